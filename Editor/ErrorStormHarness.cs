@@ -0,0 +1,802 @@
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+using System.Linq;
+using System.Text;
+using UnityEditor;
+using UnityEngine;
+using UnityEngine.LowLevel;
+using UnityEngine.Profiling;
+using MoonForge.ErrorTracking.Analytics;
+using Debug = UnityEngine.Debug;
+
+namespace MoonForge.ErrorTracking.Editor
+{
+    /// <summary>
+    /// Replays synthetic error, breadcrumb and analytics mixes through the full SDK pipeline
+    /// (capture, sampling, queueing, serialization, upload) against a local collector and
+    /// reports per-event cost, the SDK's time per frame, capture-to-ack latency, memory
+    /// high-water mark, bytes on wire and frame-time tails.
+    ///
+    /// Interactive: MoonForge > Diagnostics > Run Error Storm
+    /// Headless:    Unity -batchmode -nographics -projectPath &lt;path&gt;
+    ///                    -executeMethod MoonForge.ErrorTracking.Editor.ErrorStormHarness.RunFromCommandLine
+    ///                    [-stormProfile profile.json] [-stormReport report.json]
+    /// </summary>
+    [InitializeOnLoad]
+    public static class ErrorStormHarness
+    {
+        private const string PendingProfileKey = "MoonForge_ErrorStorm_PendingProfile";
+        private const string PendingReportKey = "MoonForge_ErrorStorm_PendingReport";
+        private const string PendingExitKey = "MoonForge_ErrorStorm_ExitWhenDone";
+        private const string DefaultReportPath = "Library/MoonForge/ErrorStormReport.json";
+        private const string CrashDirectory = "Temp/MoonForge/ErrorStormCrashes";
+        private const string StampPrefix = "[storm:";
+        private const float DrainSeconds = 3f;
+
+        private static StormRun _run;
+
+        static ErrorStormHarness()
+        {
+            // Entering play mode reloads the domain, so the pending run is carried over in SessionState
+            EditorApplication.playModeStateChanged += OnPlayModeStateChanged;
+        }
+
+        #region Entry Points
+
+        [MenuItem("MoonForge/Diagnostics/Run Error Storm (Default Profile)", false, 60)]
+        public static void RunDefaultProfile()
+        {
+            Run(ErrorStormProfile.CreateDefault(), DefaultReportPath, false);
+        }
+
+        [MenuItem("MoonForge/Diagnostics/Run Error Storm From Profile...", false, 61)]
+        public static void RunProfileFromFile()
+        {
+            var path = EditorUtility.OpenFilePanel("Error Storm Profile", "", "json");
+            if (string.IsNullOrEmpty(path)) return;
+
+            var profile = ErrorStormProfile.Load(path);
+            if (profile != null)
+            {
+                Run(profile, DefaultReportPath, false);
+            }
+        }
+
+        /// <summary>
+        /// Entry point for -executeMethod. Reads -stormProfile and -stormReport from the command line
+        /// and exits the editor with a non-zero code if the run could not complete.
+        /// </summary>
+        public static void RunFromCommandLine()
+        {
+            var args = Environment.GetCommandLineArgs();
+            var profilePath = GetArgument(args, "-stormProfile");
+            var reportPath = GetArgument(args, "-stormReport") ?? DefaultReportPath;
+
+            var profile = string.IsNullOrEmpty(profilePath)
+                ? ErrorStormProfile.CreateDefault()
+                : ErrorStormProfile.Load(profilePath);
+
+            if (profile == null)
+            {
+                EditorApplication.Exit(1);
+                return;
+            }
+
+            Run(profile, reportPath, true);
+        }
+
+        /// <summary>
+        /// Queue a storm run. Play mode is entered automatically and the run starts on the first frame.
+        /// </summary>
+        public static void Run(ErrorStormProfile profile, string reportPath, bool exitWhenDone)
+        {
+            if (profile == null || profile.phases == null || profile.phases.Count == 0)
+            {
+                Debug.LogError("[MoonForge] Error storm profile has no phases");
+                return;
+            }
+
+            SessionState.SetString(PendingProfileKey, JsonUtility.ToJson(profile));
+            SessionState.SetString(PendingReportKey, reportPath);
+            SessionState.SetBool(PendingExitKey, exitWhenDone);
+
+            if (EditorApplication.isPlaying)
+            {
+                StartPendingRun();
+            }
+            else
+            {
+                EditorApplication.isPlaying = true;
+            }
+        }
+
+        #endregion
+
+        #region Run Lifecycle
+
+        private static void OnPlayModeStateChanged(PlayModeStateChange state)
+        {
+            if (state == PlayModeStateChange.EnteredPlayMode)
+            {
+                StartPendingRun();
+            }
+            else if (state == PlayModeStateChange.ExitingPlayMode && _run != null)
+            {
+                Debug.LogWarning("[MoonForge] Error storm aborted: play mode exited before the run completed");
+                Finish(aborted: true);
+            }
+        }
+
+        private static void StartPendingRun()
+        {
+            var profileJson = SessionState.GetString(PendingProfileKey, "");
+            if (string.IsNullOrEmpty(profileJson) || _run != null) return;
+
+            var reportPath = SessionState.GetString(PendingReportKey, DefaultReportPath);
+            var exitWhenDone = SessionState.GetBool(PendingExitKey, false);
+            SessionState.EraseString(PendingProfileKey);
+
+            var profile = JsonUtility.FromJson<ErrorStormProfile>(profileJson);
+
+            if (MoonForgeErrorTracker.IsInitialized)
+            {
+                Debug.LogError("[MoonForge] Error storm needs an uninitialized tracker. " +
+                    "Disable 'Enable in Editor' in MoonForge Settings while running the harness.");
+                if (exitWhenDone) EditorApplication.Exit(1);
+                return;
+            }
+
+            var sink = new MoonForgeLocalCollector(profile.collectorFaults);
+            try
+            {
+                sink.Start();
+            }
+            catch (Exception ex)
+            {
+                Debug.LogError($"[MoonForge] Failed to start error storm collector: {ex.Message}");
+                if (exitWhenDone) EditorApplication.Exit(1);
+                return;
+            }
+
+            var config = ScriptableObject.CreateInstance<ErrorTrackerConfig>();
+            config.gameId = Guid.NewGuid().ToString();
+            config.apiEndpoint = sink.BaseUrl;
+            config.enableInEditor = true;
+            config.debugMode = false;
+            config.enableAnalytics = profile.enableAnalytics;
+            config.trackSceneViewsAutomatically = false;
+            config.enableSampling = profile.enableSampling;
+            config.captureNativeCrashes = true;
+            config.maxRetries = 1;
+            config.retryBaseDelay = 1f;
+
+            if (MoonForgeErrorTracker.Initialize(config) == null)
+            {
+                sink.Stop();
+                Debug.LogError("[MoonForge] Error storm could not initialize the tracker");
+                if (exitWhenDone) EditorApplication.Exit(1);
+                return;
+            }
+
+            _run = new StormRun(profile, sink, reportPath, exitWhenDone);
+            InstallPlayerLoopHook();
+
+            Debug.Log($"[MoonForge] Error storm '{profile.name}' started against {sink.BaseUrl} ({profile.phases.Count} phases)");
+        }
+
+        private static void OnFrame()
+        {
+            if (_run == null) return;
+
+            _run.Tick();
+
+            if (_run.IsComplete)
+            {
+                Finish(aborted: false);
+            }
+        }
+
+        private static void Finish(bool aborted)
+        {
+            var run = _run;
+            _run = null;
+            RemovePlayerLoopHook();
+
+            var report = run.BuildReport(aborted);
+            run.Sink.ErrorAccepted = null;
+            run.Sink.Stop();
+
+            WriteReport(report, run.ReportPath);
+
+            if (MoonForgeErrorTracker.Instance != null)
+            {
+                UnityEngine.Object.Destroy(MoonForgeErrorTracker.Instance.gameObject);
+            }
+
+            if (run.ExitWhenDone)
+            {
+                EditorApplication.Exit(aborted ? 1 : 0);
+            }
+            else if (EditorApplication.isPlaying && !aborted)
+            {
+                EditorApplication.isPlaying = false;
+            }
+        }
+
+        private static void WriteReport(ErrorStormReport report, string path)
+        {
+            try
+            {
+                var directory = Path.GetDirectoryName(path);
+                if (!string.IsNullOrEmpty(directory) && !Directory.Exists(directory))
+                {
+                    Directory.CreateDirectory(directory);
+                }
+                File.WriteAllText(path, JsonUtility.ToJson(report, true));
+            }
+            catch (Exception ex)
+            {
+                Debug.LogError($"[MoonForge] Failed to write error storm report: {ex.Message}");
+            }
+
+            var sb = new StringBuilder();
+            sb.AppendLine($"[MoonForge] Error storm '{report.profile}' {(report.aborted ? "ABORTED" : "complete")} - report: {path}");
+            foreach (var phase in report.phases)
+            {
+                sb.AppendLine($"  {phase.name} ({phase.kind}): {phase.eventsEmitted} events, " +
+                    $"capture p50={phase.captureP50Us:F1}us p99={phase.captureP99Us:F1}us max={phase.captureMaxUs:F1}us, " +
+                    $"frame p99={phase.frameP99Ms:F2}ms worst={phase.frameMaxMs:F2}ms, " +
+                    $"sdk/frame p99={phase.sdkFrameP99Ms:F3}ms worst={phase.sdkFrameMaxMs:F3}ms, " +
+                    $"ack {phase.eventsAcked}/{phase.eventsEmitted} p50={phase.ackP50Ms:F0}ms p99={phase.ackP99Ms:F0}ms max={phase.ackMaxMs:F0}ms");
+            }
+            sb.AppendLine($"  wire: {report.requests} requests, {report.bytesOnWire} bytes ({report.bytesPerEvent:F0} B/event), " +
+                $"{report.requestsRejected} rejected by schema validation, {report.faultsInjected} faults injected");
+            sb.AppendLine($"  managed heap high-water: {report.managedHeapHighWaterBytes / (1024f * 1024f):F1} MB, GC gen0 collections: {report.gcGen0Collections}");
+            var arenas = report.payloadArenas;
+            sb.AppendLine($"  payload arenas: {arenas.arenasCreated} created for {arenas.arenasRented} batches, " +
+                $"queue items {arenas.itemsCreated} created / {arenas.itemsReused} reused");
+            Debug.Log(sb.ToString());
+        }
+
+        private static void InstallPlayerLoopHook()
+        {
+            var loop = PlayerLoop.GetCurrentPlayerLoop();
+            for (var i = 0; i < loop.subSystemList.Length; i++)
+            {
+                if (loop.subSystemList[i].type != typeof(UnityEngine.PlayerLoop.Update)) continue;
+
+                var systems = new List<PlayerLoopSystem>(loop.subSystemList[i].subSystemList ?? Array.Empty<PlayerLoopSystem>());
+                systems.Insert(0, new PlayerLoopSystem
+                {
+                    type = typeof(ErrorStormHarness),
+                    updateDelegate = OnFrame
+                });
+                loop.subSystemList[i].subSystemList = systems.ToArray();
+                break;
+            }
+            PlayerLoop.SetPlayerLoop(loop);
+        }
+
+        private static void RemovePlayerLoopHook()
+        {
+            var loop = PlayerLoop.GetCurrentPlayerLoop();
+            for (var i = 0; i < loop.subSystemList.Length; i++)
+            {
+                var subSystems = loop.subSystemList[i].subSystemList;
+                if (subSystems == null) continue;
+                loop.subSystemList[i].subSystemList = subSystems.Where(s => s.type != typeof(ErrorStormHarness)).ToArray();
+            }
+            PlayerLoop.SetPlayerLoop(loop);
+        }
+
+        private static string GetArgument(string[] args, string name)
+        {
+            for (var i = 0; i < args.Length - 1; i++)
+            {
+                if (args[i] == name) return args[i + 1];
+            }
+            return null;
+        }
+
+        #endregion
+
+        #region Run State
+
+        private class StormRun
+        {
+            public readonly ErrorStormProfile Profile;
+            public readonly MoonForgeLocalCollector Sink;
+            public readonly string ReportPath;
+            public readonly bool ExitWhenDone;
+
+            private readonly System.Random _random;
+            private readonly List<PhaseStats> _phaseStats = new List<PhaseStats>();
+            private readonly Stopwatch _eventTimer = new Stopwatch();
+            private readonly int _gen0AtStart;
+
+            // Capture time of each stamped event the collector has not acknowledged yet
+            private readonly Dictionary<long, PendingAck> _awaitingAck = new Dictionary<long, PendingAck>();
+            private readonly object _ackLock = new object();
+
+            private int _phaseIndex;
+            private float _phaseElapsed;
+            private float _eventDebt;
+            private float _drainElapsed;
+            private long _managedHeapHighWater;
+            private long _sequence;
+            private PhaseStats _current;
+            private bool _phaseOpen;
+
+            // The last frame's emit time, completed by the tracker Update that ran after it
+            private PhaseStats _lastFrameStats;
+            private double _lastFrameEmitMs;
+
+            public bool IsComplete { get; private set; }
+
+            public StormRun(ErrorStormProfile profile, MoonForgeLocalCollector sink, string reportPath, bool exitWhenDone)
+            {
+                Profile = profile;
+                Sink = sink;
+                ReportPath = reportPath;
+                ExitWhenDone = exitWhenDone;
+                _random = new System.Random(profile.seed);
+                _gen0AtStart = GC.CollectionCount(0);
+                sink.ErrorAccepted = OnErrorAccepted;
+                BeginPhase(0);
+            }
+
+            public void Tick()
+            {
+                var frameMs = Time.unscaledDeltaTime * 1000f;
+                SampleMemory();
+                RecordSdkFrame();
+
+                if (_phaseIndex >= Profile.phases.Count)
+                {
+                    // All phases emitted; give the queue time to drain to the collector
+                    _drainElapsed += Time.unscaledDeltaTime;
+                    if (_drainElapsed >= DrainSeconds)
+                    {
+                        IsComplete = true;
+                    }
+                    return;
+                }
+
+                var phase = Profile.phases[_phaseIndex];
+                _current.FrameTimesMs.Add(frameMs);
+
+                _phaseElapsed += Time.unscaledDeltaTime;
+                _eventDebt += phase.errorsPerMinute / 60f * Time.unscaledDeltaTime;
+
+                var due = (int)_eventDebt;
+                _eventDebt -= due;
+
+                var sdkFrameTicks = 0L;
+                for (var i = 0; i < due; i++)
+                {
+                    _eventTimer.Restart();
+                    EmitEvent(phase);
+                    _eventTimer.Stop();
+
+                    sdkFrameTicks += _eventTimer.ElapsedTicks;
+                    _current.CaptureTimesUs.Add(_eventTimer.ElapsedTicks * 1_000_000.0 / Stopwatch.Frequency);
+                }
+                _current.EventsEmitted += due;
+                _lastFrameStats = _current;
+                _lastFrameEmitMs = sdkFrameTicks * 1000.0 / Stopwatch.Frequency;
+
+                if (_phaseElapsed >= phase.durationSeconds)
+                {
+                    EndPhase();
+                    BeginPhase(_phaseIndex + 1);
+                }
+            }
+
+            private void BeginPhase(int index)
+            {
+                _phaseIndex = index;
+                _phaseElapsed = 0f;
+                _eventDebt = 0f;
+
+                if (index >= Profile.phases.Count)
+                {
+                    Sink.Offline = false;
+                    MoonForgeErrorTracker.Instance?.Flush();
+                    return;
+                }
+
+                var phase = Profile.phases[index];
+                Sink.Offline = phase.kind == ErrorStormPhase.Offline;
+
+                _current = new PhaseStats
+                {
+                    Phase = phase,
+                    CollectorAtStart = Sink.GetStats()
+                };
+                _phaseStats.Add(_current);
+                _phaseOpen = true;
+            }
+
+            private void EndPhase()
+            {
+                _phaseOpen = false;
+                _current.CollectorAtEnd = Sink.GetStats();
+            }
+
+            /// <summary>
+            /// The SDK's cost of the previous frame: the events emitted in it plus the tracker's
+            /// Update (scheduled serialization, transport start), which runs after this hook
+            /// </summary>
+            private void RecordSdkFrame()
+            {
+                var tracker = MoonForgeErrorTracker.Instance;
+                if (_lastFrameStats == null || tracker == null) return;
+
+                _lastFrameStats.SdkFrameTimesMs.Add(_lastFrameEmitMs + tracker.LastUpdateMs);
+                _lastFrameStats = null;
+            }
+
+            private void EmitEvent(ErrorStormPhase phase)
+            {
+                var tracker = MoonForgeErrorTracker.Instance;
+                if (tracker == null) return;
+
+                var sequence = _sequence++;
+                var variant = phase.distinctMessages > 0 ? _random.Next(phase.distinctMessages) : 0;
+
+                for (var i = 0; i < phase.breadcrumbsPerError; i++)
+                {
+                    tracker.AddBreadcrumb($"storm breadcrumb {sequence}.{i}", BreadcrumbType.User, BreadcrumbLevel.Info, "storm");
+                }
+
+                if (MoonForgeAnalytics.IsInitialized)
+                {
+                    for (var i = 0; i < phase.analyticsEventsPerError; i++)
+                    {
+                        MoonForgeAnalytics.TrackEvent("storm_event", new Dictionary<string, object>
+                        {
+                            { "sequence", sequence },
+                            { "variant", variant }
+                        });
+                    }
+                }
+
+                var message = BuildMessage(phase, variant, sequence);
+
+                lock (_ackLock)
+                {
+                    _awaitingAck[sequence] = new PendingAck { Stats = _current, CapturedAt = Stopwatch.GetTimestamp() };
+                }
+
+                switch (phase.kind)
+                {
+                    case ErrorStormPhase.LogFlood:
+                        Debug.LogError(message);
+                        break;
+                    case ErrorStormPhase.ExceptionStorm:
+                        Debug.LogException(new InvalidOperationException(message));
+                        break;
+                    case ErrorStormPhase.CrashLoop:
+                        // The record a crashed run leaves behind, then the next launch reporting it
+                        WriteCrashRecord(message, sequence);
+                        NativeCrashHandler.ReplayCrashRecords(CrashDirectory);
+                        tracker.Flush();
+                        break;
+                    default:
+                        tracker.CaptureMessage(message, ErrorLevel.Error);
+                        break;
+                }
+            }
+
+            private string BuildMessage(ErrorStormPhase phase, int variant, long sequence)
+            {
+                var message = $"Storm error variant {variant} {StampPrefix}{sequence}]";
+                if (phase.messageLength > message.Length)
+                {
+                    message = message.PadRight(phase.messageLength, 'x');
+                }
+                return message;
+            }
+
+            /// <summary>
+            /// Write a native crash record like the signal handler does: SIGABRT with the message
+            /// as the abort reason, so the stamp survives into the reported error
+            /// </summary>
+            private void WriteCrashRecord(string message, long sequence)
+            {
+                var timestamp = DateTimeOffset.UtcNow.ToUnixTimeMilliseconds();
+                var sb = new StringBuilder();
+                sb.Append("{\"signal\":6,\"signalName\":\"SIGABRT\",\"signalDescription\":\"Abort signal\",\"siCode\":-6");
+                sb.Append(",\"faultAddress\":\"0x0\",\"threadId\":1,\"abortMessage\":\"").Append(message).Append('"');
+                sb.Append(",\"timestamp\":").Append(timestamp).Append(",\"frameCount\":16,\"frames\":[");
+                for (var i = 0; i < 16; i++)
+                {
+                    if (i > 0) sb.Append(',');
+                    sb.Append("{\"frame\":").Append(i)
+                        .Append(",\"address\":\"0x").Append((0x7f3a20001000L + i * 0x140L).ToString("x")).Append('"')
+                        .Append(",\"module\":\"libgame.so\",\"symbol\":\"StormCrash").Append(i)
+                        .Append("\",\"offset\":\"0x").Append((i * 0x140).ToString("x")).Append("\"}");
+                }
+                sb.Append("]}");
+
+                Directory.CreateDirectory(CrashDirectory);
+                File.WriteAllText(Path.Combine(CrashDirectory, $"crash_{timestamp}_{sequence}.json"), sb.ToString());
+            }
+
+            /// <summary>
+            /// Collector callback, on a request thread: matches the stamp to its capture time
+            /// </summary>
+            private void OnErrorAccepted(string message)
+            {
+                var ackedAt = Stopwatch.GetTimestamp();
+                if (!TryParseStamp(message, out var sequence)) return;
+
+                lock (_ackLock)
+                {
+                    if (!_awaitingAck.TryGetValue(sequence, out var pending)) return;
+
+                    _awaitingAck.Remove(sequence);
+                    pending.Stats.AckLatenciesMs.Add((ackedAt - pending.CapturedAt) * 1000.0 / Stopwatch.Frequency);
+                }
+            }
+
+            private static bool TryParseStamp(string message, out long sequence)
+            {
+                sequence = 0;
+                var start = message?.IndexOf(StampPrefix, StringComparison.Ordinal) ?? -1;
+                if (start < 0) return false;
+
+                start += StampPrefix.Length;
+                var end = message.IndexOf(']', start);
+                return end > start && long.TryParse(message.Substring(start, end - start), out sequence);
+            }
+
+            private void SampleMemory()
+            {
+                var heap = Profiler.GetMonoUsedSizeLong();
+                if (heap > _managedHeapHighWater)
+                {
+                    _managedHeapHighWater = heap;
+                }
+            }
+
+            public ErrorStormReport BuildReport(bool aborted)
+            {
+                if (_phaseOpen)
+                {
+                    EndPhase();
+                }
+
+                var collector = Sink.GetStats();
+                var report = new ErrorStormReport
+                {
+                    profile = Profile.name,
+                    aborted = aborted,
+                    timestampUtc = DateTime.UtcNow.ToString("o"),
+                    unityVersion = Application.unityVersion,
+                    platform = Application.platform.ToString(),
+                    requests = collector.requests,
+                    bytesOnWire = collector.bytes,
+                    eventsAccepted = collector.itemsAccepted,
+                    requestsRejected = collector.rejected,
+                    faultsInjected = collector.faultsInjected,
+                    recentRejections = collector.recentRejections,
+                    managedHeapHighWaterBytes = _managedHeapHighWater,
+                    gcGen0Collections = GC.CollectionCount(0) - _gen0AtStart,
+                    payloadArenas = PayloadArena.GetStats(),
+                    phases = new List<ErrorStormPhaseReport>()
+                };
+
+                var totalEvents = 0L;
+                lock (_ackLock)
+                {
+                    foreach (var stats in _phaseStats)
+                    {
+                        report.phases.Add(stats.ToReport());
+                        totalEvents += stats.EventsEmitted;
+                    }
+                }
+                report.eventsEmitted = totalEvents;
+                report.bytesPerEvent = totalEvents > 0 ? (float)report.bytesOnWire / totalEvents : 0f;
+
+                return report;
+            }
+        }
+
+        private struct PendingAck
+        {
+            public PhaseStats Stats;
+            public long CapturedAt;
+        }
+
+        private class PhaseStats
+        {
+            public ErrorStormPhase Phase;
+            public readonly List<double> CaptureTimesUs = new List<double>();
+            public readonly List<float> FrameTimesMs = new List<float>();
+            public readonly List<double> SdkFrameTimesMs = new List<double>();
+            public readonly List<double> AckLatenciesMs = new List<double>();
+            public long EventsEmitted;
+            public LocalCollectorStats CollectorAtStart;
+            public LocalCollectorStats CollectorAtEnd;
+
+            public ErrorStormPhaseReport ToReport()
+            {
+                var capture = CaptureTimesUs.OrderBy(t => t).ToList();
+                var frames = FrameTimesMs.OrderBy(t => t).ToList();
+                var sdkFrames = SdkFrameTimesMs.OrderBy(t => t).ToList();
+                var acks = AckLatenciesMs.OrderBy(t => t).ToList();
+                var totalCaptureUs = capture.Sum();
+
+                return new ErrorStormPhaseReport
+                {
+                    name = Phase.name,
+                    kind = Phase.kind,
+                    durationSeconds = Phase.durationSeconds,
+                    eventsEmitted = EventsEmitted,
+                    captureMeanUs = capture.Count > 0 ? (float)(totalCaptureUs / capture.Count) : 0f,
+                    captureP50Us = (float)Percentile(capture, 0.50),
+                    captureP95Us = (float)Percentile(capture, 0.95),
+                    captureP99Us = (float)Percentile(capture, 0.99),
+                    captureMaxUs = capture.Count > 0 ? (float)capture[capture.Count - 1] : 0f,
+                    frameP50Ms = (float)Percentile(frames.Select(f => (double)f).ToList(), 0.50),
+                    frameP99Ms = (float)Percentile(frames.Select(f => (double)f).ToList(), 0.99),
+                    frameMaxMs = frames.Count > 0 ? frames[frames.Count - 1] : 0f,
+                    sdkFrameP99Ms = (float)Percentile(sdkFrames, 0.99),
+                    sdkFrameMaxMs = sdkFrames.Count > 0 ? (float)sdkFrames[sdkFrames.Count - 1] : 0f,
+                    eventsAcked = acks.Count,
+                    ackP50Ms = (float)Percentile(acks, 0.50),
+                    ackP99Ms = (float)Percentile(acks, 0.99),
+                    ackMaxMs = acks.Count > 0 ? (float)acks[acks.Count - 1] : 0f,
+                    requests = CollectorAtEnd.requests - CollectorAtStart.requests,
+                    bytesOnWire = CollectorAtEnd.bytes - CollectorAtStart.bytes,
+                    requestsRejected = CollectorAtEnd.rejected - CollectorAtStart.rejected,
+                    faultsInjected = CollectorAtEnd.faultsInjected - CollectorAtStart.faultsInjected
+                };
+            }
+
+            private static double Percentile(List<double> sorted, double percentile)
+            {
+                if (sorted.Count == 0) return 0;
+                var index = (int)Math.Ceiling(percentile * sorted.Count) - 1;
+                return sorted[Mathf.Clamp(index, 0, sorted.Count - 1)];
+            }
+        }
+
+        #endregion
+    }
+
+    /// <summary>
+    /// A recorded load profile: an ordered list of phases replayed by <see cref="ErrorStormHarness"/>
+    /// </summary>
+    [Serializable]
+    public class ErrorStormProfile
+    {
+        public string name = "default";
+        public int seed = 1234;
+        public bool enableAnalytics = true;
+        public bool enableSampling = true;
+        /// <summary>
+        /// Faults the local collector injects for the whole run, on top of offline phases
+        /// </summary>
+        public CollectorFaultScript collectorFaults = new CollectorFaultScript();
+        public List<ErrorStormPhase> phases = new List<ErrorStormPhase>();
+
+        /// <summary>
+        /// Load a profile from a JSON file
+        /// </summary>
+        public static ErrorStormProfile Load(string path)
+        {
+            try
+            {
+                return JsonUtility.FromJson<ErrorStormProfile>(File.ReadAllText(path));
+            }
+            catch (Exception ex)
+            {
+                Debug.LogError($"[MoonForge] Failed to load error storm profile '{path}': {ex.Message}");
+                return null;
+            }
+        }
+
+        /// <summary>
+        /// Built-in profile covering the scenarios we get asked about most:
+        /// a 10k errors/min storm, a log flood, a crash loop and an outage.
+        /// </summary>
+        public static ErrorStormProfile CreateDefault()
+        {
+            return new ErrorStormProfile
+            {
+                name = "default",
+                phases = new List<ErrorStormPhase>
+                {
+                    new ErrorStormPhase { name = "baseline", kind = ErrorStormPhase.Idle, durationSeconds = 5f },
+                    new ErrorStormPhase { name = "log-flood", kind = ErrorStormPhase.LogFlood, durationSeconds = 15f, errorsPerMinute = 3000f, distinctMessages = 20, breadcrumbsPerError = 1 },
+                    new ErrorStormPhase { name = "storm-10k", kind = ErrorStormPhase.ExceptionStorm, durationSeconds = 30f, errorsPerMinute = 10000f, distinctMessages = 5, breadcrumbsPerError = 2, analyticsEventsPerError = 1 },
+                    new ErrorStormPhase { name = "crash-loop", kind = ErrorStormPhase.CrashLoop, durationSeconds = 10f, errorsPerMinute = 30f, distinctMessages = 1 },
+                    new ErrorStormPhase { name = "offline", kind = ErrorStormPhase.Offline, durationSeconds = 15f, errorsPerMinute = 600f, distinctMessages = 10, breadcrumbsPerError = 1 },
+                    new ErrorStormPhase { name = "recovery", kind = ErrorStormPhase.Idle, durationSeconds = 10f }
+                }
+            };
+        }
+    }
+
+    /// <summary>
+    /// A single phase of an error storm profile
+    /// </summary>
+    [Serializable]
+    public class ErrorStormPhase
+    {
+        public const string Idle = "idle";
+        public const string LogFlood = "logFlood";
+        public const string ExceptionStorm = "exceptionStorm";
+        public const string CrashLoop = "crashLoop";
+        public const string Offline = "offline";
+
+        public string name;
+        public string kind = Idle;
+        public float durationSeconds = 10f;
+        public float errorsPerMinute;
+        public int distinctMessages = 1;
+        public int messageLength;
+        public int breadcrumbsPerError;
+        public int analyticsEventsPerError;
+    }
+
+    [Serializable]
+    public class ErrorStormReport
+    {
+        public string profile;
+        public bool aborted;
+        public string timestampUtc;
+        public string unityVersion;
+        public string platform;
+        public long eventsEmitted;
+        public long eventsAccepted;
+        public long requests;
+        public long bytesOnWire;
+        public float bytesPerEvent;
+        public long requestsRejected;
+        public long faultsInjected;
+        public List<string> recentRejections;
+        public long managedHeapHighWaterBytes;
+        public int gcGen0Collections;
+        public PayloadArenaStats payloadArenas;
+        public List<ErrorStormPhaseReport> phases;
+    }
+
+    [Serializable]
+    public class ErrorStormPhaseReport
+    {
+        public string name;
+        public string kind;
+        public float durationSeconds;
+        public long eventsEmitted;
+        public float captureMeanUs;
+        public float captureP50Us;
+        public float captureP95Us;
+        public float captureP99Us;
+        public float captureMaxUs;
+        public float frameP50Ms;
+        public float frameP99Ms;
+        public float frameMaxMs;
+        /// <summary>
+        /// SDK time per frame: event capture plus the tracker's Update
+        /// </summary>
+        public float sdkFrameP99Ms;
+        public float sdkFrameMaxMs;
+        /// <summary>
+        /// Events the collector accepted, and the time from capture to its acknowledgement.
+        /// Sampled-out and dropped events are never acknowledged.
+        /// </summary>
+        public long eventsAcked;
+        public float ackP50Ms;
+        public float ackP99Ms;
+        public float ackMaxMs;
+        public long requests;
+        public long bytesOnWire;
+        public long requestsRejected;
+        public long faultsInjected;
+    }
+}
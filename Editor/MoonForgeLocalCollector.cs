@@ -0,0 +1,920 @@
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+using System.Net;
+using System.Text;
+using System.Threading;
+using UnityEditor;
+using UnityEngine;
+using Debug = UnityEngine.Debug;
+
+namespace MoonForge.ErrorTracking.Editor
+{
+    /// <summary>
+    /// Local stand-in for collector.moonforge.co used for transport testing and benchmarks.
+    /// Accepts the single error, error batch and analytics formats, validates them against the
+    /// wire schema, measures ingest throughput and can inject scripted faults
+    /// (latency, 429 with Retry-After, 5xx, connection resets, slow reads).
+    ///
+    /// Point the SDK at it by setting the API endpoint to <see cref="BaseUrl"/>.
+    /// </summary>
+    public class MoonForgeLocalCollector
+    {
+        public const int DefaultPort = 8787;
+
+        private static MoonForgeLocalCollector _shared;
+
+        private HttpListener _listener;
+        private Thread _acceptThread;
+        private readonly object _statsLock = new object();
+        private readonly Stopwatch _uptime = new Stopwatch();
+        private readonly Dictionary<string, RouteStats> _routes = new Dictionary<string, RouteStats>();
+        private readonly Queue<string> _recentRejections = new Queue<string>();
+        private readonly int[] _faultMatches;
+        private readonly int[] _faultApplied;
+        private volatile bool _offline;
+
+        private const int MaxRecentRejections = 20;
+        private const int MaxBatchItems = 50;
+
+        /// <summary>
+        /// Fault script applied to incoming requests (may be null)
+        /// </summary>
+        public CollectorFaultScript Faults { get; }
+
+        /// <summary>
+        /// Base URL to use as the SDK API endpoint, e.g. http://127.0.0.1:8787
+        /// </summary>
+        public string BaseUrl { get; private set; }
+
+        public bool IsRunning => _listener != null && _listener.IsListening;
+
+        /// <summary>
+        /// While set, every connection is reset to emulate a collector outage
+        /// </summary>
+        public bool Offline
+        {
+            get => _offline;
+            set => _offline = value;
+        }
+
+        /// <summary>
+        /// Called with the message of each error accepted, on the request's thread before it is answered
+        /// </summary>
+        public Action<string> ErrorAccepted { get; set; }
+
+        public MoonForgeLocalCollector(CollectorFaultScript faults = null)
+        {
+            Faults = faults ?? new CollectorFaultScript();
+            _faultMatches = new int[Faults.faults.Count];
+            _faultApplied = new int[Faults.faults.Count];
+        }
+
+        #region Lifecycle
+
+        /// <summary>
+        /// Start listening on the loopback interface. Port 0 picks a free port.
+        /// </summary>
+        public void Start(int port = 0)
+        {
+            if (IsRunning) return;
+
+            if (port == 0)
+            {
+                port = FindFreePort();
+            }
+
+            BaseUrl = $"http://127.0.0.1:{port}";
+
+            _listener = new HttpListener();
+            _listener.Prefixes.Add(BaseUrl + "/");
+            _listener.Start();
+            _uptime.Restart();
+
+            _acceptThread = new Thread(AcceptLoop) { IsBackground = true, Name = "MoonForge.LocalCollector" };
+            _acceptThread.Start();
+        }
+
+        public void Stop()
+        {
+            try
+            {
+                _listener?.Stop();
+                _listener?.Close();
+            }
+            catch { }
+            _listener = null;
+            _uptime.Stop();
+        }
+
+        private void AcceptLoop()
+        {
+            while (IsRunning)
+            {
+                HttpListenerContext context;
+                try
+                {
+                    context = _listener.GetContext();
+                }
+                catch
+                {
+                    return;
+                }
+
+                // Handle on the pool so injected latency on one request doesn't stall the others
+                ThreadPool.QueueUserWorkItem(_ => HandleSafe(context));
+            }
+        }
+
+        #endregion
+
+        #region Request Handling
+
+        private void HandleSafe(HttpListenerContext context)
+        {
+            try
+            {
+                Handle(context);
+            }
+            catch (Exception ex)
+            {
+                Debug.LogWarning($"[MoonForge] Local collector failed to handle request: {ex.Message}");
+                try { context.Response.Abort(); } catch { }
+            }
+        }
+
+        private void Handle(HttpListenerContext context)
+        {
+            var request = context.Request;
+            var route = GetRoute(request.Url.AbsolutePath);
+
+            if (_offline)
+            {
+                Record(route, 0, 0, rejected: false, fault: true);
+                context.Response.Abort();
+                return;
+            }
+
+            if (request.HttpMethod == "GET" && route == "health")
+            {
+                Respond(context, 200, "{\"status\":\"ok\"}");
+                return;
+            }
+
+            var fault = SelectFault(route);
+
+            if (fault != null && fault.latencyMs > 0)
+            {
+                Thread.Sleep(fault.latencyMs);
+            }
+
+            var body = ReadBody(request, fault != null && fault.kind == CollectorFault.SlowRead ? fault.bytesPerSecond : 0);
+            var bytes = request.ContentLength64 > 0 ? request.ContentLength64 : Encoding.UTF8.GetByteCount(body);
+
+            if (fault != null)
+            {
+                switch (fault.kind)
+                {
+                    case CollectorFault.Reset:
+                        Record(route, bytes, 0, rejected: false, fault: true);
+                        context.Response.Abort();
+                        return;
+                    case CollectorFault.Status:
+                        Record(route, bytes, 0, rejected: false, fault: true);
+                        if (fault.retryAfterSeconds > 0)
+                        {
+                            context.Response.AddHeader("Retry-After", fault.retryAfterSeconds.ToString());
+                        }
+                        Respond(context, fault.statusCode, $"{{\"status\":\"error\",\"error\":\"injected {fault.statusCode}\"}}");
+                        return;
+                }
+            }
+
+            string error;
+            string response;
+            int items;
+
+            switch (route)
+            {
+                case "batch":
+                    items = ValidateBatch(body, out error, out response);
+                    break;
+                case "errors":
+                    items = ValidateError(body, out error, out response);
+                    break;
+                case "analytics":
+                    items = ValidateAnalytics(body, out error, out response);
+                    break;
+                default:
+                    Respond(context, 404, "{\"status\":\"error\",\"error\":\"not found\"}");
+                    return;
+            }
+
+            if (error != null)
+            {
+                Record(route, bytes, 0, rejected: true, fault: false);
+                RecordRejection($"{route}: {error}");
+                Respond(context, 400, $"{{\"status\":\"error\",\"error\":\"{EscapeJsonString(error)}\"}}");
+                return;
+            }
+
+            Record(route, bytes, items, rejected: false, fault: fault != null);
+            Respond(context, 200, response);
+        }
+
+        private static string GetRoute(string path)
+        {
+            path = path.TrimEnd('/');
+            if (path.EndsWith("/api/errors/batch")) return "batch";
+            if (path.EndsWith("/api/errors")) return "errors";
+            if (path.EndsWith("/api/send")) return "analytics";
+            if (path.EndsWith("/health")) return "health";
+            return "unknown";
+        }
+
+        private static string ReadBody(HttpListenerRequest request, int bytesPerSecond)
+        {
+            using (var memory = new MemoryStream())
+            {
+                var buffer = new byte[bytesPerSecond > 0 ? Math.Max(1, Math.Min(bytesPerSecond / 10, 4096)) : 16384];
+                int read;
+                while ((read = request.InputStream.Read(buffer, 0, buffer.Length)) > 0)
+                {
+                    memory.Write(buffer, 0, read);
+                    if (bytesPerSecond > 0)
+                    {
+                        // Drain at the configured rate to emulate a congested link
+                        Thread.Sleep(read * 1000 / bytesPerSecond);
+                    }
+                }
+                return Encoding.UTF8.GetString(memory.ToArray());
+            }
+        }
+
+        private static void Respond(HttpListenerContext context, int statusCode, string body)
+        {
+            var bytes = Encoding.UTF8.GetBytes(body);
+            context.Response.StatusCode = statusCode;
+            context.Response.ContentType = "application/json";
+            context.Response.ContentLength64 = bytes.Length;
+            context.Response.OutputStream.Write(bytes, 0, bytes.Length);
+            context.Response.Close();
+        }
+
+        #endregion
+
+        #region Schema Validation
+
+        private int ValidateError(string body, out string error, out string response)
+        {
+            response = null;
+
+            // Full wire schema (value types, required fields), from the generated decoder
+            if (!WirePayloadDecoder.TryDecode(body, out ErrorPayload _, out error)) return 0;
+
+            var envelope = Parse<ErrorEnvelope>(body, out error);
+            if (envelope == null) return 0;
+
+            if (envelope.type != "error")
+            {
+                error = $"type must be 'error' (got '{envelope.type}')";
+                return 0;
+            }
+
+            if (envelope.payload == null)
+            {
+                error = "payload is required";
+                return 0;
+            }
+
+            if (!IsGameId(envelope.payload.game))
+            {
+                error = "payload.game must be a UUID";
+                return 0;
+            }
+
+            error = ValidateItem(envelope.payload, requireClientId: false);
+            if (error != null) return 0;
+
+            ErrorAccepted?.Invoke(envelope.payload.message);
+
+            response = $"{{\"status\":\"ok\",\"errorId\":\"{Guid.NewGuid()}\",\"sampleRate\":1}}";
+            return 1;
+        }
+
+        private int ValidateBatch(string body, out string error, out string response)
+        {
+            response = null;
+
+            if (!WirePayloadDecoder.TryDecode(body, out ErrorBatchPayload _, out error)) return 0;
+
+            var batch = Parse<BatchEnvelope>(body, out error);
+            if (batch == null) return 0;
+
+            if (batch.type != "error_batch")
+            {
+                error = $"type must be 'error_batch' (got '{batch.type}')";
+                return 0;
+            }
+
+            if (!IsGameId(batch.game))
+            {
+                error = "game must be a UUID";
+                return 0;
+            }
+
+            if (batch.errors == null || batch.errors.Count == 0)
+            {
+                error = "errors must contain at least one item";
+                return 0;
+            }
+
+            if (batch.errors.Count > MaxBatchItems)
+            {
+                error = $"errors exceeds {MaxBatchItems} items ({batch.errors.Count})";
+                return 0;
+            }
+
+            if (batch.frameEncoding == "table")
+            {
+                error = DecodeFrameTables(batch);
+                if (error != null) return 0;
+            }
+            else if (!string.IsNullOrEmpty(batch.frameEncoding))
+            {
+                error = $"frameEncoding '{batch.frameEncoding}' is not supported";
+                return 0;
+            }
+
+            var sb = new StringBuilder();
+            sb.Append("{\"status\":\"ok\",\"batchId\":\"").Append(Guid.NewGuid()).Append('"');
+            sb.Append(",\"total\":").Append(batch.errors.Count);
+            sb.Append(",\"accepted\":").Append(batch.errors.Count);
+            sb.Append(",\"sampledOut\":0,\"results\":[");
+
+            for (var i = 0; i < batch.errors.Count; i++)
+            {
+                var itemError = ValidateItem(batch.errors[i], requireClientId: true);
+                if (itemError != null)
+                {
+                    error = $"errors[{i}]: {itemError}";
+                    return 0;
+                }
+
+                if (i > 0) sb.Append(',');
+                sb.Append("{\"clientErrorId\":\"").Append(EscapeJsonString(batch.errors[i].clientErrorId))
+                    .Append("\",\"status\":\"accepted\",\"errorId\":\"").Append(Guid.NewGuid())
+                    .Append("\",\"sampleRate\":1,\"occurrenceCount\":1}");
+            }
+
+            sb.Append("]}");
+            response = sb.ToString();
+
+            var accepted = ErrorAccepted;
+            if (accepted != null)
+            {
+                foreach (var item in batch.errors) accepted(item.message);
+            }
+            return batch.errors.Count;
+        }
+
+        private int ValidateAnalytics(string body, out string error, out string response)
+        {
+            response = null;
+
+            var envelope = Parse<AnalyticsEnvelope>(body, out error);
+            if (envelope == null) return 0;
+
+            if (envelope.type != "event" && envelope.type != "identify")
+            {
+                error = $"type must be 'event' or 'identify' (got '{envelope.type}')";
+                return 0;
+            }
+
+            if (envelope.payload == null || !IsGameId(envelope.payload.game))
+            {
+                error = "payload.game must be a UUID";
+                return 0;
+            }
+
+            if (envelope.type == "identify" && string.IsNullOrEmpty(envelope.payload.id))
+            {
+                error = "identify requires payload.id";
+                return 0;
+            }
+
+            if (envelope.payload.timestamp <= 0)
+            {
+                error = "payload.timestamp is required";
+                return 0;
+            }
+
+            response = "{\"status\":\"ok\"}";
+            return 1;
+        }
+
+        /// <summary>
+        /// Reference decoder for "frameEncoding":"table" batches. Replaces each item's frameRefs with
+        /// frames resolved through frameTable and strings. Returns an error for malformed tables.
+        /// </summary>
+        private static string DecodeFrameTables(BatchEnvelope batch)
+        {
+            var strings = batch.strings;
+            var table = batch.frameTable;
+            if (strings == null || strings.Count == 0 || strings[0] != "")
+                return "strings must start with \"\"";
+            if (table == null)
+                return "frameTable is required with frameEncoding 'table'";
+
+            var decodedTable = new List<FrameItem>(table.Count);
+            for (var i = 0; i < table.Count; i++)
+            {
+                var entry = table[i];
+                var indices = new[] { entry.module, entry.function, entry.filename, entry.instructionAddress, entry.symbolAddress, entry.package };
+                foreach (var index in indices)
+                {
+                    if (index < 0 || index >= strings.Count)
+                        return $"frameTable[{i}] references string {index} of {strings.Count}";
+                }
+
+                decodedTable.Add(new FrameItem
+                {
+                    module = Resolve(strings, entry.module),
+                    function = Resolve(strings, entry.function),
+                    filename = Resolve(strings, entry.filename),
+                    lineno = entry.lineno,
+                    colno = entry.colno,
+                    instructionAddress = Resolve(strings, entry.instructionAddress),
+                    symbolAddress = Resolve(strings, entry.symbolAddress),
+                    inApp = entry.inApp,
+                    package = Resolve(strings, entry.package)
+                });
+            }
+
+            for (var i = 0; i < batch.errors.Count; i++)
+            {
+                var refs = batch.errors[i].frameRefs;
+                if (refs == null || refs.Length == 0) continue;
+
+                var frames = new List<FrameItem>(refs.Length);
+                for (var j = 0; j < refs.Length; j++)
+                {
+                    if (refs[j] < 0 || refs[j] >= decodedTable.Count)
+                        return $"errors[{i}].frameRefs[{j}] references frame {refs[j]} of {decodedTable.Count}";
+                    frames.Add(decodedTable[refs[j]]);
+                }
+                batch.errors[i].frames = frames;
+            }
+
+            return null;
+        }
+
+        private static string Resolve(List<string> strings, int index)
+        {
+            return index == 0 ? null : strings[index];
+        }
+
+        private static string ValidateItem(ErrorItem item, bool requireClientId)
+        {
+            if (requireClientId && string.IsNullOrEmpty(item.clientErrorId))
+                return "clientErrorId is required";
+
+            switch (item.errorType)
+            {
+                case "crash":
+                case "exception":
+                case "network":
+                case "custom":
+                    break;
+                default:
+                    return $"errorType '{item.errorType}' is not one of crash|exception|network|custom";
+            }
+
+            switch (item.errorCategory)
+            {
+                case "native":
+                case "managed":
+                case "handled":
+                case "unhandled":
+                    break;
+                default:
+                    return $"errorCategory '{item.errorCategory}' is not one of native|managed|handled|unhandled";
+            }
+
+            switch (item.errorLevel)
+            {
+                case "fatal":
+                case "error":
+                case "warning":
+                case "info":
+                    break;
+                default:
+                    return $"errorLevel '{item.errorLevel}' is not one of fatal|error|warning|info";
+            }
+
+            if (item.message == null)
+                return "message is required";
+
+            if (item.appVersion == null || item.buildNumber == null)
+                return "appVersion and buildNumber are required";
+
+            if (item.device != null && (string.IsNullOrEmpty(item.device.platform) || item.device.osVersion == null))
+                return "device.platform and device.osVersion are required when device is present";
+
+            return null;
+        }
+
+        private static T Parse<T>(string body, out string error) where T : class
+        {
+            if (string.IsNullOrEmpty(body))
+            {
+                error = "empty body";
+                return null;
+            }
+
+            try
+            {
+                var result = JsonUtility.FromJson<T>(body);
+                error = result == null ? "body is not a JSON object" : null;
+                return result;
+            }
+            catch (Exception ex)
+            {
+                error = $"invalid JSON: {ex.Message}";
+                return null;
+            }
+        }
+
+        private static bool IsGameId(string value)
+        {
+            return !string.IsNullOrEmpty(value) && Guid.TryParse(value, out _);
+        }
+
+        private static string EscapeJsonString(string str)
+        {
+            if (string.IsNullOrEmpty(str)) return "";
+            return str.Replace("\\", "\\\\").Replace("\"", "\\\"").Replace("\n", "\\n").Replace("\r", "\\r");
+        }
+
+        #endregion
+
+        #region Fault Injection
+
+        private CollectorFault SelectFault(string route)
+        {
+            lock (_statsLock)
+            {
+                CollectorFault selected = null;
+
+                for (var i = 0; i < Faults.faults.Count; i++)
+                {
+                    var fault = Faults.faults[i];
+                    if (fault.route != "*" && fault.route != route) continue;
+
+                    _faultMatches[i]++;
+                    if (fault.everyNth > 1 && _faultMatches[i] % fault.everyNth != 0) continue;
+                    if (fault.maxCount > 0 && _faultApplied[i] >= fault.maxCount) continue;
+
+                    _faultApplied[i]++;
+                    selected = fault;
+                    break;
+                }
+
+                return selected;
+            }
+        }
+
+        #endregion
+
+        #region Stats
+
+        private void Record(string route, long bytes, int items, bool rejected, bool fault)
+        {
+            lock (_statsLock)
+            {
+                if (!_routes.TryGetValue(route, out var stats))
+                {
+                    stats = new RouteStats { route = route };
+                    _routes[route] = stats;
+                }
+
+                stats.requests++;
+                stats.bytes += bytes;
+                stats.itemsAccepted += items;
+                if (rejected) stats.rejected++;
+                if (fault) stats.faultsInjected++;
+            }
+        }
+
+        private void RecordRejection(string message)
+        {
+            lock (_statsLock)
+            {
+                _recentRejections.Enqueue(message);
+                while (_recentRejections.Count > MaxRecentRejections)
+                {
+                    _recentRejections.Dequeue();
+                }
+            }
+        }
+
+        /// <summary>
+        /// Snapshot of ingest counters and throughput since <see cref="Start"/>
+        /// </summary>
+        public LocalCollectorStats GetStats()
+        {
+            lock (_statsLock)
+            {
+                var seconds = Math.Max(_uptime.Elapsed.TotalSeconds, 0.001);
+                var stats = new LocalCollectorStats
+                {
+                    uptimeSeconds = (float)seconds,
+                    routes = new List<RouteStats>(),
+                    recentRejections = new List<string>(_recentRejections)
+                };
+
+                foreach (var route in _routes.Values)
+                {
+                    stats.routes.Add(new RouteStats
+                    {
+                        route = route.route,
+                        requests = route.requests,
+                        bytes = route.bytes,
+                        itemsAccepted = route.itemsAccepted,
+                        rejected = route.rejected,
+                        faultsInjected = route.faultsInjected
+                    });
+
+                    stats.requests += route.requests;
+                    stats.bytes += route.bytes;
+                    stats.itemsAccepted += route.itemsAccepted;
+                    stats.rejected += route.rejected;
+                    stats.faultsInjected += route.faultsInjected;
+                }
+
+                stats.itemsPerSecond = (float)(stats.itemsAccepted / seconds);
+                stats.bytesPerSecond = (float)(stats.bytes / seconds);
+                return stats;
+            }
+        }
+
+        /// <summary>
+        /// Reset all counters and fault progress
+        /// </summary>
+        public void ResetStats()
+        {
+            lock (_statsLock)
+            {
+                _routes.Clear();
+                _recentRejections.Clear();
+                Array.Clear(_faultMatches, 0, _faultMatches.Length);
+                Array.Clear(_faultApplied, 0, _faultApplied.Length);
+                _uptime.Restart();
+            }
+        }
+
+        private static int FindFreePort()
+        {
+            var listener = new System.Net.Sockets.TcpListener(IPAddress.Loopback, 0);
+            listener.Start();
+            var port = ((IPEndPoint)listener.LocalEndpoint).Port;
+            listener.Stop();
+            return port;
+        }
+
+        #endregion
+
+        #region Menu
+
+        [MenuItem("MoonForge/Diagnostics/Local Collector/Start", false, 80)]
+        private static void StartShared()
+        {
+            StartShared(null);
+        }
+
+        [MenuItem("MoonForge/Diagnostics/Local Collector/Start With Fault Script...", false, 81)]
+        private static void StartSharedWithFaults()
+        {
+            var path = EditorUtility.OpenFilePanel("Collector Fault Script", "", "json");
+            if (string.IsNullOrEmpty(path)) return;
+
+            var faults = CollectorFaultScript.Load(path);
+            if (faults != null)
+            {
+                StartShared(faults);
+            }
+        }
+
+        [MenuItem("MoonForge/Diagnostics/Local Collector/Log Stats", false, 82)]
+        private static void LogSharedStats()
+        {
+            if (_shared == null || !_shared.IsRunning)
+            {
+                Debug.Log("[MoonForge] Local collector is not running");
+                return;
+            }
+
+            Debug.Log($"[MoonForge] Local collector stats:\n{JsonUtility.ToJson(_shared.GetStats(), true)}");
+        }
+
+        [MenuItem("MoonForge/Diagnostics/Local Collector/Stop", false, 83)]
+        private static void StopShared()
+        {
+            if (_shared == null) return;
+
+            _shared.Stop();
+            _shared = null;
+            Debug.Log("[MoonForge] Local collector stopped");
+        }
+
+        private static void StartShared(CollectorFaultScript faults)
+        {
+            StopShared();
+
+            _shared = new MoonForgeLocalCollector(faults);
+            try
+            {
+                _shared.Start(DefaultPort);
+                Debug.Log($"[MoonForge] Local collector listening on {_shared.BaseUrl} " +
+                    $"({_shared.Faults.faults.Count} faults scripted). Set the API endpoint to this URL to use it.");
+            }
+            catch (Exception ex)
+            {
+                Debug.LogError($"[MoonForge] Failed to start local collector on port {DefaultPort}: {ex.Message}");
+                _shared = null;
+            }
+        }
+
+        #endregion
+
+        #region Wire Schema
+
+        // Only the fields the collector validates; JsonUtility ignores the rest
+
+        [Serializable]
+        private class ErrorEnvelope
+        {
+            public string type;
+            public ErrorItem payload;
+        }
+
+        [Serializable]
+        private class BatchEnvelope
+        {
+            public string type;
+            public string game;
+            public List<ErrorItem> errors;
+
+            // Compact batches: "table", with frames shared through frameTable and strings
+            public string frameEncoding;
+            public List<string> strings;
+            public List<FrameTableItem> frameTable;
+        }
+
+        [Serializable]
+        private class FrameTableItem
+        {
+            // Indices into strings; 0 is an absent field
+            public int module;
+            public int function;
+            public int filename;
+            public int lineno;
+            public int colno;
+            public int instructionAddress;
+            public int symbolAddress;
+            public bool inApp;
+            public int package;
+        }
+
+        [Serializable]
+        private class FrameItem
+        {
+            public string module;
+            public string function;
+            public string filename;
+            public int lineno;
+            public int colno;
+            public string instructionAddress;
+            public string symbolAddress;
+            public bool inApp;
+            public string package;
+        }
+
+        [Serializable]
+        private class ErrorItem
+        {
+            public string game;
+            public string clientErrorId;
+            public string errorType;
+            public string errorCategory;
+            public string errorLevel;
+            public string message;
+            public string appVersion;
+            public string buildNumber;
+            public DeviceItem device;
+            public List<FrameItem> frames;
+            public int[] frameRefs;
+        }
+
+        [Serializable]
+        private class DeviceItem
+        {
+            public string platform;
+            public string osVersion;
+        }
+
+        [Serializable]
+        private class AnalyticsEnvelope
+        {
+            public string type;
+            public AnalyticsItem payload;
+        }
+
+        [Serializable]
+        private class AnalyticsItem
+        {
+            public string game;
+            public string id;
+            public long timestamp;
+        }
+
+        #endregion
+    }
+
+    /// <summary>
+    /// Ordered list of faults; the first matching fault wins for each request
+    /// </summary>
+    [Serializable]
+    public class CollectorFaultScript
+    {
+        public List<CollectorFault> faults = new List<CollectorFault>();
+
+        public static CollectorFaultScript Load(string path)
+        {
+            try
+            {
+                return JsonUtility.FromJson<CollectorFaultScript>(File.ReadAllText(path));
+            }
+            catch (Exception ex)
+            {
+                Debug.LogError($"[MoonForge] Failed to load collector fault script '{path}': {ex.Message}");
+                return null;
+            }
+        }
+    }
+
+    /// <summary>
+    /// A scripted collector fault
+    /// </summary>
+    [Serializable]
+    public class CollectorFault
+    {
+        /// <summary>Respond normally after <see cref="latencyMs"/></summary>
+        public const string Latency = "latency";
+        /// <summary>Respond with <see cref="statusCode"/> (and Retry-After if set)</summary>
+        public const string Status = "status";
+        /// <summary>Reset the connection without a response</summary>
+        public const string Reset = "reset";
+        /// <summary>Read the request body at <see cref="bytesPerSecond"/></summary>
+        public const string SlowRead = "slowRead";
+
+        /// <summary>errors | batch | analytics | *</summary>
+        public string route = "*";
+        public string kind = Latency;
+        public int latencyMs;
+        public int statusCode = 503;
+        public int retryAfterSeconds;
+        public int bytesPerSecond = 1024;
+        /// <summary>Apply to every Nth matching request (1 = every request)</summary>
+        public int everyNth = 1;
+        /// <summary>Stop after this many applications (0 = unlimited)</summary>
+        public int maxCount;
+    }
+
+    [Serializable]
+    public class LocalCollectorStats
+    {
+        public float uptimeSeconds;
+        public long requests;
+        public long bytes;
+        public long itemsAccepted;
+        public long rejected;
+        public long faultsInjected;
+        public float itemsPerSecond;
+        public float bytesPerSecond;
+        public List<RouteStats> routes;
+        public List<string> recentRejections;
+    }
+
+    [Serializable]
+    public class RouteStats
+    {
+        public string route;
+        public long requests;
+        public long bytes;
+        public long itemsAccepted;
+        public long rejected;
+        public long faultsInjected;
+    }
+}
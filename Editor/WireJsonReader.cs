@@ -0,0 +1,321 @@
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.Text;
+
+namespace MoonForge.ErrorTracking.Editor
+{
+    /// <summary>
+    /// Malformed JSON, a value of the wrong type or a missing required field
+    /// </summary>
+    public class WireFormatException : FormatException
+    {
+        public WireFormatException(string message) : base(message)
+        {
+        }
+    }
+
+    /// <summary>
+    /// Forward-only JSON reader behind the generated <see cref="WirePayloadDecoder"/>.
+    /// Values are read in document order; the caller says what type it expects and
+    /// gets a <see cref="WireFormatException"/> if the document disagrees.
+    /// </summary>
+    public class WireJsonReader
+    {
+        private readonly string _json;
+        private int _pos;
+        private readonly StringBuilder _scratch = new StringBuilder();
+
+        // Per open object or array: whether the next member or element is the first
+        private readonly Stack<bool> _first = new Stack<bool>();
+
+        public WireJsonReader(string json)
+        {
+            _json = json ?? "";
+        }
+
+        /// <summary>
+        /// Fail unless only whitespace is left
+        /// </summary>
+        public void EndOfInput()
+        {
+            SkipWhitespace();
+            if (_pos < _json.Length) throw Error("unexpected data after the document");
+        }
+
+        /// <summary>
+        /// Consume a null literal if one is next
+        /// </summary>
+        public bool ReadNull()
+        {
+            SkipWhitespace();
+            if (string.CompareOrdinal(_json, _pos, "null", 0, 4) != 0) return false;
+            _pos += 4;
+            return true;
+        }
+
+        public void BeginObject()
+        {
+            Expect('{', "object");
+            _first.Push(true);
+        }
+
+        /// <summary>
+        /// Move to the next member of the current object; false (and the object closed) at its end
+        /// </summary>
+        public bool NextField(out string name)
+        {
+            name = null;
+            if (!NextItem('}')) return false;
+            name = ReadQuoted();
+            Expect(':', "':'");
+            return true;
+        }
+
+        public void BeginArray()
+        {
+            Expect('[', "array");
+            _first.Push(true);
+        }
+
+        /// <summary>
+        /// Move to the next element of the current array; false (and the array closed) at its end
+        /// </summary>
+        public bool NextElement()
+        {
+            return NextItem(']');
+        }
+
+        public string ReadString()
+        {
+            return ReadNull() ? null : ReadQuoted();
+        }
+
+        private string ReadQuoted()
+        {
+            Expect('"', "string");
+
+            _scratch.Clear();
+            while (true)
+            {
+                if (_pos >= _json.Length) throw Error("unterminated string");
+                var c = _json[_pos++];
+                if (c == '"') break;
+                if (c != '\\')
+                {
+                    _scratch.Append(c);
+                    continue;
+                }
+
+                if (_pos >= _json.Length) throw Error("unterminated string");
+                c = _json[_pos++];
+                switch (c)
+                {
+                    case '"': _scratch.Append('"'); break;
+                    case '\\': _scratch.Append('\\'); break;
+                    case '/': _scratch.Append('/'); break;
+                    case 'b': _scratch.Append('\b'); break;
+                    case 'f': _scratch.Append('\f'); break;
+                    case 'n': _scratch.Append('\n'); break;
+                    case 'r': _scratch.Append('\r'); break;
+                    case 't': _scratch.Append('\t'); break;
+                    case 'u':
+                        if (_pos + 4 > _json.Length
+                            || !int.TryParse(_json.Substring(_pos, 4), NumberStyles.AllowHexSpecifier, CultureInfo.InvariantCulture, out var code))
+                            throw Error("invalid \\u escape");
+                        _scratch.Append((char)code);
+                        _pos += 4;
+                        break;
+                    default:
+                        throw Error($"invalid escape '\\{c}'");
+                }
+            }
+            return _scratch.ToString();
+        }
+
+        public bool ReadBool()
+        {
+            SkipWhitespace();
+            if (string.CompareOrdinal(_json, _pos, "true", 0, 4) == 0)
+            {
+                _pos += 4;
+                return true;
+            }
+            if (string.CompareOrdinal(_json, _pos, "false", 0, 5) == 0)
+            {
+                _pos += 5;
+                return false;
+            }
+            throw Error("expected true or false");
+        }
+
+        public int ReadInt()
+        {
+            var value = ReadLong();
+            if (value < int.MinValue || value > int.MaxValue) throw Error("number out of range");
+            return (int)value;
+        }
+
+        public long ReadLong()
+        {
+            var token = ReadNumberToken();
+            if (!long.TryParse(token, NumberStyles.AllowLeadingSign, CultureInfo.InvariantCulture, out var value))
+                throw Error($"expected an integer (got {token})");
+            return value;
+        }
+
+        public float ReadFloat()
+        {
+            return (float)ReadDouble();
+        }
+
+        public double ReadDouble()
+        {
+            var token = ReadNumberToken();
+            if (!double.TryParse(token, NumberStyles.Float, CultureInfo.InvariantCulture, out var value))
+                throw Error($"expected a number (got {token})");
+            return value;
+        }
+
+        public Dictionary<string, string> ReadStringDictionary()
+        {
+            if (ReadNull()) return null;
+
+            var dict = new Dictionary<string, string>();
+            BeginObject();
+            while (NextField(out var key))
+            {
+                dict[key] = ReadString();
+            }
+            return dict;
+        }
+
+        /// <summary>
+        /// Free-form object: strings, longs, doubles, bools, nulls, nested dictionaries and lists
+        /// </summary>
+        public Dictionary<string, object> ReadObjectDictionary()
+        {
+            if (ReadNull()) return null;
+
+            var dict = new Dictionary<string, object>();
+            BeginObject();
+            while (NextField(out var key))
+            {
+                dict[key] = ReadValue();
+            }
+            return dict;
+        }
+
+        /// <summary>
+        /// Skip the next value, whatever it is
+        /// </summary>
+        public void SkipValue()
+        {
+            ReadValue();
+        }
+
+        /// <summary>
+        /// Fail for the first required field whose bit is not set in <paramref name="seen"/>
+        /// </summary>
+        public void RequireFields(string path, int seen, string[] required)
+        {
+            for (var i = 0; i < required.Length; i++)
+            {
+                if ((seen & (1 << i)) == 0)
+                    throw new WireFormatException($"{Child(path, required[i])} is required");
+            }
+        }
+
+        /// <summary>
+        /// Path of a member, for error messages; the document root is ""
+        /// </summary>
+        public static string Child(string path, string name)
+        {
+            return path.Length == 0 ? name : path + "." + name;
+        }
+
+        private object ReadValue()
+        {
+            SkipWhitespace();
+            if (_pos >= _json.Length) throw Error("unexpected end of input");
+
+            var c = _json[_pos];
+            switch (c)
+            {
+                case '"':
+                    return ReadString();
+                case '{':
+                    return ReadObjectDictionary();
+                case '[':
+                    var list = new List<object>();
+                    BeginArray();
+                    while (NextElement()) list.Add(ReadValue());
+                    return list;
+                case 't':
+                case 'f':
+                    return ReadBool();
+                case 'n':
+                    if (!ReadNull()) throw Error("expected null");
+                    return null;
+                default:
+                    var token = ReadNumberToken();
+                    if (long.TryParse(token, NumberStyles.AllowLeadingSign, CultureInfo.InvariantCulture, out var integer))
+                        return integer;
+                    if (double.TryParse(token, NumberStyles.Float, CultureInfo.InvariantCulture, out var number))
+                        return number;
+                    throw Error($"invalid number {token}");
+            }
+        }
+
+        private bool NextItem(char close)
+        {
+            SkipWhitespace();
+            if (_pos < _json.Length && _json[_pos] == close)
+            {
+                _pos++;
+                _first.Pop();
+                return false;
+            }
+
+            if (!_first.Pop())
+            {
+                Expect(',', $"',' or '{close}'");
+            }
+            _first.Push(false);
+            return true;
+        }
+
+        private string ReadNumberToken()
+        {
+            SkipWhitespace();
+            var start = _pos;
+            while (_pos < _json.Length)
+            {
+                var c = _json[_pos];
+                if ((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E')
+                    _pos++;
+                else
+                    break;
+            }
+            if (_pos == start) throw Error("expected a number");
+            return _json.Substring(start, _pos - start);
+        }
+
+        private void Expect(char c, string what)
+        {
+            SkipWhitespace();
+            if (_pos >= _json.Length || _json[_pos] != c) throw Error($"expected {what}");
+            _pos++;
+        }
+
+        private void SkipWhitespace()
+        {
+            while (_pos < _json.Length && char.IsWhiteSpace(_json[_pos])) _pos++;
+        }
+
+        private WireFormatException Error(string message)
+        {
+            return new WireFormatException($"{message} at offset {_pos}");
+        }
+    }
+}
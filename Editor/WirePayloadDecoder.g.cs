@@ -0,0 +1,762 @@
+// <auto-generated>
+// Generated by MoonForge > Developer > Regenerate Wire Codecs from the models in
+// Runtime/Models/ErrorPayload.cs. Do not edit by hand.
+// </auto-generated>
+
+using System.Collections.Generic;
+using System.Runtime.CompilerServices;
+
+namespace MoonForge.ErrorTracking.Editor
+{
+    public static partial class WirePayloadDecoder
+    {
+        public static bool TryDecode(string json, out ErrorPayload value, out string error)
+        {
+            try
+            {
+                var reader = new WireJsonReader(json);
+                value = ReadErrorPayload(reader, "");
+                reader.EndOfInput();
+                error = value == null ? "body is null" : null;
+                return value != null;
+            }
+            catch (WireFormatException ex)
+            {
+                value = null;
+                error = ex.Message;
+                return false;
+            }
+        }
+
+        public static bool TryDecode(string json, out ErrorBatchPayload value, out string error)
+        {
+            try
+            {
+                var reader = new WireJsonReader(json);
+                value = ReadErrorBatchPayload(reader, "");
+                reader.EndOfInput();
+                error = value == null ? "body is null" : null;
+                return value != null;
+            }
+            catch (WireFormatException ex)
+            {
+                value = null;
+                error = ex.Message;
+                return false;
+            }
+        }
+
+        public static StackFrame ReadStackFrame(WireJsonReader reader, string path)
+        {
+            if (reader.ReadNull()) return null;
+
+            var value = new StackFrame();
+            reader.BeginObject();
+            while (reader.NextField(out var name))
+            {
+                switch (name)
+                {
+                    case "module":
+                        value.module = reader.ReadString();
+                        break;
+                    case "function":
+                        value.function = reader.ReadString();
+                        break;
+                    case "filename":
+                        value.filename = reader.ReadString();
+                        break;
+                    case "lineno":
+                        value.lineno = reader.ReadInt();
+                        break;
+                    case "colno":
+                        value.colno = reader.ReadInt();
+                        break;
+                    case "instructionAddress":
+                        value.instructionAddress = reader.ReadString();
+                        break;
+                    case "symbolAddress":
+                        value.symbolAddress = reader.ReadString();
+                        break;
+                    case "inApp":
+                        value.inApp = reader.ReadBool();
+                        break;
+                    case "package":
+                        value.package = reader.ReadString();
+                        break;
+                    default:
+                        reader.SkipValue();
+                        break;
+                }
+            }
+            return value;
+        }
+
+        private static readonly string[] ThreadCpuUsageRequired = { "tid", "name", "cpuPercent", "cpuTimeMs" };
+
+        public static ThreadCpuUsage ReadThreadCpuUsage(WireJsonReader reader, string path)
+        {
+            if (reader.ReadNull()) return null;
+
+            var value = new ThreadCpuUsage();
+            var seen = 0;
+            reader.BeginObject();
+            while (reader.NextField(out var name))
+            {
+                switch (name)
+                {
+                    case "tid":
+                        value.tid = reader.ReadInt();
+                        seen |= 1;
+                        break;
+                    case "name":
+                        value.name = reader.ReadString();
+                        seen |= 2;
+                        break;
+                    case "cpuPercent":
+                        value.cpuPercent = reader.ReadFloat();
+                        seen |= 4;
+                        break;
+                    case "cpuTimeMs":
+                        value.cpuTimeMs = reader.ReadLong();
+                        seen |= 8;
+                        break;
+                    default:
+                        reader.SkipValue();
+                        break;
+                }
+            }
+            reader.RequireFields(path, seen, ThreadCpuUsageRequired);
+            return value;
+        }
+
+        private static readonly string[] CpuClusterFrequencyRequired = { "cpu", "curKhz", "maxKhz", "capKhz" };
+
+        public static CpuClusterFrequency ReadCpuClusterFrequency(WireJsonReader reader, string path)
+        {
+            if (reader.ReadNull()) return null;
+
+            var value = new CpuClusterFrequency();
+            var seen = 0;
+            reader.BeginObject();
+            while (reader.NextField(out var name))
+            {
+                switch (name)
+                {
+                    case "cpu":
+                        value.cpu = reader.ReadInt();
+                        seen |= 1;
+                        break;
+                    case "curKhz":
+                        value.curKhz = reader.ReadInt();
+                        seen |= 2;
+                        break;
+                    case "maxKhz":
+                        value.maxKhz = reader.ReadInt();
+                        seen |= 4;
+                        break;
+                    case "capKhz":
+                        value.capKhz = reader.ReadInt();
+                        seen |= 8;
+                        break;
+                    default:
+                        reader.SkipValue();
+                        break;
+                }
+            }
+            reader.RequireFields(path, seen, CpuClusterFrequencyRequired);
+            return value;
+        }
+
+        private static readonly string[] DeviceContextRequired = { "platform", "osVersion", "deviceModel" };
+
+        public static DeviceContext ReadDeviceContext(WireJsonReader reader, string path)
+        {
+            if (reader.ReadNull()) return null;
+
+            var value = new DeviceContext();
+            var seen = 0;
+            reader.BeginObject();
+            while (reader.NextField(out var name))
+            {
+                switch (name)
+                {
+                    case "platform":
+                        value.platform = reader.ReadString();
+                        seen |= 1;
+                        break;
+                    case "osVersion":
+                        value.osVersion = reader.ReadString();
+                        seen |= 2;
+                        break;
+                    case "deviceModel":
+                        value.deviceModel = reader.ReadString();
+                        seen |= 4;
+                        break;
+                    case "manufacturer":
+                        value.manufacturer = reader.ReadString();
+                        break;
+                    case "cpuArchitecture":
+                        value.cpuArchitecture = reader.ReadString();
+                        break;
+                    case "memoryUsedMb":
+                        value.memoryUsedMb = reader.ReadNull() ? (float?)null : reader.ReadFloat();
+                        break;
+                    case "memoryAvailableMb":
+                        value.memoryAvailableMb = reader.ReadNull() ? (float?)null : reader.ReadFloat();
+                        break;
+                    case "cpuUsagePercent":
+                        value.cpuUsagePercent = reader.ReadNull() ? (float?)null : reader.ReadFloat();
+                        break;
+                    case "threadCpu":
+                        value.threadCpu = ReadThreadCpuUsageList(reader, WireJsonReader.Child(path, "threadCpu"));
+                        break;
+                    case "fps":
+                        value.fps = reader.ReadNull() ? (float?)null : reader.ReadFloat();
+                        break;
+                    case "batteryLevel":
+                        value.batteryLevel = reader.ReadNull() ? (float?)null : reader.ReadFloat();
+                        break;
+                    case "batteryCharging":
+                        value.batteryCharging = reader.ReadNull() ? (bool?)null : reader.ReadBool();
+                        break;
+                    case "thermalState":
+                        value.thermalState = reader.ReadString();
+                        break;
+                    case "temperatureC":
+                        value.temperatureC = reader.ReadNull() ? (float?)null : reader.ReadFloat();
+                        break;
+                    case "cpuFrequencyCapPercent":
+                        value.cpuFrequencyCapPercent = reader.ReadNull() ? (float?)null : reader.ReadFloat();
+                        break;
+                    case "batteryTemperatureC":
+                        value.batteryTemperatureC = reader.ReadNull() ? (float?)null : reader.ReadFloat();
+                        break;
+                    case "cpuClusters":
+                        value.cpuClusters = ReadCpuClusterFrequencyList(reader, WireJsonReader.Child(path, "cpuClusters"));
+                        break;
+                    default:
+                        reader.SkipValue();
+                        break;
+                }
+            }
+            reader.RequireFields(path, seen, DeviceContextRequired);
+            return value;
+        }
+
+        public static NetworkContext ReadNetworkContext(WireJsonReader reader, string path)
+        {
+            if (reader.ReadNull()) return null;
+
+            var value = new NetworkContext();
+            reader.BeginObject();
+            while (reader.NextField(out var name))
+            {
+                switch (name)
+                {
+                    case "type":
+                        value.type = reader.ReadString();
+                        break;
+                    case "carrier":
+                        value.carrier = reader.ReadString();
+                        break;
+                    case "effectiveType":
+                        value.effectiveType = reader.ReadString();
+                        break;
+                    default:
+                        reader.SkipValue();
+                        break;
+                }
+            }
+            return value;
+        }
+
+        public static GameState ReadGameState(WireJsonReader reader, string path)
+        {
+            if (reader.ReadNull()) return null;
+
+            var value = new GameState();
+            reader.BeginObject();
+            while (reader.NextField(out var name))
+            {
+                switch (name)
+                {
+                    case "sceneName":
+                        value.sceneName = reader.ReadString();
+                        break;
+                    case "gameMode":
+                        value.gameMode = reader.ReadString();
+                        break;
+                    case "levelId":
+                        value.levelId = reader.ReadString();
+                        break;
+                    case "customData":
+                        value.customData = reader.ReadObjectDictionary();
+                        break;
+                    default:
+                        reader.SkipValue();
+                        break;
+                }
+            }
+            return value;
+        }
+
+        private static readonly string[] BreadcrumbRequired = { "type", "level", "timestamp" };
+
+        public static Breadcrumb ReadBreadcrumb(WireJsonReader reader, string path)
+        {
+            if (reader.ReadNull()) return null;
+
+            var value = (Breadcrumb)RuntimeHelpers.GetUninitializedObject(typeof(Breadcrumb));
+            var seen = 0;
+            reader.BeginObject();
+            while (reader.NextField(out var name))
+            {
+                switch (name)
+                {
+                    case "type":
+                        value.type = reader.ReadString();
+                        seen |= 1;
+                        break;
+                    case "category":
+                        value.category = reader.ReadString();
+                        break;
+                    case "message":
+                        value.message = reader.ReadString();
+                        break;
+                    case "level":
+                        value.level = reader.ReadString();
+                        seen |= 2;
+                        break;
+                    case "data":
+                        value.data = reader.ReadObjectDictionary();
+                        break;
+                    case "timestamp":
+                        value.timestamp = reader.ReadLong();
+                        seen |= 4;
+                        break;
+                    default:
+                        reader.SkipValue();
+                        break;
+                }
+            }
+            reader.RequireFields(path, seen, BreadcrumbRequired);
+            return value;
+        }
+
+        private static readonly string[] NetworkRequestRequired = { "url", "method" };
+
+        public static NetworkRequest ReadNetworkRequest(WireJsonReader reader, string path)
+        {
+            if (reader.ReadNull()) return null;
+
+            var value = new NetworkRequest();
+            var seen = 0;
+            reader.BeginObject();
+            while (reader.NextField(out var name))
+            {
+                switch (name)
+                {
+                    case "url":
+                        value.url = reader.ReadString();
+                        seen |= 1;
+                        break;
+                    case "method":
+                        value.method = reader.ReadString();
+                        seen |= 2;
+                        break;
+                    case "statusCode":
+                        value.statusCode = reader.ReadNull() ? (int?)null : reader.ReadInt();
+                        break;
+                    case "durationMs":
+                        value.durationMs = reader.ReadNull() ? (float?)null : reader.ReadFloat();
+                        break;
+                    case "requestHeaders":
+                        value.requestHeaders = reader.ReadStringDictionary();
+                        break;
+                    case "responseHeaders":
+                        value.responseHeaders = reader.ReadStringDictionary();
+                        break;
+                    default:
+                        reader.SkipValue();
+                        break;
+                }
+            }
+            reader.RequireFields(path, seen, NetworkRequestRequired);
+            return value;
+        }
+
+        private static readonly string[] ErrorPayloadInnerRequired = { "errorType", "errorCategory", "errorLevel", "message", "appVersion", "buildNumber" };
+
+        public static ErrorPayloadInner ReadErrorPayloadInner(WireJsonReader reader, string path)
+        {
+            if (reader.ReadNull()) return null;
+
+            var value = new ErrorPayloadInner();
+            var seen = 0;
+            reader.BeginObject();
+            while (reader.NextField(out var name))
+            {
+                switch (name)
+                {
+                    case "game":
+                        value.game = reader.ReadString();
+                        break;
+                    case "errorType":
+                        value.errorType = reader.ReadString();
+                        seen |= 1;
+                        break;
+                    case "errorCategory":
+                        value.errorCategory = reader.ReadString();
+                        seen |= 2;
+                        break;
+                    case "errorLevel":
+                        value.errorLevel = reader.ReadString();
+                        seen |= 4;
+                        break;
+                    case "message":
+                        value.message = reader.ReadString();
+                        seen |= 8;
+                        break;
+                    case "frames":
+                        value.frames = ReadStackFrameList(reader, WireJsonReader.Child(path, "frames"));
+                        break;
+                    case "rawStackTrace":
+                        value.rawStackTrace = reader.ReadString();
+                        break;
+                    case "logTail":
+                        value.logTail = reader.ReadString();
+                        break;
+                    case "exceptionClass":
+                        value.exceptionClass = reader.ReadString();
+                        break;
+                    case "faultClass":
+                        value.faultClass = reader.ReadString();
+                        break;
+                    case "fingerprint":
+                        value.fingerprint = reader.ReadString();
+                        break;
+                    case "device":
+                        value.device = ReadDeviceContext(reader, WireJsonReader.Child(path, "device"));
+                        break;
+                    case "network":
+                        value.network = ReadNetworkContext(reader, WireJsonReader.Child(path, "network"));
+                        break;
+                    case "gameState":
+                        value.gameState = ReadGameState(reader, WireJsonReader.Child(path, "gameState"));
+                        break;
+                    case "appVersion":
+                        value.appVersion = reader.ReadString();
+                        seen |= 16;
+                        break;
+                    case "buildNumber":
+                        value.buildNumber = reader.ReadString();
+                        seen |= 32;
+                        break;
+                    case "unityVersion":
+                        value.unityVersion = reader.ReadString();
+                        break;
+                    case "userId":
+                        value.userId = reader.ReadString();
+                        break;
+                    case "sessionId":
+                        value.sessionId = reader.ReadString();
+                        break;
+                    case "breadcrumbs":
+                        value.breadcrumbs = ReadBreadcrumbList(reader, WireJsonReader.Child(path, "breadcrumbs"));
+                        break;
+                    case "timestamp":
+                        value.timestamp = reader.ReadNull() ? (long?)null : reader.ReadLong();
+                        break;
+                    case "networkRequest":
+                        value.networkRequest = ReadNetworkRequest(reader, WireJsonReader.Child(path, "networkRequest"));
+                        break;
+                    case "tags":
+                        value.tags = reader.ReadStringDictionary();
+                        break;
+                    default:
+                        reader.SkipValue();
+                        break;
+                }
+            }
+            reader.RequireFields(path, seen, ErrorPayloadInnerRequired);
+            return value;
+        }
+
+        private static readonly string[] ErrorPayloadRequired = { "type", "payload" };
+
+        public static ErrorPayload ReadErrorPayload(WireJsonReader reader, string path)
+        {
+            if (reader.ReadNull()) return null;
+
+            var value = new ErrorPayload();
+            var seen = 0;
+            reader.BeginObject();
+            while (reader.NextField(out var name))
+            {
+                switch (name)
+                {
+                    case "type":
+                        value.type = reader.ReadString();
+                        seen |= 1;
+                        break;
+                    case "payload":
+                        value.payload = ReadErrorPayloadInner(reader, WireJsonReader.Child(path, "payload"));
+                        seen |= 2;
+                        break;
+                    default:
+                        reader.SkipValue();
+                        break;
+                }
+            }
+            reader.RequireFields(path, seen, ErrorPayloadRequired);
+            return value;
+        }
+
+        private static readonly string[] PayloadTruncationRequired = { "field", "original", "kept" };
+
+        public static PayloadTruncation ReadPayloadTruncation(WireJsonReader reader, string path)
+        {
+            if (reader.ReadNull()) return null;
+
+            var value = new PayloadTruncation();
+            var seen = 0;
+            reader.BeginObject();
+            while (reader.NextField(out var name))
+            {
+                switch (name)
+                {
+                    case "field":
+                        value.field = reader.ReadString();
+                        seen |= 1;
+                        break;
+                    case "original":
+                        value.original = reader.ReadInt();
+                        seen |= 2;
+                        break;
+                    case "kept":
+                        value.kept = reader.ReadInt();
+                        seen |= 4;
+                        break;
+                    default:
+                        reader.SkipValue();
+                        break;
+                }
+            }
+            reader.RequireFields(path, seen, PayloadTruncationRequired);
+            return value;
+        }
+
+        private static readonly string[] BatchErrorItemRequired = { "clientErrorId", "errorType", "errorCategory", "errorLevel", "message", "appVersion", "buildNumber" };
+
+        public static BatchErrorItem ReadBatchErrorItem(WireJsonReader reader, string path)
+        {
+            if (reader.ReadNull()) return null;
+
+            var value = new BatchErrorItem();
+            var seen = 0;
+            reader.BeginObject();
+            while (reader.NextField(out var name))
+            {
+                switch (name)
+                {
+                    case "clientErrorId":
+                        value.clientErrorId = reader.ReadString();
+                        seen |= 1;
+                        break;
+                    case "errorType":
+                        value.errorType = reader.ReadString();
+                        seen |= 2;
+                        break;
+                    case "errorCategory":
+                        value.errorCategory = reader.ReadString();
+                        seen |= 4;
+                        break;
+                    case "errorLevel":
+                        value.errorLevel = reader.ReadString();
+                        seen |= 8;
+                        break;
+                    case "message":
+                        value.message = reader.ReadString();
+                        seen |= 16;
+                        break;
+                    case "frames":
+                        value.frames = ReadStackFrameList(reader, WireJsonReader.Child(path, "frames"));
+                        break;
+                    case "rawStackTrace":
+                        value.rawStackTrace = reader.ReadString();
+                        break;
+                    case "logTail":
+                        value.logTail = reader.ReadString();
+                        break;
+                    case "exceptionClass":
+                        value.exceptionClass = reader.ReadString();
+                        break;
+                    case "faultClass":
+                        value.faultClass = reader.ReadString();
+                        break;
+                    case "fingerprint":
+                        value.fingerprint = reader.ReadString();
+                        break;
+                    case "device":
+                        value.device = ReadDeviceContext(reader, WireJsonReader.Child(path, "device"));
+                        break;
+                    case "network":
+                        value.network = ReadNetworkContext(reader, WireJsonReader.Child(path, "network"));
+                        break;
+                    case "gameState":
+                        value.gameState = ReadGameState(reader, WireJsonReader.Child(path, "gameState"));
+                        break;
+                    case "appVersion":
+                        value.appVersion = reader.ReadString();
+                        seen |= 32;
+                        break;
+                    case "buildNumber":
+                        value.buildNumber = reader.ReadString();
+                        seen |= 64;
+                        break;
+                    case "unityVersion":
+                        value.unityVersion = reader.ReadString();
+                        break;
+                    case "userId":
+                        value.userId = reader.ReadString();
+                        break;
+                    case "sessionId":
+                        value.sessionId = reader.ReadString();
+                        break;
+                    case "breadcrumbs":
+                        value.breadcrumbs = ReadBreadcrumbList(reader, WireJsonReader.Child(path, "breadcrumbs"));
+                        break;
+                    case "timestamp":
+                        value.timestamp = reader.ReadNull() ? (long?)null : reader.ReadLong();
+                        break;
+                    case "networkRequest":
+                        value.networkRequest = ReadNetworkRequest(reader, WireJsonReader.Child(path, "networkRequest"));
+                        break;
+                    case "tags":
+                        value.tags = reader.ReadStringDictionary();
+                        break;
+                    case "truncated":
+                        value.truncated = ReadPayloadTruncationList(reader, WireJsonReader.Child(path, "truncated"));
+                        break;
+                    default:
+                        reader.SkipValue();
+                        break;
+                }
+            }
+            reader.RequireFields(path, seen, BatchErrorItemRequired);
+            return value;
+        }
+
+        private static readonly string[] ErrorBatchPayloadRequired = { "type", "game", "errors" };
+
+        public static ErrorBatchPayload ReadErrorBatchPayload(WireJsonReader reader, string path)
+        {
+            if (reader.ReadNull()) return null;
+
+            var value = new ErrorBatchPayload();
+            var seen = 0;
+            reader.BeginObject();
+            while (reader.NextField(out var name))
+            {
+                switch (name)
+                {
+                    case "type":
+                        value.type = reader.ReadString();
+                        seen |= 1;
+                        break;
+                    case "game":
+                        value.game = reader.ReadString();
+                        seen |= 2;
+                        break;
+                    case "errors":
+                        value.errors = ReadBatchErrorItemList(reader, WireJsonReader.Child(path, "errors"));
+                        seen |= 4;
+                        break;
+                    default:
+                        reader.SkipValue();
+                        break;
+                }
+            }
+            reader.RequireFields(path, seen, ErrorBatchPayloadRequired);
+            return value;
+        }
+
+        private static List<ThreadCpuUsage> ReadThreadCpuUsageList(WireJsonReader reader, string path)
+        {
+            if (reader.ReadNull()) return null;
+
+            var list = new List<ThreadCpuUsage>();
+            reader.BeginArray();
+            while (reader.NextElement())
+            {
+                list.Add(ReadThreadCpuUsage(reader, path + "[" + list.Count + "]"));
+            }
+            return list;
+        }
+
+        private static List<CpuClusterFrequency> ReadCpuClusterFrequencyList(WireJsonReader reader, string path)
+        {
+            if (reader.ReadNull()) return null;
+
+            var list = new List<CpuClusterFrequency>();
+            reader.BeginArray();
+            while (reader.NextElement())
+            {
+                list.Add(ReadCpuClusterFrequency(reader, path + "[" + list.Count + "]"));
+            }
+            return list;
+        }
+
+        private static List<StackFrame> ReadStackFrameList(WireJsonReader reader, string path)
+        {
+            if (reader.ReadNull()) return null;
+
+            var list = new List<StackFrame>();
+            reader.BeginArray();
+            while (reader.NextElement())
+            {
+                list.Add(ReadStackFrame(reader, path + "[" + list.Count + "]"));
+            }
+            return list;
+        }
+
+        private static List<Breadcrumb> ReadBreadcrumbList(WireJsonReader reader, string path)
+        {
+            if (reader.ReadNull()) return null;
+
+            var list = new List<Breadcrumb>();
+            reader.BeginArray();
+            while (reader.NextElement())
+            {
+                list.Add(ReadBreadcrumb(reader, path + "[" + list.Count + "]"));
+            }
+            return list;
+        }
+
+        private static List<PayloadTruncation> ReadPayloadTruncationList(WireJsonReader reader, string path)
+        {
+            if (reader.ReadNull()) return null;
+
+            var list = new List<PayloadTruncation>();
+            reader.BeginArray();
+            while (reader.NextElement())
+            {
+                list.Add(ReadPayloadTruncation(reader, path + "[" + list.Count + "]"));
+            }
+            return list;
+        }
+
+        private static List<BatchErrorItem> ReadBatchErrorItemList(WireJsonReader reader, string path)
+        {
+            if (reader.ReadNull()) return null;
+
+            var list = new List<BatchErrorItem>();
+            reader.BeginArray();
+            while (reader.NextElement())
+            {
+                list.Add(ReadBatchErrorItem(reader, path + "[" + list.Count + "]"));
+            }
+            return list;
+        }
+    }
+}
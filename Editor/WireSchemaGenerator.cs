@@ -0,0 +1,609 @@
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Reflection;
+using System.Text;
+using UnityEditor;
+using UnityEngine;
+
+namespace MoonForge.ErrorTracking.Editor
+{
+    /// <summary>
+    /// Generates the wire codecs from the models in Runtime/Models/ErrorPayload.cs, which
+    /// are the single definition of the error wire schema:
+    ///
+    /// - WirePayloadEncoder.g.cs (runtime): one straight-line Append method per model, with
+    ///   every key written as a pre-escaped literal. No reflection or key lookups at runtime.
+    /// - WirePayloadDecoder.g.cs (editor): the matching decoder, which also checks value
+    ///   types and [WireRequired] fields. The Local Collector validates requests with it.
+    ///
+    /// Interactive: MoonForge > Developer > Regenerate Wire Codecs
+    /// CI check:    Unity -batchmode -nographics -projectPath &lt;path&gt;
+    ///                    -executeMethod MoonForge.ErrorTracking.Editor.WireSchemaGenerator.VerifyFromCommandLine
+    /// </summary>
+    public static class WireSchemaGenerator
+    {
+        private const string EncoderPath = "Runtime/Transport/WirePayloadEncoder.g.cs";
+        private const string DecoderPath = "Editor/WirePayloadDecoder.g.cs";
+
+        // Request bodies; everything reachable from them is part of the schema
+        private static readonly Type[] Roots = { typeof(ErrorPayload), typeof(ErrorBatchPayload) };
+
+        // The batch envelope carries the frame tables and is written by HttpTransport
+        private static readonly Type[] HandWrittenEncoders = { typeof(ErrorBatchPayload) };
+
+        // Items of compact batches carry this instead of inline frames (see BatchFrameTable)
+        private const string FramesField = "frames";
+        private const string FrameRefsKey = "frameRefs";
+
+        private const string Header =
+            "// <auto-generated>\n" +
+            "// Generated by MoonForge > Developer > Regenerate Wire Codecs from the models in\n" +
+            "// Runtime/Models/ErrorPayload.cs. Do not edit by hand.\n" +
+            "// </auto-generated>\n";
+
+        private enum FieldKind
+        {
+            String,
+            Integer,
+            Float,
+            Bool,
+            Model,
+            ModelList,
+            StringDictionary,
+            ObjectDictionary
+        }
+
+        private class WireField
+        {
+            public FieldInfo Info;
+            public string Name;
+            public FieldKind Kind;
+            public Type ValueType; // Underlying primitive, model or list element type
+            public bool Nullable;
+            public bool Required;
+        }
+
+        #region Entry Points
+
+        [MenuItem("MoonForge/Developer/Regenerate Wire Codecs", false, 100)]
+        public static void Regenerate()
+        {
+            var root = GetPackageRoot();
+            if (root == null) return;
+
+            var changed = 0;
+            changed += WriteIfChanged(Path.Combine(root, EncoderPath), GenerateEncoder()) ? 1 : 0;
+            changed += WriteIfChanged(Path.Combine(root, DecoderPath), GenerateDecoder()) ? 1 : 0;
+
+            if (changed > 0) AssetDatabase.Refresh();
+            Debug.Log(changed > 0
+                ? $"[MoonForge] Regenerated wire codecs ({changed} file(s) changed)"
+                : "[MoonForge] Wire codecs are up to date");
+        }
+
+        /// <summary>
+        /// Exit with 1 if the generated codecs don't match the models
+        /// </summary>
+        public static void VerifyFromCommandLine()
+        {
+            var root = GetPackageRoot();
+            var stale = root == null
+                || !IsCurrent(Path.Combine(root, EncoderPath), GenerateEncoder())
+                || !IsCurrent(Path.Combine(root, DecoderPath), GenerateDecoder());
+
+            if (stale)
+            {
+                Debug.LogError("[MoonForge] Wire codecs are out of date; run MoonForge > Developer > Regenerate Wire Codecs");
+            }
+            EditorApplication.Exit(stale ? 1 : 0);
+        }
+
+        private static string GetPackageRoot()
+        {
+            var package = UnityEditor.PackageManager.PackageInfo.FindForAssembly(typeof(WireSchemaGenerator).Assembly);
+            if (package == null)
+            {
+                Debug.LogError("[MoonForge] Could not locate the MoonForge package to regenerate wire codecs");
+                return null;
+            }
+            return package.resolvedPath;
+        }
+
+        private static bool IsCurrent(string path, string source)
+        {
+            return File.Exists(path) && File.ReadAllText(path).Replace("\r\n", "\n") == source;
+        }
+
+        private static bool WriteIfChanged(string path, string source)
+        {
+            if (IsCurrent(path, source)) return false;
+            File.WriteAllText(path, source);
+            return true;
+        }
+
+        #endregion
+
+        #region Schema
+
+        /// <summary>
+        /// Models reachable from the roots, dependencies first
+        /// </summary>
+        private static List<Type> CollectModels()
+        {
+            var models = new List<Type>();
+            foreach (var root in Roots)
+            {
+                Visit(root, models);
+            }
+            return models;
+        }
+
+        private static void Visit(Type type, List<Type> models)
+        {
+            if (models.Contains(type)) return;
+
+            foreach (var field in GetFields(type))
+            {
+                if (field.Kind == FieldKind.Model || field.Kind == FieldKind.ModelList)
+                {
+                    Visit(field.ValueType, models);
+                }
+            }
+            models.Add(type);
+        }
+
+        private static List<WireField> GetFields(Type type)
+        {
+            return type.GetFields(BindingFlags.Public | BindingFlags.Instance)
+                .Where(f => !f.IsDefined(typeof(NonSerializedAttribute), false))
+                .OrderBy(f => f.MetadataToken)
+                .Select(f => Describe(type, f))
+                .ToList();
+        }
+
+        private static WireField Describe(Type owner, FieldInfo info)
+        {
+            var field = new WireField
+            {
+                Info = info,
+                Name = info.Name,
+                Required = info.IsDefined(typeof(WireRequiredAttribute), false)
+            };
+
+            var type = info.FieldType;
+            var underlying = System.Nullable.GetUnderlyingType(type);
+            if (underlying != null)
+            {
+                field.Nullable = true;
+                type = underlying;
+            }
+            field.ValueType = type;
+
+            if (type == typeof(string)) field.Kind = FieldKind.String;
+            else if (type == typeof(int) || type == typeof(long)) field.Kind = FieldKind.Integer;
+            else if (type == typeof(float)) field.Kind = FieldKind.Float;
+            else if (type == typeof(bool)) field.Kind = FieldKind.Bool;
+            else if (type == typeof(Dictionary<string, string>)) field.Kind = FieldKind.StringDictionary;
+            else if (type == typeof(Dictionary<string, object>)) field.Kind = FieldKind.ObjectDictionary;
+            else if (type.IsGenericType && type.GetGenericTypeDefinition() == typeof(List<>) && IsModel(type.GetGenericArguments()[0]))
+            {
+                field.Kind = FieldKind.ModelList;
+                field.ValueType = type.GetGenericArguments()[0];
+            }
+            else if (IsModel(type)) field.Kind = FieldKind.Model;
+            else throw new NotSupportedException($"{owner.Name}.{info.Name}: {info.FieldType} is not a supported wire type");
+
+            return field;
+        }
+
+        private static bool IsModel(Type type)
+        {
+            return type.IsClass && type.Namespace == typeof(ErrorPayload).Namespace && type.IsDefined(typeof(SerializableAttribute), false);
+        }
+
+        private static bool IsFrameList(WireField field)
+        {
+            return field.Kind == FieldKind.ModelList && field.ValueType == typeof(StackFrame) && field.Name == FramesField;
+        }
+
+        /// <summary>
+        /// Whether the model's encoder takes a frame table: it has inline frames, directly or below
+        /// </summary>
+        private static bool CarriesFrames(Type type)
+        {
+            foreach (var field in GetFields(type))
+            {
+                if (IsFrameList(field)) return true;
+                if (field.Kind == FieldKind.Model && CarriesFrames(field.ValueType)) return true;
+            }
+            return false;
+        }
+
+        /// <summary>
+        /// C# string literal for a JSON fragment
+        /// </summary>
+        private static string Literal(string text)
+        {
+            return "\"" + text.Replace("\\", "\\\\").Replace("\"", "\\\"") + "\"";
+        }
+
+        private static string TypeName(Type type)
+        {
+            switch (Type.GetTypeCode(type))
+            {
+                case TypeCode.Int32: return "int";
+                case TypeCode.Int64: return "long";
+                case TypeCode.Single: return "float";
+                case TypeCode.Boolean: return "bool";
+                default: return type.Name;
+            }
+        }
+
+        #endregion
+
+        #region Encoder
+
+        public static string GenerateEncoder()
+        {
+            var w = new CodeWriter();
+            w.Raw(Header);
+            w.Line("using System.Text;");
+            w.Line();
+            w.Line("namespace MoonForge.ErrorTracking");
+            w.Open();
+            w.Line("public static partial class WirePayloadEncoder");
+            w.Open();
+
+            var first = true;
+            foreach (var model in CollectModels())
+            {
+                if (HandWrittenEncoders.Contains(model)) continue;
+                if (!first) w.Line();
+                first = false;
+                EmitEncoder(w, model);
+            }
+
+            w.Close();
+            w.Close();
+            return w.ToString();
+        }
+
+        private static void EmitEncoder(CodeWriter w, Type model)
+        {
+            var withFrames = CarriesFrames(model);
+            w.Line(withFrames
+                ? $"public static void Append(StringBuilder sb, {model.Name} value, BatchFrameTable frameTable = null)"
+                : $"public static void Append(StringBuilder sb, {model.Name} value)");
+            w.Open();
+            w.Line("if (value == null)");
+            w.Open();
+            w.Line("sb.Append(\"null\");");
+            w.Line("return;");
+            w.Close();
+            w.Line();
+
+            // Until a required field has been written, whether a key needs a comma is only known at runtime
+            var fields = GetFields(model);
+            var dynamicStart = fields.Count > 0 && !fields[0].Required;
+            if (dynamicStart) w.Line("var separator = '{';");
+
+            var written = false;
+            foreach (var field in fields)
+            {
+                var access = "value." + field.Name;
+                if (field.Required)
+                {
+                    EmitKey(w, field.Name, written, dynamicStart);
+                    EmitValue(w, field, access, withFrames);
+                    written = true;
+                    continue;
+                }
+
+                w.Line($"if ({PresenceCondition(field, access)})");
+                w.Open();
+                if (IsFrameList(field) && withFrames)
+                {
+                    w.Line("if (frameTable != null)");
+                    w.Open();
+                    EmitKey(w, FrameRefsKey, written, dynamicStart);
+                    w.Line($"frameTable.AppendFrameRefs(sb, {access});");
+                    w.Close();
+                    w.Line("else");
+                    w.Open();
+                    EmitKey(w, field.Name, written, dynamicStart);
+                    EmitValue(w, field, access, withFrames);
+                    w.Close();
+                }
+                else
+                {
+                    EmitKey(w, field.Name, written, dynamicStart);
+                    EmitValue(w, field, access, withFrames);
+                }
+                if (dynamicStart && !written) w.Line("separator = ',';");
+                w.Close();
+            }
+
+            if (!written && dynamicStart) w.Line("if (separator == '{') sb.Append('{');");
+            else if (!written) w.Line("sb.Append('{');");
+            w.Line("sb.Append('}');");
+            w.Close();
+        }
+
+        private static void EmitKey(CodeWriter w, string name, bool written, bool dynamicStart)
+        {
+            var key = "\"" + name + "\":";
+            if (written) w.Line($"sb.Append({Literal("," + key)});");
+            else if (dynamicStart) w.Line($"sb.Append(separator).Append({Literal(key)});");
+            else w.Line($"sb.Append({Literal("{" + key)});");
+        }
+
+        private static string PresenceCondition(WireField field, string access)
+        {
+            if (field.Nullable) return access + ".HasValue";
+
+            switch (field.Kind)
+            {
+                case FieldKind.String: return $"!string.IsNullOrEmpty({access})";
+                case FieldKind.Integer:
+                case FieldKind.Float: return access + " > 0";
+                case FieldKind.Bool: return access;
+                case FieldKind.Model: return access + " != null";
+                default: return $"{access} != null && {access}.Count > 0";
+            }
+        }
+
+        private static void EmitValue(CodeWriter w, WireField field, string access, bool withFrames)
+        {
+            if (field.Nullable)
+            {
+                if (field.Required)
+                {
+                    w.Line($"if (!{access}.HasValue) sb.Append(\"null\");");
+                    w.Line("else");
+                    w.Indent++;
+                    w.Line(PrimitiveAppend(field, access + ".Value"));
+                    w.Indent--;
+                }
+                else
+                {
+                    w.Line(PrimitiveAppend(field, access + ".Value"));
+                }
+                return;
+            }
+
+            switch (field.Kind)
+            {
+                case FieldKind.String:
+                case FieldKind.Integer:
+                case FieldKind.Float:
+                case FieldKind.Bool:
+                    w.Line(PrimitiveAppend(field, access));
+                    break;
+
+                case FieldKind.Model:
+                    w.Line(CarriesFrames(field.ValueType) && withFrames
+                        ? $"Append(sb, {access}, frameTable);"
+                        : $"Append(sb, {access});");
+                    break;
+
+                case FieldKind.StringDictionary:
+                case FieldKind.ObjectDictionary:
+                    var helper = field.Kind == FieldKind.StringDictionary ? "AppendStringDictionary" : "AppendObjectDictionary";
+                    if (field.Required) w.Line($"if ({access} == null) sb.Append(\"null\"); else {helper}(sb, {access});");
+                    else w.Line($"{helper}(sb, {access});");
+                    break;
+
+                case FieldKind.ModelList:
+                    if (field.Required)
+                    {
+                        w.Line($"if ({access} == null) sb.Append(\"null\");");
+                        w.Line("else");
+                        w.Open();
+                    }
+                    w.Line("sb.Append('[');");
+                    w.Line($"for (var i = 0; i < {access}.Count; i++)");
+                    w.Open();
+                    w.Line("if (i > 0) sb.Append(',');");
+                    w.Line($"Append(sb, {access}[i]);");
+                    w.Close();
+                    w.Line("sb.Append(']');");
+                    if (field.Required) w.Close();
+                    break;
+            }
+        }
+
+        private static string PrimitiveAppend(WireField field, string access)
+        {
+            switch (field.Kind)
+            {
+                case FieldKind.String: return $"AppendString(sb, {access});";
+                case FieldKind.Float: return $"AppendFloat(sb, {access});";
+                case FieldKind.Bool: return $"AppendBool(sb, {access});";
+                default: return $"sb.Append({access});";
+            }
+        }
+
+        #endregion
+
+        #region Decoder
+
+        public static string GenerateDecoder()
+        {
+            var models = CollectModels();
+
+            var w = new CodeWriter();
+            w.Raw(Header);
+            w.Line("using System.Collections.Generic;");
+            w.Line("using System.Runtime.CompilerServices;");
+            w.Line();
+            w.Line("namespace MoonForge.ErrorTracking.Editor");
+            w.Open();
+            w.Line("public static partial class WirePayloadDecoder");
+            w.Open();
+
+            foreach (var root in Roots)
+            {
+                EmitTryDecode(w, root);
+                w.Line();
+            }
+
+            var lists = new List<Type>();
+            for (var i = 0; i < models.Count; i++)
+            {
+                if (i > 0) w.Line();
+                EmitDecoder(w, models[i]);
+                foreach (var field in GetFields(models[i]))
+                {
+                    if (field.Kind == FieldKind.ModelList && !lists.Contains(field.ValueType)) lists.Add(field.ValueType);
+                }
+            }
+
+            foreach (var element in lists)
+            {
+                w.Line();
+                EmitListDecoder(w, element);
+            }
+
+            w.Close();
+            w.Close();
+            return w.ToString();
+        }
+
+        private static void EmitTryDecode(CodeWriter w, Type root)
+        {
+            w.Line($"public static bool TryDecode(string json, out {root.Name} value, out string error)");
+            w.Open();
+            w.Line("try");
+            w.Open();
+            w.Line("var reader = new WireJsonReader(json);");
+            w.Line($"value = Read{root.Name}(reader, \"\");");
+            w.Line("reader.EndOfInput();");
+            w.Line("error = value == null ? \"body is null\" : null;");
+            w.Line("return value != null;");
+            w.Close();
+            w.Line("catch (WireFormatException ex)");
+            w.Open();
+            w.Line("value = null;");
+            w.Line("error = ex.Message;");
+            w.Line("return false;");
+            w.Close();
+            w.Close();
+        }
+
+        private static void EmitDecoder(CodeWriter w, Type model)
+        {
+            var fields = GetFields(model);
+            var required = fields.Where(f => f.Required).Select(f => f.Name).ToList();
+            if (required.Count > 31) throw new NotSupportedException($"{model.Name} has more than 31 required fields");
+
+            if (required.Count > 0)
+            {
+                w.Line($"private static readonly string[] {model.Name}Required = {{ {string.Join(", ", required.Select(Literal))} }};");
+                w.Line();
+            }
+
+            w.Line($"public static {model.Name} Read{model.Name}(WireJsonReader reader, string path)");
+            w.Open();
+            w.Line("if (reader.ReadNull()) return null;");
+            w.Line();
+
+            // Models without a default constructor (Breadcrumb) are filled in field by field anyway
+            w.Line(model.GetConstructor(Type.EmptyTypes) != null
+                ? $"var value = new {model.Name}();"
+                : $"var value = ({model.Name})RuntimeHelpers.GetUninitializedObject(typeof({model.Name}));");
+            if (required.Count > 0) w.Line("var seen = 0;");
+            w.Line("reader.BeginObject();");
+            w.Line("while (reader.NextField(out var name))");
+            w.Open();
+            w.Line("switch (name)");
+            w.Open();
+            foreach (var field in fields)
+            {
+                w.Line($"case {Literal(field.Name)}:");
+                w.Indent++;
+                w.Line($"value.{field.Name} = {ReadExpression(field)};");
+                if (field.Required) w.Line($"seen |= {1 << required.IndexOf(field.Name)};");
+                w.Line("break;");
+                w.Indent--;
+            }
+            w.Line("default:");
+            w.Indent++;
+            w.Line("reader.SkipValue();");
+            w.Line("break;");
+            w.Indent--;
+            w.Close();
+            w.Close();
+
+            if (required.Count > 0) w.Line($"reader.RequireFields(path, seen, {model.Name}Required);");
+            w.Line("return value;");
+            w.Close();
+        }
+
+        private static string ReadExpression(WireField field)
+        {
+            var child = $"WireJsonReader.Child(path, {Literal(field.Name)})";
+            string read;
+            switch (field.Kind)
+            {
+                case FieldKind.String: return "reader.ReadString()";
+                case FieldKind.StringDictionary: return "reader.ReadStringDictionary()";
+                case FieldKind.ObjectDictionary: return "reader.ReadObjectDictionary()";
+                case FieldKind.Model: return $"Read{field.ValueType.Name}(reader, {child})";
+                case FieldKind.ModelList: return $"Read{field.ValueType.Name}List(reader, {child})";
+                case FieldKind.Bool: read = "reader.ReadBool()"; break;
+                case FieldKind.Float: read = "reader.ReadFloat()"; break;
+                default: read = field.ValueType == typeof(long) ? "reader.ReadLong()" : "reader.ReadInt()"; break;
+            }
+
+            return field.Nullable ? $"reader.ReadNull() ? ({TypeName(field.ValueType)}?)null : {read}" : read;
+        }
+
+        private static void EmitListDecoder(CodeWriter w, Type element)
+        {
+            w.Line($"private static List<{element.Name}> Read{element.Name}List(WireJsonReader reader, string path)");
+            w.Open();
+            w.Line("if (reader.ReadNull()) return null;");
+            w.Line();
+            w.Line($"var list = new List<{element.Name}>();");
+            w.Line("reader.BeginArray();");
+            w.Line("while (reader.NextElement())");
+            w.Open();
+            w.Line($"list.Add(Read{element.Name}(reader, path + \"[\" + list.Count + \"]\"));");
+            w.Close();
+            w.Line("return list;");
+            w.Close();
+        }
+
+        #endregion
+
+        private class CodeWriter
+        {
+            private readonly StringBuilder _sb = new StringBuilder();
+            public int Indent;
+
+            public void Raw(string text) => _sb.Append(text).Append('\n');
+
+            public void Line(string text = "")
+            {
+                if (text.Length > 0) _sb.Append(' ', Indent * 4).Append(text);
+                _sb.Append('\n');
+            }
+
+            public void Open()
+            {
+                Line("{");
+                Indent++;
+            }
+
+            public void Close()
+            {
+                Indent--;
+                Line("}");
+            }
+
+            public override string ToString() => _sb.ToString();
+        }
+    }
+}
@@ -5,8 +5,22 @@ LOCAL_PATH := $(call my-dir)
 include $(CLEAR_VARS)
 
 LOCAL_MODULE := moonforge_crash_handler
-LOCAL_SRC_FILES := moonforge_crash_handler.c
-LOCAL_LDLIBS := -llog -ldl
+LOCAL_SRC_FILES := moonforge_crash_handler.c \
+                   moonforge_thread_policy.c \
+                   moonforge_alloc_profiler.c \
+                   moonforge_plt_hook.c \
+                   moonforge_abort_message.c \
+                   moonforge_log_tail.c \
+                   moonforge_cpu_sampler.c \
+                   moonforge_device_sampler.c \
+                   moonforge_hitch_recorder.c \
+                   moonforge_session.c \
+                   moonforge_context_store.c \
+                   moonforge_unwind_ehabi.c \
+                   moonforge_fault_context.c \
+                   moonforge_lock_monitor.c \
+                   moonforge_signal_stack.c
+LOCAL_LDLIBS := -llog -ldl -lm
 LOCAL_CFLAGS := -Wall -Wextra -fvisibility=hidden
 
 # Enable unwind support
@@ -9,6 +9,7 @@ import android.telephony.TelephonyManager;
 import android.util.Log;
 
 import java.io.BufferedReader;
+import java.io.File;
 import java.io.FileReader;
 
 /**
@@ -28,7 +29,7 @@ public class MoonForgeCrashHandler {
     private boolean isInitialized = false;
 
     // Native methods
-    private native void nativeInit();
+    private native void nativeInit(String crashDirectory);
     private native void nativeShutdown();
     private native void nativeSimulateCrash(int crashType);
 
@@ -72,7 +73,7 @@ public class MoonForgeCrashHandler {
         }
 
         try {
-            nativeInit();
+            nativeInit(getCrashDirectory());
             isInitialized = true;
             Log.d(TAG, "Crash handler started");
         } catch (Exception e) {
@@ -97,6 +98,17 @@ public class MoonForgeCrashHandler {
         }
     }
 
+    /**
+     * Directory native crash records are written to, read back on next launch
+     */
+    public String getCrashDirectory() {
+        File directory = new File(context.getFilesDir(), "moonforge/crashes");
+        if (!directory.exists() && !directory.mkdirs()) {
+            Log.e(TAG, "Failed to create crash directory");
+        }
+        return directory.getAbsolutePath();
+    }
+
     /**
      * Get memory info
      * @return Array of [usedMB, availableMB]
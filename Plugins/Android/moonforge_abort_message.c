@@ -0,0 +1,212 @@
+/**
+ * MoonForge Abort Message Capture for Android (NDK) and Linux
+ *
+ * Two sources, read at crash time:
+ *
+ * 1. bionic keeps the message passed to android_set_abort_message in its own
+ *    anonymous mapping named "abort message" (magic-tagged since Android 10).
+ *    It is found through /proc/self/maps, which needs only open/read.
+ * 2. PLT hooks on __assert2 and android_set_abort_message copy the text into
+ *    a preallocated slot before the process aborts. This covers devices
+ *    where the mapping is not named or the message never reached it.
+ *
+ * glibc has no abort message, so on Linux only the slot is used, filled by a
+ * hook on __assert_fail.
+ */
+
+#include "moonforge_abort_message.h"
+#include "moonforge_plt_hook.h"
+
+#ifdef __ANDROID__
+#include <android/set_abort_message.h>
+#endif
+#include <assert.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#define LOG_TAG "MoonForgeCrash"
+#include "moonforge_log.h"
+
+#define ABORT_SLOT_SIZE 1024
+#define MAPS_CHUNK_SIZE 4096
+#define MAPS_LINE_SIZE 512
+
+// bionic's magic_abort_msg_t header (Android 10+)
+#define ABORT_MAGIC_1 0xb18e40886ac388f0ULL
+#define ABORT_MAGIC_2 0xc6dfba755a1de0b5ULL
+
+static char abortSlot[ABORT_SLOT_SIZE];
+static volatile int abortSlotLength = 0;
+
+#ifdef __ANDROID__
+static char mapsChunk[MAPS_CHUNK_SIZE];
+static char mapsLine[MAPS_LINE_SIZE];
+#endif
+
+static void storeMessage(const char* message) {
+    if (message == NULL) return;
+
+    size_t length = strlen(message);
+    if (length >= ABORT_SLOT_SIZE) length = ABORT_SLOT_SIZE - 1;
+    memcpy(abortSlot, message, length);
+    abortSlot[length] = '\0';
+    __atomic_store_n(&abortSlotLength, (int)length, __ATOMIC_RELEASE);
+}
+
+// Hooks
+
+#ifdef __ANDROID__
+
+static void hookedSetAbortMessage(const char* message) {
+    storeMessage(message);
+    android_set_abort_message(message);
+}
+
+__attribute__((noreturn))
+static void hookedAssert2(const char* file, int line, const char* function, const char* expression) {
+    // Same wording bionic uses, so reports match logcat
+    char message[ABORT_SLOT_SIZE];
+    snprintf(message, sizeof(message), "%s:%d: %s: assertion \"%s\" failed",
+             file ? file : "?", line, function ? function : "?", expression ? expression : "?");
+    storeMessage(message);
+    __assert2(file, line, function, expression);
+}
+
+#else
+
+// Declared by <assert.h> only without NDEBUG
+extern void __assert_fail(const char* expression, const char* file, unsigned int line, const char* function)
+    __attribute__((noreturn));
+
+__attribute__((noreturn))
+static void hookedAssertFail(const char* expression, const char* file, unsigned int line, const char* function) {
+    // Same wording glibc prints to stderr
+    char message[ABORT_SLOT_SIZE];
+    snprintf(message, sizeof(message), "%s:%u: %s: Assertion `%s' failed.",
+             file ? file : "?", line, function ? function : "?", expression ? expression : "?");
+    storeMessage(message);
+    __assert_fail(expression, file, line, function);
+}
+
+#endif
+
+void moonforge_abort_message_install(void) {
+#ifdef __ANDROID__
+    moonforge_plt_hook_register(NULL, "android_set_abort_message", (void*)hookedSetAbortMessage, NULL);
+    moonforge_plt_hook_register(NULL, "__assert2", (void*)hookedAssert2, NULL);
+#else
+    moonforge_plt_hook_register(NULL, "__assert_fail", (void*)hookedAssertFail, NULL);
+#endif
+    int patched = moonforge_plt_hook_refresh();
+    LOGD("Abort message hooks installed (%d import slots)", patched);
+}
+
+// bionic mapping
+
+#ifdef __ANDROID__
+
+static int parseHex(const char* text, const char* end, uintptr_t* value, const char** next) {
+    uintptr_t result = 0;
+    const char* p = text;
+    while (p < end) {
+        char c = *p;
+        int digit;
+        if (c >= '0' && c <= '9') digit = c - '0';
+        else if (c >= 'a' && c <= 'f') digit = c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F') digit = c - 'A' + 10;
+        else break;
+        result = (result << 4) | (uintptr_t)digit;
+        p++;
+    }
+    if (p == text) return 0;
+    *value = result;
+    *next = p;
+    return 1;
+}
+
+/**
+ * Find the mapping whose name contains "abort message". Async-signal-safe.
+ */
+static int findAbortMapping(uintptr_t* start, uintptr_t* end) {
+    int fd = open("/proc/self/maps", O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return 0;
+
+    size_t lineLength = 0;
+    int found = 0;
+    ssize_t count;
+
+    while (!found && (count = read(fd, mapsChunk, sizeof(mapsChunk))) > 0) {
+        for (ssize_t i = 0; i < count && !found; i++) {
+            char c = mapsChunk[i];
+            if (c != '\n') {
+                if (lineLength < MAPS_LINE_SIZE - 1) mapsLine[lineLength++] = c;
+                continue;
+            }
+
+            mapsLine[lineLength] = '\0';
+            if (strstr(mapsLine, "abort message") != NULL) {
+                const char* lineEnd = mapsLine + lineLength;
+                const char* p;
+                if (parseHex(mapsLine, lineEnd, start, &p) && p < lineEnd && *p == '-' &&
+                    parseHex(p + 1, lineEnd, end, &p)) {
+                    found = 1;
+                }
+            }
+            lineLength = 0;
+        }
+    }
+
+    close(fd);
+    return found;
+}
+
+static size_t readAbortMapping(char* buffer, size_t bufferSize) {
+    uintptr_t start;
+    uintptr_t end;
+    if (!findAbortMapping(&start, &end) || end <= start) return 0;
+
+    const char* message;
+    const uint64_t* magic = (const uint64_t*)start;
+    size_t header = sizeof(size_t);
+
+    if (end - start > 2 * sizeof(uint64_t) + header &&
+        magic[0] == ABORT_MAGIC_1 && magic[1] == ABORT_MAGIC_2) {
+        message = (const char*)(start + 2 * sizeof(uint64_t) + header);
+    } else if (end - start > header) {
+        // Older layout: abort_msg_t at the start of the mapping
+        message = (const char*)(start + header);
+    } else {
+        return 0;
+    }
+
+    size_t length = 0;
+    while ((uintptr_t)(message + length) < end && message[length] != '\0' && length < bufferSize - 1) {
+        length++;
+    }
+    memcpy(buffer, message, length);
+    buffer[length] = '\0';
+    return length;
+}
+
+#endif
+
+size_t moonforge_abort_message_read(char* buffer, size_t bufferSize) {
+    if (buffer == NULL || bufferSize == 0) return 0;
+
+    size_t length = 0;
+#ifdef __ANDROID__
+    length = readAbortMapping(buffer, bufferSize);
+    if (length > 0) return length;
+#endif
+
+    int slotLength = __atomic_load_n(&abortSlotLength, __ATOMIC_ACQUIRE);
+    if (slotLength <= 0) return 0;
+
+    length = (size_t)slotLength < bufferSize - 1 ? (size_t)slotLength : bufferSize - 1;
+    memcpy(buffer, abortSlot, length);
+    buffer[length] = '\0';
+    return length;
+}
@@ -0,0 +1,36 @@
+/**
+ * MoonForge Abort Message Capture for Android (NDK) and Linux
+ *
+ * Recovers the reason behind SIGABRT crashes: assertion text from __assert2
+ * (__assert_fail on glibc), messages passed to android_set_abort_message
+ * (libc++abi abort_message, fortify and other fatal checks) and bionic's own
+ * abort-message mapping.
+ */
+
+#ifndef MOONFORGE_ABORT_MESSAGE_H
+#define MOONFORGE_ABORT_MESSAGE_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Hook __assert2 and android_set_abort_message (__assert_fail on Linux) in loaded modules
+ */
+void moonforge_abort_message_install(void);
+
+/**
+ * Copy the abort message into buffer. Async-signal-safe.
+ * Prefers bionic's mapping (what the process actually aborted with) over
+ * text captured by the hooks.
+ * @return Length copied, 0 if no message is known
+ */
+size_t moonforge_abort_message_read(char* buffer, size_t bufferSize);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MOONFORGE_ABORT_MESSAGE_H
@@ -0,0 +1,572 @@
+/**
+ * MoonForge Allocation Profiler for Android (NDK)
+ *
+ * Sampling follows the heapprofd/tcmalloc scheme: each thread counts down an
+ * exponentially distributed number of bytes, and the allocation that crosses
+ * zero is sampled with a weight of one interval per crossing. The estimate of
+ * bytes per call site is unbiased and the cost for unsampled allocations is a
+ * subtraction and a branch.
+ *
+ * All state lives in fixed-size static tables so the profiler never calls the
+ * allocator it is observing. When a table is full, new samples are folded
+ * into an overflow call site rather than dropped.
+ */
+
+#define _GNU_SOURCE
+
+#include "moonforge_alloc_profiler.h"
+#include "moonforge_plt_hook.h"
+
+#include <dlfcn.h>
+#include <math.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+#include <unwind.h>
+
+#define LOG_TAG "MoonForgeAlloc"
+#include "moonforge_log.h"
+
+#define DEFAULT_SAMPLE_INTERVAL (512 * 1024)
+#define SITE_FRAMES 16
+#define SKIP_FRAMES 2              // sampleAllocation + the profiled entry point
+#define MAX_SITES 1024             // power of two
+#define OVERFLOW_SITE 0
+#define LIVE_SHARDS 64
+#define LIVE_SLOTS_PER_SHARD 256   // power of two
+#define MAX_THREAD_STATES 512
+
+// Call site: a unique stack and what it has allocated
+typedef struct {
+    uint64_t hash;
+    int depth;
+    uintptr_t frames[SITE_FRAMES];
+    int64_t liveBytes;
+    int64_t liveCount;
+    int64_t totalBytes;
+} CallSite;
+
+// Sampled allocation that has not been freed yet
+typedef struct {
+    uintptr_t address;
+    uint32_t site;
+    uint32_t samples;
+} LiveAllocation;
+
+typedef struct {
+    atomic_flag lock;
+    atomic_int count;
+    LiveAllocation slots[LIVE_SLOTS_PER_SHARD];
+} LiveShard;
+
+// Per-thread sampler state. ELF TLS needs API 29 and emulated TLS allocates,
+// so states come from a fixed pool and are found through a pthread key.
+typedef struct {
+    atomic_int inUse;
+    int64_t bytesUntilSample;
+    uint64_t rng;
+    uintptr_t stackLow;
+    uintptr_t stackHigh;
+    int busy;
+} ThreadState;
+
+static atomic_int running = 0;
+static int64_t sampleInterval = DEFAULT_SAMPLE_INTERVAL;
+
+static CallSite sites[MAX_SITES];
+static int siteCount = 1;          // slot 0 is the overflow site
+static atomic_flag sitesLock = ATOMIC_FLAG_INIT;
+
+static LiveShard liveShards[LIVE_SHARDS];
+static atomic_llong sampledLiveBytes = 0;
+
+static ThreadState threadStates[MAX_THREAD_STATES];
+static ThreadState sharedState;    // used when the pool is exhausted
+static atomic_flag sharedStateLock = ATOMIC_FLAG_INIT;
+static pthread_key_t threadKey;
+static pthread_once_t keyOnce = PTHREAD_ONCE_INIT;
+
+static void spinLock(atomic_flag* lock) {
+    while (atomic_flag_test_and_set_explicit(lock, memory_order_acquire)) {
+        sched_yield();
+    }
+}
+
+static void spinUnlock(atomic_flag* lock) {
+    atomic_flag_clear_explicit(lock, memory_order_release);
+}
+
+// Sampling
+
+static uint64_t nextRandom(ThreadState* state) {
+    // xorshift64*
+    uint64_t x = state->rng;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    state->rng = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+static int64_t nextSampleDistance(ThreadState* state) {
+    // Exponential with mean sampleInterval; u in (0, 1]
+    double u = ((nextRandom(state) >> 11) + 1) * (1.0 / 9007199254740992.0);
+    int64_t distance = (int64_t)(-log(u) * (double)sampleInterval);
+    return distance > 0 ? distance : 1;
+}
+
+static void releaseThreadState(void* value) {
+    ThreadState* state = (ThreadState*)value;
+    if (state != NULL && state != &sharedState) {
+        atomic_store(&state->inUse, 0);
+    }
+}
+
+static void createThreadKey(void) {
+    pthread_key_create(&threadKey, releaseThreadState);
+}
+
+static void initThreadState(ThreadState* state) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    state->rng = ((uint64_t)gettid() << 32) ^ (uint64_t)now.tv_nsec ^ (uintptr_t)state;
+    if (state->rng == 0) state->rng = 0x9E3779B97F4A7C15ULL;
+    state->bytesUntilSample = nextSampleDistance(state);
+    state->stackLow = 0;
+    state->stackHigh = 0;
+
+    pthread_attr_t attr;
+    if (pthread_getattr_np(pthread_self(), &attr) == 0) {
+        void* base;
+        size_t size;
+        if (pthread_attr_getstack(&attr, &base, &size) == 0) {
+            state->stackLow = (uintptr_t)base;
+            state->stackHigh = (uintptr_t)base + size;
+        }
+        pthread_attr_destroy(&attr);
+    }
+}
+
+static ThreadState* acquireThreadState(void) {
+    ThreadState* state = (ThreadState*)pthread_getspecific(threadKey);
+    if (state != NULL) return state;
+
+    for (int i = 0; i < MAX_THREAD_STATES; i++) {
+        int expected = 0;
+        if (atomic_compare_exchange_strong(&threadStates[i].inUse, &expected, 1)) {
+            state = &threadStates[i];
+            break;
+        }
+    }
+
+    if (state == NULL) return NULL;
+
+    // Busy while initializing: pthread_getattr_np may allocate on the main thread
+    state->busy = 1;
+    pthread_setspecific(threadKey, state);
+    initThreadState(state);
+    state->busy = 0;
+    return state;
+}
+
+// Stack capture
+
+#if defined(__arm__)
+struct UnwindState {
+    uintptr_t* current;
+    uintptr_t* end;
+    int skip;
+};
+
+static _Unwind_Reason_Code unwindCallback(struct _Unwind_Context* context, void* arg) {
+    struct UnwindState* state = (struct UnwindState*)arg;
+    uintptr_t pc = _Unwind_GetIP(context);
+    if (pc == 0) return _URC_NO_REASON;
+    if (state->skip > 0) {
+        state->skip--;
+        return _URC_NO_REASON;
+    }
+    if (state->current == state->end) return _URC_END_OF_STACK;
+    *state->current++ = pc;
+    return _URC_NO_REASON;
+}
+#endif
+
+/**
+ * Frame-pointer walk on arm64/x86/x86_64, where each frame record is
+ * [previous fp, return address]. 32-bit ARM has no usable frame-record
+ * convention across ARM/Thumb code, so it falls back to the EHABI unwinder.
+ */
+__attribute__((noinline))
+static int captureStack(ThreadState* state, uintptr_t* frames, int maxFrames) {
+#if defined(__arm__)
+    (void)state;
+    // The unwinder also reports captureStack itself
+    struct UnwindState unwind = { frames, frames + maxFrames, SKIP_FRAMES + 1 };
+    _Unwind_Backtrace(unwindCallback, &unwind);
+    return (int)(unwind.current - frames);
+#else
+    uintptr_t fp = (uintptr_t)__builtin_frame_address(0);
+    uintptr_t low = state->stackLow ? state->stackLow : fp;
+    uintptr_t high = state->stackHigh ? state->stackHigh : fp + 1024 * 1024;
+    int depth = 0;
+    int skip = SKIP_FRAMES;
+
+    while (depth < maxFrames) {
+        if (fp < low || fp + 2 * sizeof(uintptr_t) > high || (fp & (sizeof(uintptr_t) - 1)) != 0) break;
+
+        uintptr_t next = ((uintptr_t*)fp)[0];
+        uintptr_t pc = ((uintptr_t*)fp)[1];
+        if (pc == 0) break;
+
+        if (skip > 0) {
+            skip--;
+        } else {
+            // Return address points after the call; step back into it
+            frames[depth++] = pc - 1;
+        }
+
+        // Frames grow down, so callers are at higher addresses
+        if (next <= fp) break;
+        fp = next;
+    }
+    return depth;
+#endif
+}
+
+static uint64_t hashStack(const uintptr_t* frames, int depth) {
+    uint64_t hash = 1469598103934665603ULL;
+    for (int i = 0; i < depth; i++) {
+        hash ^= (uint64_t)frames[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash ? hash : 1;
+}
+
+// Tables
+
+/**
+ * Find or create the call site for a stack. Caller holds sitesLock.
+ */
+static uint32_t internSite(const uintptr_t* frames, int depth) {
+    uint64_t hash = hashStack(frames, depth);
+    uint32_t index = (uint32_t)(hash & (MAX_SITES - 1));
+
+    for (int probe = 0; probe < MAX_SITES; probe++) {
+        if (index != OVERFLOW_SITE) {
+            CallSite* site = &sites[index];
+            if (site->hash == hash && site->depth == depth) {
+                return index;
+            }
+            if (site->hash == 0) {
+                // Keep the table at most 3/4 full so probes stay short
+                if (siteCount >= MAX_SITES * 3 / 4) return OVERFLOW_SITE;
+                site->hash = hash;
+                site->depth = depth;
+                memcpy(site->frames, frames, depth * sizeof(uintptr_t));
+                siteCount++;
+                return index;
+            }
+        }
+        index = (index + 1) & (MAX_SITES - 1);
+    }
+    return OVERFLOW_SITE;
+}
+
+static uint32_t pointerHash(uintptr_t address) {
+    uint64_t x = (uint64_t)address;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return (uint32_t)x;
+}
+
+static void insertLive(uintptr_t address, uint32_t site, uint32_t samples) {
+    uint32_t hash = pointerHash(address);
+    LiveShard* shard = &liveShards[hash & (LIVE_SHARDS - 1)];
+    uint32_t slot = (hash >> 6) & (LIVE_SLOTS_PER_SHARD - 1);
+
+    spinLock(&shard->lock);
+    int inserted = 0;
+    if (atomic_load_explicit(&shard->count, memory_order_relaxed) < LIVE_SLOTS_PER_SHARD - 1) {
+        while (shard->slots[slot].address != 0) {
+            slot = (slot + 1) & (LIVE_SLOTS_PER_SHARD - 1);
+        }
+        shard->slots[slot].address = address;
+        shard->slots[slot].site = site;
+        shard->slots[slot].samples = samples;
+        atomic_fetch_add_explicit(&shard->count, 1, memory_order_relaxed);
+        inserted = 1;
+    }
+    spinUnlock(&shard->lock);
+
+    // A full shard loses live tracking for this sample but keeps its total
+    if (!inserted) return;
+
+    int64_t bytes = (int64_t)samples * sampleInterval;
+    spinLock(&sitesLock);
+    sites[site].liveBytes += bytes;
+    sites[site].liveCount++;
+    spinUnlock(&sitesLock);
+    atomic_fetch_add_explicit(&sampledLiveBytes, bytes, memory_order_relaxed);
+}
+
+/**
+ * Remove an address from the live table if it was sampled.
+ * Unsampled frees take the early exit on an empty shard or one probe miss.
+ */
+static void removeLive(uintptr_t address) {
+    uint32_t hash = pointerHash(address);
+    LiveShard* shard = &liveShards[hash & (LIVE_SHARDS - 1)];
+    if (atomic_load_explicit(&shard->count, memory_order_relaxed) == 0) return;
+
+    uint32_t slot = (hash >> 6) & (LIVE_SLOTS_PER_SHARD - 1);
+    uint32_t site = 0;
+    uint32_t samples = 0;
+
+    spinLock(&shard->lock);
+    while (shard->slots[slot].address != 0) {
+        if (shard->slots[slot].address == address) {
+            site = shard->slots[slot].site;
+            samples = shard->slots[slot].samples;
+
+            // Backward-shift deletion keeps probe chains intact without tombstones
+            uint32_t hole = slot;
+            uint32_t next = (slot + 1) & (LIVE_SLOTS_PER_SHARD - 1);
+            while (shard->slots[next].address != 0) {
+                uint32_t home = (pointerHash(shard->slots[next].address) >> 6) & (LIVE_SLOTS_PER_SHARD - 1);
+                int movable = (hole <= next) ? (home <= hole || home > next) : (home <= hole && home > next);
+                if (movable) {
+                    shard->slots[hole] = shard->slots[next];
+                    hole = next;
+                }
+                next = (next + 1) & (LIVE_SLOTS_PER_SHARD - 1);
+            }
+            shard->slots[hole].address = 0;
+            atomic_fetch_sub_explicit(&shard->count, 1, memory_order_relaxed);
+            break;
+        }
+        slot = (slot + 1) & (LIVE_SLOTS_PER_SHARD - 1);
+    }
+    spinUnlock(&shard->lock);
+
+    if (samples == 0) return;
+
+    int64_t bytes = (int64_t)samples * sampleInterval;
+    spinLock(&sitesLock);
+    sites[site].liveBytes -= bytes;
+    sites[site].liveCount--;
+    spinUnlock(&sitesLock);
+    atomic_fetch_sub_explicit(&sampledLiveBytes, bytes, memory_order_relaxed);
+}
+
+__attribute__((noinline))
+static void sampleAllocation(ThreadState* state, uintptr_t address, uint32_t samples) {
+    uintptr_t frames[SITE_FRAMES];
+    int depth = captureStack(state, frames, SITE_FRAMES);
+
+    spinLock(&sitesLock);
+    uint32_t site = internSite(frames, depth);
+    sites[site].totalBytes += (int64_t)samples * sampleInterval;
+    spinUnlock(&sitesLock);
+
+    insertLive(address, site, samples);
+}
+
+/**
+ * Account for an allocation of size bytes at address
+ */
+static inline void recordAllocation(void* address, size_t size) {
+    if (address == NULL || !atomic_load_explicit(&running, memory_order_relaxed)) return;
+
+    ThreadState* state = acquireThreadState();
+    int shared = 0;
+    if (state == NULL) {
+        spinLock(&sharedStateLock);
+        state = &sharedState;
+        shared = 1;
+    }
+
+    if (!state->busy) {
+        state->bytesUntilSample -= (int64_t)size;
+        if (state->bytesUntilSample <= 0) {
+            // One sample per interval crossed keeps large allocations correctly weighted
+            uint32_t samples = 0;
+            while (state->bytesUntilSample <= 0) {
+                state->bytesUntilSample += nextSampleDistance(state);
+                samples++;
+            }
+
+            state->busy = 1;
+            sampleAllocation(state, (uintptr_t)address, samples);
+            state->busy = 0;
+        }
+    }
+
+    if (shared) spinUnlock(&sharedStateLock);
+}
+
+static inline void recordFree(void* address) {
+    if (address == NULL) return;
+    // Frees are tracked even after Stop so live totals stay balanced
+    removeLive((uintptr_t)address);
+}
+
+// Profiled entry points
+
+void* moonforge_profiled_malloc(size_t size) {
+    void* result = malloc(size);
+    recordAllocation(result, size);
+    return result;
+}
+
+void* moonforge_profiled_calloc(size_t count, size_t size) {
+    void* result = calloc(count, size);
+    recordAllocation(result, count * size);
+    return result;
+}
+
+void* moonforge_profiled_realloc(void* ptr, size_t size) {
+    // Forget the old block first: once realloc frees it, another thread may be handed the same address.
+    // A failed realloc loses that sample, which only under-counts.
+    recordFree(ptr);
+    void* result = realloc(ptr, size);
+    recordAllocation(result, size);
+    return result;
+}
+
+void moonforge_profiled_free(void* ptr) {
+    recordFree(ptr);
+    free(ptr);
+}
+
+void* moonforge_profiled_mmap(void* addr, size_t length, int prot, int flags, int fd, off_t offset) {
+    void* result = mmap(addr, length, prot, flags, fd, offset);
+    // File mappings are not heap growth
+    if (result != MAP_FAILED && (flags & MAP_ANONYMOUS)) {
+        recordAllocation(result, length);
+    }
+    return result;
+}
+
+int moonforge_profiled_munmap(void* addr, size_t length) {
+    // Only whole-mapping unmaps are matched; partial unmaps keep their sample
+    recordFree(addr);
+    return munmap(addr, length);
+}
+
+// Public API
+
+MOONFORGE_EXPORT int MoonForge_AllocProfiler_Start(int sampleIntervalBytes) {
+    if (atomic_load(&running)) return 1;
+
+    pthread_once(&keyOnce, createThreadKey);
+    sampleInterval = sampleIntervalBytes > 0 ? sampleIntervalBytes : DEFAULT_SAMPLE_INTERVAL;
+
+    initThreadState(&sharedState);
+
+    atomic_store(&running, 1);
+
+    // libc's own calls (e.g. malloc growing its arenas with mmap) are not the app's allocations
+    moonforge_plt_hook_ignore("/libc.so");
+    moonforge_plt_hook_register(NULL, "malloc", (void*)moonforge_profiled_malloc, NULL);
+    moonforge_plt_hook_register(NULL, "calloc", (void*)moonforge_profiled_calloc, NULL);
+    moonforge_plt_hook_register(NULL, "realloc", (void*)moonforge_profiled_realloc, NULL);
+    moonforge_plt_hook_register(NULL, "free", (void*)moonforge_profiled_free, NULL);
+    moonforge_plt_hook_register(NULL, "mmap", (void*)moonforge_profiled_mmap, NULL);
+    moonforge_plt_hook_register(NULL, "munmap", (void*)moonforge_profiled_munmap, NULL);
+    int patched = moonforge_plt_hook_refresh();
+
+    LOGD("Allocation profiler started (interval %lld bytes, %d import slots)", (long long)sampleInterval, patched);
+    return 1;
+}
+
+MOONFORGE_EXPORT void MoonForge_AllocProfiler_Stop(void) {
+    if (!atomic_exchange(&running, 0)) return;
+
+    moonforge_plt_hook_unregister((void*)moonforge_profiled_malloc);
+    moonforge_plt_hook_unregister((void*)moonforge_profiled_calloc);
+    moonforge_plt_hook_unregister((void*)moonforge_profiled_realloc);
+    moonforge_plt_hook_unregister((void*)moonforge_profiled_free);
+    moonforge_plt_hook_unregister((void*)moonforge_profiled_mmap);
+    moonforge_plt_hook_unregister((void*)moonforge_profiled_munmap);
+}
+
+MOONFORGE_EXPORT int MoonForge_AllocProfiler_IsRunning(void) {
+    return atomic_load(&running);
+}
+
+MOONFORGE_EXPORT int64_t MoonForge_AllocProfiler_GetSampledLiveBytes(void) {
+    return atomic_load_explicit(&sampledLiveBytes, memory_order_relaxed);
+}
+
+#define SNAPSHOT_MAX_SITES 32
+
+MOONFORGE_EXPORT int MoonForge_AllocProfiler_Snapshot(char* buffer, int bufferSize, int maxSites) {
+    if (buffer == NULL || bufferSize <= 0) return 0;
+    if (maxSites <= 0 || maxSites > SNAPSHOT_MAX_SITES) maxSites = SNAPSHOT_MAX_SITES;
+
+    CallSite top[SNAPSHOT_MAX_SITES];
+    int topCount = 0;
+
+    // Copy the largest sites out under the lock; symbolize after releasing it
+    spinLock(&sitesLock);
+    for (int i = 0; i < MAX_SITES; i++) {
+        const CallSite* site = &sites[i];
+        if (site->liveBytes <= 0) continue;
+
+        int position = topCount;
+        while (position > 0 && top[position - 1].liveBytes < site->liveBytes) {
+            position--;
+        }
+        if (position >= maxSites) continue;
+
+        int last = topCount < maxSites ? topCount : maxSites - 1;
+        for (int j = last; j > position; j--) {
+            top[j] = top[j - 1];
+        }
+        top[position] = *site;
+        if (topCount < maxSites) topCount++;
+    }
+    spinUnlock(&sitesLock);
+
+    size_t offset = 0;
+    size_t size = (size_t)bufferSize;
+    offset += snprintf(buffer + offset, size - offset,
+        "Sampled live native memory: %lld bytes (interval %lld bytes)\n",
+        (long long)MoonForge_AllocProfiler_GetSampledLiveBytes(), (long long)sampleInterval);
+
+    for (int i = 0; i < topCount && offset < size - 1; i++) {
+        const CallSite* site = &top[i];
+        offset += snprintf(buffer + offset, size - offset,
+            "Site %d: %lld bytes live in %lld samples, %lld bytes allocated%s\n",
+            i + 1, (long long)site->liveBytes, (long long)site->liveCount, (long long)site->totalBytes,
+            site->hash == 0 ? " (untracked call sites)" : "");
+
+        for (int f = 0; f < site->depth && offset < size - 1; f++) {
+            Dl_info info;
+            const char* module = "???";
+            const char* symbol = "";
+            uintptr_t moduleOffset = site->frames[f];
+
+            if (dladdr((void*)site->frames[f], &info) && info.dli_fname) {
+                const char* lastSlash = strrchr(info.dli_fname, '/');
+                module = lastSlash ? lastSlash + 1 : info.dli_fname;
+                moduleOffset = site->frames[f] - (uintptr_t)info.dli_fbase;
+                if (info.dli_sname) symbol = info.dli_sname;
+            }
+
+            offset += snprintf(buffer + offset, size - offset,
+                "  #%02d %s+0x%lx %s\n", f, module, (unsigned long)moduleOffset, symbol);
+        }
+    }
+
+    if (offset >= size) offset = size - 1;
+    return (int)offset;
+}
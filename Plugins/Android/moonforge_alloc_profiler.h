@@ -0,0 +1,72 @@
+/**
+ * MoonForge Allocation Profiler for Android (NDK)
+ *
+ * Poisson-sampled native allocation profiler. About one allocation per
+ * sampling interval of allocated bytes has its call stack recorded; live
+ * sampled allocations are attributed to their call site so the largest
+ * consumers of native memory can be reported before an OOM.
+ */
+
+#ifndef MOONFORGE_ALLOC_PROFILER_H
+#define MOONFORGE_ALLOC_PROFILER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef MOONFORGE_EXPORT
+#define MOONFORGE_EXPORT __attribute__((visibility("default")))
+#endif
+
+/**
+ * Start sampling
+ * @param sampleIntervalBytes Mean bytes allocated between samples (0 = default 512 KB)
+ * @return 1 if the profiler is running
+ */
+MOONFORGE_EXPORT int MoonForge_AllocProfiler_Start(int sampleIntervalBytes);
+
+/**
+ * Stop sampling and remove the allocator hooks. Tables are kept so a
+ * final snapshot can still be taken.
+ */
+MOONFORGE_EXPORT void MoonForge_AllocProfiler_Stop(void);
+
+/**
+ * Check if the profiler is sampling
+ */
+MOONFORGE_EXPORT int MoonForge_AllocProfiler_IsRunning(void);
+
+/**
+ * Estimated live bytes held by sampled allocations
+ */
+MOONFORGE_EXPORT int64_t MoonForge_AllocProfiler_GetSampledLiveBytes(void);
+
+/**
+ * Write the top call sites by live bytes as text
+ * @param buffer Output buffer
+ * @param bufferSize Size of buffer
+ * @param maxSites Number of call sites to include
+ * @return Number of characters written (excluding terminator)
+ */
+MOONFORGE_EXPORT int MoonForge_AllocProfiler_Snapshot(char* buffer, int bufferSize, int maxSites);
+
+/**
+ * Profiled allocator entry points. These call through to libc and record
+ * samples; Start installs them in other modules' import tables.
+ */
+void* moonforge_profiled_malloc(size_t size);
+void* moonforge_profiled_calloc(size_t count, size_t size);
+void* moonforge_profiled_realloc(void* ptr, size_t size);
+void moonforge_profiled_free(void* ptr);
+void* moonforge_profiled_mmap(void* addr, size_t length, int prot, int flags, int fd, off_t offset);
+int moonforge_profiled_munmap(void* addr, size_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MOONFORGE_ALLOC_PROFILER_H
@@ -0,0 +1,349 @@
+/**
+ * MoonForge Context Store for Android (NDK) and Linux
+ *
+ * Entries live in a fixed table; a key is found by a linear scan, which is
+ * cheaper than hashing at this size. Writers serialize on a mutex and bracket
+ * each change with two increments of the sequence number, so it is odd while
+ * a change is in progress and version = sequence / 2. The crash handler copies
+ * the table and retries if the sequence moved or was odd; it gives up after a
+ * bounded number of attempts, since the writer may be the thread that crashed.
+ */
+
+#define _GNU_SOURCE
+
+#include "moonforge_context_store.h"
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define LOG_TAG "MoonForgeContext"
+#include "moonforge_log.h"
+
+#define CONTEXT_MAX_ENTRIES 128
+#define CONTEXT_KEY_SIZE 64
+#define CONTEXT_TEXT_SIZE 256
+
+// Copies the crash handler makes before settling for a torn snapshot
+#define SNAPSHOT_ATTEMPTS 1000
+
+struct ContextEntry {
+    uint8_t used;
+    uint8_t scope;
+    uint8_t type;
+    char key[CONTEXT_KEY_SIZE];
+    union {
+        long long integer;
+        double number;
+    } value;
+    char text[CONTEXT_TEXT_SIZE];
+};
+
+static struct ContextEntry entries[CONTEXT_MAX_ENTRIES];
+static uint32_t sequence = 0;
+
+static pthread_mutex_t writeLock = PTHREAD_MUTEX_INITIALIZER;
+
+// Longest formatted entry: both strings fully escaped, plus the field names
+#define ENTRY_SCRATCH_SIZE 2048
+
+// Copy and scratch of each lock-free reader, so the lock monitor's worker
+// can format a snapshot while the signal handler does the same
+struct ContextReader {
+    struct ContextEntry snapshot[CONTEXT_MAX_ENTRIES];
+    char scratch[ENTRY_SCRATCH_SIZE];
+};
+
+static struct ContextReader readers[MOONFORGE_CONTEXT_READER_COUNT];
+
+// Seqlock
+
+static void beginWrite(void) {
+    __atomic_store_n(&sequence, sequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+static int endWrite(void) {
+    uint32_t next = sequence + 1;
+    __atomic_store_n(&sequence, next, __ATOMIC_RELEASE);
+    return (int)(next >> 1);
+}
+
+static int currentVersion(void) {
+    return (int)(__atomic_load_n(&sequence, __ATOMIC_ACQUIRE) >> 1);
+}
+
+/**
+ * Copy the table into out.
+ * @return 1 if the copy is consistent, 0 if a write was still in progress
+ */
+static int readSnapshot(struct ContextEntry* out, uint32_t* version) {
+    for (int attempt = 0; attempt < SNAPSHOT_ATTEMPTS; attempt++) {
+        uint32_t before = __atomic_load_n(&sequence, __ATOMIC_ACQUIRE);
+        if (before & 1) continue;
+
+        memcpy(out, entries, sizeof(entries));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&sequence, __ATOMIC_RELAXED) == before) {
+            *version = before >> 1;
+            return 1;
+        }
+    }
+
+    memcpy(out, entries, sizeof(entries));
+    *version = __atomic_load_n(&sequence, __ATOMIC_RELAXED) >> 1;
+    return 0;
+}
+
+// Table (callers hold writeLock)
+
+static int findEntry(int scope, const char* key) {
+    for (int i = 0; i < CONTEXT_MAX_ENTRIES; i++) {
+        if (entries[i].used && entries[i].scope == scope && strcmp(entries[i].key, key) == 0) return i;
+    }
+    return -1;
+}
+
+static int findFree(void) {
+    for (int i = 0; i < CONTEXT_MAX_ENTRIES; i++) {
+        if (!entries[i].used) return i;
+    }
+    return -1;
+}
+
+// Copy at most size - 1 bytes, backing off to the start of a UTF-8 character
+static void copyUtf8(char* out, size_t size, const char* in) {
+    size_t length = strlen(in);
+    if (length >= size) {
+        length = size - 1;
+        while (length > 0 && ((unsigned char)in[length] & 0xC0) == 0x80) length--;
+    }
+    memcpy(out, in, length);
+    out[length] = '\0';
+}
+
+static int validKey(int scope, const char* key) {
+    return scope >= 0 && scope < MOONFORGE_CONTEXT_SCOPE_COUNT && key != NULL && key[0] != '\0';
+}
+
+static int setEntry(int scope, const char* key, int type, long long integer, double number, const char* text) {
+    if (!validKey(scope, key)) return 0;
+
+    char truncatedKey[CONTEXT_KEY_SIZE];
+    copyUtf8(truncatedKey, sizeof(truncatedKey), key);
+
+    pthread_mutex_lock(&writeLock);
+
+    int index = findEntry(scope, truncatedKey);
+    if (index < 0) index = findFree();
+    if (index < 0) {
+        pthread_mutex_unlock(&writeLock);
+        LOGE("Context store full, dropping %s", truncatedKey);
+        return 0;
+    }
+
+    beginWrite();
+    struct ContextEntry* entry = &entries[index];
+    entry->scope = (uint8_t)scope;
+    entry->type = (uint8_t)type;
+    memcpy(entry->key, truncatedKey, sizeof(truncatedKey));
+    if (type == MOONFORGE_CONTEXT_DOUBLE) {
+        entry->value.number = number;
+    } else {
+        entry->value.integer = integer;
+    }
+    if (text != NULL) {
+        copyUtf8(entry->text, sizeof(entry->text), text);
+    } else {
+        entry->text[0] = '\0';
+    }
+    entry->used = 1;
+    int version = endWrite();
+
+    pthread_mutex_unlock(&writeLock);
+    return version;
+}
+
+// JSON
+
+// Append in as a JSON string body; 0 if it does not fit. Async-signal-safe.
+static size_t appendEscaped(char* out, size_t outSize, const char* in) {
+    static const char hex[] = "0123456789abcdef";
+    size_t o = 0;
+
+    for (size_t i = 0; in[i] != '\0'; i++) {
+        unsigned char c = (unsigned char)in[i];
+        if (o + 7 >= outSize) return 0;
+        if (c == '"' || c == '\\') {
+            out[o++] = '\\';
+            out[o++] = (char)c;
+        } else if (c == '\n') {
+            out[o++] = '\\';
+            out[o++] = 'n';
+        } else if (c < 0x20) {
+            out[o++] = '\\';
+            out[o++] = 'u';
+            out[o++] = '0';
+            out[o++] = '0';
+            out[o++] = hex[c >> 4];
+            out[o++] = hex[c & 0xf];
+        } else {
+            out[o++] = (char)c;
+        }
+    }
+    out[o] = '\0';
+    return o;
+}
+
+// Format one entry into scratch (ENTRY_SCRATCH_SIZE bytes); 0 if it is too long
+static size_t formatEntry(char* scratch, const struct ContextEntry* entry, int first) {
+    size_t offset = 0;
+    int written = snprintf(scratch, ENTRY_SCRATCH_SIZE, "%s{\"scope\":%d,\"type\":%d,\"key\":\"",
+                           first ? "" : ",", entry->scope, entry->type);
+    if (written < 0) return 0;
+    offset = (size_t)written;
+
+    size_t escaped = appendEscaped(scratch + offset, ENTRY_SCRATCH_SIZE - offset, entry->key);
+    if (escaped == 0) return 0;
+    offset += escaped;
+
+    written = snprintf(scratch + offset, ENTRY_SCRATCH_SIZE - offset, "\",\"value\":\"");
+    if (written < 0) return 0;
+    offset += (size_t)written;
+
+    switch (entry->type) {
+        case MOONFORGE_CONTEXT_LONG:
+            written = snprintf(scratch + offset, ENTRY_SCRATCH_SIZE - offset, "%lld", entry->value.integer);
+            break;
+        case MOONFORGE_CONTEXT_DOUBLE:
+            written = snprintf(scratch + offset, ENTRY_SCRATCH_SIZE - offset, "%.17g", entry->value.number);
+            break;
+        case MOONFORGE_CONTEXT_BOOL:
+            written = snprintf(scratch + offset, ENTRY_SCRATCH_SIZE - offset, "%s",
+                               entry->value.integer ? "true" : "false");
+            break;
+        default:
+            written = 0;
+            if (entry->text[0] != '\0') {
+                size_t text = appendEscaped(scratch + offset, ENTRY_SCRATCH_SIZE - offset, entry->text);
+                if (text == 0) return 0;
+                written = (int)text;
+            }
+            break;
+    }
+    if (written < 0) return 0;
+    offset += (size_t)written;
+
+    if (offset + 3 > ENTRY_SCRATCH_SIZE) return 0;
+    scratch[offset++] = '"';
+    scratch[offset++] = '}';
+    scratch[offset] = '\0';
+    return offset;
+}
+
+static size_t formatSnapshot(char* buffer, size_t bufferSize, char* scratch,
+                             struct ContextEntry* source, uint32_t version, int consistent) {
+    int written = snprintf(buffer, bufferSize, "{\"version\":%u,\"torn\":%s,\"entries\":[",
+                           version, consistent ? "false" : "true");
+    if (written < 0 || (size_t)written >= bufferSize - 2) {
+        buffer[0] = '\0';
+        return 0;
+    }
+    size_t offset = (size_t)written;
+
+    int count = 0;
+    for (int i = 0; i < CONTEXT_MAX_ENTRIES; i++) {
+        struct ContextEntry* entry = &source[i];
+        if (!entry->used) continue;
+
+        // A torn copy may have lost its terminators
+        if (!consistent) {
+            entry->key[CONTEXT_KEY_SIZE - 1] = '\0';
+            entry->text[CONTEXT_TEXT_SIZE - 1] = '\0';
+        }
+
+        size_t length = formatEntry(scratch, entry, count == 0);
+        if (length == 0 || offset + length + 2 >= bufferSize) continue;
+        memcpy(buffer + offset, scratch, length);
+        offset += length;
+        count++;
+    }
+
+    if (count == 0) {
+        buffer[0] = '\0';
+        return 0;
+    }
+    buffer[offset++] = ']';
+    buffer[offset++] = '}';
+    buffer[offset] = '\0';
+    return offset;
+}
+
+// Public API
+
+int MoonForge_Context_SetString(int scope, const char* key, const char* value) {
+    if (value == NULL) return MoonForge_Context_Remove(scope, key);
+    return setEntry(scope, key, MOONFORGE_CONTEXT_STRING, 0, 0, value);
+}
+
+int MoonForge_Context_SetLong(int scope, const char* key, long long value) {
+    return setEntry(scope, key, MOONFORGE_CONTEXT_LONG, value, 0, NULL);
+}
+
+int MoonForge_Context_SetDouble(int scope, const char* key, double value) {
+    return setEntry(scope, key, MOONFORGE_CONTEXT_DOUBLE, 0, value, NULL);
+}
+
+int MoonForge_Context_SetBool(int scope, const char* key, int value) {
+    return setEntry(scope, key, MOONFORGE_CONTEXT_BOOL, value != 0, 0, NULL);
+}
+
+int MoonForge_Context_Remove(int scope, const char* key) {
+    if (!validKey(scope, key)) return currentVersion();
+
+    char truncatedKey[CONTEXT_KEY_SIZE];
+    copyUtf8(truncatedKey, sizeof(truncatedKey), key);
+
+    pthread_mutex_lock(&writeLock);
+    int version = currentVersion();
+    int index = findEntry(scope, truncatedKey);
+    if (index >= 0) {
+        beginWrite();
+        entries[index].used = 0;
+        version = endWrite();
+    }
+    pthread_mutex_unlock(&writeLock);
+    return version;
+}
+
+int MoonForge_Context_Clear(int scope) {
+    pthread_mutex_lock(&writeLock);
+    beginWrite();
+    for (int i = 0; i < CONTEXT_MAX_ENTRIES; i++) {
+        if (scope < 0 || entries[i].scope == scope) entries[i].used = 0;
+    }
+    int version = endWrite();
+    pthread_mutex_unlock(&writeLock);
+    return version;
+}
+
+int MoonForge_Context_GetSnapshot(char* buffer, int bufferSize) {
+    if (buffer == NULL || bufferSize < 3) return 0;
+
+    // Writers are excluded, so the table itself is a consistent snapshot
+    char scratch[ENTRY_SCRATCH_SIZE];
+    pthread_mutex_lock(&writeLock);
+    size_t length = formatSnapshot(buffer, (size_t)bufferSize, scratch, entries, sequence >> 1, 1);
+    pthread_mutex_unlock(&writeLock);
+    return (int)length;
+}
+
+size_t moonforge_context_write_json(int reader, char* buffer, size_t bufferSize) {
+    if (reader < 0 || reader >= MOONFORGE_CONTEXT_READER_COUNT || buffer == NULL || bufferSize < 3) return 0;
+
+    struct ContextReader* copy = &readers[reader];
+    uint32_t version = 0;
+    int consistent = readSnapshot(copy->snapshot, &version);
+    return formatSnapshot(buffer, bufferSize, copy->scratch, copy->snapshot, version, consistent);
+}
@@ -0,0 +1,87 @@
+/**
+ * MoonForge Context Store for Android (NDK) and Linux
+ *
+ * Key/value store for the context errors are reported with: game state,
+ * custom game data, the user and tags. Values are typed (string, integer,
+ * floating point, bool) and live in a fixed table guarded by a seqlock, so
+ * setting one costs a short critical section and the crash handler can copy
+ * a consistent snapshot without taking a lock. Every change bumps the
+ * version; the crash record carries the version it was dumped at.
+ */
+
+#ifndef MOONFORGE_CONTEXT_STORE_H
+#define MOONFORGE_CONTEXT_STORE_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef MOONFORGE_EXPORT
+#define MOONFORGE_EXPORT __attribute__((visibility("default")))
+#endif
+
+// Scopes: what an entry describes
+#define MOONFORGE_CONTEXT_GAME_STATE 0  // "sceneName", "gameMode", "levelId"
+#define MOONFORGE_CONTEXT_CUSTOM_DATA 1 // custom game state data
+#define MOONFORGE_CONTEXT_USER 2        // "id"
+#define MOONFORGE_CONTEXT_TAG 3         // user tags
+#define MOONFORGE_CONTEXT_SCOPE_COUNT 4
+
+// Value types
+#define MOONFORGE_CONTEXT_STRING 0
+#define MOONFORGE_CONTEXT_LONG 1
+#define MOONFORGE_CONTEXT_DOUBLE 2
+#define MOONFORGE_CONTEXT_BOOL 3
+
+/**
+ * Set a value; keys longer than 63 bytes and strings longer than 255 bytes are
+ * cut on a UTF-8 character boundary. A NULL string removes the key.
+ * @return The new version, or 0 if the key is invalid or the table is full
+ */
+MOONFORGE_EXPORT int MoonForge_Context_SetString(int scope, const char* key, const char* value);
+MOONFORGE_EXPORT int MoonForge_Context_SetLong(int scope, const char* key, long long value);
+MOONFORGE_EXPORT int MoonForge_Context_SetDouble(int scope, const char* key, double value);
+MOONFORGE_EXPORT int MoonForge_Context_SetBool(int scope, const char* key, int value);
+
+/**
+ * Remove a key
+ * @return The new version (unchanged if the key was not set)
+ */
+MOONFORGE_EXPORT int MoonForge_Context_Remove(int scope, const char* key);
+
+/**
+ * Remove every key of a scope, or of all scopes for -1
+ * @return The new version
+ */
+MOONFORGE_EXPORT int MoonForge_Context_Clear(int scope);
+
+/**
+ * Current snapshot as a JSON object:
+ * {"version":..,"torn":false,"entries":[{"scope":..,"type":..,"key":"..","value":".."}]}
+ * Values are written as strings whatever their type. Entries that don't fit
+ * are left out.
+ * @return Number of characters written (0 if the store is empty)
+ */
+MOONFORGE_EXPORT int MoonForge_Context_GetSnapshot(char* buffer, int bufferSize);
+
+// Lock-free readers; each has its own copy of the table, so different readers
+// may run at the same time but one reader must not run twice at once
+#define MOONFORGE_CONTEXT_READER_CRASH 0   // the signal handler
+#define MOONFORGE_CONTEXT_READER_LOCKS 1   // the lock monitor's worker thread
+#define MOONFORGE_CONTEXT_READER_COUNT 2
+
+/**
+ * Same as MoonForge_Context_GetSnapshot without taking the writers' lock, for
+ * the signal handler and threads that must not block. Async-signal-safe.
+ * If a write never completes (it was interrupted by the crash) the entries are
+ * copied as they are and "torn" is true.
+ */
+size_t moonforge_context_write_json(int reader, char* buffer, size_t bufferSize);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MOONFORGE_CONTEXT_STORE_H
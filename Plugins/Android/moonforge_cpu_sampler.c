@@ -0,0 +1,268 @@
+/**
+ * MoonForge CPU Sampler for Android (NDK) and Linux
+ *
+ * Each sample reads utime+stime for the process and for every thread,
+ * keeps the previous totals in a fixed table keyed by tid and publishes the
+ * busiest threads of the last interval into one of two snapshot slots. The
+ * crash handler only ever reads the published slot, so it needs no lock and
+ * never touches /proc from the signal handler.
+ */
+
+#define _GNU_SOURCE
+
+#include "moonforge_cpu_sampler.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MAX_THREADS 256
+#define MAX_PUBLISHED 16
+#define THREAD_NAME_SIZE 16
+#define STAT_BUFFER_SIZE 512
+
+struct ThreadEntry {
+    int tid;
+    char name[THREAD_NAME_SIZE];
+    unsigned long long ticks;
+    unsigned int seen;
+};
+
+struct ThreadSample {
+    int tid;
+    char name[THREAD_NAME_SIZE];
+    unsigned long long deltaTicks;
+    float cpuPercent;
+    long long cpuTimeMs;
+};
+
+struct CpuSnapshot {
+    float processPercent;
+    int count;
+    struct ThreadSample top[MAX_PUBLISHED];
+};
+
+// Sampler state, guarded by sampleLock
+static struct ThreadEntry threads[MAX_THREADS];
+static int threadCount = 0;
+static unsigned int generation = 0;
+static unsigned long long lastProcessTicks = 0;
+static struct timespec lastSampleTime;
+static int hasBaseline = 0;
+static long clockTicks = 0;
+static long cpuCount = 0;
+
+static pthread_mutex_t sampleLock = PTHREAD_MUTEX_INITIALIZER;
+
+// Published results; readers use whichever slot publishedIndex points at
+static struct CpuSnapshot snapshots[2];
+static int publishedIndex = -1;
+
+// /proc parsing
+
+/**
+ * Read comm and utime+stime from a stat file
+ * @return 1 on success
+ */
+static int readStat(const char* path, char* name, size_t nameSize, unsigned long long* ticks) {
+    char buffer[STAT_BUFFER_SIZE];
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return 0;
+    ssize_t length = read(fd, buffer, sizeof(buffer) - 1);
+    close(fd);
+    if (length <= 0) return 0;
+    buffer[length] = '\0';
+
+    // comm may contain spaces and parentheses, so it ends at the last ')'
+    char* nameStart = strchr(buffer, '(');
+    char* nameEnd = strrchr(buffer, ')');
+    if (nameStart == NULL || nameEnd == NULL || nameEnd < nameStart) return 0;
+
+    if (name != NULL) {
+        size_t nameLength = (size_t)(nameEnd - nameStart - 1);
+        if (nameLength >= nameSize) nameLength = nameSize - 1;
+        for (size_t i = 0; i < nameLength; i++) {
+            char c = nameStart[1 + i];
+            // Names go into JSON unescaped
+            name[i] = (c == '"' || c == '\\' || (unsigned char)c < 0x20) ? '_' : c;
+        }
+        name[nameLength] = '\0';
+    }
+
+    // Fields after comm start at 3 (state); utime and stime are 14 and 15
+    char* p = nameEnd + 1;
+    for (int field = 3; field < 14; field++) {
+        p = strchr(p + 1, ' ');
+        if (p == NULL) return 0;
+    }
+
+    char* end;
+    unsigned long long utime = strtoull(p + 1, &end, 10);
+    if (end == p + 1) return 0;
+    unsigned long long stime = strtoull(end, NULL, 10);
+    *ticks = utime + stime;
+    return 1;
+}
+
+static struct ThreadEntry* findOrAddThread(int tid, int* isNew) {
+    for (int i = 0; i < threadCount; i++) {
+        if (threads[i].tid == tid) {
+            *isNew = 0;
+            return &threads[i];
+        }
+    }
+
+    if (threadCount == MAX_THREADS) return NULL;
+
+    struct ThreadEntry* entry = &threads[threadCount++];
+    memset(entry, 0, sizeof(*entry));
+    entry->tid = tid;
+    *isNew = 1;
+    return entry;
+}
+
+static void insertTop(struct CpuSnapshot* snapshot, const struct ThreadEntry* entry, unsigned long long delta) {
+    int position = snapshot->count;
+    while (position > 0 && snapshot->top[position - 1].deltaTicks < delta) position--;
+    if (position >= MAX_PUBLISHED) return;
+
+    int last = snapshot->count < MAX_PUBLISHED ? snapshot->count : MAX_PUBLISHED - 1;
+    memmove(&snapshot->top[position + 1], &snapshot->top[position],
+            (size_t)(last - position) * sizeof(struct ThreadSample));
+
+    struct ThreadSample* sample = &snapshot->top[position];
+    sample->tid = entry->tid;
+    memcpy(sample->name, entry->name, sizeof(sample->name));
+    sample->deltaTicks = delta;
+    sample->cpuTimeMs = (long long)(entry->ticks * 1000ULL / (unsigned long long)clockTicks);
+
+    if (snapshot->count < MAX_PUBLISHED) snapshot->count++;
+}
+
+// Public API
+
+float MoonForge_CpuSampler_Sample(void) {
+    pthread_mutex_lock(&sampleLock);
+
+    if (clockTicks == 0) {
+        clockTicks = sysconf(_SC_CLK_TCK);
+        cpuCount = sysconf(_SC_NPROCESSORS_CONF);
+        if (clockTicks <= 0) clockTicks = 100;
+        if (cpuCount <= 0) cpuCount = 1;
+    }
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    double elapsed = hasBaseline
+        ? (double)(now.tv_sec - lastSampleTime.tv_sec) + (double)(now.tv_nsec - lastSampleTime.tv_nsec) / 1e9
+        : 0.0;
+
+    int nextIndex = __atomic_load_n(&publishedIndex, __ATOMIC_ACQUIRE) == 0 ? 1 : 0;
+    struct CpuSnapshot* snapshot = &snapshots[nextIndex];
+    snapshot->count = 0;
+    snapshot->processPercent = -1.0f;
+
+    unsigned long long processTicks = 0;
+    if (readStat("/proc/self/stat", NULL, 0, &processTicks) && hasBaseline && elapsed > 0) {
+        double seconds = (double)(processTicks - lastProcessTicks) / (double)clockTicks;
+        snapshot->processPercent = (float)(seconds / elapsed / (double)cpuCount * 100.0);
+    }
+
+    generation++;
+
+    DIR* dir = opendir("/proc/self/task");
+    if (dir != NULL) {
+        char path[64];
+        struct dirent* item;
+
+        while ((item = readdir(dir)) != NULL) {
+            if (item->d_name[0] < '0' || item->d_name[0] > '9') continue;
+
+            int tid = atoi(item->d_name);
+            char name[THREAD_NAME_SIZE];
+            unsigned long long ticks;
+            snprintf(path, sizeof(path), "/proc/self/task/%d/stat", tid);
+            if (!readStat(path, name, sizeof(name), &ticks)) continue;
+
+            int isNew;
+            struct ThreadEntry* entry = findOrAddThread(tid, &isNew);
+            if (entry == NULL) continue;
+
+            // A thread first seen after the baseline started inside this interval
+            unsigned long long delta = isNew ? (hasBaseline ? ticks : 0) : ticks - entry->ticks;
+            entry->ticks = ticks;
+            entry->seen = generation;
+            memcpy(entry->name, name, sizeof(entry->name));
+
+            if (delta > 0) insertTop(snapshot, entry, delta);
+        }
+        closedir(dir);
+    }
+
+    // Forget threads that exited
+    int kept = 0;
+    for (int i = 0; i < threadCount; i++) {
+        if (threads[i].seen == generation) threads[kept++] = threads[i];
+    }
+    threadCount = kept;
+
+    for (int i = 0; i < snapshot->count; i++) {
+        double seconds = (double)snapshot->top[i].deltaTicks / (double)clockTicks;
+        snapshot->top[i].cpuPercent = elapsed > 0 ? (float)(seconds / elapsed * 100.0) : 0.0f;
+    }
+
+    float result = snapshot->processPercent;
+    if (hasBaseline) {
+        __atomic_store_n(&publishedIndex, nextIndex, __ATOMIC_RELEASE);
+    }
+
+    lastProcessTicks = processTicks;
+    lastSampleTime = now;
+    hasBaseline = 1;
+
+    pthread_mutex_unlock(&sampleLock);
+    return result;
+}
+
+float MoonForge_CpuSampler_GetProcessPercent(void) {
+    int index = __atomic_load_n(&publishedIndex, __ATOMIC_ACQUIRE);
+    return index < 0 ? -1.0f : snapshots[index].processPercent;
+}
+
+size_t moonforge_cpu_sampler_write_json(char* buffer, size_t bufferSize, int maxThreads) {
+    if (buffer == NULL || bufferSize < 3) return 0;
+
+    int index = __atomic_load_n(&publishedIndex, __ATOMIC_ACQUIRE);
+    if (index < 0) {
+        buffer[0] = '\0';
+        return 0;
+    }
+
+    const struct CpuSnapshot* snapshot = &snapshots[index];
+    int count = snapshot->count < maxThreads ? snapshot->count : maxThreads;
+
+    size_t offset = 0;
+    buffer[offset++] = '[';
+    for (int i = 0; i < count; i++) {
+        const struct ThreadSample* sample = &snapshot->top[i];
+        int written = snprintf(buffer + offset, bufferSize - offset,
+            "%s{\"tid\":%d,\"name\":\"%s\",\"cpuPercent\":%.1f,\"cpuTimeMs\":%lld}",
+            i > 0 ? "," : "", sample->tid, sample->name, (double)sample->cpuPercent, sample->cpuTimeMs);
+        if (written < 0 || (size_t)written >= bufferSize - offset - 1) break;
+        offset += (size_t)written;
+    }
+    buffer[offset++] = ']';
+    buffer[offset] = '\0';
+    return offset;
+}
+
+int MoonForge_CpuSampler_GetTopThreads(char* buffer, int bufferSize, int maxThreads) {
+    if (buffer == NULL || bufferSize <= 0) return 0;
+    return (int)moonforge_cpu_sampler_write_json(buffer, (size_t)bufferSize, maxThreads);
+}
@@ -0,0 +1,51 @@
+/**
+ * MoonForge CPU Sampler for Android (NDK) and Linux
+ *
+ * Attributes CPU time to threads by sampling utime/stime from
+ * /proc/self/task/<tid>/stat at a low cadence. Sampling is driven by the
+ * caller (the SDK worker's timer); the latest result is published so the
+ * crash handler can read it without locks.
+ */
+
+#ifndef MOONFORGE_CPU_SAMPLER_H
+#define MOONFORGE_CPU_SAMPLER_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef MOONFORGE_EXPORT
+#define MOONFORGE_EXPORT __attribute__((visibility("default")))
+#endif
+
+/**
+ * Take one sample and publish the deltas since the previous one
+ * @return Process CPU usage since the previous sample in percent of all cores, or -1 on the first call
+ */
+MOONFORGE_EXPORT float MoonForge_CpuSampler_Sample(void);
+
+/**
+ * Process CPU usage from the latest sample (percent of all cores), or -1 if not sampled yet
+ */
+MOONFORGE_EXPORT float MoonForge_CpuSampler_GetProcessPercent(void);
+
+/**
+ * Top CPU consumers from the latest sample as a JSON array:
+ * [{"tid":..,"name":"..","cpuPercent":..,"cpuTimeMs":..}], busiest first.
+ * cpuPercent is relative to one core.
+ * @return Number of characters written (0 if not sampled yet)
+ */
+MOONFORGE_EXPORT int MoonForge_CpuSampler_GetTopThreads(char* buffer, int bufferSize, int maxThreads);
+
+/**
+ * Same as MoonForge_CpuSampler_GetTopThreads, for the signal handler. Async-signal-safe.
+ */
+size_t moonforge_cpu_sampler_write_json(char* buffer, size_t bufferSize, int maxThreads);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MOONFORGE_CPU_SAMPLER_H
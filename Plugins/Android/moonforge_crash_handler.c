@@ -1,24 +1,43 @@
 /**
- * MoonForge Crash Handler for Android (NDK)
+ * MoonForge Crash Handler for Android (NDK) and Linux standalone players
  *
- * Implements signal-based crash capturing for native Android crashes.
+ * Implements signal-based crash capturing for native crashes.
  * Captures SIGSEGV, SIGABRT, SIGBUS, SIGFPE, SIGILL, SIGTRAP
+ *
+ * The capture path is shared; only the entry points differ. Android is
+ * driven through JNI from MoonForgeCrashHandler.java, Linux through P/Invoke
+ * exports named like the iOS plugin's.
  */
 
+#define _GNU_SOURCE
+
 #include "moonforge_crash_handler.h"
+#include "moonforge_abort_message.h"
+#include "moonforge_context_store.h"
+#include "moonforge_cpu_sampler.h"
+#include "moonforge_device_sampler.h"
+#include "moonforge_fault_context.h"
+#include "moonforge_log_tail.h"
+#include "moonforge_session.h"
+#include "moonforge_signal_stack.h"
+#include "moonforge_unwind_ehabi.h"
 
-#include <android/log.h>
 #include <dlfcn.h>
+#include <errno.h>
+#include <fcntl.h>
 #include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
+#include <time.h>
 #include <unistd.h>
 #include <unwind.h>
 #include <pthread.h>
 
 #define LOG_TAG "MoonForgeCrash"
-#define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, LOG_TAG, __VA_ARGS__)
-#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+#include "moonforge_log.h"
 
 // Signals to handle
 static const int kSignalsToHandle[] = {
@@ -44,21 +63,68 @@ static volatile sig_atomic_t isHandlingCrash = 0;
 // Initialization state
 static int isInitialized = 0;
 
+#ifdef __ANDROID__
 // Java VM reference
 static JavaVM* javaVM = NULL;
+#endif
 
-// Buffer for crash JSON (pre-allocated)
-static char crashJsonBuffer[32768];
+// Buffers for the crash record (pre-allocated; the handler runs on a small alternate stack).
+// The frames are streamed to the record file; crashJsonBuffer holds the
+// rest, plus as many frames as fit for the in-process callback.
+static char crashJsonBuffer[98304];
+static char abortMessage[1024];
+static char abortMessageJson[2048];
+static char logTail[16384];
+static char logTailJson[24576];
+static char threadCpuJson[2048];
+static char deviceStateJson[1024];
+static char contextJson[16384];
+static char faultContextJson[8192];
+
+// Busiest threads listed in the crash record
+#define CRASH_TOP_THREADS 8
+
+// Crash records are written here and picked up on next launch
+static char crashDirectory[512];
+static char crashRecordPath[600];
+static char crashRecordTempPath[600];
+
+// Stack capture. The top STACK_HEAD_FRAMES frames are kept in order and the
+// deepest STACK_TAIL_FRAMES in a ring, so a stack overflow keeps both the
+// faulting frame and the root of the recursion however deep the stack is.
+#define STACK_HEAD_FRAMES 1024
+#define STACK_TAIL_FRAMES 1024
+#define STACK_MAX_FRAMES (STACK_HEAD_FRAMES + STACK_TAIL_FRAMES)
+// Unwinding stops here, in case a corrupt stack never ends
+#define STACK_MAX_DEPTH (1 << 18)
+// Longest repeating run of frames recognized as a recursion cycle
+#define MAX_CYCLE_FRAMES 32
 
-// Stack trace structure for unwinding
 struct BacktraceState {
-    void** current;
-    void** end;
+    int depth;
 };
 
-#define MAX_FRAMES 128
-static void* stackFrames[MAX_FRAMES];
-static int stackFrameCount = 0;
+// One frame of the record; the first frame of a cycle carries its length and repeat count
+struct StackEntry {
+    int index;
+    int cycleLength;
+    int repeat;
+};
+
+static void* stackHead[STACK_HEAD_FRAMES];
+static void* stackTail[STACK_TAIL_FRAMES];
+static void* stackFrames[STACK_MAX_FRAMES];
+static int stackDepths[STACK_MAX_FRAMES];
+static struct StackEntry stackEntries[STACK_MAX_FRAMES];
+static char stackEntryScratch[512];
+
+// The crash record being written: the file, and the copy in crashJsonBuffer
+struct RecordWriter {
+    int fd;
+    int failed;
+    size_t length;
+    int truncated;
+};
 
 // Signal names
 static const char* signalName(int sig) {
@@ -87,68 +153,300 @@ static const char* signalDescription(int sig) {
     }
 }
 
+// Record one frame; 0 once STACK_MAX_DEPTH frames are recorded
+static int recordFrame(uintptr_t pc, void* arg) {
+    struct BacktraceState* state = (struct BacktraceState*)arg;
+
+    if (state->depth == STACK_MAX_DEPTH) {
+        return 0;
+    }
+    if (state->depth < STACK_HEAD_FRAMES) {
+        stackHead[state->depth] = (void*)pc;
+    } else {
+        stackTail[(state->depth - STACK_HEAD_FRAMES) % STACK_TAIL_FRAMES] = (void*)pc;
+    }
+    state->depth++;
+    return 1;
+}
+
 // Stack unwinding callback
 static _Unwind_Reason_Code unwindCallback(struct _Unwind_Context* context, void* arg) {
-    struct BacktraceState* state = (struct BacktraceState*)arg;
     uintptr_t pc = _Unwind_GetIP(context);
 
-    if (pc) {
-        if (state->current == state->end) {
-            return _URC_END_OF_STACK;
-        }
-        *state->current++ = (void*)pc;
+    if (pc && !recordFrame(pc, arg)) {
+        return _URC_END_OF_STACK;
     }
 
     return _URC_NO_REASON;
 }
 
-// Capture stack trace using libunwind
-static int captureStackTrace(void** buffer, int maxFrames) {
-    struct BacktraceState state = { buffer, buffer + maxFrames };
-    _Unwind_Backtrace(unwindCallback, &state);
-    return state.current - buffer;
+/**
+ * Unwind the whole stack into stackFrames/stackDepths: the top frames, then the deepest ones.
+ * @param context The signal handler's ucontext
+ * @return Number of frames kept; *depth receives the number unwound
+ */
+static int captureStackTrace(const void* context, int* depth) {
+    struct BacktraceState state = { 0 };
+
+    // On armeabi-v7a _Unwind_Backtrace rarely gets past the signal frame, so
+    // unwind from the interrupted registers; elsewhere this returns -1
+    if (moonforge_unwind_ehabi(context, recordFrame, &state) < 2) {
+        state.depth = 0;
+        _Unwind_Backtrace(unwindCallback, &state);
+    }
+
+    int headCount = state.depth < STACK_HEAD_FRAMES ? state.depth : STACK_HEAD_FRAMES;
+    for (int i = 0; i < headCount; i++) {
+        stackFrames[i] = stackHead[i];
+        stackDepths[i] = i;
+    }
+
+    int tailCount = state.depth - headCount;
+    if (tailCount > STACK_TAIL_FRAMES) tailCount = STACK_TAIL_FRAMES;
+    for (int i = 0; i < tailCount; i++) {
+        int tailDepth = state.depth - tailCount + i;
+        stackFrames[headCount + i] = stackTail[(tailDepth - STACK_HEAD_FRAMES) % STACK_TAIL_FRAMES];
+        stackDepths[headCount + i] = tailDepth;
+    }
+
+    *depth = state.depth;
+    return headCount + tailCount;
 }
 
-// Format stack trace as JSON
-static void formatStackTraceJson(char* buffer, size_t bufferSize, void** frames, int frameCount) {
-    size_t offset = 0;
-    offset += snprintf(buffer + offset, bufferSize - offset, "[");
+/**
+ * Append entries for frames [start, end), folding repeated runs of up to
+ * MAX_CYCLE_FRAMES frames into one copy with a repeat count.
+ */
+static int compressFrames(int start, int end, int entryCount) {
+    int i = start;
+    while (i < end) {
+        int bestLength = 1;
+        int bestRepeat = 1;
+
+        for (int length = 1; length <= MAX_CYCLE_FRAMES && i + 2 * length <= end; length++) {
+            int repeat = 1;
+            while (i + (repeat + 1) * length <= end
+                   && memcmp(&stackFrames[i], &stackFrames[i + repeat * length], length * sizeof(void*)) == 0) {
+                repeat++;
+            }
+            // Prefer the cycle covering the most frames; the shortest one on ties
+            if (repeat > 1 && length * repeat > bestLength * bestRepeat) {
+                bestLength = length;
+                bestRepeat = repeat;
+            }
+        }
 
-    for (int i = 0; i < frameCount && offset < bufferSize - 256; i++) {
-        if (i > 0) {
-            offset += snprintf(buffer + offset, bufferSize - offset, ",");
+        for (int k = 0; k < bestLength; k++) {
+            stackEntries[entryCount].index = i + k;
+            stackEntries[entryCount].cycleLength = k == 0 && bestRepeat > 1 ? bestLength : 0;
+            stackEntries[entryCount].repeat = k == 0 && bestRepeat > 1 ? bestRepeat : 0;
+            entryCount++;
         }
+        i += bestLength * bestRepeat;
+    }
+    return entryCount;
+}
 
-        void* addr = frames[i];
+// Format one frame as JSON
+static int formatStackEntry(char* buffer, size_t bufferSize, const struct StackEntry* entry) {
+    void* addr = stackFrames[entry->index];
 
-        // Try to get symbol info
-        Dl_info info;
-        const char* symbolName = "???";
-        const char* moduleName = "???";
-        ptrdiff_t symbolOffset = 0;
+    // Try to get symbol info
+    Dl_info info;
+    const char* symbolName = "???";
+    const char* moduleName = "???";
+    ptrdiff_t symbolOffset = 0;
 
-        if (dladdr(addr, &info)) {
-            if (info.dli_sname) {
-                symbolName = info.dli_sname;
-                symbolOffset = (char*)addr - (char*)info.dli_saddr;
-            }
-            if (info.dli_fname) {
-                // Get just the filename, not full path
-                const char* lastSlash = strrchr(info.dli_fname, '/');
-                moduleName = lastSlash ? lastSlash + 1 : info.dli_fname;
-            }
+    if (dladdr(addr, &info)) {
+        if (info.dli_sname) {
+            symbolName = info.dli_sname;
+            symbolOffset = (char*)addr - (char*)info.dli_saddr;
         }
+        if (info.dli_fname) {
+            // Get just the filename, not full path
+            const char* lastSlash = strrchr(info.dli_fname, '/');
+            moduleName = lastSlash ? lastSlash + 1 : info.dli_fname;
+        }
+    }
 
-        offset += snprintf(buffer + offset, bufferSize - offset,
+    int written;
+    if (entry->repeat > 1) {
+        written = snprintf(buffer, bufferSize,
+            "{\"frame\":%d,\"address\":\"%p\",\"module\":\"%s\",\"symbol\":\"%s\",\"offset\":\"%td\",\"cycleLength\":%d,\"repeat\":%d}",
+            stackDepths[entry->index], addr, moduleName, symbolName, symbolOffset, entry->cycleLength, entry->repeat);
+    } else {
+        written = snprintf(buffer, bufferSize,
             "{\"frame\":%d,\"address\":\"%p\",\"module\":\"%s\",\"symbol\":\"%s\",\"offset\":\"%td\"}",
-            i, addr, moduleName, symbolName, symbolOffset);
+            stackDepths[entry->index], addr, moduleName, symbolName, symbolOffset);
+    }
+    return written < 0 ? 0 : written >= (int)bufferSize ? (int)bufferSize - 1 : written;
+}
+
+// Escape a string into a JSON string body (no quotes). Async-signal-safe.
+static void escapeJson(char* out, size_t outSize, const char* in) {
+    static const char hex[] = "0123456789abcdef";
+    size_t o = 0;
+
+    for (size_t i = 0; in[i] != '\0' && o + 7 < outSize; i++) {
+        unsigned char c = (unsigned char)in[i];
+        if (c == '"' || c == '\\') {
+            out[o++] = '\\';
+            out[o++] = (char)c;
+        } else if (c == '\n') {
+            out[o++] = '\\';
+            out[o++] = 'n';
+        } else if (c < 0x20) {
+            out[o++] = '\\';
+            out[o++] = 'u';
+            out[o++] = '0';
+            out[o++] = '0';
+            out[o++] = hex[c >> 4];
+            out[o++] = hex[c & 0xf];
+        } else {
+            out[o++] = (char)c;
+        }
     }
+    out[o] = '\0';
+}
 
-    offset += snprintf(buffer + offset, bufferSize - offset, "]");
+// Write all of data to fd. Async-signal-safe.
+static int writeAll(int fd, const char* data, size_t length) {
+    while (length > 0) {
+        ssize_t result = write(fd, data, length);
+        if (result < 0 && errno == EINTR) continue;
+        if (result <= 0) return 0;
+        data += result;
+        length -= (size_t)result;
+    }
+    return 1;
+}
+
+/**
+ * Start the crash record file for the next launch and write the part already
+ * in crashJsonBuffer. Async-signal-safe.
+ */
+static void beginCrashRecord(struct RecordWriter* writer, size_t headerLength, long long timestampMs) {
+    writer->fd = -1;
+    writer->failed = 0;
+    writer->length = headerLength;
+    writer->truncated = 0;
+    if (crashDirectory[0] == '\0') return;
+
+    snprintf(crashRecordTempPath, sizeof(crashRecordTempPath), "%s/crash_%lld_%d.tmp",
+             crashDirectory, timestampMs, (int)getpid());
+    snprintf(crashRecordPath, sizeof(crashRecordPath), "%s/crash_%lld_%d.json",
+             crashDirectory, timestampMs, (int)getpid());
+
+    writer->fd = open(crashRecordTempPath, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (writer->fd >= 0 && !writeAll(writer->fd, crashJsonBuffer, headerLength)) {
+        writer->failed = 1;
+    }
+}
+
+/**
+ * Append to the record file, and to crashJsonBuffer while it has room for
+ * the data and the closing "]}". Async-signal-safe.
+ */
+static void appendCrashRecord(struct RecordWriter* writer, const char* data, size_t length) {
+    if (writer->fd >= 0 && !writer->failed && !writeAll(writer->fd, data, length)) {
+        writer->failed = 1;
+    }
+
+    if (crashCallback == NULL || writer->truncated) return;
+    if (writer->length + length + 3 > sizeof(crashJsonBuffer)) {
+        writer->truncated = 1;
+        return;
+    }
+    memcpy(crashJsonBuffer + writer->length, data, length);
+    writer->length += length;
+}
+
+// Close the frame array and the record. Async-signal-safe.
+static void finishCrashRecord(struct RecordWriter* writer) {
+    memcpy(crashJsonBuffer + writer->length, "]}", 3);
+    if (writer->fd < 0) return;
+
+    if (!writer->failed && !writeAll(writer->fd, "]}", 2)) {
+        writer->failed = 1;
+    }
+    close(writer->fd);
+
+    // Only complete records get the .json name
+    if (!writer->failed) {
+        rename(crashRecordTempPath, crashRecordPath);
+    }
+}
+
+/**
+ * Write the captured stack as JSON array entries, compressing recursion
+ * cycles. Each entry goes straight to the record, so the head and tail rings
+ * are all that bound it; "frame" keeps each frame's depth, so the frames
+ * between the rings show as a gap.
+ */
+static void writeStackTraceJson(struct RecordWriter* writer, int frameCount) {
+    int headCount = frameCount < STACK_HEAD_FRAMES ? frameCount : STACK_HEAD_FRAMES;
+    int entryCount = compressFrames(0, headCount, 0);
+    entryCount = compressFrames(headCount, frameCount, entryCount);
+
+    // The separator goes with its entry, so a cut copy stays valid JSON
+    for (int i = 0; i < entryCount; i++) {
+        size_t length = 0;
+        if (i > 0) stackEntryScratch[length++] = ',';
+        length += (size_t)formatStackEntry(stackEntryScratch + length, sizeof(stackEntryScratch) - length, &stackEntries[i]);
+        appendCrashRecord(writer, stackEntryScratch, length);
+    }
 }
 
 // Signal handler
+#ifndef __ANDROID__
+// Another handler recovered from the signal after the record was written
+static void discardCrashRecord(void) {
+    unlink(crashRecordTempPath);
+    unlink(crashRecordPath);
+    moonforge_session_clear_crashed();
+}
+
+static int hasPreviousHandler(int sig) {
+    const struct sigaction* previous = &previousHandlers[sig];
+    if (previous->sa_flags & SA_SIGINFO) return previous->sa_sigaction != NULL;
+    return previous->sa_handler != SIG_DFL && previous->sa_handler != SIG_IGN;
+}
+
+/**
+ * Hand the signal to the handler that was installed before ours.
+ * @return 1 if that handler ran and returned
+ */
+static int chainToPreviousHandler(int sig, siginfo_t* info, void* context) {
+    if (!hasPreviousHandler(sig)) return 0;
+
+    struct sigaction* previous = &previousHandlers[sig];
+    if (previous->sa_flags & SA_SIGINFO) {
+        previous->sa_sigaction(sig, info, context);
+    } else {
+        previous->sa_handler(sig);
+    }
+    return 1;
+}
+#endif
+
 static void signalHandler(int sig, siginfo_t* info, void* context) {
+#ifndef __ANDROID__
+    // A fault may still be handled by the handler installed before ours:
+    // Mono turns faults in JIT-compiled code into NullReferenceException and
+    // DivideByZeroException, then returns into the rewritten context. Those
+    // happen in normal play, so JIT code goes to it first. Faults in native
+    // modules are recorded first, since the previous handler may _exit
+    // (Unity's crash reporter) or abort and lose the original signal.
+    int recordBeforeChaining = 0;
+    if ((sig == SIGSEGV || sig == SIGBUS || sig == SIGFPE) && !isHandlingCrash && hasPreviousHandler(sig)) {
+        if (moonforge_fault_context_in_jit_code(context)) {
+            if (chainToPreviousHandler(sig, info, context)) return;
+        } else {
+            recordBeforeChaining = 1;
+        }
+    }
+#endif
+
     // Prevent re-entry
     if (isHandlingCrash) {
         return;
@@ -161,17 +459,50 @@ static void signalHandler(int sig, siginfo_t* info, void* context) {
     void* faultAddress = info ? info->si_addr : NULL;
 
     // Capture stack trace
-    stackFrameCount = captureStackTrace(stackFrames, MAX_FRAMES);
-
-    // Format stack trace as JSON
-    char stackTraceJson[16384];
-    formatStackTraceJson(stackTraceJson, sizeof(stackTraceJson), stackFrames, stackFrameCount);
+    int stackDepth = 0;
+    int stackFrameCount = captureStackTrace(context, &stackDepth);
 
     // Get thread info
     pthread_t thread = pthread_self();
 
-    // Build crash JSON
-    snprintf(crashJsonBuffer, sizeof(crashJsonBuffer),
+    // Reason for aborts (assert text, libc++abi / fortify messages)
+    abortMessageJson[0] = '\0';
+    if (sig == SIGABRT && moonforge_abort_message_read(abortMessage, sizeof(abortMessage)) > 0) {
+        escapeJson(abortMessageJson, sizeof(abortMessageJson), abortMessage);
+    }
+
+    // Recent log lines, newest last
+    logTailJson[0] = '\0';
+    if (moonforge_log_tail_copy(logTail, sizeof(logTail)) > 0) {
+        escapeJson(logTailJson, sizeof(logTailJson), logTail);
+    }
+
+    // CPU attribution from the last sample; the handler never reads /proc itself
+    if (moonforge_cpu_sampler_write_json(threadCpuJson, sizeof(threadCpuJson), CRASH_TOP_THREADS) == 0) {
+        strcpy(threadCpuJson, "[]");
+    }
+
+    // Thermal, frequency and battery state from the last device sample
+    if (moonforge_device_sampler_write_json(deviceStateJson, sizeof(deviceStateJson)) == 0) {
+        strcpy(deviceStateJson, "null");
+    }
+
+    // Game state, user and tags as of the crash
+    if (moonforge_context_write_json(MOONFORGE_CONTEXT_READER_CRASH, contextJson, sizeof(contextJson)) == 0) {
+        strcpy(contextJson, "null");
+    }
+
+    // Registers, stack bounds and the mappings around the fault, for classification on the next launch
+    if (moonforge_fault_context_write_json(faultContextJson, sizeof(faultContextJson), context, faultAddress) == 0) {
+        strcpy(faultContextJson, "null");
+    }
+
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    long long timestampMs = (long long)now.tv_sec * 1000 + now.tv_nsec / 1000000;
+
+    // Everything up to the frames; they are appended as the record is written
+    int headerLength = snprintf(crashJsonBuffer, sizeof(crashJsonBuffer),
         "{"
         "\"signal\":%d,"
         "\"signalName\":\"%s\","
@@ -179,16 +510,50 @@ static void signalHandler(int sig, siginfo_t* info, void* context) {
         "\"faultAddress\":\"%p\","
         "\"threadId\":%lu,"
         "\"siCode\":%d,"
-        "\"frames\":%s"
-        "}",
+        "\"fault\":%s,"
+        "\"abortMessage\":\"%s\","
+        "\"logTail\":\"%s\","
+        "\"cpuUsagePercent\":%.1f,"
+        "\"threadCpu\":%s,"
+        "\"deviceState\":%s,"
+        "\"context\":%s,"
+        "\"timestamp\":%lld,"
+        "\"frameCount\":%d,"
+        "\"frames\":[",
         sig,
         signalName(sig),
         signalDescription(sig),
         faultAddress,
         (unsigned long)thread,
         info ? info->si_code : 0,
-        stackTraceJson
+        faultContextJson,
+        abortMessageJson,
+        logTailJson,
+        (double)MoonForge_CpuSampler_GetProcessPercent(),
+        threadCpuJson,
+        deviceStateJson,
+        contextJson,
+        timestampMs,
+        stackDepth
     );
+    if (headerLength < 0) headerLength = 0;
+    if ((size_t)headerLength > sizeof(crashJsonBuffer) - 3) headerLength = (int)sizeof(crashJsonBuffer) - 3;
+
+    // The process is about to die, so the record is what reaches the next launch
+    moonforge_session_mark_crashed(sig);
+    struct RecordWriter record;
+    beginCrashRecord(&record, (size_t)headerLength, timestampMs);
+    writeStackTraceJson(&record, stackFrameCount);
+    finishCrashRecord(&record);
+
+#ifndef __ANDROID__
+    if (recordBeforeChaining && chainToPreviousHandler(sig, info, context)) {
+        // It returned, so it handled the fault after all
+        discardCrashRecord();
+        isHandlingCrash = 0;
+        return;
+    }
+#endif
 
     // Call the callback
     if (crashCallback) {
@@ -205,13 +570,9 @@ static void signalHandler(int sig, siginfo_t* info, void* context) {
     raise(sig);
 }
 
-// Public API implementation
-
-void MoonForge_Android_SetJavaVM(JavaVM* vm) {
-    javaVM = vm;
-}
+// Installation
 
-void MoonForge_Android_InitializeCrashHandler(JNIEnv* env, MoonForgeCrashCallback callback) {
+static void installHandlers(MoonForgeCrashCallback callback) {
     if (isInitialized) {
         LOGD("Crash handler already initialized");
         return;
@@ -219,6 +580,9 @@ void MoonForge_Android_InitializeCrashHandler(JNIEnv* env, MoonForgeCrashCallbac
 
     crashCallback = callback;
 
+    // Unwind tables are looked up from the handler, where dl_iterate_phdr is off limits
+    moonforge_unwind_ehabi_refresh();
+
     // Install signal handlers
     for (int i = 0; i < kNumSignals; i++) {
         int sig = kSignalsToHandle[i];
@@ -235,20 +599,16 @@ void MoonForge_Android_InitializeCrashHandler(JNIEnv* env, MoonForgeCrashCallbac
         }
     }
 
-    // Allocate alternate signal stack
-    stack_t ss;
-    ss.ss_sp = malloc(SIGSTKSZ);
-    if (ss.ss_sp != NULL) {
-        ss.ss_size = SIGSTKSZ;
-        ss.ss_flags = 0;
-        sigaltstack(&ss, NULL);
-    }
+    // Alternate signal stacks for this thread and every thread started from now on
+    moonforge_signal_stack_install();
+
+    moonforge_abort_message_install();
 
     isInitialized = 1;
     LOGD("Crash handler initialized");
 }
 
-void MoonForge_Android_ShutdownCrashHandler(void) {
+static void uninstallHandlers(void) {
     if (!isInitialized) {
         return;
     }
@@ -259,35 +619,31 @@ void MoonForge_Android_ShutdownCrashHandler(void) {
         sigaction(sig, &previousHandlers[sig], NULL);
     }
 
+    moonforge_signal_stack_uninstall();
     crashCallback = NULL;
     isInitialized = 0;
     LOGD("Crash handler shutdown");
 }
 
-int MoonForge_Android_IsInitialized(void) {
-    return isInitialized;
-}
-
-// JNI functions
-
-JNIEXPORT void JNICALL Java_com_moonforge_errortracking_CrashHandler_nativeInit(JNIEnv* env, jobject obj) {
-    // This is called from Java to initialize the native handler
-    // The actual initialization is done via Unity's P/Invoke
-    LOGD("Native init called from Java");
-}
+static void setCrashDirectory(const char* path) {
+    if (path == NULL) {
+        crashDirectory[0] = '\0';
+        return;
+    }
 
-JNIEXPORT void JNICALL Java_com_moonforge_errortracking_CrashHandler_nativeShutdown(JNIEnv* env, jobject obj) {
-    MoonForge_Android_ShutdownCrashHandler();
+    strncpy(crashDirectory, path, sizeof(crashDirectory) - 1);
+    crashDirectory[sizeof(crashDirectory) - 1] = '\0';
+    mkdir(crashDirectory, 0700);
 }
 
-JNIEXPORT void JNICALL Java_com_moonforge_errortracking_CrashHandler_nativeSimulateCrash(JNIEnv* env, jobject obj, jint crashType) {
+static void simulateCrash(int crashType) {
 #ifndef NDEBUG
     LOGD("Simulating crash type %d", crashType);
     switch (crashType) {
         case 0:
             // SIGSEGV - null pointer dereference
             {
-                int* ptr = NULL;
+                volatile int* volatile ptr = NULL;
                 *ptr = 42;
             }
             break;
@@ -298,7 +654,7 @@ JNIEXPORT void JNICALL Java_com_moonforge_errortracking_CrashHandler_nativeSimul
         case 2:
             // SIGBUS - bus error
             {
-                char* ptr = (char*)1;
+                volatile char* volatile ptr = (char*)1;
                 *ptr = 42;
             }
             break;
@@ -307,6 +663,83 @@ JNIEXPORT void JNICALL Java_com_moonforge_errortracking_CrashHandler_nativeSimul
             break;
     }
 #else
+    (void)crashType;
     LOGD("SimulateCrash is only available in debug builds");
 #endif
 }
+
+#ifdef __ANDROID__
+
+// Public API implementation
+
+void MoonForge_Android_SetJavaVM(JavaVM* vm) {
+    javaVM = vm;
+}
+
+void MoonForge_Android_InitializeCrashHandler(JNIEnv* env, MoonForgeCrashCallback callback) {
+    (void)env;
+    installHandlers(callback);
+}
+
+void MoonForge_Android_ShutdownCrashHandler(void) {
+    uninstallHandlers();
+}
+
+int MoonForge_Android_IsInitialized(void) {
+    return isInitialized;
+}
+
+void MoonForge_Android_SetCrashDirectory(const char* path) {
+    setCrashDirectory(path);
+}
+
+// JNI functions
+
+JNIEXPORT void JNICALL Java_com_moonforge_errortracking_MoonForgeCrashHandler_nativeInit(JNIEnv* env, jobject obj, jstring crashDirectoryPath) {
+    (void)obj;
+
+    if (crashDirectoryPath != NULL) {
+        const char* path = (*env)->GetStringUTFChars(env, crashDirectoryPath, NULL);
+        if (path != NULL) {
+            MoonForge_Android_SetCrashDirectory(path);
+            (*env)->ReleaseStringUTFChars(env, crashDirectoryPath, path);
+        }
+    }
+
+    // Crashes are delivered through the record on disk; there is no in-process callback on Android
+    MoonForge_Android_InitializeCrashHandler(env, NULL);
+}
+
+JNIEXPORT void JNICALL Java_com_moonforge_errortracking_MoonForgeCrashHandler_nativeShutdown(JNIEnv* env, jobject obj) {
+    MoonForge_Android_ShutdownCrashHandler();
+}
+
+JNIEXPORT void JNICALL Java_com_moonforge_errortracking_MoonForgeCrashHandler_nativeSimulateCrash(JNIEnv* env, jobject obj, jint crashType) {
+    simulateCrash(crashType);
+}
+
+#else
+
+// Public API implementation (Linux)
+
+void MoonForge_InitializeCrashHandler(MoonForgeCrashCallback callback) {
+    installHandlers(callback);
+}
+
+void MoonForge_ShutdownCrashHandler(void) {
+    uninstallHandlers();
+}
+
+int MoonForge_IsCrashHandlerInitialized(void) {
+    return isInitialized;
+}
+
+void MoonForge_SetCrashDirectory(const char* path) {
+    setCrashDirectory(path);
+}
+
+void MoonForge_SimulateCrash(int crashType) {
+    simulateCrash(crashType);
+}
+
+#endif
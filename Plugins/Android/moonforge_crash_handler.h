@@ -1,23 +1,31 @@
 /**
- * MoonForge Crash Handler for Android (NDK)
+ * MoonForge Crash Handler for Android (NDK) and Linux standalone players
  *
- * Captures native crashes (signals) on Android devices.
+ * Captures native crashes (signals) on Android devices and Linux desktops/servers.
  */
 
 #ifndef MOONFORGE_CRASH_HANDLER_H
 #define MOONFORGE_CRASH_HANDLER_H
 
+#ifdef __ANDROID__
 #include <jni.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#ifndef MOONFORGE_EXPORT
+#define MOONFORGE_EXPORT __attribute__((visibility("default")))
+#endif
+
 /**
  * Callback function type for crash notifications
  */
 typedef void (*MoonForgeCrashCallback)(const char* crashJson);
 
+#ifdef __ANDROID__
+
 /**
  * Initialize the crash handler
  * @param env JNI environment
@@ -35,15 +43,53 @@ void MoonForge_Android_ShutdownCrashHandler(void);
  */
 int MoonForge_Android_IsInitialized(void);
 
+/**
+ * Set the directory crash records are written to
+ */
+void MoonForge_Android_SetCrashDirectory(const char* path);
+
 /**
  * Set the Java VM reference (called from Unity)
  */
 void MoonForge_Android_SetJavaVM(JavaVM* vm);
 
 // JNI functions
-JNIEXPORT void JNICALL Java_com_moonforge_errortracking_CrashHandler_nativeInit(JNIEnv* env, jobject obj);
-JNIEXPORT void JNICALL Java_com_moonforge_errortracking_CrashHandler_nativeShutdown(JNIEnv* env, jobject obj);
-JNIEXPORT void JNICALL Java_com_moonforge_errortracking_CrashHandler_nativeSimulateCrash(JNIEnv* env, jobject obj, jint crashType);
+JNIEXPORT void JNICALL Java_com_moonforge_errortracking_MoonForgeCrashHandler_nativeInit(JNIEnv* env, jobject obj, jstring crashDirectory);
+JNIEXPORT void JNICALL Java_com_moonforge_errortracking_MoonForgeCrashHandler_nativeShutdown(JNIEnv* env, jobject obj);
+JNIEXPORT void JNICALL Java_com_moonforge_errortracking_MoonForgeCrashHandler_nativeSimulateCrash(JNIEnv* env, jobject obj, jint crashType);
+
+#else
+
+// P/Invoke surface for Linux standalone players, named like the iOS plugin's
+
+/**
+ * Install the signal handlers
+ * @param callback Called from the signal handler with the crash JSON (may be NULL;
+ *                 the persisted record is the reliable path)
+ */
+MOONFORGE_EXPORT void MoonForge_InitializeCrashHandler(MoonForgeCrashCallback callback);
+
+/**
+ * Restore the previous signal handlers
+ */
+MOONFORGE_EXPORT void MoonForge_ShutdownCrashHandler(void);
+
+/**
+ * Check if crash handler is initialized
+ */
+MOONFORGE_EXPORT int MoonForge_IsCrashHandlerInitialized(void);
+
+/**
+ * Set the directory crash records are written to
+ */
+MOONFORGE_EXPORT void MoonForge_SetCrashDirectory(const char* path);
+
+/**
+ * Trigger a crash for testing (0 = SIGSEGV, 1 = SIGABRT, 2 = SIGBUS)
+ */
+MOONFORGE_EXPORT void MoonForge_SimulateCrash(int crashType);
+
+#endif
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,415 @@
+/**
+ * MoonForge Device Sampler for Android (NDK) and Linux
+ *
+ * Sources are discovered on the first sample and their files kept open:
+ * every /sys/class/thermal/thermal_zone*, one cpufreq policy per cluster
+ * (falling back to the per-CPU cpufreq directories on kernels without
+ * policies) and the battery power supply. Later samples only pread the open
+ * files. A cluster is capped when scaling_max_freq is below cpuinfo_max_freq,
+ * which is how thermal and power-save limits reach the scheduler.
+ *
+ * Vendors and SELinux policies differ in what apps may read, so every source
+ * is optional and missing values are reported as unknown.
+ */
+
+#define _GNU_SOURCE
+
+#include "moonforge_device_sampler.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define MAX_ZONES 32
+#define MAX_CLUSTERS 8
+#define ZONE_TYPE_SIZE 32
+#define VALUE_BUFFER_SIZE 64
+// Room for a full d_name plus the attribute
+#define PATH_BUFFER_SIZE 320
+
+// Tests point this at a fake sysfs tree
+#ifndef MOONFORGE_SYSFS_ROOT
+#define MOONFORGE_SYSFS_ROOT ""
+#endif
+
+#define UNKNOWN_TEMPERATURE -1000.0f
+
+// Readings outside this range are disabled or virtual zones
+#define MIN_VALID_TEMPERATURE -40.0f
+#define MAX_VALID_TEMPERATURE 150.0f
+
+struct ThermalZone {
+    int fd;
+    char type[ZONE_TYPE_SIZE];
+};
+
+struct Cluster {
+    int cpu;
+    int curFd;
+    int capFd;
+    int maxKhz;
+};
+
+struct ClusterSample {
+    int cpu;
+    int curKhz;
+    int maxKhz;
+    int capKhz;
+};
+
+struct DeviceSnapshot {
+    float temperatureC;
+    char hottestZone[ZONE_TYPE_SIZE];
+    float cpuFrequencyCapPercent;
+    int batteryPercent;
+    int batteryCharging;
+    float batteryTemperatureC;
+    int clusterCount;
+    struct ClusterSample clusters[MAX_CLUSTERS];
+};
+
+// Open sources, guarded by sampleLock
+static struct ThermalZone zones[MAX_ZONES];
+static int zoneCount = 0;
+static struct Cluster clusters[MAX_CLUSTERS];
+static int clusterCount = 0;
+static int batteryCapacityFd = -1;
+static int batteryStatusFd = -1;
+static int batteryTemperatureFd = -1;
+static int isDiscovered = 0;
+
+static pthread_mutex_t sampleLock = PTHREAD_MUTEX_INITIALIZER;
+
+// Published results; readers use whichever slot publishedIndex points at
+static struct DeviceSnapshot snapshots[2];
+static int publishedIndex = -1;
+
+// sysfs reading
+
+static int openReadOnly(const char* path) {
+    return open(path, O_RDONLY | O_CLOEXEC);
+}
+
+/**
+ * Re-read a sysfs attribute from the start, without the trailing newline
+ * @return Length read, or -1
+ */
+static int readText(int fd, char* buffer, size_t bufferSize) {
+    if (fd < 0) return -1;
+
+    ssize_t length = pread(fd, buffer, bufferSize - 1, 0);
+    if (length <= 0) return -1;
+    while (length > 0 && (buffer[length - 1] == '\n' || buffer[length - 1] == ' ')) length--;
+    buffer[length] = '\0';
+    return (int)length;
+}
+
+static int readLong(int fd, long long* value) {
+    char buffer[VALUE_BUFFER_SIZE];
+    if (readText(fd, buffer, sizeof(buffer)) <= 0) return 0;
+
+    char* end;
+    *value = strtoll(buffer, &end, 10);
+    return end != buffer;
+}
+
+static int readPathText(const char* path, char* buffer, size_t bufferSize) {
+    int fd = openReadOnly(path);
+    if (fd < 0) return -1;
+    int length = readText(fd, buffer, bufferSize);
+    close(fd);
+    return length;
+}
+
+static int readPathLong(const char* path, long long* value) {
+    int fd = openReadOnly(path);
+    if (fd < 0) return 0;
+    int result = readLong(fd, value);
+    close(fd);
+    return result;
+}
+
+/**
+ * Thermal zones report millidegrees, except some older drivers that report degrees
+ */
+static float zoneTemperature(long long raw) {
+    float celsius = (raw >= 1000 || raw <= -1000) ? (float)raw / 1000.0f : (float)raw;
+    return celsius > MIN_VALID_TEMPERATURE && celsius < MAX_VALID_TEMPERATURE ? celsius : UNKNOWN_TEMPERATURE;
+}
+
+// Discovery
+
+static void discoverThermalZones(void) {
+    DIR* dir = opendir(MOONFORGE_SYSFS_ROOT "/sys/class/thermal");
+    if (dir == NULL) return;
+
+    char path[PATH_BUFFER_SIZE];
+    struct dirent* item;
+    while ((item = readdir(dir)) != NULL && zoneCount < MAX_ZONES) {
+        if (strncmp(item->d_name, "thermal_zone", 12) != 0) continue;
+
+        snprintf(path, sizeof(path), MOONFORGE_SYSFS_ROOT "/sys/class/thermal/%s/temp", item->d_name);
+        int fd = openReadOnly(path);
+        if (fd < 0) continue;
+
+        // Keep only zones that read back something plausible
+        long long raw;
+        if (!readLong(fd, &raw) || zoneTemperature(raw) == UNKNOWN_TEMPERATURE) {
+            close(fd);
+            continue;
+        }
+
+        struct ThermalZone* zone = &zones[zoneCount++];
+        zone->fd = fd;
+
+        snprintf(path, sizeof(path), MOONFORGE_SYSFS_ROOT "/sys/class/thermal/%s/type", item->d_name);
+        if (readPathText(path, zone->type, sizeof(zone->type)) <= 0) {
+            size_t length = strnlen(item->d_name, sizeof(zone->type) - 1);
+            memcpy(zone->type, item->d_name, length);
+            zone->type[length] = '\0';
+        }
+        // Types go into JSON unescaped
+        for (char* c = zone->type; *c; c++) {
+            if (*c == '"' || *c == '\\' || (unsigned char)*c < 0x20) *c = '_';
+        }
+    }
+    closedir(dir);
+}
+
+static int addCluster(int cpu, const char* directory, int perCpu) {
+    char path[PATH_BUFFER_SIZE];
+    long long maxKhz;
+
+    snprintf(path, sizeof(path), "%s/cpuinfo_max_freq", directory);
+    if (!readPathLong(path, &maxKhz) || maxKhz <= 0) return 0;
+
+    // Per-CPU directories: treat CPUs with the same top frequency as one cluster
+    for (int i = 0; perCpu && i < clusterCount; i++) {
+        if (clusters[i].maxKhz == (int)maxKhz) return 0;
+    }
+
+    struct Cluster* cluster = &clusters[clusterCount];
+    cluster->cpu = cpu;
+    cluster->maxKhz = (int)maxKhz;
+
+    snprintf(path, sizeof(path), "%s/scaling_cur_freq", directory);
+    cluster->curFd = openReadOnly(path);
+    snprintf(path, sizeof(path), "%s/scaling_max_freq", directory);
+    cluster->capFd = openReadOnly(path);
+
+    if (cluster->curFd < 0 && cluster->capFd < 0) return 0;
+    clusterCount++;
+    return 1;
+}
+
+static void discoverClusters(void) {
+    char path[PATH_BUFFER_SIZE];
+
+    // policyN is named after the first CPU of its cluster
+    DIR* dir = opendir(MOONFORGE_SYSFS_ROOT "/sys/devices/system/cpu/cpufreq");
+    if (dir != NULL) {
+        struct dirent* item;
+        int cpu;
+        while ((item = readdir(dir)) != NULL && clusterCount < MAX_CLUSTERS) {
+            if (sscanf(item->d_name, "policy%d", &cpu) != 1) continue;
+            snprintf(path, sizeof(path), MOONFORGE_SYSFS_ROOT "/sys/devices/system/cpu/cpufreq/%s", item->d_name);
+            addCluster(cpu, path, 0);
+        }
+        closedir(dir);
+    }
+
+    if (clusterCount == 0) {
+        long cpuCount = sysconf(_SC_NPROCESSORS_CONF);
+        for (int cpu = 0; cpu < cpuCount && clusterCount < MAX_CLUSTERS; cpu++) {
+            snprintf(path, sizeof(path), MOONFORGE_SYSFS_ROOT "/sys/devices/system/cpu/cpu%d/cpufreq", cpu);
+            addCluster(cpu, path, 1);
+        }
+    }
+
+    // Directory order is arbitrary; report clusters little to big
+    for (int i = 1; i < clusterCount; i++) {
+        struct Cluster cluster = clusters[i];
+        int j = i;
+        while (j > 0 && clusters[j - 1].cpu > cluster.cpu) {
+            clusters[j] = clusters[j - 1];
+            j--;
+        }
+        clusters[j] = cluster;
+    }
+}
+
+static void openBattery(const char* directory) {
+    char path[PATH_BUFFER_SIZE];
+
+    snprintf(path, sizeof(path), "%s/capacity", directory);
+    batteryCapacityFd = openReadOnly(path);
+    snprintf(path, sizeof(path), "%s/status", directory);
+    batteryStatusFd = openReadOnly(path);
+    snprintf(path, sizeof(path), "%s/temp", directory);
+    batteryTemperatureFd = openReadOnly(path);
+}
+
+static void discoverBattery(void) {
+    // Android names it "battery"; laptops use BAT0 and friends
+    if (access(MOONFORGE_SYSFS_ROOT "/sys/class/power_supply/battery/capacity", F_OK) == 0) {
+        openBattery(MOONFORGE_SYSFS_ROOT "/sys/class/power_supply/battery");
+        return;
+    }
+
+    DIR* dir = opendir(MOONFORGE_SYSFS_ROOT "/sys/class/power_supply");
+    if (dir == NULL) return;
+
+    char path[PATH_BUFFER_SIZE];
+    char type[VALUE_BUFFER_SIZE];
+    struct dirent* item;
+    while ((item = readdir(dir)) != NULL) {
+        if (item->d_name[0] == '.') continue;
+
+        snprintf(path, sizeof(path), MOONFORGE_SYSFS_ROOT "/sys/class/power_supply/%s/type", item->d_name);
+        if (readPathText(path, type, sizeof(type)) <= 0 || strcmp(type, "Battery") != 0) continue;
+
+        snprintf(path, sizeof(path), MOONFORGE_SYSFS_ROOT "/sys/class/power_supply/%s", item->d_name);
+        openBattery(path);
+        break;
+    }
+    closedir(dir);
+}
+
+// Sampling
+
+static int sampleThermalZones(struct DeviceSnapshot* snapshot) {
+    snapshot->temperatureC = UNKNOWN_TEMPERATURE;
+    snapshot->hottestZone[0] = '\0';
+
+    for (int i = 0; i < zoneCount; i++) {
+        long long raw;
+        if (!readLong(zones[i].fd, &raw)) continue;
+
+        float celsius = zoneTemperature(raw);
+        if (celsius != UNKNOWN_TEMPERATURE && celsius > snapshot->temperatureC) {
+            snapshot->temperatureC = celsius;
+            memcpy(snapshot->hottestZone, zones[i].type, sizeof(snapshot->hottestZone));
+        }
+    }
+    return snapshot->temperatureC != UNKNOWN_TEMPERATURE;
+}
+
+static int sampleClusters(struct DeviceSnapshot* snapshot) {
+    snapshot->cpuFrequencyCapPercent = -1.0f;
+    snapshot->clusterCount = clusterCount;
+
+    for (int i = 0; i < clusterCount; i++) {
+        struct ClusterSample* sample = &snapshot->clusters[i];
+        long long value;
+
+        sample->cpu = clusters[i].cpu;
+        sample->maxKhz = clusters[i].maxKhz;
+        // Offline clusters fail to read; they report 0
+        sample->curKhz = readLong(clusters[i].curFd, &value) ? (int)value : 0;
+        sample->capKhz = readLong(clusters[i].capFd, &value) ? (int)value : 0;
+
+        if (sample->capKhz > 0) {
+            float percent = (float)sample->capKhz * 100.0f / (float)sample->maxKhz;
+            if (percent > 100.0f) percent = 100.0f;
+            if (snapshot->cpuFrequencyCapPercent < 0 || percent < snapshot->cpuFrequencyCapPercent) {
+                snapshot->cpuFrequencyCapPercent = percent;
+            }
+        }
+    }
+    return snapshot->cpuFrequencyCapPercent >= 0;
+}
+
+static int sampleBattery(struct DeviceSnapshot* snapshot) {
+    char status[VALUE_BUFFER_SIZE];
+    long long value;
+
+    snapshot->batteryPercent = readLong(batteryCapacityFd, &value) && value >= 0 && value <= 100 ? (int)value : -1;
+
+    snapshot->batteryCharging = -1;
+    if (readText(batteryStatusFd, status, sizeof(status)) > 0) {
+        if (strcmp(status, "Charging") == 0 || strcmp(status, "Full") == 0) {
+            snapshot->batteryCharging = 1;
+        } else if (strcmp(status, "Discharging") == 0 || strcmp(status, "Not charging") == 0) {
+            snapshot->batteryCharging = 0;
+        }
+    }
+
+    // power_supply reports tenths of a degree
+    snapshot->batteryTemperatureC = UNKNOWN_TEMPERATURE;
+    if (readLong(batteryTemperatureFd, &value)) {
+        float celsius = (float)value / 10.0f;
+        if (celsius > MIN_VALID_TEMPERATURE && celsius < MAX_VALID_TEMPERATURE) snapshot->batteryTemperatureC = celsius;
+    }
+
+    return snapshot->batteryPercent >= 0 || snapshot->batteryCharging >= 0;
+}
+
+// Public API
+
+int MoonForge_DeviceSampler_Sample(void) {
+    pthread_mutex_lock(&sampleLock);
+
+    if (!isDiscovered) {
+        discoverThermalZones();
+        discoverClusters();
+        discoverBattery();
+        isDiscovered = 1;
+    }
+
+    int nextIndex = __atomic_load_n(&publishedIndex, __ATOMIC_ACQUIRE) == 0 ? 1 : 0;
+    struct DeviceSnapshot* snapshot = &snapshots[nextIndex];
+
+    int hasThermal = sampleThermalZones(snapshot);
+    int hasClusters = sampleClusters(snapshot);
+    int hasBattery = sampleBattery(snapshot);
+
+    __atomic_store_n(&publishedIndex, nextIndex, __ATOMIC_RELEASE);
+
+    pthread_mutex_unlock(&sampleLock);
+    return hasThermal || hasClusters || hasBattery;
+}
+
+size_t moonforge_device_sampler_write_json(char* buffer, size_t bufferSize) {
+    if (buffer == NULL || bufferSize < 3) return 0;
+
+    int index = __atomic_load_n(&publishedIndex, __ATOMIC_ACQUIRE);
+    if (index < 0) {
+        buffer[0] = '\0';
+        return 0;
+    }
+
+    const struct DeviceSnapshot* snapshot = &snapshots[index];
+
+    int written = snprintf(buffer, bufferSize,
+        "{\"temperatureC\":%.1f,\"hottestZone\":\"%s\",\"cpuFrequencyCapPercent\":%.1f,"
+        "\"batteryPercent\":%d,\"batteryCharging\":%d,\"batteryTemperatureC\":%.1f,\"clusters\":[",
+        (double)snapshot->temperatureC, snapshot->hottestZone, (double)snapshot->cpuFrequencyCapPercent,
+        snapshot->batteryPercent, snapshot->batteryCharging, (double)snapshot->batteryTemperatureC);
+    if (written < 0 || (size_t)written >= bufferSize - 2) {
+        buffer[0] = '\0';
+        return 0;
+    }
+    size_t offset = (size_t)written;
+
+    for (int i = 0; i < snapshot->clusterCount; i++) {
+        const struct ClusterSample* sample = &snapshot->clusters[i];
+        written = snprintf(buffer + offset, bufferSize - offset,
+            "%s{\"cpu\":%d,\"curKhz\":%d,\"maxKhz\":%d,\"capKhz\":%d}",
+            i > 0 ? "," : "", sample->cpu, sample->curKhz, sample->maxKhz, sample->capKhz);
+        if (written < 0 || (size_t)written >= bufferSize - offset - 2) break;
+        offset += (size_t)written;
+    }
+    buffer[offset++] = ']';
+    buffer[offset++] = '}';
+    buffer[offset] = '\0';
+    return offset;
+}
+
+int MoonForge_DeviceSampler_GetState(char* buffer, int bufferSize) {
+    if (buffer == NULL || bufferSize <= 0) return 0;
+    return (int)moonforge_device_sampler_write_json(buffer, (size_t)bufferSize);
+}
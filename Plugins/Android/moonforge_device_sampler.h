@@ -0,0 +1,49 @@
+/**
+ * MoonForge Device Sampler for Android (NDK) and Linux
+ *
+ * Reads thermal zone temperatures, per-cluster CPU frequencies and battery
+ * state from sysfs. Files are opened once and re-read with pread, so a sample
+ * costs a handful of small reads. Sampling is driven by the caller (the SDK
+ * worker's timer); the latest result is published so the crash handler can
+ * read it without locks.
+ */
+
+#ifndef MOONFORGE_DEVICE_SAMPLER_H
+#define MOONFORGE_DEVICE_SAMPLER_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef MOONFORGE_EXPORT
+#define MOONFORGE_EXPORT __attribute__((visibility("default")))
+#endif
+
+/**
+ * Take one sample and publish it
+ * @return 1 if any source could be read, 0 if sysfs is not accessible
+ */
+MOONFORGE_EXPORT int MoonForge_DeviceSampler_Sample(void);
+
+/**
+ * Latest sample as a JSON object:
+ * {"temperatureC":..,"hottestZone":"..","cpuFrequencyCapPercent":..,
+ *  "batteryPercent":..,"batteryCharging":..,"batteryTemperatureC":..,
+ *  "clusters":[{"cpu":..,"curKhz":..,"maxKhz":..,"capKhz":..}]}
+ * Unknown percentages are -1, unknown temperatures -1000, batteryCharging is -1/0/1.
+ * @return Number of characters written (0 if not sampled yet)
+ */
+MOONFORGE_EXPORT int MoonForge_DeviceSampler_GetState(char* buffer, int bufferSize);
+
+/**
+ * Same as MoonForge_DeviceSampler_GetState, for the signal handler. Async-signal-safe.
+ */
+size_t moonforge_device_sampler_write_json(char* buffer, size_t bufferSize);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MOONFORGE_DEVICE_SAMPLER_H
@@ -0,0 +1,314 @@
+/**
+ * MoonForge Fault Context for Android (NDK) and Linux
+ *
+ * /proc/self/maps is streamed through a fixed buffer one line at a time;
+ * its lines are sorted by address, so for every address of interest the
+ * mappings around it are known once the first mapping above it is read.
+ * The process may have thousands of mappings, of which a few are kept.
+ */
+
+#define _GNU_SOURCE
+
+#include "moonforge_fault_context.h"
+
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+#define FAULT_TARGETS 3       // fault address, sp, pc
+#define FAULT_MAX_MAPPINGS (FAULT_TARGETS * 3)
+#define MAPPING_NAME_SIZE 128
+
+struct Mapping {
+    uintptr_t start;
+    uintptr_t end;
+    char perms[5];
+    char name[MAPPING_NAME_SIZE];
+};
+
+// Mappings around one address, as the lines stream past
+struct Target {
+    uintptr_t address;
+    struct Mapping below;        // nearest mapping starting at or below address
+    struct Mapping underBelow;   // the one before it
+    struct Mapping above;        // first mapping starting above address
+    int hasBelow;
+    int hasUnderBelow;
+    int hasAbove;
+};
+
+// Only the signal handler uses these
+static char readBuffer[4096];
+static char line[512];
+static struct Target targets[FAULT_TARGETS];
+static const struct Mapping* kept[FAULT_MAX_MAPPINGS];
+
+// Registers
+
+struct Registers {
+    uintptr_t pc;
+    uintptr_t sp;
+    uintptr_t lr;
+    int hasLr;
+};
+
+static void readRegisters(const void* context, struct Registers* regs) {
+    memset(regs, 0, sizeof(*regs));
+    if (context == NULL) return;
+
+    const ucontext_t* uc = (const ucontext_t*)context;
+#if defined(__aarch64__)
+    regs->pc = uc->uc_mcontext.pc;
+    regs->sp = uc->uc_mcontext.sp;
+    regs->lr = uc->uc_mcontext.regs[30];
+    regs->hasLr = 1;
+#elif defined(__arm__)
+    regs->pc = uc->uc_mcontext.arm_pc;
+    regs->sp = uc->uc_mcontext.arm_sp;
+    regs->lr = uc->uc_mcontext.arm_lr;
+    regs->hasLr = 1;
+#elif defined(__x86_64__)
+    regs->pc = (uintptr_t)uc->uc_mcontext.gregs[REG_RIP];
+    regs->sp = (uintptr_t)uc->uc_mcontext.gregs[REG_RSP];
+#elif defined(__i386__)
+    regs->pc = (uintptr_t)uc->uc_mcontext.gregs[REG_EIP];
+    regs->sp = (uintptr_t)uc->uc_mcontext.gregs[REG_ESP];
+#endif
+}
+
+// /proc/self/maps
+
+static int parseHex(const char** cursor, uintptr_t* value) {
+    const char* p = *cursor;
+    uintptr_t result = 0;
+    int digits = 0;
+
+    for (;; p++, digits++) {
+        char c = *p;
+        if (c >= '0' && c <= '9') result = (result << 4) | (uintptr_t)(c - '0');
+        else if (c >= 'a' && c <= 'f') result = (result << 4) | (uintptr_t)(c - 'a' + 10);
+        else break;
+    }
+    *cursor = p;
+    *value = result;
+    return digits > 0;
+}
+
+static const char* skipField(const char* p) {
+    while (*p != '\0' && *p != ' ') p++;
+    while (*p == ' ') p++;
+    return p;
+}
+
+// "start-end perms offset dev inode   name"
+static int parseMapping(const char* text, struct Mapping* mapping) {
+    const char* p = text;
+    if (!parseHex(&p, &mapping->start) || *p++ != '-') return 0;
+    if (!parseHex(&p, &mapping->end) || *p++ != ' ') return 0;
+
+    for (int i = 0; i < 4; i++) {
+        if (p[i] == '\0') return 0;
+        mapping->perms[i] = p[i];
+    }
+    mapping->perms[4] = '\0';
+
+    p = skipField(p);   // perms
+    p = skipField(p);   // offset
+    p = skipField(p);   // dev
+    p = skipField(p);   // inode
+
+    size_t length = strlen(p);
+    if (length >= sizeof(mapping->name)) length = sizeof(mapping->name) - 1;
+    memcpy(mapping->name, p, length);
+    mapping->name[length] = '\0';
+    return 1;
+}
+
+static void trackMapping(const struct Mapping* mapping) {
+    for (int i = 0; i < FAULT_TARGETS; i++) {
+        struct Target* target = &targets[i];
+        if (mapping->start <= target->address) {
+            if (target->hasBelow) {
+                target->underBelow = target->below;
+                target->hasUnderBelow = 1;
+            }
+            target->below = *mapping;
+            target->hasBelow = 1;
+        } else if (!target->hasAbove) {
+            target->above = *mapping;
+            target->hasAbove = 1;
+        }
+    }
+}
+
+/**
+ * Stream /proc/self/maps through the given buffers, calling visit for each
+ * mapping until it returns 0
+ */
+static void streamMaps(char* buffer, size_t bufferSize, char* text, size_t textSize,
+                       int (*visit)(const struct Mapping*, void*), void* data) {
+    int fd = open("/proc/self/maps", O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return;
+
+    size_t lineLength = 0;
+    ssize_t count;
+    int more = 1;
+    while (more && (count = read(fd, buffer, bufferSize)) > 0) {
+        for (ssize_t i = 0; more && i < count; i++) {
+            char c = buffer[i];
+            if (c != '\n') {
+                // Overlong lines keep their start, which has the fields we need
+                if (lineLength < textSize - 1) text[lineLength++] = c;
+                continue;
+            }
+
+            text[lineLength] = '\0';
+            lineLength = 0;
+
+            struct Mapping mapping;
+            if (parseMapping(text, &mapping)) more = visit(&mapping, data);
+        }
+    }
+    close(fd);
+}
+
+static int visitTarget(const struct Mapping* mapping, void* data) {
+    (void)data;
+    trackMapping(mapping);
+    return 1;
+}
+
+static void scanMaps(void) {
+    streamMaps(readBuffer, sizeof(readBuffer), line, sizeof(line), visitTarget, NULL);
+}
+
+struct CodeSearch {
+    uintptr_t pc;
+    int isJit;
+};
+
+static int visitCode(const struct Mapping* mapping, void* data) {
+    struct CodeSearch* search = data;
+    if (search->pc < mapping->start) return 0;
+    if (search->pc >= mapping->end) return 1;
+
+    // Modules and the vDSO have a name; code a JIT emits lives in anonymous memory
+    search->isJit = mapping->perms[2] == 'x' &&
+                    (mapping->name[0] == '\0' || strncmp(mapping->name, "[anon", 5) == 0);
+    return 0;
+}
+
+int moonforge_fault_context_in_jit_code(const void* ucontext) {
+    struct Registers regs;
+    readRegisters(ucontext, &regs);
+    if (regs.pc == 0) return 0;
+
+    // On the stack: faults that turn into managed exceptions can happen on several threads at once
+    char buffer[1024];
+    char text[256];
+    struct CodeSearch search = { regs.pc, 0 };
+    streamMaps(buffer, sizeof(buffer), text, sizeof(text), visitCode, &search);
+    return search.isJit;
+}
+
+// JSON
+
+static size_t appendEscaped(char* out, size_t outSize, const char* in) {
+    static const char hex[] = "0123456789abcdef";
+    size_t o = 0;
+
+    for (size_t i = 0; in[i] != '\0' && o + 7 < outSize; i++) {
+        unsigned char c = (unsigned char)in[i];
+        if (c == '"' || c == '\\') {
+            out[o++] = '\\';
+            out[o++] = (char)c;
+        } else if (c < 0x20) {
+            out[o++] = '\\';
+            out[o++] = 'u';
+            out[o++] = '0';
+            out[o++] = '0';
+            out[o++] = hex[c >> 4];
+            out[o++] = hex[c & 0xf];
+        } else {
+            out[o++] = (char)c;
+        }
+    }
+    if (o < outSize) out[o] = '\0';
+    return o;
+}
+
+static int keep(int count, const struct Mapping* mapping) {
+    for (int i = 0; i < count; i++) {
+        if (kept[i]->start == mapping->start) return count;
+    }
+    kept[count] = mapping;
+    return count + 1;
+}
+
+size_t moonforge_fault_context_write_json(char* buffer, size_t bufferSize, const void* ucontext, const void* faultAddress) {
+    if (buffer == NULL || bufferSize < 3) return 0;
+
+    struct Registers regs;
+    readRegisters(ucontext, &regs);
+
+    memset(targets, 0, sizeof(targets));
+    targets[0].address = (uintptr_t)faultAddress;
+    targets[1].address = regs.sp;
+    targets[2].address = regs.pc;
+    scanMaps();
+
+    char lr[32] = "";
+    if (regs.hasLr) {
+        snprintf(lr, sizeof(lr), ",\"lr\":\"0x%" PRIxPTR "\"", regs.lr);
+    }
+
+    char stackBounds[80] = "";
+    const struct Target* stack = &targets[1];
+    if (stack->hasBelow && regs.sp < stack->below.end) {
+        snprintf(stackBounds, sizeof(stackBounds), ",\"stackStart\":\"0x%" PRIxPTR "\",\"stackEnd\":\"0x%" PRIxPTR "\"",
+                 stack->below.start, stack->below.end);
+    }
+
+    int written = snprintf(buffer, bufferSize, "{\"pc\":\"0x%" PRIxPTR "\",\"sp\":\"0x%" PRIxPTR "\"%s%s,\"maps\":[",
+                           regs.pc, regs.sp, lr, stackBounds);
+    if (written < 0 || (size_t)written >= bufferSize - 2) {
+        buffer[0] = '\0';
+        return 0;
+    }
+    size_t offset = (size_t)written;
+
+    // Lowest first, as in maps; few enough for an insertion pass
+    int count = 0;
+    for (int i = 0; i < FAULT_TARGETS; i++) {
+        if (targets[i].hasUnderBelow) count = keep(count, &targets[i].underBelow);
+        if (targets[i].hasBelow) count = keep(count, &targets[i].below);
+        if (targets[i].hasAbove) count = keep(count, &targets[i].above);
+    }
+    for (int i = 1; i < count; i++) {
+        const struct Mapping* mapping = kept[i];
+        int j = i;
+        for (; j > 0 && kept[j - 1]->start > mapping->start; j--) kept[j] = kept[j - 1];
+        kept[j] = mapping;
+    }
+
+    for (int i = 0; i < count; i++) {
+        const struct Mapping* mapping = kept[i];
+        char name[MAPPING_NAME_SIZE * 6 + 1];
+        appendEscaped(name, sizeof(name), mapping->name);
+
+        written = snprintf(buffer + offset, bufferSize - offset,
+                           "%s{\"start\":\"0x%" PRIxPTR "\",\"end\":\"0x%" PRIxPTR "\",\"perms\":\"%s\",\"name\":\"%s\"}",
+                           i == 0 ? "" : ",", mapping->start, mapping->end, mapping->perms, name);
+        // Mappings that don't fit are left out
+        if (written < 0 || (size_t)written >= bufferSize - offset - 2) break;
+        offset += (size_t)written;
+    }
+    buffer[offset++] = ']';
+    buffer[offset++] = '}';
+    buffer[offset] = '\0';
+    return offset;
+}
@@ -0,0 +1,45 @@
+/**
+ * MoonForge Fault Context for Android (NDK) and Linux
+ *
+ * What the crash record needs to tell one kind of fault from another: the
+ * interrupted thread's pc, sp (and lr on ARM), the bounds of the mapping
+ * its sp is in, and the lines of /proc/self/maps around the fault address,
+ * sp and pc. The next launch classifies the crash from these
+ * (FaultClassifier.cs); nothing is interpreted in the signal handler.
+ */
+
+#ifndef MOONFORGE_FAULT_CONTEXT_H
+#define MOONFORGE_FAULT_CONTEXT_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Write the fault context as a JSON object:
+ * {"pc":"0x..","sp":"0x..","lr":"0x..","stackStart":"0x..","stackEnd":"0x..",
+ *  "maps":[{"start":"0x..","end":"0x..","perms":"r-xp","name":".."}]}
+ * For each of the fault address, sp and pc, maps lists the mapping that
+ * contains it (or the nearest one below), the one below that and the next
+ * one above. lr is only written on ARM; the stack bounds only if sp is in a
+ * mapping. Async-signal-safe: /proc/self/maps is read with open/read.
+ * @param ucontext The signal handler's third argument (may be NULL)
+ * @return Number of characters written (0 if nothing fits)
+ */
+size_t moonforge_fault_context_write_json(char* buffer, size_t bufferSize, const void* ucontext, const void* faultAddress);
+
+/**
+ * Whether the interrupted pc is in anonymous executable memory, i.e. code a
+ * JIT emitted rather than a loaded module. 0 for a pc outside any mapping.
+ * Async-signal-safe and reentrant: the buffers are on the caller's stack.
+ * @param ucontext The signal handler's third argument
+ */
+int moonforge_fault_context_in_jit_code(const void* ucontext);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MOONFORGE_FAULT_CONTEXT_H
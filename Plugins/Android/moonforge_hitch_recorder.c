@@ -0,0 +1,411 @@
+/**
+ * MoonForge Hitch Recorder for Android (NDK) and Linux
+ *
+ * Every frame boundary costs one vDSO clock read, one getrusage and, with
+ * perf counters, one read of the counter group. getrusage(RUSAGE_THREAD)
+ * supplies CPU time, faults and context switches and needs no permission.
+ * Cycles, instructions and cache misses come from a perf_event group on the
+ * main thread; kernels with perf_event_paranoid above 2 (most Android
+ * builds) or without a PMU (VMs) refuse it and hitches go out without them.
+ *
+ * With I/O tracking, each boundary also preads /proc/self/io and
+ * /proc/self/stat from descriptors opened at start. They are process-wide,
+ * so storage reads and major faults of loader threads that the main thread
+ * waits on show up too. delayacct_blkio_ticks is only non-zero on kernels
+ * with task delay accounting enabled.
+ *
+ * Hitches go into a small single-producer ring; the worker drains it, along
+ * with the scene, level and activity names that were current at the time.
+ */
+
+#define _GNU_SOURCE
+
+#include "moonforge_hitch_recorder.h"
+
+#define LOG_TAG "MoonForgeHitch"
+#include "moonforge_log.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/perf_event.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#define RING_SIZE 32
+#define PERF_COUNTER_COUNT 3
+#define CONTEXT_NAME_SIZE 64
+#define PROC_BUFFER_SIZE 1024
+
+struct HitchRecord {
+    long long timestampMs;
+    float durationMs;
+    float cpuTimeMs;
+    long long minorFaults;
+    long long majorFaults;
+    long long contextSwitches;
+    long long perf[PERF_COUNTER_COUNT];
+    long long processMajorFaults;
+    long long readBytes;
+    long long writeBytes;
+    long long ioWaitMs;
+    char scene[CONTEXT_NAME_SIZE];
+    char level[CONTEXT_NAME_SIZE];
+    char activity[CONTEXT_NAME_SIZE];
+};
+
+// Process-wide I/O counters
+struct IoCounters {
+    long long majorFaults;
+    long long readBytes;
+    long long writeBytes;
+    long long ioWaitTicks;
+};
+
+struct FrameCounters {
+    struct timespec time;
+    long long cpuTimeUs;
+    long long minorFaults;
+    long long majorFaults;
+    long long contextSwitches;
+    unsigned long long perf[PERF_COUNTER_COUNT];
+    unsigned long long timeEnabled;
+    unsigned long long timeRunning;
+    int hasPerf;
+    struct IoCounters io;
+    int hasIo;
+};
+
+// Hardware counters, in output order
+static const unsigned long long perfConfigs[PERF_COUNTER_COUNT] = {
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES,
+};
+
+// Recorder state, owned by the thread that called MoonForge_Hitch_Start
+static int isRunning = 0;
+static long long thresholdNs = 0;
+static int perfFds[PERF_COUNTER_COUNT] = { -1, -1, -1 };
+// Position of each counter in the group read, or -1 if the PMU lacks it
+static int perfSlots[PERF_COUNTER_COUNT] = { -1, -1, -1 };
+static int perfMemberCount = 0;
+static int hasBaseline = 0;
+static struct FrameCounters previous;
+static int ioFd = -1;
+static int statFd = -1;
+static long clockTicks = 100;
+
+// What the game was doing, set from the main thread
+static char currentScene[CONTEXT_NAME_SIZE];
+static char currentLevel[CONTEXT_NAME_SIZE];
+static char currentActivity[CONTEXT_NAME_SIZE];
+
+// Single producer (frame thread), single consumer (drain)
+static struct HitchRecord ring[RING_SIZE];
+static unsigned int writeCount = 0;
+static unsigned int readCount = 0;
+static pthread_mutex_t drainLock = PTHREAD_MUTEX_INITIALIZER;
+
+// perf events
+
+static int openPerfCounter(unsigned long long config, int groupFd) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    // User space only, which perf_event_paranoid 2 still allows
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    // pid 0, cpu -1: the calling thread on any CPU
+    return (int)syscall(__NR_perf_event_open, &attr, 0, -1, groupFd, PERF_FLAG_FD_CLOEXEC);
+}
+
+static void closePerfCounters(void) {
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        if (perfFds[i] >= 0) close(perfFds[i]);
+        perfFds[i] = -1;
+        perfSlots[i] = -1;
+    }
+    perfMemberCount = 0;
+}
+
+static int openPerfCounters(void) {
+    perfFds[0] = openPerfCounter(perfConfigs[0], -1);
+    if (perfFds[0] < 0) {
+        LOGD("perf counters unavailable: %s", strerror(errno));
+        return 0;
+    }
+    perfSlots[0] = perfMemberCount++;
+
+    for (int i = 1; i < PERF_COUNTER_COUNT; i++) {
+        perfFds[i] = openPerfCounter(perfConfigs[i], perfFds[0]);
+        if (perfFds[i] >= 0) perfSlots[i] = perfMemberCount++;
+    }
+    return 1;
+}
+
+// /proc I/O counters
+
+static long long findIoValue(const char* text, const char* key) {
+    const char* line = strstr(text, key);
+    return line != NULL ? strtoll(line + strlen(key), NULL, 10) : 0;
+}
+
+static int readIoCounters(struct IoCounters* io) {
+    char buffer[PROC_BUFFER_SIZE];
+
+    ssize_t length = pread(ioFd, buffer, sizeof(buffer) - 1, 0);
+    if (length <= 0) return 0;
+    buffer[length] = '\0';
+    // read_bytes and write_bytes reached the block layer; rchar/wchar include the page cache
+    io->readBytes = findIoValue(buffer, "\nread_bytes: ");
+    io->writeBytes = findIoValue(buffer, "\nwrite_bytes: ");
+
+    length = pread(statFd, buffer, sizeof(buffer) - 1, 0);
+    if (length <= 0) return 0;
+    buffer[length] = '\0';
+
+    // comm may contain spaces; fields after it start at 3 (state)
+    char* p = strrchr(buffer, ')');
+    if (p == NULL) return 0;
+
+    io->majorFaults = 0;
+    io->ioWaitTicks = 0;
+    for (int field = 3; field <= 42; field++) {
+        p = strchr(p + 1, ' ');
+        if (p == NULL) break;
+        // p is at the space before field N: majflt is 12, delayacct_blkio_ticks 42
+        if (field == 12) io->majorFaults = strtoll(p + 1, NULL, 10);
+        if (field == 42) io->ioWaitTicks = strtoll(p + 1, NULL, 10);
+    }
+    return 1;
+}
+
+static void closeIoCounters(void) {
+    if (ioFd >= 0) close(ioFd);
+    if (statFd >= 0) close(statFd);
+    ioFd = -1;
+    statFd = -1;
+}
+
+static void openIoCounters(void) {
+    ioFd = open("/proc/self/io", O_RDONLY | O_CLOEXEC);
+    statFd = open("/proc/self/stat", O_RDONLY | O_CLOEXEC);
+
+    struct IoCounters probe;
+    if (ioFd < 0 || statFd < 0 || !readIoCounters(&probe)) {
+        LOGD("I/O counters unavailable");
+        closeIoCounters();
+    }
+
+    clockTicks = sysconf(_SC_CLK_TCK);
+    if (clockTicks <= 0) clockTicks = 100;
+}
+
+static void copyName(char* destination, const char* source) {
+    size_t length = source != NULL ? strnlen(source, CONTEXT_NAME_SIZE - 1) : 0;
+    for (size_t i = 0; i < length; i++) {
+        char c = source[i];
+        // Names go into JSON unescaped
+        destination[i] = (c == '"' || c == '\\' || (unsigned char)c < 0x20) ? '_' : c;
+    }
+    destination[length] = '\0';
+}
+
+// Counters
+
+static void readCounters(struct FrameCounters* counters) {
+    memset(counters, 0, sizeof(*counters));
+    clock_gettime(CLOCK_MONOTONIC, &counters->time);
+
+    struct rusage usage;
+    if (getrusage(RUSAGE_THREAD, &usage) == 0) {
+        counters->cpuTimeUs = (long long)(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000LL
+            + usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+        counters->minorFaults = usage.ru_minflt;
+        counters->majorFaults = usage.ru_majflt;
+        counters->contextSwitches = usage.ru_nvcsw + usage.ru_nivcsw;
+    }
+
+    counters->hasPerf = 0;
+    if (perfMemberCount > 0) {
+        // nr, time_enabled, time_running, then one value per member
+        unsigned long long values[3 + PERF_COUNTER_COUNT];
+        ssize_t length = read(perfFds[0], values, sizeof(values));
+        if (length >= (ssize_t)((3 + perfMemberCount) * sizeof(unsigned long long))) {
+            counters->timeEnabled = values[1];
+            counters->timeRunning = values[2];
+            for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+                counters->perf[i] = perfSlots[i] >= 0 ? values[3 + perfSlots[i]] : 0;
+            }
+            counters->hasPerf = 1;
+        }
+    }
+
+    counters->hasIo = ioFd >= 0 && readIoCounters(&counters->io);
+}
+
+static void recordHitch(const struct FrameCounters* start, const struct FrameCounters* end, long long durationNs) {
+    unsigned int writeIndex = writeCount;
+    if (writeIndex - __atomic_load_n(&readCount, __ATOMIC_ACQUIRE) >= RING_SIZE) return;
+
+    struct HitchRecord* record = &ring[writeIndex % RING_SIZE];
+
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    record->timestampMs = (long long)now.tv_sec * 1000 + now.tv_nsec / 1000000;
+    record->durationMs = (float)durationNs / 1e6f;
+    record->cpuTimeMs = (float)(end->cpuTimeUs - start->cpuTimeUs) / 1000.0f;
+    record->minorFaults = end->minorFaults - start->minorFaults;
+    record->majorFaults = end->majorFaults - start->majorFaults;
+    record->contextSwitches = end->contextSwitches - start->contextSwitches;
+
+    // Scale up when the counters shared the PMU with other events during the frame
+    unsigned long long enabled = end->timeEnabled - start->timeEnabled;
+    unsigned long long running = end->timeRunning - start->timeRunning;
+    int hasPerf = start->hasPerf && end->hasPerf && running > 0;
+
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        if (!hasPerf || perfSlots[i] < 0) {
+            record->perf[i] = -1;
+            continue;
+        }
+        double delta = (double)(end->perf[i] - start->perf[i]);
+        if (running < enabled) delta = delta * (double)enabled / (double)running;
+        record->perf[i] = (long long)delta;
+    }
+
+    if (start->hasIo && end->hasIo) {
+        record->processMajorFaults = end->io.majorFaults - start->io.majorFaults;
+        record->readBytes = end->io.readBytes - start->io.readBytes;
+        record->writeBytes = end->io.writeBytes - start->io.writeBytes;
+        record->ioWaitMs = (end->io.ioWaitTicks - start->io.ioWaitTicks) * 1000 / clockTicks;
+    } else {
+        record->processMajorFaults = -1;
+        record->readBytes = -1;
+        record->writeBytes = -1;
+        record->ioWaitMs = -1;
+    }
+
+    memcpy(record->scene, currentScene, sizeof(record->scene));
+    memcpy(record->level, currentLevel, sizeof(record->level));
+    memcpy(record->activity, currentActivity, sizeof(record->activity));
+
+    __atomic_store_n(&writeCount, writeIndex + 1, __ATOMIC_RELEASE);
+}
+
+// Public API
+
+int MoonForge_Hitch_Start(int thresholdMs, int usePerfCounters, int trackIo) {
+    if (thresholdMs <= 0) return 0;
+
+    if (!isRunning) {
+        if (usePerfCounters) openPerfCounters();
+        if (trackIo) openIoCounters();
+        isRunning = 1;
+        hasBaseline = 0;
+    }
+    thresholdNs = (long long)thresholdMs * 1000000LL;
+
+    LOGD("Hitch recorder started (%d ms, perf counters %s)", thresholdMs, perfMemberCount > 0 ? "on" : "off");
+    return MOONFORGE_HITCH_COUNTERS_RUSAGE
+        | (perfMemberCount > 0 ? MOONFORGE_HITCH_COUNTERS_PERF : 0)
+        | (ioFd >= 0 ? MOONFORGE_HITCH_COUNTERS_IO : 0);
+}
+
+void MoonForge_Hitch_Stop(void) {
+    if (!isRunning) return;
+
+    isRunning = 0;
+    hasBaseline = 0;
+    closePerfCounters();
+    closeIoCounters();
+}
+
+void MoonForge_Hitch_FrameBoundary(void) {
+    if (!isRunning) return;
+
+    struct FrameCounters current;
+    readCounters(&current);
+
+    if (hasBaseline) {
+        long long durationNs = (long long)(current.time.tv_sec - previous.time.tv_sec) * 1000000000LL
+            + (current.time.tv_nsec - previous.time.tv_nsec);
+        if (durationNs >= thresholdNs) recordHitch(&previous, &current, durationNs);
+    }
+
+    previous = current;
+    hasBaseline = 1;
+}
+
+void MoonForge_Hitch_Reset(void) {
+    hasBaseline = 0;
+}
+
+void MoonForge_Hitch_SetContext(const char* scene, const char* level, const char* activity) {
+    copyName(currentScene, scene);
+    copyName(currentLevel, level);
+    copyName(currentActivity, activity);
+}
+
+int MoonForge_Hitch_GetIoTotals(long long* values, int count) {
+    struct IoCounters io;
+    if (values == NULL || count < 4 || ioFd < 0 || !readIoCounters(&io)) return 0;
+
+    values[0] = io.majorFaults;
+    values[1] = io.readBytes;
+    values[2] = io.writeBytes;
+    values[3] = io.ioWaitTicks * 1000 / clockTicks;
+    return 4;
+}
+
+int MoonForge_Hitch_Drain(char* buffer, int bufferSize) {
+    if (buffer == NULL || bufferSize < 3) return 0;
+
+    pthread_mutex_lock(&drainLock);
+
+    unsigned int readIndex = readCount;
+    unsigned int writeIndex = __atomic_load_n(&writeCount, __ATOMIC_ACQUIRE);
+    if (readIndex == writeIndex) {
+        pthread_mutex_unlock(&drainLock);
+        buffer[0] = '\0';
+        return 0;
+    }
+
+    size_t size = (size_t)bufferSize;
+    size_t offset = 0;
+    buffer[offset++] = '[';
+
+    for (; readIndex != writeIndex; readIndex++) {
+        const struct HitchRecord* record = &ring[readIndex % RING_SIZE];
+        int written = snprintf(buffer + offset, size - offset,
+            "%s{\"timestamp\":%lld,\"durationMs\":%.1f,\"cpuTimeMs\":%.1f,\"minorFaults\":%lld,"
+            "\"majorFaults\":%lld,\"contextSwitches\":%lld,\"cycles\":%lld,\"instructions\":%lld,\"cacheMisses\":%lld,"
+            "\"processMajorFaults\":%lld,\"readBytes\":%lld,\"writeBytes\":%lld,\"ioWaitMs\":%lld,"
+            "\"scene\":\"%s\",\"level\":\"%s\",\"activity\":\"%s\"}",
+            offset > 1 ? "," : "", record->timestampMs, (double)record->durationMs, (double)record->cpuTimeMs,
+            record->minorFaults, record->majorFaults, record->contextSwitches,
+            record->perf[0], record->perf[1], record->perf[2],
+            record->processMajorFaults, record->readBytes, record->writeBytes, record->ioWaitMs,
+            record->scene, record->level, record->activity);
+        // Leave the rest for the next drain
+        if (written < 0 || (size_t)written >= size - offset - 1) break;
+        offset += (size_t)written;
+    }
+
+    __atomic_store_n(&readCount, readIndex, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&drainLock);
+
+    buffer[offset++] = ']';
+    buffer[offset] = '\0';
+    return offset > 2 ? (int)offset : 0;
+}
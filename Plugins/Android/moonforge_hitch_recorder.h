@@ -0,0 +1,78 @@
+/**
+ * MoonForge Hitch Recorder for Android (NDK) and Linux
+ *
+ * Times the main thread between frame boundaries and records frames over a
+ * threshold, with counter deltas for that frame: the thread's CPU time,
+ * page faults and context switches always; cycles, instructions and cache
+ * misses when perf events are permitted; process-wide storage I/O and major
+ * faults when tracked. Recorded hitches are drained by the SDK worker.
+ */
+
+#ifndef MOONFORGE_HITCH_RECORDER_H
+#define MOONFORGE_HITCH_RECORDER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef MOONFORGE_EXPORT
+#define MOONFORGE_EXPORT __attribute__((visibility("default")))
+#endif
+
+// Counter sources, as returned by MoonForge_Hitch_Start
+#define MOONFORGE_HITCH_COUNTERS_RUSAGE 1
+#define MOONFORGE_HITCH_COUNTERS_PERF 2
+#define MOONFORGE_HITCH_COUNTERS_IO 4
+
+/**
+ * Start recording frames of the calling thread (the main thread)
+ * @param thresholdMs Frames at least this long are recorded
+ * @param usePerfCounters Non-zero to open hardware perf counters for the thread
+ * @param trackIo Non-zero to track process-wide storage I/O and major faults from /proc
+ * @return Bitmask of MOONFORGE_HITCH_COUNTERS_* in use, or 0 on failure
+ */
+MOONFORGE_EXPORT int MoonForge_Hitch_Start(int thresholdMs, int usePerfCounters, int trackIo);
+
+/**
+ * Stop recording and close the counters. Call from the thread that started.
+ */
+MOONFORGE_EXPORT void MoonForge_Hitch_Stop(void);
+
+/**
+ * Mark the end of a frame. Call once per frame from the thread that started.
+ */
+MOONFORGE_EXPORT void MoonForge_Hitch_FrameBoundary(void);
+
+/**
+ * Forget the current frame, e.g. around application pause, so the gap is not reported as a hitch
+ */
+MOONFORGE_EXPORT void MoonForge_Hitch_Reset(void);
+
+/**
+ * Scene, level and activity names recorded with later hitches. NULL clears a name.
+ * Call from the thread that started.
+ */
+MOONFORGE_EXPORT void MoonForge_Hitch_SetContext(const char* scene, const char* level, const char* activity);
+
+/**
+ * Current process-wide totals: major faults, storage bytes read, storage bytes written, I/O wait ms
+ * @return 4, or 0 if I/O is not tracked
+ */
+MOONFORGE_EXPORT int MoonForge_Hitch_GetIoTotals(long long* values, int count);
+
+/**
+ * Move recorded hitches out as a JSON array, oldest first:
+ * [{"timestamp":..,"durationMs":..,"cpuTimeMs":..,"minorFaults":..,"majorFaults":..,
+ *   "contextSwitches":..,"cycles":..,"instructions":..,"cacheMisses":..,
+ *   "processMajorFaults":..,"readBytes":..,"writeBytes":..,"ioWaitMs":..,
+ *   "scene":"..","level":"..","activity":".."}]
+ * Hardware and I/O counters are -1 when unavailable. Safe to call from any one thread.
+ * @return Number of characters written (0 if nothing was recorded)
+ */
+MOONFORGE_EXPORT int MoonForge_Hitch_Drain(char* buffer, int bufferSize);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MOONFORGE_HITCH_RECORDER_H
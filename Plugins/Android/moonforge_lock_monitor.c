@@ -0,0 +1,794 @@
+/**
+ * MoonForge Lock Monitor for Android (NDK) and Linux
+ *
+ * Every monitored lock first tries the mutex; only when that fails does the
+ * thread publish what it waits on and block. Ownership is recorded for a
+ * sample of mutexes from their first lock and for every mutex once it has
+ * been contended, so the uncontended cost for the rest is a trylock and a
+ * probe of the lock table. A waiter's stack is captured only once it has
+ * waited STACK_DELAY_MS: short waits never pay for a stack walk.
+ *
+ * Owners live in a fixed open-addressed table claimed with compare-and-swap
+ * and waits in a pool of per-thread slots, each published under a sequence
+ * number so the checker can copy it without a lock.
+ */
+
+#define _GNU_SOURCE
+
+#include "moonforge_lock_monitor.h"
+#include "moonforge_context_store.h"
+#include "moonforge_plt_hook.h"
+
+#include <dlfcn.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <link.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#include <unwind.h>
+
+#define LOG_TAG "MoonForgeLocks"
+#include "moonforge_log.h"
+
+#define DEFAULT_SAMPLE_RATE 16
+#define MAX_LOCKS 4096              // power of two
+#define MAX_TRACKED_LOCKS (MAX_LOCKS * 3 / 4)
+#define MAX_THREAD_SLOTS 256
+#define WAIT_FRAMES 32
+#define STACK_DELAY_MS 100
+#define SNAPSHOT_ATTEMPTS 4
+#define REPORT_MAX_THREADS 16
+
+#define WAIT_MUTEX 1
+#define WAIT_CONDITION 2
+
+// A mutex whose owner is recorded
+typedef struct {
+    _Atomic uintptr_t mutex;
+    atomic_int owner;              // thread id, 0 when free or not known
+    int depth;                     // recursive acquisitions; only the owner touches it
+} LockEntry;
+
+// A thread that has touched a tracked mutex or had to wait. ELF TLS needs
+// API 29 and emulated TLS allocates, so slots come from a fixed pool and are
+// found through a pthread key.
+typedef struct {
+    atomic_int inUse;
+    atomic_int tid;
+    atomic_int heldLocks;          // tracked mutexes this thread owns
+    int busy;                      // inside the monitor; nested lock calls pass straight through
+    uintptr_t stackLow;
+    uintptr_t stackHigh;
+
+    // The current wait, written by the thread under sequence (odd while changing)
+    atomic_uint sequence;
+    _Atomic uintptr_t waitingOn;   // mutex or condition, 0 when not waiting
+    int waitKind;
+    unsigned waitNumber;
+    int64_t waitStartMs;
+    int depth;
+    uintptr_t frames[WAIT_FRAMES];
+
+    // Written by the checker: the last wait it reported
+    atomic_uint reportedWait;
+} ThreadSlot;
+
+static atomic_int running = 0;
+static int sampleRate = DEFAULT_SAMPLE_RATE;
+static int mainThreadId = 0;
+
+static LockEntry locks[MAX_LOCKS];
+static atomic_int lockCount = 0;
+
+static ThreadSlot threadSlots[MAX_THREAD_SLOTS];
+static pthread_key_t threadKey;
+static pthread_once_t keyOnce = PTHREAD_ONCE_INIT;
+
+// Text segment of this library; its frames are left out of wait stacks
+static uintptr_t ownTextStart = 0;
+static uintptr_t ownTextEnd = 0;
+
+static int currentThreadId(void) {
+    return (int)syscall(SYS_gettid);
+}
+
+static int64_t monotonicMs(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+// Threads
+
+static void releaseThreadSlot(void* value) {
+    ThreadSlot* slot = (ThreadSlot*)value;
+    if (slot == NULL) return;
+    atomic_store_explicit(&slot->waitingOn, 0, memory_order_relaxed);
+    atomic_store_explicit(&slot->tid, 0, memory_order_relaxed);
+    atomic_store_explicit(&slot->inUse, 0, memory_order_release);
+}
+
+static void createThreadKey(void) {
+    pthread_key_create(&threadKey, releaseThreadSlot);
+}
+
+static ThreadSlot* currentSlot(void) {
+    ThreadSlot* slot = (ThreadSlot*)pthread_getspecific(threadKey);
+    if (slot != NULL) return slot;
+
+    for (int i = 0; i < MAX_THREAD_SLOTS; i++) {
+        int expected = 0;
+        if (atomic_compare_exchange_strong(&threadSlots[i].inUse, &expected, 1)) {
+            slot = &threadSlots[i];
+            break;
+        }
+    }
+
+    // Threads beyond the pool are not tracked
+    if (slot == NULL) return NULL;
+
+    // Busy while initializing: pthread_getattr_np reads /proc and allocates on the main thread
+    slot->busy = 1;
+    atomic_store_explicit(&slot->heldLocks, 0, memory_order_relaxed);
+    atomic_store_explicit(&slot->waitingOn, 0, memory_order_relaxed);
+    slot->stackLow = 0;
+    slot->stackHigh = 0;
+
+    pthread_attr_t attr;
+    if (pthread_getattr_np(pthread_self(), &attr) == 0) {
+        void* base;
+        size_t size;
+        if (pthread_attr_getstack(&attr, &base, &size) == 0) {
+            slot->stackLow = (uintptr_t)base;
+            slot->stackHigh = (uintptr_t)base + size;
+        }
+        pthread_attr_destroy(&attr);
+    }
+
+    atomic_store_explicit(&slot->tid, currentThreadId(), memory_order_relaxed);
+    pthread_setspecific(threadKey, slot);
+    slot->busy = 0;
+    return slot;
+}
+
+// Lock table
+
+static uint32_t pointerHash(uintptr_t address) {
+    uint64_t x = (uint64_t)address;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return (uint32_t)x;
+}
+
+static int isSampled(uintptr_t mutex) {
+    // Bits above the table index, so sampled mutexes don't cluster in the table
+    return sampleRate <= 1 || (pointerHash(mutex) >> 12) % (uint32_t)sampleRate == 0;
+}
+
+/**
+ * Find a mutex's entry, claiming one if insert is set. Entries are never
+ * removed: a mutex reallocated at the same address keeps the entry.
+ */
+static LockEntry* findLock(uintptr_t mutex, int insert) {
+    uint32_t index = pointerHash(mutex) & (MAX_LOCKS - 1);
+
+    for (int probe = 0; probe < MAX_LOCKS; probe++) {
+        LockEntry* entry = &locks[index];
+        uintptr_t current = atomic_load_explicit(&entry->mutex, memory_order_acquire);
+        if (current == mutex) return entry;
+
+        if (current == 0) {
+            // Keep the table at most 3/4 full so misses stay short
+            if (!insert || atomic_load_explicit(&lockCount, memory_order_relaxed) >= MAX_TRACKED_LOCKS) return NULL;
+
+            uintptr_t expected = 0;
+            if (atomic_compare_exchange_strong(&entry->mutex, &expected, mutex)) {
+                atomic_fetch_add_explicit(&lockCount, 1, memory_order_relaxed);
+                return entry;
+            }
+            if (expected == mutex) return entry;
+            // Another mutex took the slot; keep probing
+        }
+        index = (index + 1) & (MAX_LOCKS - 1);
+    }
+    return NULL;
+}
+
+static void noteAcquired(pthread_mutex_t* mutex, int contended) {
+    LockEntry* entry = findLock((uintptr_t)mutex, contended || isSampled((uintptr_t)mutex));
+    if (entry == NULL) return;
+
+    ThreadSlot* slot = currentSlot();
+    if (slot == NULL || slot->busy) return;
+
+    int tid = atomic_load_explicit(&slot->tid, memory_order_relaxed);
+    if (atomic_load_explicit(&entry->owner, memory_order_relaxed) == tid) {
+        entry->depth++;
+        return;
+    }
+    entry->depth = 1;
+    atomic_store_explicit(&entry->owner, tid, memory_order_relaxed);
+    atomic_fetch_add_explicit(&slot->heldLocks, 1, memory_order_relaxed);
+}
+
+static void noteReleased(pthread_mutex_t* mutex) {
+    LockEntry* entry = findLock((uintptr_t)mutex, 0);
+    if (entry == NULL) return;
+
+    // A thread without a slot never recorded owning anything
+    ThreadSlot* slot = (ThreadSlot*)pthread_getspecific(threadKey);
+    if (slot == NULL) return;
+
+    int tid = atomic_load_explicit(&slot->tid, memory_order_relaxed);
+    if (atomic_load_explicit(&entry->owner, memory_order_relaxed) != tid) return;
+    if (--entry->depth > 0) return;
+
+    atomic_store_explicit(&entry->owner, 0, memory_order_relaxed);
+    atomic_fetch_sub_explicit(&slot->heldLocks, 1, memory_order_relaxed);
+}
+
+// Waits
+
+static void beginWait(ThreadSlot* slot, uintptr_t object, int kind) {
+    unsigned sequence = atomic_load_explicit(&slot->sequence, memory_order_relaxed);
+    atomic_store_explicit(&slot->sequence, sequence + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    slot->waitKind = kind;
+    slot->waitNumber++;
+    slot->waitStartMs = monotonicMs();
+    slot->depth = 0;
+    atomic_store_explicit(&slot->waitingOn, object, memory_order_relaxed);
+
+    atomic_store_explicit(&slot->sequence, sequence + 2, memory_order_release);
+}
+
+static void endWait(ThreadSlot* slot) {
+    unsigned sequence = atomic_load_explicit(&slot->sequence, memory_order_relaxed);
+    atomic_store_explicit(&slot->sequence, sequence + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    atomic_store_explicit(&slot->waitingOn, 0, memory_order_relaxed);
+    slot->depth = 0;
+
+    atomic_store_explicit(&slot->sequence, sequence + 2, memory_order_release);
+}
+
+#if defined(__arm__)
+struct UnwindState {
+    uintptr_t* frames;
+    int depth;
+    int skipping;
+};
+
+static _Unwind_Reason_Code unwindCallback(struct _Unwind_Context* context, void* arg) {
+    struct UnwindState* state = (struct UnwindState*)arg;
+    uintptr_t pc = _Unwind_GetIP(context);
+    if (pc == 0) return _URC_NO_REASON;
+    if (state->skipping && pc >= ownTextStart && pc < ownTextEnd) return _URC_NO_REASON;
+    state->skipping = 0;
+    if (state->depth == WAIT_FRAMES) return _URC_END_OF_STACK;
+    state->frames[state->depth++] = pc;
+    return _URC_NO_REASON;
+}
+#endif
+
+/**
+ * Record the waiting thread's stack, leaving out the monitor's own frames.
+ * Frame-pointer walk on arm64/x86/x86_64, as in the allocation profiler;
+ * 32-bit ARM has no usable frame-record convention and uses the unwinder.
+ */
+__attribute__((noinline))
+static void captureWaitStack(ThreadSlot* slot) {
+    uintptr_t frames[WAIT_FRAMES];
+    int depth = 0;
+
+    slot->busy = 1;
+#if defined(__arm__)
+    struct UnwindState unwind = { frames, 0, 1 };
+    _Unwind_Backtrace(unwindCallback, &unwind);
+    depth = unwind.depth;
+#else
+    uintptr_t fp = (uintptr_t)__builtin_frame_address(0);
+    uintptr_t low = slot->stackLow ? slot->stackLow : fp;
+    uintptr_t high = slot->stackHigh ? slot->stackHigh : fp + 1024 * 1024;
+    int skipping = 1;
+
+    while (depth < WAIT_FRAMES) {
+        if (fp < low || fp + 2 * sizeof(uintptr_t) > high || (fp & (sizeof(uintptr_t) - 1)) != 0) break;
+
+        uintptr_t next = ((uintptr_t*)fp)[0];
+        uintptr_t pc = ((uintptr_t*)fp)[1];
+        if (pc == 0) break;
+
+        if (!skipping || pc < ownTextStart || pc >= ownTextEnd) {
+            skipping = 0;
+            frames[depth++] = pc;
+        }
+
+        // Frames grow down, so callers are at higher addresses
+        if (next <= fp) break;
+        fp = next;
+    }
+#endif
+    slot->busy = 0;
+
+    unsigned sequence = atomic_load_explicit(&slot->sequence, memory_order_relaxed);
+    atomic_store_explicit(&slot->sequence, sequence + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    memcpy(slot->frames, frames, (size_t)depth * sizeof(uintptr_t));
+    slot->depth = depth;
+    atomic_store_explicit(&slot->sequence, sequence + 2, memory_order_release);
+}
+
+static int waitForMutex(pthread_mutex_t* mutex) {
+    ThreadSlot* slot = currentSlot();
+    if (slot == NULL || slot->busy) return pthread_mutex_lock(mutex);
+
+    // Contended mutexes are tracked from here on, so their next owner is known
+    findLock((uintptr_t)mutex, 1);
+    beginWait(slot, (uintptr_t)mutex, WAIT_MUTEX);
+
+    // Most waits end within the delay and skip the stack walk
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_nsec += STACK_DELAY_MS * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    int result = pthread_mutex_timedlock(mutex, &deadline);
+    if (result == ETIMEDOUT) {
+        captureWaitStack(slot);
+        result = pthread_mutex_lock(mutex);
+    }
+
+    endWait(slot);
+    if (result == 0 || result == EOWNERDEAD) noteAcquired(mutex, 1);
+    return result;
+}
+
+static int waitForCondition(pthread_cond_t* cond, pthread_mutex_t* mutex, const struct timespec* deadline) {
+    ThreadSlot* slot = currentSlot();
+    if (slot == NULL || slot->busy) {
+        return deadline != NULL ? pthread_cond_timedwait(cond, mutex, deadline) : pthread_cond_wait(cond, mutex);
+    }
+
+    // The mutex is released for the wait and held again when it returns
+    int tid = atomic_load_explicit(&slot->tid, memory_order_relaxed);
+    LockEntry* entry = findLock((uintptr_t)mutex, 0);
+    int depth = 0;
+    if (entry != NULL && atomic_load_explicit(&entry->owner, memory_order_relaxed) == tid) {
+        depth = entry->depth;
+        atomic_store_explicit(&entry->owner, 0, memory_order_relaxed);
+        atomic_fetch_sub_explicit(&slot->heldLocks, 1, memory_order_relaxed);
+    } else {
+        entry = NULL;
+    }
+
+    beginWait(slot, (uintptr_t)cond, WAIT_CONDITION);
+
+    // Nothing records who will signal, so the stack is taken up front, but only where a hang
+    // is likely to be reported: on the main thread, or while holding locks a signaller may need
+    if (tid == mainThreadId || atomic_load_explicit(&slot->heldLocks, memory_order_relaxed) > 0) {
+        captureWaitStack(slot);
+    }
+
+    int result = deadline != NULL ? pthread_cond_timedwait(cond, mutex, deadline) : pthread_cond_wait(cond, mutex);
+
+    endWait(slot);
+    if (entry != NULL) {
+        entry->depth = depth;
+        atomic_store_explicit(&entry->owner, tid, memory_order_relaxed);
+        atomic_fetch_add_explicit(&slot->heldLocks, 1, memory_order_relaxed);
+    }
+    return result;
+}
+
+// Monitored entry points
+
+int moonforge_monitored_mutex_lock(pthread_mutex_t* mutex) {
+    if (!atomic_load_explicit(&running, memory_order_relaxed)) return pthread_mutex_lock(mutex);
+
+    int result = pthread_mutex_trylock(mutex);
+    if (result == 0 || result == EOWNERDEAD) {
+        noteAcquired(mutex, 0);
+        return result;
+    }
+    // Anything but "held by another thread" is what lock would have returned too
+    if (result != EBUSY) return result;
+
+    return waitForMutex(mutex);
+}
+
+int moonforge_monitored_mutex_trylock(pthread_mutex_t* mutex) {
+    int result = pthread_mutex_trylock(mutex);
+    if ((result == 0 || result == EOWNERDEAD) && atomic_load_explicit(&running, memory_order_relaxed)) {
+        noteAcquired(mutex, 0);
+    }
+    return result;
+}
+
+int moonforge_monitored_mutex_timedlock(pthread_mutex_t* mutex, const struct timespec* deadline) {
+    // Timed waits end by themselves; only the owner is recorded
+    int result = pthread_mutex_timedlock(mutex, deadline);
+    if ((result == 0 || result == EOWNERDEAD) && atomic_load_explicit(&running, memory_order_relaxed)) {
+        noteAcquired(mutex, 0);
+    }
+    return result;
+}
+
+int moonforge_monitored_mutex_unlock(pthread_mutex_t* mutex) {
+    // Releases are tracked even after Stop so owners stay balanced
+    noteReleased(mutex);
+    return pthread_mutex_unlock(mutex);
+}
+
+int moonforge_monitored_cond_wait(pthread_cond_t* cond, pthread_mutex_t* mutex) {
+    if (!atomic_load_explicit(&running, memory_order_relaxed)) return pthread_cond_wait(cond, mutex);
+    return waitForCondition(cond, mutex, NULL);
+}
+
+int moonforge_monitored_cond_timedwait(pthread_cond_t* cond, pthread_mutex_t* mutex, const struct timespec* deadline) {
+    if (!atomic_load_explicit(&running, memory_order_relaxed)) return pthread_cond_timedwait(cond, mutex, deadline);
+    return waitForCondition(cond, mutex, deadline);
+}
+
+// Checking for hangs. Only the checking thread uses these.
+
+typedef struct {
+    int slot;
+    int tid;
+    int kind;
+    uintptr_t object;
+    int owner;
+    unsigned waitNumber;
+    int64_t startMs;
+    int heldLocks;
+    int depth;
+    uintptr_t frames[WAIT_FRAMES];
+} Wait;
+
+static Wait waits[MAX_THREAD_SLOTS];
+static int chainTids[REPORT_MAX_THREADS];
+static char threadJson[8192];
+static char contextJson[16384];
+
+static int snapshotWaits(void) {
+    int count = 0;
+
+    for (int i = 0; i < MAX_THREAD_SLOTS; i++) {
+        ThreadSlot* slot = &threadSlots[i];
+        if (!atomic_load_explicit(&slot->inUse, memory_order_acquire)) continue;
+
+        for (int attempt = 0; attempt < SNAPSHOT_ATTEMPTS; attempt++) {
+            unsigned before = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+            if (before & 1) continue;
+
+            Wait* wait = &waits[count];
+            wait->object = atomic_load_explicit(&slot->waitingOn, memory_order_relaxed);
+            if (wait->object == 0) break;
+
+            wait->slot = i;
+            wait->tid = atomic_load_explicit(&slot->tid, memory_order_relaxed);
+            wait->kind = slot->waitKind;
+            wait->waitNumber = slot->waitNumber;
+            wait->startMs = slot->waitStartMs;
+            wait->heldLocks = atomic_load_explicit(&slot->heldLocks, memory_order_relaxed);
+            wait->depth = slot->depth;
+            if (wait->depth < 0 || wait->depth > WAIT_FRAMES) wait->depth = 0;
+            memcpy(wait->frames, slot->frames, (size_t)wait->depth * sizeof(uintptr_t));
+
+            atomic_thread_fence(memory_order_acquire);
+            if (atomic_load_explicit(&slot->sequence, memory_order_relaxed) == before) {
+                count++;
+                break;
+            }
+        }
+    }
+
+    // Who each mutex wait is blocked behind, where the owner is known
+    for (int i = 0; i < count; i++) {
+        waits[i].owner = 0;
+        if (waits[i].kind != WAIT_MUTEX) continue;
+        LockEntry* entry = findLock(waits[i].object, 0);
+        if (entry != NULL) waits[i].owner = atomic_load_explicit(&entry->owner, memory_order_relaxed);
+    }
+    return count;
+}
+
+static int findWait(int count, int tid) {
+    for (int i = 0; i < count; i++) {
+        if (waits[i].tid == tid) return i;
+    }
+    return -1;
+}
+
+static int isReported(const Wait* wait) {
+    return atomic_load_explicit(&threadSlots[wait->slot].reportedWait, memory_order_relaxed) == wait->waitNumber;
+}
+
+/**
+ * Follow owner edges from a wait into chainTids. The chain ends at a thread
+ * that isn't waiting for a mutex with a known owner, or where it meets
+ * itself; cycleStart is then the index it closes on.
+ */
+static int followChain(int count, int start, int* cycleStart) {
+    int length = 0;
+    int tid = waits[start].tid;
+    *cycleStart = -1;
+
+    while (length < REPORT_MAX_THREADS) {
+        for (int i = 0; i < length; i++) {
+            if (chainTids[i] == tid) {
+                *cycleStart = i;
+                return length;
+            }
+        }
+        chainTids[length++] = tid;
+
+        int index = findWait(count, tid);
+        if (index < 0 || waits[index].kind != WAIT_MUTEX || waits[index].owner == 0) break;
+        tid = waits[index].owner;
+    }
+    return length;
+}
+
+static void readThreadName(int tid, char* name, size_t nameSize) {
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/self/task/%d/comm", tid);
+    name[0] = '\0';
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return;
+    ssize_t length = read(fd, name, nameSize - 1);
+    close(fd);
+    if (length <= 0) return;
+
+    name[length] = '\0';
+    for (ssize_t i = 0; i < length; i++) {
+        // comm is at most 15 characters; anything that would need escaping is replaced
+        char c = name[i];
+        if (c == '\n') {
+            name[i] = '\0';
+            break;
+        }
+        if (c == '"' || c == '\\' || (unsigned char)c < 0x20) name[i] = '_';
+    }
+}
+
+static size_t writeFrames(char* buffer, size_t bufferSize, const Wait* wait) {
+    size_t offset = 0;
+
+    for (int i = 0; wait != NULL && i < wait->depth; i++) {
+        void* address = (void*)wait->frames[i];
+        Dl_info info;
+        const char* symbolName = "???";
+        const char* moduleName = "???";
+        ptrdiff_t symbolOffset = 0;
+
+        if (dladdr(address, &info)) {
+            if (info.dli_sname) {
+                symbolName = info.dli_sname;
+                symbolOffset = (char*)address - (char*)info.dli_saddr;
+            }
+            if (info.dli_fname) {
+                const char* lastSlash = strrchr(info.dli_fname, '/');
+                moduleName = lastSlash ? lastSlash + 1 : info.dli_fname;
+            }
+        }
+
+        int written = snprintf(buffer + offset, bufferSize - offset,
+            "%s{\"frame\":%d,\"address\":\"%p\",\"module\":\"%s\",\"symbol\":\"%s\",\"offset\":\"%td\"}",
+            i == 0 ? "" : ",", i, address, moduleName, symbolName, symbolOffset);
+        // Frames that don't fit are left out
+        if (written < 0 || (size_t)written >= bufferSize - offset) break;
+        offset += (size_t)written;
+    }
+    return offset;
+}
+
+static int writeThread(char* buffer, size_t bufferSize, int count, int tid, int64_t now) {
+    char name[32];
+    readThreadName(tid, name, sizeof(name));
+
+    int index = findWait(count, tid);
+    const Wait* wait = index >= 0 ? &waits[index] : NULL;
+
+    int written;
+    if (wait == NULL) {
+        written = snprintf(buffer, bufferSize, "{\"tid\":%d,\"name\":\"%s\",\"main\":%s,\"wait\":\"none\",\"frames\":[",
+                           tid, name, tid == mainThreadId ? "true" : "false");
+    } else {
+        written = snprintf(buffer, bufferSize,
+            "{\"tid\":%d,\"name\":\"%s\",\"main\":%s,\"wait\":\"%s\",\"lock\":\"0x%" PRIxPTR "\",\"owner\":%d,"
+            "\"waitedMs\":%lld,\"heldLocks\":%d,\"frames\":[",
+            tid, name, tid == mainThreadId ? "true" : "false", wait->kind == WAIT_MUTEX ? "mutex" : "condition",
+            wait->object, wait->owner, (long long)(now - wait->startMs), wait->heldLocks);
+    }
+    if (written < 0 || (size_t)written >= bufferSize - 2) return 0;
+
+    size_t offset = (size_t)written;
+    offset += writeFrames(buffer + offset, bufferSize - offset - 2, wait);
+    buffer[offset++] = ']';
+    buffer[offset++] = '}';
+    buffer[offset] = '\0';
+    return (int)offset;
+}
+
+static void markReported(int count, int length) {
+    for (int i = 0; i < length; i++) {
+        int index = findWait(count, chainTids[i]);
+        if (index < 0) continue;
+        atomic_store_explicit(&threadSlots[waits[index].slot].reportedWait, waits[index].waitNumber, memory_order_relaxed);
+    }
+}
+
+// Public API
+
+static int findOwnText(struct dl_phdr_info* info, size_t size, void* data) {
+    (void)size;
+    uintptr_t self = (uintptr_t)data;
+
+    for (int i = 0; i < info->dlpi_phnum; i++) {
+        const ElfW(Phdr)* header = &info->dlpi_phdr[i];
+        if (header->p_type != PT_LOAD) continue;
+
+        uintptr_t start = (uintptr_t)info->dlpi_addr + header->p_vaddr;
+        uintptr_t end = start + header->p_memsz;
+        if (self >= start && self < end) {
+            ownTextStart = start;
+            ownTextEnd = end;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+MOONFORGE_EXPORT int MoonForge_LockMonitor_Start(int rate) {
+    if (atomic_load(&running)) return 1;
+
+    pthread_once(&keyOnce, createThreadKey);
+    sampleRate = rate > 0 ? rate : DEFAULT_SAMPLE_RATE;
+    mainThreadId = currentThreadId();
+    dl_iterate_phdr(findOwnText, (void*)(uintptr_t)moonforge_monitored_mutex_lock);
+
+    atomic_store(&running, 1);
+
+    // libc's own locking (stdio, the allocator) is not the app's
+    moonforge_plt_hook_ignore("/libc.so");
+    moonforge_plt_hook_register(NULL, "pthread_mutex_lock", (void*)moonforge_monitored_mutex_lock, NULL);
+    moonforge_plt_hook_register(NULL, "pthread_mutex_trylock", (void*)moonforge_monitored_mutex_trylock, NULL);
+    moonforge_plt_hook_register(NULL, "pthread_mutex_timedlock", (void*)moonforge_monitored_mutex_timedlock, NULL);
+    moonforge_plt_hook_register(NULL, "pthread_mutex_unlock", (void*)moonforge_monitored_mutex_unlock, NULL);
+    moonforge_plt_hook_register(NULL, "pthread_cond_wait", (void*)moonforge_monitored_cond_wait, NULL);
+    moonforge_plt_hook_register(NULL, "pthread_cond_timedwait", (void*)moonforge_monitored_cond_timedwait, NULL);
+    int patched = moonforge_plt_hook_refresh();
+
+    LOGD("Lock monitor started (1 in %d mutexes tracked, %d import slots)", sampleRate, patched);
+    return 1;
+}
+
+MOONFORGE_EXPORT void MoonForge_LockMonitor_Stop(void) {
+    if (!atomic_exchange(&running, 0)) return;
+
+    moonforge_plt_hook_unregister((void*)moonforge_monitored_mutex_lock);
+    moonforge_plt_hook_unregister((void*)moonforge_monitored_mutex_trylock);
+    moonforge_plt_hook_unregister((void*)moonforge_monitored_mutex_timedlock);
+    moonforge_plt_hook_unregister((void*)moonforge_monitored_mutex_unlock);
+    moonforge_plt_hook_unregister((void*)moonforge_monitored_cond_wait);
+    moonforge_plt_hook_unregister((void*)moonforge_monitored_cond_timedwait);
+}
+
+MOONFORGE_EXPORT int MoonForge_LockMonitor_IsRunning(void) {
+    return atomic_load(&running);
+}
+
+MOONFORGE_EXPORT int MoonForge_LockMonitor_Check(int hangMs, char* buffer, int bufferSize) {
+    if (buffer == NULL || bufferSize < 3 || !atomic_load(&running)) return 0;
+
+    int64_t now = monotonicMs();
+    int count = snapshotWaits();
+    if (count == 0) return 0;
+
+    const char* kind = NULL;
+    int length = 0;
+    int cycleStart = -1;
+    int64_t blockedMs = 0;
+
+    // Any long wait of the main thread is a hang, whatever it waits behind
+    int mainWait = findWait(count, mainThreadId);
+    if (mainWait >= 0 && now - waits[mainWait].startMs >= hangMs && !isReported(&waits[mainWait])) {
+        length = followChain(count, mainWait, &cycleStart);
+        blockedMs = now - waits[mainWait].startMs;
+        kind = cycleStart >= 0 ? "deadlock"
+             : waits[mainWait].kind == WAIT_MUTEX ? "lock_wait" : "condition_wait";
+    }
+
+    // Elsewhere only a cycle is; it has lasted as long as its most recent wait
+    for (int i = 0; kind == NULL && i < count; i++) {
+        if (waits[i].kind != WAIT_MUTEX || now - waits[i].startMs < hangMs || isReported(&waits[i])) continue;
+
+        length = followChain(count, i, &cycleStart);
+        if (cycleStart < 0) continue;
+
+        blockedMs = INT64_MAX;
+        for (int j = cycleStart; j < length; j++) {
+            int64_t waited = now - waits[findWait(count, chainTids[j])].startMs;
+            if (waited < blockedMs) blockedMs = waited;
+        }
+        if (blockedMs < hangMs) continue;
+
+        // Report the cycle itself, not the threads queued behind it
+        memmove(chainTids, chainTids + cycleStart, (size_t)(length - cycleStart) * sizeof(int));
+        length -= cycleStart;
+        cycleStart = 0;
+        kind = "deadlock";
+    }
+
+    if (kind == NULL) return 0;
+    markReported(count, length);
+
+    struct timespec wallClock;
+    clock_gettime(CLOCK_REALTIME, &wallClock);
+    int64_t timestampMs = (int64_t)wallClock.tv_sec * 1000 + wallClock.tv_nsec / 1000000 - blockedMs;
+
+    // Game state, user and tags as of the hang, in case the process never recovers
+    if (moonforge_context_write_json(MOONFORGE_CONTEXT_READER_LOCKS, contextJson, sizeof(contextJson)) == 0) {
+        strcpy(contextJson, "null");
+    }
+
+    size_t size = (size_t)bufferSize;
+    int written = snprintf(buffer, size,
+        "{\"timestamp\":%lld,\"kind\":\"%s\",\"blockedMs\":%lld,\"mainThreadId\":%d,\"sampleRate\":%d,"
+        "\"trackedLocks\":%d,\"chainLength\":%d,\"cycleStart\":%d,\"context\":%s,\"threads\":[",
+        (long long)timestampMs, kind, (long long)blockedMs, mainThreadId, sampleRate,
+        atomic_load_explicit(&lockCount, memory_order_relaxed), length, cycleStart, contextJson);
+    if (written < 0 || (size_t)written >= size - 2) {
+        buffer[0] = '\0';
+        return 0;
+    }
+    size_t offset = (size_t)written;
+
+    // The chain, then other threads that have been blocked as long
+    int threads = 0;
+    for (int i = 0; i < count + length && threads < REPORT_MAX_THREADS; i++) {
+        int tid;
+        if (i < length) {
+            tid = chainTids[i];
+        } else {
+            const Wait* wait = &waits[i - length];
+            if (now - wait->startMs < hangMs) continue;
+
+            int inChain = 0;
+            for (int j = 0; j < length; j++) {
+                if (chainTids[j] == wait->tid) inChain = 1;
+            }
+            if (inChain) continue;
+            tid = wait->tid;
+        }
+
+        int threadLength = writeThread(threadJson, sizeof(threadJson), count, tid, now);
+        // Threads that don't fit are left out
+        if (threadLength == 0 || (size_t)threadLength + 1 >= size - offset - 2) break;
+
+        if (threads > 0) buffer[offset++] = ',';
+        memcpy(buffer + offset, threadJson, (size_t)threadLength);
+        offset += (size_t)threadLength;
+        threads++;
+    }
+    buffer[offset++] = ']';
+    buffer[offset++] = '}';
+    buffer[offset] = '\0';
+    return (int)offset;
+}
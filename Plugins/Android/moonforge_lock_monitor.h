@@ -0,0 +1,78 @@
+/**
+ * MoonForge Lock Monitor for Android (NDK) and Linux
+ *
+ * Interposes on pthread mutexes and condition variables through the PLT
+ * hook engine and keeps a wait-for graph: which thread owns each tracked
+ * mutex, and what each blocked thread is waiting on. When the main thread
+ * has been blocked for too long, or threads wait on each other in a cycle,
+ * a report names every thread in the chain with the stack it is waiting at.
+ */
+
+#ifndef MOONFORGE_LOCK_MONITOR_H
+#define MOONFORGE_LOCK_MONITOR_H
+
+#include <pthread.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef MOONFORGE_EXPORT
+#define MOONFORGE_EXPORT __attribute__((visibility("default")))
+#endif
+
+/**
+ * Install the hooks. Call from the main thread; the calling thread is the
+ * one whose waits are reported as hangs.
+ * @param sampleRate Track the owner of 1 in sampleRate mutexes from their first
+ *        lock (1 = all, 0 = default 16). Mutexes are always tracked once contended.
+ * @return 1 if the monitor is running
+ */
+MOONFORGE_EXPORT int MoonForge_LockMonitor_Start(int sampleRate);
+
+/**
+ * Remove the hooks. Recorded owners and waits are kept but no longer reported.
+ */
+MOONFORGE_EXPORT void MoonForge_LockMonitor_Stop(void);
+
+/**
+ * Check if the hooks are installed
+ */
+MOONFORGE_EXPORT int MoonForge_LockMonitor_IsRunning(void);
+
+/**
+ * Look for a hang: the main thread blocked on a mutex or condition for at
+ * least hangMs, or a cycle of threads that have each waited that long for a
+ * mutex the next one owns. Each wait is reported once. Writes a JSON report:
+ * {"timestamp":..,"kind":"deadlock"|"lock_wait"|"condition_wait","blockedMs":..,
+ *  "mainThreadId":..,"sampleRate":..,"trackedLocks":..,"chainLength":..,"cycleStart":..,
+ *  "context":{..},
+ *  "threads":[{"tid":..,"name":"..","main":true,"wait":"mutex"|"condition"|"none",
+ *              "lock":"0x..","owner":..,"waitedMs":..,"heldLocks":..,"frames":[..]}]}
+ * threads starts with the wait chain (chainLength entries, from the main thread
+ * or the first thread of the cycle, ending at a thread that isn't waiting or
+ * closing the cycle at index cycleStart, -1 without one), followed by other
+ * threads blocked as long. context is the context store's snapshot
+ * (MoonForge_Context_GetSnapshot), or null if it is empty. Call from one
+ * thread at a time.
+ * @return Number of characters written, or 0 if there is nothing to report
+ */
+MOONFORGE_EXPORT int MoonForge_LockMonitor_Check(int hangMs, char* buffer, int bufferSize);
+
+/**
+ * Monitored entry points. These call through to libc and record owners and
+ * waits; Start installs them in other modules' import tables.
+ */
+int moonforge_monitored_mutex_lock(pthread_mutex_t* mutex);
+int moonforge_monitored_mutex_trylock(pthread_mutex_t* mutex);
+int moonforge_monitored_mutex_timedlock(pthread_mutex_t* mutex, const struct timespec* deadline);
+int moonforge_monitored_mutex_unlock(pthread_mutex_t* mutex);
+int moonforge_monitored_cond_wait(pthread_cond_t* cond, pthread_mutex_t* mutex);
+int moonforge_monitored_cond_timedwait(pthread_cond_t* cond, pthread_mutex_t* mutex, const struct timespec* deadline);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MOONFORGE_LOCK_MONITOR_H
@@ -0,0 +1,57 @@
+/**
+ * MoonForge native plugin logging
+ *
+ * liblog on Android. On other targets (Linux standalone) errors go to stderr,
+ * which the player log already collects, and debug output is compiled out.
+ * Define LOG_TAG before including.
+ */
+
+#ifndef MOONFORGE_LOG_H
+#define MOONFORGE_LOG_H
+
+#ifdef __ANDROID__
+
+#include <android/log.h>
+
+#define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+#else
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+// liblog priorities; the log tail records them on every target
+#define ANDROID_LOG_VERBOSE 2
+#define ANDROID_LOG_DEBUG 3
+#define ANDROID_LOG_INFO 4
+#define ANDROID_LOG_WARN 5
+#define ANDROID_LOG_ERROR 6
+#define ANDROID_LOG_FATAL 7
+
+// Formats on the stack and writes once, so it can be used from the signal handler
+__attribute__((format(printf, 2, 3)))
+static inline void moonforge_log_stderr(const char* tag, const char* format, ...) {
+    char line[512];
+    int prefix = snprintf(line, sizeof(line), "%s: ", tag);
+    if (prefix < 0 || prefix >= (int)sizeof(line) - 1) prefix = 0;
+
+    va_list args;
+    va_start(args, format);
+    vsnprintf(line + prefix, sizeof(line) - (size_t)prefix - 1, format, args);
+    va_end(args);
+
+    size_t length = strlen(line);
+    line[length++] = '\n';
+    ssize_t written = write(STDERR_FILENO, line, length);
+    (void)written;
+}
+
+#define LOGD(...) do { if (0) moonforge_log_stderr(LOG_TAG, __VA_ARGS__); } while (0)
+#define LOGE(...) moonforge_log_stderr(LOG_TAG, __VA_ARGS__)
+
+#endif
+
+#endif // MOONFORGE_LOG_H
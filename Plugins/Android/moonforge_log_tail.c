@@ -0,0 +1,395 @@
+/**
+ * MoonForge Log Tail for Android (NDK) and Linux
+ *
+ * Lines are written into a power-of-two ring in logcat's brief format
+ * ("I/Tag: message"). Writers reserve space with a single atomic add on the
+ * write position and copy their bytes in, so appends never block and the
+ * crash handler can copy the ring without taking a lock. A writer that is
+ * lapped mid-copy can leave one torn line behind; that is acceptable for a
+ * diagnostic tail.
+ */
+
+#define _GNU_SOURCE
+
+#include "moonforge_log_tail.h"
+#include "moonforge_plt_hook.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#define LOG_TAG "MoonForgeLogTail"
+#include "moonforge_log.h"
+
+#define MIN_RING_SIZE (4 * 1024)
+#define MAX_RING_SIZE (1024 * 1024)
+
+// Same limit liblog uses when formatting __android_log_print
+#define LOG_LINE_SIZE 1024
+#define MAX_TAG_LENGTH 64
+
+#define STDIO_READ_SIZE 4096
+
+static char* ring = NULL;
+static char* ringMemory = NULL;
+static size_t ringSize = 0;
+static uint64_t writePosition = 0;
+static int isRunning = 0;
+
+static pthread_mutex_t startLock = PTHREAD_MUTEX_INITIALIZER;
+
+// Ring
+
+static size_t roundUpPowerOfTwo(size_t value) {
+    size_t result = MIN_RING_SIZE;
+    while (result < value && result < MAX_RING_SIZE) result <<= 1;
+    return result;
+}
+
+static void copyIn(uint64_t position, const char* data, size_t length) {
+    size_t offset = (size_t)(position & (ringSize - 1));
+    size_t first = ringSize - offset;
+    if (first > length) first = length;
+    memcpy(ring + offset, data, first);
+    if (length > first) memcpy(ring, data + first, length - first);
+}
+
+static char priorityChar(int priority) {
+    switch (priority) {
+        case ANDROID_LOG_VERBOSE: return 'V';
+        case ANDROID_LOG_DEBUG: return 'D';
+        case ANDROID_LOG_INFO: return 'I';
+        case ANDROID_LOG_WARN: return 'W';
+        case ANDROID_LOG_ERROR: return 'E';
+        case ANDROID_LOG_FATAL: return 'F';
+        default: return 'I';
+    }
+}
+
+void moonforge_log_tail_append(int priority, const char* tag, const char* text, size_t textLength) {
+    char* buffer = __atomic_load_n(&ring, __ATOMIC_ACQUIRE);
+    if (buffer == NULL || text == NULL) return;
+
+    if (tag == NULL) tag = "";
+    size_t tagLength = strnlen(tag, MAX_TAG_LENGTH);
+
+    // Trailing newlines are replaced by our own
+    while (textLength > 0 && text[textLength - 1] == '\n') textLength--;
+    if (textLength > LOG_LINE_SIZE) textLength = LOG_LINE_SIZE;
+
+    char prefix[2] = { priorityChar(priority), '/' };
+    size_t total = sizeof(prefix) + tagLength + 2 + textLength + 1;
+
+    uint64_t position = __atomic_fetch_add(&writePosition, total, __ATOMIC_RELAXED);
+    copyIn(position, prefix, sizeof(prefix));
+    position += sizeof(prefix);
+    copyIn(position, tag, tagLength);
+    position += tagLength;
+    copyIn(position, ": ", 2);
+    position += 2;
+    copyIn(position, text, textLength);
+    position += textLength;
+    copyIn(position, "\n", 1);
+}
+
+size_t moonforge_log_tail_copy(char* buffer, size_t bufferSize) {
+    if (buffer == NULL || bufferSize == 0) return 0;
+    buffer[0] = '\0';
+
+    char* source = __atomic_load_n(&ring, __ATOMIC_ACQUIRE);
+    if (source == NULL) return 0;
+
+    uint64_t end = __atomic_load_n(&writePosition, __ATOMIC_ACQUIRE);
+    size_t length = bufferSize - 1;
+    if (length > ringSize) length = ringSize;
+    if ((uint64_t)length > end) length = (size_t)end;
+    if (length == 0) return 0;
+
+    uint64_t start = end - length;
+    size_t offset = (size_t)(start & (ringSize - 1));
+    size_t first = ringSize - offset;
+    if (first > length) first = length;
+    memcpy(buffer, source + offset, first);
+    if (length > first) memcpy(buffer + first, source, length - first);
+
+    // Drop the partial line at the front unless the ring hasn't wrapped yet
+    size_t skip = 0;
+    if (start > 0) {
+        while (skip < length && buffer[skip] != '\n') skip++;
+        if (skip < length) skip++;
+    }
+
+    if (skip > 0) memmove(buffer, buffer + skip, length - skip);
+    length -= skip;
+    buffer[length] = '\0';
+    return length;
+}
+
+// liblog hooks
+
+#ifdef __ANDROID__
+
+static int hookedLogWrite(int priority, const char* tag, const char* text) {
+    if (text != NULL) moonforge_log_tail_append(priority, tag, text, strlen(text));
+    return __android_log_write(priority, tag, text);
+}
+
+static int hookedLogVprint(int priority, const char* tag, const char* format, va_list args) {
+    char line[LOG_LINE_SIZE];
+    vsnprintf(line, sizeof(line), format, args);
+    return hookedLogWrite(priority, tag, line);
+}
+
+static int hookedLogPrint(int priority, const char* tag, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int result = hookedLogVprint(priority, tag, format, args);
+    va_end(args);
+    return result;
+}
+
+static int hookedLogBufWrite(int bufferId, int priority, const char* tag, const char* text) {
+    if (text != NULL) moonforge_log_tail_append(priority, tag, text, strlen(text));
+    return __android_log_buf_write(bufferId, priority, tag, text);
+}
+
+#endif
+
+// stdout/stderr
+
+struct StdioStream {
+    int readFd;
+    int forwardFd;
+    int priority;
+    const char* tag;
+    char pending[LOG_LINE_SIZE];
+    size_t pendingLength;
+};
+
+static struct StdioStream stdioStreams[2];
+static const int stdioTargets[2] = { STDOUT_FILENO, STDERR_FILENO };
+static pthread_t stdioThread;
+static int stdioCaptured = 0;
+static char stdoutBuffer[BUFSIZ];
+
+static int redirectStream(struct StdioStream* stream, int targetFd, int priority, const char* tag) {
+    int fds[2];
+    if (pipe(fds) != 0) return 0;
+
+    int saved = dup(targetFd);
+    if (saved < 0 || dup2(fds[1], targetFd) < 0) {
+        if (saved >= 0) close(saved);
+        close(fds[0]);
+        close(fds[1]);
+        return 0;
+    }
+    close(fds[1]);
+    fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(saved, F_SETFD, FD_CLOEXEC);
+
+    stream->readFd = fds[0];
+    stream->forwardFd = saved;
+    stream->priority = priority;
+    stream->tag = tag;
+    stream->pendingLength = 0;
+    return 1;
+}
+
+static void flushPending(struct StdioStream* stream) {
+    if (stream->pendingLength == 0) return;
+    moonforge_log_tail_append(stream->priority, stream->tag, stream->pending, stream->pendingLength);
+    stream->pendingLength = 0;
+}
+
+static void consumeStdio(struct StdioStream* stream, const char* data, size_t length) {
+    // Keep whatever the original descriptor pointed at (a terminal or log file under a debugger) working
+    size_t written = 0;
+    while (written < length) {
+        ssize_t result = write(stream->forwardFd, data + written, length - written);
+        if (result < 0 && errno == EINTR) continue;
+        if (result <= 0) break;
+        written += (size_t)result;
+    }
+
+    for (size_t i = 0; i < length; i++) {
+        if (data[i] == '\n') {
+            flushPending(stream);
+        } else {
+            if (stream->pendingLength == sizeof(stream->pending)) flushPending(stream);
+            stream->pending[stream->pendingLength++] = data[i];
+        }
+    }
+}
+
+static void* stdioThreadMain(void* arg) {
+    (void)arg;
+    char chunk[STDIO_READ_SIZE];
+    struct pollfd fds[2];
+    int openCount = 0;
+    for (int i = 0; i < 2; i++) {
+        fds[i].fd = stdioStreams[i].readFd;
+        fds[i].events = POLLIN;
+        if (fds[i].fd >= 0) openCount++;
+    }
+
+    while (openCount > 0) {
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        for (int i = 0; i < 2; i++) {
+            if (fds[i].fd < 0 || fds[i].revents == 0) continue;
+
+            ssize_t count = read(fds[i].fd, chunk, sizeof(chunk));
+            if (count > 0) {
+                consumeStdio(&stdioStreams[i], chunk, (size_t)count);
+            } else if (count == 0 || errno != EINTR) {
+                flushPending(&stdioStreams[i]);
+                close(fds[i].fd);
+                fds[i].fd = -1;
+                openCount--;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+// Point stdout/stderr back at what they were, which closes the pipes' write ends
+static void restoreStdio(void) {
+    fflush(stdout);
+    fflush(stderr);
+    for (int i = 0; i < 2; i++) {
+        if (stdioStreams[i].forwardFd >= 0) dup2(stdioStreams[i].forwardFd, stdioTargets[i]);
+    }
+}
+
+static void closeForwardFds(void) {
+    for (int i = 0; i < 2; i++) {
+        if (stdioStreams[i].forwardFd >= 0) close(stdioStreams[i].forwardFd);
+        stdioStreams[i].forwardFd = -1;
+    }
+}
+
+static int startStdioCapture(void) {
+    // stdio buffers fully when not attached to a terminal; line buffering keeps the tail current.
+    // glibc only resets a used stream's write pointers when it is given a buffer.
+    setvbuf(stdout, stdoutBuffer, _IOLBF, sizeof(stdoutBuffer));
+    setvbuf(stderr, NULL, _IONBF, 0);
+
+    stdioStreams[0].readFd = stdioStreams[1].readFd = -1;
+    stdioStreams[0].forwardFd = stdioStreams[1].forwardFd = -1;
+    int redirected = redirectStream(&stdioStreams[0], stdioTargets[0], ANDROID_LOG_INFO, "stdout");
+    redirected += redirectStream(&stdioStreams[1], stdioTargets[1], ANDROID_LOG_WARN, "stderr");
+    if (redirected == 0) return 0;
+
+    if (pthread_create(&stdioThread, NULL, stdioThreadMain, NULL) != 0) {
+        // Nothing would drain the pipes, so writes to stdout would block once they fill
+        restoreStdio();
+        for (int i = 0; i < 2; i++) {
+            if (stdioStreams[i].readFd >= 0) close(stdioStreams[i].readFd);
+        }
+        closeForwardFds();
+        return 0;
+    }
+
+    pthread_setname_np(stdioThread, "MoonForge.Stdio");
+    stdioCaptured = 1;
+    return 1;
+}
+
+// The drain thread reads what is left in the pipes, sees them close and exits
+static void stopStdioCapture(void) {
+    if (!stdioCaptured) return;
+
+    restoreStdio();
+    pthread_join(stdioThread, NULL);
+    closeForwardFds();
+    stdioCaptured = 0;
+}
+
+// Public API
+
+int MoonForge_LogTail_Start(int ringSizeBytes, int captureStdio) {
+    pthread_mutex_lock(&startLock);
+
+    if (isRunning) {
+        pthread_mutex_unlock(&startLock);
+        return 1;
+    }
+
+    // A restart reuses the ring of the first start, see MoonForge_LogTail_Stop
+    size_t size = ringSize;
+    void* memory = ringMemory;
+    if (memory == NULL) {
+        size = roundUpPowerOfTwo(ringSizeBytes > 0 ? (size_t)ringSizeBytes : MIN_RING_SIZE);
+        memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED) {
+            LOGE("Failed to map %zu byte log ring", size);
+            pthread_mutex_unlock(&startLock);
+            return 0;
+        }
+        ringMemory = (char*)memory;
+        ringSize = size;
+    }
+
+    __atomic_store_n(&writePosition, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&ring, (char*)memory, __ATOMIC_RELEASE);
+    isRunning = 1;
+
+    int patched = 0;
+#ifdef __ANDROID__
+    moonforge_plt_hook_register(NULL, "__android_log_write", (void*)hookedLogWrite, NULL);
+    moonforge_plt_hook_register(NULL, "__android_log_print", (void*)hookedLogPrint, NULL);
+    moonforge_plt_hook_register(NULL, "__android_log_vprint", (void*)hookedLogVprint, NULL);
+    moonforge_plt_hook_register(NULL, "__android_log_buf_write", (void*)hookedLogBufWrite, NULL);
+    patched = moonforge_plt_hook_refresh();
+#endif
+
+    if (captureStdio) startStdioCapture();
+
+    LOGD("Log tail started (%zu byte ring, %d import slots, stdio %s)",
+         size, patched, stdioCaptured ? "captured" : "not captured");
+
+    pthread_mutex_unlock(&startLock);
+    return 1;
+}
+
+void MoonForge_LogTail_Stop(void) {
+    pthread_mutex_lock(&startLock);
+
+    if (!isRunning) {
+        pthread_mutex_unlock(&startLock);
+        return;
+    }
+
+#ifdef __ANDROID__
+    moonforge_plt_hook_unregister((void*)hookedLogWrite);
+    moonforge_plt_hook_unregister((void*)hookedLogPrint);
+    moonforge_plt_hook_unregister((void*)hookedLogVprint);
+    moonforge_plt_hook_unregister((void*)hookedLogBufWrite);
+#endif
+
+    // Drained before the ring goes, so the last stdout lines still land in it
+    stopStdioCapture();
+
+    // The mapping stays: a writer that got past the hooks may still be copying into it
+    __atomic_store_n(&ring, NULL, __ATOMIC_RELEASE);
+    isRunning = 0;
+
+    LOGD("Log tail stopped");
+    pthread_mutex_unlock(&startLock);
+}
+
+int MoonForge_LogTail_Read(char* buffer, int bufferSize) {
+    if (buffer == NULL || bufferSize <= 0) return 0;
+    return (int)moonforge_log_tail_copy(buffer, (size_t)bufferSize);
+}
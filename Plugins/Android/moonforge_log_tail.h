@@ -0,0 +1,62 @@
+/**
+ * MoonForge Log Tail for Android (NDK) and Linux
+ *
+ * Keeps the most recent log output of the process in a ring buffer so it can
+ * be attached to crash records and errors. Apps can no longer read their own
+ * logcat, so lines are captured on the way in: liblog calls made by other
+ * modules are hooked, and stdout/stderr can optionally be redirected through
+ * a pipe drained by a background thread. Linux has no liblog, so there only
+ * stdout/stderr are captured.
+ */
+
+#ifndef MOONFORGE_LOG_TAIL_H
+#define MOONFORGE_LOG_TAIL_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef MOONFORGE_EXPORT
+#define MOONFORGE_EXPORT __attribute__((visibility("default")))
+#endif
+
+/**
+ * Start capturing
+ * @param ringSizeBytes Ring capacity, rounded up to a power of two (4 KB - 1 MB)
+ * @param captureStdio Also redirect stdout/stderr into the ring
+ * @return 1 if capturing
+ */
+MOONFORGE_EXPORT int MoonForge_LogTail_Start(int ringSizeBytes, int captureStdio);
+
+/**
+ * Stop capturing: remove the liblog hooks, point stdout/stderr back at their
+ * original targets and let the drain thread exit. The ring reads as empty
+ * until the next start, which reuses it at its first size.
+ */
+MOONFORGE_EXPORT void MoonForge_LogTail_Stop(void);
+
+/**
+ * Copy the most recent log lines
+ * @param buffer Output buffer (NUL-terminated)
+ * @param bufferSize Size of buffer
+ * @return Number of characters copied
+ */
+MOONFORGE_EXPORT int MoonForge_LogTail_Read(char* buffer, int bufferSize);
+
+/**
+ * Same as MoonForge_LogTail_Read, for use from the signal handler. Async-signal-safe.
+ */
+size_t moonforge_log_tail_copy(char* buffer, size_t bufferSize);
+
+/**
+ * Append one line. Costs a few memcpys; safe from any thread.
+ */
+void moonforge_log_tail_append(int priority, const char* tag, const char* text, size_t textLength);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MOONFORGE_LOG_TAIL_H
@@ -0,0 +1,450 @@
+/**
+ * MoonForge PLT/GOT Hook Engine for Android (NDK)
+ *
+ * Walks loaded modules with dl_iterate_phdr, finds relocations that bind a
+ * registered symbol (JUMP_SLOT for calls, GLOB_DAT/ABS for address-taken
+ * uses) and swaps the slot with a single atomic pointer store. Slots inside
+ * PT_GNU_RELRO are made writable only for the store and then returned to
+ * read-only.
+ *
+ * Android packs most non-PLT relocations (DT_ANDROID_REL/RELA) and those
+ * are not decoded here; call sites go through DT_JMPREL, which is never
+ * packed, so plain calls are always covered.
+ *
+ * The main executable is patched like any library. glibc reports it with an
+ * empty path, so module filters never match it and only unfiltered hooks
+ * reach it. The module the engine is linked into is found by address and
+ * skipped, so the replacements' own calls still reach the real functions.
+ */
+
+#define _GNU_SOURCE
+
+#include "moonforge_plt_hook.h"
+
+#include <dlfcn.h>
+#include <elf.h>
+#include <link.h>
+#include <pthread.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#define LOG_TAG "MoonForgeHook"
+#include "moonforge_log.h"
+
+#define MAX_HOOKS 32
+#define MAX_IGNORES 16
+#define MAX_FILTER_LENGTH 64
+#define MAX_SYMBOL_LENGTH 64
+#define MAX_MODULES 512
+#define MAX_PATCHED_SLOTS 4096
+
+#if defined(__LP64__)
+#define ELF_R_SYM(info) ELF64_R_SYM(info)
+#define ELF_R_TYPE(info) ELF64_R_TYPE(info)
+#else
+#define ELF_R_SYM(info) ELF32_R_SYM(info)
+#define ELF_R_TYPE(info) ELF32_R_TYPE(info)
+#endif
+
+#if defined(__aarch64__)
+#define RELOC_JUMP_SLOT R_AARCH64_JUMP_SLOT
+#define RELOC_GLOB_DAT R_AARCH64_GLOB_DAT
+#define RELOC_ABS R_AARCH64_ABS64
+#elif defined(__arm__)
+#define RELOC_JUMP_SLOT R_ARM_JUMP_SLOT
+#define RELOC_GLOB_DAT R_ARM_GLOB_DAT
+#define RELOC_ABS R_ARM_ABS32
+#elif defined(__x86_64__)
+#define RELOC_JUMP_SLOT R_X86_64_JUMP_SLOT
+#define RELOC_GLOB_DAT R_X86_64_GLOB_DAT
+#define RELOC_ABS R_X86_64_64
+#elif defined(__i386__)
+#define RELOC_JUMP_SLOT R_386_JMP_SLOT
+#define RELOC_GLOB_DAT R_386_GLOB_DAT
+#define RELOC_ABS R_386_32
+#else
+#error "Unsupported architecture"
+#endif
+
+typedef struct {
+    char filter[MAX_FILTER_LENGTH];   // empty = all modules
+    char symbol[MAX_SYMBOL_LENGTH];
+    void* replacement;
+    void** original;
+    void* target;                     // what original calls, shared by hooks on the same symbol
+} HookEntry;
+
+typedef struct {
+    void** slot;
+    void* previous;
+    void* replacement;
+    int inRelro;
+} PatchedSlot;
+
+typedef struct {
+    ElfW(Addr) bias;
+    unsigned generation;
+} ModuleState;
+
+typedef struct {
+    const char* path;
+    ElfW(Addr) bias;
+    ElfW(Addr) relroStart;
+    ElfW(Addr) relroEnd;
+    ElfW(Addr) textStart;             // executable segment, where lazy-binding stubs live
+    ElfW(Addr) textEnd;
+} ModuleImage;
+
+typedef struct {
+    int patched;
+} RefreshContext;
+
+static pthread_mutex_t hookMutex = PTHREAD_MUTEX_INITIALIZER;
+
+static HookEntry hooks[MAX_HOOKS];
+static int hookCount = 0;
+
+static char ignores[MAX_IGNORES][MAX_FILTER_LENGTH] = { "linker", "vdso" };
+static int ignoreCount = 2;
+
+static PatchedSlot patchedSlots[MAX_PATCHED_SLOTS];
+static int patchedCount = 0;
+
+// Modules processed at the current hook generation are skipped by refresh
+static ModuleState modules[MAX_MODULES];
+static int moduleCount = 0;
+static unsigned generation = 1;
+
+// Load address of the module the engine is in, from dladdr
+static ElfW(Addr) selfBase = 0;
+
+static void copyString(char* dest, size_t size, const char* src) {
+    if (src == NULL) {
+        dest[0] = '\0';
+        return;
+    }
+    strncpy(dest, src, size - 1);
+    dest[size - 1] = '\0';
+}
+
+// Relocation slots
+
+/**
+ * The function a hook's original should call. A slot that still points into
+ * its own module's code holds a lazy-binding stub (glibc without -z now):
+ * calling it would run the resolver, which rewrites the slot behind the hook
+ * or resolves back into it, so the symbol is looked up instead. Hooks on
+ * the same symbol share the first target found.
+ */
+static void* resolveTarget(HookEntry* hook, void* current, const ModuleImage* image) {
+    if (hook->target != NULL) return hook->target;
+
+    for (int h = 0; h < hookCount; h++) {
+        if (hooks[h].target != NULL && strcmp(hooks[h].symbol, hook->symbol) == 0) {
+            hook->target = hooks[h].target;
+            return hook->target;
+        }
+    }
+
+    void* target = current;
+    if ((ElfW(Addr))current >= image->textStart && (ElfW(Addr))current < image->textEnd) {
+        target = dlsym(RTLD_DEFAULT, hook->symbol);
+        if (target == hook->replacement) target = dlsym(RTLD_NEXT, hook->symbol);
+    }
+    hook->target = target;
+    return target;
+}
+
+static int patchSlot(void** slot, HookEntry* hook, int inRelro, const ModuleImage* image) {
+    void* replacement = hook->replacement;
+    void* current = __atomic_load_n(slot, __ATOMIC_ACQUIRE);
+    if (current == replacement) return 0;
+    if (patchedCount >= MAX_PATCHED_SLOTS) return 0;
+
+    // Page size can be 4 KB or 16 KB depending on the device
+    uintptr_t pageSize = (uintptr_t)sysconf(_SC_PAGESIZE);
+    void* page = (void*)((uintptr_t)slot & ~(pageSize - 1));
+
+    if (mprotect(page, pageSize, PROT_READ | PROT_WRITE) != 0) {
+        LOGD("mprotect failed for slot %p", (void*)slot);
+        return 0;
+    }
+
+    // Threads calling through the slot see either the old or the new target
+    __atomic_store_n(slot, replacement, __ATOMIC_RELEASE);
+
+    if (inRelro) {
+        mprotect(page, pageSize, PROT_READ);
+    }
+
+    PatchedSlot* record = &patchedSlots[patchedCount++];
+    record->slot = slot;
+    record->previous = current;
+    record->replacement = replacement;
+    record->inRelro = inRelro;
+
+    void* target = resolveTarget(hook, current, image);
+    if (hook->original != NULL && *hook->original == NULL) {
+        *hook->original = target;
+    }
+    return 1;
+}
+
+static void restoreSlot(const PatchedSlot* record) {
+    uintptr_t pageSize = (uintptr_t)sysconf(_SC_PAGESIZE);
+    void* page = (void*)((uintptr_t)record->slot & ~(pageSize - 1));
+
+    if (mprotect(page, pageSize, PROT_READ | PROT_WRITE) != 0) return;
+
+    // Leave slots alone that someone else has re-patched since
+    void* expected = record->replacement;
+    __atomic_compare_exchange_n(record->slot, &expected, record->previous, 0, __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+
+    if (record->inRelro) {
+        mprotect(page, pageSize, PROT_READ);
+    }
+}
+
+// Module scanning
+
+static int isIgnored(const char* path) {
+    if (path == NULL) return 0;
+
+    for (int i = 0; i < ignoreCount; i++) {
+        if (strstr(path, ignores[i]) != NULL) return 1;
+    }
+    return 0;
+}
+
+static int containsSelf(const struct dl_phdr_info* info) {
+    for (int i = 0; i < info->dlpi_phnum; i++) {
+        const ElfW(Phdr)* phdr = &info->dlpi_phdr[i];
+        if (phdr->p_type != PT_LOAD) continue;
+
+        ElfW(Addr) start = info->dlpi_addr + phdr->p_vaddr;
+        if (selfBase >= start && selfBase < start + phdr->p_memsz) return 1;
+    }
+    return 0;
+}
+
+static ModuleState* findModule(ElfW(Addr) bias) {
+    for (int i = 0; i < moduleCount; i++) {
+        if (modules[i].bias == bias) return &modules[i];
+    }
+    if (moduleCount >= MAX_MODULES) return NULL;
+
+    ModuleState* module = &modules[moduleCount++];
+    module->bias = bias;
+    module->generation = 0;
+    return module;
+}
+
+/**
+ * Dynamic-section pointers are link-time addresses on bionic but glibc
+ * rewrites some of them in place to absolute addresses
+ */
+static ElfW(Addr) dynamicAddress(ElfW(Addr) bias, ElfW(Addr) value) {
+    return value < bias ? bias + value : value;
+}
+
+static int applyToRelocations(const ModuleImage* image, const void* table, size_t tableSize, int isRela,
+                              const ElfW(Sym)* symtab, const char* strtab, size_t strsz) {
+    size_t entrySize = isRela ? sizeof(ElfW(Rela)) : sizeof(ElfW(Rel));
+    size_t count = tableSize / entrySize;
+    int patched = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        ElfW(Addr) offset;
+        ElfW(Xword) info;
+        if (isRela) {
+            const ElfW(Rela)* rel = (const ElfW(Rela)*)table + i;
+            offset = rel->r_offset;
+            info = rel->r_info;
+        } else {
+            const ElfW(Rel)* rel = (const ElfW(Rel)*)table + i;
+            offset = rel->r_offset;
+            info = rel->r_info;
+        }
+
+        unsigned type = (unsigned)ELF_R_TYPE(info);
+        if (type != RELOC_JUMP_SLOT && type != RELOC_GLOB_DAT && type != RELOC_ABS) continue;
+
+        size_t symbolIndex = ELF_R_SYM(info);
+        if (symbolIndex == 0) continue;
+
+        size_t nameOffset = symtab[symbolIndex].st_name;
+        if (strsz != 0 && nameOffset >= strsz) continue;
+        const char* name = strtab + nameOffset;
+
+        for (int h = 0; h < hookCount; h++) {
+            HookEntry* hook = &hooks[h];
+            if (strcmp(name, hook->symbol) != 0) continue;
+            if (hook->filter[0] != '\0' && strstr(image->path, hook->filter) == NULL) continue;
+
+            ElfW(Addr) slot = image->bias + offset;
+            int inRelro = slot >= image->relroStart && slot < image->relroEnd;
+            patched += patchSlot((void**)slot, hook, inRelro, image);
+        }
+    }
+    return patched;
+}
+
+static int processModule(struct dl_phdr_info* info, size_t size, void* data) {
+    (void)size;
+    RefreshContext* context = (RefreshContext*)data;
+
+    if (isIgnored(info->dlpi_name) || containsSelf(info)) return 0;
+
+    ModuleState* module = findModule(info->dlpi_addr);
+    if (module == NULL || module->generation == generation) return 0;
+    module->generation = generation;
+
+    ElfW(Addr) bias = info->dlpi_addr;
+    const ElfW(Dyn)* dynamic = NULL;
+    ModuleImage image = { info->dlpi_name != NULL ? info->dlpi_name : "", bias, 0, 0, 0, 0 };
+
+    for (int i = 0; i < info->dlpi_phnum; i++) {
+        const ElfW(Phdr)* phdr = &info->dlpi_phdr[i];
+        if (phdr->p_type == PT_DYNAMIC) {
+            dynamic = (const ElfW(Dyn)*)(bias + phdr->p_vaddr);
+        } else if (phdr->p_type == PT_GNU_RELRO) {
+            image.relroStart = bias + phdr->p_vaddr;
+            image.relroEnd = image.relroStart + phdr->p_memsz;
+        } else if (phdr->p_type == PT_LOAD && (phdr->p_flags & PF_X) && image.textEnd == 0) {
+            image.textStart = bias + phdr->p_vaddr;
+            image.textEnd = image.textStart + phdr->p_memsz;
+        }
+    }
+    if (dynamic == NULL) return 0;
+
+    const ElfW(Sym)* symtab = NULL;
+    const char* strtab = NULL;
+    size_t strsz = 0;
+    const void* jmprel = NULL;
+    size_t pltrelsz = 0;
+    int pltIsRela = 0;
+    const void* rela = NULL;
+    size_t relasz = 0;
+    const void* rel = NULL;
+    size_t relsz = 0;
+
+    for (const ElfW(Dyn)* entry = dynamic; entry->d_tag != DT_NULL; entry++) {
+        switch (entry->d_tag) {
+            case DT_SYMTAB: symtab = (const ElfW(Sym)*)dynamicAddress(bias, entry->d_un.d_ptr); break;
+            case DT_STRTAB: strtab = (const char*)dynamicAddress(bias, entry->d_un.d_ptr); break;
+            case DT_STRSZ: strsz = entry->d_un.d_val; break;
+            case DT_JMPREL: jmprel = (const void*)dynamicAddress(bias, entry->d_un.d_ptr); break;
+            case DT_PLTRELSZ: pltrelsz = entry->d_un.d_val; break;
+            case DT_PLTREL: pltIsRela = entry->d_un.d_val == DT_RELA; break;
+            case DT_RELA: rela = (const void*)dynamicAddress(bias, entry->d_un.d_ptr); break;
+            case DT_RELASZ: relasz = entry->d_un.d_val; break;
+            case DT_REL: rel = (const void*)dynamicAddress(bias, entry->d_un.d_ptr); break;
+            case DT_RELSZ: relsz = entry->d_un.d_val; break;
+            default: break;
+        }
+    }
+    if (symtab == NULL || strtab == NULL) return 0;
+
+    if (jmprel != NULL) {
+        context->patched += applyToRelocations(&image, jmprel, pltrelsz, pltIsRela, symtab, strtab, strsz);
+    }
+    if (rela != NULL) {
+        context->patched += applyToRelocations(&image, rela, relasz, 1, symtab, strtab, strsz);
+    }
+    if (rel != NULL) {
+        context->patched += applyToRelocations(&image, rel, relsz, 0, symtab, strtab, strsz);
+    }
+    return 0;
+}
+
+// Public API
+
+int moonforge_plt_hook_register(const char* moduleFilter, const char* symbol, void* replacement, void** original) {
+    if (symbol == NULL || replacement == NULL) return -1;
+
+    pthread_mutex_lock(&hookMutex);
+    if (hookCount >= MAX_HOOKS) {
+        pthread_mutex_unlock(&hookMutex);
+        return -1;
+    }
+
+    HookEntry* hook = &hooks[hookCount++];
+    copyString(hook->filter, sizeof(hook->filter), moduleFilter);
+    copyString(hook->symbol, sizeof(hook->symbol), symbol);
+    hook->replacement = replacement;
+    hook->original = original;
+    hook->target = NULL;
+
+    // Already-processed modules need another pass for the new hook
+    generation++;
+    pthread_mutex_unlock(&hookMutex);
+    return 0;
+}
+
+int moonforge_plt_hook_ignore(const char* moduleFilter) {
+    if (moduleFilter == NULL || moduleFilter[0] == '\0') return -1;
+
+    pthread_mutex_lock(&hookMutex);
+    int result = -1;
+    if (ignoreCount < MAX_IGNORES) {
+        copyString(ignores[ignoreCount++], MAX_FILTER_LENGTH, moduleFilter);
+        result = 0;
+    }
+    pthread_mutex_unlock(&hookMutex);
+    return result;
+}
+
+int moonforge_plt_hook_refresh(void) {
+    pthread_mutex_lock(&hookMutex);
+
+    if (selfBase == 0) {
+        Dl_info info;
+        if (dladdr((void*)moonforge_plt_hook_refresh, &info)) {
+            selfBase = (ElfW(Addr))info.dli_fbase;
+        }
+    }
+
+    RefreshContext context = { 0 };
+    if (hookCount > 0) {
+        dl_iterate_phdr(processModule, &context);
+    }
+    pthread_mutex_unlock(&hookMutex);
+
+    if (context.patched > 0) {
+        LOGD("Patched %d import slots", context.patched);
+    }
+    return context.patched;
+}
+
+int moonforge_plt_hook_unregister(void* replacement) {
+    pthread_mutex_lock(&hookMutex);
+
+    int restored = 0;
+    int kept = 0;
+    for (int i = 0; i < patchedCount; i++) {
+        if (replacement == NULL || patchedSlots[i].replacement == replacement) {
+            restoreSlot(&patchedSlots[i]);
+            restored++;
+        } else {
+            patchedSlots[kept++] = patchedSlots[i];
+        }
+    }
+    patchedCount = kept;
+
+    kept = 0;
+    for (int i = 0; i < hookCount; i++) {
+        if (replacement != NULL && hooks[i].replacement != replacement) {
+            hooks[kept++] = hooks[i];
+        }
+    }
+    hookCount = kept;
+    generation++;
+
+    pthread_mutex_unlock(&hookMutex);
+    return restored;
+}
+
+MOONFORGE_EXPORT int MoonForge_PltHook_Refresh(void) {
+    return moonforge_plt_hook_refresh();
+}
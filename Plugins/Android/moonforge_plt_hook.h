@@ -0,0 +1,62 @@
+/**
+ * MoonForge PLT/GOT Hook Engine for Android (NDK)
+ *
+ * Redirects calls that other modules make through their import tables
+ * (PLT/GOT relocation slots) to replacement functions. Only the caller's
+ * slot is changed, so the target function itself is untouched and modules
+ * that are not patched keep calling it directly.
+ */
+
+#ifndef MOONFORGE_PLT_HOOK_H
+#define MOONFORGE_PLT_HOOK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef MOONFORGE_EXPORT
+#define MOONFORGE_EXPORT __attribute__((visibility("default")))
+#endif
+
+/**
+ * Register a hook. Takes effect on the next moonforge_plt_hook_refresh.
+ * @param moduleFilter Only patch modules whose path contains this string (NULL = all modules)
+ * @param symbol Imported symbol to redirect
+ * @param replacement Function to call instead
+ * @param original Receives the function the symbol was bound to, shared by every hook on
+ *                 the symbol; lazy-binding stubs are resolved by name (may be NULL)
+ * @return 0 on success, -1 if the registry is full
+ */
+int moonforge_plt_hook_register(const char* moduleFilter, const char* symbol, void* replacement, void** original);
+
+/**
+ * Never patch modules whose path contains this string. The engine's own
+ * module, the dynamic linker and the vDSO are always ignored.
+ * @return 0 on success, -1 if the ignore list is full
+ */
+int moonforge_plt_hook_ignore(const char* moduleFilter);
+
+/**
+ * Apply registered hooks to every loaded module not yet patched.
+ * Cheap to call again after libraries are loaded.
+ * @return Number of slots patched by this call
+ */
+int moonforge_plt_hook_refresh(void);
+
+/**
+ * Restore every slot patched for the given replacement (NULL = all hooks)
+ * and drop the matching registrations
+ * @return Number of slots restored
+ */
+int moonforge_plt_hook_unregister(void* replacement);
+
+/**
+ * Re-scan loaded modules from Java/C# after late library loads
+ */
+MOONFORGE_EXPORT int MoonForge_PltHook_Refresh(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MOONFORGE_PLT_HOOK_H
@@ -0,0 +1,231 @@
+/**
+ * MoonForge Session Black Box for Android (NDK) and Linux
+ *
+ * One fixed-size record in a MAP_SHARED file, rewritten in place and never
+ * flushed explicitly: the kernel writes the dirty page back even after the
+ * process dies. Only a power loss can lose the last heartbeats.
+ *
+ * Durations use CLOCK_BOOTTIME so time asleep counts as background time;
+ * timestamps use the wall clock.
+ */
+
+#define _GNU_SOURCE
+
+#include "moonforge_session.h"
+
+#define LOG_TAG "MoonForgeSession"
+#include "moonforge_log.h"
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#define SESSION_MAGIC 0x5353464dU // "MFSS"
+#define SESSION_VERSION 1
+#define SESSION_ID_SIZE 64
+
+struct SessionRecord {
+    uint32_t magic;
+    uint32_t version;
+    char sessionId[SESSION_ID_SIZE];
+    int64_t startTimestampMs;
+    int64_t heartbeatTimestampMs;
+    int64_t foregroundMs;
+    int64_t backgroundMs;
+    int32_t foreground;
+    int32_t endReason;
+    int32_t signal;
+    int32_t pid;
+};
+
+// The mapped record of this process
+static struct SessionRecord* session = NULL;
+
+// Totals up to the last foreground/background switch, guarded by sessionLock
+static int64_t foregroundBaseMs = 0;
+static int64_t backgroundBaseMs = 0;
+static int64_t stateSinceMs = 0;
+static pthread_mutex_t sessionLock = PTHREAD_MUTEX_INITIALIZER;
+
+// What the previous process left behind
+static struct SessionRecord previousSession;
+static int hasPreviousSession = 0;
+
+// Clocks
+
+static int64_t clockMs(clockid_t clock) {
+    struct timespec now;
+    clock_gettime(clock, &now);
+    return (int64_t)now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+static int64_t elapsedMs(void) {
+    return clockMs(CLOCK_BOOTTIME);
+}
+
+static int64_t wallClockMs(void) {
+    return clockMs(CLOCK_REALTIME);
+}
+
+/**
+ * Fold the time since the last update into the totals and store them. Caller holds sessionLock.
+ */
+static void updateTotals(void) {
+    int64_t elapsed = elapsedMs() - stateSinceMs;
+    int isForeground = session->foreground;
+
+    session->foregroundMs = foregroundBaseMs + (isForeground ? elapsed : 0);
+    session->backgroundMs = backgroundBaseMs + (isForeground ? 0 : elapsed);
+    session->heartbeatTimestampMs = wallClockMs();
+}
+
+// Public API
+
+int MoonForge_Session_Begin(const char* directory, const char* sessionId) {
+    if (directory == NULL || sessionId == NULL) return 0;
+
+    pthread_mutex_lock(&sessionLock);
+
+    if (session != NULL) {
+        pthread_mutex_unlock(&sessionLock);
+        return 1;
+    }
+
+    char path[512];
+    snprintf(path, sizeof(path), "%s/session.bin", directory);
+
+    int fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        LOGE("Failed to open %s", path);
+        pthread_mutex_unlock(&sessionLock);
+        return 0;
+    }
+
+    // Keep what the previous process left before this one takes the record over
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size >= (off_t)sizeof(struct SessionRecord)
+        && pread(fd, &previousSession, sizeof(previousSession), 0) == (ssize_t)sizeof(previousSession)
+        && previousSession.magic == SESSION_MAGIC && previousSession.version == SESSION_VERSION
+        && previousSession.pid != (int32_t)getpid()) {
+        previousSession.sessionId[SESSION_ID_SIZE - 1] = '\0';
+        hasPreviousSession = 1;
+    }
+
+    size_t mapSize = (size_t)sysconf(_SC_PAGESIZE);
+    if (mapSize < sizeof(struct SessionRecord)) mapSize = sizeof(struct SessionRecord);
+
+    void* mapping = MAP_FAILED;
+    if (ftruncate(fd, (off_t)mapSize) == 0) {
+        mapping = mmap(NULL, mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+
+    if (mapping == MAP_FAILED) {
+        LOGE("Failed to map %s", path);
+        pthread_mutex_unlock(&sessionLock);
+        return 0;
+    }
+
+    struct SessionRecord* record = (struct SessionRecord*)mapping;
+    memset(record, 0, sizeof(*record));
+    record->version = SESSION_VERSION;
+
+    size_t idLength = strnlen(sessionId, SESSION_ID_SIZE - 1);
+    for (size_t i = 0; i < idLength; i++) {
+        char c = sessionId[i];
+        // Ids go into JSON unescaped
+        record->sessionId[i] = (c == '"' || c == '\\' || (unsigned char)c < 0x20) ? '_' : c;
+    }
+
+    record->startTimestampMs = wallClockMs();
+    record->heartbeatTimestampMs = record->startTimestampMs;
+    record->foreground = 1;
+    record->endReason = MOONFORGE_SESSION_RUNNING;
+    record->pid = (int32_t)getpid();
+
+    // The magic goes in last, so a record is either complete or ignored
+    __atomic_store_n(&record->magic, SESSION_MAGIC, __ATOMIC_RELEASE);
+
+    foregroundBaseMs = 0;
+    backgroundBaseMs = 0;
+    stateSinceMs = elapsedMs();
+    session = record;
+
+    pthread_mutex_unlock(&sessionLock);
+
+    LOGD("Session %s started", record->sessionId);
+    return 1;
+}
+
+void MoonForge_Session_Heartbeat(void) {
+    pthread_mutex_lock(&sessionLock);
+    if (session != NULL && session->endReason == MOONFORGE_SESSION_RUNNING) {
+        updateTotals();
+    }
+    pthread_mutex_unlock(&sessionLock);
+}
+
+void MoonForge_Session_SetForeground(int foreground) {
+    pthread_mutex_lock(&sessionLock);
+    if (session != NULL && session->endReason == MOONFORGE_SESSION_RUNNING && session->foreground != (foreground != 0)) {
+        updateTotals();
+        foregroundBaseMs = session->foregroundMs;
+        backgroundBaseMs = session->backgroundMs;
+        stateSinceMs = elapsedMs();
+        session->foreground = foreground != 0;
+    }
+    pthread_mutex_unlock(&sessionLock);
+}
+
+void MoonForge_Session_End(void) {
+    pthread_mutex_lock(&sessionLock);
+    if (session != NULL && session->endReason == MOONFORGE_SESSION_RUNNING) {
+        updateTotals();
+        session->endReason = MOONFORGE_SESSION_EXITED;
+    }
+    pthread_mutex_unlock(&sessionLock);
+}
+
+void moonforge_session_mark_crashed(int signal) {
+    // No lock: the crashing thread may hold it. Totals stay at the last heartbeat.
+    struct SessionRecord* record = session;
+    if (record == NULL) return;
+
+    record->heartbeatTimestampMs = wallClockMs();
+    record->signal = signal;
+    record->endReason = MOONFORGE_SESSION_CRASHED;
+}
+
+void moonforge_session_clear_crashed(void) {
+    struct SessionRecord* record = session;
+    if (record == NULL || record->endReason != MOONFORGE_SESSION_CRASHED) return;
+
+    record->signal = 0;
+    record->endReason = MOONFORGE_SESSION_RUNNING;
+}
+
+int MoonForge_Session_GetPreviousSummary(char* buffer, int bufferSize) {
+    if (buffer == NULL || bufferSize <= 0 || !hasPreviousSession) return 0;
+
+    const struct SessionRecord* record = &previousSession;
+    const char* endReason;
+    switch (record->endReason) {
+        case MOONFORGE_SESSION_EXITED: endReason = "exit"; break;
+        case MOONFORGE_SESSION_CRASHED: endReason = "crash"; break;
+        // Never ended: killed by the OS or the user (or a crash outside our handler)
+        default: endReason = record->foreground ? "killed_foreground" : "killed_background"; break;
+    }
+
+    int written = snprintf(buffer, (size_t)bufferSize,
+        "{\"sessionId\":\"%s\",\"startTimestamp\":%lld,\"endTimestamp\":%lld,\"foregroundMs\":%lld,"
+        "\"backgroundMs\":%lld,\"endReason\":\"%s\",\"signal\":%d}",
+        record->sessionId, (long long)record->startTimestampMs, (long long)record->heartbeatTimestampMs,
+        (long long)record->foregroundMs, (long long)record->backgroundMs, endReason, (int)record->signal);
+    return written > 0 && written < bufferSize ? written : 0;
+}
@@ -0,0 +1,74 @@
+/**
+ * MoonForge Session Black Box for Android (NDK) and Linux
+ *
+ * Keeps the state of the running session in a small memory-mapped file: id,
+ * start, last heartbeat, foreground and background time, and how it ended.
+ * Stores to a shared mapping reach the page cache immediately, so the record
+ * survives crashes and kills and the next launch can summarize the session
+ * that ended without running any shutdown code.
+ */
+
+#ifndef MOONFORGE_SESSION_H
+#define MOONFORGE_SESSION_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef MOONFORGE_EXPORT
+#define MOONFORGE_EXPORT __attribute__((visibility("default")))
+#endif
+
+// How a session ended, as recorded in the black box
+#define MOONFORGE_SESSION_RUNNING 0
+#define MOONFORGE_SESSION_EXITED 1
+#define MOONFORGE_SESSION_CRASHED 2
+
+/**
+ * Start recording a session into <directory>/session.bin. The record left
+ * there by the previous process becomes available through
+ * MoonForge_Session_GetPreviousSummary.
+ * @return 1 on success
+ */
+MOONFORGE_EXPORT int MoonForge_Session_Begin(const char* directory, const char* sessionId);
+
+/**
+ * Update the heartbeat and the foreground/background totals
+ */
+MOONFORGE_EXPORT void MoonForge_Session_Heartbeat(void);
+
+/**
+ * Switch between foreground (1) and background (0)
+ */
+MOONFORGE_EXPORT void MoonForge_Session_SetForeground(int foreground);
+
+/**
+ * Mark the session as ended normally (application quit)
+ */
+MOONFORGE_EXPORT void MoonForge_Session_End(void);
+
+/**
+ * The previous session as a JSON object:
+ * {"sessionId":"..","startTimestamp":..,"endTimestamp":..,"foregroundMs":..,
+ *  "backgroundMs":..,"endReason":"..","signal":..}
+ * endReason is "exit", "crash", "killed_foreground" or "killed_background".
+ * @return Number of characters written (0 if there was no previous session)
+ */
+MOONFORGE_EXPORT int MoonForge_Session_GetPreviousSummary(char* buffer, int bufferSize);
+
+/**
+ * Mark the session as crashed. Async-signal-safe; called by the crash handler.
+ */
+void moonforge_session_mark_crashed(int signal);
+
+/**
+ * Undo moonforge_session_mark_crashed when another handler recovered from
+ * the signal. Async-signal-safe.
+ */
+void moonforge_session_clear_crashed(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MOONFORGE_SESSION_H
@@ -0,0 +1,134 @@
+/**
+ * MoonForge Signal Stacks for Android (NDK) and Linux
+ *
+ * A PLT hook on pthread_create starts each new thread in a trampoline that
+ * maps its alternate stack before running the real start routine. The stack
+ * has a guard page below it, so a handler that overflows it faults instead of
+ * writing over other memory. A thread-specific key frees it on thread exit;
+ * the previous stack is restored first, since bionic unmaps its own during
+ * thread teardown.
+ */
+
+#define _GNU_SOURCE
+
+#include "moonforge_signal_stack.h"
+#include "moonforge_plt_hook.h"
+
+#include <pthread.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#define LOG_TAG "MoonForgeCrash"
+#include "moonforge_log.h"
+
+struct SignalStack {
+    void* mapping;
+    size_t mappingSize;
+    stack_t previous;
+};
+
+struct ThreadStart {
+    void* (*routine)(void*);
+    void* argument;
+};
+
+static pthread_once_t keyOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t stackKey;
+static int hasKey = 0;
+
+static void releaseSignalStack(void* data) {
+    struct SignalStack* stack = data;
+    sigaltstack(&stack->previous, NULL);
+    munmap(stack->mapping, stack->mappingSize);
+    free(stack);
+}
+
+static void createKey(void) {
+    hasKey = pthread_key_create(&stackKey, releaseSignalStack) == 0;
+}
+
+int moonforge_signal_stack_ensure(void) {
+    stack_t current;
+    if (sigaltstack(NULL, &current) != 0) return 0;
+    if (!(current.ss_flags & SS_DISABLE) && current.ss_size >= MOONFORGE_SIGNAL_STACK_SIZE) return 1;
+
+    // Can't be replaced while a handler is running on it
+    if (current.ss_flags & SS_ONSTACK) return 0;
+
+    pthread_once(&keyOnce, createKey);
+    if (!hasKey) return 0;
+
+    size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    struct SignalStack* stack = malloc(sizeof(*stack));
+    if (stack == NULL) return 0;
+
+    stack->mappingSize = MOONFORGE_SIGNAL_STACK_SIZE + pageSize;
+    stack->mapping = mmap(NULL, stack->mappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (stack->mapping == MAP_FAILED) {
+        free(stack);
+        return 0;
+    }
+    mprotect(stack->mapping, pageSize, PROT_NONE);
+
+    stack_t replacement;
+    replacement.ss_sp = (char*)stack->mapping + pageSize;
+    replacement.ss_size = MOONFORGE_SIGNAL_STACK_SIZE;
+    replacement.ss_flags = 0;
+    if (sigaltstack(&replacement, NULL) != 0) {
+        munmap(stack->mapping, stack->mappingSize);
+        free(stack);
+        return 0;
+    }
+
+    // Disabled stacks report flags only; put back exactly that
+    stack->previous = current;
+    stack->previous.ss_flags &= SS_DISABLE;
+
+    // Replacing a stack installed by an earlier call on this thread frees that one
+    struct SignalStack* earlier = pthread_getspecific(stackKey);
+    pthread_setspecific(stackKey, stack);
+    if (earlier != NULL) {
+        stack->previous = earlier->previous;
+        munmap(earlier->mapping, earlier->mappingSize);
+        free(earlier);
+    }
+    return 1;
+}
+
+// pthread_create hook
+
+static void* startWithSignalStack(void* data) {
+    struct ThreadStart start = *(struct ThreadStart*)data;
+    free(data);
+
+    moonforge_signal_stack_ensure();
+    return start.routine(start.argument);
+}
+
+static int hookedPthreadCreate(pthread_t* thread, const pthread_attr_t* attributes,
+                               void* (*routine)(void*), void* argument) {
+    struct ThreadStart* start = malloc(sizeof(*start));
+    if (start == NULL) return pthread_create(thread, attributes, routine, argument);
+
+    start->routine = routine;
+    start->argument = argument;
+    int result = pthread_create(thread, attributes, startWithSignalStack, start);
+    if (result != 0) free(start);
+    return result;
+}
+
+void moonforge_signal_stack_install(void) {
+    if (!moonforge_signal_stack_ensure()) {
+        LOGE("Failed to install the alternate signal stack");
+    }
+
+    moonforge_plt_hook_register(NULL, "pthread_create", (void*)hookedPthreadCreate, NULL);
+    int patched = moonforge_plt_hook_refresh();
+    LOGD("Signal stacks for new threads (%d import slots)", patched);
+}
+
+void moonforge_signal_stack_uninstall(void) {
+    moonforge_plt_hook_unregister((void*)hookedPthreadCreate);
+}
@@ -0,0 +1,44 @@
+/**
+ * MoonForge Signal Stacks for Android (NDK) and Linux
+ *
+ * The crash handler runs on an alternate signal stack, so it still runs when
+ * a thread overflows its own stack. The alternate stack is per thread: every
+ * thread that can crash needs one, large enough for unwinding and formatting
+ * the record. glibc gives threads none, and bionic's are too small.
+ */
+
+#ifndef MOONFORGE_SIGNAL_STACK_H
+#define MOONFORGE_SIGNAL_STACK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Alternate stack the crash handler needs (SIGSTKSZ is too small for unwinding and formatting)
+#define MOONFORGE_SIGNAL_STACK_SIZE (64 * 1024)
+
+/**
+ * Give the calling thread an alternate stack, unless it already has one of at
+ * least MOONFORGE_SIGNAL_STACK_SIZE. It is freed, and the previous one put
+ * back, when the thread exits.
+ * @return 1 if the thread has a large enough stack
+ */
+int moonforge_signal_stack_ensure(void);
+
+/**
+ * Cover the calling thread and hook pthread_create in loaded modules, so
+ * threads started from now on get their own stack. Threads that are already
+ * running keep what they have.
+ */
+void moonforge_signal_stack_install(void);
+
+/**
+ * Remove the pthread_create hook. Threads keep their stacks until they exit.
+ */
+void moonforge_signal_stack_uninstall(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MOONFORGE_SIGNAL_STACK_H
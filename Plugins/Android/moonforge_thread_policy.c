@@ -0,0 +1,163 @@
+/**
+ * MoonForge Thread Policy for Android (NDK)
+ *
+ * Detects efficiency cores from the kernel's CPU capacity table (falling back
+ * to the maximum frequency of each core) and moves the calling thread onto
+ * them at reduced priority. Everything here is best effort: a device that
+ * refuses a setting keeps the default for that setting.
+ */
+
+#define _GNU_SOURCE
+
+#include "moonforge_thread_policy.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#define LOG_TAG "MoonForgeThread"
+#include "moonforge_log.h"
+
+#ifndef SCHED_IDLE
+#define SCHED_IDLE 5
+#endif
+
+#define MAX_CPUS 64
+
+// Nice values for each policy (0 = leave unchanged)
+#define EFFICIENCY_NICE 10
+#define BACKGROUND_NICE 19
+
+static pthread_once_t detectOnce = PTHREAD_ONCE_INIT;
+static uint64_t efficiencyMask = 0;
+static int cpuCount = 0;
+
+/**
+ * Read a single non-negative integer from a sysfs file, or -1
+ */
+static long readSysfsLong(const char* path) {
+    FILE* file = fopen(path, "re");
+    if (file == NULL) return -1;
+
+    long value = -1;
+    if (fscanf(file, "%ld", &value) != 1) {
+        value = -1;
+    }
+    fclose(file);
+    return value;
+}
+
+/**
+ * Read one metric for every CPU. Returns 0 if any CPU is missing it,
+ * since a partial table can't be compared.
+ */
+static int readCpuTable(const char* format, long* values, int count) {
+    char path[128];
+    for (int cpu = 0; cpu < count; cpu++) {
+        snprintf(path, sizeof(path), format, cpu);
+        values[cpu] = readSysfsLong(path);
+        if (values[cpu] <= 0) return 0;
+    }
+    return 1;
+}
+
+static void detectEfficiencyCores(void) {
+    long configured = sysconf(_SC_NPROCESSORS_CONF);
+    cpuCount = configured > 0 ? (int)configured : 1;
+
+    int count = cpuCount < MAX_CPUS ? cpuCount : MAX_CPUS;
+    long values[MAX_CPUS];
+
+    // cpu_capacity is the scheduler's own view (EAS); max frequency is a proxy on older kernels
+    if (!readCpuTable("/sys/devices/system/cpu/cpu%d/cpu_capacity", values, count) &&
+        !readCpuTable("/sys/devices/system/cpu/cpu%d/cpufreq/cpuinfo_max_freq", values, count)) {
+        LOGD("No CPU capacity or frequency table, leaving affinity unchanged");
+        return;
+    }
+
+    long lowest = values[0];
+    long highest = values[0];
+    for (int cpu = 1; cpu < count; cpu++) {
+        if (values[cpu] < lowest) lowest = values[cpu];
+        if (values[cpu] > highest) highest = values[cpu];
+    }
+
+    // Homogeneous cores: nothing to prefer
+    if (lowest == highest) return;
+
+    for (int cpu = 0; cpu < count; cpu++) {
+        if (values[cpu] == lowest) {
+            efficiencyMask |= (uint64_t)1 << cpu;
+        }
+    }
+
+    LOGD("Efficiency cores: mask 0x%llx of %d CPUs", (unsigned long long)efficiencyMask, cpuCount);
+}
+
+static int applyAffinity(void) {
+    pthread_once(&detectOnce, detectEfficiencyCores);
+    if (efficiencyMask == 0) return 0;
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu = 0; cpu < MAX_CPUS; cpu++) {
+        if (efficiencyMask & ((uint64_t)1 << cpu)) {
+            CPU_SET(cpu, &set);
+        }
+    }
+
+    // pid 0 is the calling thread. Fails if the app's cpuset excludes the little cores.
+    if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+        LOGD("sched_setaffinity failed: %s", strerror(errno));
+        return 0;
+    }
+    return MOONFORGE_THREAD_APPLIED_AFFINITY;
+}
+
+static int applyNice(int nice) {
+    // On Linux, PRIO_PROCESS with a thread id sets the priority of that thread only
+    if (setpriority(PRIO_PROCESS, (id_t)gettid(), nice) != 0) {
+        LOGD("setpriority(%d) failed: %s", nice, strerror(errno));
+        return 0;
+    }
+    return MOONFORGE_THREAD_APPLIED_NICE;
+}
+
+static int applySchedIdle(void) {
+    struct sched_param param;
+    memset(&param, 0, sizeof(param));
+
+    // Lowering our own policy needs no privileges, but seccomp or SELinux may still refuse
+    if (sched_setscheduler(0, SCHED_IDLE, &param) != 0) {
+        LOGD("SCHED_IDLE not permitted: %s", strerror(errno));
+        return 0;
+    }
+    return MOONFORGE_THREAD_APPLIED_SCHED_IDLE;
+}
+
+MOONFORGE_EXPORT int MoonForge_ThreadPolicy_ApplyToCurrentThread(int policy) {
+    switch (policy) {
+        case MOONFORGE_THREAD_POLICY_EFFICIENCY_CORES:
+            return applyAffinity() | applyNice(EFFICIENCY_NICE);
+
+        case MOONFORGE_THREAD_POLICY_BACKGROUND:
+            return applyAffinity() | applyNice(BACKGROUND_NICE) | applySchedIdle();
+
+        default:
+            return 0;
+    }
+}
+
+MOONFORGE_EXPORT uint64_t MoonForge_ThreadPolicy_GetEfficiencyCoreMask(void) {
+    pthread_once(&detectOnce, detectEfficiencyCores);
+    return efficiencyMask;
+}
+
+MOONFORGE_EXPORT int MoonForge_ThreadPolicy_GetCpuCount(void) {
+    pthread_once(&detectOnce, detectEfficiencyCores);
+    return cpuCount;
+}
@@ -0,0 +1,57 @@
+/**
+ * MoonForge Thread Policy for Android (NDK)
+ *
+ * Keeps SDK background threads off the performance cores on big.LITTLE
+ * devices and lowers their scheduling priority.
+ */
+
+#ifndef MOONFORGE_THREAD_POLICY_H
+#define MOONFORGE_THREAD_POLICY_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef MOONFORGE_EXPORT
+#define MOONFORGE_EXPORT __attribute__((visibility("default")))
+#endif
+
+/**
+ * Placement policies (must match ThreadAffinityPolicy in C#)
+ */
+#define MOONFORGE_THREAD_POLICY_NONE              0
+#define MOONFORGE_THREAD_POLICY_EFFICIENCY_CORES  1
+#define MOONFORGE_THREAD_POLICY_BACKGROUND        2
+
+/**
+ * Result flags returned by MoonForge_ThreadPolicy_ApplyToCurrentThread
+ */
+#define MOONFORGE_THREAD_APPLIED_AFFINITY    0x1
+#define MOONFORGE_THREAD_APPLIED_NICE        0x2
+#define MOONFORGE_THREAD_APPLIED_SCHED_IDLE  0x4
+
+/**
+ * Apply a placement policy to the calling thread
+ * @param policy One of MOONFORGE_THREAD_POLICY_*
+ * @return MOONFORGE_THREAD_APPLIED_* flags for the parts that took effect
+ */
+MOONFORGE_EXPORT int MoonForge_ThreadPolicy_ApplyToCurrentThread(int policy);
+
+/**
+ * Bit mask of the CPUs detected as efficiency cores (CPUs 0-63).
+ * Zero when the device has a single core type.
+ */
+MOONFORGE_EXPORT uint64_t MoonForge_ThreadPolicy_GetEfficiencyCoreMask(void);
+
+/**
+ * Number of configured CPUs
+ */
+MOONFORGE_EXPORT int MoonForge_ThreadPolicy_GetCpuCount(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MOONFORGE_THREAD_POLICY_H
@@ -0,0 +1,426 @@
+/**
+ * MoonForge ARM EHABI Unwinder for Android (NDK)
+ *
+ * Each module's .ARM.exidx is a table of (function, unwind data) pairs
+ * sorted by function address; the unwind data is a short program of
+ * opcodes (ARM EHABI section 10.3) that undoes the function's prologue,
+ * either inline in the table or in .ARM.extab. Per frame the unwinder
+ * binary-searches the table for the pc, runs the opcodes against a copy of
+ * the registers, and continues from the restored pc and sp.
+ *
+ * The module table is filled with dl_iterate_phdr at install; a pc outside
+ * every known module is resolved with dladdr and the module's program
+ * headers, and the module is added. Stack words are read only from pages a
+ * process_vm_readv probe found readable, so a wild sp stops the unwind.
+ */
+
+#define _GNU_SOURCE
+
+#include "moonforge_unwind_ehabi.h"
+
+// MOONFORGE_UNWIND_EHABI_TABLES builds the table interpreter on other hosts,
+// for the tests that run it against synthetic tables
+#if defined(__arm__) || defined(MOONFORGE_UNWIND_EHABI_TABLES)
+
+#include <dlfcn.h>
+#include <elf.h>
+#include <link.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+#ifndef PT_ARM_EXIDX
+#define PT_ARM_EXIDX (PT_LOPROC + 1)
+#endif
+
+#define LOG_TAG "MoonForgeUnwind"
+#include "moonforge_log.h"
+
+#define MAX_MODULES 512
+
+// Entry data meaning the function cannot be unwound
+#define EXIDX_CANTUNWIND 1
+
+// Longest opcode program: three bytes in the first word plus up to 255 more words
+#define MAX_OPCODES (3 + 255 * 4)
+
+#define REG_SP 13
+#define REG_LR 14
+#define REG_PC 15
+
+struct UnwindModule {
+    uintptr_t textStart;    // executable segments
+    uintptr_t textEnd;
+    uintptr_t imageStart;   // every loaded segment; extab must lie inside
+    uintptr_t imageEnd;
+    const uint32_t* exidx;
+    size_t exidxCount;
+};
+
+static struct UnwindModule modules[MAX_MODULES];
+static int moduleCount = 0;
+static int lastModule = 0;
+
+static uintptr_t pageSize = 4096;
+
+// Stack pages known to be readable, as one contiguous range
+static uintptr_t readableStart = 0;
+static uintptr_t readableEnd = 0;
+
+// Opcodes of the frame being unwound; only the crash handler unwinds
+static uint8_t opcodes[MAX_OPCODES];
+
+// Module table
+
+static int addModule(ElfW(Addr) bias, const ElfW(Phdr)* phdrs, int phnum) {
+    struct UnwindModule module;
+    memset(&module, 0, sizeof(module));
+    module.textStart = module.imageStart = UINTPTR_MAX;
+
+    for (int i = 0; i < phnum; i++) {
+        const ElfW(Phdr)* phdr = &phdrs[i];
+        uintptr_t start = bias + phdr->p_vaddr;
+        uintptr_t end = start + phdr->p_memsz;
+
+        if (phdr->p_type == PT_LOAD) {
+            if (start < module.imageStart) module.imageStart = start;
+            if (end > module.imageEnd) module.imageEnd = end;
+            if (phdr->p_flags & PF_X) {
+                if (start < module.textStart) module.textStart = start;
+                if (end > module.textEnd) module.textEnd = end;
+            }
+        } else if (phdr->p_type == PT_ARM_EXIDX) {
+            module.exidx = (const uint32_t*)start;
+            module.exidxCount = phdr->p_memsz / 8;
+        }
+    }
+
+    if (module.exidx == NULL || module.exidxCount == 0 || module.textEnd == 0) return -1;
+
+    for (int i = 0; i < moduleCount; i++) {
+        if (modules[i].textStart == module.textStart) {
+            modules[i] = module;
+            return i;
+        }
+    }
+    if (moduleCount >= MAX_MODULES) return -1;
+
+    modules[moduleCount] = module;
+    __atomic_store_n(&moduleCount, moduleCount + 1, __ATOMIC_RELEASE);
+    return moduleCount - 1;
+}
+
+static int addLoadedModule(struct dl_phdr_info* info, size_t size, void* data) {
+    (void)size;
+    (void)data;
+    addModule(info->dlpi_addr, info->dlpi_phdr, info->dlpi_phnum);
+    return 0;
+}
+
+// A module loaded after the last refresh, from its ELF header in memory
+static int addModuleAt(uintptr_t pc) {
+    Dl_info info;
+    if (!dladdr((void*)pc, &info) || info.dli_fbase == NULL) return -1;
+
+    const ElfW(Ehdr)* ehdr = (const ElfW(Ehdr)*)info.dli_fbase;
+    if (memcmp(ehdr->e_ident, ELFMAG, SELFMAG) != 0 || ehdr->e_ident[EI_CLASS] != ELFCLASS32) return -1;
+
+    // dli_fbase is the start of the lowest segment, which maps the headers
+    const ElfW(Phdr)* phdrs = (const ElfW(Phdr)*)((uintptr_t)ehdr + ehdr->e_phoff);
+    ElfW(Addr) lowest = UINTPTR_MAX;
+    for (int i = 0; i < ehdr->e_phnum; i++) {
+        if (phdrs[i].p_type == PT_LOAD && phdrs[i].p_vaddr < lowest) lowest = phdrs[i].p_vaddr;
+    }
+    if (lowest == UINTPTR_MAX) return -1;
+
+    ElfW(Addr) bias = (uintptr_t)info.dli_fbase - (lowest & ~(pageSize - 1));
+    return addModule(bias, phdrs, ehdr->e_phnum);
+}
+
+static const struct UnwindModule* findModule(uintptr_t pc) {
+    int count = __atomic_load_n(&moduleCount, __ATOMIC_ACQUIRE);
+
+    // Consecutive frames are mostly in the same module
+    if (lastModule < count && pc >= modules[lastModule].textStart && pc < modules[lastModule].textEnd) {
+        return &modules[lastModule];
+    }
+    for (int i = 0; i < count; i++) {
+        if (pc >= modules[i].textStart && pc < modules[i].textEnd) {
+            lastModule = i;
+            return &modules[i];
+        }
+    }
+
+    int added = addModuleAt(pc);
+    if (added < 0 || pc < modules[added].textStart || pc >= modules[added].textEnd) return NULL;
+    lastModule = added;
+    return &modules[added];
+}
+
+// Memory
+
+static uintptr_t prel31(const uint32_t* word) {
+    int32_t offset = (int32_t)(*word << 1) >> 1;
+    return (uintptr_t)word + offset;
+}
+
+static int pageReadable(uintptr_t page) {
+    char byte;
+    struct iovec local = { &byte, 1 };
+    struct iovec remote = { (void*)page, 1 };
+    return syscall(__NR_process_vm_readv, getpid(), &local, 1, &remote, 1, 0) == 1;
+}
+
+static int readStack(uintptr_t address, uint32_t* value) {
+    if ((address & 3) != 0 || address > UINTPTR_MAX - 4) return 0;
+
+    if (address < readableStart || address + 4 > readableEnd) {
+        uintptr_t page = address & ~(pageSize - 1);
+        if (!pageReadable(page)) return 0;
+
+        // Frames are read upwards, so the range mostly grows at its end
+        if (page == readableEnd) {
+            readableEnd += pageSize;
+        } else if (page + pageSize == readableStart) {
+            readableStart = page;
+        } else {
+            readableStart = page;
+            readableEnd = page + pageSize;
+        }
+    }
+
+    *value = *(const uint32_t*)address;
+    return 1;
+}
+
+// Unwind tables
+
+/**
+ * Find the entry covering pc and copy its opcodes into the opcodes buffer
+ * @return Number of opcodes, or -1 if the frame cannot be unwound
+ */
+static int loadOpcodes(const struct UnwindModule* module, uintptr_t pc) {
+    // Last entry whose function starts at or before pc
+    size_t low = 0;
+    size_t high = module->exidxCount;
+    while (high - low > 1) {
+        size_t middle = low + (high - low) / 2;
+        if (prel31(&module->exidx[middle * 2]) <= pc) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+
+    const uint32_t* entry = &module->exidx[low * 2];
+    if (prel31(entry) > pc || entry[1] == EXIDX_CANTUNWIND) return -1;
+
+    const uint32_t* data;
+    int firstOpcodes = 3;   // opcodes in the low bytes of the first word
+    int extraWords = 0;     // words of four opcodes that follow it
+
+    if (entry[1] & 0x80000000u) {
+        // Compact model inline: personality 0 with three opcodes
+        data = &entry[1];
+        if ((*data & 0x0f000000u) != 0) return -1;
+    } else {
+        data = (const uint32_t*)prel31(&entry[1]);
+        if ((uintptr_t)data < module->imageStart || (uintptr_t)data + 8 > module->imageEnd) return -1;
+
+        if (*data & 0x80000000u) {
+            int personality = (*data >> 24) & 0x0f;
+            if (personality == 1 || personality == 2) {
+                // Lu16/Lu32: word count, then two opcodes
+                firstOpcodes = 2;
+                extraWords = (*data >> 16) & 0xff;
+            } else if (personality != 0) {
+                return -1;
+            }
+        } else {
+            // Generic model: a personality routine, then data laid out like Lu16 with
+            // the word count in the top byte (as GCC's and Clang's routines expect)
+            data++;
+            extraWords = *data >> 24;
+        }
+        if ((uintptr_t)(data + 1 + extraWords) > module->imageEnd) return -1;
+    }
+
+    int count = 0;
+    for (int shift = 8 * (firstOpcodes - 1); shift >= 0; shift -= 8) {
+        opcodes[count++] = (*data >> shift) & 0xff;
+    }
+    for (int i = 1; i <= extraWords; i++) {
+        for (int shift = 24; shift >= 0; shift -= 8) {
+            opcodes[count++] = (data[i] >> shift) & 0xff;
+        }
+    }
+    return count;
+}
+
+// Pop the registers in mask (bit n = r[first + n]) from vsp upwards
+static int popRegisters(uint32_t* regs, uint32_t* vsp, int first, unsigned mask) {
+    for (int reg = first; mask != 0; reg++, mask >>= 1) {
+        if (!(mask & 1)) continue;
+        if (!readStack(*vsp, &regs[reg])) return 0;
+        *vsp += 4;
+    }
+    return 1;
+}
+
+/**
+ * Run the opcodes against regs, leaving the caller's registers
+ * @return 1 on success, 0 if the opcodes are invalid, refuse to unwind or read bad memory
+ */
+static int executeOpcodes(uint32_t* regs, int count) {
+    uint32_t vsp = regs[REG_SP];
+    int pcRestored = 0;
+
+    for (int i = 0; i < count; i++) {
+        uint8_t op = opcodes[i];
+
+        if ((op & 0xc0) == 0x00) {
+            vsp += ((op & 0x3f) << 2) + 4;
+        } else if ((op & 0xc0) == 0x40) {
+            vsp -= ((op & 0x3f) << 2) + 4;
+        } else if ((op & 0xf0) == 0x80) {
+            if (++i >= count) return 0;
+            unsigned mask = ((op & 0x0f) << 8) | opcodes[i];
+            if (mask == 0) return 0;  // refuse to unwind
+            if (!popRegisters(regs, &vsp, 4, mask)) return 0;
+            if (mask & (1 << (REG_SP - 4))) vsp = regs[REG_SP];
+            if (mask & (1 << (REG_PC - 4))) pcRestored = 1;
+        } else if ((op & 0xf0) == 0x90) {
+            int reg = op & 0x0f;
+            if (reg == REG_SP || reg == REG_PC) return 0;
+            vsp = regs[reg];
+        } else if ((op & 0xf0) == 0xa0) {
+            unsigned mask = (1u << ((op & 0x07) + 1)) - 1;
+            if (op & 0x08) mask |= 1 << (REG_LR - 4);
+            if (!popRegisters(regs, &vsp, 4, mask)) return 0;
+        } else if (op == 0xb0) {
+            break;
+        } else if (op == 0xb1) {
+            if (++i >= count) return 0;
+            unsigned mask = opcodes[i];
+            if (mask == 0 || (mask & 0xf0) != 0) return 0;
+            if (!popRegisters(regs, &vsp, 0, mask)) return 0;
+        } else if (op == 0xb2) {
+            uint32_t value = 0;
+            int shift = 0;
+            do {
+                if (++i >= count || shift > 28) return 0;
+                value |= (uint32_t)(opcodes[i] & 0x7f) << shift;
+                shift += 7;
+            } while (opcodes[i] & 0x80);
+            vsp += 0x204 + (value << 2);
+        } else if (op == 0xb3) {
+            // VFP D[s]-D[s+c] saved by FSTMFDX
+            if (++i >= count) return 0;
+            vsp += 8 * ((opcodes[i] & 0x0f) + 1) + 4;
+        } else if ((op & 0xf8) == 0xb8) {
+            // VFP D8-D[8+n] saved by FSTMFDX
+            vsp += 8 * ((op & 0x07) + 1) + 4;
+        } else if (op == 0xc6 || op == 0xc8 || op == 0xc9) {
+            // iWMMXt wR[s]-wR[s+c], VFP D[16+s]-D[16+s+c] or D[s]-D[s+c] saved by VPUSH
+            if (++i >= count) return 0;
+            vsp += 8 * ((opcodes[i] & 0x0f) + 1);
+        } else if (op == 0xc7) {
+            // iWMMXt control registers under mask
+            if (++i >= count) return 0;
+            unsigned mask = opcodes[i];
+            if (mask == 0 || (mask & 0xf0) != 0) return 0;
+            vsp += 4 * __builtin_popcount(mask);
+        } else if ((op & 0xf8) == 0xc0 || (op & 0xf8) == 0xd0) {
+            // iWMMXt wR10-wR[10+n], or VFP D8-D[8+n] saved by VPUSH
+            vsp += 8 * ((op & 0x07) + 1);
+        } else {
+            return 0;  // spare
+        }
+    }
+
+    regs[REG_SP] = vsp;
+    if (!pcRestored) regs[REG_PC] = regs[REG_LR];
+    return 1;
+}
+
+// Walk
+
+static int unwindFrom(uint32_t* regs, MoonForgeUnwindCallback callback, void* arg) {
+    int frames = 0;
+
+    while (regs[REG_PC] != 0) {
+        uintptr_t pc = regs[REG_PC] & ~1u;
+        frames++;
+        if (!callback(pc, arg)) break;
+
+        // Callers' pcs are return addresses; step back into the call instruction
+        uintptr_t lookup = frames == 1 ? pc : pc - 2;
+        const struct UnwindModule* module = findModule(lookup);
+        int count = module != NULL ? loadOpcodes(module, lookup) : -1;
+
+        if (count < 0) {
+            // A call through a bad pointer faults with pc outside any function;
+            // the caller is still in lr and sp is unchanged
+            if (frames == 1 && regs[REG_LR] != 0 && (regs[REG_LR] & ~1u) != pc) {
+                regs[REG_PC] = regs[REG_LR];
+                continue;
+            }
+            break;
+        }
+
+        uint32_t sp = regs[REG_SP];
+        if (!executeOpcodes(regs, count)) break;
+
+        // The stack only unwinds upwards; no progress means a loop
+        if (regs[REG_SP] < sp || (regs[REG_SP] == sp && (regs[REG_PC] & ~1u) == pc)) break;
+    }
+    return frames;
+}
+
+// Public API
+
+void moonforge_unwind_ehabi_refresh(void) {
+    long size = sysconf(_SC_PAGESIZE);
+    if (size > 0) pageSize = (uintptr_t)size;
+
+    dl_iterate_phdr(addLoadedModule, NULL);
+    LOGD("Unwind tables of %d modules", moduleCount);
+}
+
+#endif
+
+#if defined(__arm__)
+
+int moonforge_unwind_ehabi(const void* ucontext, MoonForgeUnwindCallback callback, void* arg) {
+    if (ucontext == NULL || callback == NULL) return 0;
+
+    const mcontext_t* mcontext = &((const ucontext_t*)ucontext)->uc_mcontext;
+    uint32_t regs[16] = {
+        mcontext->arm_r0, mcontext->arm_r1, mcontext->arm_r2, mcontext->arm_r3,
+        mcontext->arm_r4, mcontext->arm_r5, mcontext->arm_r6, mcontext->arm_r7,
+        mcontext->arm_r8, mcontext->arm_r9, mcontext->arm_r10, mcontext->arm_fp,
+        mcontext->arm_ip, mcontext->arm_sp, mcontext->arm_lr, mcontext->arm_pc
+    };
+
+    readableStart = readableEnd = 0;
+    lastModule = 0;
+    return unwindFrom(regs, callback, arg);
+}
+
+#else
+
+#if !defined(MOONFORGE_UNWIND_EHABI_TABLES)
+void moonforge_unwind_ehabi_refresh(void) {
+}
+#endif
+
+int moonforge_unwind_ehabi(const void* ucontext, MoonForgeUnwindCallback callback, void* arg) {
+    (void)ucontext;
+    (void)callback;
+    (void)arg;
+    return -1;
+}
+
+#endif
@@ -0,0 +1,52 @@
+/**
+ * MoonForge ARM EHABI Unwinder for Android (NDK)
+ *
+ * Unwinds 32-bit ARM (armeabi-v7a) stacks with the .ARM.exidx/.ARM.extab
+ * tables the compiler emits for every function. _Unwind_Backtrace called
+ * from a signal handler on 32-bit ARM often stops after one or two frames:
+ * it starts at the handler, running on the alternate stack, and cannot
+ * unwind through the signal frame back into the interrupted code. This
+ * unwinder starts from the registers saved in the ucontext instead and
+ * interprets the unwind opcodes itself, without going through personality
+ * routines.
+ *
+ * On other architectures the functions are stubs and the crash handler
+ * keeps using _Unwind_Backtrace.
+ */
+
+#ifndef MOONFORGE_UNWIND_EHABI_H
+#define MOONFORGE_UNWIND_EHABI_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Called with each frame's pc, innermost first
+ * @return 0 to stop unwinding
+ */
+typedef int (*MoonForgeUnwindCallback)(uintptr_t pc, void* arg);
+
+/**
+ * Record the unwind tables of every loaded module. Not async-signal-safe;
+ * called when the crash handler is installed. Modules loaded afterwards are
+ * found from the crash handler itself, at the cost of a dladdr per module.
+ */
+void moonforge_unwind_ehabi_refresh(void);
+
+/**
+ * Unwind the stack of the thread a signal interrupted. Async-signal-safe and
+ * allocation-free; stack memory is probed before it is read, so a corrupt
+ * stack ends the unwind instead of faulting.
+ * @param ucontext The signal handler's third argument
+ * @return Number of frames passed to callback, or -1 if not supported on this architecture
+ */
+int moonforge_unwind_ehabi(const void* ucontext, MoonForgeUnwindCallback callback, void* arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MOONFORGE_UNWIND_EHABI_H
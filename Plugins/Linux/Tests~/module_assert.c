@@ -0,0 +1,12 @@
+// Game code with a failing assert, in a module of its own so its __assert_fail import is hooked
+#undef NDEBUG
+#include <assert.h>
+#include <stdlib.h>
+
+__attribute__((noinline)) void assert_positive(int value) {
+    assert(value > 0);
+}
+
+__attribute__((noinline)) void abort_without_message(void) {
+    abort();
+}
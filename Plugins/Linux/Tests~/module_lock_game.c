@@ -0,0 +1,154 @@
+// Game code taking pthread locks, so its imports are hooked by test_lock_monitor
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+static pthread_mutex_t lockA = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t lockB = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t lockC = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t never = PTHREAD_COND_INITIALIZER;
+
+static void sleepMs(int ms) {
+    usleep((useconds_t)ms * 1000);
+}
+
+__attribute__((noinline)) void lock_a_then_b(void) {
+    pthread_mutex_lock(&lockA);
+    sleepMs(200);
+    pthread_mutex_lock(&lockB);
+}
+
+__attribute__((noinline)) void lock_b_then_a(void) {
+    pthread_mutex_lock(&lockB);
+    sleepMs(200);
+    pthread_mutex_lock(&lockA);
+}
+
+void* render_thread(void* argument) {
+    (void)argument;
+    pthread_setname_np(pthread_self(), "RenderThread");
+    lock_a_then_b();
+    return NULL;
+}
+
+// A quote in the name, which the report must not pass through
+void* audio_thread(void* argument) {
+    (void)argument;
+    pthread_setname_np(pthread_self(), "Audio\"Thread");
+    lock_b_then_a();
+    return NULL;
+}
+
+void* loader_thread(void* argument) {
+    (void)argument;
+    pthread_setname_np(pthread_self(), "Loader");
+    pthread_mutex_lock(&lockA);
+    sleepMs(3000);
+    pthread_mutex_unlock(&lockA);
+    return NULL;
+}
+
+__attribute__((noinline)) void wait_for_a(void) {
+    pthread_mutex_lock(&lockA);
+}
+
+__attribute__((noinline)) void wait_for_condition(void) {
+    pthread_mutex_lock(&lockC);
+    pthread_cond_wait(&never, &lockC);
+}
+
+// Short waits that never add up to a hang
+void take_a_briefly(int times) {
+    for (int i = 0; i < times; i++) {
+        pthread_mutex_lock(&lockA);
+        sleepMs(20);
+        pthread_mutex_unlock(&lockA);
+    }
+}
+
+void* brief_thread(void* argument) {
+    (void)argument;
+    take_a_briefly(40);
+    return NULL;
+}
+
+static void* alternate(void* argument) {
+    (void)argument;
+    for (int i = 0; i < 2000; i++) {
+        pthread_mutex_lock(&lockA);
+        usleep(10);
+        pthread_mutex_unlock(&lockA);
+        pthread_mutex_lock(&lockB);
+        usleep(10);
+        pthread_mutex_unlock(&lockB);
+    }
+    return NULL;
+}
+
+// Two threads fighting over A and B, so both end up contended
+void contend_a_and_b(void) {
+    pthread_t first, second;
+    pthread_create(&first, NULL, alternate, NULL);
+    pthread_create(&second, NULL, alternate, NULL);
+    pthread_join(first, NULL);
+    pthread_join(second, NULL);
+}
+
+// Contended increments; the monitor must not break mutual exclusion
+static pthread_mutex_t counterLock = PTHREAD_MUTEX_INITIALIZER;
+static long counter;
+static int increments;
+
+static void* increment(void* argument) {
+    (void)argument;
+    for (int i = 0; i < increments; i++) {
+        pthread_mutex_lock(&counterLock);
+        counter++;
+        pthread_mutex_unlock(&counterLock);
+    }
+    return NULL;
+}
+
+long count_with_threads(int threads, int perThread) {
+    pthread_t workers[16];
+    counter = 0;
+    increments = perThread;
+    for (int i = 0; i < threads; i++) pthread_create(&workers[i], NULL, increment, NULL);
+    for (int i = 0; i < threads; i++) pthread_join(workers[i], NULL);
+    return counter;
+}
+
+// trylock and timedlock on a held mutex, then a recursive mutex taken twice; 0 when all behave
+int check_lock_results(void) {
+    int failures = 0;
+    pthread_mutex_lock(&lockC);
+    failures += pthread_mutex_trylock(&lockC) != EBUSY;
+
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_nsec += 50000000;
+    if (deadline.tv_nsec >= 1000000000) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000;
+    }
+    failures += pthread_mutex_timedlock(&lockC, &deadline) != ETIMEDOUT;
+    pthread_mutex_unlock(&lockC);
+
+    pthread_mutex_t recursive;
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&recursive, &attr);
+    pthread_mutexattr_destroy(&attr);
+    failures += pthread_mutex_lock(&recursive) != 0;
+    failures += pthread_mutex_lock(&recursive) != 0;
+    failures += pthread_mutex_unlock(&recursive) != 0;
+    failures += pthread_mutex_unlock(&recursive) != 0;
+    failures += pthread_mutex_trylock(&recursive) != 0;
+    pthread_mutex_unlock(&recursive);
+    pthread_mutex_destroy(&recursive);
+    return failures;
+}
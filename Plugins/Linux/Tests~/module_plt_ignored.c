@@ -0,0 +1,9 @@
+/**
+ * Loaded by test_plt_hook after its path is put on the ignore list
+ */
+
+#include <string.h>
+
+size_t ignored_len(const char* text) {
+    return strlen(text);
+}
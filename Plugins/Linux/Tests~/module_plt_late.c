@@ -0,0 +1,9 @@
+/**
+ * Loaded by test_plt_hook after the hooks are installed
+ */
+
+#include <string.h>
+
+size_t late_len(const char* text) {
+    return strlen(text);
+}
@@ -0,0 +1,21 @@
+/**
+ * Loaded by test_plt_hook before the hooks are installed. Linked with
+ * -z relro -z now, so its import slots are in read-only RELRO.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+// Call through the PLT
+size_t target_len(const char* text) {
+    return strlen(text);
+}
+
+void* target_alloc(size_t size) {
+    return malloc(size);
+}
+
+// Address-taken import, bound through a GLOB_DAT slot
+size_t (*target_len_function(void))(const char*) {
+    return strlen;
+}
@@ -0,0 +1,46 @@
+// Recursion to a known depth that then faults, in a module of its own so the frames have symbols
+#include <stddef.h>
+
+static volatile int* volatile target = NULL;
+
+__attribute__((noinline)) int crash_at_depth(int depth) {
+    volatile char frame[64];
+    frame[0] = (char)depth;
+    if (depth == 0) {
+        *target = 42;
+        return frame[0];
+    }
+    return crash_at_depth(depth - 1) + frame[0];
+}
+
+int crash_through_hashed_path(int depth);
+
+__attribute__((noinline)) int hashed_step_left(int depth) {
+    volatile char frame[32];
+    frame[0] = (char)depth;
+    return crash_through_hashed_path(depth - 1) + frame[0];
+}
+
+__attribute__((noinline)) int hashed_step_right(int depth) {
+    volatile char frame[32];
+    frame[0] = (char)depth;
+    return crash_through_hashed_path(depth - 1) ^ frame[0];
+}
+
+// Recursion through two call sites picked by a hash of the depth, so the frames barely fold
+__attribute__((noinline)) int crash_through_hashed_path(int depth) {
+    if (depth == 0) {
+        *target = 42;
+        return 0;
+    }
+    if ((((unsigned)depth * 2654435761u) >> 13) & 1) {
+        return hashed_step_left(depth) + 1;
+    }
+    return hashed_step_right(depth) + 2;
+}
+
+// A call through a null function pointer: the fault pc is 0
+void call_null_function(void) {
+    void (*volatile function)(void) = NULL;
+    function();
+}
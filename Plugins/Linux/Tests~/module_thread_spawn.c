@@ -0,0 +1,6 @@
+// A plugin that starts its own threads, as Unity and native plugins do
+#include <pthread.h>
+
+int spawn_thread(pthread_t* thread, void* (*routine)(void*), void* argument) {
+    return pthread_create(thread, NULL, routine, argument);
+}
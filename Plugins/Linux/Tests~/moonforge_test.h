@@ -0,0 +1,53 @@
+/**
+ * MoonForge native plugin tests
+ *
+ * Each test_*.c is one executable, linked with the plugin sources and run
+ * from its build directory by `make test`; test_unit_*.c include the one
+ * source they test instead. Modules the tests load are built from
+ * module_*.c into libmodule_*.so next to them. A failed CHECK is
+ * reported and the test goes on; the exit status is 1 if any failed.
+ */
+
+#ifndef MOONFORGE_TEST_H
+#define MOONFORGE_TEST_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int testFailures = 0;
+
+#define CHECK(condition) do { \
+    if (!(condition)) { \
+        fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition); \
+        testFailures++; \
+    } \
+} while (0)
+
+#define CHECK_CONTAINS(text, part) do { \
+    const char* checkText = (text); \
+    if (checkText == NULL || strstr(checkText, (part)) == NULL) { \
+        fprintf(stderr, "%s:%d: CHECK failed: \"%s\" not in %.300s\n", __FILE__, __LINE__, (part), \
+                checkText ? checkText : "(null)"); \
+        testFailures++; \
+    } \
+} while (0)
+
+#define RUN_TEST(test) do { \
+    int failuresBefore = testFailures; \
+    test(); \
+    printf("%s %s\n", testFailures == failuresBefore ? "ok  " : "FAIL", #test); \
+} while (0)
+
+// For checks the machine can't support (no PMU, no qemu syscall); not a failure
+#define SKIP_TEST(reason) do { \
+    printf("skip %s: %s\n", __func__, (reason)); \
+    return; \
+} while (0)
+
+static inline int testResult(void) {
+    if (testFailures > 0) fprintf(stderr, "%d check(s) failed\n", testFailures);
+    return testFailures > 0 ? 1 : 0;
+}
+
+#endif // MOONFORGE_TEST_H
@@ -0,0 +1,133 @@
+/**
+ * Abort messages: an assert failing in a dlopen'd module reaches the crash
+ * record's abortMessage through the __assert_fail hook, also when the module
+ * is loaded after the crash handler and picked up by a refresh. A bare
+ * abort() leaves the field empty. Each crash runs in a child process.
+ */
+
+#define _GNU_SOURCE
+
+#include "moonforge_test.h"
+#include "moonforge_crash_handler.h"
+#include "moonforge_plt_hook.h"
+
+#include <dirent.h>
+#include <dlfcn.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define ASSERT_MESSAGE "module_assert.c:7: assert_positive: Assertion `value > 0' failed.\""
+
+static char crashDirectory[64];
+static char record[98304];
+
+// Reads the only record and deletes it
+static int takeRecord(void) {
+    record[0] = '\0';
+    DIR* directory = opendir(crashDirectory);
+    if (directory == NULL) return 0;
+
+    int found = 0;
+    struct dirent* entry;
+    while ((entry = readdir(directory)) != NULL) {
+        if (strncmp(entry->d_name, "crash_", 6) != 0) continue;
+
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s", crashDirectory, entry->d_name);
+        FILE* file = fopen(path, "r");
+        if (file != NULL) {
+            size_t length = fread(record, 1, sizeof(record) - 1, file);
+            record[length] = '\0';
+            fclose(file);
+            found = strstr(entry->d_name, ".json") != NULL;
+        }
+        unlink(path);
+    }
+    closedir(directory);
+    return found;
+}
+
+static void* loadModule(void) {
+    void* module = dlopen("./libmodule_assert.so", RTLD_NOW | RTLD_LOCAL);
+    if (module == NULL) {
+        fprintf(stderr, "dlopen: %s\n", dlerror());
+        _exit(1);
+    }
+    return module;
+}
+
+static void callInModule(void* module, const char* symbol) {
+    void (*assertPositive)(int) = (void (*)(int))dlsym(module, "assert_positive");
+    void (*abortWithoutMessage)(void) = (void (*)(void))dlsym(module, "abort_without_message");
+    if (strcmp(symbol, "assert_positive") == 0) {
+        assertPositive(0);
+    } else {
+        abortWithoutMessage();
+    }
+}
+
+/**
+ * Crash in a child: the module is loaded before the handler is installed,
+ * or after it and then found by MoonForge_PltHook_Refresh
+ */
+static int runChild(int loadFirst, const char* symbol) {
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0) {
+        // glibc prints the assertion itself; keep it out of the test output
+        freopen("/dev/null", "w", stderr);
+
+        void* module = loadFirst ? loadModule() : NULL;
+        MoonForge_SetCrashDirectory(crashDirectory);
+        MoonForge_InitializeCrashHandler(NULL);
+        if (!loadFirst) {
+            module = loadModule();
+            MoonForge_PltHook_Refresh();
+        }
+        callInModule(module, symbol);
+        _exit(0);
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return status;
+}
+
+static void test_assert_in_module_recorded(void) {
+    int status = runChild(1, "assert_positive");
+
+    CHECK(WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT);
+    CHECK(takeRecord());
+    CHECK_CONTAINS(record, "\"signalName\":\"SIGABRT\"");
+    CHECK_CONTAINS(record, "\"abortMessage\":\"");
+    CHECK_CONTAINS(record, ASSERT_MESSAGE);
+}
+
+static void test_module_loaded_later_hooked_on_refresh(void) {
+    int status = runChild(0, "assert_positive");
+
+    CHECK(WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT);
+    CHECK(takeRecord());
+    CHECK_CONTAINS(record, ASSERT_MESSAGE);
+}
+
+static void test_plain_abort_has_no_message(void) {
+    int status = runChild(1, "abort_without_message");
+
+    CHECK(WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT);
+    CHECK(takeRecord());
+    CHECK_CONTAINS(record, "\"abortMessage\":\"\",");
+}
+
+int main(void) {
+    strcpy(crashDirectory, "/tmp/moonforge_abort_XXXXXX");
+    if (mkdtemp(crashDirectory) == NULL) return 1;
+
+    RUN_TEST(test_assert_in_module_recorded);
+    RUN_TEST(test_module_loaded_later_hooked_on_refresh);
+    RUN_TEST(test_plain_abort_has_no_message);
+
+    rmdir(crashDirectory);
+    return testResult();
+}
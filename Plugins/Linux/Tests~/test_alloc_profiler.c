@@ -0,0 +1,141 @@
+/**
+ * Allocation profiler: Poisson sampling estimates allocated bytes within its
+ * statistical bounds, realloc and free take sampled blocks out of the live
+ * table again, and snapshots are cut cleanly at the buffer size. The
+ * profiled entry points are called directly; the hooks skip the executable
+ * the plugin is linked into.
+ */
+
+#define _GNU_SOURCE
+
+#include "moonforge_test.h"
+#include "moonforge_alloc_profiler.h"
+
+#include <stdint.h>
+
+#define SAMPLE_INTERVAL 4096
+#define SMALL_COUNT 200000
+#define SMALL_SIZE 64
+
+static void* blocks[SMALL_COUNT];
+static char snapshot[65536];
+static char cut[65536];
+
+static int64_t liveBytes(void) {
+    return MoonForge_AllocProfiler_GetSampledLiveBytes();
+}
+
+static void test_small_allocations_sampled_at_interval(void) {
+    int64_t before = liveBytes();
+    for (int i = 0; i < SMALL_COUNT; i++) {
+        blocks[i] = moonforge_profiled_malloc(SMALL_SIZE);
+    }
+
+    // ~3100 samples, so one standard deviation is under 2%
+    int64_t allocated = (int64_t)SMALL_COUNT * SMALL_SIZE;
+    int64_t estimated = liveBytes() - before;
+    CHECK(estimated > allocated * 85 / 100);
+    CHECK(estimated < allocated * 115 / 100);
+
+    for (int i = 0; i < SMALL_COUNT; i++) {
+        moonforge_profiled_free(blocks[i]);
+    }
+    CHECK(liveBytes() == before);
+}
+
+static void test_large_allocation_weighted_by_size(void) {
+    int64_t before = liveBytes();
+
+    // One block crossing ~256 intervals counts as that many samples
+    void* block = moonforge_profiled_calloc(256, SAMPLE_INTERVAL);
+    int64_t estimated = liveBytes() - before;
+    CHECK(estimated > 256 * SAMPLE_INTERVAL * 75 / 100);
+    CHECK(estimated < 256 * SAMPLE_INTERVAL * 125 / 100);
+
+    moonforge_profiled_free(block);
+    CHECK(liveBytes() == before);
+}
+
+static void test_realloc_moves_live_bytes(void) {
+    int64_t before = liveBytes();
+
+    char* block = moonforge_profiled_malloc(1024 * 1024);
+    CHECK(liveBytes() - before > 512 * 1024);
+
+    // The old block is forgotten and the new size counted in its place
+    block = moonforge_profiled_realloc(block, 2 * 1024 * 1024);
+    int64_t grown = liveBytes() - before;
+    CHECK(grown > 3 * 512 * 1024);
+    CHECK(grown < 5 * 512 * 1024);
+
+    // Too small to be sampled more than rarely, and once is one interval
+    block = moonforge_profiled_realloc(block, 16);
+    CHECK(liveBytes() - before <= SAMPLE_INTERVAL);
+
+    moonforge_profiled_free(block);
+    CHECK(liveBytes() == before);
+
+    // realloc of NULL allocates like malloc, and freeing NULL changes nothing
+    block = moonforge_profiled_realloc(NULL, 1024 * 1024);
+    CHECK(liveBytes() - before > 512 * 1024);
+    moonforge_profiled_free(block);
+    moonforge_profiled_free(NULL);
+    CHECK(liveBytes() == before);
+}
+
+static void test_snapshot_cut_at_buffer_size(void) {
+    void* held = moonforge_profiled_malloc(1024 * 1024);
+
+    int length = MoonForge_AllocProfiler_Snapshot(snapshot, sizeof(snapshot), 8);
+    CHECK(length > 0 && length == (int)strlen(snapshot));
+    CHECK_CONTAINS(snapshot, "Sampled live native memory: ");
+    CHECK_CONTAINS(snapshot, "(interval 4096 bytes)");
+    CHECK_CONTAINS(snapshot, "Site 1: ");
+    CHECK_CONTAINS(snapshot, "  #00 ");
+
+    // Cut inside the header, inside the first site's frames, and one short of the end
+    int sizes[] = { 1, 16, (int)(strstr(snapshot, "  #00 ") - snapshot) + 4, length };
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        int size = sizes[i];
+        memset(cut, 'x', sizeof(cut));
+        int written = MoonForge_AllocProfiler_Snapshot(cut, size, 8);
+
+        CHECK(written == size - 1);
+        CHECK(cut[size - 1] == '\0');
+        CHECK(cut[size] == 'x');
+        CHECK(strncmp(cut, snapshot, (size_t)written) == 0);
+    }
+
+    CHECK(MoonForge_AllocProfiler_Snapshot(cut, 0, 8) == 0);
+    CHECK(MoonForge_AllocProfiler_Snapshot(NULL, 64, 8) == 0);
+
+    moonforge_profiled_free(held);
+}
+
+static void test_frees_tracked_after_stop(void) {
+    int64_t before = liveBytes();
+    void* block = moonforge_profiled_malloc(1024 * 1024);
+    CHECK(liveBytes() > before);
+
+    MoonForge_AllocProfiler_Stop();
+    CHECK(!MoonForge_AllocProfiler_IsRunning());
+
+    // Nothing new is sampled, but the block still leaves the live total
+    void* unsampled = moonforge_profiled_malloc(1024 * 1024);
+    moonforge_profiled_free(block);
+    CHECK(liveBytes() == before);
+    moonforge_profiled_free(unsampled);
+}
+
+int main(void) {
+    if (!MoonForge_AllocProfiler_Start(SAMPLE_INTERVAL)) return 1;
+    CHECK(MoonForge_AllocProfiler_IsRunning());
+
+    RUN_TEST(test_small_allocations_sampled_at_interval);
+    RUN_TEST(test_large_allocation_weighted_by_size);
+    RUN_TEST(test_realloc_moves_live_bytes);
+    RUN_TEST(test_snapshot_cut_at_buffer_size);
+    RUN_TEST(test_frees_tracked_after_stop);
+
+    return testResult();
+}
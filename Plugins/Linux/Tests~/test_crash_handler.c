@@ -0,0 +1,238 @@
+/**
+ * Crash handler on Linux: faults in native code are recorded before the
+ * previously installed handler runs, so the record keeps the original
+ * signal when that handler exits or aborts, and is discarded when it
+ * recovers. Faults in JIT code go to the previous handler first.
+ */
+
+#define _GNU_SOURCE
+
+#include "moonforge_test.h"
+#include "moonforge_crash_handler.h"
+
+#include <dirent.h>
+#include <signal.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+static char crashDirectory[64];
+static char record[98304];
+
+static void* guardPage;
+static volatile sig_atomic_t recordSeenByPrevious;
+
+enum PreviousHandler { PREVIOUS_NONE, PREVIOUS_EXIT, PREVIOUS_ABORT, PREVIOUS_RECOVER };
+static enum PreviousHandler previousKind;
+
+static int countRecords(void) {
+    DIR* directory = opendir(crashDirectory);
+    if (directory == NULL) return 0;
+
+    int count = 0;
+    struct dirent* entry;
+    while ((entry = readdir(directory)) != NULL) {
+        if (strncmp(entry->d_name, "crash_", 6) == 0) count++;
+    }
+    closedir(directory);
+    return count;
+}
+
+// Reads the only record and deletes it
+static int takeRecord(void) {
+    record[0] = '\0';
+    DIR* directory = opendir(crashDirectory);
+    if (directory == NULL) return 0;
+
+    int found = 0;
+    struct dirent* entry;
+    while ((entry = readdir(directory)) != NULL) {
+        if (strncmp(entry->d_name, "crash_", 6) != 0) continue;
+
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s", crashDirectory, entry->d_name);
+        FILE* file = fopen(path, "r");
+        if (file != NULL) {
+            size_t length = fread(record, 1, sizeof(record) - 1, file);
+            record[length] = '\0';
+            fclose(file);
+            found = strstr(entry->d_name, ".json") != NULL;
+        }
+        unlink(path);
+    }
+    closedir(directory);
+    return found;
+}
+
+static void previousHandler(int sig, siginfo_t* info, void* context) {
+    (void)sig;
+    (void)context;
+    recordSeenByPrevious = countRecords() > 0;
+
+    switch (previousKind) {
+        case PREVIOUS_EXIT:
+            // What Unity's crash reporter does once it has written its own report
+            _exit(recordSeenByPrevious ? 3 : 4);
+        case PREVIOUS_ABORT:
+            abort();
+        case PREVIOUS_RECOVER:
+            // What Mono does for a NullReferenceException: fix things up and return
+            if (info->si_addr == guardPage) {
+                mprotect(guardPage, (size_t)sysconf(_SC_PAGESIZE), PROT_READ | PROT_WRITE);
+                return;
+            }
+            _exit(5);
+        default:
+            _exit(6);
+    }
+}
+
+static void installHandlers(enum PreviousHandler kind) {
+    previousKind = kind;
+    if (kind != PREVIOUS_NONE) {
+        struct sigaction action;
+        memset(&action, 0, sizeof(action));
+        action.sa_sigaction = previousHandler;
+        action.sa_flags = SA_SIGINFO;
+        sigaction(SIGSEGV, &action, NULL);
+    }
+
+    MoonForge_SetCrashDirectory(crashDirectory);
+    MoonForge_InitializeCrashHandler(NULL);
+}
+
+__attribute__((noinline)) static void writeThrough(volatile char* pointer) {
+    *pointer = 42;
+}
+
+// Runs body in a child process and returns its wait status
+static int runChild(void (*body)(void)) {
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0) {
+        body();
+        _exit(0);
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return status;
+}
+
+static void nullWriteWithExitingHandler(void) {
+    installHandlers(PREVIOUS_EXIT);
+    writeThrough(NULL);
+}
+
+static void test_record_survives_exit_in_previous_handler(void) {
+    int status = runChild(nullWriteWithExitingHandler);
+
+    // The record was on disk before the previous handler ran
+    CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 3);
+    CHECK(takeRecord());
+    CHECK_CONTAINS(record, "\"signalName\":\"SIGSEGV\"");
+    CHECK_CONTAINS(record, "\"siCode\":1,");
+    CHECK_CONTAINS(record, "\"faultAddress\":\"(nil)\"");
+    CHECK_CONTAINS(record, "\"fault\":{\"pc\":");
+}
+
+static void nullWriteWithAbortingHandler(void) {
+    installHandlers(PREVIOUS_ABORT);
+    writeThrough(NULL);
+}
+
+static void test_abort_in_previous_handler_keeps_original_signal(void) {
+    int status = runChild(nullWriteWithAbortingHandler);
+
+    CHECK(WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT);
+    CHECK(countRecords() == 1);
+    CHECK(takeRecord());
+    CHECK_CONTAINS(record, "\"signalName\":\"SIGSEGV\"");
+}
+
+static void recoveredNativeFault(void) {
+    installHandlers(PREVIOUS_RECOVER);
+    writeThrough(guardPage);
+    _exit(recordSeenByPrevious && countRecords() == 0 ? 0 : 7);
+}
+
+static void test_record_discarded_when_previous_handler_recovers(void) {
+    int status = runChild(recoveredNativeFault);
+
+    // Recorded first, then deleted once the previous handler returned
+    CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    CHECK(countRecords() == 0);
+    takeRecord();
+}
+
+typedef void (*JitStore)(volatile char* pointer);
+
+// A store and return, written into anonymous executable memory like a JIT would
+static JitStore emitJitStore(void) {
+#if defined(__x86_64__)
+    static const unsigned char code[] = { 0xc6, 0x07, 0x2a, 0xc3 };   // movb $42, (%rdi); ret
+#elif defined(__aarch64__)
+    static const uint32_t code[] = { 0x52800541, 0x39000001, 0xd65f03c0 };   // mov w1, #42; strb w1, [x0]; ret
+#elif defined(__arm__) && !defined(__thumb__)
+    static const uint32_t code[] = { 0xe3a0102a, 0xe5c01000, 0xe12fff1e };   // mov r1, #42; strb r1, [r0]; bx lr
+#else
+    static const unsigned char code[] = { 0 };
+    return NULL;
+#endif
+    void* memory = mmap(NULL, (size_t)sysconf(_SC_PAGESIZE), PROT_READ | PROT_WRITE | PROT_EXEC,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) return NULL;
+    memcpy(memory, code, sizeof(code));
+    __builtin___clear_cache((char*)memory, (char*)memory + sizeof(code));
+    return (JitStore)memory;
+}
+
+static void recoveredJitFault(void) {
+    JitStore store = emitJitStore();
+    if (store == NULL) _exit(77);
+
+    installHandlers(PREVIOUS_RECOVER);
+    store(guardPage);
+    _exit(!recordSeenByPrevious && countRecords() == 0 ? 0 : 7);
+}
+
+static void test_jit_fault_goes_to_previous_handler_first(void) {
+    int status = runChild(recoveredJitFault);
+    if (WIFEXITED(status) && WEXITSTATUS(status) == 77) SKIP_TEST("no JIT stub for this architecture");
+
+    // Nothing was recorded, before or after
+    CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    CHECK(countRecords() == 0);
+    takeRecord();
+}
+
+static void nullWriteWithoutPreviousHandler(void) {
+    installHandlers(PREVIOUS_NONE);
+    writeThrough(NULL);
+}
+
+static void test_fault_without_previous_handler(void) {
+    int status = runChild(nullWriteWithoutPreviousHandler);
+
+    CHECK(WIFSIGNALED(status) && WTERMSIG(status) == SIGSEGV);
+    CHECK(takeRecord());
+    CHECK_CONTAINS(record, "\"signalName\":\"SIGSEGV\"");
+}
+
+int main(void) {
+    strcpy(crashDirectory, "/tmp/moonforge_crash_XXXXXX");
+    if (mkdtemp(crashDirectory) == NULL) return 1;
+
+    guardPage = mmap(NULL, (size_t)sysconf(_SC_PAGESIZE), PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (guardPage == MAP_FAILED) return 1;
+
+    RUN_TEST(test_record_survives_exit_in_previous_handler);
+    RUN_TEST(test_abort_in_previous_handler_keeps_original_signal);
+    RUN_TEST(test_record_discarded_when_previous_handler_recovers);
+    RUN_TEST(test_jit_fault_goes_to_previous_handler_first);
+    RUN_TEST(test_fault_without_previous_handler);
+
+    rmdir(crashDirectory);
+    return testResult();
+}
@@ -0,0 +1,246 @@
+/**
+ * Fault context: the crash record's "fault" section carries pc, sp, the
+ * bounds of the stack mapping and the /proc/self/maps lines around the
+ * fault address, sp and pc, enough for FaultClassifier to tell a stack
+ * overflow from a jump into data or a use after unmap. Crashes run in
+ * child processes.
+ */
+
+#define _GNU_SOURCE
+
+#include "moonforge_test.h"
+#include "moonforge_crash_handler.h"
+#include "moonforge_fault_context.h"
+
+#include <dirent.h>
+#include <inttypes.h>
+#include <signal.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+static char crashDirectory[64];
+static char record[98304];
+static char context[16384];
+static size_t pageSize;
+
+// Reads the only record and deletes it
+static int takeRecord(void) {
+    record[0] = '\0';
+    DIR* directory = opendir(crashDirectory);
+    if (directory == NULL) return 0;
+
+    int found = 0;
+    struct dirent* entry;
+    while ((entry = readdir(directory)) != NULL) {
+        if (strncmp(entry->d_name, "crash_", 6) != 0) continue;
+
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s", crashDirectory, entry->d_name);
+        FILE* file = fopen(path, "r");
+        if (file != NULL) {
+            size_t length = fread(record, 1, sizeof(record) - 1, file);
+            record[length] = '\0';
+            fclose(file);
+            found = strstr(entry->d_name, ".json") != NULL;
+        }
+        unlink(path);
+    }
+    closedir(directory);
+    return found;
+}
+
+// Runs body with the crash handler installed in a child process; returns its wait status
+static int runCrash(void (*body)(void)) {
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0) {
+        MoonForge_SetCrashDirectory(crashDirectory);
+        MoonForge_InitializeCrashHandler(NULL);
+        body();
+        _exit(0);
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return status;
+}
+
+// An address field of json, 0 if absent; "(nil)" reads as 0 too
+static uintptr_t addressField(const char* json, const char* name) {
+    char key[64];
+    snprintf(key, sizeof(key), "\"%s\":\"", name);
+    const char* field = strstr(json, key);
+    return field != NULL ? (uintptr_t)strtoull(field + strlen(key), NULL, 16) : 0;
+}
+
+// The maps entry containing address, or NULL
+static const char* mappingAt(const char* json, uintptr_t address) {
+    const char* entry = strstr(json, "\"maps\":[");
+    while (entry != NULL && (entry = strstr(entry, "{\"start\":\"")) != NULL) {
+        if (address >= addressField(entry, "start") && address < addressField(entry, "end")) return entry;
+        entry++;
+    }
+    return NULL;
+}
+
+static int hasPerms(const char* entry, const char* perms) {
+    char key[32];
+    snprintf(key, sizeof(key), "\"perms\":\"%s\"", perms);
+    const char* field = entry != NULL ? strstr(entry, "\"perms\":") : NULL;
+    return field != NULL && strncmp(field, key, strlen(key)) == 0;
+}
+
+// Three pages; the middle one is given protection, or unmapped if protection is -1
+static char* mapThreePages(int protection) {
+    char* pages = mmap(NULL, 3 * pageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (pages == MAP_FAILED) return NULL;
+
+    if (protection < 0) {
+        munmap(pages + pageSize, pageSize);
+    } else {
+        mprotect(pages + pageSize, pageSize, protection);
+    }
+    return pages;
+}
+
+static void test_maps_around_protected_page(void) {
+    char* pages = mapThreePages(PROT_NONE);
+    CHECK(pages != NULL);
+    if (pages == NULL) return;
+
+    size_t length = moonforge_fault_context_write_json(context, sizeof(context), NULL, pages + pageSize + 100);
+    CHECK(length > 0 && length == strlen(context));
+    CHECK(strncmp(context, "{\"pc\":\"0x0\",\"sp\":\"0x0\",\"maps\":[", 31) == 0);
+    CHECK(strcmp(context + length - 2, "]}") == 0);
+
+    // The mapping holding the address, the one below and the one above
+    CHECK(hasPerms(mappingAt(context, (uintptr_t)(pages + pageSize)), "---p"));
+    CHECK(hasPerms(mappingAt(context, (uintptr_t)pages), "rw-p"));
+    CHECK(hasPerms(mappingAt(context, (uintptr_t)(pages + 2 * pageSize)), "rw-p"));
+    munmap(pages, 3 * pageSize);
+}
+
+static void test_unmapped_address_has_neighbours_only(void) {
+    char* pages = mapThreePages(-1);
+    CHECK(pages != NULL);
+    if (pages == NULL) return;
+
+    moonforge_fault_context_write_json(context, sizeof(context), NULL, pages + pageSize + 100);
+    CHECK(mappingAt(context, (uintptr_t)(pages + pageSize + 100)) == NULL);
+    CHECK(mappingAt(context, (uintptr_t)pages) != NULL);
+    CHECK(mappingAt(context, (uintptr_t)(pages + 2 * pageSize)) != NULL);
+    munmap(pages, pageSize);
+    munmap(pages + 2 * pageSize, pageSize);
+}
+
+static void test_small_buffer_stays_valid(void) {
+    CHECK(moonforge_fault_context_write_json(context, 2, NULL, NULL) == 0);
+
+    memset(context, 'x', 16);
+    CHECK(moonforge_fault_context_write_json(context, 16, NULL, NULL) == 0);
+    CHECK(context[0] == '\0');
+
+    // Mappings that don't fit are left out, and the object is still closed
+    size_t length = moonforge_fault_context_write_json(context, 200, NULL, (void*)test_small_buffer_stays_valid);
+    CHECK(length > 0 && length < 200 && length == strlen(context));
+    CHECK(strcmp(context + length - 2, "]}") == 0);
+}
+
+__attribute__((noinline)) static void writeThrough(volatile char* pointer) {
+    *pointer = 42;
+}
+
+static void writeNull(void) {
+    writeThrough(NULL);
+}
+
+static void test_crash_record_has_registers_and_stack(void) {
+    int status = runCrash(writeNull);
+    CHECK(WIFSIGNALED(status) && WTERMSIG(status) == SIGSEGV);
+    CHECK(takeRecord());
+
+    const char* fault = strstr(record, "\"fault\":{");
+    CHECK(fault != NULL);
+    if (fault == NULL) return;
+
+    uintptr_t pc = addressField(fault, "pc");
+    uintptr_t sp = addressField(fault, "sp");
+    uintptr_t stackStart = addressField(fault, "stackStart");
+    uintptr_t stackEnd = addressField(fault, "stackEnd");
+    CHECK(hasPerms(mappingAt(fault, pc), "r-xp"));
+    CHECK(sp >= stackStart && sp < stackEnd);
+    CHECK(hasPerms(mappingAt(fault, sp), "rw-p"));
+}
+
+static char* dataPage;
+
+static void jumpIntoData(void) {
+    void (*function)(void) = (void (*)(void))dataPage;
+    function();
+}
+
+static void test_jump_into_data_faults_at_pc(void) {
+    dataPage = mmap(NULL, pageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    CHECK(dataPage != MAP_FAILED);
+
+    int status = runCrash(jumpIntoData);
+    CHECK(WIFSIGNALED(status) && WTERMSIG(status) == SIGSEGV);
+    CHECK(takeRecord());
+
+    const char* fault = strstr(record, "\"fault\":{");
+    CHECK(fault != NULL);
+    if (fault == NULL) return;
+
+    CHECK(addressField(fault, "pc") == (uintptr_t)dataPage);
+    CHECK(addressField(record, "faultAddress") == (uintptr_t)dataPage);
+    CHECK(hasPerms(mappingAt(fault, (uintptr_t)dataPage), "rw-p"));
+    munmap(dataPage, pageSize);
+}
+
+// Never reached; keeps the compiler from treating the recursion as infinite
+static volatile int recursionLimit = -1;
+
+__attribute__((noinline)) static int recurse(int depth) {
+    if (depth == recursionLimit) return 0;
+    volatile char frame[512];
+    frame[0] = (char)depth;
+    return recurse(depth + 1) + frame[0];
+}
+
+static void overflowStack(void) {
+    recurse(0);
+}
+
+static void test_stack_overflow_faults_next_to_sp(void) {
+    int status = runCrash(overflowStack);
+    CHECK(WIFSIGNALED(status) && WTERMSIG(status) == SIGSEGV);
+    CHECK(takeRecord());
+
+    const char* fault = strstr(record, "\"fault\":{");
+    CHECK(fault != NULL);
+    if (fault == NULL) return;
+
+    // Below the last frame, in no mapping; sp is already past the stack's mapping
+    uintptr_t address = addressField(record, "faultAddress");
+    uintptr_t sp = addressField(fault, "sp");
+    CHECK(sp != 0 && address + 0x10000 >= sp && address <= sp + 0x10000);
+    CHECK(mappingAt(fault, address) == NULL);
+}
+
+int main(void) {
+    pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    strcpy(crashDirectory, "/tmp/moonforge_fault_XXXXXX");
+    if (mkdtemp(crashDirectory) == NULL) return 1;
+
+    RUN_TEST(test_maps_around_protected_page);
+    RUN_TEST(test_unmapped_address_has_neighbours_only);
+    RUN_TEST(test_small_buffer_stays_valid);
+    RUN_TEST(test_crash_record_has_registers_and_stack);
+    RUN_TEST(test_jump_into_data_faults_at_pc);
+    RUN_TEST(test_stack_overflow_faults_next_to_sp);
+
+    rmdir(crashDirectory);
+    return testResult();
+}
@@ -0,0 +1,320 @@
+/**
+ * Hitch recorder: frames over the threshold are recorded with the CPU
+ * time, faults and context switches of that frame, and perf counters when
+ * the kernel allows them; shorter frames and the gap after a reset are
+ * not. Drains move hitches out oldest first, leaving what does not fit for
+ * the next one, and a full ring drops new hitches. With I/O tracking,
+ * storage reads by any thread and the main thread's own major faults are
+ * attributed to the frame, with the scene and activity of the time.
+ */
+
+#define _GNU_SOURCE
+
+#include "moonforge_test.h"
+#include "moonforge_hitch_recorder.h"
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+// In the build directory: /tmp may be tmpfs, which never reads from storage
+#define IO_FILE "hitch_io.bin"
+#define IO_FILE_SIZE (16 << 20)
+#define IO_BLOCK_SIZE (1 << 20)
+
+static char drained[65536];
+
+static void spin(int ms) {
+    struct timespec start, now;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    do {
+        clock_gettime(CLOCK_MONOTONIC, &now);
+    } while ((now.tv_sec - start.tv_sec) * 1000000000LL + (now.tv_nsec - start.tv_nsec) < ms * 1000000LL);
+}
+
+static int countHitches(const char* json) {
+    int count = 0;
+    for (const char* p = json; (p = strstr(p, "{\"timestamp\":")) != NULL; p++) count++;
+    return count;
+}
+
+// A numeric field of the index-th hitch in json, or -2 if it is missing
+static double hitchField(const char* json, int index, const char* name) {
+    const char* hitch = json;
+    for (int i = 0; i <= index; i++) {
+        hitch = strstr(i == 0 ? hitch : hitch + 1, "{\"timestamp\":");
+        if (hitch == NULL) return -2;
+    }
+
+    char key[64];
+    snprintf(key, sizeof(key), "\"%s\":", name);
+    const char* end = strchr(hitch, '}');
+    const char* field = strstr(hitch, key);
+    if (field == NULL || (end != NULL && field > end)) return -2;
+    return strtod(field + strlen(key), NULL);
+}
+
+static void test_short_frames_not_recorded(void) {
+    CHECK(MoonForge_Hitch_Start(50, 0, 0) & MOONFORGE_HITCH_COUNTERS_RUSAGE);
+    for (int frame = 0; frame < 10; frame++) {
+        MoonForge_Hitch_FrameBoundary();
+        usleep(5000);
+    }
+    MoonForge_Hitch_FrameBoundary();
+
+    CHECK(MoonForge_Hitch_Drain(drained, sizeof(drained)) == 0);
+    CHECK(drained[0] == '\0');
+    MoonForge_Hitch_Stop();
+}
+
+static void test_hitch_counters_are_frame_deltas(void) {
+    MoonForge_Hitch_Start(50, 0, 0);
+    MoonForge_Hitch_FrameBoundary();
+
+    // Busy: CPU time close to the frame time
+    spin(80);
+    MoonForge_Hitch_FrameBoundary();
+
+    // Blocked: little CPU, at least one context switch
+    usleep(90000);
+    MoonForge_Hitch_FrameBoundary();
+
+    // Touching fresh memory: minor faults
+    size_t size = 16 << 20;
+    volatile char* memory = malloc(size);
+    for (size_t i = 0; i < size; i += 4096) memory[i] = 1;
+    usleep(50000);
+    MoonForge_Hitch_FrameBoundary();
+    free((void*)memory);
+
+    CHECK(MoonForge_Hitch_Drain(drained, sizeof(drained)) > 0);
+    CHECK(countHitches(drained) == 3);
+
+    CHECK(hitchField(drained, 0, "durationMs") >= 80);
+    CHECK(hitchField(drained, 0, "cpuTimeMs") >= 40);
+
+    CHECK(hitchField(drained, 1, "durationMs") >= 90);
+    CHECK(hitchField(drained, 1, "cpuTimeMs") < 30);
+    CHECK(hitchField(drained, 1, "contextSwitches") >= 1);
+
+    CHECK(hitchField(drained, 2, "minorFaults") >= 1000);
+
+    // Not asked for
+    CHECK(hitchField(drained, 0, "cycles") == -1);
+    CHECK(hitchField(drained, 0, "readBytes") == -1);
+
+    // Drained hitches are gone
+    CHECK(MoonForge_Hitch_Drain(drained, sizeof(drained)) == 0);
+    MoonForge_Hitch_Stop();
+}
+
+static void test_perf_counters_when_permitted(void) {
+    int counters = MoonForge_Hitch_Start(50, 1, 0);
+    MoonForge_Hitch_FrameBoundary();
+    spin(60);
+    MoonForge_Hitch_FrameBoundary();
+
+    CHECK(MoonForge_Hitch_Drain(drained, sizeof(drained)) > 0);
+    MoonForge_Hitch_Stop();
+    if (!(counters & MOONFORGE_HITCH_COUNTERS_PERF)) {
+        // Refused counters leave the rest of the hitch intact
+        CHECK(hitchField(drained, 0, "cycles") == -1);
+        CHECK(hitchField(drained, 0, "cpuTimeMs") >= 40);
+        SKIP_TEST("perf events not permitted or no PMU");
+    }
+
+    CHECK(hitchField(drained, 0, "cycles") > 1000000);
+    CHECK(hitchField(drained, 0, "instructions") > 1000000);
+}
+
+static void test_reset_skips_the_gap(void) {
+    MoonForge_Hitch_Start(50, 0, 0);
+    MoonForge_Hitch_FrameBoundary();
+
+    // Paused: the next boundary only sets the baseline
+    MoonForge_Hitch_Reset();
+    usleep(100000);
+    MoonForge_Hitch_FrameBoundary();
+    MoonForge_Hitch_FrameBoundary();
+
+    CHECK(MoonForge_Hitch_Drain(drained, sizeof(drained)) == 0);
+    MoonForge_Hitch_Stop();
+}
+
+static void test_small_buffer_leaves_rest_for_next_drain(void) {
+    MoonForge_Hitch_Start(1, 0, 0);
+    MoonForge_Hitch_FrameBoundary();
+    for (int frame = 0; frame < 10; frame++) {
+        usleep(2000);
+        MoonForge_Hitch_FrameBoundary();
+    }
+
+    char small[600];
+    int length = MoonForge_Hitch_Drain(small, sizeof(small));
+    CHECK(length > 0 && length < (int)sizeof(small));
+    CHECK(small[0] == '[' && small[length - 1] == ']');
+    int first = countHitches(small);
+    CHECK(first >= 1 && first < 10);
+
+    CHECK(MoonForge_Hitch_Drain(drained, sizeof(drained)) > 0);
+    CHECK(first + countHitches(drained) == 10);
+
+    // Too small for even one: nothing is lost
+    MoonForge_Hitch_FrameBoundary();
+    usleep(2000);
+    MoonForge_Hitch_FrameBoundary();
+    CHECK(MoonForge_Hitch_Drain(small, 64) == 0);
+    CHECK(MoonForge_Hitch_Drain(drained, sizeof(drained)) > 0);
+    CHECK(countHitches(drained) == 1);
+    MoonForge_Hitch_Stop();
+}
+
+static void test_full_ring_drops_new_hitches(void) {
+    MoonForge_Hitch_Start(1, 0, 0);
+    MoonForge_Hitch_FrameBoundary();
+    for (int frame = 0; frame < 40; frame++) {
+        usleep(2000);
+        MoonForge_Hitch_FrameBoundary();
+    }
+
+    CHECK(MoonForge_Hitch_Drain(drained, sizeof(drained)) > 0);
+    CHECK(countHitches(drained) == 32);
+    MoonForge_Hitch_Stop();
+}
+
+// A file on storage with none of its pages cached, or -1
+static int openColdFile(void) {
+    int fd = open(IO_FILE, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) return -1;
+    unlink(IO_FILE);
+
+    char* block = malloc(IO_BLOCK_SIZE);
+    memset(block, 7, IO_BLOCK_SIZE);
+    int written = 1;
+    for (int i = 0; i < IO_FILE_SIZE / IO_BLOCK_SIZE; i++) {
+        written &= write(fd, block, IO_BLOCK_SIZE) == IO_BLOCK_SIZE;
+    }
+    free(block);
+    fsync(fd);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+
+    // Evicted only if the file system honoured the advice
+    size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    unsigned char* resident = malloc(IO_FILE_SIZE / pageSize);
+    void* mapping = mmap(NULL, IO_FILE_SIZE, PROT_READ, MAP_SHARED, fd, 0);
+    int cold = written && mapping != MAP_FAILED && mincore(mapping, IO_FILE_SIZE, resident) == 0;
+    for (size_t i = 0; cold && i < IO_FILE_SIZE / pageSize; i++) cold = !(resident[i] & 1);
+    if (mapping != MAP_FAILED) munmap(mapping, IO_FILE_SIZE);
+    free(resident);
+
+    if (!cold) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static void* loadFile(void* data) {
+    int fd = *(int*)data;
+    char* block = malloc(IO_BLOCK_SIZE);
+    for (off_t offset = 0; offset < IO_FILE_SIZE; offset += IO_BLOCK_SIZE) {
+        if (pread(fd, block, IO_BLOCK_SIZE, offset) != IO_BLOCK_SIZE) break;
+    }
+    free(block);
+    return NULL;
+}
+
+static void test_io_totals(void) {
+    long long totals[4] = { -1, -1, -1, -1 };
+    CHECK(MoonForge_Hitch_GetIoTotals(totals, 4) == 0);
+
+    int counters = MoonForge_Hitch_Start(30, 0, 1);
+    if (!(counters & MOONFORGE_HITCH_COUNTERS_IO)) {
+        MoonForge_Hitch_Stop();
+        SKIP_TEST("/proc/self/io not readable");
+    }
+
+    CHECK(MoonForge_Hitch_GetIoTotals(totals, 3) == 0);
+    CHECK(MoonForge_Hitch_GetIoTotals(totals, 4) == 4);
+    for (int i = 0; i < 4; i++) CHECK(totals[i] >= 0);
+    MoonForge_Hitch_Stop();
+}
+
+static void test_loader_thread_reads_attributed(void) {
+    int counters = MoonForge_Hitch_Start(30, 0, 1);
+    int fd = openColdFile();
+    if (!(counters & MOONFORGE_HITCH_COUNTERS_IO) || fd < 0) {
+        if (fd >= 0) close(fd);
+        MoonForge_Hitch_Stop();
+        SKIP_TEST("no I/O counters or no storage-backed file");
+    }
+
+    // Names go into JSON as they are, so quotes are replaced
+    MoonForge_Hitch_SetContext("Forest", "3-2", "bundle:\"forest\"");
+    MoonForge_Hitch_FrameBoundary();
+
+    // The main thread waits on a loader thread that reads the file
+    pthread_t loader;
+    pthread_create(&loader, NULL, loadFile, &fd);
+    pthread_join(loader, NULL);
+    usleep(30000);
+    MoonForge_Hitch_FrameBoundary();
+    MoonForge_Hitch_SetContext(NULL, NULL, NULL);
+
+    CHECK(MoonForge_Hitch_Drain(drained, sizeof(drained)) > 0);
+    CHECK(countHitches(drained) == 1);
+    CHECK(hitchField(drained, 0, "readBytes") >= IO_FILE_SIZE);
+    CHECK(hitchField(drained, 0, "writeBytes") >= 0);
+    CHECK(hitchField(drained, 0, "processMajorFaults") >= 0);
+    CHECK(hitchField(drained, 0, "ioWaitMs") >= 0);
+    // Not the main thread's faults
+    CHECK(hitchField(drained, 0, "majorFaults") == 0);
+    CHECK_CONTAINS(drained, "\"scene\":\"Forest\",\"level\":\"3-2\",\"activity\":\"bundle:_forest_\"");
+
+    close(fd);
+    MoonForge_Hitch_Stop();
+}
+
+static void test_main_thread_faults_attributed(void) {
+    int counters = MoonForge_Hitch_Start(30, 0, 1);
+    int fd = openColdFile();
+    if (!(counters & MOONFORGE_HITCH_COUNTERS_IO) || fd < 0) {
+        if (fd >= 0) close(fd);
+        MoonForge_Hitch_Stop();
+        SKIP_TEST("no I/O counters or no storage-backed file");
+    }
+
+    // Reading a mapped file: the main thread faults each page in itself
+    volatile const char* mapping = mmap(NULL, IO_FILE_SIZE, PROT_READ, MAP_PRIVATE, fd, 0);
+    CHECK(mapping != MAP_FAILED);
+    MoonForge_Hitch_FrameBoundary();
+    long sum = 0;
+    for (long i = 0; mapping != MAP_FAILED && i < IO_FILE_SIZE; i += 4096) sum += mapping[i];
+    usleep(30000);
+    MoonForge_Hitch_FrameBoundary();
+    CHECK(sum > 0);
+
+    CHECK(MoonForge_Hitch_Drain(drained, sizeof(drained)) > 0);
+    CHECK(hitchField(drained, 0, "majorFaults") > 0);
+    CHECK(hitchField(drained, 0, "processMajorFaults") >= hitchField(drained, 0, "majorFaults"));
+    CHECK(hitchField(drained, 0, "readBytes") > 0);
+
+    if (mapping != MAP_FAILED) munmap((void*)mapping, IO_FILE_SIZE);
+    close(fd);
+    MoonForge_Hitch_Stop();
+}
+
+int main(void) {
+    RUN_TEST(test_short_frames_not_recorded);
+    RUN_TEST(test_hitch_counters_are_frame_deltas);
+    RUN_TEST(test_perf_counters_when_permitted);
+    RUN_TEST(test_reset_skips_the_gap);
+    RUN_TEST(test_small_buffer_leaves_rest_for_next_drain);
+    RUN_TEST(test_full_ring_drops_new_hitches);
+    RUN_TEST(test_io_totals);
+    RUN_TEST(test_loader_thread_reads_attributed);
+    RUN_TEST(test_main_thread_faults_attributed);
+    return testResult();
+}
@@ -0,0 +1,234 @@
+/**
+ * Lock monitor: deadlocks between workers or with the main thread, and the
+ * main thread stuck on a lock or a condition, are reported once with the
+ * wait chain and the stacks it waits at; short waits are not. Locking
+ * behaves as before with the hooks in. The locks are taken in
+ * libmodule_lock_game.so, since the hooks skip the module the plugin is
+ * linked into, here the executable. Each
+ * scenario runs in a child process, as its threads never finish.
+ */
+
+#define _GNU_SOURCE
+
+#include "moonforge_test.h"
+#include "moonforge_lock_monitor.h"
+
+#include <dlfcn.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define HANG_MS 500
+#define CHECK_PERIOD_MS 50
+#define GIVE_UP_MS 5000
+
+typedef void* (*ThreadFunction)(void*);
+
+static void* game;
+static ThreadFunction renderThread;
+static ThreadFunction audioThread;
+static ThreadFunction loaderThread;
+static ThreadFunction briefThread;
+static void (*waitForA)(void);
+static void (*waitForCondition)(void);
+static void (*takeABriefly)(int);
+static void (*contendAAndB)(void);
+static long (*countWithThreads)(int, int);
+static int (*checkLockResults)(void);
+
+static char report[65536];
+static int reportPipe[2];
+static atomic_int bodyDone;
+
+static void sleepMs(int ms) {
+    usleep((useconds_t)ms * 1000);
+}
+
+// Polls for a report and sends it, then whether a second check reports the same wait again
+static void* checker(void* argument) {
+    (void)argument;
+    for (int waited = 0; waited < GIVE_UP_MS; waited += CHECK_PERIOD_MS) {
+        sleepMs(CHECK_PERIOD_MS);
+        int done = atomic_load(&bodyDone);
+
+        int length = MoonForge_LockMonitor_Check(HANG_MS, report, sizeof(report));
+        if (length > 0) {
+            sleepMs(2 * HANG_MS);
+            int again = MoonForge_LockMonitor_Check(HANG_MS, report + length + 1, (int)sizeof(report) - length - 1);
+            if (write(reportPipe[1], report, (size_t)length) != length) _exit(2);
+            _exit(again > 0 ? 3 : 0);
+        }
+        if (done) break;
+    }
+    _exit(1);
+}
+
+// Runs body on the main thread of a child with the monitor started; returns
+// the child's exit code (0: reported once, 1: nothing to report) and the report
+static int runScenario(int sampleRate, void (*body)(void)) {
+    report[0] = '\0';
+    if (pipe(reportPipe) != 0) return -1;
+
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(reportPipe[0]);
+        if (!MoonForge_LockMonitor_Start(sampleRate)) _exit(4);
+
+        pthread_t thread;
+        pthread_create(&thread, NULL, checker, NULL);
+        body();
+        atomic_store(&bodyDone, 1);
+        for (;;) pause();
+    }
+
+    close(reportPipe[1]);
+    size_t length = 0;
+    ssize_t count;
+    while (length < sizeof(report) - 1 &&
+           (count = read(reportPipe[0], report + length, sizeof(report) - 1 - length)) > 0) {
+        length += (size_t)count;
+    }
+    report[length] = '\0';
+    close(reportPipe[0]);
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+static void startThread(ThreadFunction function) {
+    pthread_t thread;
+    pthread_create(&thread, NULL, function, NULL);
+}
+
+static void workersDeadlock(void) {
+    pthread_t render, audio;
+    pthread_create(&render, NULL, renderThread, NULL);
+    pthread_create(&audio, NULL, audioThread, NULL);
+    pthread_join(render, NULL);
+    pthread_join(audio, NULL);
+}
+
+static void checkWorkerDeadlock(void) {
+    CHECK_CONTAINS(report, "\"kind\":\"deadlock\"");
+    CHECK_CONTAINS(report, "\"chainLength\":2,\"cycleStart\":0");
+    CHECK_CONTAINS(report, "\"name\":\"RenderThread\",\"main\":false,\"wait\":\"mutex\"");
+    CHECK_CONTAINS(report, "\"name\":\"Audio_Thread\",\"main\":false,\"wait\":\"mutex\"");
+    CHECK_CONTAINS(report, "\"symbol\":\"lock_a_then_b\"");
+    CHECK_CONTAINS(report, "\"symbol\":\"lock_b_then_a\"");
+}
+
+static void test_worker_deadlock_reported_once(void) {
+    CHECK(runScenario(1, workersDeadlock) == 0);
+    checkWorkerDeadlock();
+}
+
+static void contendedThenDeadlock(void) {
+    contendAAndB();
+    workersDeadlock();
+}
+
+static void test_deadlock_found_on_contended_mutexes(void) {
+    // 1 in 1000 tracked from the first lock: A and B are tracked because they were contended
+    CHECK(runScenario(1000, contendedThenDeadlock) == 0);
+    checkWorkerDeadlock();
+}
+
+static void mainWaitsForLoader(void) {
+    startThread(loaderThread);
+    sleepMs(50);
+    waitForA();
+}
+
+static void test_main_thread_lock_wait(void) {
+    CHECK(runScenario(1, mainWaitsForLoader) == 0);
+    CHECK_CONTAINS(report, "\"kind\":\"lock_wait\"");
+    CHECK_CONTAINS(report, "\"chainLength\":2,\"cycleStart\":-1");
+    CHECK_CONTAINS(report, "\"main\":true,\"wait\":\"mutex\"");
+    CHECK_CONTAINS(report, "\"symbol\":\"wait_for_a\"");
+    CHECK_CONTAINS(report, "\"name\":\"Loader\",\"main\":false,\"wait\":\"none\"");
+}
+
+static void mainInDeadlock(void) {
+    startThread(audioThread);
+    sleepMs(50);
+    void (*lockAThenB)(void) = (void (*)(void))dlsym(game, "lock_a_then_b");
+    lockAThenB();
+}
+
+static void test_main_thread_deadlock(void) {
+    CHECK(runScenario(1, mainInDeadlock) == 0);
+    CHECK_CONTAINS(report, "\"kind\":\"deadlock\"");
+    CHECK_CONTAINS(report, "\"main\":true,\"wait\":\"mutex\"");
+    CHECK_CONTAINS(report, "\"symbol\":\"lock_b_then_a\"");
+}
+
+static void test_main_thread_condition_wait(void) {
+    CHECK(runScenario(1, waitForCondition) == 0);
+    CHECK_CONTAINS(report, "\"kind\":\"condition_wait\"");
+    CHECK_CONTAINS(report, "\"main\":true,\"wait\":\"condition\"");
+    CHECK_CONTAINS(report, "\"symbol\":\"wait_for_condition\"");
+}
+
+// Two threads taking turns on A, each wait far shorter than a hang
+static void briefWaits(void) {
+    pthread_t thread;
+    pthread_create(&thread, NULL, briefThread, NULL);
+    takeABriefly(40);
+    pthread_join(thread, NULL);
+}
+
+static void test_short_waits_not_reported(void) {
+    CHECK(runScenario(1, briefWaits) == 1);
+    CHECK(report[0] == '\0');
+}
+
+static void lockingStillWorks(void) {
+    if (countWithThreads(8, 20000) != 8 * 20000) _exit(5);
+    if (checkLockResults() != 0) _exit(6);
+}
+
+static void test_locking_unchanged_with_hooks(void) {
+    CHECK(runScenario(1, lockingStillWorks) == 1);
+}
+
+static void test_stop_removes_hooks(void) {
+    CHECK(MoonForge_LockMonitor_Start(1));
+    CHECK(MoonForge_LockMonitor_IsRunning());
+    MoonForge_LockMonitor_Stop();
+    CHECK(!MoonForge_LockMonitor_IsRunning());
+    CHECK(MoonForge_LockMonitor_Check(0, report, sizeof(report)) == 0);
+    CHECK(checkLockResults() == 0);
+}
+
+int main(void) {
+    game = dlopen("./libmodule_lock_game.so", RTLD_NOW | RTLD_LOCAL);
+    if (game == NULL) {
+        fprintf(stderr, "dlopen: %s\n", dlerror());
+        return 1;
+    }
+    renderThread = (ThreadFunction)dlsym(game, "render_thread");
+    audioThread = (ThreadFunction)dlsym(game, "audio_thread");
+    loaderThread = (ThreadFunction)dlsym(game, "loader_thread");
+    briefThread = (ThreadFunction)dlsym(game, "brief_thread");
+    waitForA = (void (*)(void))dlsym(game, "wait_for_a");
+    waitForCondition = (void (*)(void))dlsym(game, "wait_for_condition");
+    takeABriefly = (void (*)(int))dlsym(game, "take_a_briefly");
+    contendAAndB = (void (*)(void))dlsym(game, "contend_a_and_b");
+    countWithThreads = (long (*)(int, int))dlsym(game, "count_with_threads");
+    checkLockResults = (int (*)(void))dlsym(game, "check_lock_results");
+
+    RUN_TEST(test_worker_deadlock_reported_once);
+    RUN_TEST(test_deadlock_found_on_contended_mutexes);
+    RUN_TEST(test_main_thread_lock_wait);
+    RUN_TEST(test_main_thread_deadlock);
+    RUN_TEST(test_main_thread_condition_wait);
+    RUN_TEST(test_short_waits_not_reported);
+    RUN_TEST(test_locking_unchanged_with_hooks);
+    RUN_TEST(test_stop_removes_hooks);
+
+    return testResult();
+}
@@ -0,0 +1,204 @@
+/**
+ * Log tail: the ring keeps the newest whole lines once it has wrapped,
+ * writers racing each other across the wrap each get their own space, and
+ * stdout/stderr go through the ring to their original targets until Stop
+ * points them back and the drain thread exits.
+ */
+
+#define _GNU_SOURCE
+
+#include "moonforge_test.h"
+#include "moonforge_log_tail.h"
+
+#define LOG_TAG "test"
+#include "moonforge_log.h"
+
+#include <dirent.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define RING_SIZE 16384
+// "I/test: " and the newline around each line's text
+#define LINE_OVERHEAD 9
+
+#define WRITER_THREADS 4
+#define LINES_PER_WRITER 50
+
+static char tail[RING_SIZE + 1];
+static size_t bytesAppended;
+static pthread_barrier_t writersReady;
+
+static void append(const char* text) {
+    size_t length = strlen(text);
+    moonforge_log_tail_append(ANDROID_LOG_INFO, LOG_TAG, text, length);
+    bytesAppended += LINE_OVERHEAD + length;
+}
+
+// Every line in the tail is one of ours, whole
+static int allLinesWhole(const char* text) {
+    for (const char* line = text; *line != '\0';) {
+        const char* end = strchr(line, '\n');
+        if (end == NULL || strncmp(line, "I/test: ", 8) != 0) return 0;
+        line = end + 1;
+    }
+    return 1;
+}
+
+static void test_wrapped_ring_keeps_newest_lines(void) {
+    char text[32];
+    for (int i = 0; i < 2000; i++) {
+        snprintf(text, sizeof(text), "line %05d", i);
+        append(text);
+    }
+
+    int length = MoonForge_LogTail_Read(tail, sizeof(tail));
+    CHECK(length > RING_SIZE - 64 && length <= RING_SIZE);
+    CHECK(length == (int)strlen(tail));
+    CHECK(allLinesWhole(tail));
+
+    // Consecutive up to the last line written, with the partial oldest line dropped
+    int expected = atoi(tail + strlen("I/test: line "));
+    CHECK(expected > 0);
+    for (const char* line = tail; *line != '\0'; line = strchr(line, '\n') + 1) {
+        if (atoi(line + strlen("I/test: line ")) != expected) {
+            CHECK(!"lines out of order");
+            break;
+        }
+        expected++;
+    }
+    CHECK(expected == 2000);
+
+    // A small buffer gets the newest whole lines
+    char small[64];
+    CHECK(MoonForge_LogTail_Read(small, sizeof(small)) > 0);
+    CHECK(strcmp(small, "I/test: line 01997\nI/test: line 01998\nI/test: line 01999\n") == 0);
+}
+
+static void* writer(void* argument) {
+    int index = (int)(intptr_t)argument;
+    char text[32];
+
+    pthread_barrier_wait(&writersReady);
+    for (int i = 0; i < LINES_PER_WRITER; i++) {
+        // Same length for every line, so the total is known
+        snprintf(text, sizeof(text), "writer %d line %04d ..........", index, i);
+        moonforge_log_tail_append(ANDROID_LOG_INFO, LOG_TAG, text, strlen(text));
+    }
+    return NULL;
+}
+
+static void test_concurrent_writers_across_wrap(void) {
+    // Pad until the next lines start 4 KB before the ring's end
+    size_t target = (bytesAppended / RING_SIZE + 1) * RING_SIZE - 4096;
+    if (target < bytesAppended + LINE_OVERHEAD + 1) target += RING_SIZE;
+    char filler[256];
+    while (bytesAppended < target) {
+        // 100-byte lines while that leaves room for a shorter last one
+        size_t remaining = target - bytesAppended;
+        size_t length = (remaining >= 200 ? 100 : remaining) - LINE_OVERHEAD;
+        memset(filler, '-', length);
+        filler[length] = '\0';
+        append(filler);
+    }
+    CHECK(bytesAppended % RING_SIZE == RING_SIZE - 4096);
+
+    // 8000 bytes from here: across the wrap, but not a whole lap, so nothing is overwritten
+    pthread_t threads[WRITER_THREADS];
+    pthread_barrier_init(&writersReady, NULL, WRITER_THREADS);
+    for (int i = 0; i < WRITER_THREADS; i++) {
+        pthread_create(&threads[i], NULL, writer, (void*)(intptr_t)i);
+    }
+    for (int i = 0; i < WRITER_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    pthread_barrier_destroy(&writersReady);
+
+    CHECK(MoonForge_LogTail_Read(tail, sizeof(tail)) > 0);
+    CHECK(allLinesWhole(tail));
+
+    // Each line exactly once
+    char line[64];
+    for (int i = 0; i < WRITER_THREADS; i++) {
+        for (int j = 0; j < LINES_PER_WRITER; j++) {
+            snprintf(line, sizeof(line), "I/test: writer %d line %04d ..........\n", i, j);
+            const char* found = strstr(tail, line);
+            CHECK(found != NULL);
+            if (found != NULL) CHECK(strstr(found + 1, line) == NULL);
+        }
+    }
+}
+
+static int threadCount(void) {
+    int count = 0;
+    DIR* directory = opendir("/proc/self/task");
+    if (directory == NULL) return -1;
+    struct dirent* entry;
+    while ((entry = readdir(directory)) != NULL) {
+        if (entry->d_name[0] != '.') count++;
+    }
+    closedir(directory);
+    return count;
+}
+
+// The drain thread hands lines over asynchronously
+static int waitForTail(const char* part) {
+    for (int waited = 0; waited < 2000; waited += 10) {
+        if (MoonForge_LogTail_Read(tail, sizeof(tail)) > 0 && strstr(tail, part) != NULL) return 1;
+        usleep(10 * 1000);
+    }
+    return 0;
+}
+
+static void test_stdio_redirected_until_stop(void) {
+    // Stand-ins for the terminal or player log stdout/stderr pointed at
+    fflush(stdout);
+    int savedStdout = dup(STDOUT_FILENO);
+    int savedStderr = dup(STDERR_FILENO);
+    char path[] = "/tmp/moonforge_stdio_XXXXXX";
+    int file = mkstemp(path);
+    CHECK(file >= 0);
+    dup2(file, STDOUT_FILENO);
+    dup2(file, STDERR_FILENO);
+    int threadsBefore = threadCount();
+
+    CHECK(MoonForge_LogTail_Start(RING_SIZE, 1));
+    CHECK(threadCount() == threadsBefore + 1);
+
+    printf("to stdout\n");
+    fprintf(stderr, "to stderr\n");
+    CHECK(waitForTail("I/stdout: to stdout\n"));
+    CHECK(waitForTail("W/stderr: to stderr\n"));
+
+    // Back to the original targets, with the pipes closed and the drain thread gone
+    MoonForge_LogTail_Stop();
+    CHECK(threadCount() == threadsBefore);
+    printf("after stop\n");
+    fflush(stdout);
+    CHECK(MoonForge_LogTail_Read(tail, sizeof(tail)) == 0);
+
+    dup2(savedStdout, STDOUT_FILENO);
+    dup2(savedStderr, STDERR_FILENO);
+    close(savedStdout);
+    close(savedStderr);
+
+    char forwarded[256];
+    ssize_t length = pread(file, forwarded, sizeof(forwarded) - 1, 0);
+    forwarded[length > 0 ? length : 0] = '\0';
+    CHECK_CONTAINS(forwarded, "to stdout\n");
+    CHECK_CONTAINS(forwarded, "to stderr\n");
+    CHECK_CONTAINS(forwarded, "after stop\n");
+    close(file);
+    unlink(path);
+}
+
+int main(void) {
+    CHECK(MoonForge_LogTail_Start(RING_SIZE, 0));
+    RUN_TEST(test_wrapped_ring_keeps_newest_lines);
+    RUN_TEST(test_concurrent_writers_across_wrap);
+    MoonForge_LogTail_Stop();
+
+    RUN_TEST(test_stdio_redirected_until_stop);
+
+    return testResult();
+}
@@ -0,0 +1,234 @@
+/**
+ * PLT/GOT hook engine: install and module filter, RELRO re-protection,
+ * unregister and restore, refresh after dlopen, the ignore list, and the
+ * executable's own imports. The engine is linked in from
+ * libmoonforge_plugin.so, so the executable is not the module it skips.
+ */
+
+#define _GNU_SOURCE
+
+#include "moonforge_test.h"
+#include "moonforge_plt_hook.h"
+
+#include <dlfcn.h>
+#include <link.h>
+#include <stdint.h>
+#include <unistd.h>
+
+typedef size_t (*LengthFunction)(const char*);
+
+static LengthFunction originalStrlen;
+static void* (*originalMalloc)(size_t);
+static pid_t (*originalGetppid)(void);
+static int strlenCalls;
+static int mallocCalls;
+static int getppidCalls;
+
+static size_t countingStrlen(const char* text) {
+    strlenCalls++;
+    return originalStrlen(text) + 100;
+}
+
+static void* countingMalloc(size_t size) {
+    mallocCalls++;
+    return originalMalloc(size);
+}
+
+static pid_t countingGetppid(void) {
+    getppidCalls++;
+    return originalGetppid();
+}
+
+static void* targetModule;
+static LengthFunction targetLen;
+static void* (*targetAlloc)(size_t);
+static LengthFunction (*targetLenFunction)(void);
+
+static void* loadModule(const char* path) {
+    void* module = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+    if (module == NULL) fprintf(stderr, "dlopen %s: %s\n", path, dlerror());
+    return module;
+}
+
+// Permissions of the mapping that contains address, from /proc/self/maps
+static int mappingPerms(uintptr_t address, char perms[5]) {
+    FILE* maps = fopen("/proc/self/maps", "r");
+    if (maps == NULL) return 0;
+
+    char line[512];
+    int found = 0;
+    while (!found && fgets(line, sizeof(line), maps) != NULL) {
+        unsigned long start, end;
+        if (sscanf(line, "%lx-%lx %4s", &start, &end, perms) == 3 && address >= start && address < end) {
+            found = 1;
+        }
+    }
+    fclose(maps);
+    return found;
+}
+
+struct RelroSearch {
+    const char* name;
+    uintptr_t start;
+};
+
+static int findRelro(struct dl_phdr_info* info, size_t size, void* data) {
+    (void)size;
+    struct RelroSearch* search = data;
+    if (info->dlpi_name == NULL || strstr(info->dlpi_name, search->name) == NULL) return 0;
+
+    for (int i = 0; i < info->dlpi_phnum; i++) {
+        if (info->dlpi_phdr[i].p_type == PT_GNU_RELRO) {
+            search->start = (uintptr_t)info->dlpi_addr + info->dlpi_phdr[i].p_vaddr;
+            return 1;
+        }
+    }
+    return 1;
+}
+
+static void test_install_and_filter(void) {
+    CHECK(targetLen("abc") == 3);
+
+    CHECK(moonforge_plt_hook_register("libmodule_plt_target", "strlen", (void*)countingStrlen, (void**)&originalStrlen) == 0);
+    CHECK(moonforge_plt_hook_register("libno_such_module", "malloc", (void*)countingMalloc, (void**)&originalMalloc) == 0);
+    CHECK(moonforge_plt_hook_refresh() > 0);
+    CHECK(originalStrlen != NULL);
+
+    // Calls and address-taken uses both go through patched slots
+    CHECK(targetLen("abc") == 103);
+    CHECK(strlenCalls == 1);
+    CHECK(targetLenFunction() == countingStrlen);
+
+    // A filter that matches nothing patches nothing
+    free(targetAlloc(16));
+    CHECK(mallocCalls == 0);
+
+    // Nothing changed since, so nothing to do
+    CHECK(moonforge_plt_hook_refresh() == 0);
+
+    moonforge_plt_hook_unregister(NULL);
+}
+
+static void test_relro_reprotected(void) {
+    struct RelroSearch search = { "libmodule_plt_target", 0 };
+    dl_iterate_phdr(findRelro, &search);
+    CHECK(search.start != 0);
+    if (search.start == 0) return;
+
+    char perms[5] = "";
+    CHECK(mappingPerms(search.start, perms));
+    CHECK(perms[1] == '-');
+
+    moonforge_plt_hook_register("libmodule_plt_target", "strlen", (void*)countingStrlen, (void**)&originalStrlen);
+    CHECK(moonforge_plt_hook_refresh() > 0);
+    CHECK(targetLen("abc") == 103);
+
+    // Written through a temporary mprotect, then read-only again
+    CHECK(mappingPerms(search.start, perms));
+    CHECK(perms[1] == '-');
+
+    moonforge_plt_hook_unregister(NULL);
+    CHECK(mappingPerms(search.start, perms));
+    CHECK(perms[1] == '-');
+}
+
+static void test_unregister_restores(void) {
+    moonforge_plt_hook_register("libmodule_plt_target", "strlen", (void*)countingStrlen, (void**)&originalStrlen);
+    moonforge_plt_hook_register(NULL, "malloc", (void*)countingMalloc, (void**)&originalMalloc);
+    moonforge_plt_hook_refresh();
+
+    int calls = mallocCalls;
+    free(targetAlloc(16));
+    CHECK(mallocCalls == calls + 1);
+    CHECK(targetLen("abc") == 103);
+
+    // Only the slots of the given replacement go back
+    CHECK(moonforge_plt_hook_unregister((void*)countingStrlen) > 0);
+    CHECK(targetLen("abc") == 3);
+    CHECK(targetLenFunction() != countingStrlen);
+    free(targetAlloc(16));
+    CHECK(mallocCalls == calls + 2);
+
+    CHECK(moonforge_plt_hook_unregister(NULL) > 0);
+    free(targetAlloc(16));
+    CHECK(mallocCalls == calls + 2);
+
+    // A restored slot can be patched again
+    moonforge_plt_hook_register("libmodule_plt_target", "strlen", (void*)countingStrlen, NULL);
+    CHECK(moonforge_plt_hook_refresh() > 0);
+    CHECK(targetLen("abc") == 103);
+    moonforge_plt_hook_unregister(NULL);
+    CHECK(targetLen("abc") == 3);
+}
+
+static void test_refresh_after_dlopen(void) {
+    moonforge_plt_hook_register("libmodule_plt_", "strlen", (void*)countingStrlen, (void**)&originalStrlen);
+    moonforge_plt_hook_refresh();
+
+    void* late = loadModule("./libmodule_plt_late.so");
+    CHECK(late != NULL);
+    if (late == NULL) return;
+    LengthFunction lateLen = (LengthFunction)dlsym(late, "late_len");
+
+    // Loaded after the last refresh: not patched yet
+    CHECK(lateLen("abc") == 3);
+    CHECK(moonforge_plt_hook_refresh() > 0);
+    CHECK(lateLen("abc") == 103);
+    CHECK(targetLen("abc") == 103);
+
+    moonforge_plt_hook_unregister(NULL);
+    CHECK(lateLen("abc") == 3);
+    dlclose(late);
+}
+
+static void test_executable_imports_patched(void) {
+    pid_t (*realGetppid)(void) = (pid_t (*)(void))dlsym(RTLD_DEFAULT, "getppid");
+
+    // Not called from here before, so the slot still holds its lazy-binding stub
+    moonforge_plt_hook_register(NULL, "getppid", (void*)countingGetppid, (void**)&originalGetppid);
+    CHECK(moonforge_plt_hook_refresh() > 0);
+    CHECK(originalGetppid == realGetppid);
+
+    // Calling the stub would have let the resolver put the real function back in the slot
+    CHECK(getppid() == realGetppid());
+    CHECK(getppid() == realGetppid());
+    CHECK(getppidCalls == 2);
+
+    moonforge_plt_hook_unregister(NULL);
+    CHECK(getppid() == realGetppid());
+    CHECK(getppidCalls == 2);
+}
+
+static void test_ignore_list(void) {
+    CHECK(moonforge_plt_hook_ignore("libmodule_plt_ignored") == 0);
+
+    void* ignored = loadModule("./libmodule_plt_ignored.so");
+    CHECK(ignored != NULL);
+    if (ignored == NULL) return;
+    LengthFunction ignoredLen = (LengthFunction)dlsym(ignored, "ignored_len");
+
+    moonforge_plt_hook_register("libmodule_plt_", "strlen", (void*)countingStrlen, (void**)&originalStrlen);
+    moonforge_plt_hook_refresh();
+    CHECK(targetLen("abc") == 103);
+    CHECK(ignoredLen("abc") == 3);
+
+    moonforge_plt_hook_unregister(NULL);
+    dlclose(ignored);
+}
+
+int main(void) {
+    targetModule = loadModule("./libmodule_plt_target.so");
+    if (targetModule == NULL) return 1;
+    targetLen = (LengthFunction)dlsym(targetModule, "target_len");
+    targetAlloc = (void* (*)(size_t))dlsym(targetModule, "target_alloc");
+    targetLenFunction = (LengthFunction (*)(void))dlsym(targetModule, "target_len_function");
+
+    RUN_TEST(test_install_and_filter);
+    RUN_TEST(test_relro_reprotected);
+    RUN_TEST(test_unregister_restores);
+    RUN_TEST(test_refresh_after_dlopen);
+    RUN_TEST(test_executable_imports_patched);
+    // Last: the ignore list can't be emptied again
+    RUN_TEST(test_ignore_list);
+    return testResult();
+}
@@ -0,0 +1,216 @@
+/**
+ * Session black box: the next launch learns how the previous process
+ * ended (quit, crash, or killed in the foreground or background) and how
+ * long it spent in each state, without the previous process running any
+ * shutdown code. Each session runs in a child process.
+ */
+
+#define _GNU_SOURCE
+
+#include "moonforge_test.h"
+#include "moonforge_crash_handler.h"
+#include "moonforge_session.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+static char sessionDirectory[64];
+static char summary[512];
+
+static void removeSessionFile(void) {
+    char path[128];
+    snprintf(path, sizeof(path), "%s/session.bin", sessionDirectory);
+    unlink(path);
+}
+
+// The session file and the crash records left by the crash test
+static void removeSessionDirectory(void) {
+    DIR* directory = opendir(sessionDirectory);
+    if (directory != NULL) {
+        struct dirent* entry;
+        while ((entry = readdir(directory)) != NULL) {
+            if (entry->d_name[0] == '.') continue;
+
+            char path[512];
+            snprintf(path, sizeof(path), "%s/%s", sessionDirectory, entry->d_name);
+            unlink(path);
+        }
+        closedir(directory);
+    }
+    rmdir(sessionDirectory);
+}
+
+// Runs body as a session in a child process; returns its wait status
+static int runSession(const char* sessionId, void (*body)(void)) {
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0) {
+        if (!MoonForge_Session_Begin(sessionDirectory, sessionId)) _exit(2);
+        body();
+        _exit(0);
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return status;
+}
+
+// What the next launch sees, from a child so this process never takes the record over
+static int readPreviousSummary(void) {
+    int pipeFds[2];
+    if (pipe(pipeFds) != 0) return 0;
+
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(pipeFds[0]);
+        char buffer[512];
+        int length = MoonForge_Session_Begin(sessionDirectory, "next")
+            ? MoonForge_Session_GetPreviousSummary(buffer, sizeof(buffer)) : 0;
+        if (length > 0 && write(pipeFds[1], buffer, (size_t)length) != length) _exit(1);
+        _exit(0);
+    }
+
+    close(pipeFds[1]);
+    ssize_t length = read(pipeFds[0], summary, sizeof(summary) - 1);
+    summary[length > 0 ? length : 0] = '\0';
+    close(pipeFds[0]);
+    waitpid(pid, NULL, 0);
+    return length > 0;
+}
+
+static long long summaryField(const char* name) {
+    char key[64];
+    snprintf(key, sizeof(key), "\"%s\":", name);
+    const char* field = strstr(summary, key);
+    return field != NULL ? strtoll(field + strlen(key), NULL, 10) : -1;
+}
+
+static void quitNormally(void) {
+    usleep(50000);
+    MoonForge_Session_Heartbeat();
+    MoonForge_Session_End();
+}
+
+static void test_first_launch_has_no_previous_session(void) {
+    removeSessionFile();
+    CHECK(!readPreviousSummary());
+
+    // Nor does a file that is not a session record
+    char path[128];
+    snprintf(path, sizeof(path), "%s/session.bin", sessionDirectory);
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    char garbage[4096];
+    memset(garbage, 0x5a, sizeof(garbage));
+    CHECK(fd >= 0 && write(fd, garbage, sizeof(garbage)) == (ssize_t)sizeof(garbage));
+    if (fd >= 0) close(fd);
+    CHECK(!readPreviousSummary());
+}
+
+static void test_quit_reported_as_exit(void) {
+    runSession("session-quit", quitNormally);
+
+    CHECK(readPreviousSummary());
+    CHECK_CONTAINS(summary, "\"sessionId\":\"session-quit\"");
+    CHECK_CONTAINS(summary, "\"endReason\":\"exit\"");
+    CHECK_CONTAINS(summary, "\"signal\":0}");
+    CHECK(summaryField("foregroundMs") >= 50);
+    CHECK(summaryField("backgroundMs") == 0);
+    CHECK(summaryField("endTimestamp") >= summaryField("startTimestamp"));
+}
+
+__attribute__((noinline)) static void writeThrough(volatile char* pointer) {
+    *pointer = 42;
+}
+
+static void crashWithHandler(void) {
+    MoonForge_SetCrashDirectory(sessionDirectory);
+    MoonForge_InitializeCrashHandler(NULL);
+    MoonForge_Session_Heartbeat();
+    writeThrough(NULL);
+}
+
+static void test_crash_reported_with_signal(void) {
+    int status = runSession("session-crash", crashWithHandler);
+    CHECK(WIFSIGNALED(status) && WTERMSIG(status) == SIGSEGV);
+
+    CHECK(readPreviousSummary());
+    CHECK_CONTAINS(summary, "\"sessionId\":\"session-crash\"");
+    CHECK_CONTAINS(summary, "\"endReason\":\"crash\"");
+    CHECK_CONTAINS(summary, "\"signal\":11}");
+}
+
+static void killedInForeground(void) {
+    usleep(50000);
+    MoonForge_Session_Heartbeat();
+    kill(getpid(), SIGKILL);
+}
+
+static void test_kill_in_foreground(void) {
+    int status = runSession("session-fg", killedInForeground);
+    CHECK(WIFSIGNALED(status) && WTERMSIG(status) == SIGKILL);
+
+    CHECK(readPreviousSummary());
+    CHECK_CONTAINS(summary, "\"endReason\":\"killed_foreground\"");
+    CHECK(summaryField("foregroundMs") >= 50);
+}
+
+static void killedInBackground(void) {
+    usleep(50000);
+    MoonForge_Session_SetForeground(0);
+    usleep(100000);
+    MoonForge_Session_Heartbeat();
+    kill(getpid(), SIGKILL);
+}
+
+static void test_kill_in_background_splits_time(void) {
+    runSession("session-bg", killedInBackground);
+
+    CHECK(readPreviousSummary());
+    CHECK_CONTAINS(summary, "\"endReason\":\"killed_background\"");
+    long long foreground = summaryField("foregroundMs");
+    long long background = summaryField("backgroundMs");
+    CHECK(foreground >= 50);
+    CHECK(background >= 100);
+}
+
+static void recoveredFault(void) {
+    // What the crash handler does when the previous handler recovers
+    moonforge_session_mark_crashed(SIGSEGV);
+    moonforge_session_clear_crashed();
+    kill(getpid(), SIGKILL);
+}
+
+static void test_recovered_fault_not_reported_as_crash(void) {
+    runSession("session-recovered", recoveredFault);
+
+    CHECK(readPreviousSummary());
+    CHECK_CONTAINS(summary, "\"endReason\":\"killed_foreground\"");
+    CHECK_CONTAINS(summary, "\"signal\":0}");
+}
+
+static void test_session_id_safe_for_json(void) {
+    runSession("id\"with\\quotes", quitNormally);
+
+    CHECK(readPreviousSummary());
+    CHECK_CONTAINS(summary, "\"sessionId\":\"id_with_quotes\"");
+}
+
+int main(void) {
+    strcpy(sessionDirectory, "/tmp/moonforge_session_XXXXXX");
+    if (mkdtemp(sessionDirectory) == NULL) return 1;
+
+    RUN_TEST(test_first_launch_has_no_previous_session);
+    RUN_TEST(test_quit_reported_as_exit);
+    RUN_TEST(test_crash_reported_with_signal);
+    RUN_TEST(test_kill_in_foreground);
+    RUN_TEST(test_kill_in_background_splits_time);
+    RUN_TEST(test_recovered_fault_not_reported_as_crash);
+    RUN_TEST(test_session_id_safe_for_json);
+
+    removeSessionDirectory();
+    return testResult();
+}
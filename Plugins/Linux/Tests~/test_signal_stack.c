@@ -0,0 +1,161 @@
+/**
+ * Per-thread alternate signal stacks: threads started by plugins after the
+ * crash handler is installed get one, so a stack overflow on any of them is
+ * recorded; existing large enough stacks are kept; the hook goes away on
+ * shutdown.
+ */
+
+#define _GNU_SOURCE
+
+#include "moonforge_test.h"
+#include "moonforge_crash_handler.h"
+#include "moonforge_signal_stack.h"
+
+#include <dirent.h>
+#include <dlfcn.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+typedef int (*SpawnFunction)(pthread_t*, void* (*)(void*), void*);
+
+static SpawnFunction spawnThread;
+static char crashDirectory[64];
+
+static int countRecords(void) {
+    DIR* directory = opendir(crashDirectory);
+    if (directory == NULL) return 0;
+
+    int count = 0;
+    struct dirent* entry;
+    while ((entry = readdir(directory)) != NULL) {
+        if (strncmp(entry->d_name, "crash_", 6) != 0) continue;
+        count++;
+
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s", crashDirectory, entry->d_name);
+        unlink(path);
+    }
+    closedir(directory);
+    return count;
+}
+
+static void* querySignalStack(void* data) {
+    sigaltstack(NULL, (stack_t*)data);
+    return NULL;
+}
+
+static stack_t stackOfPluginThread(void) {
+    stack_t stack;
+    memset(&stack, 0, sizeof(stack));
+    pthread_t thread;
+    if (spawnThread(&thread, querySignalStack, &stack) == 0) pthread_join(thread, NULL);
+    return stack;
+}
+
+static void test_plugin_threads_get_a_stack(void) {
+    MoonForge_SetCrashDirectory(crashDirectory);
+    MoonForge_InitializeCrashHandler(NULL);
+
+    stack_t stack = stackOfPluginThread();
+    CHECK(!(stack.ss_flags & SS_DISABLE));
+    CHECK(stack.ss_size >= MOONFORGE_SIGNAL_STACK_SIZE);
+
+    // And the thread that installed the handler
+    stack_t own;
+    sigaltstack(NULL, &own);
+    CHECK(!(own.ss_flags & SS_DISABLE));
+    CHECK(own.ss_size >= MOONFORGE_SIGNAL_STACK_SIZE);
+
+    // Each thread has its own
+    stack_t other = stackOfPluginThread();
+    CHECK(other.ss_size >= MOONFORGE_SIGNAL_STACK_SIZE);
+    CHECK(own.ss_sp != stack.ss_sp);
+
+    MoonForge_ShutdownCrashHandler();
+}
+
+static void* keepLargerStack(void* data) {
+    static char existing[128 * 1024];
+    stack_t larger = { .ss_sp = existing, .ss_size = sizeof(existing), .ss_flags = 0 };
+    sigaltstack(&larger, NULL);
+
+    stack_t after;
+    *(int*)data = moonforge_signal_stack_ensure() && sigaltstack(NULL, &after) == 0 && after.ss_sp == existing;
+    return NULL;
+}
+
+static void test_larger_stack_kept(void) {
+    int kept = 0;
+    pthread_t thread;
+    pthread_create(&thread, NULL, keepLargerStack, &kept);
+    pthread_join(thread, NULL);
+    CHECK(kept);
+}
+
+static void test_hook_removed_on_shutdown(void) {
+    MoonForge_InitializeCrashHandler(NULL);
+    MoonForge_ShutdownCrashHandler();
+
+    // glibc threads start without one
+    stack_t stack = stackOfPluginThread();
+    CHECK(stack.ss_flags & SS_DISABLE);
+}
+
+// Never reached; keeps the compiler from treating the recursion as infinite
+static volatile int recursionLimit = -1;
+
+__attribute__((noinline)) static int recurse(int depth) {
+    if (depth == recursionLimit) return 0;
+    volatile char frame[256];
+    frame[0] = (char)depth;
+    return recurse(depth + 1) + frame[0];
+}
+
+static void* overflow(void* data) {
+    (void)data;
+    recurse(0);
+    return NULL;
+}
+
+static void overflowPluginThread(void) {
+    MoonForge_InitializeCrashHandler(NULL);
+    pthread_t thread;
+    spawnThread(&thread, overflow, NULL);
+    pthread_join(thread, NULL);
+}
+
+static void test_stack_overflow_on_plugin_thread_recorded(void) {
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0) {
+        overflowPluginThread();
+        _exit(0);
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    CHECK(WIFSIGNALED(status) && WTERMSIG(status) == SIGSEGV);
+    CHECK(countRecords() == 1);
+}
+
+int main(void) {
+    strcpy(crashDirectory, "/tmp/moonforge_stack_XXXXXX");
+    if (mkdtemp(crashDirectory) == NULL) return 1;
+
+    void* module = dlopen("./libmodule_thread_spawn.so", RTLD_NOW | RTLD_LOCAL);
+    if (module == NULL) {
+        fprintf(stderr, "dlopen: %s\n", dlerror());
+        return 1;
+    }
+    spawnThread = (SpawnFunction)dlsym(module, "spawn_thread");
+
+    RUN_TEST(test_plugin_threads_get_a_stack);
+    RUN_TEST(test_larger_stack_kept);
+    RUN_TEST(test_hook_removed_on_shutdown);
+    RUN_TEST(test_stack_overflow_on_plugin_thread_recorded);
+
+    rmdir(crashDirectory);
+    return testResult();
+}
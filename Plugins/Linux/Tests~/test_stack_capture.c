@@ -0,0 +1,200 @@
+/**
+ * Stack capture from the crash handler: faults at known recursion depths
+ * record every frame, with the recursion folded and the deepest frames
+ * kept past the head of the stack, and a deep stack that barely folds keeps
+ * every head and tail frame in the record; a fault the interrupted registers can't
+ * be unwound from falls back to _Unwind_Backtrace.
+ *
+ * On armeabi-v7a (make test-arm) the stack comes from the EHABI unwinder,
+ * starting at the signal frame's registers; elsewhere from
+ * _Unwind_Backtrace, through the signal frame.
+ */
+
+#define _GNU_SOURCE
+
+#include "moonforge_test.h"
+#include "moonforge_crash_handler.h"
+
+#include <dirent.h>
+#include <dlfcn.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Frames above the recursion: the test, libc start-up and, with _Unwind_Backtrace, the handler
+#define OTHER_FRAMES 64
+
+typedef int (*CrashAtDepth)(int depth);
+typedef void (*CallNullFunction)(void);
+
+static CrashAtDepth crashAtDepth;
+static CrashAtDepth crashThroughHashedPath;
+static CallNullFunction callNullFunction;
+static char crashDirectory[64];
+static char record[1 << 20];
+static int requestedDepth;
+
+// Reads the only record and deletes it
+static int takeRecord(void) {
+    record[0] = '\0';
+    DIR* directory = opendir(crashDirectory);
+    if (directory == NULL) return 0;
+
+    int found = 0;
+    struct dirent* entry;
+    while ((entry = readdir(directory)) != NULL) {
+        if (strncmp(entry->d_name, "crash_", 6) != 0) continue;
+
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s", crashDirectory, entry->d_name);
+        FILE* file = fopen(path, "r");
+        if (file != NULL) {
+            size_t length = fread(record, 1, sizeof(record) - 1, file);
+            record[length] = '\0';
+            fclose(file);
+            found = strstr(entry->d_name, ".json") != NULL;
+        }
+        unlink(path);
+    }
+    closedir(directory);
+    return found;
+}
+
+static int recordedDepth(void) {
+    const char* field = strstr(record, "\"frameCount\":");
+    return field != NULL ? atoi(field + strlen("\"frameCount\":")) : -1;
+}
+
+// The innermost frame's JSON object
+static void firstFrame(char* frame, size_t frameSize) {
+    frame[0] = '\0';
+    const char* start = strstr(record, "\"frames\":[{");
+    if (start == NULL) return;
+    start += strlen("\"frames\":[");
+
+    const char* end = strchr(start, '}');
+    size_t length = end != NULL ? (size_t)(end - start) + 1 : 0;
+    if (length >= frameSize) length = frameSize - 1;
+    memcpy(frame, start, length);
+    frame[length] = '\0';
+}
+
+// Runs body in a child process with the crash handler installed; returns its wait status
+static int runChild(void (*body)(void)) {
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0) {
+        MoonForge_SetCrashDirectory(crashDirectory);
+        MoonForge_InitializeCrashHandler(NULL);
+        body();
+        _exit(0);
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return status;
+}
+
+static void crashAtRequestedDepth(void) {
+    crashAtDepth(requestedDepth);
+}
+
+static void crashAt(int depth) {
+    requestedDepth = depth;
+    int status = runChild(crashAtRequestedDepth);
+
+    CHECK(WIFSIGNALED(status) && WTERMSIG(status) == SIGSEGV);
+    CHECK(takeRecord());
+    CHECK_CONTAINS(record, "\"module\":\"libmodule_stack_depth.so\",\"symbol\":\"crash_at_depth\"");
+
+    // The faulting call plus one frame per level, and no more than the frames above them
+    int recorded = recordedDepth();
+    CHECK(recorded >= depth + 1);
+    CHECK(recorded <= depth + 1 + OTHER_FRAMES);
+
+#if defined(__arm__)
+    // Unwound from the interrupted registers, so the fault itself comes first
+    char frame[512];
+    firstFrame(frame, sizeof(frame));
+    CHECK_CONTAINS(frame, "\"symbol\":\"crash_at_depth\"");
+#endif
+}
+
+static void test_shallow_crash_folds_recursion(void) {
+    crashAt(10);
+
+    // The ten identical return addresses under the faulting frame
+    CHECK_CONTAINS(record, "\"cycleLength\":1,\"repeat\":10}");
+}
+
+static void test_deep_crash_keeps_bottom_of_stack(void) {
+    crashAt(3000);
+
+    // Frames past the head are skipped; the deepest ones keep their depth
+    char deepest[64];
+    snprintf(deepest, sizeof(deepest), "{\"frame\":%d,", recordedDepth() - 1);
+    CHECK_CONTAINS(record, deepest);
+    CHECK(strstr(record, "{\"frame\":1500,") == NULL);
+}
+
+static void crashThroughRequestedDepth(void) {
+    crashThroughHashedPath(requestedDepth);
+}
+
+static void test_unfolded_deep_stack_keeps_every_ring_frame(void) {
+    requestedDepth = 3000;
+    int status = runChild(crashThroughRequestedDepth);
+
+    CHECK(WIFSIGNALED(status) && WTERMSIG(status) == SIGSEGV);
+    CHECK(takeRecord());
+    CHECK(strcmp(record + strlen(record) - 2, "]}") == 0);
+
+    // The last frames of the head ring and the first of the tail ring, not a cut in between
+    int recorded = recordedDepth();
+    int lastHead = -1;
+    int firstTail = recorded;
+    for (const char* entry = strstr(record, "{\"frame\":"); entry != NULL; entry = strstr(entry + 1, "{\"frame\":")) {
+        int frame = atoi(entry + strlen("{\"frame\":"));
+        if (frame < 1024 && frame > lastHead) lastHead = frame;
+        if (frame >= 1024 && frame < firstTail) firstTail = frame;
+    }
+    CHECK(lastHead >= 1024 - 2 * 32);
+    CHECK(firstTail <= recorded - 1024 + 2 * 32);
+}
+
+static void test_null_call_falls_back_to_unwind_backtrace(void) {
+    // pc is 0: the EHABI walk yields no frames, under the fallback threshold
+    int status = runChild(callNullFunction);
+
+    CHECK(WIFSIGNALED(status) && WTERMSIG(status) == SIGSEGV);
+    CHECK(takeRecord());
+    CHECK(recordedDepth() > 0);
+
+    // _Unwind_Backtrace starts in the handler, not in the interrupted code
+    char frame[512];
+    firstFrame(frame, sizeof(frame));
+    CHECK(frame[0] != '\0');
+    CHECK(strstr(frame, "libmodule_stack_depth.so") == NULL);
+}
+
+int main(void) {
+    strcpy(crashDirectory, "/tmp/moonforge_capture_XXXXXX");
+    if (mkdtemp(crashDirectory) == NULL) return 1;
+
+    void* module = dlopen("./libmodule_stack_depth.so", RTLD_NOW | RTLD_LOCAL);
+    if (module == NULL) {
+        fprintf(stderr, "dlopen: %s\n", dlerror());
+        return 1;
+    }
+    crashAtDepth = (CrashAtDepth)dlsym(module, "crash_at_depth");
+    crashThroughHashedPath = (CrashAtDepth)dlsym(module, "crash_through_hashed_path");
+    callNullFunction = (CallNullFunction)dlsym(module, "call_null_function");
+
+    RUN_TEST(test_shallow_crash_folds_recursion);
+    RUN_TEST(test_deep_crash_keeps_bottom_of_stack);
+    RUN_TEST(test_unfolded_deep_stack_keeps_every_ring_frame);
+    RUN_TEST(test_null_call_falls_back_to_unwind_backtrace);
+
+    rmdir(crashDirectory);
+    return testResult();
+}
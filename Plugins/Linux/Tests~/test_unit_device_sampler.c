@@ -0,0 +1,138 @@
+/**
+ * Device sampler against a fake sysfs tree: thermal zones in millidegrees
+ * and degrees with implausible ones left out, cpufreq policies ordered
+ * little to big with the tightest frequency cap reported, and the laptop
+ * style battery found by its type. Later samples re-read the open files,
+ * and state that doesn't fit the buffer is cut at a cluster boundary.
+ */
+
+#define _GNU_SOURCE
+#define MOONFORGE_SYSFS_ROOT "/tmp/moonforge_sysfs_test"
+
+#include "moonforge_test.h"
+#include "moonforge_device_sampler.c"
+
+#include <errno.h>
+#include <sys/stat.h>
+
+static char state[1024];
+
+static void removeTree(void) {
+    if (system("rm -rf " MOONFORGE_SYSFS_ROOT) != 0) fprintf(stderr, "could not remove the fake sysfs\n");
+}
+
+// Write a sysfs attribute in place, creating its directories, as the kernel would update it
+static void writeAttribute(const char* relativePath, const char* value) {
+    char path[PATH_BUFFER_SIZE];
+    snprintf(path, sizeof(path), "%s/%s", MOONFORGE_SYSFS_ROOT, relativePath);
+    for (char* slash = strchr(path + 1, '/'); slash != NULL; slash = strchr(slash + 1, '/')) {
+        *slash = '\0';
+        if (mkdir(path, 0700) != 0 && errno != EEXIST) fprintf(stderr, "mkdir %s failed\n", path);
+        *slash = '/';
+    }
+
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    if (fd < 0) return;
+    if (write(fd, value, strlen(value)) < 0) fprintf(stderr, "write %s failed\n", path);
+    close(fd);
+}
+
+static void buildTree(void) {
+    writeAttribute("sys/class/thermal/thermal_zone0/temp", "45000\n");
+    writeAttribute("sys/class/thermal/thermal_zone0/type", "cpu-0-0\n");
+    // A quote in the type, which must not reach the JSON
+    writeAttribute("sys/class/thermal/thermal_zone1/temp", "51500\n");
+    writeAttribute("sys/class/thermal/thermal_zone1/type", "gpu\"0\n");
+    // Disabled zone, and an older driver reporting degrees without a type
+    writeAttribute("sys/class/thermal/thermal_zone2/temp", "-273000\n");
+    writeAttribute("sys/class/thermal/thermal_zone2/type", "disabled\n");
+    writeAttribute("sys/class/thermal/thermal_zone3/temp", "38\n");
+    writeAttribute("sys/class/thermal/cooling_device0/cur_state", "0\n");
+
+    // Big cluster listed first and capped to half its top frequency
+    writeAttribute("sys/devices/system/cpu/cpufreq/policy4/cpuinfo_max_freq", "2400000\n");
+    writeAttribute("sys/devices/system/cpu/cpufreq/policy4/scaling_cur_freq", "1800000\n");
+    writeAttribute("sys/devices/system/cpu/cpufreq/policy4/scaling_max_freq", "1200000\n");
+    writeAttribute("sys/devices/system/cpu/cpufreq/policy0/cpuinfo_max_freq", "1800000\n");
+    writeAttribute("sys/devices/system/cpu/cpufreq/policy0/scaling_cur_freq", "1000000\n");
+    writeAttribute("sys/devices/system/cpu/cpufreq/policy0/scaling_max_freq", "1800000\n");
+
+    // No "battery" supply: BAT0 is found by its type, past the charger
+    writeAttribute("sys/class/power_supply/AC/type", "Mains\n");
+    writeAttribute("sys/class/power_supply/AC/online", "1\n");
+    writeAttribute("sys/class/power_supply/BAT0/type", "Battery\n");
+    writeAttribute("sys/class/power_supply/BAT0/capacity", "76\n");
+    writeAttribute("sys/class/power_supply/BAT0/status", "Discharging\n");
+    writeAttribute("sys/class/power_supply/BAT0/temp", "312\n");
+}
+
+static void test_nothing_before_first_sample(void) {
+    CHECK(MoonForge_DeviceSampler_GetState(state, sizeof(state)) == 0);
+    CHECK(state[0] == '\0');
+}
+
+static void test_sample_reads_every_source(void) {
+    CHECK(MoonForge_DeviceSampler_Sample() == 1);
+    CHECK(zoneCount == 3);
+
+    int length = MoonForge_DeviceSampler_GetState(state, sizeof(state));
+    CHECK(length == (int)strlen(state));
+    CHECK(strcmp(state,
+        "{\"temperatureC\":51.5,\"hottestZone\":\"gpu_0\",\"cpuFrequencyCapPercent\":50.0,"
+        "\"batteryPercent\":76,\"batteryCharging\":0,\"batteryTemperatureC\":31.2,\"clusters\":["
+        "{\"cpu\":0,\"curKhz\":1000000,\"maxKhz\":1800000,\"capKhz\":1800000},"
+        "{\"cpu\":4,\"curKhz\":1800000,\"maxKhz\":2400000,\"capKhz\":1200000}]}") == 0);
+}
+
+static void test_later_samples_reread_open_files(void) {
+    writeAttribute("sys/class/thermal/thermal_zone0/temp", "60300\n");
+    writeAttribute("sys/devices/system/cpu/cpufreq/policy4/scaling_max_freq", "2400000\n");
+    writeAttribute("sys/class/power_supply/BAT0/capacity", "80\n");
+    writeAttribute("sys/class/power_supply/BAT0/status", "Charging\n");
+
+    CHECK(MoonForge_DeviceSampler_Sample() == 1);
+    MoonForge_DeviceSampler_GetState(state, sizeof(state));
+    CHECK_CONTAINS(state, "\"temperatureC\":60.3,\"hottestZone\":\"cpu-0-0\",\"cpuFrequencyCapPercent\":100.0,");
+    CHECK_CONTAINS(state, "\"batteryPercent\":80,\"batteryCharging\":1,");
+    CHECK_CONTAINS(state, "{\"cpu\":4,\"curKhz\":1800000,\"maxKhz\":2400000,\"capKhz\":2400000}]}");
+
+    // Unreadable and unknown values are reported as unknown
+    writeAttribute("sys/class/power_supply/BAT0/capacity", "unknown\n");
+    writeAttribute("sys/class/power_supply/BAT0/status", "Unknown\n");
+    CHECK(MoonForge_DeviceSampler_Sample() == 1);
+    MoonForge_DeviceSampler_GetState(state, sizeof(state));
+    CHECK_CONTAINS(state, "\"batteryPercent\":-1,\"batteryCharging\":-1,");
+}
+
+static void test_small_buffer_drops_whole_clusters(void) {
+    int full = MoonForge_DeviceSampler_GetState(state, sizeof(state));
+    const char* second = strstr(state, ",{\"cpu\":4");
+    CHECK(second != NULL);
+    if (second == NULL) return;
+
+    // Room for the first cluster only: still valid JSON
+    char small[512];
+    int size = (int)(second - state) + 3;
+    int length = MoonForge_DeviceSampler_GetState(small, size);
+    CHECK(length == size - 1);
+    CHECK(strncmp(small, state, (size_t)(second - state)) == 0);
+    CHECK(strcmp(small + length - 2, "]}") == 0);
+
+    // Not even the fixed fields fit
+    CHECK(MoonForge_DeviceSampler_GetState(small, 64) == 0);
+    CHECK(small[0] == '\0');
+    CHECK(full > 64);
+}
+
+int main(void) {
+    removeTree();
+    buildTree();
+
+    RUN_TEST(test_nothing_before_first_sample);
+    RUN_TEST(test_sample_reads_every_source);
+    RUN_TEST(test_later_samples_reread_open_files);
+    RUN_TEST(test_small_buffer_drops_whole_clusters);
+
+    removeTree();
+    return testResult();
+}
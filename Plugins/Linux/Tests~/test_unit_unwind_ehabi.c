@@ -0,0 +1,283 @@
+/**
+ * ARM EHABI table interpreter against synthetic .ARM.exidx/.ARM.extab
+ * tables and a synthetic stack: each opcode form restores the expected
+ * registers, a bad first pc continues from lr, unreadable or misaligned
+ * stacks and frames that make no progress end the walk, deep recursion
+ * unwinds in full, and refuse-to-unwind and spare opcodes stop cleanly.
+ *
+ * The interpreter works on 32-bit addresses, so the tables and stack are
+ * mapped below 4 GB; it is built on x86_64 and arm, and skipped where no
+ * such mapping can be had.
+ */
+
+#define _GNU_SOURCE
+#define MOONFORGE_UNWIND_EHABI_TABLES
+
+#include "moonforge_test.h"
+#include "moonforge_unwind_ehabi.c"
+
+#include <sys/mman.h>
+
+#ifndef MAP_32BIT
+#define MAP_32BIT 0
+#endif
+
+// Layout of the fake module and its stack
+enum {
+    EXIDX = 0x0,
+    EXTAB = 0x200,
+    TEXT = 0x1000,
+    TEXT_SIZE = 0x800,
+    STACK = 0x10000,
+    REGION_SIZE = 0x400000
+};
+
+#define RECURSION_DEPTH 200000
+
+static uint8_t* region;
+static uint32_t* exidx;
+
+static uint32_t frames[RECURSION_DEPTH + 16];
+static int frameCount;
+static int frameLimit;
+
+static uint32_t* wordAt(uint32_t address) {
+    return (uint32_t*)(uintptr_t)address;
+}
+
+static uint32_t addressOf(uint32_t offset) {
+    return (uint32_t)(uintptr_t)(region + offset);
+}
+
+// Start of the nth fake function
+static uint32_t function(int n) {
+    return addressOf(TEXT) + 0x100 * n;
+}
+
+static void setPrel31(uint32_t* word, uint32_t target) {
+    *word = (target - (uint32_t)(uintptr_t)word) & 0x7fffffff;
+}
+
+static int collectFrame(uintptr_t pc, void* arg) {
+    (void)arg;
+    frames[frameCount++] = (uint32_t)pc;
+    return frameLimit == 0 || frameCount < frameLimit;
+}
+
+static int unwind(uint32_t* regs) {
+    frameCount = 0;
+    readableStart = readableEnd = 0;
+    lastModule = 0;
+    return unwindFrom(regs, collectFrame, NULL);
+}
+
+/**
+ * Functions 0-6 of the fake module, one per way of describing a frame:
+ * inline and extab compact models, the generic model, cantunwind.
+ */
+static int buildModule(void) {
+    region = mmap((void*)0x40000000, REGION_SIZE, PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_ANONYMOUS | MAP_32BIT, -1, 0);
+    if (region == MAP_FAILED) return 0;
+    if ((uint64_t)(uintptr_t)region + REGION_SIZE > UINT32_MAX) {
+        munmap(region, REGION_SIZE);
+        return 0;
+    }
+
+    exidx = (uint32_t*)(region + EXIDX);
+    uint32_t* extab = (uint32_t*)(region + EXTAB);
+
+    // 0: leaf, nothing to undo (finish, inline)
+    setPrel31(&exidx[0], function(0));
+    exidx[1] = 0x80b0b0b0;
+    // 1: vsp = r7; vsp -= 8; pop {r4, r5, r7, lr} (Lu16 in extab)
+    setPrel31(&exidx[2], function(1));
+    setPrel31(&exidx[3], addressOf(EXTAB));
+    extab[0] = 0x81019741;
+    extab[1] = 0x840bb0b0;
+    // 2: vsp += 16; vpop {d8-d9}; pop {r4, lr} (inline Su16)
+    setPrel31(&exidx[4], function(2));
+    exidx[5] = 0x8003d1a8;
+    // 3: personality routine, then vsp += 0x1000 (uleb128); pop {r4-r11, lr}
+    setPrel31(&exidx[6], function(3));
+    setPrel31(&exidx[7], addressOf(EXTAB + 0x10));
+    setPrel31(&extab[4], function(7));
+    extab[5] = 0x01b2ff06;
+    extab[6] = 0xafb0b0b0;
+    // 4: pop {r4, pc} (Su16 in extab)
+    setPrel31(&exidx[8], function(4));
+    setPrel31(&exidx[9], addressOf(EXTAB + 0x20));
+    extab[8] = 0x808801b0;
+    // 5: cantunwind, the bottom of the stack
+    setPrel31(&exidx[10], function(5));
+    exidx[11] = EXIDX_CANTUNWIND;
+    // 6: recursive, pop {r4, lr}
+    setPrel31(&exidx[12], function(6));
+    exidx[13] = 0x80a8b0b0;
+
+    ElfW(Phdr) phdrs[3];
+    memset(phdrs, 0, sizeof(phdrs));
+    phdrs[0].p_type = PT_LOAD;
+    phdrs[0].p_memsz = TEXT;
+    phdrs[0].p_flags = PF_R;
+    phdrs[1].p_type = PT_LOAD;
+    phdrs[1].p_vaddr = TEXT;
+    phdrs[1].p_memsz = TEXT_SIZE;
+    phdrs[1].p_flags = PF_R | PF_X;
+    phdrs[2].p_type = PT_ARM_EXIDX;
+    phdrs[2].p_vaddr = EXIDX;
+    phdrs[2].p_memsz = 8 * 7;
+
+    pageSize = (uintptr_t)sysconf(_SC_PAGESIZE);
+    return addModule((uintptr_t)region, phdrs, 3) == 0;
+}
+
+// The stack of functions 0 <- 1 <- 2 <- 3 <- 4 <- 5
+static uint32_t stackTop;
+static uint32_t frameOf1;
+static uint32_t bottomSp;
+
+static void buildStack(void) {
+    stackTop = addressOf(REGION_SIZE - 0x3000);
+
+    frameOf1 = stackTop + 16;
+    *wordAt(frameOf1) = 0x44;                      // r4
+    *wordAt(frameOf1 + 4) = 0x55;                  // r5
+    *wordAt(frameOf1 + 8) = 0x77;                  // r7
+    *wordAt(frameOf1 + 12) = function(2) + 0x11;   // return into 2 (Thumb bit set)
+
+    uint32_t frameOf2 = frameOf1 + 16;
+    *wordAt(frameOf2 + 36) = function(3) + 0x40;
+
+    uint32_t frameOf3 = frameOf2 + 40;
+    *wordAt(frameOf3 + 0x1000 + 32) = function(4) + 0x21;
+
+    uint32_t frameOf4 = frameOf3 + 0x1000 + 36;
+    *wordAt(frameOf4 + 4) = function(5) + 0x9;
+    bottomSp = frameOf4 + 8;
+}
+
+static void crashIn0(uint32_t* regs, uint32_t pc) {
+    memset(regs, 0, 16 * sizeof(uint32_t));
+    regs[7] = frameOf1 + 8;
+    regs[REG_SP] = stackTop;
+    regs[REG_LR] = function(1) + 0x21;
+    regs[REG_PC] = pc;
+}
+
+static void test_each_opcode_form_unwinds(void) {
+    uint32_t regs[16];
+    crashIn0(regs, function(0) + 0x6);
+
+    CHECK(unwind(regs) == 6);
+    const uint32_t expected[] = {
+        function(0) + 0x6, function(1) + 0x20, function(2) + 0x10,
+        function(3) + 0x40, function(4) + 0x20, function(5) + 0x8
+    };
+    for (int i = 0; i < 6 && i < frameCount; i++) CHECK(frames[i] == expected[i]);
+
+    // Every pop and vsp adjustment was applied
+    CHECK(regs[REG_SP] == bottomSp);
+}
+
+static void test_bad_pc_continues_from_lr(void) {
+    // A call through a bad function pointer
+    uint32_t regs[16];
+    crashIn0(regs, 0x10);
+
+    CHECK(unwind(regs) == 6);
+    CHECK(frames[0] == 0x10);
+    CHECK(frames[1] == function(1) + 0x20);
+}
+
+static void test_unreadable_stack_ends_walk(void) {
+    uint32_t regs[16];
+    uint32_t guard = addressOf(REGION_SIZE - 0x1000);
+    mprotect(region + REGION_SIZE - 0x1000, 0x1000, PROT_NONE);
+
+    // Frame pointer into a guard page
+    crashIn0(regs, function(0));
+    regs[7] = guard + 8;
+    CHECK(unwind(regs) == 2);
+
+    // Into unmapped memory
+    crashIn0(regs, function(0));
+    regs[7] = 0xfffff000u;
+    CHECK(unwind(regs) == 2);
+
+    // Misaligned
+    crashIn0(regs, function(0));
+    regs[7] = 0x1002;
+    CHECK(unwind(regs) == 2);
+
+    mprotect(region + REGION_SIZE - 0x1000, 0x1000, PROT_READ | PROT_WRITE);
+}
+
+static void test_no_progress_ends_walk(void) {
+    // A leaf whose lr points back into itself: same sp, same pc
+    uint32_t regs[16] = { 0 };
+    regs[REG_SP] = stackTop;
+    regs[REG_PC] = function(0) + 4;
+    regs[REG_LR] = function(0) + 9;
+    CHECK(unwind(regs) == 2);
+}
+
+static void buildRecursion(uint32_t* regs) {
+    uint32_t top = addressOf(STACK);
+    for (int i = 0; i < RECURSION_DEPTH; i++) {
+        *wordAt(top + 8 * i + 4) = i == RECURSION_DEPTH - 1 ? function(5) + 1 : function(6) + 0x11;
+    }
+    memset(regs, 0, 16 * sizeof(uint32_t));
+    regs[REG_SP] = top;
+    regs[REG_PC] = function(6) + 4;
+}
+
+static void test_deep_recursion_unwinds_in_full(void) {
+    uint32_t regs[16];
+    buildRecursion(regs);
+
+    CHECK(unwind(regs) == RECURSION_DEPTH + 1);
+    CHECK(frames[RECURSION_DEPTH] == function(5));
+
+    // The callback ends it early
+    buildRecursion(regs);
+    frameLimit = 1000;
+    CHECK(unwind(regs) == 1000);
+    frameLimit = 0;
+}
+
+static void test_refused_or_spare_opcodes_stop(void) {
+    uint32_t saved = exidx[13];
+    uint32_t regs[16];
+    const uint32_t programs[] = {
+        0x808000b0,   // refuse to unwind
+        0x80b4b0b0,   // spare
+        0x8f000000    // unknown personality
+    };
+
+    for (size_t i = 0; i < sizeof(programs) / sizeof(programs[0]); i++) {
+        exidx[13] = programs[i];
+        buildRecursion(regs);
+        regs[REG_PC] = function(6);
+        CHECK(unwind(regs) == 1);
+    }
+    exidx[13] = saved;
+}
+
+int main(void) {
+    if (!buildModule()) {
+        printf("skip: no memory below 4 GB for the 32-bit tables\n");
+        return 0;
+    }
+    buildStack();
+
+    RUN_TEST(test_each_opcode_form_unwinds);
+    RUN_TEST(test_bad_pc_continues_from_lr);
+    RUN_TEST(test_unreadable_stack_ends_walk);
+    RUN_TEST(test_no_progress_ends_walk);
+    RUN_TEST(test_deep_recursion_unwinds_in_full);
+    RUN_TEST(test_refused_or_spare_opcodes_stop);
+
+    munmap(region, REGION_SIZE);
+    return testResult();
+}
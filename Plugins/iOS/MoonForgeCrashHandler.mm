@@ -8,8 +8,13 @@
 #import "MoonForgeCrashHandler.h"
 #import <UIKit/UIKit.h>
 #import <mach/mach.h>
-#import <execinfo.h>
+#import <dlfcn.h>
+#import <pthread.h>
 #import <signal.h>
+#import <sys/ucontext.h>
+#if __has_include(<ptrauth.h>)
+#import <ptrauth.h>
+#endif
 #import <sys/sysctl.h>
 #import <CoreTelephony/CTCarrier.h>
 #import <CoreTelephony/CTTelephonyNetworkInfo.h>
@@ -38,8 +43,36 @@ static volatile sig_atomic_t isHandlingCrash = 0;
 // Initialization state
 static int isInitialized = 0;
 
-// Buffer for crash JSON (pre-allocated to avoid malloc in signal handler)
-static char crashJsonBuffer[32768];
+// Buffers for crash JSON (pre-allocated to avoid malloc in signal handler)
+static char crashJsonBuffer[40960];
+static char stackTraceJson[32768];
+
+// Alternate signal stack, so stack overflows still reach the handler
+#define ALT_STACK_SIZE (64 * 1024)
+
+// Stack capture. The top STACK_HEAD_FRAMES frames are kept in order and the
+// deepest STACK_TAIL_FRAMES in a ring, so a stack overflow keeps both the
+// faulting frame and the root of the recursion however deep the stack is.
+#define STACK_HEAD_FRAMES 512
+#define STACK_TAIL_FRAMES 512
+#define STACK_MAX_FRAMES (STACK_HEAD_FRAMES + STACK_TAIL_FRAMES)
+// Longest repeating run of frames recognized as a recursion cycle
+#define MAX_CYCLE_FRAMES 32
+
+// One frame of the record; the first frame of a cycle carries its length and repeat count
+struct StackEntry {
+    int index;
+    int cycleLength;
+    int repeat;
+};
+
+static void* stackHead[STACK_HEAD_FRAMES];
+static void* stackTail[STACK_TAIL_FRAMES];
+static void* stackFrames[STACK_MAX_FRAMES];
+static int stackDepths[STACK_MAX_FRAMES];
+static struct StackEntry stackEntries[STACK_MAX_FRAMES];
+static int stackEntryLengths[STACK_MAX_FRAMES];
+static char stackEntryScratch[512];
 
 #pragma mark - Signal Handler
 
@@ -69,43 +102,190 @@ static const char* signalDescription(int sig) {
     }
 }
 
-static void captureStackTrace(char* buffer, size_t bufferSize) {
-    void* callstack[128];
-    int frames = backtrace(callstack, 128);
-    char** symbols = backtrace_symbols(callstack, frames);
+static uintptr_t stripPointer(uintptr_t pointer) {
+#if __has_feature(ptrauth_calls)
+    return (uintptr_t)ptrauth_strip((void*)pointer, ptrauth_key_return_address);
+#else
+    return pointer;
+#endif
+}
 
-    size_t offset = 0;
-    offset += snprintf(buffer + offset, bufferSize - offset, "[");
+static void recordFrame(int depth, uintptr_t pc) {
+    if (depth < STACK_HEAD_FRAMES) {
+        stackHead[depth] = (void*)pc;
+    } else {
+        stackTail[(depth - STACK_HEAD_FRAMES) % STACK_TAIL_FRAMES] = (void*)pc;
+    }
+}
 
-    for (int i = 0; i < frames && offset < bufferSize - 100; i++) {
-        if (i > 0) {
-            offset += snprintf(buffer + offset, bufferSize - offset, ",");
+/**
+ * Walk the crashed thread's frame-pointer chain into stackFrames/stackDepths:
+ * the top frames, then the deepest ones. Apple's arm64 and x86_64 ABIs keep
+ * frame pointers, so unlike backtrace() this reaches the bottom of any stack.
+ * @return Number of frames kept; *depth receives the number walked
+ */
+static int captureStackTrace(void* context, int* depth) {
+    ucontext_t* uc = (ucontext_t*)context;
+    int count = 0;
+
+    if (uc != NULL && uc->uc_mcontext != NULL) {
+#if defined(__arm64__)
+        uintptr_t pc = stripPointer((uintptr_t)arm_thread_state64_get_pc(uc->uc_mcontext->__ss));
+        uintptr_t fp = stripPointer((uintptr_t)arm_thread_state64_get_fp(uc->uc_mcontext->__ss));
+#elif defined(__x86_64__)
+        uintptr_t pc = (uintptr_t)uc->uc_mcontext->__ss.__rip;
+        uintptr_t fp = (uintptr_t)uc->uc_mcontext->__ss.__rbp;
+#else
+        uintptr_t pc = 0;
+        uintptr_t fp = 0;
+#endif
+        pthread_t thread = pthread_self();
+        uintptr_t stackHigh = (uintptr_t)pthread_get_stackaddr_np(thread);
+        uintptr_t stackLow = stackHigh - pthread_get_stacksize_np(thread);
+
+        if (pc != 0) recordFrame(count++, pc);
+
+        // Each frame record is {previous fp, return address}, at increasing addresses
+        while (fp >= stackLow && fp + 2 * sizeof(uintptr_t) <= stackHigh && (fp & (sizeof(uintptr_t) - 1)) == 0) {
+            const uintptr_t* frame = (const uintptr_t*)fp;
+            uintptr_t returnAddress = stripPointer(frame[1]);
+            if (returnAddress == 0) break;
+
+            recordFrame(count++, returnAddress);
+            if (frame[0] <= fp) break;
+            fp = frame[0];
         }
+    }
+
+    int headCount = count < STACK_HEAD_FRAMES ? count : STACK_HEAD_FRAMES;
+    for (int i = 0; i < headCount; i++) {
+        stackFrames[i] = stackHead[i];
+        stackDepths[i] = i;
+    }
+
+    int tailCount = count - headCount;
+    if (tailCount > STACK_TAIL_FRAMES) tailCount = STACK_TAIL_FRAMES;
+    for (int i = 0; i < tailCount; i++) {
+        int tailDepth = count - tailCount + i;
+        stackFrames[headCount + i] = stackTail[(tailDepth - STACK_HEAD_FRAMES) % STACK_TAIL_FRAMES];
+        stackDepths[headCount + i] = tailDepth;
+    }
 
-        // Parse symbol: "index  module  address  function"
-        const char* symbol = symbols ? symbols[i] : "???";
+    *depth = count;
+    return headCount + tailCount;
+}
 
-        // Escape quotes in symbol
-        char escapedSymbol[512];
-        size_t j = 0, k = 0;
-        while (symbol[j] && k < sizeof(escapedSymbol) - 2) {
-            if (symbol[j] == '"' || symbol[j] == '\\') {
-                escapedSymbol[k++] = '\\';
+/**
+ * Append entries for frames [start, end), folding repeated runs of up to
+ * MAX_CYCLE_FRAMES frames into one copy with a repeat count.
+ */
+static int compressFrames(int start, int end, int entryCount) {
+    int i = start;
+    while (i < end) {
+        int bestLength = 1;
+        int bestRepeat = 1;
+
+        for (int length = 1; length <= MAX_CYCLE_FRAMES && i + 2 * length <= end; length++) {
+            int repeat = 1;
+            while (i + (repeat + 1) * length <= end
+                   && memcmp(&stackFrames[i], &stackFrames[i + repeat * length], length * sizeof(void*)) == 0) {
+                repeat++;
+            }
+            // Prefer the cycle covering the most frames; the shortest one on ties
+            if (repeat > 1 && length * repeat > bestLength * bestRepeat) {
+                bestLength = length;
+                bestRepeat = repeat;
             }
-            escapedSymbol[k++] = symbol[j++];
         }
-        escapedSymbol[k] = '\0';
 
-        offset += snprintf(buffer + offset, bufferSize - offset,
-            "{\"frame\":%d,\"symbol\":\"%s\",\"address\":\"%p\"}",
-            i, escapedSymbol, callstack[i]);
+        for (int k = 0; k < bestLength; k++) {
+            stackEntries[entryCount].index = i + k;
+            stackEntries[entryCount].cycleLength = k == 0 && bestRepeat > 1 ? bestLength : 0;
+            stackEntries[entryCount].repeat = k == 0 && bestRepeat > 1 ? bestRepeat : 0;
+            entryCount++;
+        }
+        i += bestLength * bestRepeat;
     }
+    return entryCount;
+}
+
+// Format one frame as JSON
+static int formatStackEntry(char* buffer, size_t bufferSize, const struct StackEntry* entry) {
+    void* addr = stackFrames[entry->index];
 
-    offset += snprintf(buffer + offset, bufferSize - offset, "]");
+    Dl_info info;
+    const char* symbolName = "???";
+    const char* moduleName = "???";
+    ptrdiff_t symbolOffset = 0;
 
-    if (symbols) {
-        free(symbols);
+    if (dladdr(addr, &info)) {
+        if (info.dli_sname) {
+            symbolName = info.dli_sname;
+            symbolOffset = (char*)addr - (char*)info.dli_saddr;
+        }
+        if (info.dli_fname) {
+            const char* lastSlash = strrchr(info.dli_fname, '/');
+            moduleName = lastSlash ? lastSlash + 1 : info.dli_fname;
+        }
     }
+
+    int written;
+    if (entry->repeat > 1) {
+        written = snprintf(buffer, bufferSize,
+            "{\"frame\":%d,\"address\":\"%p\",\"module\":\"%s\",\"symbol\":\"%s\",\"offset\":\"%td\",\"cycleLength\":%d,\"repeat\":%d}",
+            stackDepths[entry->index], addr, moduleName, symbolName, symbolOffset, entry->cycleLength, entry->repeat);
+    } else {
+        written = snprintf(buffer, bufferSize,
+            "{\"frame\":%d,\"address\":\"%p\",\"module\":\"%s\",\"symbol\":\"%s\",\"offset\":\"%td\"}",
+            stackDepths[entry->index], addr, moduleName, symbolName, symbolOffset);
+    }
+    return written < 0 ? 0 : written >= (int)bufferSize ? (int)bufferSize - 1 : written;
+}
+
+/**
+ * Format the captured stack as a JSON array, compressing recursion cycles.
+ * When the frames do not fit, the top half of the buffer goes to the top of
+ * the stack and the rest to the bottom; "frame" keeps each frame's depth, so
+ * dropped frames show as a gap.
+ */
+static void formatStackTraceJson(char* buffer, size_t bufferSize, int frameCount) {
+    int headCount = frameCount < STACK_HEAD_FRAMES ? frameCount : STACK_HEAD_FRAMES;
+    int entryCount = compressFrames(0, headCount, 0);
+    entryCount = compressFrames(headCount, frameCount, entryCount);
+
+    // Sizes first, so the cut can be placed before anything is written
+    size_t total = 2;
+    for (int i = 0; i < entryCount; i++) {
+        stackEntryLengths[i] = formatStackEntry(stackEntryScratch, sizeof(stackEntryScratch), &stackEntries[i]) + 1;
+        total += (size_t)stackEntryLengths[i];
+    }
+
+    int topCount = entryCount;
+    int bottomStart = entryCount;
+    if (total >= bufferSize) {
+        size_t budget = bufferSize - 3;
+        size_t used = 0;
+
+        topCount = 0;
+        while (topCount < entryCount && used + (size_t)stackEntryLengths[topCount] <= budget / 2) {
+            used += (size_t)stackEntryLengths[topCount++];
+        }
+        while (bottomStart > topCount && used + (size_t)stackEntryLengths[bottomStart - 1] <= budget) {
+            used += (size_t)stackEntryLengths[--bottomStart];
+        }
+    }
+
+    size_t offset = 0;
+    buffer[offset++] = '[';
+    for (int i = 0; i < entryCount; i++) {
+        if (i == topCount) i = bottomStart;
+        if (i == entryCount) break;
+
+        if (offset > 1) buffer[offset++] = ',';
+        offset += (size_t)formatStackEntry(buffer + offset, bufferSize - offset - 1, &stackEntries[i]);
+    }
+    buffer[offset++] = ']';
+    buffer[offset] = '\0';
 }
 
 static void signalHandler(int sig, siginfo_t* info, void* context) {
@@ -119,8 +299,9 @@ static void signalHandler(int sig, siginfo_t* info, void* context) {
     void* faultAddress = info ? info->si_addr : NULL;
 
     // Capture stack trace
-    char stackTraceJson[16384];
-    captureStackTrace(stackTraceJson, sizeof(stackTraceJson));
+    int stackDepth = 0;
+    int stackFrameCount = captureStackTrace(context, &stackDepth);
+    formatStackTraceJson(stackTraceJson, sizeof(stackTraceJson), stackFrameCount);
 
     // Get thread info
     mach_port_t thread = mach_thread_self();
@@ -133,6 +314,7 @@ static void signalHandler(int sig, siginfo_t* info, void* context) {
         "\"signalDescription\":\"%s\","
         "\"faultAddress\":\"%p\","
         "\"threadId\":%u,"
+        "\"frameCount\":%d,"
         "\"frames\":%s"
         "}",
         sig,
@@ -140,6 +322,7 @@ static void signalHandler(int sig, siginfo_t* info, void* context) {
         signalDescription(sig),
         faultAddress,
         thread,
+        stackDepth,
         stackTraceJson
     );
 
@@ -246,6 +429,15 @@ void MoonForge_InitializeCrashHandler(MoonForgeCrashCallback callback) {
         sigaction(sig, &action, &previousHandlers[sig]);
     }
 
+    // Allocate alternate signal stack (SA_ONSTACK needs one, and the default stack is gone after an overflow)
+    stack_t ss;
+    ss.ss_sp = malloc(ALT_STACK_SIZE);
+    if (ss.ss_sp != NULL) {
+        ss.ss_size = ALT_STACK_SIZE;
+        ss.ss_flags = 0;
+        sigaltstack(&ss, NULL);
+    }
+
     // Install NSException handler
     previousExceptionHandler = NSGetUncaughtExceptionHandler();
     NSSetUncaughtExceptionHandler(exceptionHandler);
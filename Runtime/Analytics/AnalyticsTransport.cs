@@ -14,16 +14,18 @@ namespace MoonForge.ErrorTracking.Analytics
     {
         private readonly ErrorTrackerConfig _config;
         private readonly MonoBehaviour _coroutineRunner;
+        private readonly FrameBudgetScheduler _scheduler;
         private readonly Queue<QueuedAnalyticsEvent> _offlineQueue;
         private readonly int _maxOfflineQueueSize;
         private bool _isSendingOfflineQueue;
 
         private const string OFFLINE_STORAGE_KEY = "MoonForge_Analytics_OfflineQueue";
 
-        public AnalyticsTransport(ErrorTrackerConfig config, MonoBehaviour coroutineRunner)
+        public AnalyticsTransport(ErrorTrackerConfig config, MonoBehaviour coroutineRunner, FrameBudgetScheduler scheduler = null)
         {
             _config = config;
             _coroutineRunner = coroutineRunner;
+            _scheduler = scheduler;
             _offlineQueue = new Queue<QueuedAnalyticsEvent>();
             _maxOfflineQueueSize = 100;
 
@@ -255,7 +257,7 @@ namespace MoonForge.ErrorTracking.Analytics
                 }
             }
 
-            SaveOfflineQueue();
+            RequestSaveOfflineQueue();
             _isSendingOfflineQueue = false;
         }
 
@@ -274,7 +276,21 @@ namespace MoonForge.ErrorTracking.Analytics
                 retryCount = 0
             });
 
-            SaveOfflineQueue();
+            RequestSaveOfflineQueue();
+        }
+
+        /// <summary>
+        /// PlayerPrefs.Save hits disk, so saves requested in the same frame are coalesced into one
+        /// </summary>
+        private void RequestSaveOfflineQueue()
+        {
+            if (_scheduler == null)
+            {
+                SaveOfflineQueue();
+                return;
+            }
+
+            _scheduler.PostOnce(OFFLINE_STORAGE_KEY, SaveOfflineQueue);
         }
 
         private void SaveOfflineQueue()
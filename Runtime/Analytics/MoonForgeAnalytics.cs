@@ -1,5 +1,6 @@
 using System;
 using System.Collections.Generic;
+using System.Threading;
 using UnityEngine;
 using UnityEngine.SceneManagement;
 
@@ -14,6 +15,9 @@ namespace MoonForge.ErrorTracking.Analytics
         private static AnalyticsTransport _transport;
         private static ErrorTrackerConfig _config;
         private static MonoBehaviour _coroutineRunner;
+        private static SdkWorkerThread _worker;
+        private static SdkTimer _sessionTimer;
+        private static volatile bool _sessionExpired;
         private static bool _isInitialized;
 
         private static string _sessionId;
@@ -33,7 +37,8 @@ namespace MoonForge.ErrorTracking.Analytics
         /// Initialize analytics with the given configuration.
         /// Called automatically by MoonForgeErrorTracker if analytics is enabled.
         /// </summary>
-        internal static void Initialize(ErrorTrackerConfig config, MonoBehaviour coroutineRunner)
+        internal static void Initialize(ErrorTrackerConfig config, MonoBehaviour coroutineRunner,
+            FrameBudgetScheduler scheduler = null, SdkWorkerThread worker = null)
         {
             if (_isInitialized)
             {
@@ -55,7 +60,9 @@ namespace MoonForge.ErrorTracking.Analytics
 
             _config = config;
             _coroutineRunner = coroutineRunner;
-            _transport = new AnalyticsTransport(config, coroutineRunner);
+            _worker = worker;
+            _sessionExpired = false;
+            _transport = new AnalyticsTransport(config, coroutineRunner, scheduler);
             _userProperties = new Dictionary<string, object>();
 
             // Generate or restore session/distinct IDs
@@ -85,6 +92,7 @@ namespace MoonForge.ErrorTracking.Analytics
             {
                 { "session_id", _sessionId }
             });
+            ArmSessionTimer(config.sessionTimeoutSeconds);
 
             // Track initial screen view
             if (config.trackSceneViewsAutomatically && !string.IsNullOrEmpty(_currentScene))
@@ -115,10 +123,14 @@ namespace MoonForge.ErrorTracking.Analytics
                 { "duration_seconds", sessionDuration }
             });
 
+            _sessionTimer?.Cancel();
+            _sessionTimer = null;
+
             _isInitialized = false;
             _transport = null;
             _config = null;
             _coroutineRunner = null;
+            _worker = null;
         }
 
         /// <summary>
@@ -377,8 +389,12 @@ namespace MoonForge.ErrorTracking.Analytics
             // Check for session timeout
             if (_config != null && _config.sessionTimeoutSeconds > 0)
             {
-                var timeSinceLastActivity = now - _lastActivityTime;
-                if (timeSinceLastActivity > _config.sessionTimeoutSeconds)
+                // With a worker the session timer flags expiry, so events don't have to check the clock
+                var timedOut = _worker != null
+                    ? _sessionExpired
+                    : now - _lastActivityTime > _config.sessionTimeoutSeconds;
+
+                if (timedOut)
                 {
                     // Session timed out, start a new one
                     var oldSessionId = _sessionId;
@@ -387,7 +403,9 @@ namespace MoonForge.ErrorTracking.Analytics
 
                     // Update timestamp BEFORE calling TrackEvent to prevent
                     // infinite recursion (TrackEvent -> UpdateLastActivity -> TrackEvent)
-                    _lastActivityTime = now;
+                    Interlocked.Exchange(ref _lastActivityTime, now);
+                    _sessionExpired = false;
+                    ArmSessionTimer(_config.sessionTimeoutSeconds);
 
                     if (_config.debugMode)
                     {
@@ -405,7 +423,47 @@ namespace MoonForge.ErrorTracking.Analytics
                 }
             }
 
-            _lastActivityTime = now;
+            Interlocked.Exchange(ref _lastActivityTime, now);
+        }
+
+        /// <summary>
+        /// Re-check the session against wall-clock time, e.g. after the app resumes
+        /// from a suspension the worker's monotonic timers didn't see
+        /// </summary>
+        internal static void CheckSessionTimeout()
+        {
+            if (!_isInitialized || _config.sessionTimeoutSeconds <= 0) return;
+
+            var now = DateTimeOffset.UtcNow.ToUnixTimeSeconds();
+            if (now - Interlocked.Read(ref _lastActivityTime) > _config.sessionTimeoutSeconds)
+            {
+                _sessionExpired = true;
+            }
+        }
+
+        private static void ArmSessionTimer(int timeoutSeconds)
+        {
+            if (_worker == null || timeoutSeconds <= 0) return;
+
+            _sessionTimer = _worker.Schedule(TimeSpan.FromSeconds(timeoutSeconds + 1), () => OnSessionTimer(timeoutSeconds));
+        }
+
+        /// <summary>
+        /// Runs on the worker. Activity only records a timestamp, so the timer re-arms itself
+        /// for the remaining idle time until the session has been idle for the full timeout.
+        /// </summary>
+        private static void OnSessionTimer(int timeoutSeconds)
+        {
+            if (!_isInitialized) return;
+
+            var idle = DateTimeOffset.UtcNow.ToUnixTimeSeconds() - Interlocked.Read(ref _lastActivityTime);
+            if (idle > timeoutSeconds)
+            {
+                _sessionExpired = true;
+                return;
+            }
+
+            _sessionTimer = _worker?.Schedule(TimeSpan.FromSeconds(timeoutSeconds - idle + 1), () => OnSessionTimer(timeoutSeconds));
         }
 
         private static string GetOrCreateDistinctId()
@@ -0,0 +1,210 @@
+using System;
+using System.Globalization;
+
+namespace MoonForge.ErrorTracking
+{
+    /// <summary>
+    /// Labels a native crash with the kind of fault behind it, from the signal,
+    /// si_code and fault address and, on Android and Linux, the registers, stack
+    /// bounds and memory mappings the crash handler saved (the record's "fault"
+    /// section). Runs when the crash record is converted on the next launch; the
+    /// label is sent as <see cref="ErrorPayloadInner.faultClass"/> and is part of
+    /// the fingerprint, so different faults at the same frame are grouped apart.
+    /// </summary>
+    public static class FaultClassifier
+    {
+        /// <summary>Read, write or call through an address in the first 64 KB, which is never mapped</summary>
+        public const string NullDereference = "null_dereference";
+        /// <summary>The stack ran into its guard page or past the bottom of its mapping</summary>
+        public const string StackOverflow = "stack_overflow";
+        /// <summary>Jump to an address that isn't mapped executable (W^X violation or corrupt function pointer)</summary>
+        public const string ExecuteFault = "execute_fault";
+        /// <summary>Access to unmapped memory, often a use after free of a large allocation</summary>
+        public const string UnmappedAccess = "unmapped_access";
+        /// <summary>Access a mapping's permissions don't allow, e.g. a write to read-only data or an allocator guard page</summary>
+        public const string ProtectionFault = "protection_fault";
+        public const string MisalignedAccess = "misaligned_access";
+        /// <summary>SIGBUS other than misalignment, e.g. a mapped file that was truncated</summary>
+        public const string BusError = "bus_error";
+        public const string DivisionByZero = "division_by_zero";
+        public const string ArithmeticError = "arithmetic_error";
+        /// <summary>abort() with an abort message (assert, libc++abi, fortify)</summary>
+        public const string AbortWithMessage = "abort_with_message";
+        public const string Abort = "abort";
+        public const string IllegalInstruction = "illegal_instruction";
+        /// <summary>Breakpoint or trap instruction, e.g. __builtin_trap on ARM64</summary>
+        public const string Trap = "trap";
+        public const string BrokenPipe = "broken_pipe";
+        /// <summary>A fault signal sent by kill/tgkill rather than raised by a fault</summary>
+        public const string SignalSent = "signal_sent";
+        /// <summary>SIGSEGV matching none of the above</summary>
+        public const string SegmentationFault = "segmentation_fault";
+
+        /// <summary>
+        /// The crash record's "fault" section
+        /// </summary>
+        [Serializable]
+        public class FaultRecord
+        {
+            public string pc;
+            public string sp;
+            /// <summary>Link register; ARM only</summary>
+            public string lr;
+            /// <summary>Mapping sp was in; empty if sp was not in a mapping</summary>
+            public string stackStart;
+            public string stackEnd;
+            /// <summary>The mappings around the fault address, sp and pc, lowest first</summary>
+            public MappingRecord[] maps;
+        }
+
+        /// <summary>
+        /// One line of /proc/self/maps
+        /// </summary>
+        [Serializable]
+        public class MappingRecord
+        {
+            public string start;
+            public string end;
+            public string perms;
+            public string name;
+        }
+
+        // Nothing is ever mapped below this (vm.mmap_min_addr)
+        private const ulong NullPageLimit = 0x10000;
+
+        // Distance from sp within which a fault is taken for a stack access
+        private const ulong StackReach = 0x10000;
+
+        // Widest gap below a stack in which a fault still counts as overflow (the kernel's stack guard gap)
+        private const ulong StackGuardGap = 0x100000;
+
+        // Linux si_code values
+        private const int SegvMapErr = 1;
+        private const int SegvAccErr = 2;
+        private const int BusAdrAln = 1;
+        private const int FpeIntDiv = 1;
+        private const int FpeFltDiv = 3;
+
+        /// <summary>
+        /// Label a signal crash, or null for records that aren't one (iOS NSExceptions)
+        /// </summary>
+        /// <param name="signalName">"SIGSEGV" etc.</param>
+        /// <param name="siCode">si_code, or null if the platform doesn't record it</param>
+        /// <param name="faultAddress">si_addr as written by the handler</param>
+        /// <param name="abortMessage">The abort message, if any</param>
+        /// <param name="fault">The record's fault section; null or empty on iOS and in older records</param>
+        public static string Classify(string signalName, int? siCode, string faultAddress, string abortMessage, FaultRecord fault)
+        {
+            if (string.IsNullOrEmpty(signalName)) return null;
+
+            // JsonUtility fills in an empty section when the record has none
+            if (string.IsNullOrEmpty(fault?.pc)) fault = null;
+
+            switch (signalName)
+            {
+                case "SIGABRT":
+                    return string.IsNullOrEmpty(abortMessage) ? Abort : AbortWithMessage;
+                case "SIGPIPE":
+                    return BrokenPipe;
+                case "SIGTRAP":
+                    return Trap;
+            }
+
+            // si_code <= 0: sent with kill/tgkill/sigqueue, and si_addr means nothing
+            if (siCode.HasValue && siCode.Value <= 0) return SignalSent;
+
+            switch (signalName)
+            {
+                case "SIGSEGV":
+                    return ClassifySegv(siCode, faultAddress, fault);
+                case "SIGBUS":
+                    if (siCode == BusAdrAln) return MisalignedAccess;
+                    return TryParseAddress(faultAddress, out var busAddress) && busAddress < NullPageLimit
+                        ? NullDereference
+                        : BusError;
+                case "SIGFPE":
+                    return siCode == FpeIntDiv || siCode == FpeFltDiv ? DivisionByZero : ArithmeticError;
+                case "SIGILL":
+                    return IllegalInstruction;
+                default:
+                    return null;
+            }
+        }
+
+        private static string ClassifySegv(int? siCode, string faultAddress, FaultRecord fault)
+        {
+            if (!TryParseAddress(faultAddress, out var address)) return SegmentationFault;
+            if (address < NullPageLimit) return NullDereference;
+
+            if (fault == null)
+            {
+                // Without registers and maps, si_code is all there is
+                if (siCode == SegvMapErr) return UnmappedAccess;
+                if (siCode == SegvAccErr) return ProtectionFault;
+                return SegmentationFault;
+            }
+
+            var mapping = FindMapping(fault.maps, address);
+            var hasPc = TryParseAddress(fault.pc, out var pc);
+            var hasSp = TryParseAddress(fault.sp, out var sp) && sp != 0;
+
+            // The instruction fetch itself faulted
+            if (hasPc && pc == address && (mapping == null || !HasPermission(mapping, 'x'))) return ExecuteFault;
+
+            // Guard page, or the gap below the stack's mapping, next to sp
+            var inaccessible = mapping == null || mapping.perms == null || mapping.perms.StartsWith("---", StringComparison.Ordinal);
+            if (inaccessible && hasSp && IsBelowStack(fault, address, sp)) return StackOverflow;
+
+            if (mapping == null) return UnmappedAccess;
+            if (inaccessible || siCode == SegvAccErr) return ProtectionFault;
+            return siCode == SegvMapErr ? UnmappedAccess : SegmentationFault;
+        }
+
+        private static bool IsBelowStack(FaultRecord fault, ulong address, ulong sp)
+        {
+            if (address + StackReach >= sp && address <= sp + StackReach) return true;
+
+            // A large frame (alloca, big local arrays) can reach far past sp
+            return TryParseAddress(fault.stackStart, out var stackStart) &&
+                   address < stackStart && stackStart - address <= StackGuardGap;
+        }
+
+        private static MappingRecord FindMapping(MappingRecord[] maps, ulong address)
+        {
+            if (maps == null) return null;
+
+            foreach (var mapping in maps)
+            {
+                if (mapping != null &&
+                    TryParseAddress(mapping.start, out var start) &&
+                    TryParseAddress(mapping.end, out var end) &&
+                    address >= start && address < end)
+                {
+                    return mapping;
+                }
+            }
+            return null;
+        }
+
+        private static bool HasPermission(MappingRecord mapping, char permission)
+        {
+            return mapping.perms != null && mapping.perms.IndexOf(permission) >= 0;
+        }
+
+        /// <summary>
+        /// Parse an address as the native handlers print it: "0x7f12ab", "7f12ab" or "(nil)"
+        /// </summary>
+        public static bool TryParseAddress(string text, out ulong address)
+        {
+            address = 0;
+            if (string.IsNullOrEmpty(text)) return false;
+            if (text == "(nil)") return true;
+
+            if (text.StartsWith("0x", StringComparison.OrdinalIgnoreCase))
+            {
+                text = text.Substring(2);
+            }
+            return ulong.TryParse(text, NumberStyles.AllowHexSpecifier, CultureInfo.InvariantCulture, out address);
+        }
+    }
+}
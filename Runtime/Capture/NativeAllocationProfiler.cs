@@ -0,0 +1,171 @@
+using System;
+using System.Runtime.InteropServices;
+using UnityEngine;
+
+namespace MoonForge.ErrorTracking
+{
+    /// <summary>
+    /// Bridge to the sampled native allocation profiler (Android).
+    /// Records the call stack of roughly one allocation per sampling interval of
+    /// allocated bytes and attributes live sampled memory to call sites, so
+    /// low-memory reports can say what was holding native memory.
+    /// </summary>
+    public static class NativeAllocationProfiler
+    {
+        private const int SnapshotBufferSize = 16384;
+
+        #region Native Plugin Imports
+
+#if UNITY_ANDROID && !UNITY_EDITOR
+        private const string NativeLibrary = "moonforge_crash_handler";
+
+        [DllImport(NativeLibrary)]
+        private static extern int MoonForge_AllocProfiler_Start(int sampleIntervalBytes);
+
+        [DllImport(NativeLibrary)]
+        private static extern void MoonForge_AllocProfiler_Stop();
+
+        [DllImport(NativeLibrary)]
+        private static extern int MoonForge_AllocProfiler_IsRunning();
+
+        [DllImport(NativeLibrary)]
+        private static extern long MoonForge_AllocProfiler_GetSampledLiveBytes();
+
+        [DllImport(NativeLibrary)]
+        private static extern int MoonForge_AllocProfiler_Snapshot(byte[] buffer, int bufferSize, int maxSites);
+#endif
+
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+        // Part of the crash handler library on Linux too (abort message and log tail hooks)
+        [DllImport("moonforge_crash_handler")]
+        private static extern int MoonForge_PltHook_Refresh();
+#endif
+
+        #endregion
+
+        /// <summary>
+        /// Whether the profiler is sampling
+        /// </summary>
+        public static bool IsRunning
+        {
+            get
+            {
+#if UNITY_ANDROID && !UNITY_EDITOR
+                try
+                {
+                    return MoonForge_AllocProfiler_IsRunning() != 0;
+                }
+                catch (Exception)
+                {
+                    return false;
+                }
+#else
+                return false;
+#endif
+            }
+        }
+
+        /// <summary>
+        /// Start sampling native allocations
+        /// </summary>
+        public static bool Start(ErrorTrackerConfig config)
+        {
+#if UNITY_ANDROID && !UNITY_EDITOR
+            try
+            {
+                var started = MoonForge_AllocProfiler_Start(config.allocationSampleIntervalKb * 1024) != 0;
+                if (config.debugMode)
+                {
+                    Debug.Log($"[MoonForge] Allocation profiler {(started ? "started" : "unavailable")} (1 sample per {config.allocationSampleIntervalKb} KB)");
+                }
+                return started;
+            }
+            catch (Exception ex)
+            {
+                if (config.debugMode)
+                {
+                    Debug.LogWarning($"[MoonForge] Allocation profiler unavailable: {ex.Message}");
+                }
+                return false;
+            }
+#else
+            if (config.debugMode)
+            {
+                Debug.Log("[MoonForge] Allocation profiler not available on this platform");
+            }
+            return false;
+#endif
+        }
+
+        /// <summary>
+        /// Stop sampling. Recorded call sites are kept.
+        /// </summary>
+        public static void Stop()
+        {
+#if UNITY_ANDROID && !UNITY_EDITOR
+            try
+            {
+                MoonForge_AllocProfiler_Stop();
+            }
+            catch (Exception) { }
+#endif
+        }
+
+        /// <summary>
+        /// Install registered import hooks (allocator, log tail) in libraries loaded since they started
+        /// </summary>
+        public static void RefreshHooks()
+        {
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+            try
+            {
+                MoonForge_PltHook_Refresh();
+            }
+            catch (Exception) { }
+#endif
+        }
+
+        /// <summary>
+        /// Estimated native bytes held by sampled allocations
+        /// </summary>
+        public static long SampledLiveBytes
+        {
+            get
+            {
+#if UNITY_ANDROID && !UNITY_EDITOR
+                try
+                {
+                    return MoonForge_AllocProfiler_GetSampledLiveBytes();
+                }
+                catch (Exception)
+                {
+                    return 0;
+                }
+#else
+                return 0;
+#endif
+            }
+        }
+
+        /// <summary>
+        /// Top call sites by live sampled bytes, one stack per site, or null if the profiler isn't available
+        /// </summary>
+        public static string Snapshot(int maxSites = 10)
+        {
+#if UNITY_ANDROID && !UNITY_EDITOR
+            try
+            {
+                var buffer = new byte[SnapshotBufferSize];
+                var length = MoonForge_AllocProfiler_Snapshot(buffer, buffer.Length, maxSites);
+                return length > 0 ? System.Text.Encoding.UTF8.GetString(buffer, 0, length) : null;
+            }
+            catch (Exception)
+            {
+                return null;
+            }
+#else
+            return null;
+#endif
+        }
+    }
+}
@@ -0,0 +1,234 @@
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.Runtime.InteropServices;
+
+namespace MoonForge.ErrorTracking
+{
+    /// <summary>
+    /// Bridge to the native context store (Android, Linux standalone).
+    /// <see cref="ContextStore"/> mirrors every change here, so the native crash
+    /// handler can write the game state, user and tags of the crashed process into
+    /// the crash record. Entries are typed; keys over 63 bytes and strings over 255
+    /// bytes are cut, and the store holds at most 128 entries.
+    /// </summary>
+    public static class NativeContextStore
+    {
+        #region Native Plugin Imports
+
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+        private const string NativeLibrary = "moonforge_crash_handler";
+
+        [DllImport(NativeLibrary)]
+        private static extern int MoonForge_Context_SetString(int scope, string key, string value);
+
+        [DllImport(NativeLibrary)]
+        private static extern int MoonForge_Context_SetLong(int scope, string key, long value);
+
+        [DllImport(NativeLibrary)]
+        private static extern int MoonForge_Context_SetDouble(int scope, string key, double value);
+
+        [DllImport(NativeLibrary)]
+        private static extern int MoonForge_Context_SetBool(int scope, string key, int value);
+
+        [DllImport(NativeLibrary)]
+        private static extern int MoonForge_Context_Remove(int scope, string key);
+
+        [DllImport(NativeLibrary)]
+        private static extern int MoonForge_Context_Clear(int scope);
+#endif
+
+        #endregion
+
+        /// <summary>
+        /// The context section of a native crash record
+        /// </summary>
+        [Serializable]
+        public class ContextRecord
+        {
+            /// <summary>Store version the record was written at</summary>
+            public int version;
+            /// <summary>A change was in progress when the process crashed; one entry may be inconsistent</summary>
+            public bool torn;
+            public ContextRecordEntry[] entries;
+        }
+
+        [Serializable]
+        public class ContextRecordEntry
+        {
+            public int scope;
+            public int type;
+            public string key;
+            /// <summary>The value in its JSON spelling, whatever its type</summary>
+            public string value;
+        }
+
+        /// <summary>
+        /// Tag set on crash payloads whose context came from the record: the store version it was written at
+        /// </summary>
+        public const string VersionTag = "contextVersion";
+
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+        // Cleared on the first failed call, so a missing library costs one exception
+        private static bool _available = true;
+#endif
+
+        public static void SetString(ContextScope scope, string key, string value)
+        {
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+            if (!_available) return;
+            try
+            {
+                MoonForge_Context_SetString((int)scope, key, value);
+            }
+            catch (Exception)
+            {
+                _available = false;
+            }
+#endif
+        }
+
+        public static void SetLong(ContextScope scope, string key, long value)
+        {
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+            if (!_available) return;
+            try
+            {
+                MoonForge_Context_SetLong((int)scope, key, value);
+            }
+            catch (Exception)
+            {
+                _available = false;
+            }
+#endif
+        }
+
+        public static void SetDouble(ContextScope scope, string key, double value)
+        {
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+            if (!_available) return;
+            try
+            {
+                MoonForge_Context_SetDouble((int)scope, key, value);
+            }
+            catch (Exception)
+            {
+                _available = false;
+            }
+#endif
+        }
+
+        public static void SetBool(ContextScope scope, string key, bool value)
+        {
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+            if (!_available) return;
+            try
+            {
+                MoonForge_Context_SetBool((int)scope, key, value ? 1 : 0);
+            }
+            catch (Exception)
+            {
+                _available = false;
+            }
+#endif
+        }
+
+        public static void Remove(ContextScope scope, string key)
+        {
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+            if (!_available) return;
+            try
+            {
+                MoonForge_Context_Remove((int)scope, key);
+            }
+            catch (Exception)
+            {
+                _available = false;
+            }
+#endif
+        }
+
+        public static void Clear(ContextScope scope)
+        {
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+            if (!_available) return;
+            try
+            {
+                MoonForge_Context_Clear((int)scope);
+            }
+            catch (Exception)
+            {
+                _available = false;
+            }
+#endif
+        }
+
+        /// <summary>
+        /// Fill the game state, user and tags of a crash payload from the record's context
+        /// and tag it with <see cref="VersionTag"/>. Returns false (and leaves the payload
+        /// alone) if the record has none.
+        /// </summary>
+        public static bool Apply(ErrorPayloadInner payload, ContextRecord record)
+        {
+            if (record?.entries == null || record.entries.Length == 0) return false;
+
+            var gameState = new GameState();
+            // A copy: the payload's tags may be shared with other payloads
+            var tags = payload.tags != null
+                ? new Dictionary<string, string>(payload.tags)
+                : new Dictionary<string, string>();
+            foreach (var entry in record.entries)
+            {
+                if (string.IsNullOrEmpty(entry?.key)) continue;
+
+                switch ((ContextScope)entry.scope)
+                {
+                    case ContextScope.GameState:
+                        if (entry.key == ContextStore.SceneNameKey) gameState.sceneName = SdkStringTable.Intern(entry.value);
+                        else if (entry.key == ContextStore.GameModeKey) gameState.gameMode = entry.value;
+                        else if (entry.key == ContextStore.LevelIdKey) gameState.levelId = entry.value;
+                        break;
+                    case ContextScope.CustomData:
+                        if (gameState.customData == null) gameState.customData = new Dictionary<string, object>();
+                        gameState.customData[entry.key] = ParseValue(entry);
+                        break;
+                    case ContextScope.User:
+                        if (entry.key == ContextStore.UserIdKey) payload.userId = entry.value;
+                        break;
+                    case ContextScope.Tag:
+                        tags[entry.key] = entry.value ?? "";
+                        break;
+                }
+            }
+
+            tags[VersionTag] = record.version.ToString(CultureInfo.InvariantCulture);
+            if (record.torn)
+            {
+                tags["contextTorn"] = "true";
+            }
+            payload.gameState = gameState;
+            payload.tags = tags;
+            return true;
+        }
+
+        private static object ParseValue(ContextRecordEntry entry)
+        {
+            var text = entry.value ?? "";
+            switch ((ContextValueType)entry.type)
+            {
+                case ContextValueType.Long:
+                    return long.TryParse(text, NumberStyles.Integer, CultureInfo.InvariantCulture, out var integer)
+                        ? (object)integer
+                        : text;
+                case ContextValueType.Double:
+                    return double.TryParse(text, NumberStyles.Float, CultureInfo.InvariantCulture, out var number)
+                        ? (object)number
+                        : text;
+                case ContextValueType.Bool:
+                    return text == "true";
+                default:
+                    return text;
+            }
+        }
+    }
+}
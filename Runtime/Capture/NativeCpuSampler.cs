@@ -0,0 +1,138 @@
+using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+using UnityEngine;
+
+namespace MoonForge.ErrorTracking
+{
+    /// <summary>
+    /// Bridge to the native per-thread CPU sampler (Android, Linux standalone).
+    /// Each <see cref="Sample"/> reads utime/stime for the process and every
+    /// thread from /proc and publishes the busiest threads of the interval, which
+    /// the crash handler copies into crash records.
+    /// </summary>
+    public static class NativeCpuSampler
+    {
+        private const int TopThreadsBufferSize = 4096;
+
+        #region Native Plugin Imports
+
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+        private const string NativeLibrary = "moonforge_crash_handler";
+
+        [DllImport(NativeLibrary)]
+        private static extern float MoonForge_CpuSampler_Sample();
+
+        [DllImport(NativeLibrary)]
+        private static extern float MoonForge_CpuSampler_GetProcessPercent();
+
+        [DllImport(NativeLibrary)]
+        private static extern int MoonForge_CpuSampler_GetTopThreads(byte[] buffer, int bufferSize, int maxThreads);
+#endif
+
+        #endregion
+
+        [Serializable]
+        private class ThreadCpuList
+        {
+            public ThreadCpuUsage[] items;
+        }
+
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+        private static bool _isAvailable = true;
+#endif
+
+        /// <summary>
+        /// Whether the platform has a sampler
+        /// </summary>
+        public static bool IsSupported
+        {
+            get
+            {
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+                return _isAvailable;
+#else
+                return false;
+#endif
+            }
+        }
+
+        /// <summary>
+        /// Take one sample. Reads /proc, so call it from the worker thread.
+        /// </summary>
+        public static void Sample()
+        {
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+            if (!_isAvailable) return;
+
+            try
+            {
+                MoonForge_CpuSampler_Sample();
+            }
+            catch (Exception)
+            {
+                // Library missing (e.g. Linux player built without the plugin)
+                _isAvailable = false;
+            }
+#endif
+        }
+
+        /// <summary>
+        /// Process CPU usage over the last sampling interval in percent of all cores, or null before two samples
+        /// </summary>
+        public static float? ProcessCpuPercent
+        {
+            get
+            {
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+                if (!_isAvailable) return null;
+
+                try
+                {
+                    var percent = MoonForge_CpuSampler_GetProcessPercent();
+                    return percent >= 0 ? percent : (float?)null;
+                }
+                catch (Exception)
+                {
+                    _isAvailable = false;
+                    return null;
+                }
+#else
+                return null;
+#endif
+            }
+        }
+
+        /// <summary>
+        /// Busiest threads over the last sampling interval, busiest first, or null before two samples
+        /// </summary>
+        public static List<ThreadCpuUsage> TopThreads(int maxThreads = 8)
+        {
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+            if (!_isAvailable) return null;
+
+            try
+            {
+                var buffer = new byte[TopThreadsBufferSize];
+                var length = MoonForge_CpuSampler_GetTopThreads(buffer, buffer.Length, maxThreads);
+                if (length <= 0) return null;
+
+                return ParseThreadList(System.Text.Encoding.UTF8.GetString(buffer, 0, length));
+            }
+            catch (Exception)
+            {
+                return null;
+            }
+#else
+            return null;
+#endif
+        }
+
+        private static List<ThreadCpuUsage> ParseThreadList(string json)
+        {
+            // JsonUtility can't read a top-level array
+            var list = JsonUtility.FromJson<ThreadCpuList>("{\"items\":" + json + "}");
+            return list?.items != null && list.items.Length > 0 ? new List<ThreadCpuUsage>(list.items) : null;
+        }
+    }
+}
@@ -1,5 +1,6 @@
 using System;
 using System.Collections.Generic;
+using System.IO;
 using System.Runtime.InteropServices;
 using UnityEngine;
 using AOT;
@@ -7,13 +8,14 @@ using AOT;
 namespace MoonForge.ErrorTracking
 {
     /// <summary>
-    /// Bridge to native crash handlers for iOS and Android.
+    /// Bridge to native crash handlers for iOS, Android and Linux standalone players.
     /// Captures native crashes (SIGSEGV, SIGABRT, etc.) that can't be caught by managed code.
     /// </summary>
     public class NativeCrashHandler
     {
         private static NativeCrashHandler _instance;
         private static bool _isInitialized;
+        private static string _crashDirectory;
 
         private readonly ErrorTrackerConfig _config;
         private readonly Action<ErrorPayloadInner> _onCrashCaptured;
@@ -24,6 +26,11 @@ namespace MoonForge.ErrorTracking
         public static NativeCrashHandler Instance => _instance;
         public static bool IsInitialized => _isInitialized;
 
+        /// <summary>
+        /// Where native records are written for the next launch (Android, Linux), or null
+        /// </summary>
+        public static string CrashDirectory => _crashDirectory;
+
         #region Native Plugin Imports
 
 #if UNITY_IOS && !UNITY_EDITOR
@@ -56,6 +63,27 @@ namespace MoonForge.ErrorTracking
         // Android uses JNI bridge through Java class
         private static AndroidJavaObject _crashHandlerJava;
 
+#elif UNITY_STANDALONE_LINUX && !UNITY_EDITOR
+        private delegate void CrashCallbackDelegate(string crashJson);
+
+        // Built from the Android sources by Plugins/Linux/Makefile
+        private const string NativeLibrary = "moonforge_crash_handler";
+
+        [DllImport(NativeLibrary)]
+        private static extern void MoonForge_InitializeCrashHandler(CrashCallbackDelegate callback);
+
+        [DllImport(NativeLibrary)]
+        private static extern void MoonForge_ShutdownCrashHandler();
+
+        [DllImport(NativeLibrary)]
+        private static extern int MoonForge_IsCrashHandlerInitialized();
+
+        [DllImport(NativeLibrary)]
+        private static extern void MoonForge_SetCrashDirectory(string path);
+
+        [DllImport(NativeLibrary)]
+        private static extern void MoonForge_SimulateCrash(int crashType);
+
 #else
         // Editor/Standalone - no-op
         private delegate void CrashCallbackDelegate(string crashJson);
@@ -86,6 +114,8 @@ namespace MoonForge.ErrorTracking
             InitializeIOS();
 #elif UNITY_ANDROID && !UNITY_EDITOR
             InitializeAndroid();
+#elif UNITY_STANDALONE_LINUX && !UNITY_EDITOR
+            InitializeLinux();
 #else
             if (config.debugMode)
             {
@@ -112,10 +142,13 @@ namespace MoonForge.ErrorTracking
             MoonForge_ShutdownCrashHandler();
 #elif UNITY_ANDROID && !UNITY_EDITOR
             ShutdownAndroid();
+#elif UNITY_STANDALONE_LINUX && !UNITY_EDITOR
+            ShutdownLinux();
 #endif
 
             _instance = null;
             _isInitialized = false;
+            _crashDirectory = null;
         }
 
         #region iOS Implementation
@@ -214,8 +247,10 @@ namespace MoonForge.ErrorTracking
                     }
                 }
 
-                // Set up Java crash callback using Unity's Application.logMessageReceived
-                // Native crashes are handled by the native library directly
+                // The process doesn't survive a native crash, so the handler writes a record
+                // that is reported on the next launch
+                _crashDirectory = _crashHandlerJava?.Call<string>("getCrashDirectory");
+                _instance.ProcessPendingCrashRecords(_crashDirectory);
             }
             catch (Exception ex)
             {
@@ -299,8 +334,130 @@ namespace MoonForge.ErrorTracking
 
         #endregion
 
+        #region Linux Implementation
+
+#if UNITY_STANDALONE_LINUX && !UNITY_EDITOR
+        private static void InitializeLinux()
+        {
+            try
+            {
+                var crashDirectory = Path.Combine(Application.persistentDataPath, "moonforge", "crashes");
+                Directory.CreateDirectory(crashDirectory);
+
+                // Same model as Android: no managed callback from the signal handler,
+                // the record on disk is reported on the next launch
+                MoonForge_SetCrashDirectory(crashDirectory);
+                MoonForge_InitializeCrashHandler(null);
+
+                _instance.ProcessPendingCrashRecords(crashDirectory);
+                _crashDirectory = crashDirectory;
+            }
+            catch (Exception ex)
+            {
+                Debug.LogError($"[MoonForge] Failed to initialize Linux crash handler: {ex.Message}");
+            }
+        }
+
+        private static void ShutdownLinux()
+        {
+            try
+            {
+                MoonForge_ShutdownCrashHandler();
+            }
+            catch (Exception ex)
+            {
+                Debug.LogError($"[MoonForge] Failed to shutdown Linux crash handler: {ex.Message}");
+            }
+        }
+#endif
+
+        #endregion
+
         #region Crash Processing
 
+        /// <summary>
+        /// Report crash and hang records left by a previous run and delete them
+        /// </summary>
+        private void ProcessPendingCrashRecords(string directory)
+        {
+            if (string.IsNullOrEmpty(directory) || !Directory.Exists(directory))
+            {
+                return;
+            }
+
+            foreach (var path in Directory.GetFiles(directory, "crash_*.json"))
+            {
+                try
+                {
+                    ProcessNativeCrash(File.ReadAllText(path));
+                }
+                catch (Exception ex)
+                {
+                    Debug.LogError($"[MoonForge] Failed to read crash record: {ex.Message}");
+                }
+
+                try { File.Delete(path); } catch { }
+            }
+
+            ProcessHangRecords(directory);
+
+            // Records interrupted mid-write are never completed
+            foreach (var pattern in new[] { "crash_*.tmp", "hang_*.tmp" })
+            {
+                foreach (var path in Directory.GetFiles(directory, pattern))
+                {
+                    try { File.Delete(path); } catch { }
+                }
+            }
+        }
+
+        /// <summary>
+        /// Report the crash and hang records in directory as if a previous run had left them, and
+        /// delete them. The error storm harness uses it to replay crash loops in the Editor.
+        /// </summary>
+        public static void ReplayCrashRecords(string directory)
+        {
+            _instance?.ProcessPendingCrashRecords(directory);
+        }
+
+        /// <summary>
+        /// Report hang records written by <see cref="NativeLockMonitor"/> in this run.
+        /// Call from the main thread; once it runs again the hang is over.
+        /// </summary>
+        public static void ReportHangRecords()
+        {
+            try
+            {
+                _instance?.ProcessHangRecords(_crashDirectory);
+            }
+            catch (Exception ex)
+            {
+                Debug.LogError($"[MoonForge] Failed to report hang records: {ex.Message}");
+            }
+        }
+
+        private void ProcessHangRecords(string directory)
+        {
+            if (string.IsNullOrEmpty(directory) || !Directory.Exists(directory))
+            {
+                return;
+            }
+
+            foreach (var path in Directory.GetFiles(directory, "hang_*.json"))
+            {
+                try
+                {
+                    ProcessHang(File.ReadAllText(path));
+                }
+                catch (Exception ex)
+                {
+                    Debug.LogError($"[MoonForge] Failed to read hang record: {ex.Message}");
+                }
+
+                try { File.Delete(path); } catch { }
+            }
+        }
+
         private void ProcessNativeCrash(string crashJson)
         {
             if (string.IsNullOrEmpty(crashJson))
@@ -327,9 +484,16 @@ namespace MoonForge.ErrorTracking
                     errorCategory = "native",
                     errorLevel = "fatal",
                     message = BuildCrashMessage(crashData),
-                    exceptionClass = crashData.signalName ?? crashData.exceptionName,
+                    exceptionClass = SdkStringTable.Intern(crashData.signalName ?? crashData.exceptionName),
+                    faultClass = FaultClassifier.Classify(
+                        crashData.signalName,
+                        crashData.siCode != NativeCrashData.NoSiCode ? crashData.siCode : (int?)null,
+                        crashData.faultAddress,
+                        crashData.abortMessage,
+                        crashData.fault),
                     rawStackTrace = BuildRawStackTrace(crashData),
-                    frames = ParseNativeFrames(crashData),
+                    logTail = string.IsNullOrEmpty(crashData.logTail) ? null : crashData.logTail,
+                    frames = ParseNativeFrames(crashData.frames),
                     device = DeviceContextCollector.Instance.Collect(),
                     network = DeviceContextCollector.Instance.CollectNetworkContext(),
                     gameState = GameStateCollector.Instance.Collect(),
@@ -337,9 +501,22 @@ namespace MoonForge.ErrorTracking
                     buildNumber = GetBuildNumber(),
                     unityVersion = Application.unityVersion,
                     breadcrumbs = BreadcrumbTracker.Instance.GetBreadcrumbs(),
-                    timestamp = DateTimeOffset.UtcNow.ToUnixTimeMilliseconds()
+                    timestamp = crashData.timestamp > 0 ? crashData.timestamp : DateTimeOffset.UtcNow.ToUnixTimeMilliseconds()
                 };
 
+                // The record describes the crashed process, not this one
+                if (payload.device != null)
+                {
+                    payload.device.cpuUsagePercent = crashData.cpuUsagePercent >= 0 ? crashData.cpuUsagePercent : (float?)null;
+                    payload.device.threadCpu = crashData.threadCpu != null && crashData.threadCpu.Length > 0
+                        ? new List<ThreadCpuUsage>(crashData.threadCpu)
+                        : null;
+                    NativeDeviceSampler.Apply(payload.device, crashData.deviceState);
+                }
+
+                // Game state as it was at the crash; without a context section the current one stands in
+                NativeContextStore.Apply(payload, crashData.context);
+
                 // Notify the error tracker
                 _onCrashCaptured?.Invoke(payload);
             }
@@ -349,10 +526,146 @@ namespace MoonForge.ErrorTracking
             }
         }
 
+        private void ProcessHang(string hangJson)
+        {
+            if (string.IsNullOrEmpty(hangJson)) return;
+
+            if (_config.debugMode)
+            {
+                Debug.Log($"[MoonForge] Processing hang: {hangJson.Substring(0, Math.Min(200, hangJson.Length))}...");
+            }
+
+            try
+            {
+                var hangData = JsonUtility.FromJson<NativeHangData>(hangJson);
+                var isDeadlock = hangData.kind == "deadlock";
+                var first = hangData.threads != null && hangData.threads.Length > 0 ? hangData.threads[0] : null;
+
+                // A deadlock never resolves; a long wait did, or the process was killed during it
+                var payload = new ErrorPayloadInner
+                {
+                    game = _config.gameId,
+                    errorType = isDeadlock ? "crash" : "custom",
+                    errorCategory = "native",
+                    errorLevel = isDeadlock ? "fatal" : "error",
+                    message = BuildHangMessage(hangData),
+                    exceptionClass = isDeadlock ? "Deadlock" : hangData.kind == "lock_wait" ? "LockWait" : "ConditionWait",
+                    rawStackTrace = BuildHangStackTrace(hangData),
+                    frames = ParseNativeFrames(first?.frames),
+                    device = DeviceContextCollector.Instance.Collect(),
+                    network = DeviceContextCollector.Instance.CollectNetworkContext(),
+                    gameState = GameStateCollector.Instance.Collect(),
+                    appVersion = Application.version,
+                    buildNumber = GetBuildNumber(),
+                    unityVersion = Application.unityVersion,
+                    breadcrumbs = BreadcrumbTracker.Instance.GetBreadcrumbs(),
+                    timestamp = hangData.timestamp > 0 ? hangData.timestamp : DateTimeOffset.UtcNow.ToUnixTimeMilliseconds()
+                };
+
+                // Game state as it was at the hang
+                NativeContextStore.Apply(payload, hangData.context);
+
+                _onCrashCaptured?.Invoke(payload);
+            }
+            catch (Exception ex)
+            {
+                Debug.LogError($"[MoonForge] Failed to process hang: {ex.Message}\n{ex.StackTrace}");
+            }
+        }
+
+        private static string DescribeThread(NativeHangThread thread)
+        {
+            if (thread.main) return "main thread";
+            return string.IsNullOrEmpty(thread.name) ? $"thread {thread.tid}" : $"{thread.name} ({thread.tid})";
+        }
+
+        private string BuildHangMessage(NativeHangData hangData)
+        {
+            var threads = hangData.threads ?? new NativeHangThread[0];
+            var chainLength = Math.Min(hangData.chainLength, threads.Length);
+            if (chainLength == 0)
+            {
+                return $"Native hang: {hangData.blockedMs} ms";
+            }
+
+            // "main thread -> Loader (1235)": each thread waits for a lock the next one holds
+            var chain = DescribeThread(threads[0]);
+            for (var i = 1; i < chainLength; i++)
+            {
+                chain += $" -> {DescribeThread(threads[i])}";
+            }
+
+            if (hangData.kind == "deadlock")
+            {
+                if (hangData.cycleStart >= 0 && hangData.cycleStart < chainLength)
+                {
+                    chain += $" -> {DescribeThread(threads[hangData.cycleStart])}";
+                }
+                return $"Deadlock for {hangData.blockedMs} ms: {chain}";
+            }
+
+            if (hangData.kind == "condition_wait")
+            {
+                return $"Main thread blocked {hangData.blockedMs} ms waiting on a condition variable";
+            }
+            // Without a recorded owner the chain is the main thread alone
+            return chainLength > 1
+                ? $"Main thread blocked {hangData.blockedMs} ms waiting on a mutex: {chain}"
+                : $"Main thread blocked {hangData.blockedMs} ms waiting on a mutex";
+        }
+
+        private string BuildHangStackTrace(NativeHangData hangData)
+        {
+            if (hangData.threads == null || hangData.threads.Length == 0)
+            {
+                return null;
+            }
+
+            var lines = new List<string>();
+            foreach (var thread in hangData.threads)
+            {
+                if (lines.Count > 0)
+                {
+                    lines.Add("");
+                }
+
+                var header = $"Thread {thread.tid}";
+                if (!string.IsNullOrEmpty(thread.name)) header += $" \"{thread.name}\"";
+                if (thread.main) header += " (main)";
+                switch (thread.wait)
+                {
+                    case "mutex":
+                        header += thread.owner > 0
+                            ? $" waiting {thread.waitedMs} ms for mutex {thread.@lock} held by thread {thread.owner}"
+                            : $" waiting {thread.waitedMs} ms for mutex {thread.@lock}";
+                        break;
+                    case "condition":
+                        header += $" waiting {thread.waitedMs} ms on condition {thread.@lock}";
+                        break;
+                    default:
+                        header += " running";
+                        break;
+                }
+                if (thread.heldLocks > 0)
+                {
+                    header += $", holding {thread.heldLocks} lock{(thread.heldLocks == 1 ? "" : "s")}";
+                }
+                lines.Add(header);
+                AppendFrames(lines, thread.frames);
+            }
+
+            return string.Join("\n", lines);
+        }
+
         private string BuildCrashMessage(NativeCrashData crashData)
         {
             if (!string.IsNullOrEmpty(crashData.signalName))
             {
+                // The abort reason identifies the crash far better than "Abort signal"
+                if (!string.IsNullOrEmpty(crashData.abortMessage))
+                {
+                    return $"{crashData.signalName}: {crashData.abortMessage}";
+                }
                 return $"{crashData.signalName}: {crashData.signalDescription ?? "Native crash"}";
             }
             if (!string.IsNullOrEmpty(crashData.exceptionName))
@@ -370,8 +683,31 @@ namespace MoonForge.ErrorTracking
             }
 
             var lines = new List<string>();
-            foreach (var frame in crashData.frames)
+            if (crashData.frameCount > 0)
+            {
+                lines.Add($"{crashData.frameCount} frames");
+            }
+            AppendFrames(lines, crashData.frames);
+
+            return string.Join("\n", lines);
+        }
+
+        private static void AppendFrames(List<string> lines, NativeStackFrame[] frames)
+        {
+            if (frames == null || frames.Length == 0)
             {
+                return;
+            }
+
+            // Depth of the next frame if nothing was left out
+            var expectedFrame = frames[0].frame;
+            foreach (var frame in frames)
+            {
+                if (frame.frame > expectedFrame)
+                {
+                    lines.Add($"... {frame.frame - expectedFrame} frames omitted ...");
+                }
+
                 var line = $"#{frame.frame} {frame.address}";
                 if (!string.IsNullOrEmpty(frame.module))
                 {
@@ -385,26 +721,34 @@ namespace MoonForge.ErrorTracking
                         line += $"+{frame.offset}";
                     }
                 }
+                if (frame.repeat > 1)
+                {
+                    // Native records fold recursion: this frame and the next cycleLength - 1 repeat
+                    line += $" (frames #{frame.frame}-#{frame.frame + frame.cycleLength - 1} repeated {frame.repeat} times)";
+                    expectedFrame = frame.frame + frame.cycleLength * frame.repeat;
+                }
+                else
+                {
+                    expectedFrame = Math.Max(expectedFrame, frame.frame + 1);
+                }
                 lines.Add(line);
             }
-
-            return string.Join("\n", lines);
         }
 
-        private List<StackFrame> ParseNativeFrames(NativeCrashData crashData)
+        private List<StackFrame> ParseNativeFrames(NativeStackFrame[] nativeFrames)
         {
-            if (crashData.frames == null || crashData.frames.Length == 0)
+            if (nativeFrames == null || nativeFrames.Length == 0)
             {
                 return null;
             }
 
             var frames = new List<StackFrame>();
-            foreach (var nativeFrame in crashData.frames)
+            foreach (var nativeFrame in nativeFrames)
             {
                 var frame = new StackFrame
                 {
-                    module = nativeFrame.module,
-                    function = nativeFrame.symbol,
+                    module = SdkStringTable.Intern(nativeFrame.module),
+                    function = SdkStringTable.Intern(nativeFrame.symbol),
                     instructionAddress = nativeFrame.address,
                     inApp = IsInAppFrame(nativeFrame)
                 };
@@ -482,6 +826,8 @@ namespace MoonForge.ErrorTracking
             MoonForge_SimulateCrash(crashType);
 #elif UNITY_ANDROID && !UNITY_EDITOR
             _crashHandlerJava?.Call("simulateCrash", crashType);
+#elif UNITY_STANDALONE_LINUX && !UNITY_EDITOR
+            MoonForge_SimulateCrash(crashType);
 #else
             Debug.Log("[MoonForge] Crash simulation not available on this platform");
 #endif
@@ -500,14 +846,68 @@ namespace MoonForge.ErrorTracking
             public string signalDescription;
             public string faultAddress;
             public long threadId;
-            public int siCode;
+            // Not written by the iOS handler
+            public const int NoSiCode = int.MinValue;
+            public int siCode = NoSiCode;
+
+            // Registers, stack bounds and memory mappings around the fault (Android, Linux)
+            public FaultClassifier.FaultRecord fault;
+
+            public string abortMessage;
+            public string logTail;
+            public long timestamp;
+
+            // CPU attribution from the last sample before the crash (-1 = not sampled)
+            public float cpuUsagePercent = -1f;
+            public ThreadCpuUsage[] threadCpu;
+
+            // Thermal, frequency and battery state from the last device sample
+            public NativeDeviceSampler.DeviceState deviceState;
+
+            // Game state, user and tags of the crashed process
+            public NativeContextStore.ContextRecord context;
 
             // NSException fields (iOS)
             public string exceptionType;
             public string exceptionName;
             public string exceptionReason;
 
-            // Stack frames
+            // Stack frames; frameCount is the full depth, of which long stacks keep the top and bottom
+            public int frameCount;
+            public NativeStackFrame[] frames;
+        }
+
+        [Serializable]
+        private class NativeHangData
+        {
+            public long timestamp;
+
+            // "deadlock", "lock_wait" or "condition_wait"
+            public string kind;
+            public long blockedMs;
+            public int sampleRate;
+
+            // threads starts with the wait chain; its last thread waits for the one at cycleStart (-1 = no cycle)
+            public int chainLength;
+            public int cycleStart = -1;
+
+            public NativeContextStore.ContextRecord context;
+            public NativeHangThread[] threads;
+        }
+
+        [Serializable]
+        private class NativeHangThread
+        {
+            public long tid;
+            public string name;
+            public bool main;
+
+            // "mutex", "condition" or "none"
+            public string wait;
+            public string @lock;
+            public long owner;
+            public long waitedMs;
+            public int heldLocks;
             public NativeStackFrame[] frames;
         }
 
@@ -519,6 +919,10 @@ namespace MoonForge.ErrorTracking
             public string module;
             public string symbol;
             public string offset;
+
+            // Set on the first frame of a recursion cycle: the cycle's length in frames and how often it repeats
+            public int cycleLength;
+            public int repeat;
         }
 
         #endregion
@@ -0,0 +1,235 @@
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.Runtime.InteropServices;
+using UnityEngine;
+
+namespace MoonForge.ErrorTracking
+{
+    /// <summary>
+    /// Bridge to the native device sampler (Android, Linux standalone).
+    /// Each <see cref="Sample"/> reads thermal zone temperatures, per-cluster CPU
+    /// frequencies and battery state from sysfs, keeps the latest state for error
+    /// payloads and turns notable changes (frequency caps, temperature steps,
+    /// charger and low battery) into breadcrumbs. The crash handler copies the
+    /// last sample into crash records.
+    /// </summary>
+    public static class NativeDeviceSampler
+    {
+        private const int StateBufferSize = 1024;
+
+        // A cluster capped below this share of its top frequency counts as throttled
+        private const float ThrottledCapPercent = 95f;
+        // Cap changes smaller than this while throttled are not reported again
+        private const float CapStepPercent = 10f;
+        private const float TemperatureStepC = 5f;
+        private const float HotTemperatureC = 45f;
+        private static readonly int[] LowBatteryThresholds = { 20, 10, 5 };
+
+        #region Native Plugin Imports
+
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+        private const string NativeLibrary = "moonforge_crash_handler";
+
+        [DllImport(NativeLibrary)]
+        private static extern int MoonForge_DeviceSampler_Sample();
+
+        [DllImport(NativeLibrary)]
+        private static extern int MoonForge_DeviceSampler_GetState(byte[] buffer, int bufferSize);
+#endif
+
+        #endregion
+
+        /// <summary>
+        /// One device sample as written by the native sampler
+        /// </summary>
+        [Serializable]
+        public class DeviceState
+        {
+            /// <summary>Hottest thermal zone, -1000 if unknown</summary>
+            public float temperatureC = -1000f;
+            public string hottestZone;
+            /// <summary>Lowest frequency cap across clusters in percent of the cluster's top frequency, -1 if unknown</summary>
+            public float cpuFrequencyCapPercent = -1f;
+            public int batteryPercent = -1;
+            /// <summary>1 charging or full, 0 discharging, -1 unknown</summary>
+            public int batteryCharging = -1;
+            public float batteryTemperatureC = -1000f;
+            public CpuClusterFrequency[] clusters;
+
+            public bool HasTemperature => temperatureC > -273f;
+            public bool HasBatteryTemperature => batteryTemperatureC > -273f;
+        }
+
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+        private static bool _isAvailable = true;
+#endif
+        private static volatile DeviceState _latest;
+        private static DeviceState _reported;
+
+        /// <summary>
+        /// Whether the platform has a sampler
+        /// </summary>
+        public static bool IsSupported
+        {
+            get
+            {
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+                return _isAvailable;
+#else
+                return false;
+#endif
+            }
+        }
+
+        /// <summary>
+        /// Latest sample, or null before the first one
+        /// </summary>
+        public static DeviceState Latest => _latest;
+
+        /// <summary>
+        /// Take one sample and add breadcrumbs for notable changes. Reads sysfs, so call it from the worker thread.
+        /// </summary>
+        public static void Sample()
+        {
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+            if (!_isAvailable) return;
+
+            try
+            {
+                if (MoonForge_DeviceSampler_Sample() == 0)
+                {
+                    // Nothing readable (SELinux, containers); don't keep polling
+                    _isAvailable = false;
+                    return;
+                }
+
+                var buffer = new byte[StateBufferSize];
+                var length = MoonForge_DeviceSampler_GetState(buffer, buffer.Length);
+                if (length <= 0) return;
+
+                var state = JsonUtility.FromJson<DeviceState>(System.Text.Encoding.UTF8.GetString(buffer, 0, length));
+                AddChangeBreadcrumbs(_reported, state);
+                _latest = state;
+            }
+            catch (Exception)
+            {
+                // Library missing (e.g. Linux player built without the plugin)
+                _isAvailable = false;
+            }
+#endif
+        }
+
+        /// <summary>
+        /// Copy a sample into a device context. Battery level, charging and thermal state from
+        /// Unity and PowerManager take precedence; the sample only fills them when they are missing.
+        /// </summary>
+        public static void Apply(DeviceContext context, DeviceState state)
+        {
+            if (context == null || state == null) return;
+
+            context.temperatureC = state.HasTemperature ? state.temperatureC : (float?)null;
+            context.cpuFrequencyCapPercent = state.cpuFrequencyCapPercent >= 0 ? state.cpuFrequencyCapPercent : (float?)null;
+            context.batteryTemperatureC = state.HasBatteryTemperature ? state.batteryTemperatureC : (float?)null;
+            context.cpuClusters = state.clusters != null && state.clusters.Length > 0
+                ? new List<CpuClusterFrequency>(state.clusters)
+                : null;
+
+            if (!context.batteryLevel.HasValue && state.batteryPercent >= 0)
+                context.batteryLevel = state.batteryPercent;
+            if (!context.batteryCharging.HasValue && state.batteryCharging >= 0)
+                context.batteryCharging = state.batteryCharging == 1;
+            if (context.thermalState == null)
+                context.thermalState = ThermalStateFromTemperature(state);
+        }
+
+        /// <summary>
+        /// Coarse thermal state for devices without PowerManager thermal status
+        /// </summary>
+        private static string ThermalStateFromTemperature(DeviceState state)
+        {
+            if (!state.HasTemperature) return null;
+            if (state.temperatureC >= 55f) return "critical";
+            if (state.temperatureC >= 48f) return "serious";
+            if (state.temperatureC >= 40f) return "fair";
+            return "nominal";
+        }
+
+        private static void AddChangeBreadcrumbs(DeviceState previous, DeviceState current)
+        {
+            // The first sample is the baseline; only a throttled start is worth a breadcrumb
+            var reported = previous ?? new DeviceState
+            {
+                temperatureC = current.temperatureC,
+                cpuFrequencyCapPercent = 100f,
+                batteryPercent = current.batteryPercent,
+                batteryCharging = current.batteryCharging
+            };
+            var next = new DeviceState
+            {
+                temperatureC = reported.temperatureC,
+                cpuFrequencyCapPercent = reported.cpuFrequencyCapPercent,
+                batteryPercent = current.batteryPercent,
+                batteryCharging = current.batteryCharging
+            };
+
+            if (current.cpuFrequencyCapPercent >= 0)
+            {
+                var wasThrottled = reported.cpuFrequencyCapPercent < ThrottledCapPercent;
+                var isThrottled = current.cpuFrequencyCapPercent < ThrottledCapPercent;
+
+                if (isThrottled && (!wasThrottled || Math.Abs(current.cpuFrequencyCapPercent - reported.cpuFrequencyCapPercent) >= CapStepPercent))
+                {
+                    Add($"CPU frequency capped at {Format(current.cpuFrequencyCapPercent)}% of max{DescribeTemperature(current)}", BreadcrumbLevel.Warning);
+                    next.cpuFrequencyCapPercent = current.cpuFrequencyCapPercent;
+                }
+                else if (!isThrottled && wasThrottled)
+                {
+                    Add($"CPU frequency cap lifted{DescribeTemperature(current)}", BreadcrumbLevel.Info);
+                    next.cpuFrequencyCapPercent = current.cpuFrequencyCapPercent;
+                }
+            }
+
+            if (current.HasTemperature && (!reported.HasTemperature || Math.Abs(current.temperatureC - reported.temperatureC) >= TemperatureStepC))
+            {
+                var level = current.temperatureC >= HotTemperatureC ? BreadcrumbLevel.Warning : BreadcrumbLevel.Info;
+                Add($"Device temperature {Format(current.temperatureC)}°C ({current.hottestZone})", level);
+                next.temperatureC = current.temperatureC;
+            }
+
+            if (current.batteryCharging >= 0 && reported.batteryCharging >= 0 && current.batteryCharging != reported.batteryCharging)
+            {
+                Add(current.batteryCharging == 1 ? "Battery charging" : "Battery discharging", BreadcrumbLevel.Info);
+            }
+
+            if (current.batteryCharging == 0 && current.batteryPercent >= 0 && reported.batteryPercent >= 0)
+            {
+                foreach (var threshold in LowBatteryThresholds)
+                {
+                    if (current.batteryPercent <= threshold && reported.batteryPercent > threshold)
+                    {
+                        Add($"Battery low ({current.batteryPercent}%)", BreadcrumbLevel.Warning);
+                        break;
+                    }
+                }
+            }
+
+            _reported = next;
+        }
+
+        private static string DescribeTemperature(DeviceState state)
+        {
+            return state.HasTemperature ? $" at {Format(state.temperatureC)}°C" : "";
+        }
+
+        private static string Format(float value)
+        {
+            return value.ToString("0", CultureInfo.InvariantCulture);
+        }
+
+        private static void Add(string message, BreadcrumbLevel level)
+        {
+            BreadcrumbTracker.Instance.Add(BreadcrumbType.Debug, message, level, "device");
+        }
+    }
+}
@@ -0,0 +1,412 @@
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.Runtime.InteropServices;
+using UnityEngine;
+
+namespace MoonForge.ErrorTracking
+{
+    /// <summary>
+    /// Bridge to the native hitch recorder (Android, Linux standalone).
+    /// The tracker marks every frame boundary; frames longer than
+    /// <see cref="ErrorTrackerConfig.hitchThresholdMs"/> are recorded natively with
+    /// the main thread's counter deltas and drained on the worker into "hitch"
+    /// breadcrumbs, labelled with the kind of stall. With I/O tracking, hitches and
+    /// scene and activity breadcrumbs also carry the process's storage reads and
+    /// major faults, so loading stalls can be traced to the level or bundle.
+    /// </summary>
+    public static class NativeHitchRecorder
+    {
+        private const int DrainBufferSize = 8192;
+
+        // Below this share of on-CPU time the main thread was waiting, not working
+        private const float BlockedCpuShare = 0.5f;
+        // Cache misses per thousand instructions above which a busy frame is memory-bound
+        private const float MemoryBoundMissesPerKiloInstruction = 20f;
+        // Storage reads below this during an off-CPU frame are not blamed for it
+        private const long IoBoundReadBytes = 256 * 1024;
+        private const int IoTotalsCount = 4;
+
+        #region Native Plugin Imports
+
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+        private const string NativeLibrary = "moonforge_crash_handler";
+
+        [DllImport(NativeLibrary)]
+        private static extern int MoonForge_Hitch_Start(int thresholdMs, int usePerfCounters, int trackIo);
+
+        [DllImport(NativeLibrary)]
+        private static extern void MoonForge_Hitch_Stop();
+
+        [DllImport(NativeLibrary)]
+        private static extern void MoonForge_Hitch_FrameBoundary();
+
+        [DllImport(NativeLibrary)]
+        private static extern void MoonForge_Hitch_Reset();
+
+        [DllImport(NativeLibrary)]
+        private static extern void MoonForge_Hitch_SetContext(string scene, string level, string activity);
+
+        [DllImport(NativeLibrary)]
+        private static extern int MoonForge_Hitch_GetIoTotals(long[] values, int count);
+
+        [DllImport(NativeLibrary)]
+        private static extern int MoonForge_Hitch_Drain(byte[] buffer, int bufferSize);
+#endif
+
+        // Match MOONFORGE_HITCH_COUNTERS_PERF and MOONFORGE_HITCH_COUNTERS_IO
+        private const int PerfCountersFlag = 2;
+        private const int IoCountersFlag = 4;
+
+        #endregion
+
+        /// <summary>
+        /// One recorded frame over the threshold. Hardware counters are -1 when perf events are unavailable,
+        /// I/O counters when I/O is not tracked.
+        /// </summary>
+        [Serializable]
+        public class HitchEvent
+        {
+            public long timestamp;
+            public float durationMs;
+            public float cpuTimeMs;
+            public long minorFaults;
+            public long majorFaults;
+            public long contextSwitches;
+            public long cycles = -1;
+            public long instructions = -1;
+            public long cacheMisses = -1;
+
+            // Process-wide, so loader threads the main thread waited on count too
+            public long processMajorFaults = -1;
+            public long readBytes = -1;
+            public long writeBytes = -1;
+            public long ioWaitMs = -1;
+
+            public string scene;
+            public string level;
+            public string activity;
+
+            /// <summary>
+            /// "cpu", "memory", "page-faults", "io" or "blocked"
+            /// </summary>
+            public string stall;
+        }
+
+        [Serializable]
+        private class HitchList
+        {
+            public HitchEvent[] items;
+        }
+
+        private static bool _isRunning;
+        private static bool _hasPerfCounters;
+        private static bool _hasIoCounters;
+
+        // Main thread only
+        private static string _scene;
+        private static string _level;
+        private static string _activity;
+        private static long[] _sceneIoStart;
+        private static long[] _activityIoStart;
+        private static float _activityStartTime;
+
+        /// <summary>
+        /// Whether frames are being timed
+        /// </summary>
+        public static bool IsRunning => _isRunning;
+
+        /// <summary>
+        /// Whether hitches carry cycles, instructions and cache misses
+        /// </summary>
+        public static bool HasPerfCounters => _hasPerfCounters;
+
+        /// <summary>
+        /// Whether hitches and scene breadcrumbs carry storage I/O and major faults
+        /// </summary>
+        public static bool HasIoCounters => _hasIoCounters;
+
+        /// <summary>
+        /// Start timing frames of the calling thread. Call from the main thread.
+        /// </summary>
+        public static bool Start(ErrorTrackerConfig config)
+        {
+            if (config.hitchThresholdMs <= 0) return false;
+
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+            try
+            {
+                var counters = MoonForge_Hitch_Start(config.hitchThresholdMs, config.captureHitchCounters ? 1 : 0, config.trackHitchIo ? 1 : 0);
+                _isRunning = counters != 0;
+                _hasPerfCounters = (counters & PerfCountersFlag) != 0;
+                _hasIoCounters = (counters & IoCountersFlag) != 0;
+                if (config.debugMode)
+                {
+                    Debug.Log($"[MoonForge] Hitch recorder {(_isRunning ? "started" : "unavailable")} ({config.hitchThresholdMs} ms, " +
+                        $"perf counters {(_hasPerfCounters ? "on" : config.captureHitchCounters ? "unavailable" : "off")}, " +
+                        $"I/O {(_hasIoCounters ? "on" : config.trackHitchIo ? "unavailable" : "off")})");
+                }
+
+                if (_isRunning)
+                {
+                    SetScene(UnityEngine.SceneManagement.SceneManager.GetActiveScene().name);
+                }
+                return _isRunning;
+            }
+            catch (Exception ex)
+            {
+                if (config.debugMode)
+                {
+                    Debug.LogWarning($"[MoonForge] Hitch recorder unavailable: {ex.Message}");
+                }
+                return false;
+            }
+#else
+            return false;
+#endif
+        }
+
+        /// <summary>
+        /// Stop timing frames. Call from the main thread.
+        /// </summary>
+        public static void Stop()
+        {
+            if (!_isRunning) return;
+            _isRunning = false;
+
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+            try
+            {
+                MoonForge_Hitch_Stop();
+            }
+            catch (Exception)
+            {
+                // Ignore
+            }
+#endif
+        }
+
+        /// <summary>
+        /// Mark the end of a frame. Call once per frame from the main thread.
+        /// </summary>
+        public static void FrameBoundary()
+        {
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+            if (_isRunning) MoonForge_Hitch_FrameBoundary();
+#endif
+        }
+
+        /// <summary>
+        /// Drop the frame in progress, so time spent paused is not reported as a hitch
+        /// </summary>
+        public static void Reset()
+        {
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+            if (_isRunning) MoonForge_Hitch_Reset();
+#endif
+        }
+
+        /// <summary>
+        /// Record the active scene with later hitches. Returns the storage I/O since the
+        /// previous scene change as breadcrumb data, or null. Call from the main thread.
+        /// </summary>
+        public static Dictionary<string, object> SetScene(string scene)
+        {
+            if (!_isRunning) return null;
+
+            _scene = scene;
+            UpdateContext();
+            return TakeIoWindow(ref _sceneIoStart);
+        }
+
+        /// <summary>
+        /// Record the level with later hitches. Call from the main thread.
+        /// </summary>
+        public static void SetLevel(string level)
+        {
+            if (!_isRunning) return;
+
+            _level = level;
+            UpdateContext();
+        }
+
+        /// <summary>
+        /// Record the loading work in progress with later hitches. When an activity ends or is
+        /// replaced, a breadcrumb reports its duration and storage I/O. Call from the main thread.
+        /// </summary>
+        public static void SetActivity(string activity)
+        {
+            if (!_isRunning || activity == _activity) return;
+
+            if (_activity != null)
+            {
+                var data = TakeIoWindow(ref _activityIoStart) ?? new Dictionary<string, object>();
+                var seconds = Time.realtimeSinceStartup - _activityStartTime;
+                data["durationMs"] = seconds * 1000f;
+                BreadcrumbTracker.Instance.Add(new Breadcrumb(BreadcrumbType.Debug,
+                    $"Finished {_activity} in {(seconds * 1000f).ToString("0", CultureInfo.InvariantCulture)} ms{DescribeIo(data)}",
+                    BreadcrumbLevel.Info, "activity").WithData(data));
+            }
+
+            _activity = activity;
+            _activityIoStart = activity != null ? ReadIoTotals() : null;
+            _activityStartTime = Time.realtimeSinceStartup;
+            UpdateContext();
+        }
+
+        private static void UpdateContext()
+        {
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+            MoonForge_Hitch_SetContext(_scene, _level, _activity);
+#endif
+        }
+
+        private static long[] ReadIoTotals()
+        {
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+            if (!_hasIoCounters) return null;
+
+            var totals = new long[IoTotalsCount];
+            return MoonForge_Hitch_GetIoTotals(totals, totals.Length) == IoTotalsCount ? totals : null;
+#else
+            return null;
+#endif
+        }
+
+        /// <summary>
+        /// I/O since <paramref name="start"/> as breadcrumb data; restarts the window
+        /// </summary>
+        private static Dictionary<string, object> TakeIoWindow(ref long[] start)
+        {
+            var now = ReadIoTotals();
+            var previous = start;
+            start = now;
+            if (now == null || previous == null) return null;
+
+            return new Dictionary<string, object>
+            {
+                { "majorFaults", now[0] - previous[0] },
+                { "readBytes", now[1] - previous[1] },
+                { "writeBytes", now[2] - previous[2] },
+                { "ioWaitMs", now[3] - previous[3] }
+            };
+        }
+
+        /// <summary>
+        /// " (IO wait 310 ms, 1820 major faults, 38.0 MB read)" for data with I/O, otherwise empty
+        /// </summary>
+        public static string DescribeIo(Dictionary<string, object> data)
+        {
+            if (data == null) return "";
+
+            var parts = new List<string>();
+            if (data.TryGetValue("ioWaitMs", out var ioWait) && Convert.ToInt64(ioWait) > 0)
+                parts.Add($"IO wait {ioWait} ms");
+            if (data.TryGetValue("majorFaults", out var faults) && Convert.ToInt64(faults) > 0)
+                parts.Add($"{faults} major faults");
+            if (data.TryGetValue("readBytes", out var read) && Convert.ToInt64(read) > 0)
+                parts.Add($"{(Convert.ToInt64(read) / (1024f * 1024f)).ToString("0.0", CultureInfo.InvariantCulture)} MB read");
+
+            return parts.Count > 0 ? " (" + string.Join(", ", parts) + ")" : "";
+        }
+
+        /// <summary>
+        /// Move recorded hitches into breadcrumbs. Runs on the worker thread.
+        /// </summary>
+        public static void Drain()
+        {
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+            if (!_isRunning) return;
+
+            try
+            {
+                var buffer = new byte[DrainBufferSize];
+                int length;
+                while ((length = MoonForge_Hitch_Drain(buffer, buffer.Length)) > 0)
+                {
+                    var list = JsonUtility.FromJson<HitchList>("{\"items\":" + System.Text.Encoding.UTF8.GetString(buffer, 0, length) + "}");
+                    if (list?.items == null) break;
+
+                    foreach (var hitch in list.items)
+                    {
+                        hitch.stall = ClassifyStall(hitch);
+                        BreadcrumbTracker.Instance.Add(CreateBreadcrumb(hitch));
+                    }
+                }
+            }
+            catch (Exception)
+            {
+                // Ignore; hitches are best effort
+            }
+#endif
+        }
+
+        /// <summary>
+        /// Label what the main thread was doing during a hitch
+        /// </summary>
+        public static string ClassifyStall(HitchEvent hitch)
+        {
+            if (hitch.durationMs <= 0) return null;
+
+            if (hitch.cpuTimeMs < hitch.durationMs * BlockedCpuShare)
+            {
+                // Off-CPU: faulting pages in itself, waiting on threads that read storage, or on locks, GPU, other threads
+                if (hitch.majorFaults > 0) return "page-faults";
+                if (hitch.ioWaitMs > 0 || hitch.processMajorFaults > 0 || hitch.readBytes >= IoBoundReadBytes) return "io";
+                return "blocked";
+            }
+
+            if (hitch.instructions > 0 && hitch.cacheMisses >= 0
+                && hitch.cacheMisses * 1000f / hitch.instructions >= MemoryBoundMissesPerKiloInstruction)
+            {
+                return "memory";
+            }
+
+            return "cpu";
+        }
+
+        private static Breadcrumb CreateBreadcrumb(HitchEvent hitch)
+        {
+            var data = new Dictionary<string, object>
+            {
+                { "durationMs", hitch.durationMs },
+                { "cpuTimeMs", hitch.cpuTimeMs },
+                { "majorFaults", hitch.majorFaults },
+                { "minorFaults", hitch.minorFaults },
+                { "contextSwitches", hitch.contextSwitches },
+                { "stall", hitch.stall }
+            };
+
+            if (hitch.cycles >= 0) data["cycles"] = hitch.cycles;
+            if (hitch.instructions >= 0) data["instructions"] = hitch.instructions;
+            if (hitch.cacheMisses >= 0) data["cacheMisses"] = hitch.cacheMisses;
+            if (hitch.cycles > 0 && hitch.instructions >= 0) data["ipc"] = (float)hitch.instructions / hitch.cycles;
+            if (hitch.readBytes >= 0)
+            {
+                data["processMajorFaults"] = hitch.processMajorFaults;
+                data["readBytes"] = hitch.readBytes;
+                data["writeBytes"] = hitch.writeBytes;
+                data["ioWaitMs"] = hitch.ioWaitMs;
+            }
+            if (!string.IsNullOrEmpty(hitch.scene)) data["scene"] = hitch.scene;
+            if (!string.IsNullOrEmpty(hitch.level)) data["level"] = hitch.level;
+            if (!string.IsNullOrEmpty(hitch.activity)) data["activity"] = hitch.activity;
+
+            var where = !string.IsNullOrEmpty(hitch.activity) ? $" during {hitch.activity}"
+                : !string.IsNullOrEmpty(hitch.scene) ? $" in {hitch.scene}"
+                : "";
+            var io = hitch.readBytes >= 0
+                ? DescribeIo(new Dictionary<string, object>
+                {
+                    { "ioWaitMs", hitch.ioWaitMs },
+                    { "majorFaults", Math.Max(hitch.majorFaults, hitch.processMajorFaults) },
+                    { "readBytes", hitch.readBytes }
+                })
+                : "";
+            var message = $"Frame hitch {hitch.durationMs.ToString("0", CultureInfo.InvariantCulture)} ms ({hitch.stall}){where}{io}";
+            var breadcrumb = new Breadcrumb(BreadcrumbType.Debug, message, BreadcrumbLevel.Warning, "hitch").WithData(data);
+            breadcrumb.timestamp = hitch.timestamp;
+            return breadcrumb;
+        }
+    }
+}
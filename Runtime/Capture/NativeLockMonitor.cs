@@ -0,0 +1,152 @@
+using System;
+using System.IO;
+using System.Runtime.InteropServices;
+using UnityEngine;
+
+namespace MoonForge.ErrorTracking
+{
+    /// <summary>
+    /// Bridge to the native lock monitor (Android, Linux standalone).
+    /// Native plugins' pthread mutexes and condition variables are interposed on
+    /// to keep a wait-for graph. When the main thread has been blocked on one for
+    /// <see cref="ErrorTrackerConfig.lockHangThresholdMs"/>, or threads deadlock,
+    /// the worker writes a hang record naming every thread in the wait chain with
+    /// its stack. The record is reported as soon as the main thread runs again,
+    /// or on the next launch if the process never recovers.
+    /// </summary>
+    public static class NativeLockMonitor
+    {
+        private const int ReportBufferSize = 65536;
+
+        #region Native Plugin Imports
+
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+        private const string NativeLibrary = "moonforge_crash_handler";
+
+        [DllImport(NativeLibrary)]
+        private static extern int MoonForge_LockMonitor_Start(int sampleRate);
+
+        [DllImport(NativeLibrary)]
+        private static extern void MoonForge_LockMonitor_Stop();
+
+        [DllImport(NativeLibrary)]
+        private static extern int MoonForge_LockMonitor_Check(int hangMs, byte[] buffer, int bufferSize);
+#endif
+
+        #endregion
+
+        private static bool _isRunning;
+
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+        private static int _hangThresholdMs;
+        private static string _directory;
+
+        // Worker thread only
+        private static byte[] _buffer;
+#endif
+
+        /// <summary>
+        /// Whether lock waits are being monitored
+        /// </summary>
+        public static bool IsRunning => _isRunning;
+
+        /// <summary>
+        /// Install the hooks. Call from the main thread, after the native crash
+        /// handler is initialized: hang records go to its crash directory.
+        /// </summary>
+        public static bool Start(ErrorTrackerConfig config)
+        {
+            if (!config.enableLockMonitor) return false;
+
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+            _directory = NativeCrashHandler.CrashDirectory;
+            if (string.IsNullOrEmpty(_directory))
+            {
+                if (config.debugMode)
+                {
+                    Debug.LogWarning("[MoonForge] Lock monitor needs the native crash handler");
+                }
+                return false;
+            }
+
+            try
+            {
+                _hangThresholdMs = config.lockHangThresholdMs;
+                _isRunning = MoonForge_LockMonitor_Start(config.lockMonitorSampleRate) != 0;
+                if (config.debugMode)
+                {
+                    Debug.Log($"[MoonForge] Lock monitor {(_isRunning ? "started" : "unavailable")} " +
+                        $"(1 in {config.lockMonitorSampleRate} mutexes tracked, hang after {_hangThresholdMs} ms)");
+                }
+                return _isRunning;
+            }
+            catch (Exception ex)
+            {
+                if (config.debugMode)
+                {
+                    Debug.LogWarning($"[MoonForge] Lock monitor unavailable: {ex.Message}");
+                }
+                return false;
+            }
+#else
+            return false;
+#endif
+        }
+
+        /// <summary>
+        /// Remove the hooks. Call from the main thread.
+        /// </summary>
+        public static void Stop()
+        {
+            if (!_isRunning) return;
+            _isRunning = false;
+
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+            try
+            {
+                MoonForge_LockMonitor_Stop();
+            }
+            catch (Exception)
+            {
+                // Ignore
+            }
+#endif
+        }
+
+        /// <summary>
+        /// Write a hang record if the main thread is blocked or threads are deadlocked.
+        /// Returns whether one was written. Runs on the worker thread, which keeps
+        /// running while the main thread is stuck.
+        /// </summary>
+        public static bool Check()
+        {
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+            if (!_isRunning) return false;
+
+            try
+            {
+                _buffer = _buffer ?? new byte[ReportBufferSize];
+                var length = MoonForge_LockMonitor_Check(_hangThresholdMs, _buffer, _buffer.Length);
+                if (length <= 0) return false;
+
+                // Written under a temporary name so a half-written record is never read
+                var name = $"hang_{DateTimeOffset.UtcNow.ToUnixTimeMilliseconds()}";
+                var temporaryPath = Path.Combine(_directory, name + ".tmp");
+                using (var stream = new FileStream(temporaryPath, FileMode.Create, FileAccess.Write))
+                {
+                    stream.Write(_buffer, 0, length);
+                }
+                File.Move(temporaryPath, Path.Combine(_directory, name + ".json"));
+                return true;
+            }
+            catch (Exception)
+            {
+                // Ignore; hangs are best effort
+                return false;
+            }
+#else
+            return false;
+#endif
+        }
+    }
+}
@@ -0,0 +1,113 @@
+using System;
+using System.Runtime.InteropServices;
+using UnityEngine;
+
+namespace MoonForge.ErrorTracking
+{
+    /// <summary>
+    /// Bridge to the native log tail (Android, Linux standalone).
+    /// Keeps the most recent liblog output (and optionally stdout/stderr) of the
+    /// process in a fixed-size ring, since apps can no longer read their own logcat.
+    /// Linux players have no liblog, so there only stdout/stderr are captured.
+    /// The native crash handler attaches the ring to every crash record.
+    /// </summary>
+    public static class NativeLogTail
+    {
+        #region Native Plugin Imports
+
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+        private const string NativeLibrary = "moonforge_crash_handler";
+
+        [DllImport(NativeLibrary)]
+        private static extern int MoonForge_LogTail_Start(int ringSizeBytes, int captureStdio);
+
+        [DllImport(NativeLibrary)]
+        private static extern void MoonForge_LogTail_Stop();
+
+        [DllImport(NativeLibrary)]
+        private static extern int MoonForge_LogTail_Read(byte[] buffer, int bufferSize);
+#endif
+
+        #endregion
+
+        private static bool _isRunning;
+
+        /// <summary>
+        /// Whether log lines are being captured
+        /// </summary>
+        public static bool IsRunning => _isRunning;
+
+        /// <summary>
+        /// Start capturing into a ring of <see cref="ErrorTrackerConfig.logTailSizeKb"/> KB
+        /// </summary>
+        public static bool Start(ErrorTrackerConfig config)
+        {
+            if (config.logTailSizeKb <= 0) return false;
+
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+            try
+            {
+                _isRunning = MoonForge_LogTail_Start(config.logTailSizeKb * 1024, config.captureStdoutStderr ? 1 : 0) != 0;
+                if (config.debugMode)
+                {
+                    Debug.Log($"[MoonForge] Log tail {(_isRunning ? "started" : "unavailable")} ({config.logTailSizeKb} KB{(config.captureStdoutStderr ? ", with stdout/stderr" : "")})");
+                }
+                return _isRunning;
+            }
+            catch (Exception ex)
+            {
+                if (config.debugMode)
+                {
+                    Debug.LogWarning($"[MoonForge] Log tail unavailable: {ex.Message}");
+                }
+                return false;
+            }
+#else
+            return false;
+#endif
+        }
+
+        /// <summary>
+        /// Remove the liblog hooks and give stdout/stderr back their original targets
+        /// </summary>
+        public static void Stop()
+        {
+            if (!_isRunning) return;
+            _isRunning = false;
+
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+            try
+            {
+                MoonForge_LogTail_Stop();
+            }
+            catch (Exception)
+            {
+                // Ignore
+            }
+#endif
+        }
+
+        /// <summary>
+        /// Most recent log lines, oldest first, at most <paramref name="maxBytes"/> long. Null if nothing was captured.
+        /// </summary>
+        public static string Read(int maxBytes)
+        {
+            if (!_isRunning || maxBytes <= 0) return null;
+
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+            try
+            {
+                var buffer = new byte[maxBytes + 1];
+                var length = MoonForge_LogTail_Read(buffer, buffer.Length);
+                return length > 0 ? System.Text.Encoding.UTF8.GetString(buffer, 0, length) : null;
+            }
+            catch (Exception)
+            {
+                return null;
+            }
+#else
+            return null;
+#endif
+        }
+    }
+}
@@ -0,0 +1,191 @@
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Runtime.InteropServices;
+using MoonForge.ErrorTracking.Analytics;
+using UnityEngine;
+
+namespace MoonForge.ErrorTracking
+{
+    /// <summary>
+    /// Bridge to the native session black box (Android, Linux standalone).
+    /// The session's start, heartbeat, foreground and background time and end
+    /// reason live in a memory-mapped file, so they survive crashes and kills that
+    /// never reach <c>session_end</c>. The next launch reports the previous session
+    /// as a <c>session_summary</c> analytics event, from which crash-free session
+    /// rates can be computed.
+    /// </summary>
+    public static class NativeSessionRecorder
+    {
+        private const int SummaryBufferSize = 512;
+
+        #region Native Plugin Imports
+
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+        private const string NativeLibrary = "moonforge_crash_handler";
+
+        [DllImport(NativeLibrary)]
+        private static extern int MoonForge_Session_Begin(string directory, string sessionId);
+
+        [DllImport(NativeLibrary)]
+        private static extern void MoonForge_Session_Heartbeat();
+
+        [DllImport(NativeLibrary)]
+        private static extern void MoonForge_Session_SetForeground(int foreground);
+
+        [DllImport(NativeLibrary)]
+        private static extern void MoonForge_Session_End();
+
+        [DllImport(NativeLibrary)]
+        private static extern int MoonForge_Session_GetPreviousSummary(byte[] buffer, int bufferSize);
+#endif
+
+        #endregion
+
+        /// <summary>
+        /// How the previous session ended, as left in the black box
+        /// </summary>
+        [Serializable]
+        public class SessionSummary
+        {
+            public string sessionId;
+            /// <summary>Unix milliseconds</summary>
+            public long startTimestamp;
+            /// <summary>Unix milliseconds of the last heartbeat, or of the exit or crash</summary>
+            public long endTimestamp;
+            public long foregroundMs;
+            public long backgroundMs;
+            /// <summary>"exit", "crash", "killed_foreground" or "killed_background"</summary>
+            public string endReason;
+            /// <summary>Crash signal, 0 unless the session crashed</summary>
+            public int signal;
+
+            public bool Crashed => endReason == "crash";
+        }
+
+        private static bool _isRunning;
+        private static SessionSummary _previousSession;
+
+        /// <summary>
+        /// Whether the current session is being recorded
+        /// </summary>
+        public static bool IsRunning => _isRunning;
+
+        /// <summary>
+        /// The session before this launch, or null if there was none
+        /// </summary>
+        public static SessionSummary PreviousSession => _previousSession;
+
+        /// <summary>
+        /// Start recording the current session and pick up the previous one. Call from the main thread.
+        /// </summary>
+        public static bool Begin(ErrorTrackerConfig config, string sessionId)
+        {
+            if (!config.trackSessionHealth || _isRunning) return _isRunning;
+
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+            try
+            {
+                var directory = Path.Combine(Application.persistentDataPath, "moonforge");
+                Directory.CreateDirectory(directory);
+
+                _isRunning = MoonForge_Session_Begin(directory, sessionId) != 0;
+                if (!_isRunning) return false;
+
+                var buffer = new byte[SummaryBufferSize];
+                var length = MoonForge_Session_GetPreviousSummary(buffer, buffer.Length);
+                if (length > 0)
+                {
+                    _previousSession = JsonUtility.FromJson<SessionSummary>(System.Text.Encoding.UTF8.GetString(buffer, 0, length));
+                }
+
+                if (config.debugMode)
+                {
+                    var previous = _previousSession != null ? $"previous {_previousSession.sessionId} ended by {_previousSession.endReason}" : "no previous session";
+                    Debug.Log($"[MoonForge] Session black box started ({previous})");
+                }
+                return true;
+            }
+            catch (Exception ex)
+            {
+                _isRunning = false;
+                if (config.debugMode)
+                {
+                    Debug.LogWarning($"[MoonForge] Session black box unavailable: {ex.Message}");
+                }
+                return false;
+            }
+#else
+            return false;
+#endif
+        }
+
+        /// <summary>
+        /// Store the heartbeat and the time totals. Runs on the worker.
+        /// </summary>
+        public static void Heartbeat()
+        {
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+            if (_isRunning) MoonForge_Session_Heartbeat();
+#endif
+        }
+
+        /// <summary>
+        /// Count the following time as foreground or background
+        /// </summary>
+        public static void SetForeground(bool foreground)
+        {
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+            if (_isRunning) MoonForge_Session_SetForeground(foreground ? 1 : 0);
+#endif
+        }
+
+        /// <summary>
+        /// Record a normal exit. Later calls are ignored.
+        /// </summary>
+        public static void End()
+        {
+            if (!_isRunning) return;
+            _isRunning = false;
+
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+            try
+            {
+                MoonForge_Session_End();
+            }
+            catch (Exception)
+            {
+                // Ignore
+            }
+#endif
+        }
+
+        /// <summary>
+        /// Send the previous session as a <c>session_summary</c> analytics event, once
+        /// </summary>
+        public static void ReportPreviousSession()
+        {
+            var session = _previousSession;
+            if (session == null || !MoonForgeAnalytics.IsInitialized) return;
+            _previousSession = null;
+
+            var data = new Dictionary<string, object>
+            {
+                { "session_id", session.sessionId },
+                { "end_reason", session.endReason },
+                { "crashed", session.Crashed },
+                { "duration_seconds", (session.foregroundMs + session.backgroundMs) / 1000 },
+                { "foreground_seconds", session.foregroundMs / 1000 },
+                { "background_seconds", session.backgroundMs / 1000 },
+                { "started_at", session.startTimestamp / 1000 },
+                { "ended_at", session.endTimestamp / 1000 }
+            };
+            if (session.Crashed)
+            {
+                data["crash_signal"] = session.signal;
+            }
+
+            MoonForgeAnalytics.TrackEvent("session_summary", data);
+        }
+    }
+}
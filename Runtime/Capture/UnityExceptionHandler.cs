@@ -162,15 +162,15 @@ namespace MoonForge.ErrorTracking
         private ErrorPayloadInner CreatePayload(string condition, string stackTrace, LogType logType)
         {
             var (errorType, errorCategory, errorLevel) = ClassifyLogType(logType);
-            var exceptionClass = ExtractExceptionClass(condition);
+            var exceptionClass = SdkStringTable.Intern(ExtractExceptionClass(condition));
             var message = ScrubMessage(condition);
 
             var payload = new ErrorPayloadInner
             {
                 game = _config.gameId,
-                errorType = errorType.ToString().ToLowerInvariant(),
-                errorCategory = errorCategory.ToString().ToLowerInvariant(),
-                errorLevel = errorLevel.ToString().ToLowerInvariant(),
+                errorType = errorType.ToWireName(),
+                errorCategory = errorCategory.ToWireName(),
+                errorLevel = errorLevel.ToWireName(),
                 message = message,
                 exceptionClass = exceptionClass,
                 rawStackTrace = stackTrace,
@@ -200,7 +200,7 @@ namespace MoonForge.ErrorTracking
                 errorCategory = "unhandled",
                 errorLevel = isTerminating ? "fatal" : "error",
                 message = message,
-                exceptionClass = exception.GetType().FullName,
+                exceptionClass = SdkStringTable.Intern(exception.GetType().FullName),
                 rawStackTrace = stackTrace,
                 frames = ParseStackFrames(stackTrace),
                 device = DeviceContextCollector.Instance.Collect(),
@@ -306,14 +306,14 @@ namespace MoonForge.ErrorTracking
             var atMatch = Regex.Match(line, @"^(.+?)\s*\(.*?\)\s*\(at\s+(.+?):(\d+)\)");
             if (atMatch.Success)
             {
-                frame.function = atMatch.Groups[1].Value.Trim();
-                frame.filename = atMatch.Groups[2].Value.Trim();
+                frame.function = SdkStringTable.Intern(atMatch.Groups[1].Value.Trim());
+                frame.filename = SdkStringTable.Intern(atMatch.Groups[2].Value.Trim());
                 if (int.TryParse(atMatch.Groups[3].Value, out var lineNo))
                 {
                     frame.lineno = lineNo;
                 }
                 frame.inApp = IsInAppFrame(frame.filename, frame.function);
-                frame.module = ExtractModule(frame.function);
+                frame.module = SdkStringTable.Intern(ExtractModule(frame.function));
                 return frame;
             }
 
@@ -321,9 +321,9 @@ namespace MoonForge.ErrorTracking
             var simpleMatch = Regex.Match(line, @"^(.+?)\s*\(");
             if (simpleMatch.Success)
             {
-                frame.function = simpleMatch.Groups[1].Value.Trim();
+                frame.function = SdkStringTable.Intern(simpleMatch.Groups[1].Value.Trim());
                 frame.inApp = IsInAppFrame(null, frame.function);
-                frame.module = ExtractModule(frame.function);
+                frame.module = SdkStringTable.Intern(ExtractModule(frame.function));
                 return frame;
             }
 
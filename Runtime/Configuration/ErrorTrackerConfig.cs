@@ -25,12 +25,22 @@ namespace MoonForge.ErrorTracking
         [Tooltip("Capture Unity log errors (Debug.LogError, Debug.LogException)")]
         public bool captureLogErrors = true;
 
-        [Tooltip("Capture native crashes (iOS/Android)")]
+        [Tooltip("Capture native crashes (iOS/Android/Linux standalone)")]
         public bool captureNativeCrashes = true;
 
         [Tooltip("Minimum error level to capture")]
         public ErrorLevel minimumLevel = ErrorLevel.Warning;
 
+        [Tooltip("Kilobytes of recent native log output (liblog, optionally stdout/stderr) kept in memory and attached to native crash reports (Android, Linux). 0 disables.")]
+        [Range(0, 1024)]
+        public int logTailSizeKb = 16;
+
+        [Tooltip("Also capture stdout/stderr into the log tail by redirecting them through a pipe (Android, Linux)")]
+        public bool captureStdoutStderr = false;
+
+        [Tooltip("Attach the most recent log tail lines to managed errors and fatals, not only native crashes")]
+        public bool attachLogTailToErrors = false;
+
         [Header("Breadcrumb Settings")]
         [Tooltip("Maximum number of breadcrumbs to keep")]
         [Range(10, 200)]
@@ -51,6 +61,17 @@ namespace MoonForge.ErrorTracking
         [Range(1f, 60f)]
         public float maxBatchWaitTime = 10f;
 
+        [Tooltip("Send each batch's stack frames and their strings once, in shared tables referenced by index, instead of inline in every error. Requires a collector that accepts \"frameEncoding\":\"table\".")]
+        public bool compactBatchFrames = false;
+
+        [Tooltip("Largest encoded size of one batched error, in KB. Larger errors are trimmed (custom data, then breadcrumbs, raw stack trace, log tail, frames past the first 64, tags, message) and list what was cut in \"truncated\". 0 = no limit.")]
+        [Range(0, 1024)]
+        public int maxErrorPayloadKB = 64;
+
+        [Tooltip("Largest batch request body, in KB. A batch that would be larger is sent as several requests. 0 = no limit.")]
+        [Range(0, 4096)]
+        public int maxBatchPayloadKB = 512;
+
         [Header("Offline Storage")]
         [Tooltip("Store errors when offline and send when connection is restored")]
         public bool enableOfflineStorage = true;
@@ -88,6 +109,59 @@ namespace MoonForge.ErrorTracking
         [Range(1f, 10f)]
         public float retryBaseDelay = 2f;
 
+        [Header("Performance Settings")]
+        [Tooltip("Main-thread time (milliseconds) the SDK may spend per frame. Work that doesn't fit carries over to the next frame.")]
+        [Range(0.05f, 2f)]
+        public float mainThreadBudgetMs = 0.2f;
+
+        [Tooltip("Placement of SDK background threads on big.LITTLE devices (Android). EfficiencyCores keeps SDK work off the cores the game renders on.")]
+        public ThreadAffinityPolicy workerThreadPolicy = ThreadAffinityPolicy.EfficiencyCores;
+
+        [Header("Memory Diagnostics")]
+        [Tooltip("Sample native allocations (Android) and attach the top call sites by live memory to low-memory reports. Costs a few percent of allocator time while enabled.")]
+        public bool enableAllocationProfiler = false;
+
+        [Tooltip("Mean kilobytes allocated between samples. Smaller intervals find smaller leaks at higher cost.")]
+        [Range(64, 8192)]
+        public int allocationSampleIntervalKb = 512;
+
+        [Header("CPU Diagnostics")]
+        [Tooltip("Sample per-thread CPU time from /proc (Android, Linux) to fill cpuUsagePercent and list the busiest threads in crash reports")]
+        public bool enableCpuSampling = true;
+
+        [Tooltip("Seconds between CPU samples. Each sample reads one small /proc file per thread on the SDK worker thread.")]
+        [Range(1f, 60f)]
+        public float cpuSampleIntervalSeconds = 5f;
+
+        [Tooltip("Sample thermal zones, CPU cluster frequencies and battery state from sysfs (Android, Linux). Frequency caps, temperature steps and battery changes become breadcrumbs.")]
+        public bool enableDeviceSampling = true;
+
+        [Tooltip("Seconds between device samples. Each sample re-reads a few already open sysfs files on the SDK worker thread.")]
+        [Range(1f, 60f)]
+        public float deviceSampleIntervalSeconds = 2f;
+
+        [Tooltip("Main-thread frames at least this long are recorded as hitch breadcrumbs with CPU time, page faults and context switches (Android, Linux). 0 disables.")]
+        [Range(0, 2000)]
+        public int hitchThresholdMs = 100;
+
+        [Tooltip("Also open perf_event counters (cycles, instructions, cache misses) for the main thread. Most Android builds restrict perf events; hitches are then recorded without them.")]
+        public bool captureHitchCounters = false;
+
+        [Tooltip("Track process-wide storage reads and major faults from /proc each frame, so hitches, scene loads and activities show the I/O behind them (Android, Linux)")]
+        public bool trackHitchIo = true;
+
+        [Header("Hang Diagnostics")]
+        [Tooltip("Interpose on native plugins' pthread mutexes and condition variables (Android, Linux) to report deadlocks and long main-thread lock waits with every thread's stack in the wait chain. Requires captureNativeCrashes.")]
+        public bool enableLockMonitor = false;
+
+        [Tooltip("Record the owner of 1 in N mutexes from their first lock; every mutex is tracked once it has been contended. 1 tracks all of them, for QA builds, at about twice the cost of an uncontended lock.")]
+        [Range(1, 256)]
+        public int lockMonitorSampleRate = 16;
+
+        [Tooltip("Report when the main thread has waited this long on a mutex or condition variable, or threads have been deadlocked this long")]
+        [Range(500, 30000)]
+        public int lockHangThresholdMs = 2000;
+
         [Header("Privacy Settings")]
         [Tooltip("Scrub potentially sensitive data from error messages")]
         public bool scrubSensitiveData = true;
@@ -117,6 +191,13 @@ namespace MoonForge.ErrorTracking
         [Range(60, 7200)]
         public int sessionTimeoutSeconds = 1800;
 
+        [Tooltip("Keep the session's heartbeat, foreground/background time and end reason in a memory-mapped file, and report the previous session as a session_summary event on the next launch, including crashes and kills (Android, Linux)")]
+        public bool trackSessionHealth = true;
+
+        [Tooltip("How often the session heartbeat and time totals are stored. A killed session loses at most this much time.")]
+        [Range(1, 60)]
+        public int sessionHeartbeatSeconds = 5;
+
         [Header("Debug Settings")]
         [Tooltip("Enable debug logging for the SDK")]
         public bool debugMode = false;
@@ -0,0 +1,342 @@
+using System;
+using System.Collections.Generic;
+using System.Threading;
+
+namespace MoonForge.ErrorTracking
+{
+    /// <summary>
+    /// What a context entry describes; matches MOONFORGE_CONTEXT_* in moonforge_context_store.h
+    /// </summary>
+    public enum ContextScope
+    {
+        /// <summary>Scene name, game mode and level</summary>
+        GameState = 0,
+        /// <summary>Custom game state data</summary>
+        CustomData = 1,
+        /// <summary>The user id</summary>
+        User = 2,
+        /// <summary>User tags</summary>
+        Tag = 3
+    }
+
+    /// <summary>
+    /// Type of a context value; matches the native value types
+    /// </summary>
+    public enum ContextValueType
+    {
+        String = 0,
+        Long = 1,
+        Double = 2,
+        Bool = 3,
+        /// <summary>Anything else (nested dictionaries, lists); kept managed-side only</summary>
+        Object = 4
+    }
+
+    /// <summary>
+    /// Immutable view of the context at one version. Payloads share it rather than
+    /// copying the context, so its dictionaries must not be modified.
+    /// </summary>
+    public sealed class ContextSnapshot
+    {
+        /// <summary>Store version this snapshot was taken at</summary>
+        public readonly int version;
+        public readonly GameState gameState;
+        public readonly string userId;
+        /// <summary>User tags, or null if there are none</summary>
+        public readonly Dictionary<string, string> tags;
+
+        internal ContextSnapshot(int version, GameState gameState, string userId, Dictionary<string, string> tags)
+        {
+            this.version = version;
+            this.gameState = gameState;
+            this.userId = userId;
+            this.tags = tags;
+        }
+    }
+
+    /// <summary>
+    /// Typed key/value store for the context errors are reported with: game state,
+    /// custom game data, the user and tags. Every change bumps the version and is
+    /// mirrored into the native store (see <see cref="NativeContextStore"/>), from
+    /// which the crash handler writes the context into crash records.
+    ///
+    /// Setting a value is a dictionary write and, on Android and Linux, one native
+    /// call; setting the value a key already has changes nothing. Capturing is
+    /// copy-free: <see cref="Current"/> builds a snapshot at most once per version
+    /// and every payload captured at that version shares it. Thread-safe.
+    /// </summary>
+    public static class ContextStore
+    {
+        internal const string SceneNameKey = "sceneName";
+        internal const string GameModeKey = "gameMode";
+        internal const string LevelIdKey = "levelId";
+        internal const string UserIdKey = "id";
+
+        private struct Entry
+        {
+            public ContextValueType type;
+            public long integer;
+            public double number;
+            public string text;
+            // The value as the caller passed it, reused by snapshots to avoid boxing again
+            public object boxed;
+        }
+
+        private static readonly Dictionary<string, Entry>[] _scopes =
+        {
+            new Dictionary<string, Entry>(),
+            new Dictionary<string, Entry>(),
+            new Dictionary<string, Entry>(),
+            new Dictionary<string, Entry>()
+        };
+        private static readonly object _lock = new object();
+        private static int _version;
+        private static ContextSnapshot _snapshot;
+
+        /// <summary>
+        /// Incremented by every change
+        /// </summary>
+        public static int Version => Volatile.Read(ref _version);
+
+        /// <summary>
+        /// The context as of now, shared by every caller until the next change
+        /// </summary>
+        public static ContextSnapshot Current
+        {
+            get
+            {
+                var snapshot = Volatile.Read(ref _snapshot);
+                if (snapshot != null && snapshot.version == Volatile.Read(ref _version)) return snapshot;
+
+                lock (_lock)
+                {
+                    if (_snapshot == null || _snapshot.version != _version)
+                    {
+                        Volatile.Write(ref _snapshot, BuildSnapshot());
+                    }
+                    return _snapshot;
+                }
+            }
+        }
+
+        public static void SetString(ContextScope scope, string key, string value)
+        {
+            if (value == null)
+            {
+                Remove(scope, key);
+                return;
+            }
+            Store(scope, key, new Entry { type = ContextValueType.String, text = value, boxed = value });
+        }
+
+        public static void SetLong(ContextScope scope, string key, long value)
+        {
+            Store(scope, key, new Entry { type = ContextValueType.Long, integer = value });
+        }
+
+        public static void SetDouble(ContextScope scope, string key, double value)
+        {
+            Store(scope, key, new Entry { type = ContextValueType.Double, number = value });
+        }
+
+        public static void SetBool(ContextScope scope, string key, bool value)
+        {
+            Store(scope, key, new Entry { type = ContextValueType.Bool, integer = value ? 1 : 0 });
+        }
+
+        /// <summary>
+        /// Set a value of any type; null removes the key. Numbers, strings and bools
+        /// are stored typed; other values are kept as they are for payloads but do not
+        /// reach native crash records.
+        /// </summary>
+        public static void Set(ContextScope scope, string key, object value)
+        {
+            switch (value)
+            {
+                case null:
+                    Remove(scope, key);
+                    break;
+                case string s:
+                    SetString(scope, key, s);
+                    break;
+                case bool b:
+                    Store(scope, key, new Entry { type = ContextValueType.Bool, integer = b ? 1 : 0, boxed = value });
+                    break;
+                case int _:
+                case long _:
+                case short _:
+                case byte _:
+                case sbyte _:
+                case ushort _:
+                case uint _:
+                    Store(scope, key, new Entry { type = ContextValueType.Long, integer = Convert.ToInt64(value), boxed = value });
+                    break;
+                case float f:
+                    Store(scope, key, new Entry { type = ContextValueType.Double, number = Widen(f), boxed = value });
+                    break;
+                case double d:
+                    Store(scope, key, new Entry { type = ContextValueType.Double, number = d, boxed = value });
+                    break;
+                default:
+                    Store(scope, key, new Entry { type = ContextValueType.Object, boxed = value });
+                    break;
+            }
+        }
+
+        /// <summary>
+        /// A float as the double it reads as, so 0.1f is stored as 0.1 rather than 0.100000001490116
+        /// </summary>
+        public static double Widen(float value)
+        {
+            // Via decimal, which keeps the float's shortest spelling; out of its range there is nothing to round
+            return Math.Abs(value) < 1e28f ? (double)(decimal)value : value;
+        }
+
+        public static void Remove(ContextScope scope, string key)
+        {
+            if (string.IsNullOrEmpty(key)) return;
+
+            lock (_lock)
+            {
+                if (!_scopes[(int)scope].Remove(key)) return;
+                _version++;
+                NativeContextStore.Remove(scope, key);
+            }
+        }
+
+        /// <summary>
+        /// Remove every key of a scope
+        /// </summary>
+        public static void Clear(ContextScope scope)
+        {
+            lock (_lock)
+            {
+                if (_scopes[(int)scope].Count == 0) return;
+                _scopes[(int)scope].Clear();
+                _version++;
+                NativeContextStore.Clear(scope);
+            }
+        }
+
+        /// <summary>
+        /// Value of a key, or null
+        /// </summary>
+        public static object Get(ContextScope scope, string key)
+        {
+            if (string.IsNullOrEmpty(key)) return null;
+
+            lock (_lock)
+            {
+                return _scopes[(int)scope].TryGetValue(key, out var entry) ? Box(entry) : null;
+            }
+        }
+
+        private static void Store(ContextScope scope, string key, Entry entry)
+        {
+            if (string.IsNullOrEmpty(key)) return;
+
+            lock (_lock)
+            {
+                var values = _scopes[(int)scope];
+                if (values.TryGetValue(key, out var existing) && SameValue(existing, entry)) return;
+                values[key] = entry;
+                _version++;
+
+                // Under the lock, so the native store sees changes in the same order
+                switch (entry.type)
+                {
+                    case ContextValueType.String:
+                        NativeContextStore.SetString(scope, key, entry.text);
+                        break;
+                    case ContextValueType.Long:
+                        NativeContextStore.SetLong(scope, key, entry.integer);
+                        break;
+                    case ContextValueType.Double:
+                        NativeContextStore.SetDouble(scope, key, entry.number);
+                        break;
+                    case ContextValueType.Bool:
+                        NativeContextStore.SetBool(scope, key, entry.integer != 0);
+                        break;
+                    default:
+                        // A stale native value must not outlive its replacement
+                        NativeContextStore.Remove(scope, key);
+                        break;
+                }
+            }
+        }
+
+        private static bool SameValue(Entry a, Entry b)
+        {
+            if (a.type != b.type) return false;
+            switch (a.type)
+            {
+                case ContextValueType.String:
+                    return string.Equals(a.text, b.text, StringComparison.Ordinal);
+                case ContextValueType.Long:
+                case ContextValueType.Bool:
+                    return a.integer == b.integer && Equals(a.boxed, b.boxed);
+                case ContextValueType.Double:
+                    return a.number.Equals(b.number) && Equals(a.boxed, b.boxed);
+                default:
+                    // The caller may have changed the object since it was set
+                    return false;
+            }
+        }
+
+        private static object Box(Entry entry)
+        {
+            if (entry.boxed != null) return entry.boxed;
+            switch (entry.type)
+            {
+                case ContextValueType.Long:
+                    return entry.integer;
+                case ContextValueType.Double:
+                    return entry.number;
+                case ContextValueType.Bool:
+                    return entry.integer != 0;
+                default:
+                    return entry.text;
+            }
+        }
+
+        // Caller holds _lock
+        private static ContextSnapshot BuildSnapshot()
+        {
+            var state = _scopes[(int)ContextScope.GameState];
+            var custom = _scopes[(int)ContextScope.CustomData];
+            var user = _scopes[(int)ContextScope.User];
+            var tagValues = _scopes[(int)ContextScope.Tag];
+
+            Dictionary<string, object> customData = null;
+            if (custom.Count > 0)
+            {
+                customData = new Dictionary<string, object>(custom.Count);
+                foreach (var kvp in custom)
+                {
+                    customData[kvp.Key] = Box(kvp.Value);
+                }
+            }
+
+            Dictionary<string, string> tags = null;
+            if (tagValues.Count > 0)
+            {
+                tags = new Dictionary<string, string>(tagValues.Count);
+                foreach (var kvp in tagValues)
+                {
+                    tags[kvp.Key] = kvp.Value.text;
+                }
+            }
+
+            var gameState = new GameState
+            {
+                sceneName = state.TryGetValue(SceneNameKey, out var scene) ? scene.text : null,
+                gameMode = state.TryGetValue(GameModeKey, out var mode) ? mode.text : null,
+                levelId = state.TryGetValue(LevelIdKey, out var level) ? level.text : null,
+                customData = customData
+            };
+
+            var userId = user.TryGetValue(UserIdKey, out var id) ? id.text : null;
+            return new ContextSnapshot(_version, gameState, userId, tags);
+        }
+    }
+}
@@ -15,6 +15,15 @@ namespace MoonForge.ErrorTracking
         private int _fpsFrameCount;
         private float _fpsTimeLeft;
 
+#if UNITY_ANDROID && !UNITY_EDITOR
+        // PowerManager thermal status is a JNI round trip, so errors share one reading for a while
+        private const int ThermalStatusCacheMs = 5000;
+        private string _cachedThermalState;
+        private int _thermalStateReadAt;
+        private bool _hasThermalState;
+        private bool _thermalStatusUnavailable;
+#endif
+
         private static DeviceContextCollector _instance;
         public static DeviceContextCollector Instance => _instance ??= new DeviceContextCollector();
 
@@ -50,12 +59,16 @@ namespace MoonForge.ErrorTracking
                 cpuArchitecture = GetCpuArchitecture(),
                 memoryUsedMb = GetUsedMemoryMb(),
                 memoryAvailableMb = GetAvailableMemoryMb(),
+                cpuUsagePercent = NativeCpuSampler.ProcessCpuPercent,
                 fps = _lastFps > 0 ? _lastFps : null,
                 batteryLevel = GetBatteryLevel(),
                 batteryCharging = GetBatteryCharging(),
                 thermalState = GetThermalState()
             };
 
+            // sysfs temperatures, CPU frequency caps and battery fallbacks (Android, Linux)
+            NativeDeviceSampler.Apply(context, NativeDeviceSampler.Latest);
+
             return context;
         }
 
@@ -195,7 +208,16 @@ namespace MoonForge.ErrorTracking
 #if UNITY_IOS && !UNITY_EDITOR
             return GetIOSThermalState();
 #elif UNITY_ANDROID && !UNITY_EDITOR
-            return GetAndroidThermalState();
+            if (_thermalStatusUnavailable) return null;
+
+            var now = Environment.TickCount;
+            if (!_hasThermalState || unchecked(now - _thermalStateReadAt) >= ThermalStatusCacheMs)
+            {
+                _cachedThermalState = GetAndroidThermalState();
+                _thermalStateReadAt = now;
+                _hasThermalState = true;
+            }
+            return _cachedThermalState;
 #else
             return null;
 #endif
@@ -240,6 +262,9 @@ namespace MoonForge.ErrorTracking
             }
             catch (Exception ex)
             {
+                // getCurrentThermalStatus needs API 29; the device sampler's temperatures stand in from now on
+                if (ex.Message != null && ex.Message.Contains("NoSuchMethod"))
+                    _thermalStatusUnavailable = true;
                 Debug.LogWarning($"[MoonForge] JNI call failed in GetAndroidThermalState: {ex.Message}. " +
                     "Thermal API may not be available on this device/Android version.");
             }
@@ -5,20 +5,16 @@ using UnityEngine.SceneManagement;
 namespace MoonForge.ErrorTracking
 {
     /// <summary>
-    /// Tracks and collects game state information
+    /// Tracks and collects game state information. The state itself lives in
+    /// <see cref="ContextStore"/>, so native crash records carry it too.
     /// </summary>
     public class GameStateCollector
     {
-        private string _gameMode;
-        private string _levelId;
-        private Dictionary<string, object> _customData;
-
         private static GameStateCollector _instance;
         public static GameStateCollector Instance => _instance ??= new GameStateCollector();
 
         private GameStateCollector()
         {
-            _customData = new Dictionary<string, object>();
         }
 
         /// <summary>
@@ -27,7 +23,7 @@ namespace MoonForge.ErrorTracking
         /// <param name="gameMode">Game mode identifier (e.g., "pvp", "campaign", "tutorial")</param>
         public void SetGameMode(string gameMode)
         {
-            _gameMode = gameMode;
+            ContextStore.SetString(ContextScope.GameState, ContextStore.GameModeKey, gameMode);
         }
 
         /// <summary>
@@ -36,24 +32,58 @@ namespace MoonForge.ErrorTracking
         /// <param name="levelId">Level identifier</param>
         public void SetLevelId(string levelId)
         {
-            _levelId = levelId;
+            ContextStore.SetString(ContextScope.GameState, ContextStore.LevelIdKey, levelId);
+        }
+
+        /// <summary>
+        /// Record the active scene; <see cref="Collect"/> also picks it up when it changes
+        /// </summary>
+        public void SetSceneName(string sceneName)
+        {
+            ContextStore.SetString(ContextScope.GameState, ContextStore.SceneNameKey, SdkStringTable.Intern(sceneName));
         }
 
         /// <summary>
         /// Set custom game state data
         /// </summary>
         /// <param name="key">Data key</param>
-        /// <param name="value">Data value (must be JSON serializable)</param>
+        /// <param name="value">Data value (must be JSON serializable); null removes the key.
+        /// Strings, numbers and bools also reach native crash records.</param>
         public void SetCustomData(string key, object value)
         {
-            if (value == null)
-            {
-                _customData.Remove(key);
-            }
-            else
-            {
-                _customData[key] = value;
-            }
+            ContextStore.Set(ContextScope.CustomData, key, value);
+        }
+
+        /// <summary>
+        /// Set a custom game state value without boxing it
+        /// </summary>
+        public void SetCustomData(string key, long value)
+        {
+            ContextStore.SetLong(ContextScope.CustomData, key, value);
+        }
+
+        /// <summary>
+        /// Set a custom game state value without boxing it
+        /// </summary>
+        public void SetCustomData(string key, double value)
+        {
+            ContextStore.SetDouble(ContextScope.CustomData, key, value);
+        }
+
+        /// <summary>
+        /// Set a custom game state value without boxing it
+        /// </summary>
+        public void SetCustomData(string key, float value)
+        {
+            ContextStore.SetDouble(ContextScope.CustomData, key, ContextStore.Widen(value));
+        }
+
+        /// <summary>
+        /// Set a custom game state value without boxing it
+        /// </summary>
+        public void SetCustomData(string key, bool value)
+        {
+            ContextStore.SetBool(ContextScope.CustomData, key, value);
         }
 
         /// <summary>
@@ -75,23 +105,22 @@ namespace MoonForge.ErrorTracking
         /// </summary>
         public void ClearCustomData()
         {
-            _customData.Clear();
+            ContextStore.Clear(ContextScope.CustomData);
         }
 
         /// <summary>
-        /// Collect current game state
+        /// Collect current game state. The result is shared by every payload collected
+        /// until the state changes; treat it as read-only.
         /// </summary>
         public GameState Collect()
         {
-            var state = new GameState
+            var sceneName = GetCurrentSceneName();
+            if (sceneName != ContextStore.Current.gameState.sceneName)
             {
-                sceneName = GetCurrentSceneName(),
-                gameMode = _gameMode,
-                levelId = _levelId,
-                customData = _customData.Count > 0 ? new Dictionary<string, object>(_customData) : null
-            };
+                ContextStore.SetString(ContextScope.GameState, ContextStore.SceneNameKey, sceneName);
+            }
 
-            return state;
+            return ContextStore.Current.gameState;
         }
 
         /// <summary>
@@ -100,7 +129,7 @@ namespace MoonForge.ErrorTracking
         private string GetCurrentSceneName()
         {
             var scene = SceneManager.GetActiveScene();
-            return scene.IsValid() ? scene.name : null;
+            return scene.IsValid() ? SdkStringTable.Intern(scene.name) : null;
         }
 
         /// <summary>
@@ -108,9 +137,9 @@ namespace MoonForge.ErrorTracking
         /// </summary>
         public void Reset()
         {
-            _gameMode = null;
-            _levelId = null;
-            _customData.Clear();
+            ContextStore.Remove(ContextScope.GameState, ContextStore.GameModeKey);
+            ContextStore.Remove(ContextScope.GameState, ContextStore.LevelIdKey);
+            ContextStore.Clear(ContextScope.CustomData);
         }
     }
 }
@@ -99,4 +99,80 @@ namespace MoonForge.ErrorTracking
         Cellular,
         Ethernet
     }
+
+    /// <summary>
+    /// Where SDK background threads run on devices with mixed core types
+    /// </summary>
+    public enum ThreadAffinityPolicy
+    {
+        /// <summary>Leave placement and priority to the OS</summary>
+        None,
+        /// <summary>Pin to efficiency cores at lowered priority</summary>
+        EfficiencyCores,
+        /// <summary>Efficiency cores, lowest priority, and SCHED_IDLE where permitted</summary>
+        Background
+    }
+
+    /// <summary>
+    /// Lower-case wire names, as literals so building a payload doesn't allocate them
+    /// </summary>
+    public static class ErrorEnumNames
+    {
+        public static string ToWireName(this ErrorType value)
+        {
+            switch (value)
+            {
+                case ErrorType.Crash: return "crash";
+                case ErrorType.Exception: return "exception";
+                case ErrorType.Network: return "network";
+                default: return "custom";
+            }
+        }
+
+        public static string ToWireName(this ErrorCategory value)
+        {
+            switch (value)
+            {
+                case ErrorCategory.Native: return "native";
+                case ErrorCategory.Managed: return "managed";
+                case ErrorCategory.Handled: return "handled";
+                default: return "unhandled";
+            }
+        }
+
+        public static string ToWireName(this ErrorLevel value)
+        {
+            switch (value)
+            {
+                case ErrorLevel.Info: return "info";
+                case ErrorLevel.Warning: return "warning";
+                case ErrorLevel.Fatal: return "fatal";
+                default: return "error";
+            }
+        }
+
+        public static string ToWireName(this BreadcrumbType value)
+        {
+            switch (value)
+            {
+                case BreadcrumbType.Navigation: return "navigation";
+                case BreadcrumbType.Network: return "network";
+                case BreadcrumbType.User: return "user";
+                case BreadcrumbType.Debug: return "debug";
+                default: return "error";
+            }
+        }
+
+        public static string ToWireName(this BreadcrumbLevel value)
+        {
+            switch (value)
+            {
+                case BreadcrumbLevel.Debug: return "debug";
+                case BreadcrumbLevel.Warning: return "warning";
+                case BreadcrumbLevel.Error: return "error";
+                case BreadcrumbLevel.Fatal: return "fatal";
+                default: return "info";
+            }
+        }
+    }
 }
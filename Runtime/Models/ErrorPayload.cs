@@ -27,19 +27,22 @@ namespace MoonForge.ErrorTracking
     [Serializable]
     public class Breadcrumb
     {
+        [WireRequired]
         public string type;
         public string category;
         public string message;
+        [WireRequired]
         public string level;
         public Dictionary<string, object> data;
+        [WireRequired]
         public long timestamp;
 
         public Breadcrumb(BreadcrumbType type, string message, BreadcrumbLevel level = BreadcrumbLevel.Info, string category = null)
         {
-            this.type = type.ToString().ToLowerInvariant();
+            this.type = type.ToWireName();
             this.message = message;
-            this.level = level.ToString().ToLowerInvariant();
-            this.category = category;
+            this.level = level.ToWireName();
+            this.category = SdkStringTable.Intern(category);
             this.timestamp = DateTimeOffset.UtcNow.ToUnixTimeMilliseconds();
         }
 
@@ -56,18 +59,94 @@ namespace MoonForge.ErrorTracking
     [Serializable]
     public class DeviceContext
     {
+        [WireRequired]
         public string platform;
+        [WireRequired]
         public string osVersion;
+        [WireRequired]
         public string deviceModel;
         public string manufacturer;
         public string cpuArchitecture;
         public float? memoryUsedMb;
         public float? memoryAvailableMb;
+        /// <summary>
+        /// Process CPU usage over the last sampling interval, in percent of all cores
+        /// </summary>
         public float? cpuUsagePercent;
+
+        /// <summary>
+        /// Busiest threads over the last sampling interval (crash reports)
+        /// </summary>
+        public List<ThreadCpuUsage> threadCpu;
+
         public float? fps;
         public float? batteryLevel;
         public bool? batteryCharging;
         public string thermalState;
+
+        /// <summary>
+        /// Hottest thermal zone, in degrees Celsius
+        /// </summary>
+        public float? temperatureC;
+
+        /// <summary>
+        /// Lowest CPU frequency cap across clusters, in percent of the cluster's top frequency (100 = not throttled)
+        /// </summary>
+        public float? cpuFrequencyCapPercent;
+
+        public float? batteryTemperatureC;
+
+        /// <summary>
+        /// Current and capped frequency of each CPU cluster
+        /// </summary>
+        public List<CpuClusterFrequency> cpuClusters;
+    }
+
+    /// <summary>
+    /// CPU time attributed to one thread
+    /// </summary>
+    [Serializable]
+    public class ThreadCpuUsage
+    {
+        [WireRequired]
+        public int tid;
+        [WireRequired]
+        public string name;
+
+        /// <summary>
+        /// Usage over the last sampling interval, in percent of one core
+        /// </summary>
+        [WireRequired]
+        public float cpuPercent;
+
+        /// <summary>
+        /// Total CPU time used by the thread since it started
+        /// </summary>
+        [WireRequired]
+        public long cpuTimeMs;
+    }
+
+    /// <summary>
+    /// Frequencies of one CPU cluster, in kHz
+    /// </summary>
+    [Serializable]
+    public class CpuClusterFrequency
+    {
+        /// <summary>
+        /// First CPU of the cluster
+        /// </summary>
+        [WireRequired]
+        public int cpu;
+        [WireRequired]
+        public int curKhz;
+        [WireRequired]
+        public int maxKhz;
+
+        /// <summary>
+        /// Current upper limit (scaling_max_freq); below maxKhz when thermal or power-save limits apply
+        /// </summary>
+        [WireRequired]
+        public int capKhz;
     }
 
     /// <summary>
@@ -99,7 +178,9 @@ namespace MoonForge.ErrorTracking
     [Serializable]
     public class NetworkRequest
     {
+        [WireRequired]
         public string url;
+        [WireRequired]
         public string method;
         public int? statusCode;
         public float? durationMs;
@@ -114,22 +195,39 @@ namespace MoonForge.ErrorTracking
     public class ErrorPayloadInner
     {
         public string game;
+        [WireRequired]
         public string errorType;
+        [WireRequired]
         public string errorCategory;
+        [WireRequired]
         public string errorLevel;
+        [WireRequired]
         public string message;
 
         public List<StackFrame> frames;
         public string rawStackTrace;
 
+        /// <summary>
+        /// Recent native log and stdout/stderr lines, oldest first
+        /// </summary>
+        public string logTail;
+
         public string exceptionClass;
+
+        /// <summary>
+        /// Kind of fault behind a native crash, e.g. "null_dereference" or "stack_overflow" (see <see cref="FaultClassifier"/>)
+        /// </summary>
+        public string faultClass;
+
         public string fingerprint;
 
         public DeviceContext device;
         public NetworkContext network;
         public GameState gameState;
 
+        [WireRequired]
         public string appVersion;
+        [WireRequired]
         public string buildNumber;
         public string unityVersion;
 
@@ -151,33 +249,78 @@ namespace MoonForge.ErrorTracking
     [Serializable]
     public class ErrorPayload
     {
+        [WireRequired]
         public string type = "error";
+        [WireRequired]
         public ErrorPayloadInner payload;
     }
 
+    /// <summary>
+    /// Part of an error that was cut to keep it within the payload size budget
+    /// </summary>
+    [Serializable]
+    public class PayloadTruncation
+    {
+        /// <summary>
+        /// What was cut: "gameState.customData", "breadcrumbs", "rawStackTrace", "logTail", "frames", "tags" or "message"
+        /// </summary>
+        [WireRequired]
+        public string field;
+
+        /// <summary>
+        /// Size before cutting: encoded UTF-8 bytes for text, entries for lists and dictionaries
+        /// </summary>
+        [WireRequired]
+        public int original;
+
+        /// <summary>
+        /// Size kept, in the same unit
+        /// </summary>
+        [WireRequired]
+        public int kept;
+    }
+
     /// <summary>
     /// Error item in batch submission (without game field)
     /// </summary>
     [Serializable]
     public class BatchErrorItem
     {
+        [WireRequired]
         public string clientErrorId;
+        [WireRequired]
         public string errorType;
+        [WireRequired]
         public string errorCategory;
+        [WireRequired]
         public string errorLevel;
+        [WireRequired]
         public string message;
 
         public List<StackFrame> frames;
         public string rawStackTrace;
 
+        /// <summary>
+        /// Recent native log and stdout/stderr lines, oldest first
+        /// </summary>
+        public string logTail;
+
         public string exceptionClass;
+
+        /// <summary>
+        /// Kind of fault behind a native crash, e.g. "null_dereference" or "stack_overflow" (see <see cref="FaultClassifier"/>)
+        /// </summary>
+        public string faultClass;
+
         public string fingerprint;
 
         public DeviceContext device;
         public NetworkContext network;
         public GameState gameState;
 
+        [WireRequired]
         public string appVersion;
+        [WireRequired]
         public string buildNumber;
         public string unityVersion;
 
@@ -191,6 +334,11 @@ namespace MoonForge.ErrorTracking
         public NetworkRequest networkRequest;
 
         public Dictionary<string, string> tags;
+
+        /// <summary>
+        /// Parts cut to fit the per-error size budget, in the order they were cut
+        /// </summary>
+        public List<PayloadTruncation> truncated;
     }
 
     /// <summary>
@@ -199,9 +347,18 @@ namespace MoonForge.ErrorTracking
     [Serializable]
     public class ErrorBatchPayload
     {
+        [WireRequired]
         public string type = "error_batch";
+        [WireRequired]
         public string game;
+        [WireRequired]
         public List<BatchErrorItem> errors;
+
+        /// <summary>
+        /// Arena owning the items and the encode buffer; released once the upload has finished
+        /// </summary>
+        [NonSerialized]
+        internal PayloadArena arena;
     }
 
     /// <summary>
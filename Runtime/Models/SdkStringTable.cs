@@ -0,0 +1,82 @@
+using System;
+using System.Collections.Concurrent;
+using System.Threading;
+
+namespace MoonForge.ErrorTracking
+{
+    /// <summary>
+    /// Process-wide, append-only table of recurring SDK strings: frame modules,
+    /// functions and files, exception classes, scene names, breadcrumb categories.
+    /// Every payload that mentions one shares a single instance, so queued, stored
+    /// and breadcrumb copies don't each hold their own, and comparisons between
+    /// them succeed on the reference check. Each string also gets a stable id.
+    ///
+    /// Lookups never lock; only adding a new string does. The table is bounded, so
+    /// high-cardinality input (messages, ids) must not be interned; past the bound
+    /// strings are returned as they are.
+    /// </summary>
+    public static class SdkStringTable
+    {
+        /// <summary>
+        /// Upper bound on distinct strings
+        /// </summary>
+        public const int Capacity = 16384;
+
+        // Longer strings are rarely repeated verbatim; not worth a slot
+        private const int MaxLength = 512;
+
+        private static readonly ConcurrentDictionary<string, int> _ids =
+            new ConcurrentDictionary<string, int>(StringComparer.Ordinal);
+        private static readonly string[] _strings = new string[Capacity];
+        private static readonly object _appendLock = new object();
+        private static int _count;
+
+        /// <summary>
+        /// Number of strings in the table
+        /// </summary>
+        public static int Count => Volatile.Read(ref _count);
+
+        /// <summary>
+        /// The shared instance equal to <paramref name="value"/>, adding it if there is room.
+        /// Null and "" are returned unchanged.
+        /// </summary>
+        public static string Intern(string value)
+        {
+            var id = GetId(value);
+            return id >= 0 ? _strings[id] : value;
+        }
+
+        /// <summary>
+        /// Stable id of <paramref name="value"/>, adding it if there is room; -1 for null, "",
+        /// over-long strings and once the table is full
+        /// </summary>
+        public static int GetId(string value)
+        {
+            if (string.IsNullOrEmpty(value) || value.Length > MaxLength) return -1;
+
+            if (_ids.TryGetValue(value, out var id)) return id;
+
+            lock (_appendLock)
+            {
+                if (_ids.TryGetValue(value, out id)) return id;
+
+                id = _count;
+                if (id >= Capacity) return -1;
+
+                // Slot first, then the id, so a reader that finds the id also finds the string
+                _strings[id] = value;
+                Volatile.Write(ref _count, id + 1);
+                _ids[value] = id;
+                return id;
+            }
+        }
+
+        /// <summary>
+        /// The string with the given id, or null if there is none
+        /// </summary>
+        public static string Resolve(int id)
+        {
+            return id >= 0 && id < Volatile.Read(ref _count) ? _strings[id] : null;
+        }
+    }
+}
@@ -0,0 +1,17 @@
+using System;
+
+namespace MoonForge.ErrorTracking
+{
+    /// <summary>
+    /// Marks a wire model field that is always sent: null strings go out as "", null
+    /// objects as null. Every other field is left out when it is null, empty, false or
+    /// not positive, and decoders reject payloads that lack a required field.
+    ///
+    /// The models in ErrorPayload.cs are the wire schema. After changing them, run
+    /// MoonForge > Developer > Regenerate Wire Codecs to update the encoder and decoder.
+    /// </summary>
+    [AttributeUsage(AttributeTargets.Field)]
+    public sealed class WireRequiredAttribute : Attribute
+    {
+    }
+}
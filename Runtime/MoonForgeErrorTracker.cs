@@ -1,5 +1,7 @@
 using System;
+using System.Collections;
 using System.Collections.Generic;
+using System.Globalization;
 using UnityEngine;
 using UnityEngine.SceneManagement;
 using MoonForge.ErrorTracking.Analytics;
@@ -39,6 +41,11 @@ namespace MoonForge.ErrorTracking
         /// </summary>
         public static bool IsInitialized => _isInitialized && _instance != null;
 
+        /// <summary>
+        /// Time the tracker's last Update took, scheduled main-thread work included (ms)
+        /// </summary>
+        public double LastUpdateMs { get; private set; }
+
         [Header("Configuration")]
         [SerializeField]
         private ErrorTrackerConfig _config;
@@ -49,13 +56,21 @@ namespace MoonForge.ErrorTracking
         private BatchQueue _batchQueue;
         private OfflineStorage _offlineStorage;
         private AdaptiveSampler _sampler;
+        private FrameBudgetScheduler _scheduler;
+        private SdkWorkerThread _worker;
 
         // State
         private string _userId;
         private string _sessionId;
-        private Dictionary<string, string> _userTags;
-        private float _lastCleanupTime;
-        private const float CleanupInterval = 300f; // 5 minutes
+        private readonly System.Diagnostics.Stopwatch _updateTimer = new System.Diagnostics.Stopwatch();
+
+        private static readonly TimeSpan CleanupInterval = TimeSpan.FromMinutes(5);
+        private static readonly TimeSpan StorageCompactionDelay = TimeSpan.FromSeconds(30);
+        private static readonly TimeSpan ModuleRefreshInterval = TimeSpan.FromSeconds(30);
+        private static readonly TimeSpan HitchDrainInterval = TimeSpan.FromSeconds(1);
+        private static readonly TimeSpan HangCheckInterval = TimeSpan.FromMilliseconds(500);
+        private const int WorkerShutdownTimeoutMs = 500;
+        private const int LogTailAttachBytes = 4096;
 
         #region Initialization
 
@@ -113,13 +128,20 @@ namespace MoonForge.ErrorTracking
         {
             // Generate session ID
             _sessionId = Guid.NewGuid().ToString();
-            _userTags = new Dictionary<string, string>();
+
+            // Main-thread work runs within the frame budget; I/O and serialization run on the worker
+            _scheduler = new FrameBudgetScheduler(_config);
+            _worker = new SdkWorkerThread(_config);
 
             // Initialize components
-            _transport = new HttpTransport(_config, this);
+            _transport = new HttpTransport(_config, this, _worker, _scheduler);
             _offlineStorage = new OfflineStorage(_config);
             _sampler = new AdaptiveSampler(_config);
-            _batchQueue = new BatchQueue(_config, _transport, OnSendFailed);
+            _batchQueue = new BatchQueue(_config, _transport, OnSendFailed, _worker, _scheduler);
+
+            // Periodic maintenance runs on the worker's timers instead of being polled every frame
+            _worker.ScheduleRepeating(CleanupInterval, CleanupInterval, _sampler.Cleanup);
+            _worker.ScheduleRepeating(StorageCompactionDelay, CleanupInterval, () => _offlineStorage.Cleanup());
 
             // Initialize context collectors
             BreadcrumbTracker.Instance.Configure(_config.maxBreadcrumbs);
@@ -134,6 +156,63 @@ namespace MoonForge.ErrorTracking
                 NativeCrashHandler.Initialize(_config, OnNativeCrashCaptured);
             }
 
+            // Per-thread CPU attribution for crash reports and DeviceContext.cpuUsagePercent (Android, Linux)
+            if (_config.enableCpuSampling && NativeCpuSampler.IsSupported)
+            {
+                var cpuInterval = TimeSpan.FromSeconds(_config.cpuSampleIntervalSeconds);
+                _worker.Post(NativeCpuSampler.Sample);
+                _worker.ScheduleRepeating(cpuInterval, cpuInterval, NativeCpuSampler.Sample);
+            }
+
+            // Thermal throttling and battery state for breadcrumbs and DeviceContext (Android, Linux)
+            if (_config.enableDeviceSampling && NativeDeviceSampler.IsSupported)
+            {
+                var deviceInterval = TimeSpan.FromSeconds(_config.deviceSampleIntervalSeconds);
+                _worker.Post(NativeDeviceSampler.Sample);
+                _worker.ScheduleRepeating(deviceInterval, deviceInterval, NativeDeviceSampler.Sample);
+            }
+
+            // Main-thread frames over hitchThresholdMs, with counter deltas, as breadcrumbs (Android, Linux)
+            if (NativeHitchRecorder.Start(_config))
+            {
+                _worker.ScheduleRepeating(HitchDrainInterval, HitchDrainInterval, NativeHitchRecorder.Drain);
+            }
+
+            // Recent native log lines for crash reports (Android)
+            var logTailStarted = NativeLogTail.Start(_config);
+
+            // Sampled native allocation profiling for low-memory reports (Android)
+            var profilerStarted = _config.enableAllocationProfiler && NativeAllocationProfiler.Start(_config);
+            if (profilerStarted)
+            {
+                Application.lowMemory += OnLowMemory;
+            }
+
+            // Deadlocks and long main-thread lock waits in native plugins (Android, Linux).
+            // Checked from the worker, which keeps running while the main thread is stuck;
+            // the record is reported once the main thread runs again, or on the next launch
+            var lockMonitorStarted = NativeLockMonitor.Start(_config);
+            if (lockMonitorStarted)
+            {
+                _worker.ScheduleRepeating(HangCheckInterval, HangCheckInterval, () =>
+                {
+                    if (NativeLockMonitor.Check()) _scheduler.Post(NativeCrashHandler.ReportHangRecords);
+                });
+            }
+
+            // The native crash handler hooks pthread_create to give new threads a signal stack
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+            var threadHookInstalled = NativeCrashHandler.IsInitialized;
+#else
+            var threadHookInstalled = false;
+#endif
+
+            // Plugins loaded on first use need their imports patched too
+            if (threadHookInstalled || logTailStarted || profilerStarted || lockMonitorStarted)
+            {
+                _worker.ScheduleRepeating(ModuleRefreshInterval, ModuleRefreshInterval, NativeAllocationProfiler.RefreshHooks);
+            }
+
             // Initialize network error interceptor
             NetworkErrorInterceptor.Initialize(_config, OnNetworkErrorCaptured);
 
@@ -149,11 +228,19 @@ namespace MoonForge.ErrorTracking
             // Initialize analytics if enabled
             if (_config.enableAnalytics)
             {
-                MoonForgeAnalytics.Initialize(_config, this);
+                MoonForgeAnalytics.Initialize(_config, this, _scheduler, _worker);
                 if (_config.debugMode)
                 {
                     Debug.Log("[MoonForge] Analytics initialized");
                 }
+
+                // Session end reasons that survive crashes and kills, reported on the next launch (Android, Linux)
+                if (NativeSessionRecorder.Begin(_config, _sessionId))
+                {
+                    var heartbeatInterval = TimeSpan.FromSeconds(_config.sessionHeartbeatSeconds);
+                    _worker.ScheduleRepeating(heartbeatInterval, heartbeatInterval, NativeSessionRecorder.Heartbeat);
+                    NativeSessionRecorder.ReportPreviousSession();
+                }
             }
         }
 
@@ -166,6 +253,7 @@ namespace MoonForge.ErrorTracking
             {
                 MoonForgeAnalytics.Shutdown();
             }
+            NativeSessionRecorder.End();
 
             if (_exceptionHandler != null)
             {
@@ -178,6 +266,15 @@ namespace MoonForge.ErrorTracking
                 NativeCrashHandler.Shutdown();
             }
 
+            NativeHitchRecorder.Stop();
+            NativeLockMonitor.Stop();
+
+            if (NativeAllocationProfiler.IsRunning)
+            {
+                Application.lowMemory -= OnLowMemory;
+                NativeAllocationProfiler.Stop();
+            }
+
             if (_config.trackSceneChanges)
             {
                 SceneManager.sceneLoaded -= OnSceneLoaded;
@@ -186,6 +283,15 @@ namespace MoonForge.ErrorTracking
             // Flush remaining errors
             _batchQueue?.Flush();
 
+            // Let serialization and disk writes finish first: they hand their results
+            // (batch requests, analytics saves) to the scheduler, and anything posted
+            // to the worker from now on runs inline
+            _worker?.Shutdown(WorkerShutdownTimeoutMs);
+            _scheduler?.RunAll();
+
+            // Last, so the events flushed above still carry the tail
+            NativeLogTail.Stop();
+
             _isInitialized = false;
             _instance = null;
         }
@@ -196,26 +302,24 @@ namespace MoonForge.ErrorTracking
 
         private void Update()
         {
+            _updateTimer.Restart();
+
             // Update FPS tracking
             DeviceContextCollector.Instance.UpdateFps();
+            NativeHitchRecorder.FrameBoundary();
 
-            // Update batch queue
-            if (_config.enableBatching)
-            {
-                _batchQueue?.Update();
-            }
+            // Deferred main-thread work, bounded by mainThreadBudgetMs
+            _scheduler?.Tick();
 
-            // Periodic cleanup
-            if (Time.unscaledTime - _lastCleanupTime > CleanupInterval)
-            {
-                _lastCleanupTime = Time.unscaledTime;
-                _sampler?.Cleanup();
-                _offlineStorage?.Cleanup();
-            }
+            LastUpdateMs = _updateTimer.Elapsed.TotalMilliseconds;
         }
 
         private void OnApplicationPause(bool pauseStatus)
         {
+            // Time spent in the background is not a hitch
+            NativeHitchRecorder.Reset();
+            NativeSessionRecorder.SetForeground(!pauseStatus);
+
             if (pauseStatus)
             {
                 // Flush errors when app is paused
@@ -229,6 +333,8 @@ namespace MoonForge.ErrorTracking
                 // Flush any queued analytics events
                 if (MoonForgeAnalytics.IsInitialized)
                 {
+                    // Worker timers don't advance while the device sleeps, so check the session against wall time
+                    MoonForgeAnalytics.CheckSessionTimeout();
                     MoonForgeAnalytics.Flush();
                 }
             }
@@ -236,6 +342,9 @@ namespace MoonForge.ErrorTracking
 
         private void OnApplicationQuit()
         {
+            // OnDestroy is not guaranteed on mobile
+            NativeSessionRecorder.End();
+
             // Store any queued errors before quit
             if (_config.enableOfflineStorage && _batchQueue != null)
             {
@@ -274,7 +383,17 @@ namespace MoonForge.ErrorTracking
         public void SetUser(string userId, Dictionary<string, string> tags = null)
         {
             _userId = userId;
-            _userTags = tags ?? new Dictionary<string, string>();
+
+            // Kept in the context store, so native crash records name the user too
+            ContextStore.SetString(ContextScope.User, ContextStore.UserIdKey, userId);
+            ContextStore.Clear(ContextScope.Tag);
+            if (tags != null)
+            {
+                foreach (var kvp in tags)
+                {
+                    ContextStore.SetString(ContextScope.Tag, kvp.Key, kvp.Value ?? "");
+                }
+            }
 
             if (_config.debugMode)
             {
@@ -288,7 +407,8 @@ namespace MoonForge.ErrorTracking
         public void ClearUser()
         {
             _userId = null;
-            _userTags?.Clear();
+            ContextStore.Remove(ContextScope.User, ContextStore.UserIdKey);
+            ContextStore.Clear(ContextScope.Tag);
         }
 
         /// <summary>
@@ -303,9 +423,20 @@ namespace MoonForge.ErrorTracking
             if (!string.IsNullOrEmpty(levelId))
             {
                 GameStateCollector.Instance.SetLevelId(levelId);
+                NativeHitchRecorder.SetLevel(levelId);
             }
         }
 
+        /// <summary>
+        /// Name the loading work in progress (e.g. "bundle:forest_hd", "stream:chunk_12") so hitches
+        /// during it are attributed to it. When it ends, a breadcrumb records its duration and storage I/O.
+        /// Call from the main thread; pass null when the work is done.
+        /// </summary>
+        public void SetActivity(string activity)
+        {
+            NativeHitchRecorder.SetActivity(activity);
+        }
+
         /// <summary>
         /// Add custom game state data
         /// </summary>
@@ -342,9 +473,9 @@ namespace MoonForge.ErrorTracking
                 game = _config.gameId,
                 errorType = "exception",
                 errorCategory = "handled",
-                errorLevel = level.ToString().ToLowerInvariant(),
+                errorLevel = level.ToWireName(),
                 message = exception.Message,
-                exceptionClass = exception.GetType().FullName,
+                exceptionClass = SdkStringTable.Intern(exception.GetType().FullName),
                 rawStackTrace = exception.StackTrace,
                 device = DeviceContextCollector.Instance.Collect(),
                 network = DeviceContextCollector.Instance.CollectNetworkContext(),
@@ -410,7 +541,7 @@ namespace MoonForge.ErrorTracking
                 game = _config.gameId,
                 errorType = "custom",
                 errorCategory = "handled",
-                errorLevel = level.ToString().ToLowerInvariant(),
+                errorLevel = level.ToWireName(),
                 message = message,
                 device = DeviceContextCollector.Instance.Collect(),
                 network = DeviceContextCollector.Instance.CollectNetworkContext(),
@@ -464,6 +595,13 @@ namespace MoonForge.ErrorTracking
 
             payload.fingerprint = decision.Fingerprint;
 
+            // Only errors that survive sampling pay for the copy
+            if (_config.attachLogTailToErrors && payload.logTail == null &&
+                (payload.errorLevel == "error" || payload.errorLevel == "fatal"))
+            {
+                payload.logTail = NativeLogTail.Read(LogTailAttachBytes);
+            }
+
             // Check connectivity
             if (!_transport.HasConnectivity())
             {
@@ -471,10 +609,7 @@ namespace MoonForge.ErrorTracking
                 {
                     Debug.Log("[MoonForge] No connectivity, storing offline");
                 }
-                if (_config.enableOfflineStorage)
-                {
-                    _offlineStorage.Store(payload);
-                }
+                StoreOffline(payload);
                 return;
             }
 
@@ -503,19 +638,25 @@ namespace MoonForge.ErrorTracking
 
             _transport.SendError(errorPayload, response =>
             {
-                if (response?.status == "error" && _config.enableOfflineStorage)
+                if (response?.status == "error")
                 {
-                    _offlineStorage.Store(payload);
+                    StoreOffline(payload);
                 }
             });
         }
 
         private void OnSendFailed(ErrorPayloadInner payload)
         {
-            if (_config.enableOfflineStorage)
-            {
-                _offlineStorage.Store(payload);
-            }
+            StoreOffline(payload);
+        }
+
+        /// <summary>
+        /// Persist an error on the worker thread so the disk write stays off the main thread
+        /// </summary>
+        private void StoreOffline(ErrorPayloadInner payload)
+        {
+            if (!_config.enableOfflineStorage) return;
+            _worker.Post(() => _offlineStorage.Store(payload));
         }
 
         private void SendStoredErrors()
@@ -523,17 +664,23 @@ namespace MoonForge.ErrorTracking
             if (!_config.enableOfflineStorage) return;
             if (!_transport.HasConnectivity()) return;
 
-            var storedErrors = _offlineStorage.GetStoredErrors();
-            if (storedErrors.Count == 0) return;
+            // Read and parse on the worker, then hand the errors back to the main thread a slice at a time
+            _worker.Post(() =>
+            {
+                var storedErrors = _offlineStorage.TakeStoredErrors();
+                if (storedErrors.Count == 0) return;
 
+                _scheduler.PostSliced(EnqueueStoredErrors(storedErrors));
+            });
+        }
+
+        private IEnumerator EnqueueStoredErrors(List<ErrorPayloadInner> storedErrors)
+        {
             if (_config.debugMode)
             {
                 Debug.Log($"[MoonForge] Sending {storedErrors.Count} stored errors");
             }
 
-            // Clear storage and enqueue
-            _offlineStorage.Clear();
-
             foreach (var error in storedErrors)
             {
                 if (_config.enableBatching)
@@ -544,30 +691,47 @@ namespace MoonForge.ErrorTracking
                 {
                     SendErrorDirectly(error);
                 }
+                yield return null;
             }
         }
 
         private void OnSceneLoaded(Scene scene, LoadSceneMode mode)
         {
-            BreadcrumbTracker.Instance.AddNavigation($"Loaded scene: {scene.name}", "scene");
+            // Storage I/O since the previous scene change, i.e. mostly this load
+            GameStateCollector.Instance.SetSceneName(SceneManager.GetActiveScene().name);
+            var io = NativeHitchRecorder.SetScene(SceneManager.GetActiveScene().name);
+            var breadcrumb = new Breadcrumb(BreadcrumbType.Navigation, $"Loaded scene: {scene.name}{NativeHitchRecorder.DescribeIo(io)}",
+                BreadcrumbLevel.Info, "scene");
+            BreadcrumbTracker.Instance.Add(io != null ? breadcrumb.WithData(io) : breadcrumb);
         }
 
         private void OnNativeCrashCaptured(ErrorPayloadInner payload)
         {
             // Native crashes are always critical - skip sampling
-            payload.userId = _userId;
             payload.sessionId = _sessionId;
-            payload.tags = MergeTags(payload.tags);
+
+            // A record with a context section already names the crashed process's user and tags
+            if (payload.tags == null || !payload.tags.ContainsKey(NativeContextStore.VersionTag))
+            {
+                payload.userId = _userId;
+                payload.tags = MergeTags(payload.tags);
+            }
 
             if (_config.debugMode)
             {
                 Debug.Log($"[MoonForge] Native crash captured: {payload.message}");
             }
 
-            // Try to send immediately (crash is imminent)
+            // Try to send immediately (crash is imminent), bypassing the worker and frame budget
             if (_transport.HasConnectivity())
             {
-                SendErrorDirectly(payload);
+                _transport.SendError(new ErrorPayload { payload = payload }, response =>
+                {
+                    if (response?.status == "error" && _config.enableOfflineStorage)
+                    {
+                        _offlineStorage.Store(payload);
+                    }
+                }, immediate: true);
             }
             else if (_config.enableOfflineStorage)
             {
@@ -575,6 +739,46 @@ namespace MoonForge.ErrorTracking
             }
         }
 
+        private void OnLowMemory()
+        {
+            var payload = new ErrorPayloadInner
+            {
+                game = _config.gameId,
+                errorType = "custom",
+                errorCategory = "handled",
+                errorLevel = "warning",
+                message = "Low memory warning",
+                exceptionClass = "LowMemory",
+                device = DeviceContextCollector.Instance.Collect(),
+                network = DeviceContextCollector.Instance.CollectNetworkContext(),
+                gameState = GameStateCollector.Instance.Collect(),
+                appVersion = Application.version,
+                buildNumber = GetBuildNumber(),
+                unityVersion = Application.unityVersion,
+                userId = _userId,
+                sessionId = _sessionId,
+                breadcrumbs = BreadcrumbTracker.Instance.GetBreadcrumbs(),
+                timestamp = DateTimeOffset.UtcNow.ToUnixTimeMilliseconds()
+            };
+
+            // Symbolizing the call sites takes a few ms; do it off the main thread
+            _worker.Post(() =>
+            {
+                var liveMb = NativeAllocationProfiler.SampledLiveBytes / (1024f * 1024f);
+                var snapshot = NativeAllocationProfiler.Snapshot();
+
+                _scheduler.Post(() =>
+                {
+                    payload.rawStackTrace = snapshot;
+                    payload.tags = MergeTags(new Dictionary<string, string>
+                    {
+                        { "sampledNativeLiveMb", liveMb.ToString("F1", CultureInfo.InvariantCulture) }
+                    });
+                    OnErrorCaptured(payload);
+                });
+            });
+        }
+
         private void OnNetworkErrorCaptured(NetworkRequest networkRequest, string errorMessage, int statusCode)
         {
             var payload = new ErrorPayloadInner
@@ -602,27 +806,24 @@ namespace MoonForge.ErrorTracking
 
         private Dictionary<string, string> MergeTags(Dictionary<string, string> additionalTags)
         {
-            var tags = new Dictionary<string, string>();
-
-            // Add user tags
-            if (_userTags != null)
+            // Nothing to add: share the snapshot's user tags rather than copying them
+            var userTags = ContextStore.Current.tags;
+            if (additionalTags == null || additionalTags.Count == 0)
             {
-                foreach (var kvp in _userTags)
-                {
-                    tags[kvp.Key] = kvp.Value;
-                }
+                return userTags;
             }
 
+            var tags = userTags != null
+                ? new Dictionary<string, string>(userTags)
+                : new Dictionary<string, string>();
+
             // Add additional tags
-            if (additionalTags != null)
+            foreach (var kvp in additionalTags)
             {
-                foreach (var kvp in additionalTags)
-                {
-                    tags[kvp.Key] = kvp.Value;
-                }
+                tags[kvp.Key] = kvp.Value;
             }
 
-            return tags.Count > 0 ? tags : null;
+            return tags;
         }
 
         private string GetBuildNumber()
@@ -56,6 +56,13 @@ namespace MoonForge.ErrorTracking
         [Range(60, 7200)]
         public int sessionTimeoutSeconds = 1800;
 
+        [Tooltip("Report how each session ended (exit, crash, kill) on the next launch (Android/Linux)")]
+        public bool trackSessionHealth = true;
+
+        [Tooltip("Seconds between session heartbeats")]
+        [Range(1, 60)]
+        public int sessionHeartbeatSeconds = 5;
+
         [Header("═══ ADVANCED (Optional) ═══")]
         [Tooltip("API endpoint base URL - the URL of your MoonForge collector service (without /api/errors)")]
         public string apiEndpoint = "https://collector.moonforge.co";
@@ -66,9 +73,19 @@ namespace MoonForge.ErrorTracking
         [Tooltip("Capture Debug.LogError and Debug.LogException calls")]
         public bool captureLogErrors = true;
 
-        [Tooltip("Capture native iOS/Android crashes")]
+        [Tooltip("Capture native iOS/Android/Linux crashes")]
         public bool captureNativeCrashes = true;
 
+        [Tooltip("KB of recent native log output attached to native crash reports (Android/Linux, 0 = off)")]
+        [Range(0, 1024)]
+        public int logTailSizeKb = 16;
+
+        [Tooltip("Include stdout/stderr in the log tail (Android/Linux)")]
+        public bool captureStdoutStderr = false;
+
+        [Tooltip("Attach the log tail to managed errors as well")]
+        public bool attachLogTailToErrors = false;
+
         [Tooltip("Track scene changes as breadcrumbs")]
         public bool trackSceneChanges = true;
 
@@ -87,6 +104,17 @@ namespace MoonForge.ErrorTracking
         [Range(1, 60)]
         public float batchWaitSeconds = 5f;
 
+        [Tooltip("Deduplicate stack frames and strings across each batch (collector must support it)")]
+        public bool compactBatchFrames = false;
+
+        [Tooltip("Max encoded size of one error in KB; larger errors are trimmed (0 = no limit)")]
+        [Range(0, 1024)]
+        public int maxErrorPayloadKB = 64;
+
+        [Tooltip("Max batch request size in KB; larger batches are split (0 = no limit)")]
+        [Range(0, 4096)]
+        public int maxBatchPayloadKB = 512;
+
         [Tooltip("Store errors offline when no connection")]
         public bool enableOfflineStorage = true;
 
@@ -97,6 +125,55 @@ namespace MoonForge.ErrorTracking
         [Range(5, 60)]
         public int requestTimeoutSeconds = 30;
 
+        [Tooltip("Main-thread time (ms) the SDK may use per frame; the rest is deferred to later frames")]
+        [Range(0.05f, 2f)]
+        public float mainThreadBudgetMs = 0.2f;
+
+        [Tooltip("Where SDK background threads run on big.LITTLE devices (Android, Linux)")]
+        public ThreadAffinityPolicy workerThreadPolicy = ThreadAffinityPolicy.EfficiencyCores;
+
+        [Tooltip("Sample native allocations (Android) and report the top call sites on low memory")]
+        public bool enableAllocationProfiler = false;
+
+        [Tooltip("Mean KB allocated between allocation samples")]
+        [Range(64, 8192)]
+        public int allocationSampleIntervalKb = 512;
+
+        [Tooltip("Sample per-thread CPU time (Android/Linux) for crash reports")]
+        public bool enableCpuSampling = true;
+
+        [Tooltip("Seconds between CPU samples")]
+        [Range(1f, 60f)]
+        public float cpuSampleIntervalSeconds = 5f;
+
+        [Tooltip("Sample thermal, CPU frequency and battery state (Android/Linux)")]
+        public bool enableDeviceSampling = true;
+
+        [Tooltip("Seconds between device samples")]
+        [Range(1f, 60f)]
+        public float deviceSampleIntervalSeconds = 2f;
+
+        [Tooltip("Record main-thread frames at least this long as hitches (Android/Linux, 0 = off)")]
+        [Range(0, 2000)]
+        public int hitchThresholdMs = 100;
+
+        [Tooltip("Add hardware perf counters to hitches where permitted")]
+        public bool captureHitchCounters = false;
+
+        [Tooltip("Add storage I/O and major faults to hitches and scene loads")]
+        public bool trackHitchIo = true;
+
+        [Tooltip("Report deadlocks and long main-thread lock waits in native code (Android/Linux)")]
+        public bool enableLockMonitor = false;
+
+        [Tooltip("Track the owner of 1 in N mutexes (1 = all, for QA builds)")]
+        [Range(1, 256)]
+        public int lockMonitorSampleRate = 16;
+
+        [Tooltip("Main-thread lock wait that counts as a hang, in milliseconds")]
+        [Range(500, 30000)]
+        public int lockHangThresholdMs = 2000;
+
         [Tooltip("Auto-upload debug symbols on build")]
         public bool autoUploadSymbols = true;
 
@@ -219,6 +296,9 @@ namespace MoonForge.ErrorTracking
             config.captureUnhandledExceptions = captureUnhandledExceptions;
             config.captureLogErrors = captureLogErrors;
             config.captureNativeCrashes = captureNativeCrashes;
+            config.logTailSizeKb = logTailSizeKb;
+            config.captureStdoutStderr = captureStdoutStderr;
+            config.attachLogTailToErrors = attachLogTailToErrors;
 
             // Breadcrumbs
             config.maxBreadcrumbs = maxBreadcrumbs;
@@ -228,6 +308,9 @@ namespace MoonForge.ErrorTracking
             config.enableBatching = enableBatching;
             config.maxBatchSize = batchSize;
             config.maxBatchWaitTime = batchWaitSeconds;
+            config.compactBatchFrames = compactBatchFrames;
+            config.maxErrorPayloadKB = maxErrorPayloadKB;
+            config.maxBatchPayloadKB = maxBatchPayloadKB;
 
             // Offline
             config.enableOfflineStorage = enableOfflineStorage;
@@ -238,6 +321,22 @@ namespace MoonForge.ErrorTracking
             // Network
             config.requestTimeout = requestTimeoutSeconds;
 
+            // Performance
+            config.mainThreadBudgetMs = mainThreadBudgetMs;
+            config.workerThreadPolicy = workerThreadPolicy;
+            config.enableAllocationProfiler = enableAllocationProfiler;
+            config.allocationSampleIntervalKb = allocationSampleIntervalKb;
+            config.enableCpuSampling = enableCpuSampling;
+            config.cpuSampleIntervalSeconds = cpuSampleIntervalSeconds;
+            config.enableDeviceSampling = enableDeviceSampling;
+            config.deviceSampleIntervalSeconds = deviceSampleIntervalSeconds;
+            config.hitchThresholdMs = hitchThresholdMs;
+            config.captureHitchCounters = captureHitchCounters;
+            config.trackHitchIo = trackHitchIo;
+            config.enableLockMonitor = enableLockMonitor;
+            config.lockMonitorSampleRate = lockMonitorSampleRate;
+            config.lockHangThresholdMs = lockHangThresholdMs;
+
             // Symbols
             config.autoUploadSymbols = autoUploadSymbols;
 
@@ -249,6 +348,8 @@ namespace MoonForge.ErrorTracking
             config.enableAnalytics = enableAnalytics;
             config.trackSceneViewsAutomatically = trackSceneViewsAutomatically;
             config.sessionTimeoutSeconds = sessionTimeoutSeconds;
+            config.trackSessionHealth = trackSessionHealth;
+            config.sessionHeartbeatSeconds = sessionHeartbeatSeconds;
 
             return config;
         }
@@ -0,0 +1,209 @@
+using System;
+using System.Collections;
+using System.Collections.Generic;
+using System.Diagnostics;
+using Debug = UnityEngine.Debug;
+
+namespace MoonForge.ErrorTracking
+{
+    /// <summary>
+    /// Runs main-thread SDK work within a fixed per-frame time budget.
+    /// Work can be posted from any thread; anything that doesn't fit in the
+    /// current frame's budget carries over to the next frame.
+    /// </summary>
+    public class FrameBudgetScheduler
+    {
+        private readonly ErrorTrackerConfig _config;
+        private readonly LinkedList<WorkItem> _queue = new LinkedList<WorkItem>();
+        private readonly HashSet<string> _pendingKeys = new HashSet<string>();
+        private readonly object _lock = new object();
+        private readonly Stopwatch _frameTimer = new Stopwatch();
+
+        private long _framesOverBudget;
+        private double _maxFrameMs;
+
+        public FrameBudgetScheduler(ErrorTrackerConfig config)
+        {
+            _config = config;
+        }
+
+        /// <summary>
+        /// Number of work items waiting to run
+        /// </summary>
+        public int Pending
+        {
+            get
+            {
+                lock (_lock)
+                {
+                    return _queue.Count;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Frames in which a single slice ran past the budget
+        /// </summary>
+        public long FramesOverBudget => _framesOverBudget;
+
+        /// <summary>
+        /// Longest time spent in <see cref="Tick"/> in a single frame (ms)
+        /// </summary>
+        public double MaxFrameMs => _maxFrameMs;
+
+        /// <summary>
+        /// Queue a unit of main-thread work. Safe to call from any thread.
+        /// </summary>
+        public void Post(Action work)
+        {
+            if (work == null) return;
+            Enqueue(new WorkItem { Action = work });
+        }
+
+        /// <summary>
+        /// Queue work unless work with the same key is already pending.
+        /// Use for idempotent jobs (saves, cleanups) that may be requested many times per frame.
+        /// </summary>
+        public void PostOnce(string key, Action work)
+        {
+            if (work == null) return;
+
+            lock (_lock)
+            {
+                if (!_pendingKeys.Add(key)) return;
+                _queue.AddLast(new WorkItem { Action = work, Key = key });
+            }
+        }
+
+        /// <summary>
+        /// Queue long-running work as an iterator. Each MoveNext is one slice;
+        /// the scheduler resumes it on later frames until it completes.
+        /// </summary>
+        public void PostSliced(IEnumerator work)
+        {
+            if (work == null) return;
+            Enqueue(new WorkItem { Slices = work });
+        }
+
+        /// <summary>
+        /// Run queued work until the frame budget is spent. Call once per frame from the main thread.
+        /// At least one slice runs per frame so queued work always makes progress.
+        /// </summary>
+        public void Tick()
+        {
+            var budgetTicks = (long)(_config.mainThreadBudgetMs * Stopwatch.Frequency / 1000.0);
+            var ran = false;
+
+            _frameTimer.Restart();
+
+            while (!ran || _frameTimer.ElapsedTicks < budgetTicks)
+            {
+                WorkItem item;
+                lock (_lock)
+                {
+                    if (_queue.Count == 0) break;
+
+                    item = _queue.First.Value;
+                    _queue.RemoveFirst();
+                    if (item.Key != null)
+                    {
+                        _pendingKeys.Remove(item.Key);
+                    }
+                }
+
+                ran = true;
+
+                if (RunSlice(item))
+                {
+                    // Unfinished iterator keeps its place at the head of the queue
+                    lock (_lock)
+                    {
+                        _queue.AddFirst(item);
+                    }
+                }
+            }
+
+            _frameTimer.Stop();
+
+            if (!ran) return;
+
+            var elapsedMs = _frameTimer.Elapsed.TotalMilliseconds;
+            if (elapsedMs > _maxFrameMs)
+            {
+                _maxFrameMs = elapsedMs;
+            }
+
+            if (_frameTimer.ElapsedTicks > budgetTicks)
+            {
+                _framesOverBudget++;
+                if (_config.debugMode && elapsedMs > _config.mainThreadBudgetMs * 4)
+                {
+                    Debug.LogWarning($"[MoonForge] Main-thread work took {elapsedMs:F2}ms (budget {_config.mainThreadBudgetMs}ms)");
+                }
+            }
+        }
+
+        /// <summary>
+        /// Run everything that is queued, ignoring the budget. Used on shutdown.
+        /// </summary>
+        public void RunAll()
+        {
+            while (true)
+            {
+                WorkItem item;
+                lock (_lock)
+                {
+                    if (_queue.Count == 0) return;
+                    item = _queue.First.Value;
+                    _queue.RemoveFirst();
+                    if (item.Key != null)
+                    {
+                        _pendingKeys.Remove(item.Key);
+                    }
+                }
+
+                while (RunSlice(item)) { }
+            }
+        }
+
+        private void Enqueue(WorkItem item)
+        {
+            lock (_lock)
+            {
+                _queue.AddLast(item);
+            }
+        }
+
+        /// <summary>
+        /// Run one slice. Returns true if the item has more slices to run.
+        /// </summary>
+        private bool RunSlice(WorkItem item)
+        {
+            try
+            {
+                if (item.Slices != null)
+                {
+                    return item.Slices.MoveNext();
+                }
+
+                item.Action();
+            }
+            catch (Exception ex)
+            {
+                if (_config.debugMode)
+                {
+                    Debug.LogWarning($"[MoonForge] Scheduled work failed: {ex.Message}");
+                }
+            }
+
+            return false;
+        }
+
+        private class WorkItem
+        {
+            public Action Action;
+            public IEnumerator Slices;
+            public string Key;
+        }
+    }
+}
@@ -0,0 +1,98 @@
+using System;
+using System.Runtime.InteropServices;
+using Debug = UnityEngine.Debug;
+
+namespace MoonForge.ErrorTracking
+{
+    /// <summary>
+    /// Applies <see cref="ThreadAffinityPolicy"/> to SDK background threads.
+    /// On Android and Linux players the calling thread is pinned to the efficiency
+    /// cores and its nice value (and optionally scheduling class) lowered, so SDK
+    /// work doesn't take big-core time from the game's render and job threads.
+    /// Other platforms rely on the managed thread priority alone.
+    /// </summary>
+    public static class SdkThreadPolicy
+    {
+        [Flags]
+        public enum Applied
+        {
+            None = 0,
+            Affinity = 0x1,
+            Nice = 0x2,
+            SchedIdle = 0x4
+        }
+
+        #region Native Plugin Imports
+
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+        private const string NativeLibrary = "moonforge_crash_handler";
+
+        [DllImport(NativeLibrary)]
+        private static extern int MoonForge_ThreadPolicy_ApplyToCurrentThread(int policy);
+
+        [DllImport(NativeLibrary)]
+        private static extern ulong MoonForge_ThreadPolicy_GetEfficiencyCoreMask();
+
+        [DllImport(NativeLibrary)]
+        private static extern int MoonForge_ThreadPolicy_GetCpuCount();
+#endif
+
+        #endregion
+
+        /// <summary>
+        /// Apply the policy to the calling thread. Must run on the thread being placed.
+        /// </summary>
+        public static Applied ApplyToCurrentThread(ThreadAffinityPolicy policy, bool debugMode = false)
+        {
+            if (policy == ThreadAffinityPolicy.None) return Applied.None;
+
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+            try
+            {
+                var applied = (Applied)MoonForge_ThreadPolicy_ApplyToCurrentThread((int)policy);
+
+                if (debugMode)
+                {
+                    Debug.Log($"[MoonForge] Thread policy {policy}: applied {applied} (efficiency cores 0x{MoonForge_ThreadPolicy_GetEfficiencyCoreMask():x} of {MoonForge_ThreadPolicy_GetCpuCount()})");
+                }
+
+                return applied;
+            }
+            catch (Exception ex)
+            {
+                // Older native plugin without the thread policy exports
+                if (debugMode)
+                {
+                    Debug.LogWarning($"[MoonForge] Thread policy unavailable: {ex.Message}");
+                }
+                return Applied.None;
+            }
+#else
+            return Applied.None;
+#endif
+        }
+
+        /// <summary>
+        /// Bit mask of detected efficiency cores, or 0 if the device has a single core type
+        /// or the platform doesn't support placement
+        /// </summary>
+        public static ulong EfficiencyCoreMask
+        {
+            get
+            {
+#if (UNITY_ANDROID || UNITY_STANDALONE_LINUX) && !UNITY_EDITOR
+                try
+                {
+                    return MoonForge_ThreadPolicy_GetEfficiencyCoreMask();
+                }
+                catch (Exception)
+                {
+                    return 0;
+                }
+#else
+                return 0;
+#endif
+            }
+        }
+    }
+}
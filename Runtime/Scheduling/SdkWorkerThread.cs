@@ -0,0 +1,220 @@
+using System;
+using System.Collections.Generic;
+using System.Threading;
+using Debug = UnityEngine.Debug;
+
+namespace MoonForge.ErrorTracking
+{
+    /// <summary>
+    /// Dedicated background thread for SDK work that doesn't need Unity APIs:
+    /// offline storage I/O, JSON serialization and parsing, and all periodic SDK tasks.
+    /// Jobs run one at a time in the order they were posted. Timers live on a
+    /// <see cref="TimerWheel"/> and the thread sleeps until the next one is due,
+    /// so an idle SDK costs no wakeups and no per-frame polling. Timers that are
+    /// due run before the next queued job.
+    /// </summary>
+    public class SdkWorkerThread
+    {
+        private readonly ErrorTrackerConfig _config;
+        private readonly Queue<Action> _queue = new Queue<Action>();
+        private readonly object _lock = new object();
+        private readonly Thread _thread;
+        private readonly TimerWheel _timers;
+        private readonly List<SdkTimer> _expired = new List<SdkTimer>();
+
+        private bool _stopping;
+
+        public SdkWorkerThread(ErrorTrackerConfig config)
+        {
+            _config = config;
+            _timers = new TimerWheel(TimerWheel.NowTick());
+            _thread = new Thread(Run)
+            {
+                IsBackground = true,
+                Name = "MoonForge.Worker",
+                Priority = ThreadPriority.BelowNormal
+            };
+            _thread.Start();
+        }
+
+        /// <summary>
+        /// True when called from the worker thread itself
+        /// </summary>
+        public bool IsCurrentThread => Thread.CurrentThread == _thread;
+
+        /// <summary>
+        /// Queue a job. Safe to call from any thread. Jobs posted after
+        /// <see cref="Shutdown"/> run inline on the caller.
+        /// </summary>
+        public void Post(Action job)
+        {
+            if (job == null) return;
+
+            lock (_lock)
+            {
+                if (!_stopping)
+                {
+                    _queue.Enqueue(job);
+                    Monitor.Pulse(_lock);
+                    return;
+                }
+            }
+
+            RunJob(job);
+        }
+
+        /// <summary>
+        /// Run a callback on the worker thread once, after <paramref name="delay"/>
+        /// </summary>
+        public SdkTimer Schedule(TimeSpan delay, Action callback)
+        {
+            return AddTimer(delay, TimeSpan.Zero, callback);
+        }
+
+        /// <summary>
+        /// Run a callback on the worker thread every <paramref name="interval"/>,
+        /// first after <paramref name="initialDelay"/>
+        /// </summary>
+        public SdkTimer ScheduleRepeating(TimeSpan initialDelay, TimeSpan interval, Action callback)
+        {
+            return AddTimer(initialDelay, interval, callback);
+        }
+
+        internal void Cancel(SdkTimer timer)
+        {
+            lock (_lock)
+            {
+                timer.Cancelled = true;
+                timer.IntervalTicks = 0;
+                _timers.Remove(timer);
+            }
+        }
+
+        /// <summary>
+        /// Stop accepting work and wait for queued jobs to finish. Pending timers are dropped.
+        /// </summary>
+        /// <returns>False if queued jobs did not finish within the timeout</returns>
+        public bool Shutdown(int timeoutMs)
+        {
+            lock (_lock)
+            {
+                _stopping = true;
+                Monitor.Pulse(_lock);
+            }
+
+            return _thread.Join(timeoutMs);
+        }
+
+        private SdkTimer AddTimer(TimeSpan delay, TimeSpan interval, Action callback)
+        {
+            var timer = new SdkTimer
+            {
+                Callback = callback,
+                Owner = this,
+                IntervalTicks = interval > TimeSpan.Zero ? TimerWheel.ToTicks(interval) : 0
+            };
+
+            lock (_lock)
+            {
+                if (_stopping) return timer;
+
+                timer.DueTick = TimerWheel.NowTick() + TimerWheel.ToTicks(delay);
+                _timers.Add(timer);
+
+                // Wake the thread so it can shorten its sleep if this is now the earliest deadline
+                Monitor.Pulse(_lock);
+            }
+
+            return timer;
+        }
+
+        private void Run()
+        {
+            // Placement is per OS thread, so it has to be applied from the thread itself
+            SdkThreadPolicy.ApplyToCurrentThread(_config.workerThreadPolicy, _config.debugMode);
+
+            var due = new List<SdkTimer>();
+
+            while (true)
+            {
+                Action job = null;
+                due.Clear();
+
+                lock (_lock)
+                {
+                    while (true)
+                    {
+                        // Timers are collected before every job, not only when the queue is
+                        // empty, so a steady stream of posted jobs can't hold them back
+                        var now = TimerWheel.NowTick();
+                        if (!_stopping)
+                        {
+                            _timers.Advance(now, _expired);
+                            foreach (var timer in _expired)
+                            {
+                                due.Add(timer);
+
+                                if (timer.IntervalTicks > 0)
+                                {
+                                    // Keep the original cadence unless we fell behind by a whole interval
+                                    timer.DueTick = Math.Max(timer.DueTick + timer.IntervalTicks, now + 1);
+                                    _timers.Add(timer);
+                                }
+                            }
+                            _expired.Clear();
+                        }
+
+                        if (_queue.Count > 0)
+                        {
+                            job = _queue.Dequeue();
+                            break;
+                        }
+
+                        if (due.Count > 0) break;
+                        if (_stopping) return;
+
+                        var next = _timers.NextDeadlineTick();
+                        if (next == long.MaxValue)
+                        {
+                            Monitor.Wait(_lock);
+                        }
+                        else
+                        {
+                            var waitMs = (next - now) * (1000 / TimerWheel.TicksPerSecond);
+                            Monitor.Wait(_lock, (int)Math.Min(Math.Max(waitMs, 1), int.MaxValue));
+                        }
+                    }
+                }
+
+                foreach (var timer in due)
+                {
+                    // May have been cancelled after it expired but before it ran
+                    if (!timer.Cancelled)
+                    {
+                        RunJob(timer.Callback);
+                    }
+                }
+
+                if (job != null)
+                {
+                    RunJob(job);
+                }
+            }
+        }
+
+        private void RunJob(Action job)
+        {
+            try
+            {
+                job();
+            }
+            catch (Exception ex)
+            {
+                if (_config.debugMode)
+                {
+                    Debug.LogWarning($"[MoonForge] Background job failed: {ex.Message}");
+                }
+            }
+        }
+    }
+}
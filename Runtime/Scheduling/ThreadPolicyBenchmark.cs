@@ -0,0 +1,232 @@
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Text;
+using System.Threading;
+using Debug = UnityEngine.Debug;
+
+namespace MoonForge.ErrorTracking
+{
+    /// <summary>
+    /// Measures how much SDK-style background work slows a foreground busy loop
+    /// under each <see cref="ThreadAffinityPolicy"/>. Only meaningful on a device:
+    /// call <see cref="Start"/> from a development build and read the report from logcat.
+    /// The foreground loop runs on a thread of its own for (policies + 1) x duration,
+    /// so the caller, usually the main thread, is never blocked.
+    /// </summary>
+    public static class ThreadPolicyBenchmark
+    {
+        // Work per foreground unit; roughly tens of microseconds on a mobile big core
+        private const int UnitIterations = 20000;
+
+        /// <summary>
+        /// Start the benchmark on a dedicated thread, which plays the game thread
+        /// </summary>
+        /// <param name="durationMs">Measurement time per phase</param>
+        /// <param name="backgroundThreads">Background load threads; 0 uses one per CPU so every core is contended without a policy</param>
+        /// <param name="completed">Receives the report on the benchmark thread (may be null)</param>
+        /// <returns>The benchmark thread, already started</returns>
+        public static Thread Start(int durationMs = 3000, int backgroundThreads = 0, Action<ThreadPolicyBenchmarkReport> completed = null)
+        {
+            // Normal priority and no policy, like the game thread it stands in for
+            var thread = new Thread(() =>
+            {
+                var report = Run(durationMs, backgroundThreads);
+                completed?.Invoke(report);
+            })
+            {
+                IsBackground = true,
+                Name = "MoonForge.Benchmark.Foreground"
+            };
+            thread.Start();
+            return thread;
+        }
+
+        private static ThreadPolicyBenchmarkReport Run(int durationMs, int backgroundThreads)
+        {
+            if (backgroundThreads <= 0)
+            {
+                backgroundThreads = Environment.ProcessorCount;
+            }
+
+            var report = new ThreadPolicyBenchmarkReport
+            {
+                cpuCount = Environment.ProcessorCount,
+                efficiencyCoreMask = SdkThreadPolicy.EfficiencyCoreMask.ToString("x"),
+                backgroundThreads = backgroundThreads,
+                phases = new List<ThreadPolicyBenchmarkPhase>()
+            };
+
+            var baseline = RunPhase("no background load", null, durationMs, 0);
+            report.phases.Add(baseline);
+
+            foreach (ThreadAffinityPolicy policy in Enum.GetValues(typeof(ThreadAffinityPolicy)))
+            {
+                var phase = RunPhase(policy.ToString(), policy, durationMs, backgroundThreads);
+                phase.foregroundSlowdownPercent = baseline.foregroundUnitsPerSecond > 0
+                    ? (float)(100.0 * (1.0 - phase.foregroundUnitsPerSecond / baseline.foregroundUnitsPerSecond))
+                    : 0f;
+                report.phases.Add(phase);
+            }
+
+            Debug.Log($"[MoonForge] Thread policy benchmark:\n{report}");
+            return report;
+        }
+
+        private static ThreadPolicyBenchmarkPhase RunPhase(string name, ThreadAffinityPolicy? policy, int durationMs, int threadCount)
+        {
+            var stop = 0;
+            var backgroundUnits = 0L;
+            var applied = SdkThreadPolicy.Applied.None;
+            var threads = new List<Thread>();
+            var started = new CountdownEvent(threadCount);
+
+            for (var i = 0; i < threadCount; i++)
+            {
+                var thread = new Thread(() =>
+                {
+                    var result = SdkThreadPolicy.ApplyToCurrentThread(policy.Value);
+                    lock (threads)
+                    {
+                        applied |= result;
+                    }
+                    started.Signal();
+
+                    var units = 0L;
+                    var builder = new StringBuilder(1024);
+                    while (Volatile.Read(ref stop) == 0)
+                    {
+                        SimulateSdkWork(builder, units);
+                        units++;
+                    }
+                    Interlocked.Add(ref backgroundUnits, units);
+                })
+                {
+                    IsBackground = true,
+                    Name = $"MoonForge.Benchmark.{i}",
+                    Priority = ThreadPriority.BelowNormal
+                };
+                threads.Add(thread);
+                thread.Start();
+            }
+
+            started.Wait();
+
+            var unitTimesUs = new List<double>();
+            var clock = Stopwatch.StartNew();
+            var unitClock = new Stopwatch();
+            var sink = 0UL;
+
+            while (clock.ElapsedMilliseconds < durationMs)
+            {
+                unitClock.Restart();
+                sink += ForegroundUnit(sink);
+                unitTimesUs.Add(unitClock.Elapsed.TotalMilliseconds * 1000.0);
+            }
+
+            var elapsedSeconds = clock.Elapsed.TotalSeconds;
+            Volatile.Write(ref stop, 1);
+            foreach (var thread in threads)
+            {
+                thread.Join();
+            }
+
+            unitTimesUs.Sort();
+
+            return new ThreadPolicyBenchmarkPhase
+            {
+                name = name,
+                appliedPolicy = applied.ToString(),
+                foregroundUnitsPerSecond = (float)(unitTimesUs.Count / elapsedSeconds),
+                foregroundP50Us = Percentile(unitTimesUs, 0.50),
+                foregroundP99Us = Percentile(unitTimesUs, 0.99),
+                foregroundMaxUs = unitTimesUs.Count > 0 ? (float)unitTimesUs[unitTimesUs.Count - 1] : 0f,
+                backgroundUnitsPerSecond = (float)(backgroundUnits / elapsedSeconds),
+                checksum = sink
+            };
+        }
+
+        /// <summary>
+        /// Integer mixing loop standing in for a slice of game-thread work
+        /// </summary>
+        private static ulong ForegroundUnit(ulong seed)
+        {
+            var x = seed | 1;
+            for (var i = 0; i < UnitIterations; i++)
+            {
+                x ^= x << 13;
+                x ^= x >> 7;
+                x ^= x << 17;
+            }
+            return x;
+        }
+
+        /// <summary>
+        /// String building and hashing, the shape of payload serialization
+        /// </summary>
+        private static void SimulateSdkWork(StringBuilder builder, long unit)
+        {
+            builder.Clear();
+            builder.Append("{\"message\":\"benchmark ").Append(unit).Append("\",\"frames\":[");
+            for (var i = 0; i < 16; i++)
+            {
+                builder.Append("{\"method\":\"Game.Update\",\"line\":").Append(i).Append("},");
+            }
+            builder.Append("]}");
+
+            var hash = 17;
+            for (var i = 0; i < builder.Length; i++)
+            {
+                hash = hash * 31 + builder[i];
+            }
+
+            if (hash == int.MinValue)
+            {
+                builder.Clear();
+            }
+        }
+
+        private static float Percentile(List<double> sorted, double p)
+        {
+            if (sorted.Count == 0) return 0f;
+            var index = (int)Math.Min(sorted.Count - 1, Math.Ceiling(p * sorted.Count) - 1);
+            return (float)sorted[Math.Max(0, index)];
+        }
+    }
+
+    [Serializable]
+    public class ThreadPolicyBenchmarkReport
+    {
+        public int cpuCount;
+        public string efficiencyCoreMask;
+        public int backgroundThreads;
+        public List<ThreadPolicyBenchmarkPhase> phases;
+
+        public override string ToString()
+        {
+            var builder = new StringBuilder();
+            builder.AppendLine($"CPUs: {cpuCount}, efficiency cores: 0x{efficiencyCoreMask}, background threads: {backgroundThreads}");
+            foreach (var phase in phases)
+            {
+                builder.AppendLine($"  {phase.name,-20} fg {phase.foregroundUnitsPerSecond,8:F0}/s ({phase.foregroundSlowdownPercent,5:F1}% slower) " +
+                                   $"p50 {phase.foregroundP50Us:F0}us p99 {phase.foregroundP99Us:F0}us max {phase.foregroundMaxUs:F0}us | " +
+                                   $"bg {phase.backgroundUnitsPerSecond:F0}/s [{phase.appliedPolicy}]");
+            }
+            return builder.ToString();
+        }
+    }
+
+    [Serializable]
+    public class ThreadPolicyBenchmarkPhase
+    {
+        public string name;
+        public string appliedPolicy;
+        public float foregroundUnitsPerSecond;
+        public float foregroundSlowdownPercent;
+        public float foregroundP50Us;
+        public float foregroundP99Us;
+        public float foregroundMaxUs;
+        public float backgroundUnitsPerSecond;
+        public ulong checksum;
+    }
+}
@@ -0,0 +1,255 @@
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+
+namespace MoonForge.ErrorTracking
+{
+    /// <summary>
+    /// Handle to a timer scheduled on the <see cref="SdkWorkerThread"/>
+    /// </summary>
+    public sealed class SdkTimer
+    {
+        internal Action Callback;
+        internal long DueTick;
+        internal long IntervalTicks;
+        internal SdkTimer Prev;
+        internal SdkTimer Next;
+        internal int Slot = -1;
+        internal SdkWorkerThread Owner;
+        internal volatile bool Cancelled;
+
+        internal SdkTimer() { }
+
+        /// <summary>
+        /// Stop the timer. Safe to call from any thread, including from the timer's own callback.
+        /// </summary>
+        public void Cancel()
+        {
+            Owner?.Cancel(this);
+        }
+    }
+
+    /// <summary>
+    /// Hierarchical timer wheel (4 levels x 64 slots, 10 ms resolution, ~46 h range).
+    /// Insert and cancel are O(1); the earliest deadline is found from per-level occupancy bits
+    /// so the owning thread can sleep until exactly the next timer is due.
+    /// Not thread-safe: the owner serializes access.
+    /// </summary>
+    internal sealed class TimerWheel
+    {
+        public const long TicksPerSecond = 100;
+
+        private const int SlotBits = 6;
+        private const int SlotsPerLevel = 1 << SlotBits;
+        private const int SlotMask = SlotsPerLevel - 1;
+        private const int Levels = 4;
+        private const long MaxDelta = (1L << (SlotBits * Levels)) - 1;
+
+        private readonly SdkTimer[] _slots = new SdkTimer[Levels * SlotsPerLevel];
+        private readonly ulong[] _occupied = new ulong[Levels];
+        private long _currentTick;
+        private int _count;
+
+        public TimerWheel(long nowTick)
+        {
+            _currentTick = nowTick;
+        }
+
+        /// <summary>
+        /// Number of scheduled timers
+        /// </summary>
+        public int Count => _count;
+
+        /// <summary>
+        /// Monotonic wheel time (10 ms ticks)
+        /// </summary>
+        public static long NowTick()
+        {
+            return (long)(Stopwatch.GetTimestamp() / (Stopwatch.Frequency / (double)TicksPerSecond));
+        }
+
+        public static long ToTicks(TimeSpan span)
+        {
+            return Math.Max(1, (long)Math.Ceiling(span.TotalSeconds * TicksPerSecond));
+        }
+
+        public void Add(SdkTimer timer)
+        {
+            // The current tick's slot has already been processed
+            if (timer.DueTick <= _currentTick)
+            {
+                timer.DueTick = _currentTick + 1;
+            }
+
+            Insert(timer);
+        }
+
+        private void Insert(SdkTimer timer)
+        {
+            var delta = Math.Min(timer.DueTick - _currentTick, MaxDelta);
+            var level = 0;
+            while (delta >= 1L << (SlotBits * (level + 1)))
+            {
+                level++;
+            }
+
+            var dueForSlot = _currentTick + delta;
+            var slot = level * SlotsPerLevel + (int)((dueForSlot >> (SlotBits * level)) & SlotMask);
+
+            timer.Slot = slot;
+            timer.Prev = null;
+            timer.Next = _slots[slot];
+            if (timer.Next != null)
+            {
+                timer.Next.Prev = timer;
+            }
+            _slots[slot] = timer;
+            _occupied[level] |= 1UL << (slot & SlotMask);
+            _count++;
+        }
+
+        public void Remove(SdkTimer timer)
+        {
+            if (timer.Slot < 0) return;
+
+            var slot = timer.Slot;
+            if (timer.Prev != null)
+            {
+                timer.Prev.Next = timer.Next;
+            }
+            else
+            {
+                _slots[slot] = timer.Next;
+            }
+
+            if (timer.Next != null)
+            {
+                timer.Next.Prev = timer.Prev;
+            }
+
+            if (_slots[slot] == null)
+            {
+                _occupied[slot / SlotsPerLevel] &= ~(1UL << (slot & SlotMask));
+            }
+
+            timer.Slot = -1;
+            timer.Prev = null;
+            timer.Next = null;
+            _count--;
+        }
+
+        /// <summary>
+        /// Move the wheel forward to <paramref name="nowTick"/>, appending expired timers to <paramref name="expired"/>.
+        /// Jumps from one occupied slot to the next, so a long sleep costs one step per cascade or expiry, not per tick.
+        /// </summary>
+        public void Advance(long nowTick, List<SdkTimer> expired)
+        {
+            while (_currentTick < nowTick)
+            {
+                // No slot is expired or cascaded before this, so the ticks in between have nothing to do
+                var nextTick = NextDeadlineTick();
+                if (nextTick > nowTick)
+                {
+                    _currentTick = nowTick;
+                    return;
+                }
+
+                _currentTick = nextTick;
+
+                // Pull timers down from higher levels when the lower level wraps
+                for (var level = Levels - 1; level >= 1; level--)
+                {
+                    if ((_currentTick & ((1L << (SlotBits * level)) - 1)) == 0)
+                    {
+                        Cascade(level, (int)((_currentTick >> (SlotBits * level)) & SlotMask));
+                    }
+                }
+
+                var slot = (int)(_currentTick & SlotMask);
+                var timer = _slots[slot];
+                while (timer != null)
+                {
+                    var next = timer.Next;
+                    Remove(timer);
+
+                    // Timers beyond the wheel's range were clamped and go round again
+                    if (timer.DueTick > _currentTick)
+                    {
+                        Insert(timer);
+                    }
+                    else
+                    {
+                        expired.Add(timer);
+                    }
+
+                    timer = next;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Earliest tick at which <see cref="Advance"/> has work to do, or long.MaxValue if no timers are scheduled.
+        /// For timers on higher levels this is the tick at which they cascade, which is never later than they are due.
+        /// </summary>
+        public long NextDeadlineTick()
+        {
+            if (_count == 0) return long.MaxValue;
+
+            var next = long.MaxValue;
+            for (var level = 0; level < Levels; level++)
+            {
+                if (_occupied[level] == 0) continue;
+
+                var shift = SlotBits * level;
+                var position = (int)((_currentTick >> shift) & SlotMask);
+
+                // Distance (1..64) from the current slot to the next occupied slot on this level
+                var rotated = RotateRight(_occupied[level], (position + 1) & SlotMask);
+                var distance = TrailingZeroCount(rotated) + 1;
+
+                var tick = ((_currentTick >> shift) + distance) << shift;
+                if (tick < next)
+                {
+                    next = tick;
+                }
+            }
+
+            return next;
+        }
+
+        private void Cascade(int level, int index)
+        {
+            var slot = level * SlotsPerLevel + index;
+            var timer = _slots[slot];
+            if (timer == null) return;
+
+            _slots[slot] = null;
+            _occupied[level] &= ~(1UL << index);
+
+            while (timer != null)
+            {
+                var next = timer.Next;
+                _count--;
+                // Timers due on this tick land in the slot Advance expires next
+                Insert(timer);
+                timer = next;
+            }
+        }
+
+        private static ulong RotateRight(ulong value, int count)
+        {
+            return count == 0 ? value : (value >> count) | (value << (64 - count));
+        }
+
+        private static int TrailingZeroCount(ulong value)
+        {
+            var count = 0;
+            while ((value & 1) == 0)
+            {
+                value >>= 1;
+                count++;
+            }
+            return count;
+        }
+    }
+}
@@ -1,7 +1,10 @@
 using System.Collections.Generic;
+using System.Diagnostics;
 using System.Security.Cryptography;
 using System.Text;
 using UnityEngine;
+using Debug = UnityEngine.Debug;
+using Random = UnityEngine.Random;
 
 namespace MoonForge.ErrorTracking
 {
@@ -42,7 +45,7 @@ namespace MoonForge.ErrorTracking
         };
 
         private const float MinSampleRate = 0.01f;
-        private const float CounterWindowSeconds = 3600f; // 1 hour
+        private const double CounterWindowSeconds = 3600.0; // 1 hour
 
         public AdaptiveSampler(ErrorTrackerConfig config)
         {
@@ -122,6 +125,13 @@ namespace MoonForge.ErrorTracking
                 sb.Append('|');
             }
 
+            // Native crashes at the same frame can be different faults
+            if (!string.IsNullOrEmpty(payload.faultClass))
+            {
+                sb.Append(payload.faultClass);
+                sb.Append('|');
+            }
+
             // Normalize message (remove numbers and memory addresses)
             var normalizedMessage = NormalizeMessage(payload.message);
             sb.Append(normalizedMessage.Substring(0, Mathf.Min(200, normalizedMessage.Length)));
@@ -161,13 +171,13 @@ namespace MoonForge.ErrorTracking
         }
 
         /// <summary>
-        /// Periodic cleanup of old counters
+        /// Periodic cleanup of old counters. Safe to call from any thread.
         /// </summary>
         public void Cleanup()
         {
             lock (_lock)
             {
-                var now = Time.unscaledTime;
+                var now = Now;
                 var keysToRemove = new List<string>();
 
                 foreach (var kvp in _counters)
@@ -238,7 +248,7 @@ namespace MoonForge.ErrorTracking
         {
             lock (_lock)
             {
-                var now = Time.unscaledTime;
+                var now = Now;
 
                 if (_counters.TryGetValue(fingerprint, out var counter))
                 {
@@ -308,11 +318,16 @@ namespace MoonForge.ErrorTracking
             };
         }
 
+        /// <summary>
+        /// Monotonic seconds; unlike Time.unscaledTime it can be read off the main thread
+        /// </summary>
+        private static double Now => Stopwatch.GetTimestamp() / (double)Stopwatch.Frequency;
+
         private class FingerprintCounter
         {
             public int Count;
-            public float FirstSeen;
-            public float LastSeen;
+            public double FirstSeen;
+            public double LastSeen;
         }
     }
 
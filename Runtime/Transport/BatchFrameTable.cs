@@ -0,0 +1,279 @@
+using System;
+using System.Collections.Generic;
+using System.Text;
+
+namespace MoonForge.ErrorTracking
+{
+    /// <summary>
+    /// Per-batch string and frame dictionaries for compact batch encoding.
+    /// Every distinct string (module, function, file, address, package) is stored
+    /// once in "strings" and every distinct frame once in "frameTable", whose
+    /// fields are indices into "strings". Items then carry "frameRefs", indices
+    /// into "frameTable", instead of inline frames.
+    ///
+    /// Decoding: frames[i] = frameTable[frameRefs[i]] with each string field
+    /// replaced by strings[index]; index 0 is always "" and means the field is
+    /// absent. See MoonForgeLocalCollector for the reference decoder.
+    /// Not thread-safe; build one per batch.
+    /// </summary>
+    public class BatchFrameTable
+    {
+        private readonly Dictionary<string, int> _stringIndex = new Dictionary<string, int>(StringComparer.Ordinal);
+        private readonly List<string> _strings = new List<string>();
+        private readonly Dictionary<FrameKey, int> _frameIndex = new Dictionary<FrameKey, int>();
+        private readonly List<FrameKey> _frames = new List<FrameKey>();
+
+        // ,"strings":[""],"frameTable":[]
+        private const int EmptyTablesBytes = 31;
+        private int _encodedBytes = EmptyTablesBytes;
+
+        private readonly struct FrameKey : IEquatable<FrameKey>
+        {
+            public readonly int Module;
+            public readonly int Function;
+            public readonly int Filename;
+            public readonly int Lineno;
+            public readonly int Colno;
+            public readonly int InstructionAddress;
+            public readonly int SymbolAddress;
+            public readonly int Package;
+            public readonly bool InApp;
+
+            public FrameKey(int module, int function, int filename, int lineno, int colno,
+                int instructionAddress, int symbolAddress, int package, bool inApp)
+            {
+                Module = module;
+                Function = function;
+                Filename = filename;
+                Lineno = lineno;
+                Colno = colno;
+                InstructionAddress = instructionAddress;
+                SymbolAddress = symbolAddress;
+                Package = package;
+                InApp = inApp;
+            }
+
+            public bool Equals(FrameKey other)
+            {
+                return Module == other.Module && Function == other.Function && Filename == other.Filename
+                    && Lineno == other.Lineno && Colno == other.Colno
+                    && InstructionAddress == other.InstructionAddress && SymbolAddress == other.SymbolAddress
+                    && Package == other.Package && InApp == other.InApp;
+            }
+
+            public override bool Equals(object obj) => obj is FrameKey other && Equals(other);
+
+            public override int GetHashCode()
+            {
+                unchecked
+                {
+                    var hash = Module;
+                    hash = hash * 31 + Function;
+                    hash = hash * 31 + Filename;
+                    hash = hash * 31 + Lineno;
+                    hash = hash * 31 + Colno;
+                    hash = hash * 31 + InstructionAddress;
+                    hash = hash * 31 + SymbolAddress;
+                    hash = hash * 31 + Package;
+                    return hash * 2 + (InApp ? 1 : 0);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Table size at some point, to roll back to with <see cref="Rollback"/>
+        /// </summary>
+        public readonly struct Checkpoint
+        {
+            internal readonly int Strings;
+            internal readonly int Frames;
+            internal readonly int EncodedBytes;
+
+            internal Checkpoint(int strings, int frames, int encodedBytes)
+            {
+                Strings = strings;
+                Frames = frames;
+                EncodedBytes = encodedBytes;
+            }
+        }
+
+        public BatchFrameTable()
+        {
+            // Index 0 stands for a missing string
+            _strings.Add("");
+            _stringIndex[""] = 0;
+        }
+
+        /// <summary>
+        /// Number of distinct frames so far
+        /// </summary>
+        public int FrameCount => _frames.Count;
+
+        /// <summary>
+        /// Number of distinct strings so far, including the empty string
+        /// </summary>
+        public int StringCount => _strings.Count;
+
+        /// <summary>
+        /// UTF-8 size of what AppendTables would write now
+        /// </summary>
+        public int EncodedBytes => _encodedBytes;
+
+        public Checkpoint GetCheckpoint()
+        {
+            return new Checkpoint(_strings.Count, _frames.Count, _encodedBytes);
+        }
+
+        /// <summary>
+        /// Forget every string and frame added since <paramref name="checkpoint"/>,
+        /// e.g. those of an item that was encoded and then taken out again
+        /// </summary>
+        public void Rollback(Checkpoint checkpoint)
+        {
+            for (var i = checkpoint.Frames; i < _frames.Count; i++)
+            {
+                _frameIndex.Remove(_frames[i]);
+            }
+            _frames.RemoveRange(checkpoint.Frames, _frames.Count - checkpoint.Frames);
+
+            for (var i = checkpoint.Strings; i < _strings.Count; i++)
+            {
+                _stringIndex.Remove(_strings[i]);
+            }
+            _strings.RemoveRange(checkpoint.Strings, _strings.Count - checkpoint.Strings);
+
+            _encodedBytes = checkpoint.EncodedBytes;
+        }
+
+        /// <summary>
+        /// Index of the string in "strings", adding it if new. Null and "" map to 0.
+        /// </summary>
+        public int Intern(string value)
+        {
+            if (string.IsNullOrEmpty(value)) return 0;
+
+            if (!_stringIndex.TryGetValue(value, out var index))
+            {
+                index = _strings.Count;
+                _strings.Add(value);
+                _stringIndex[value] = index;
+                _encodedBytes += 3 + WirePayloadEncoder.EncodedByteCount(value);
+            }
+            return index;
+        }
+
+        /// <summary>
+        /// Index of the frame in "frameTable", adding it if new
+        /// </summary>
+        public int AddFrame(StackFrame frame)
+        {
+            var key = new FrameKey(
+                Intern(frame.module),
+                Intern(frame.function),
+                Intern(frame.filename),
+                frame.lineno > 0 ? frame.lineno : 0,
+                frame.colno > 0 ? frame.colno : 0,
+                Intern(frame.instructionAddress),
+                Intern(frame.symbolAddress),
+                Intern(frame.package),
+                frame.inApp);
+
+            if (!_frameIndex.TryGetValue(key, out var index))
+            {
+                index = _frames.Count;
+                _frames.Add(key);
+                _frameIndex[key] = index;
+                _encodedBytes += (index > 0 ? 1 : 0) + FrameBytes(key);
+            }
+            return index;
+        }
+
+        /// <summary>
+        /// Append the frames of one item as a JSON array of frame indices
+        /// </summary>
+        public void AppendFrameRefs(StringBuilder sb, List<StackFrame> frames)
+        {
+            sb.Append('[');
+            for (int i = 0; i < frames.Count; i++)
+            {
+                if (i > 0) sb.Append(',');
+                sb.Append(AddFrame(frames[i]));
+            }
+            sb.Append(']');
+        }
+
+        /// <summary>
+        /// Append the "strings" and "frameTable" members (with a leading comma).
+        /// Call after every item has been added.
+        /// </summary>
+        public void AppendTables(StringBuilder sb, Func<string, string> escape)
+        {
+            sb.Append(",\"strings\":[");
+            for (int i = 0; i < _strings.Count; i++)
+            {
+                if (i > 0) sb.Append(',');
+                sb.Append('"').Append(escape(_strings[i])).Append('"');
+            }
+
+            sb.Append("],\"frameTable\":[");
+            for (int i = 0; i < _frames.Count; i++)
+            {
+                if (i > 0) sb.Append(',');
+                var frame = _frames[i];
+
+                // Zero fields are left out, like absent fields of inline frames
+                sb.Append('{');
+                var first = true;
+                AppendField(sb, "module", frame.Module, ref first);
+                AppendField(sb, "function", frame.Function, ref first);
+                AppendField(sb, "filename", frame.Filename, ref first);
+                AppendField(sb, "lineno", frame.Lineno, ref first);
+                AppendField(sb, "colno", frame.Colno, ref first);
+                AppendField(sb, "instructionAddress", frame.InstructionAddress, ref first);
+                AppendField(sb, "symbolAddress", frame.SymbolAddress, ref first);
+                AppendField(sb, "package", frame.Package, ref first);
+                if (frame.InApp)
+                {
+                    if (!first) sb.Append(',');
+                    sb.Append("\"inApp\":true");
+                }
+                sb.Append('}');
+            }
+            sb.Append(']');
+        }
+
+        // Length of the frame's object in AppendTables
+        private static int FrameBytes(FrameKey frame)
+        {
+            var bytes = 2;
+            var fields = 0;
+            bytes += FieldBytes("module", frame.Module, ref fields);
+            bytes += FieldBytes("function", frame.Function, ref fields);
+            bytes += FieldBytes("filename", frame.Filename, ref fields);
+            bytes += FieldBytes("lineno", frame.Lineno, ref fields);
+            bytes += FieldBytes("colno", frame.Colno, ref fields);
+            bytes += FieldBytes("instructionAddress", frame.InstructionAddress, ref fields);
+            bytes += FieldBytes("symbolAddress", frame.SymbolAddress, ref fields);
+            bytes += FieldBytes("package", frame.Package, ref fields);
+            if (frame.InApp)
+                bytes += (fields > 0 ? 1 : 0) + "\"inApp\":true".Length;
+            return bytes;
+        }
+
+        private static int FieldBytes(string name, int value, ref int fields)
+        {
+            if (value == 0) return 0;
+            var digits = 1;
+            for (var v = value; v >= 10; v /= 10) digits++;
+            return (fields++ > 0 ? 1 : 0) + name.Length + 3 + digits;
+        }
+
+        private static void AppendField(StringBuilder sb, string name, int value, ref bool first)
+        {
+            if (value == 0) return;
+            if (!first) sb.Append(',');
+            sb.Append('"').Append(name).Append("\":").Append(value);
+            first = false;
+        }
+    }
+}
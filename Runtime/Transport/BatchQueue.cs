@@ -12,18 +12,28 @@ namespace MoonForge.ErrorTracking
         private readonly ErrorTrackerConfig _config;
         private readonly HttpTransport _transport;
         private readonly Action<ErrorPayloadInner> _onSendFailed;
+        private readonly SdkWorkerThread _worker;
+        private readonly FrameBudgetScheduler _scheduler;
 
         private readonly List<BatchErrorItem> _queue;
         private readonly object _lock = new object();
 
         private float _lastBatchTime;
         private bool _isSending;
+        private SdkTimer _flushDeadline;
 
-        public BatchQueue(ErrorTrackerConfig config, HttpTransport transport, Action<ErrorPayloadInner> onSendFailed = null)
+        /// <summary>
+        /// With a worker and scheduler, the max-wait flush runs off a timer deadline
+        /// and <see cref="Update"/> doesn't need to be called.
+        /// </summary>
+        public BatchQueue(ErrorTrackerConfig config, HttpTransport transport, Action<ErrorPayloadInner> onSendFailed = null,
+            SdkWorkerThread worker = null, FrameBudgetScheduler scheduler = null)
         {
             _config = config;
             _transport = transport;
             _onSendFailed = onSendFailed;
+            _worker = worker;
+            _scheduler = scheduler;
             _queue = new List<BatchErrorItem>();
             _lastBatchTime = Time.unscaledTime;
         }
@@ -49,11 +59,13 @@ namespace MoonForge.ErrorTracking
                 {
                     FlushInternal();
                 }
+
+                ArmFlushDeadline();
             }
         }
 
         /// <summary>
-        /// Update the batch queue (call from Update loop)
+        /// Update the batch queue (call from Update loop when no worker is used)
         /// </summary>
         public void Update()
         {
@@ -122,6 +134,31 @@ namespace MoonForge.ErrorTracking
             }
         }
 
+        /// <summary>
+        /// Schedule a flush maxBatchWaitTime from now if items are waiting and none is scheduled. Caller holds _lock.
+        /// </summary>
+        private void ArmFlushDeadline()
+        {
+            if (_worker == null || _scheduler == null) return;
+            if (_flushDeadline != null || _queue.Count == 0) return;
+
+            // The timer fires on the worker; the flush itself needs the main thread
+            _flushDeadline = _worker.Schedule(TimeSpan.FromSeconds(_config.maxBatchWaitTime),
+                () => _scheduler.PostOnce("batch-flush-deadline", OnFlushDeadline));
+        }
+
+        private void OnFlushDeadline()
+        {
+            lock (_lock)
+            {
+                _flushDeadline = null;
+                FlushInternal();
+
+                // Still waiting (send in flight, offline or more than one batch queued): try again later
+                ArmFlushDeadline();
+            }
+        }
+
         private void FlushInternal()
         {
             if (_isSending || _queue.Count == 0) return;
@@ -130,8 +167,9 @@ namespace MoonForge.ErrorTracking
             _isSending = true;
             _lastBatchTime = Time.unscaledTime;
 
-            // Take items from queue
-            var itemsToSend = new List<BatchErrorItem>();
+            // Take items from queue; the arena owns them until the upload has finished
+            var arena = PayloadArena.Rent();
+            var itemsToSend = arena.Items;
             var count = Math.Min(_queue.Count, _config.maxBatchSize);
 
             for (var i = 0; i < count; i++)
@@ -145,7 +183,8 @@ namespace MoonForge.ErrorTracking
             var batchPayload = new ErrorBatchPayload
             {
                 game = _config.gameId,
-                errors = itemsToSend
+                errors = itemsToSend,
+                arena = arena
             };
 
             if (_config.debugMode)
@@ -158,6 +197,14 @@ namespace MoonForge.ErrorTracking
             {
                 _isSending = false;
 
+                // Acknowledged or given up on: nothing refers to the items any more
+                arena.Release();
+
+                lock (_lock)
+                {
+                    ArmFlushDeadline();
+                }
+
                 if (response?.status == "error")
                 {
                     if (_config.debugMode)
@@ -177,30 +224,32 @@ namespace MoonForge.ErrorTracking
 
         private BatchErrorItem ConvertToQueueItem(ErrorPayloadInner payload)
         {
-            return new BatchErrorItem
-            {
-                clientErrorId = Guid.NewGuid().ToString(),
-                errorType = payload.errorType,
-                errorCategory = payload.errorCategory,
-                errorLevel = payload.errorLevel,
-                message = payload.message,
-                frames = payload.frames,
-                rawStackTrace = payload.rawStackTrace,
-                exceptionClass = payload.exceptionClass,
-                fingerprint = payload.fingerprint,
-                device = payload.device,
-                network = payload.network,
-                gameState = payload.gameState,
-                appVersion = payload.appVersion,
-                buildNumber = payload.buildNumber,
-                unityVersion = payload.unityVersion,
-                userId = payload.userId,
-                sessionId = payload.sessionId,
-                breadcrumbs = payload.breadcrumbs,
-                timestamp = payload.timestamp,
-                networkRequest = payload.networkRequest,
-                tags = payload.tags
-            };
+            // Recycled from an acknowledged batch when possible
+            var item = PayloadArena.RentItem();
+            item.clientErrorId = Guid.NewGuid().ToString();
+            item.errorType = payload.errorType;
+            item.errorCategory = payload.errorCategory;
+            item.errorLevel = payload.errorLevel;
+            item.message = payload.message;
+            item.frames = payload.frames;
+            item.rawStackTrace = payload.rawStackTrace;
+            item.logTail = payload.logTail;
+            item.exceptionClass = payload.exceptionClass;
+            item.faultClass = payload.faultClass;
+            item.fingerprint = payload.fingerprint;
+            item.device = payload.device;
+            item.network = payload.network;
+            item.gameState = payload.gameState;
+            item.appVersion = payload.appVersion;
+            item.buildNumber = payload.buildNumber;
+            item.unityVersion = payload.unityVersion;
+            item.userId = payload.userId;
+            item.sessionId = payload.sessionId;
+            item.breadcrumbs = payload.breadcrumbs;
+            item.timestamp = payload.timestamp;
+            item.networkRequest = payload.networkRequest;
+            item.tags = payload.tags;
+            return item;
         }
     }
 }
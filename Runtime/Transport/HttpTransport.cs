@@ -1,7 +1,6 @@
 using System;
 using System.Collections;
 using System.Collections.Generic;
-using System.Globalization;
 using System.Text;
 using UnityEngine;
 using UnityEngine.Networking;
@@ -15,19 +14,39 @@ namespace MoonForge.ErrorTracking
     {
         private readonly ErrorTrackerConfig _config;
         private readonly MonoBehaviour _coroutineRunner;
+        private readonly SdkWorkerThread _worker;
+        private readonly FrameBudgetScheduler _scheduler;
 
-        public HttpTransport(ErrorTrackerConfig config, MonoBehaviour coroutineRunner)
+        /// <summary>
+        /// When a worker and scheduler are given, payloads are serialized on the worker
+        /// and only the request itself is started on the main thread.
+        /// </summary>
+        public HttpTransport(ErrorTrackerConfig config, MonoBehaviour coroutineRunner,
+            SdkWorkerThread worker = null, FrameBudgetScheduler scheduler = null)
         {
             _config = config;
             _coroutineRunner = coroutineRunner;
+            _worker = worker;
+            _scheduler = scheduler;
         }
 
         /// <summary>
         /// Send a single error payload
         /// </summary>
-        public void SendError(ErrorPayload payload, Action<ErrorSubmissionResponse> onComplete)
+        /// <param name="immediate">Serialize and start the request on the calling frame (crash paths)</param>
+        public void SendError(ErrorPayload payload, Action<ErrorSubmissionResponse> onComplete, bool immediate = false)
         {
-            _coroutineRunner.StartCoroutine(SendErrorCoroutine(payload, onComplete));
+            if (immediate || _worker == null || _scheduler == null)
+            {
+                _coroutineRunner.StartCoroutine(SendErrorCoroutine(SerializeErrorPayload(payload), onComplete));
+                return;
+            }
+
+            _worker.Post(() =>
+            {
+                var json = SerializeErrorPayload(payload);
+                _scheduler.Post(() => StartRequest(SendErrorCoroutine(json, onComplete)));
+            });
         }
 
         /// <summary>
@@ -35,12 +54,28 @@ namespace MoonForge.ErrorTracking
         /// </summary>
         public void SendBatch(ErrorBatchPayload payload, Action<BatchSubmissionResponse> onComplete)
         {
-            _coroutineRunner.StartCoroutine(SendBatchCoroutine(payload, onComplete));
+            if (_worker == null || _scheduler == null)
+            {
+                _coroutineRunner.StartCoroutine(SendBatchBodiesCoroutine(SerializeBatchPayload(payload), onComplete));
+                return;
+            }
+
+            _worker.Post(() =>
+            {
+                var bodies = SerializeBatchPayload(payload);
+                _scheduler.Post(() => StartRequest(SendBatchBodiesCoroutine(bodies, onComplete)));
+            });
+        }
+
+        private void StartRequest(IEnumerator request)
+        {
+            // The runner may have been destroyed while the payload was being serialized
+            if (_coroutineRunner == null || !_coroutineRunner.isActiveAndEnabled) return;
+            _coroutineRunner.StartCoroutine(request);
         }
 
-        private IEnumerator SendErrorCoroutine(ErrorPayload payload, Action<ErrorSubmissionResponse> onComplete)
+        private IEnumerator SendErrorCoroutine(string json, Action<ErrorSubmissionResponse> onComplete)
         {
-            var json = SerializeErrorPayload(payload);
             var url = _config.GetErrorsApiUrl();
 
             var attempt = 0;
@@ -130,9 +165,58 @@ namespace MoonForge.ErrorTracking
             onComplete?.Invoke(response);
         }
 
-        private IEnumerator SendBatchCoroutine(ErrorBatchPayload payload, Action<BatchSubmissionResponse> onComplete)
+        /// <summary>
+        /// Send the request bodies of one batch in turn and report them as a single response
+        /// </summary>
+        private IEnumerator SendBatchBodiesCoroutine(List<BatchBody> bodies, Action<BatchSubmissionResponse> onComplete)
+        {
+            if (bodies.Count == 1)
+            {
+                yield return SendBatchCoroutine(bodies[0].json, bodies[0].count, onComplete);
+                yield break;
+            }
+
+            if (_config.debugMode)
+            {
+                Debug.Log($"[MoonForge] Batch is over {_config.maxBatchPayloadKB} KB, sending it as {bodies.Count} requests");
+            }
+
+            BatchSubmissionResponse merged = null;
+            foreach (var body in bodies)
+            {
+                BatchSubmissionResponse part = null;
+                yield return SendBatchCoroutine(body.json, body.count, response => part = response);
+                merged = MergeBatchResponses(merged, part);
+            }
+
+            onComplete?.Invoke(merged);
+        }
+
+        private static BatchSubmissionResponse MergeBatchResponses(BatchSubmissionResponse merged, BatchSubmissionResponse part)
+        {
+            if (part == null) return merged;
+            if (merged == null) return part;
+
+            merged.total += part.total;
+            merged.accepted += part.accepted;
+            merged.sampledOut += part.sampledOut;
+            if (part.results != null)
+            {
+                if (merged.results == null) merged.results = new List<BatchResultItem>();
+                merged.results.AddRange(part.results);
+            }
+
+            // Any failed request fails the batch, as it would have unsplit
+            if (part.status == "error" && merged.status != "error")
+            {
+                merged.status = "error";
+                merged.error = part.error;
+            }
+            return merged;
+        }
+
+        private IEnumerator SendBatchCoroutine(string json, int count, Action<BatchSubmissionResponse> onComplete)
         {
-            var json = SerializeBatchPayload(payload);
             var url = _config.GetBatchErrorsApiUrl();
 
             var attempt = 0;
@@ -146,7 +230,7 @@ namespace MoonForge.ErrorTracking
 
                     if (_config.debugMode)
                     {
-                        Debug.Log($"[MoonForge] Sending batch ({payload.errors?.Count ?? 0} errors) to {url} (attempt {attempt + 1})");
+                        Debug.Log($"[MoonForge] Sending batch ({count} errors) to {url} (attempt {attempt + 1})");
                     }
 
                     yield return request.SendWebRequest();
@@ -271,372 +355,94 @@ namespace MoonForge.ErrorTracking
         private string SerializeErrorPayload(ErrorPayload payload)
         {
             var sb = new StringBuilder();
-            sb.Append("{\"type\":\"error\",\"payload\":");
-            sb.Append(SerializeErrorPayloadInner(payload.payload, includeGame: true));
-            sb.Append("}");
+            WirePayloadEncoder.Append(sb, payload);
             return sb.ToString();
         }
 
         /// <summary>
-        /// Custom JSON serialization for ErrorBatchPayload
+        /// One request body of a batch and the number of errors in it
         /// </summary>
-        private string SerializeBatchPayload(ErrorBatchPayload payload)
-        {
-            var sb = new StringBuilder();
-            sb.Append("{\"type\":\"error_batch\"");
-            sb.Append($",\"game\":\"{EscapeJsonString(payload.game)}\"");
-            sb.Append(",\"errors\":[");
-
-            if (payload.errors != null)
-            {
-                for (int i = 0; i < payload.errors.Count; i++)
-                {
-                    if (i > 0) sb.Append(",");
-                    sb.Append(SerializeBatchErrorItem(payload.errors[i]));
-                }
-            }
-
-            sb.Append("]}");
-            return sb.ToString();
-        }
-
-        private string SerializeErrorPayloadInner(ErrorPayloadInner p, bool includeGame)
-        {
-            var fields = new List<string>();
-
-            if (includeGame && !string.IsNullOrEmpty(p.game))
-                fields.Add($"\"game\":\"{EscapeJsonString(p.game)}\"");
-
-            fields.Add($"\"errorType\":\"{EscapeJsonString(p.errorType)}\"");
-            fields.Add($"\"errorCategory\":\"{EscapeJsonString(p.errorCategory)}\"");
-            fields.Add($"\"errorLevel\":\"{EscapeJsonString(p.errorLevel)}\"");
-            fields.Add($"\"message\":\"{EscapeJsonString(p.message)}\"");
-
-            if (p.frames != null && p.frames.Count > 0)
-                fields.Add($"\"frames\":{SerializeStackFrames(p.frames)}");
-
-            if (!string.IsNullOrEmpty(p.rawStackTrace))
-                fields.Add($"\"rawStackTrace\":\"{EscapeJsonString(p.rawStackTrace)}\"");
-
-            if (!string.IsNullOrEmpty(p.exceptionClass))
-                fields.Add($"\"exceptionClass\":\"{EscapeJsonString(p.exceptionClass)}\"");
-
-            if (!string.IsNullOrEmpty(p.fingerprint))
-                fields.Add($"\"fingerprint\":\"{EscapeJsonString(p.fingerprint)}\"");
-
-            if (p.device != null)
-                fields.Add($"\"device\":{SerializeDeviceContext(p.device)}");
-
-            if (p.network != null)
-                fields.Add($"\"network\":{SerializeNetworkContext(p.network)}");
-
-            if (p.gameState != null)
-                fields.Add($"\"gameState\":{SerializeGameState(p.gameState)}");
-
-            fields.Add($"\"appVersion\":\"{EscapeJsonString(p.appVersion)}\"");
-            fields.Add($"\"buildNumber\":\"{EscapeJsonString(p.buildNumber)}\"");
-
-            if (!string.IsNullOrEmpty(p.unityVersion))
-                fields.Add($"\"unityVersion\":\"{EscapeJsonString(p.unityVersion)}\"");
-
-            if (!string.IsNullOrEmpty(p.userId))
-                fields.Add($"\"userId\":\"{EscapeJsonString(p.userId)}\"");
-
-            if (!string.IsNullOrEmpty(p.sessionId))
-                fields.Add($"\"sessionId\":\"{EscapeJsonString(p.sessionId)}\"");
-
-            if (p.breadcrumbs != null && p.breadcrumbs.Count > 0)
-                fields.Add($"\"breadcrumbs\":{SerializeBreadcrumbs(p.breadcrumbs)}");
-
-            if (p.timestamp.HasValue)
-                fields.Add($"\"timestamp\":{p.timestamp.Value}");
-
-            if (p.networkRequest != null)
-                fields.Add($"\"networkRequest\":{SerializeNetworkRequest(p.networkRequest)}");
-
-            if (p.tags != null && p.tags.Count > 0)
-                fields.Add($"\"tags\":{SerializeStringDictionary(p.tags)}");
-
-            return "{" + string.Join(",", fields) + "}";
-        }
-
-        private string SerializeBatchErrorItem(BatchErrorItem item)
+        private struct BatchBody
         {
-            var fields = new List<string>();
-
-            fields.Add($"\"clientErrorId\":\"{EscapeJsonString(item.clientErrorId)}\"");
-            fields.Add($"\"errorType\":\"{EscapeJsonString(item.errorType)}\"");
-            fields.Add($"\"errorCategory\":\"{EscapeJsonString(item.errorCategory)}\"");
-            fields.Add($"\"errorLevel\":\"{EscapeJsonString(item.errorLevel)}\"");
-            fields.Add($"\"message\":\"{EscapeJsonString(item.message)}\"");
-
-            if (item.frames != null && item.frames.Count > 0)
-                fields.Add($"\"frames\":{SerializeStackFrames(item.frames)}");
-
-            if (!string.IsNullOrEmpty(item.rawStackTrace))
-                fields.Add($"\"rawStackTrace\":\"{EscapeJsonString(item.rawStackTrace)}\"");
-
-            if (!string.IsNullOrEmpty(item.exceptionClass))
-                fields.Add($"\"exceptionClass\":\"{EscapeJsonString(item.exceptionClass)}\"");
-
-            if (!string.IsNullOrEmpty(item.fingerprint))
-                fields.Add($"\"fingerprint\":\"{EscapeJsonString(item.fingerprint)}\"");
-
-            if (item.device != null)
-                fields.Add($"\"device\":{SerializeDeviceContext(item.device)}");
-
-            if (item.network != null)
-                fields.Add($"\"network\":{SerializeNetworkContext(item.network)}");
-
-            if (item.gameState != null)
-                fields.Add($"\"gameState\":{SerializeGameState(item.gameState)}");
-
-            fields.Add($"\"appVersion\":\"{EscapeJsonString(item.appVersion)}\"");
-            fields.Add($"\"buildNumber\":\"{EscapeJsonString(item.buildNumber)}\"");
-
-            if (!string.IsNullOrEmpty(item.unityVersion))
-                fields.Add($"\"unityVersion\":\"{EscapeJsonString(item.unityVersion)}\"");
-
-            if (!string.IsNullOrEmpty(item.userId))
-                fields.Add($"\"userId\":\"{EscapeJsonString(item.userId)}\"");
-
-            if (!string.IsNullOrEmpty(item.sessionId))
-                fields.Add($"\"sessionId\":\"{EscapeJsonString(item.sessionId)}\"");
-
-            if (item.breadcrumbs != null && item.breadcrumbs.Count > 0)
-                fields.Add($"\"breadcrumbs\":{SerializeBreadcrumbs(item.breadcrumbs)}");
-
-            if (item.timestamp.HasValue)
-                fields.Add($"\"timestamp\":{item.timestamp.Value}");
-
-            if (item.networkRequest != null)
-                fields.Add($"\"networkRequest\":{SerializeNetworkRequest(item.networkRequest)}");
-
-            if (item.tags != null && item.tags.Count > 0)
-                fields.Add($"\"tags\":{SerializeStringDictionary(item.tags)}");
-
-            return "{" + string.Join(",", fields) + "}";
+            public string json;
+            public int count;
         }
 
-        private string SerializeStackFrames(List<StackFrame> frames)
-        {
-            var sb = new StringBuilder("[");
-            for (int i = 0; i < frames.Count; i++)
-            {
-                if (i > 0) sb.Append(",");
-                sb.Append(SerializeStackFrame(frames[i]));
-            }
-            sb.Append("]");
-            return sb.ToString();
-        }
-
-        private string SerializeStackFrame(StackFrame frame)
-        {
-            var fields = new List<string>();
-
-            if (!string.IsNullOrEmpty(frame.module))
-                fields.Add($"\"module\":\"{EscapeJsonString(frame.module)}\"");
-            if (!string.IsNullOrEmpty(frame.function))
-                fields.Add($"\"function\":\"{EscapeJsonString(frame.function)}\"");
-            if (!string.IsNullOrEmpty(frame.filename))
-                fields.Add($"\"filename\":\"{EscapeJsonString(frame.filename)}\"");
-            if (frame.lineno > 0)
-                fields.Add($"\"lineno\":{frame.lineno}");
-            if (frame.colno > 0)
-                fields.Add($"\"colno\":{frame.colno}");
-            if (!string.IsNullOrEmpty(frame.instructionAddress))
-                fields.Add($"\"instructionAddress\":\"{EscapeJsonString(frame.instructionAddress)}\"");
-            if (!string.IsNullOrEmpty(frame.symbolAddress))
-                fields.Add($"\"symbolAddress\":\"{EscapeJsonString(frame.symbolAddress)}\"");
-            if (frame.inApp)
-                fields.Add("\"inApp\":true");
-            if (!string.IsNullOrEmpty(frame.package))
-                fields.Add($"\"package\":\"{EscapeJsonString(frame.package)}\"");
-
-            return "{" + string.Join(",", fields) + "}";
-        }
-
-        private string SerializeDeviceContext(DeviceContext device)
-        {
-            var fields = new List<string>();
-
-            fields.Add($"\"platform\":\"{EscapeJsonString(device.platform)}\"");
-            fields.Add($"\"osVersion\":\"{EscapeJsonString(device.osVersion)}\"");
-            fields.Add($"\"deviceModel\":\"{EscapeJsonString(device.deviceModel)}\"");
-
-            if (!string.IsNullOrEmpty(device.manufacturer))
-                fields.Add($"\"manufacturer\":\"{EscapeJsonString(device.manufacturer)}\"");
-            if (!string.IsNullOrEmpty(device.cpuArchitecture))
-                fields.Add($"\"cpuArchitecture\":\"{EscapeJsonString(device.cpuArchitecture)}\"");
-            if (device.memoryUsedMb.HasValue)
-                fields.Add($"\"memoryUsedMb\":{device.memoryUsedMb.Value.ToString(CultureInfo.InvariantCulture)}");
-            if (device.memoryAvailableMb.HasValue)
-                fields.Add($"\"memoryAvailableMb\":{device.memoryAvailableMb.Value.ToString(CultureInfo.InvariantCulture)}");
-            if (device.cpuUsagePercent.HasValue)
-                fields.Add($"\"cpuUsagePercent\":{device.cpuUsagePercent.Value.ToString(CultureInfo.InvariantCulture)}");
-            if (device.fps.HasValue)
-                fields.Add($"\"fps\":{device.fps.Value.ToString(CultureInfo.InvariantCulture)}");
-            if (device.batteryLevel.HasValue)
-                fields.Add($"\"batteryLevel\":{device.batteryLevel.Value.ToString(CultureInfo.InvariantCulture)}");
-            if (device.batteryCharging.HasValue)
-                fields.Add($"\"batteryCharging\":{(device.batteryCharging.Value ? "true" : "false")}");
-            if (!string.IsNullOrEmpty(device.thermalState))
-                fields.Add($"\"thermalState\":\"{EscapeJsonString(device.thermalState)}\"");
-
-            return "{" + string.Join(",", fields) + "}";
-        }
-
-        private string SerializeNetworkContext(NetworkContext network)
+        /// <summary>
+        /// Custom JSON serialization for ErrorBatchPayload. Each error is kept within
+        /// maxErrorPayloadKB (see <see cref="PayloadBudget"/>); errors that would take
+        /// the body past maxBatchPayloadKB go into a further body, sent as its own request.
+        /// </summary>
+        private List<BatchBody> SerializeBatchPayload(ErrorBatchPayload payload)
         {
-            var fields = new List<string>();
-
-            if (!string.IsNullOrEmpty(network.type))
-                fields.Add($"\"type\":\"{EscapeJsonString(network.type)}\"");
-            if (!string.IsNullOrEmpty(network.carrier))
-                fields.Add($"\"carrier\":\"{EscapeJsonString(network.carrier)}\"");
-            if (!string.IsNullOrEmpty(network.effectiveType))
-                fields.Add($"\"effectiveType\":\"{EscapeJsonString(network.effectiveType)}\"");
+            var maxItemBytes = _config.maxErrorPayloadKB * 1024;
+            var maxBodyBytes = _config.maxBatchPayloadKB * 1024;
+            var bodies = new List<BatchBody>(1);
 
-            return "{" + string.Join(",", fields) + "}";
-        }
+            // The whole batch is written into one buffer, pooled with the batch's arena
+            var sb = payload.arena?.Buffer ?? new StringBuilder();
+            var frameTable = BeginBatchBody(sb, payload.game);
+            var bodyBytes = PayloadBudget.Utf8Length(sb, 0);
+            var count = 0;
 
-        private string SerializeGameState(GameState state)
-        {
-            var fields = new List<string>();
-
-            if (!string.IsNullOrEmpty(state.sceneName))
-                fields.Add($"\"sceneName\":\"{EscapeJsonString(state.sceneName)}\"");
-            if (!string.IsNullOrEmpty(state.gameMode))
-                fields.Add($"\"gameMode\":\"{EscapeJsonString(state.gameMode)}\"");
-            if (!string.IsNullOrEmpty(state.levelId))
-                fields.Add($"\"levelId\":\"{EscapeJsonString(state.levelId)}\"");
-            if (state.customData != null && state.customData.Count > 0)
-                fields.Add($"\"customData\":{SerializeObjectDictionary(state.customData)}");
-
-            return "{" + string.Join(",", fields) + "}";
-        }
-
-        private string SerializeBreadcrumbs(List<Breadcrumb> breadcrumbs)
-        {
-            var sb = new StringBuilder("[");
-            for (int i = 0; i < breadcrumbs.Count; i++)
+            if (payload.errors != null)
             {
-                if (i > 0) sb.Append(",");
-                sb.Append(SerializeBreadcrumb(breadcrumbs[i]));
-            }
-            sb.Append("]");
-            return sb.ToString();
-        }
-
-        private string SerializeBreadcrumb(Breadcrumb bc)
-        {
-            var fields = new List<string>();
-
-            fields.Add($"\"type\":\"{EscapeJsonString(bc.type)}\"");
-            if (!string.IsNullOrEmpty(bc.category))
-                fields.Add($"\"category\":\"{EscapeJsonString(bc.category)}\"");
-            if (!string.IsNullOrEmpty(bc.message))
-                fields.Add($"\"message\":\"{EscapeJsonString(bc.message)}\"");
-            fields.Add($"\"level\":\"{EscapeJsonString(bc.level)}\"");
-            if (bc.data != null && bc.data.Count > 0)
-                fields.Add($"\"data\":{SerializeObjectDictionary(bc.data)}");
-            fields.Add($"\"timestamp\":{bc.timestamp}");
-
-            return "{" + string.Join(",", fields) + "}";
-        }
+                foreach (var item in payload.errors)
+                {
+                    var itemStart = sb.Length;
+                    var checkpoint = frameTable?.GetCheckpoint() ?? default;
+                    if (count > 0) sb.Append(',');
+                    var itemBytes = (count > 0 ? 1 : 0) + PayloadBudget.AppendItem(sb, item, frameTable, maxItemBytes);
+
+                    // "]", the tables and "}" still follow the last item
+                    var tailBytes = 2 + (frameTable?.EncodedBytes ?? 0);
+                    if (maxBodyBytes > 0 && count > 0 && bodyBytes + itemBytes + tailBytes > maxBodyBytes)
+                    {
+                        sb.Length = itemStart;
+                        frameTable?.Rollback(checkpoint);
+                        bodies.Add(EndBatchBody(sb, frameTable, count));
+
+                        frameTable = BeginBatchBody(sb, payload.game);
+                        bodyBytes = PayloadBudget.Utf8Length(sb, 0);
+                        count = 0;
+                        itemBytes = PayloadBudget.AppendItem(sb, item, frameTable, maxItemBytes);
+                    }
 
-        private string SerializeNetworkRequest(NetworkRequest req)
-        {
-            var fields = new List<string>();
-
-            fields.Add($"\"url\":\"{EscapeJsonString(req.url)}\"");
-            fields.Add($"\"method\":\"{EscapeJsonString(req.method)}\"");
-            if (req.statusCode.HasValue)
-                fields.Add($"\"statusCode\":{req.statusCode.Value}");
-            if (req.durationMs.HasValue)
-                fields.Add($"\"durationMs\":{req.durationMs.Value.ToString(CultureInfo.InvariantCulture)}");
-            if (req.requestHeaders != null && req.requestHeaders.Count > 0)
-                fields.Add($"\"requestHeaders\":{SerializeStringDictionary(req.requestHeaders)}");
-            if (req.responseHeaders != null && req.responseHeaders.Count > 0)
-                fields.Add($"\"responseHeaders\":{SerializeStringDictionary(req.responseHeaders)}");
-
-            return "{" + string.Join(",", fields) + "}";
-        }
+                    if (_config.debugMode && item?.truncated != null)
+                    {
+                        Debug.Log($"[MoonForge] Trimmed error {item.clientErrorId} to {itemBytes} bytes");
+                    }
 
-        private string SerializeStringDictionary(Dictionary<string, string> dict)
-        {
-            var sb = new StringBuilder("{");
-            bool first = true;
-            foreach (var kvp in dict)
-            {
-                if (!first) sb.Append(",");
-                sb.Append($"\"{EscapeJsonString(kvp.Key)}\":\"{EscapeJsonString(kvp.Value)}\"");
-                first = false;
+                    bodyBytes += itemBytes;
+                    count++;
+                }
             }
-            sb.Append("}");
-            return sb.ToString();
-        }
 
-        private string SerializeObjectDictionary(Dictionary<string, object> dict)
-        {
-            var sb = new StringBuilder("{");
-            bool first = true;
-            foreach (var kvp in dict)
-            {
-                if (!first) sb.Append(",");
-                sb.Append($"\"{EscapeJsonString(kvp.Key)}\":{SerializeValue(kvp.Value)}");
-                first = false;
-            }
-            sb.Append("}");
-            return sb.ToString();
+            bodies.Add(EndBatchBody(sb, frameTable, count));
+            return bodies;
         }
 
-        private string SerializeValue(object value)
+        // Start a body in the cleared buffer; returns its frame table when frames are compacted
+        private BatchFrameTable BeginBatchBody(StringBuilder sb, string game)
         {
-            if (value == null)
-                return "null";
-            if (value is bool b)
-                return b ? "true" : "false";
-            if (value is int || value is long)
-                return value.ToString();
-            if (value is float f)
-                return f.ToString(CultureInfo.InvariantCulture);
-            if (value is double d)
-                return d.ToString(CultureInfo.InvariantCulture);
-            if (value is string s)
-                return $"\"{EscapeJsonString(s)}\"";
-            if (value is Dictionary<string, object> dict)
-                return SerializeObjectDictionary(dict);
-            // Default to string representation
-            return $"\"{EscapeJsonString(value.ToString())}\"";
+            // Items reference shared frame and string tables instead of carrying frames inline
+            var frameTable = _config.compactBatchFrames ? new BatchFrameTable() : null;
+
+            sb.Clear();
+            sb.Append("{\"type\":\"error_batch\",\"game\":");
+            WirePayloadEncoder.AppendString(sb, game);
+            if (frameTable != null)
+                sb.Append(",\"frameEncoding\":\"table\"");
+            sb.Append(",\"errors\":[");
+            return frameTable;
         }
 
-        private string EscapeJsonString(string str)
+        private static BatchBody EndBatchBody(StringBuilder sb, BatchFrameTable frameTable, int count)
         {
-            if (string.IsNullOrEmpty(str))
-                return "";
-
-            var sb = new StringBuilder(str.Length);
-            foreach (char c in str)
-            {
-                switch (c)
-                {
-                    case '"': sb.Append("\\\""); break;
-                    case '\\': sb.Append("\\\\"); break;
-                    case '\b': sb.Append("\\b"); break;
-                    case '\f': sb.Append("\\f"); break;
-                    case '\n': sb.Append("\\n"); break;
-                    case '\r': sb.Append("\\r"); break;
-                    case '\t': sb.Append("\\t"); break;
-                    default:
-                        if (c < ' ')
-                            sb.Append($"\\u{(int)c:X4}");
-                        else
-                            sb.Append(c);
-                        break;
-                }
-            }
-            return sb.ToString();
+            sb.Append(']');
+            frameTable?.AppendTables(sb, WirePayloadEncoder.Escape);
+            sb.Append('}');
+            return new BatchBody { json = sb.ToString(), count = count };
         }
 
         #endregion
@@ -136,6 +136,53 @@ namespace MoonForge.ErrorTracking
             return errors;
         }
 
+        /// <summary>
+        /// Read and remove all stored errors in one step, so errors stored
+        /// concurrently are kept for the next call instead of being cleared unsent
+        /// </summary>
+        public List<ErrorPayloadInner> TakeStoredErrors()
+        {
+            var errors = new List<ErrorPayloadInner>();
+
+            lock (_lock)
+            {
+                try
+                {
+                    var files = GetStoredFiles();
+                    foreach (var file in files)
+                    {
+                        try
+                        {
+                            var json = File.ReadAllText(file.FullName);
+                            var wrapper = JsonUtility.FromJson<StoredError>(json);
+                            if (wrapper?.payload != null)
+                            {
+                                errors.Add(wrapper.payload);
+                            }
+                        }
+                        catch (Exception ex)
+                        {
+                            if (_config.debugMode)
+                            {
+                                Debug.LogWarning($"[MoonForge] Failed to read stored error: {ex.Message}");
+                            }
+                        }
+
+                        try { File.Delete(file.FullName); } catch { }
+                    }
+                }
+                catch (Exception ex)
+                {
+                    if (_config.debugMode)
+                    {
+                        Debug.LogWarning($"[MoonForge] Failed to take stored errors: {ex.Message}");
+                    }
+                }
+            }
+
+            return errors;
+        }
+
         /// <summary>
         /// Clear all stored errors
         /// </summary>
@@ -0,0 +1,193 @@
+using System;
+using System.Collections.Generic;
+using System.Text;
+using System.Threading;
+
+namespace MoonForge.ErrorTracking
+{
+    /// <summary>
+    /// Allocation counters for <see cref="PayloadArena"/>
+    /// </summary>
+    [Serializable]
+    public struct PayloadArenaStats
+    {
+        /// <summary>Arenas ever allocated; stays flat once the pool is warm</summary>
+        public long arenasCreated;
+        /// <summary>Batches that took an arena</summary>
+        public long arenasRented;
+        /// <summary>Arenas taken and not yet released (batches in flight)</summary>
+        public int arenasInUse;
+        /// <summary>Queue items ever allocated</summary>
+        public long itemsCreated;
+        /// <summary>Queue items served from the pool</summary>
+        public long itemsReused;
+        /// <summary>Characters currently reserved by pooled encode buffers</summary>
+        public long pooledBufferChars;
+    }
+
+    /// <summary>
+    /// Everything one error batch needs, kept together and recycled together.
+    /// BatchQueue rents an arena per flush and fills it with the batch's items;
+    /// the worker encodes the whole batch into the arena's buffer; when the upload
+    /// is acknowledged (or given up on) the arena goes back to the pool with its
+    /// items, whose objects are reused by later errors. Steady-state batching then
+    /// allocates neither queue items nor encode buffers.
+    /// </summary>
+    public sealed class PayloadArena
+    {
+        // Enough for a couple of batches in flight plus the one being filled
+        private const int MaxPooledArenas = 4;
+        // Twice the largest batch
+        private const int MaxPooledItems = 100;
+        // Buffers that grew past this (a pathological batch) are not kept
+        private const int MaxPooledBufferChars = 1024 * 1024;
+        private const int InitialBufferChars = 16 * 1024;
+
+        private static readonly Stack<PayloadArena> _arenaPool = new Stack<PayloadArena>();
+        private static readonly Stack<BatchErrorItem> _itemPool = new Stack<BatchErrorItem>();
+        private static readonly object _poolLock = new object();
+
+        private static long _arenasCreated;
+        private static long _arenasRented;
+        private static int _arenasInUse;
+        private static long _itemsCreated;
+        private static long _itemsReused;
+
+        private bool _rented;
+
+        /// <summary>
+        /// The batch's items, in send order
+        /// </summary>
+        public List<BatchErrorItem> Items { get; } = new List<BatchErrorItem>();
+
+        /// <summary>
+        /// Encode buffer for the batch; empty when rented
+        /// </summary>
+        public StringBuilder Buffer { get; } = new StringBuilder(InitialBufferChars);
+
+        private PayloadArena()
+        {
+        }
+
+        /// <summary>
+        /// Take an arena from the pool, or allocate one
+        /// </summary>
+        public static PayloadArena Rent()
+        {
+            PayloadArena arena = null;
+            lock (_poolLock)
+            {
+                if (_arenaPool.Count > 0) arena = _arenaPool.Pop();
+            }
+
+            if (arena == null)
+            {
+                arena = new PayloadArena();
+                Interlocked.Increment(ref _arenasCreated);
+            }
+
+            arena._rented = true;
+            Interlocked.Increment(ref _arenasRented);
+            Interlocked.Increment(ref _arenasInUse);
+            return arena;
+        }
+
+        /// <summary>
+        /// A cleared queue item, reused if one is pooled
+        /// </summary>
+        public static BatchErrorItem RentItem()
+        {
+            lock (_poolLock)
+            {
+                if (_itemPool.Count > 0)
+                {
+                    _itemsReused++;
+                    return _itemPool.Pop();
+                }
+            }
+
+            Interlocked.Increment(ref _itemsCreated);
+            return new BatchErrorItem();
+        }
+
+        /// <summary>
+        /// Return the arena and its items once nothing refers to them any more. Later calls are ignored.
+        /// </summary>
+        public void Release()
+        {
+            if (!_rented) return;
+            _rented = false;
+            Interlocked.Decrement(ref _arenasInUse);
+
+            Buffer.Clear();
+            var keepBuffer = Buffer.Capacity <= MaxPooledBufferChars;
+
+            lock (_poolLock)
+            {
+                foreach (var item in Items)
+                {
+                    if (_itemPool.Count >= MaxPooledItems) break;
+                    ClearItem(item);
+                    _itemPool.Push(item);
+                }
+
+                if (keepBuffer && _arenaPool.Count < MaxPooledArenas)
+                {
+                    _arenaPool.Push(this);
+                }
+            }
+            Items.Clear();
+        }
+
+        public static PayloadArenaStats GetStats()
+        {
+            long bufferChars = 0;
+            lock (_poolLock)
+            {
+                foreach (var arena in _arenaPool)
+                {
+                    bufferChars += arena.Buffer.Capacity;
+                }
+            }
+
+            return new PayloadArenaStats
+            {
+                arenasCreated = Interlocked.Read(ref _arenasCreated),
+                arenasRented = Interlocked.Read(ref _arenasRented),
+                arenasInUse = Volatile.Read(ref _arenasInUse),
+                itemsCreated = Interlocked.Read(ref _itemsCreated),
+                itemsReused = Interlocked.Read(ref _itemsReused),
+                pooledBufferChars = bufferChars
+            };
+        }
+
+        // Drop every reference, so pooled items don't keep payload graphs alive
+        private static void ClearItem(BatchErrorItem item)
+        {
+            item.clientErrorId = null;
+            item.errorType = null;
+            item.errorCategory = null;
+            item.errorLevel = null;
+            item.message = null;
+            item.frames = null;
+            item.rawStackTrace = null;
+            item.logTail = null;
+            item.exceptionClass = null;
+            item.faultClass = null;
+            item.fingerprint = null;
+            item.device = null;
+            item.network = null;
+            item.gameState = null;
+            item.appVersion = null;
+            item.buildNumber = null;
+            item.unityVersion = null;
+            item.userId = null;
+            item.sessionId = null;
+            item.breadcrumbs = null;
+            item.timestamp = null;
+            item.networkRequest = null;
+            item.tags = null;
+            item.truncated = null;
+        }
+    }
+}
@@ -0,0 +1,184 @@
+using System;
+using System.Collections.Generic;
+using System.Text;
+
+namespace MoonForge.ErrorTracking
+{
+    /// <summary>
+    /// Keeps encoded errors within a byte budget. An error is encoded as usual; if
+    /// it comes out larger than the budget it is rolled back, the least useful part
+    /// that is left is cut, and it is encoded again, until it fits or nothing more
+    /// can go. Parts are cut in this order:
+    ///   1. gameState.customData
+    ///   2. breadcrumbs, oldest first, halving each time
+    ///   3. rawStackTrace, then logTail, cut to the size still needed
+    ///   4. frames past the first <see cref="KeptFrames"/>
+    ///   5. tags
+    ///   6. message
+    /// Every cut is listed in the item's "truncated" field. Text is cut on character
+    /// boundaries, so the result is always valid UTF-8.
+    ///
+    /// Only the item is changed: shared objects (game state, lists) are replaced
+    /// with trimmed copies, never modified in place.
+    /// </summary>
+    public static class PayloadBudget
+    {
+        /// <summary>
+        /// Frames kept when frames have to be cut; the innermost ones
+        /// </summary>
+        public const int KeptFrames = 64;
+
+        private const int StepCount = 7;
+
+        /// <summary>
+        /// Encode <paramref name="item"/> into <paramref name="sb"/>, trimming it first if
+        /// its encoding would exceed <paramref name="maxBytes"/> (0 means no limit).
+        /// Returns the UTF-8 size of what was appended; the item's frames and strings
+        /// are added to <paramref name="frameTable"/> as usual.
+        /// </summary>
+        public static int AppendItem(StringBuilder sb, BatchErrorItem item, BatchFrameTable frameTable, int maxBytes)
+        {
+            var start = sb.Length;
+            var checkpoint = frameTable?.GetCheckpoint() ?? default;
+            WirePayloadEncoder.Append(sb, item, frameTable);
+            var size = Utf8Length(sb, start);
+            if (maxBytes <= 0 || item == null) return size;
+
+            var step = 0;
+            while (size > maxBytes && step < StepCount)
+            {
+                if (!Cut(item, step, size - maxBytes))
+                {
+                    step++;
+                    continue;
+                }
+
+                // Frames that were cut must not stay behind in the batch tables
+                sb.Length = start;
+                frameTable?.Rollback(checkpoint);
+                WirePayloadEncoder.Append(sb, item, frameTable);
+                size = Utf8Length(sb, start);
+            }
+            return size;
+        }
+
+        /// <summary>
+        /// UTF-8 size of <paramref name="sb"/> from <paramref name="start"/> on
+        /// </summary>
+        public static int Utf8Length(StringBuilder sb, int start)
+        {
+            var bytes = 0;
+            var offset = 0;
+            foreach (var chunk in sb.GetChunks())
+            {
+                var span = chunk.Span;
+                var from = Math.Max(0, start - offset);
+                offset += span.Length;
+                for (var i = from; i < span.Length; i++)
+                {
+                    var c = span[i];
+                    // A surrogate pair is 4 bytes, 2 per half
+                    bytes += c < 0x80 ? 1 : c < 0x800 || char.IsSurrogate(c) ? 2 : 3;
+                }
+            }
+            return bytes;
+        }
+
+        // Cut a bit more of the item; false when this step has nothing left to cut
+        private static bool Cut(BatchErrorItem item, int step, int excess)
+        {
+            switch (step)
+            {
+                case 0:
+                    return CutCustomData(item);
+                case 1:
+                    return CutBreadcrumbs(item);
+                case 2:
+                    return CutText(item, "rawStackTrace", ref item.rawStackTrace, excess);
+                case 3:
+                    return CutText(item, "logTail", ref item.logTail, excess);
+                case 4:
+                    return CutFrames(item);
+                case 5:
+                    return CutTags(item);
+                default:
+                    return CutText(item, "message", ref item.message, excess);
+            }
+        }
+
+        private static bool CutCustomData(BatchErrorItem item)
+        {
+            var state = item.gameState;
+            if (state?.customData == null || state.customData.Count == 0) return false;
+
+            Record(item, "gameState.customData", state.customData.Count, 0);
+            item.gameState = new GameState
+            {
+                sceneName = state.sceneName,
+                gameMode = state.gameMode,
+                levelId = state.levelId
+            };
+            return true;
+        }
+
+        private static bool CutBreadcrumbs(BatchErrorItem item)
+        {
+            var breadcrumbs = item.breadcrumbs;
+            if (breadcrumbs == null || breadcrumbs.Count == 0) return false;
+
+            // Oldest first, so the newest half is the tail
+            var kept = breadcrumbs.Count / 2;
+            Record(item, "breadcrumbs", breadcrumbs.Count, kept);
+            item.breadcrumbs = kept > 0 ? breadcrumbs.GetRange(breadcrumbs.Count - kept, kept) : null;
+            return true;
+        }
+
+        private static bool CutFrames(BatchErrorItem item)
+        {
+            var frames = item.frames;
+            if (frames == null || frames.Count <= KeptFrames) return false;
+
+            Record(item, "frames", frames.Count, KeptFrames);
+            item.frames = frames.GetRange(0, KeptFrames);
+            return true;
+        }
+
+        private static bool CutTags(BatchErrorItem item)
+        {
+            if (item.tags == null || item.tags.Count == 0) return false;
+
+            Record(item, "tags", item.tags.Count, 0);
+            item.tags = null;
+            return true;
+        }
+
+        private static bool CutText(BatchErrorItem item, string field, ref string text, int excess)
+        {
+            var bytes = WirePayloadEncoder.EncodedByteCount(text);
+            if (bytes == 0) return false;
+
+            var cut = WirePayloadEncoder.CutToEncodedBytes(text, Math.Max(0, bytes - excess));
+            Record(item, field, bytes, WirePayloadEncoder.EncodedByteCount(cut));
+            text = cut;
+            return true;
+        }
+
+        // Cutting the same field again updates its entry, keeping the original size
+        private static void Record(BatchErrorItem item, string field, int original, int kept)
+        {
+            if (item.truncated == null)
+                item.truncated = new List<PayloadTruncation>();
+
+            foreach (var entry in item.truncated)
+            {
+                if (entry.field == field)
+                {
+                    entry.kept = kept;
+                    return;
+                }
+            }
+
+            item.truncated.Add(new PayloadTruncation { field = field, original = original, kept = kept });
+        }
+    }
+}
@@ -0,0 +1,207 @@
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.Text;
+
+namespace MoonForge.ErrorTracking
+{
+    /// <summary>
+    /// JSON encoder for the wire models. The per-model Append methods are generated
+    /// from ErrorPayload.cs into WirePayloadEncoder.g.cs (MoonForge > Developer >
+    /// Regenerate Wire Codecs); this part holds the primitives they call and the
+    /// free-form values (dictionaries) that have no fixed schema.
+    /// </summary>
+    public static partial class WirePayloadEncoder
+    {
+        /// <summary>
+        /// Escaped JSON string content without quotes; null becomes ""
+        /// </summary>
+        public static string Escape(string str)
+        {
+            if (string.IsNullOrEmpty(str))
+                return "";
+
+            var sb = new StringBuilder(str.Length);
+            AppendEscaped(sb, str);
+            return sb.ToString();
+        }
+
+        /// <summary>
+        /// Append a quoted, escaped JSON string; null is written as ""
+        /// </summary>
+        public static void AppendString(StringBuilder sb, string str)
+        {
+            sb.Append('"');
+            if (!string.IsNullOrEmpty(str))
+                AppendEscaped(sb, str);
+            sb.Append('"');
+        }
+
+        /// <summary>
+        /// UTF-8 size of the escaped string content without quotes, as AppendString writes it
+        /// </summary>
+        public static int EncodedByteCount(string str)
+        {
+            if (string.IsNullOrEmpty(str))
+                return 0;
+
+            var bytes = 0;
+            for (var i = 0; i < str.Length; i++)
+            {
+                bytes += EncodedCharBytes(str, i);
+            }
+            return bytes;
+        }
+
+        /// <summary>
+        /// Longest prefix of <paramref name="str"/> whose escaped content fits in
+        /// <paramref name="maxBytes"/> UTF-8 bytes. Never ends inside a surrogate pair.
+        /// </summary>
+        public static string CutToEncodedBytes(string str, int maxBytes)
+        {
+            if (string.IsNullOrEmpty(str))
+                return str;
+
+            var bytes = 0;
+            var i = 0;
+            while (i < str.Length)
+            {
+                var n = EncodedCharBytes(str, i);
+                if (bytes + n > maxBytes) break;
+                bytes += n;
+                // A pair is counted once, on its high surrogate
+                i += n == 4 && char.IsHighSurrogate(str[i]) ? 2 : 1;
+            }
+            return i == str.Length ? str : str.Substring(0, i);
+        }
+
+        // Escaped UTF-8 bytes of str[i]; 4 for a whole surrogate pair on its high half,
+        // and an unpaired surrogate as the 3-byte replacement character
+        private static int EncodedCharBytes(string str, int i)
+        {
+            var c = str[i];
+            if (c < 0x80)
+            {
+                switch (c)
+                {
+                    case '"':
+                    case '\\':
+                    case '\b':
+                    case '\f':
+                    case '\n':
+                    case '\r':
+                    case '\t':
+                        return 2;
+                    default:
+                        return c < ' ' ? 6 : 1;
+                }
+            }
+            if (c < 0x800) return 2;
+            if (char.IsHighSurrogate(c) && i + 1 < str.Length && char.IsLowSurrogate(str[i + 1])) return 4;
+            if (char.IsLowSurrogate(c) && i > 0 && char.IsHighSurrogate(str[i - 1])) return 0;
+            return 3;
+        }
+
+        private static void AppendEscaped(StringBuilder sb, string str)
+        {
+            foreach (char c in str)
+            {
+                switch (c)
+                {
+                    case '"': sb.Append("\\\""); break;
+                    case '\\': sb.Append("\\\\"); break;
+                    case '\b': sb.Append("\\b"); break;
+                    case '\f': sb.Append("\\f"); break;
+                    case '\n': sb.Append("\\n"); break;
+                    case '\r': sb.Append("\\r"); break;
+                    case '\t': sb.Append("\\t"); break;
+                    default:
+                        if (c < ' ')
+                            sb.Append("\\u").Append(((int)c).ToString("X4"));
+                        else
+                            sb.Append(c);
+                        break;
+                }
+            }
+        }
+
+        private static void AppendFloat(StringBuilder sb, float value)
+        {
+            Span<char> buffer = stackalloc char[32];
+            if (value.TryFormat(buffer, out var written, default, CultureInfo.InvariantCulture))
+                sb.Append(buffer.Slice(0, written));
+            else
+                sb.Append(value.ToString(CultureInfo.InvariantCulture));
+        }
+
+        private static void AppendBool(StringBuilder sb, bool value)
+        {
+            sb.Append(value ? "true" : "false");
+        }
+
+        private static void AppendStringDictionary(StringBuilder sb, Dictionary<string, string> dict)
+        {
+            sb.Append('{');
+            var first = true;
+            foreach (var kvp in dict)
+            {
+                if (!first) sb.Append(',');
+                AppendString(sb, kvp.Key);
+                sb.Append(':');
+                AppendString(sb, kvp.Value);
+                first = false;
+            }
+            sb.Append('}');
+        }
+
+        private static void AppendObjectDictionary(StringBuilder sb, Dictionary<string, object> dict)
+        {
+            sb.Append('{');
+            var first = true;
+            foreach (var kvp in dict)
+            {
+                if (!first) sb.Append(',');
+                AppendString(sb, kvp.Key);
+                sb.Append(':');
+                AppendValue(sb, kvp.Value);
+                first = false;
+            }
+            sb.Append('}');
+        }
+
+        private static void AppendValue(StringBuilder sb, object value)
+        {
+            switch (value)
+            {
+                case null:
+                    sb.Append("null");
+                    break;
+                case bool b:
+                    AppendBool(sb, b);
+                    break;
+                case int i:
+                    sb.Append(i);
+                    break;
+                case long l:
+                    sb.Append(l);
+                    break;
+                case float f:
+                    AppendFloat(sb, f);
+                    break;
+                case double d:
+                    sb.Append(d.ToString(CultureInfo.InvariantCulture));
+                    break;
+                case string s:
+                    AppendString(sb, s);
+                    break;
+                case Dictionary<string, object> dict:
+                    AppendObjectDictionary(sb, dict);
+                    break;
+                default:
+                    // Default to string representation
+                    AppendString(sb, value.ToString());
+                    break;
+            }
+        }
+    }
+}
@@ -0,0 +1,649 @@
+// <auto-generated>
+// Generated by MoonForge > Developer > Regenerate Wire Codecs from the models in
+// Runtime/Models/ErrorPayload.cs. Do not edit by hand.
+// </auto-generated>
+
+using System.Text;
+
+namespace MoonForge.ErrorTracking
+{
+    public static partial class WirePayloadEncoder
+    {
+        public static void Append(StringBuilder sb, StackFrame value)
+        {
+            if (value == null)
+            {
+                sb.Append("null");
+                return;
+            }
+
+            var separator = '{';
+            if (!string.IsNullOrEmpty(value.module))
+            {
+                sb.Append(separator).Append("\"module\":");
+                AppendString(sb, value.module);
+                separator = ',';
+            }
+            if (!string.IsNullOrEmpty(value.function))
+            {
+                sb.Append(separator).Append("\"function\":");
+                AppendString(sb, value.function);
+                separator = ',';
+            }
+            if (!string.IsNullOrEmpty(value.filename))
+            {
+                sb.Append(separator).Append("\"filename\":");
+                AppendString(sb, value.filename);
+                separator = ',';
+            }
+            if (value.lineno > 0)
+            {
+                sb.Append(separator).Append("\"lineno\":");
+                sb.Append(value.lineno);
+                separator = ',';
+            }
+            if (value.colno > 0)
+            {
+                sb.Append(separator).Append("\"colno\":");
+                sb.Append(value.colno);
+                separator = ',';
+            }
+            if (!string.IsNullOrEmpty(value.instructionAddress))
+            {
+                sb.Append(separator).Append("\"instructionAddress\":");
+                AppendString(sb, value.instructionAddress);
+                separator = ',';
+            }
+            if (!string.IsNullOrEmpty(value.symbolAddress))
+            {
+                sb.Append(separator).Append("\"symbolAddress\":");
+                AppendString(sb, value.symbolAddress);
+                separator = ',';
+            }
+            if (value.inApp)
+            {
+                sb.Append(separator).Append("\"inApp\":");
+                AppendBool(sb, value.inApp);
+                separator = ',';
+            }
+            if (!string.IsNullOrEmpty(value.package))
+            {
+                sb.Append(separator).Append("\"package\":");
+                AppendString(sb, value.package);
+                separator = ',';
+            }
+            if (separator == '{') sb.Append('{');
+            sb.Append('}');
+        }
+
+        public static void Append(StringBuilder sb, ThreadCpuUsage value)
+        {
+            if (value == null)
+            {
+                sb.Append("null");
+                return;
+            }
+
+            sb.Append("{\"tid\":");
+            sb.Append(value.tid);
+            sb.Append(",\"name\":");
+            AppendString(sb, value.name);
+            sb.Append(",\"cpuPercent\":");
+            AppendFloat(sb, value.cpuPercent);
+            sb.Append(",\"cpuTimeMs\":");
+            sb.Append(value.cpuTimeMs);
+            sb.Append('}');
+        }
+
+        public static void Append(StringBuilder sb, CpuClusterFrequency value)
+        {
+            if (value == null)
+            {
+                sb.Append("null");
+                return;
+            }
+
+            sb.Append("{\"cpu\":");
+            sb.Append(value.cpu);
+            sb.Append(",\"curKhz\":");
+            sb.Append(value.curKhz);
+            sb.Append(",\"maxKhz\":");
+            sb.Append(value.maxKhz);
+            sb.Append(",\"capKhz\":");
+            sb.Append(value.capKhz);
+            sb.Append('}');
+        }
+
+        public static void Append(StringBuilder sb, DeviceContext value)
+        {
+            if (value == null)
+            {
+                sb.Append("null");
+                return;
+            }
+
+            sb.Append("{\"platform\":");
+            AppendString(sb, value.platform);
+            sb.Append(",\"osVersion\":");
+            AppendString(sb, value.osVersion);
+            sb.Append(",\"deviceModel\":");
+            AppendString(sb, value.deviceModel);
+            if (!string.IsNullOrEmpty(value.manufacturer))
+            {
+                sb.Append(",\"manufacturer\":");
+                AppendString(sb, value.manufacturer);
+            }
+            if (!string.IsNullOrEmpty(value.cpuArchitecture))
+            {
+                sb.Append(",\"cpuArchitecture\":");
+                AppendString(sb, value.cpuArchitecture);
+            }
+            if (value.memoryUsedMb.HasValue)
+            {
+                sb.Append(",\"memoryUsedMb\":");
+                AppendFloat(sb, value.memoryUsedMb.Value);
+            }
+            if (value.memoryAvailableMb.HasValue)
+            {
+                sb.Append(",\"memoryAvailableMb\":");
+                AppendFloat(sb, value.memoryAvailableMb.Value);
+            }
+            if (value.cpuUsagePercent.HasValue)
+            {
+                sb.Append(",\"cpuUsagePercent\":");
+                AppendFloat(sb, value.cpuUsagePercent.Value);
+            }
+            if (value.threadCpu != null && value.threadCpu.Count > 0)
+            {
+                sb.Append(",\"threadCpu\":");
+                sb.Append('[');
+                for (var i = 0; i < value.threadCpu.Count; i++)
+                {
+                    if (i > 0) sb.Append(',');
+                    Append(sb, value.threadCpu[i]);
+                }
+                sb.Append(']');
+            }
+            if (value.fps.HasValue)
+            {
+                sb.Append(",\"fps\":");
+                AppendFloat(sb, value.fps.Value);
+            }
+            if (value.batteryLevel.HasValue)
+            {
+                sb.Append(",\"batteryLevel\":");
+                AppendFloat(sb, value.batteryLevel.Value);
+            }
+            if (value.batteryCharging.HasValue)
+            {
+                sb.Append(",\"batteryCharging\":");
+                AppendBool(sb, value.batteryCharging.Value);
+            }
+            if (!string.IsNullOrEmpty(value.thermalState))
+            {
+                sb.Append(",\"thermalState\":");
+                AppendString(sb, value.thermalState);
+            }
+            if (value.temperatureC.HasValue)
+            {
+                sb.Append(",\"temperatureC\":");
+                AppendFloat(sb, value.temperatureC.Value);
+            }
+            if (value.cpuFrequencyCapPercent.HasValue)
+            {
+                sb.Append(",\"cpuFrequencyCapPercent\":");
+                AppendFloat(sb, value.cpuFrequencyCapPercent.Value);
+            }
+            if (value.batteryTemperatureC.HasValue)
+            {
+                sb.Append(",\"batteryTemperatureC\":");
+                AppendFloat(sb, value.batteryTemperatureC.Value);
+            }
+            if (value.cpuClusters != null && value.cpuClusters.Count > 0)
+            {
+                sb.Append(",\"cpuClusters\":");
+                sb.Append('[');
+                for (var i = 0; i < value.cpuClusters.Count; i++)
+                {
+                    if (i > 0) sb.Append(',');
+                    Append(sb, value.cpuClusters[i]);
+                }
+                sb.Append(']');
+            }
+            sb.Append('}');
+        }
+
+        public static void Append(StringBuilder sb, NetworkContext value)
+        {
+            if (value == null)
+            {
+                sb.Append("null");
+                return;
+            }
+
+            var separator = '{';
+            if (!string.IsNullOrEmpty(value.type))
+            {
+                sb.Append(separator).Append("\"type\":");
+                AppendString(sb, value.type);
+                separator = ',';
+            }
+            if (!string.IsNullOrEmpty(value.carrier))
+            {
+                sb.Append(separator).Append("\"carrier\":");
+                AppendString(sb, value.carrier);
+                separator = ',';
+            }
+            if (!string.IsNullOrEmpty(value.effectiveType))
+            {
+                sb.Append(separator).Append("\"effectiveType\":");
+                AppendString(sb, value.effectiveType);
+                separator = ',';
+            }
+            if (separator == '{') sb.Append('{');
+            sb.Append('}');
+        }
+
+        public static void Append(StringBuilder sb, GameState value)
+        {
+            if (value == null)
+            {
+                sb.Append("null");
+                return;
+            }
+
+            var separator = '{';
+            if (!string.IsNullOrEmpty(value.sceneName))
+            {
+                sb.Append(separator).Append("\"sceneName\":");
+                AppendString(sb, value.sceneName);
+                separator = ',';
+            }
+            if (!string.IsNullOrEmpty(value.gameMode))
+            {
+                sb.Append(separator).Append("\"gameMode\":");
+                AppendString(sb, value.gameMode);
+                separator = ',';
+            }
+            if (!string.IsNullOrEmpty(value.levelId))
+            {
+                sb.Append(separator).Append("\"levelId\":");
+                AppendString(sb, value.levelId);
+                separator = ',';
+            }
+            if (value.customData != null && value.customData.Count > 0)
+            {
+                sb.Append(separator).Append("\"customData\":");
+                AppendObjectDictionary(sb, value.customData);
+                separator = ',';
+            }
+            if (separator == '{') sb.Append('{');
+            sb.Append('}');
+        }
+
+        public static void Append(StringBuilder sb, Breadcrumb value)
+        {
+            if (value == null)
+            {
+                sb.Append("null");
+                return;
+            }
+
+            sb.Append("{\"type\":");
+            AppendString(sb, value.type);
+            if (!string.IsNullOrEmpty(value.category))
+            {
+                sb.Append(",\"category\":");
+                AppendString(sb, value.category);
+            }
+            if (!string.IsNullOrEmpty(value.message))
+            {
+                sb.Append(",\"message\":");
+                AppendString(sb, value.message);
+            }
+            sb.Append(",\"level\":");
+            AppendString(sb, value.level);
+            if (value.data != null && value.data.Count > 0)
+            {
+                sb.Append(",\"data\":");
+                AppendObjectDictionary(sb, value.data);
+            }
+            sb.Append(",\"timestamp\":");
+            sb.Append(value.timestamp);
+            sb.Append('}');
+        }
+
+        public static void Append(StringBuilder sb, NetworkRequest value)
+        {
+            if (value == null)
+            {
+                sb.Append("null");
+                return;
+            }
+
+            sb.Append("{\"url\":");
+            AppendString(sb, value.url);
+            sb.Append(",\"method\":");
+            AppendString(sb, value.method);
+            if (value.statusCode.HasValue)
+            {
+                sb.Append(",\"statusCode\":");
+                sb.Append(value.statusCode.Value);
+            }
+            if (value.durationMs.HasValue)
+            {
+                sb.Append(",\"durationMs\":");
+                AppendFloat(sb, value.durationMs.Value);
+            }
+            if (value.requestHeaders != null && value.requestHeaders.Count > 0)
+            {
+                sb.Append(",\"requestHeaders\":");
+                AppendStringDictionary(sb, value.requestHeaders);
+            }
+            if (value.responseHeaders != null && value.responseHeaders.Count > 0)
+            {
+                sb.Append(",\"responseHeaders\":");
+                AppendStringDictionary(sb, value.responseHeaders);
+            }
+            sb.Append('}');
+        }
+
+        public static void Append(StringBuilder sb, ErrorPayloadInner value, BatchFrameTable frameTable = null)
+        {
+            if (value == null)
+            {
+                sb.Append("null");
+                return;
+            }
+
+            var separator = '{';
+            if (!string.IsNullOrEmpty(value.game))
+            {
+                sb.Append(separator).Append("\"game\":");
+                AppendString(sb, value.game);
+                separator = ',';
+            }
+            sb.Append(separator).Append("\"errorType\":");
+            AppendString(sb, value.errorType);
+            sb.Append(",\"errorCategory\":");
+            AppendString(sb, value.errorCategory);
+            sb.Append(",\"errorLevel\":");
+            AppendString(sb, value.errorLevel);
+            sb.Append(",\"message\":");
+            AppendString(sb, value.message);
+            if (value.frames != null && value.frames.Count > 0)
+            {
+                if (frameTable != null)
+                {
+                    sb.Append(",\"frameRefs\":");
+                    frameTable.AppendFrameRefs(sb, value.frames);
+                }
+                else
+                {
+                    sb.Append(",\"frames\":");
+                    sb.Append('[');
+                    for (var i = 0; i < value.frames.Count; i++)
+                    {
+                        if (i > 0) sb.Append(',');
+                        Append(sb, value.frames[i]);
+                    }
+                    sb.Append(']');
+                }
+            }
+            if (!string.IsNullOrEmpty(value.rawStackTrace))
+            {
+                sb.Append(",\"rawStackTrace\":");
+                AppendString(sb, value.rawStackTrace);
+            }
+            if (!string.IsNullOrEmpty(value.logTail))
+            {
+                sb.Append(",\"logTail\":");
+                AppendString(sb, value.logTail);
+            }
+            if (!string.IsNullOrEmpty(value.exceptionClass))
+            {
+                sb.Append(",\"exceptionClass\":");
+                AppendString(sb, value.exceptionClass);
+            }
+            if (!string.IsNullOrEmpty(value.faultClass))
+            {
+                sb.Append(",\"faultClass\":");
+                AppendString(sb, value.faultClass);
+            }
+            if (!string.IsNullOrEmpty(value.fingerprint))
+            {
+                sb.Append(",\"fingerprint\":");
+                AppendString(sb, value.fingerprint);
+            }
+            if (value.device != null)
+            {
+                sb.Append(",\"device\":");
+                Append(sb, value.device);
+            }
+            if (value.network != null)
+            {
+                sb.Append(",\"network\":");
+                Append(sb, value.network);
+            }
+            if (value.gameState != null)
+            {
+                sb.Append(",\"gameState\":");
+                Append(sb, value.gameState);
+            }
+            sb.Append(",\"appVersion\":");
+            AppendString(sb, value.appVersion);
+            sb.Append(",\"buildNumber\":");
+            AppendString(sb, value.buildNumber);
+            if (!string.IsNullOrEmpty(value.unityVersion))
+            {
+                sb.Append(",\"unityVersion\":");
+                AppendString(sb, value.unityVersion);
+            }
+            if (!string.IsNullOrEmpty(value.userId))
+            {
+                sb.Append(",\"userId\":");
+                AppendString(sb, value.userId);
+            }
+            if (!string.IsNullOrEmpty(value.sessionId))
+            {
+                sb.Append(",\"sessionId\":");
+                AppendString(sb, value.sessionId);
+            }
+            if (value.breadcrumbs != null && value.breadcrumbs.Count > 0)
+            {
+                sb.Append(",\"breadcrumbs\":");
+                sb.Append('[');
+                for (var i = 0; i < value.breadcrumbs.Count; i++)
+                {
+                    if (i > 0) sb.Append(',');
+                    Append(sb, value.breadcrumbs[i]);
+                }
+                sb.Append(']');
+            }
+            if (value.timestamp.HasValue)
+            {
+                sb.Append(",\"timestamp\":");
+                sb.Append(value.timestamp.Value);
+            }
+            if (value.networkRequest != null)
+            {
+                sb.Append(",\"networkRequest\":");
+                Append(sb, value.networkRequest);
+            }
+            if (value.tags != null && value.tags.Count > 0)
+            {
+                sb.Append(",\"tags\":");
+                AppendStringDictionary(sb, value.tags);
+            }
+            sb.Append('}');
+        }
+
+        public static void Append(StringBuilder sb, ErrorPayload value, BatchFrameTable frameTable = null)
+        {
+            if (value == null)
+            {
+                sb.Append("null");
+                return;
+            }
+
+            sb.Append("{\"type\":");
+            AppendString(sb, value.type);
+            sb.Append(",\"payload\":");
+            Append(sb, value.payload, frameTable);
+            sb.Append('}');
+        }
+
+        public static void Append(StringBuilder sb, PayloadTruncation value)
+        {
+            if (value == null)
+            {
+                sb.Append("null");
+                return;
+            }
+
+            sb.Append("{\"field\":");
+            AppendString(sb, value.field);
+            sb.Append(",\"original\":");
+            sb.Append(value.original);
+            sb.Append(",\"kept\":");
+            sb.Append(value.kept);
+            sb.Append('}');
+        }
+
+        public static void Append(StringBuilder sb, BatchErrorItem value, BatchFrameTable frameTable = null)
+        {
+            if (value == null)
+            {
+                sb.Append("null");
+                return;
+            }
+
+            sb.Append("{\"clientErrorId\":");
+            AppendString(sb, value.clientErrorId);
+            sb.Append(",\"errorType\":");
+            AppendString(sb, value.errorType);
+            sb.Append(",\"errorCategory\":");
+            AppendString(sb, value.errorCategory);
+            sb.Append(",\"errorLevel\":");
+            AppendString(sb, value.errorLevel);
+            sb.Append(",\"message\":");
+            AppendString(sb, value.message);
+            if (value.frames != null && value.frames.Count > 0)
+            {
+                if (frameTable != null)
+                {
+                    sb.Append(",\"frameRefs\":");
+                    frameTable.AppendFrameRefs(sb, value.frames);
+                }
+                else
+                {
+                    sb.Append(",\"frames\":");
+                    sb.Append('[');
+                    for (var i = 0; i < value.frames.Count; i++)
+                    {
+                        if (i > 0) sb.Append(',');
+                        Append(sb, value.frames[i]);
+                    }
+                    sb.Append(']');
+                }
+            }
+            if (!string.IsNullOrEmpty(value.rawStackTrace))
+            {
+                sb.Append(",\"rawStackTrace\":");
+                AppendString(sb, value.rawStackTrace);
+            }
+            if (!string.IsNullOrEmpty(value.logTail))
+            {
+                sb.Append(",\"logTail\":");
+                AppendString(sb, value.logTail);
+            }
+            if (!string.IsNullOrEmpty(value.exceptionClass))
+            {
+                sb.Append(",\"exceptionClass\":");
+                AppendString(sb, value.exceptionClass);
+            }
+            if (!string.IsNullOrEmpty(value.faultClass))
+            {
+                sb.Append(",\"faultClass\":");
+                AppendString(sb, value.faultClass);
+            }
+            if (!string.IsNullOrEmpty(value.fingerprint))
+            {
+                sb.Append(",\"fingerprint\":");
+                AppendString(sb, value.fingerprint);
+            }
+            if (value.device != null)
+            {
+                sb.Append(",\"device\":");
+                Append(sb, value.device);
+            }
+            if (value.network != null)
+            {
+                sb.Append(",\"network\":");
+                Append(sb, value.network);
+            }
+            if (value.gameState != null)
+            {
+                sb.Append(",\"gameState\":");
+                Append(sb, value.gameState);
+            }
+            sb.Append(",\"appVersion\":");
+            AppendString(sb, value.appVersion);
+            sb.Append(",\"buildNumber\":");
+            AppendString(sb, value.buildNumber);
+            if (!string.IsNullOrEmpty(value.unityVersion))
+            {
+                sb.Append(",\"unityVersion\":");
+                AppendString(sb, value.unityVersion);
+            }
+            if (!string.IsNullOrEmpty(value.userId))
+            {
+                sb.Append(",\"userId\":");
+                AppendString(sb, value.userId);
+            }
+            if (!string.IsNullOrEmpty(value.sessionId))
+            {
+                sb.Append(",\"sessionId\":");
+                AppendString(sb, value.sessionId);
+            }
+            if (value.breadcrumbs != null && value.breadcrumbs.Count > 0)
+            {
+                sb.Append(",\"breadcrumbs\":");
+                sb.Append('[');
+                for (var i = 0; i < value.breadcrumbs.Count; i++)
+                {
+                    if (i > 0) sb.Append(',');
+                    Append(sb, value.breadcrumbs[i]);
+                }
+                sb.Append(']');
+            }
+            if (value.timestamp.HasValue)
+            {
+                sb.Append(",\"timestamp\":");
+                sb.Append(value.timestamp.Value);
+            }
+            if (value.networkRequest != null)
+            {
+                sb.Append(",\"networkRequest\":");
+                Append(sb, value.networkRequest);
+            }
+            if (value.tags != null && value.tags.Count > 0)
+            {
+                sb.Append(",\"tags\":");
+                AppendStringDictionary(sb, value.tags);
+            }
+            if (value.truncated != null && value.truncated.Count > 0)
+            {
+                sb.Append(",\"truncated\":");
+                sb.Append('[');
+                for (var i = 0; i < value.truncated.Count; i++)
+                {
+                    if (i > 0) sb.Append(',');
+                    Append(sb, value.truncated[i]);
+                }
+                sb.Append(']');
+            }
+            sb.Append('}');
+        }
+    }
+}
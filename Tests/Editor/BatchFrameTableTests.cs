@@ -0,0 +1,281 @@
+using System;
+using System.Collections.Generic;
+using System.Net.Http;
+using System.Text;
+using MoonForge.ErrorTracking.Editor;
+using NUnit.Framework;
+using UnityEngine;
+
+namespace MoonForge.ErrorTracking.Tests
+{
+    public class BatchFrameTableTests
+    {
+        private const string GameId = "3f2504e0-4f89-11d3-9a0c-0305e82c3301";
+
+        // The compact batch as a backend reads it
+        [Serializable]
+        private class EncodedBatch
+        {
+            public List<EncodedItem> errors;
+            public List<string> strings;
+            public List<EncodedFrame> frameTable;
+        }
+
+        [Serializable]
+        private class EncodedItem
+        {
+            public int[] frameRefs;
+        }
+
+        [Serializable]
+        private class EncodedFrame
+        {
+            public int module;
+            public int function;
+            public int filename;
+            public int lineno;
+            public int colno;
+            public int instructionAddress;
+            public int symbolAddress;
+            public bool inApp;
+            public int package;
+        }
+
+        private static List<StackFrame> Stack(int system, int depth)
+        {
+            var frames = new List<StackFrame>();
+            for (var i = 0; i < depth; i++)
+            {
+                frames.Add(new StackFrame
+                {
+                    module = "Assembly-CSharp",
+                    function = $"Game.System{system}.Method{i}",
+                    filename = $"Assets/Scripts/System{i % 5}.cs",
+                    lineno = 10 + i,
+                    inApp = i % 3 == 0
+                });
+            }
+            return frames;
+        }
+
+        private static List<List<StackFrame>> Stacks()
+        {
+            var stacks = new List<List<StackFrame>>();
+            for (var s = 0; s < 4; s++) stacks.Add(Stack(s % 2, 25));
+
+            // Native frames, strings that need escaping, absent fields
+            stacks.Add(new List<StackFrame>
+            {
+                new StackFrame { module = "libil2cpp.so", instructionAddress = "0x7f12a4c0", symbolAddress = "0x7f12a400", package = "com.example.game" },
+                new StackFrame { function = "Über.\"Quoted\"\\Path", filename = "Assets/Scripts/Ünïcödé.cs", lineno = 7, colno = 3 },
+                new StackFrame()
+            });
+            return stacks;
+        }
+
+        private static string Encode(BatchFrameTable table, List<List<StackFrame>> items)
+        {
+            var sb = new StringBuilder("{\"errors\":[");
+            for (var i = 0; i < items.Count; i++)
+            {
+                if (i > 0) sb.Append(',');
+                sb.Append("{\"frameRefs\":");
+                table.AppendFrameRefs(sb, items[i]);
+                sb.Append('}');
+            }
+            sb.Append(']');
+            table.AppendTables(sb, WirePayloadEncoder.Escape);
+            sb.Append('}');
+            return sb.ToString();
+        }
+
+        private static string Resolve(List<string> strings, int index)
+        {
+            return index == 0 ? null : strings[index];
+        }
+
+        private static List<StackFrame> Decode(EncodedBatch batch, int item)
+        {
+            var frames = new List<StackFrame>();
+            foreach (var reference in batch.errors[item].frameRefs)
+            {
+                var entry = batch.frameTable[reference];
+                frames.Add(new StackFrame
+                {
+                    module = Resolve(batch.strings, entry.module),
+                    function = Resolve(batch.strings, entry.function),
+                    filename = Resolve(batch.strings, entry.filename),
+                    lineno = entry.lineno,
+                    colno = entry.colno,
+                    instructionAddress = Resolve(batch.strings, entry.instructionAddress),
+                    symbolAddress = Resolve(batch.strings, entry.symbolAddress),
+                    inApp = entry.inApp,
+                    package = Resolve(batch.strings, entry.package)
+                });
+            }
+            return frames;
+        }
+
+        private static void AssertSameFrames(List<StackFrame> expected, List<StackFrame> actual)
+        {
+            Assert.AreEqual(expected.Count, actual.Count);
+            for (var i = 0; i < expected.Count; i++)
+            {
+                Assert.AreEqual(expected[i].module, actual[i].module);
+                Assert.AreEqual(expected[i].function, actual[i].function);
+                Assert.AreEqual(expected[i].filename, actual[i].filename);
+                Assert.AreEqual(expected[i].lineno, actual[i].lineno);
+                Assert.AreEqual(expected[i].colno, actual[i].colno);
+                Assert.AreEqual(expected[i].instructionAddress, actual[i].instructionAddress);
+                Assert.AreEqual(expected[i].symbolAddress, actual[i].symbolAddress);
+                Assert.AreEqual(expected[i].inApp, actual[i].inApp);
+                Assert.AreEqual(expected[i].package, actual[i].package);
+            }
+        }
+
+        private static List<List<StackFrame>> PickItems(List<List<StackFrame>> stacks, int count)
+        {
+            var random = new System.Random(1);
+            var items = new List<List<StackFrame>>();
+            for (var i = 0; i < count; i++) items.Add(stacks[random.Next(stacks.Count)]);
+            return items;
+        }
+
+        [Test]
+        public void FramesRoundTrip()
+        {
+            var items = PickItems(Stacks(), 20);
+            var table = new BatchFrameTable();
+            var batch = JsonUtility.FromJson<EncodedBatch>(Encode(table, items));
+
+            Assert.AreEqual("", batch.strings[0]);
+            for (var i = 0; i < items.Count; i++)
+            {
+                AssertSameFrames(items[i], Decode(batch, i));
+            }
+        }
+
+        [Test]
+        public void RepeatedFramesAndStringsStoredOnce()
+        {
+            var stacks = Stacks();
+            var table = new BatchFrameTable();
+            Encode(table, PickItems(stacks, 20));
+
+            // Systems 0 and 1 share files and the module; stacks 2 and 3 repeat them
+            var frames = new HashSet<string>();
+            var strings = new HashSet<string>();
+            foreach (var stack in stacks)
+            {
+                foreach (var frame in stack)
+                {
+                    frames.Add(JsonUtility.ToJson(frame));
+                    foreach (var value in new[] { frame.module, frame.function, frame.filename, frame.instructionAddress, frame.symbolAddress, frame.package })
+                    {
+                        if (!string.IsNullOrEmpty(value)) strings.Add(value);
+                    }
+                }
+            }
+
+            Assert.AreEqual(frames.Count, table.FrameCount);
+            Assert.AreEqual(strings.Count + 1, table.StringCount);
+        }
+
+        [Test]
+        public void EncodedBytesMatchesTables()
+        {
+            var table = new BatchFrameTable();
+            Assert.AreEqual(Encoding.UTF8.GetByteCount(Tables(table)), table.EncodedBytes);
+
+            Encode(table, Stacks());
+            Assert.AreEqual(Encoding.UTF8.GetByteCount(Tables(table)), table.EncodedBytes);
+        }
+
+        private static string Tables(BatchFrameTable table)
+        {
+            var sb = new StringBuilder();
+            table.AppendTables(sb, WirePayloadEncoder.Escape);
+            return sb.ToString();
+        }
+
+        [Test]
+        public void RollbackForgetsLaterFrames()
+        {
+            var stacks = Stacks();
+            var table = new BatchFrameTable();
+            var refs = new StringBuilder();
+            table.AppendFrameRefs(refs, stacks[0]);
+
+            var checkpoint = table.GetCheckpoint();
+            var before = Tables(table);
+            var bytesBefore = table.EncodedBytes;
+
+            table.AppendFrameRefs(new StringBuilder(), stacks[1]);
+            table.AppendFrameRefs(new StringBuilder(), stacks[4]);
+            table.Rollback(checkpoint);
+
+            Assert.AreEqual(before, Tables(table));
+            Assert.AreEqual(bytesBefore, table.EncodedBytes);
+
+            // Added again, frames get the indices a fresh table would give them
+            var again = new StringBuilder();
+            table.AppendFrameRefs(again, stacks[4]);
+            var fresh = new BatchFrameTable();
+            fresh.AppendFrameRefs(new StringBuilder(), stacks[0]);
+            var expected = new StringBuilder();
+            fresh.AppendFrameRefs(expected, stacks[4]);
+            Assert.AreEqual(expected.ToString(), again.ToString());
+        }
+
+        private static string BatchBody(List<List<StackFrame>> items, Func<string, string> editRefs)
+        {
+            var table = new BatchFrameTable();
+            var sb = new StringBuilder("{\"type\":\"error_batch\",\"game\":\"" + GameId + "\",\"frameEncoding\":\"table\",\"errors\":[");
+            for (var i = 0; i < items.Count; i++)
+            {
+                if (i > 0) sb.Append(',');
+                var refs = new StringBuilder();
+                table.AppendFrameRefs(refs, items[i]);
+                sb.Append("{\"clientErrorId\":\"item-").Append(i)
+                    .Append("\",\"errorType\":\"exception\",\"errorCategory\":\"managed\",\"errorLevel\":\"error\"")
+                    .Append(",\"message\":\"Test\",\"appVersion\":\"1.0\",\"buildNumber\":\"1\",\"frameRefs\":")
+                    .Append(editRefs(refs.ToString())).Append('}');
+            }
+            sb.Append(']');
+            table.AppendTables(sb, WirePayloadEncoder.Escape);
+            sb.Append('}');
+            return sb.ToString();
+        }
+
+        [Test]
+        public void LocalCollectorDecodesTableBatches()
+        {
+            var collector = new MoonForgeLocalCollector();
+            collector.Start();
+            try
+            {
+                using (var client = new HttpClient())
+                {
+                    var items = PickItems(Stacks(), 10);
+                    var accepted = client.PostAsync(collector.BaseUrl + "/api/errors/batch",
+                        new StringContent(BatchBody(items, refs => refs), Encoding.UTF8, "application/json")).Result;
+                    Assert.AreEqual(200, (int)accepted.StatusCode, accepted.Content.ReadAsStringAsync().Result);
+
+                    // A reference past the end of frameTable
+                    var rejected = client.PostAsync(collector.BaseUrl + "/api/errors/batch",
+                        new StringContent(BatchBody(items, refs => refs.Replace("[0,", "[9999,")), Encoding.UTF8, "application/json")).Result;
+                    Assert.AreEqual(400, (int)rejected.StatusCode);
+                    StringAssert.Contains("references frame 9999", rejected.Content.ReadAsStringAsync().Result);
+                }
+
+                var stats = collector.GetStats();
+                Assert.AreEqual(10, stats.itemsAccepted);
+                Assert.AreEqual(1, stats.rejected);
+            }
+            finally
+            {
+                collector.Stop();
+            }
+        }
+    }
+}
@@ -0,0 +1,149 @@
+using NUnit.Framework;
+
+namespace MoonForge.ErrorTracking.Tests
+{
+    // Fault sections are shaped like the ones the Linux handler wrote for real crashes
+    public class FaultClassifierTests
+    {
+        private static FaultClassifier.MappingRecord Mapping(string start, string end, string perms, string name = "")
+        {
+            return new FaultClassifier.MappingRecord { start = start, end = end, perms = perms, name = name };
+        }
+
+        // Main thread stopped in the game's code, with a data page and a guard page mapped nearby
+        private static FaultClassifier.FaultRecord MainThread(string pc = "0x55b59e74b625", string sp = "0x7ffc37817970")
+        {
+            return new FaultClassifier.FaultRecord
+            {
+                pc = pc,
+                sp = sp,
+                stackStart = "0x7ffc377f9000",
+                stackEnd = "0x7ffc3781a000",
+                maps = new[]
+                {
+                    Mapping("0x55b59e749000", "0x55b59e74b000", "r--p", "/data/app/libgame.so"),
+                    Mapping("0x55b59e74b000", "0x55b59e755000", "r-xp", "/data/app/libgame.so"),
+                    Mapping("0x55b59e755000", "0x55b59e758000", "r--p", "/data/app/libgame.so"),
+                    Mapping("0x7fd836d67000", "0x7fd836d69000", "---p"),
+                    Mapping("0x7fd836d69000", "0x7fd836d6b000", "rw-p"),
+                    Mapping("0x7ffc377f9000", "0x7ffc3781a000", "rw-p", "[stack]")
+                }
+            };
+        }
+
+        [Test]
+        public void LowAddressIsNullDereference()
+        {
+            Assert.AreEqual("null_dereference", FaultClassifier.Classify("SIGSEGV", 1, "0x18", null, MainThread()));
+            Assert.AreEqual("null_dereference", FaultClassifier.Classify("SIGSEGV", null, "(nil)", null, null));
+            Assert.AreEqual("null_dereference", FaultClassifier.Classify("SIGBUS", 2, "0x8", null, null));
+        }
+
+        [Test]
+        public void JumpIntoDataIsExecuteFault()
+        {
+            var fault = MainThread(pc: "0x7fd836d69000");
+            Assert.AreEqual("execute_fault", FaultClassifier.Classify("SIGSEGV", 2, "0x7fd836d69000", null, fault));
+
+            // Into nothing at all, e.g. a corrupt function pointer
+            fault.pc = "0x1234567000";
+            Assert.AreEqual("execute_fault", FaultClassifier.Classify("SIGSEGV", 1, "0x1234567000", null, fault));
+        }
+
+        [Test]
+        public void AccessOutsideAnyMappingIsUnmappedAccess()
+        {
+            Assert.AreEqual("unmapped_access", FaultClassifier.Classify("SIGSEGV", 1, "0x7fd836a58000", null, MainThread()));
+        }
+
+        [Test]
+        public void ForbiddenAccessIsProtectionFault()
+        {
+            // Write to read-only data, and a read of a PROT_NONE page far from the stack
+            Assert.AreEqual("protection_fault", FaultClassifier.Classify("SIGSEGV", 2, "0x55b59e755004", null, MainThread()));
+            Assert.AreEqual("protection_fault", FaultClassifier.Classify("SIGSEGV", 2, "0x7fd836d67064", null, MainThread()));
+        }
+
+        [Test]
+        public void MainThreadOverflowIsStackOverflow()
+        {
+            // sp has left the stack's mapping, so there are no stack bounds
+            var fault = MainThread(sp: "0x7ffc37019e10");
+            fault.stackStart = null;
+            fault.stackEnd = null;
+            Assert.AreEqual("stack_overflow", FaultClassifier.Classify("SIGSEGV", 1, "0x7ffc37019e1c", null, fault));
+        }
+
+        [Test]
+        public void ThreadGuardPageIsStackOverflow()
+        {
+            var fault = new FaultClassifier.FaultRecord
+            {
+                pc = "0x5000000",
+                sp = "0x7000000ff0",
+                stackStart = "0x7000000000",
+                stackEnd = "0x7000001000",
+                maps = new[]
+                {
+                    Mapping("0x7000000000", "0x7000001000", "---p", "[anon:thread stack guard]"),
+                    Mapping("0x7000001000", "0x7000100000", "rw-p", "[anon:stack_and_tls:123]")
+                }
+            };
+            Assert.AreEqual("stack_overflow", FaultClassifier.Classify("SIGSEGV", 2, "0x7000000fe8", null, fault));
+
+            // A large frame skipping far past sp into the guard gap
+            fault.sp = "0x7000001100";
+            fault.stackStart = "0x7000001000";
+            Assert.AreEqual("stack_overflow", FaultClassifier.Classify("SIGSEGV", 2, "0x6ffff80000", null, fault));
+
+            // Too far below the stack to be its guard gap
+            Assert.AreEqual("unmapped_access", FaultClassifier.Classify("SIGSEGV", 1, "0x6f00000000", null, fault));
+        }
+
+        [Test]
+        public void WithoutFaultSectionSiCodeDecides()
+        {
+            // iOS and older records; JsonUtility leaves an empty section behind
+            Assert.AreEqual("unmapped_access", FaultClassifier.Classify("SIGSEGV", 1, "0x7f0000001000", null, new FaultClassifier.FaultRecord()));
+            Assert.AreEqual("protection_fault", FaultClassifier.Classify("SIGSEGV", 2, "0x7f0000001000", null, null));
+            Assert.AreEqual("segmentation_fault", FaultClassifier.Classify("SIGSEGV", null, "0x7f0000001000", null, null));
+            Assert.AreEqual("segmentation_fault", FaultClassifier.Classify("SIGSEGV", 1, "garbage", null, null));
+        }
+
+        [Test]
+        public void OtherSignals()
+        {
+            Assert.AreEqual("abort", FaultClassifier.Classify("SIGABRT", -6, "0x214f", null, MainThread()));
+            Assert.AreEqual("abort_with_message", FaultClassifier.Classify("SIGABRT", -6, "0x214f", "assert failed", null));
+            Assert.AreEqual("signal_sent", FaultClassifier.Classify("SIGSEGV", -6, "0x2153", null, MainThread()));
+            Assert.AreEqual("misaligned_access", FaultClassifier.Classify("SIGBUS", 1, "0x7f0000001001", null, null));
+            Assert.AreEqual("bus_error", FaultClassifier.Classify("SIGBUS", 2, "0x7f0000001000", null, null));
+            Assert.AreEqual("division_by_zero", FaultClassifier.Classify("SIGFPE", 1, "0x55b59e74b724", null, MainThread()));
+            Assert.AreEqual("division_by_zero", FaultClassifier.Classify("SIGFPE", 3, "0x1234567", null, null));
+            Assert.AreEqual("arithmetic_error", FaultClassifier.Classify("SIGFPE", 4, "0x1234567", null, null));
+            Assert.AreEqual("illegal_instruction", FaultClassifier.Classify("SIGILL", 1, "0x1234567", null, null));
+            Assert.AreEqual("trap", FaultClassifier.Classify("SIGTRAP", 1, "0x1234567", null, null));
+            Assert.AreEqual("broken_pipe", FaultClassifier.Classify("SIGPIPE", 0, null, null, null));
+        }
+
+        [Test]
+        public void NotASignalIsNotClassified()
+        {
+            Assert.IsNull(FaultClassifier.Classify(null, null, null, null, null));
+            Assert.IsNull(FaultClassifier.Classify("", 1, "0x18", null, null));
+        }
+
+        [Test]
+        public void AddressesParseInEveryHandlerFormat()
+        {
+            Assert.IsTrue(FaultClassifier.TryParseAddress("0x7F12ab", out var address));
+            Assert.AreEqual(0x7f12abUL, address);
+            Assert.IsTrue(FaultClassifier.TryParseAddress("7f12ab", out address));
+            Assert.AreEqual(0x7f12abUL, address);
+            Assert.IsTrue(FaultClassifier.TryParseAddress("(nil)", out address));
+            Assert.AreEqual(0UL, address);
+            Assert.IsFalse(FaultClassifier.TryParseAddress("", out _));
+            Assert.IsFalse(FaultClassifier.TryParseAddress("0xzz", out _));
+        }
+    }
+}
@@ -0,0 +1,140 @@
+using System.Collections.Generic;
+using System.Linq;
+using System.Reflection;
+using NUnit.Framework;
+
+namespace MoonForge.ErrorTracking.Tests
+{
+    // Samples are shaped like the ones the native sampler reads from sysfs
+    public class NativeDeviceSamplerTests
+    {
+        private static readonly MethodInfo AddChangeBreadcrumbs =
+            typeof(NativeDeviceSampler).GetMethod("AddChangeBreadcrumbs", BindingFlags.NonPublic | BindingFlags.Static);
+        private static readonly FieldInfo Reported =
+            typeof(NativeDeviceSampler).GetField("_reported", BindingFlags.NonPublic | BindingFlags.Static);
+
+        private static NativeDeviceSampler.DeviceState Sample(float temperatureC = 40f, float capPercent = 100f,
+            int batteryPercent = 80, int batteryCharging = 0)
+        {
+            return new NativeDeviceSampler.DeviceState
+            {
+                temperatureC = temperatureC,
+                hottestZone = "cpu-0-0",
+                cpuFrequencyCapPercent = capPercent,
+                batteryPercent = batteryPercent,
+                batteryCharging = batteryCharging,
+                batteryTemperatureC = 31.2f,
+                clusters = new[]
+                {
+                    new CpuClusterFrequency { cpu = 0, curKhz = 1000000, maxKhz = 1800000, capKhz = 1800000 },
+                    new CpuClusterFrequency { cpu = 4, curKhz = 1800000, maxKhz = 2400000, capKhz = 1200000 }
+                }
+            };
+        }
+
+        // Breadcrumbs added by this sample
+        private static List<string> Report(NativeDeviceSampler.DeviceState state)
+        {
+            BreadcrumbTracker.Instance.Clear();
+            AddChangeBreadcrumbs.Invoke(null, new object[] { Reported.GetValue(null), state });
+            return BreadcrumbTracker.Instance.GetBreadcrumbs()
+                .Where(crumb => crumb.category == "device")
+                .Select(crumb => crumb.message)
+                .ToList();
+        }
+
+        [SetUp]
+        public void SetUp()
+        {
+            Reported.SetValue(null, null);
+        }
+
+        [TearDown]
+        public void TearDown()
+        {
+            Reported.SetValue(null, null);
+            BreadcrumbTracker.Instance.Clear();
+        }
+
+        [Test]
+        public void ApplyFillsOnlyWhatPlatformApisLeftOpen()
+        {
+            var context = new DeviceContext { batteryLevel = 55, thermalState = "fair" };
+            NativeDeviceSampler.Apply(context, Sample(temperatureC: 50f, capPercent: 50f, batteryCharging: 1));
+
+            Assert.AreEqual(50f, context.temperatureC);
+            Assert.AreEqual(50f, context.cpuFrequencyCapPercent);
+            Assert.AreEqual(31.2f, context.batteryTemperatureC);
+            Assert.AreEqual(2, context.cpuClusters.Count);
+            Assert.AreEqual(4, context.cpuClusters[1].cpu);
+
+            // Unity's battery level and PowerManager's thermal status win
+            Assert.AreEqual(55f, context.batteryLevel);
+            Assert.AreEqual("fair", context.thermalState);
+            Assert.AreEqual(true, context.batteryCharging);
+
+            // Without them, the temperature decides
+            context = new DeviceContext();
+            NativeDeviceSampler.Apply(context, Sample(temperatureC: 50f));
+            Assert.AreEqual(80f, context.batteryLevel);
+            Assert.AreEqual(false, context.batteryCharging);
+            Assert.AreEqual("serious", context.thermalState);
+        }
+
+        [Test]
+        public void UnknownValuesStayUnset()
+        {
+            var context = new DeviceContext();
+            NativeDeviceSampler.Apply(context, new NativeDeviceSampler.DeviceState { clusters = new CpuClusterFrequency[0] });
+
+            Assert.IsNull(context.temperatureC);
+            Assert.IsNull(context.cpuFrequencyCapPercent);
+            Assert.IsNull(context.batteryTemperatureC);
+            Assert.IsNull(context.cpuClusters);
+            Assert.IsNull(context.batteryLevel);
+            Assert.IsNull(context.batteryCharging);
+            Assert.IsNull(context.thermalState);
+        }
+
+        [Test]
+        public void FrequencyCapReportedOnCrossingAndLargeSteps()
+        {
+            Assert.IsEmpty(Report(Sample()));
+
+            CollectionAssert.AreEqual(new[]
+            {
+                "CPU frequency capped at 60% of max at 47°C",
+                "Device temperature 47°C (cpu-0-0)"
+            }, Report(Sample(temperatureC: 47f, capPercent: 60f)));
+
+            // Small moves while throttled are not news
+            Assert.IsEmpty(Report(Sample(temperatureC: 48f, capPercent: 55f)));
+            CollectionAssert.AreEqual(new[] { "CPU frequency capped at 45% of max at 48°C" },
+                Report(Sample(temperatureC: 48f, capPercent: 45f)));
+
+            CollectionAssert.AreEqual(new[] { "CPU frequency cap lifted at 48°C" },
+                Report(Sample(temperatureC: 48f, capPercent: 100f)));
+        }
+
+        [Test]
+        public void ThrottledFirstSampleIsReported()
+        {
+            CollectionAssert.AreEqual(new[] { "CPU frequency capped at 70% of max at 40°C" },
+                Report(Sample(capPercent: 70f)));
+        }
+
+        [Test]
+        public void ChargerAndLowBatteryReported()
+        {
+            Assert.IsEmpty(Report(Sample(batteryPercent: 25, batteryCharging: 1)));
+            CollectionAssert.AreEqual(new[] { "Battery discharging" }, Report(Sample(batteryPercent: 25)));
+
+            CollectionAssert.AreEqual(new[] { "Battery low (19%)" }, Report(Sample(batteryPercent: 19)));
+            Assert.IsEmpty(Report(Sample(batteryPercent: 18)));
+            CollectionAssert.AreEqual(new[] { "Battery low (9%)" }, Report(Sample(batteryPercent: 9)));
+
+            // Charging through a threshold is not low battery
+            CollectionAssert.AreEqual(new[] { "Battery charging" }, Report(Sample(batteryPercent: 4, batteryCharging: 1)));
+        }
+    }
+}
@@ -0,0 +1,108 @@
+using System.Collections.Generic;
+using NUnit.Framework;
+
+namespace MoonForge.ErrorTracking.Tests
+{
+    public class NativeHitchRecorderTests
+    {
+        private static NativeHitchRecorder.HitchEvent Hitch(float durationMs, float cpuTimeMs)
+        {
+            return new NativeHitchRecorder.HitchEvent { durationMs = durationMs, cpuTimeMs = cpuTimeMs };
+        }
+
+        [Test]
+        public void BusyFrameIsCpu()
+        {
+            Assert.AreEqual("cpu", NativeHitchRecorder.ClassifyStall(Hitch(120, 110)));
+        }
+
+        [Test]
+        public void BusyFrameWithManyCacheMissesIsMemory()
+        {
+            var hitch = Hitch(120, 110);
+            hitch.instructions = 1000000;
+            hitch.cacheMisses = 25000;
+            Assert.AreEqual("memory", NativeHitchRecorder.ClassifyStall(hitch));
+
+            hitch.cacheMisses = 5000;
+            Assert.AreEqual("cpu", NativeHitchRecorder.ClassifyStall(hitch));
+        }
+
+        [Test]
+        public void OffCpuFrameWithOwnMajorFaultsIsPageFaults()
+        {
+            var hitch = Hitch(300, 40);
+            hitch.majorFaults = 900;
+            hitch.readBytes = 32 * 1024 * 1024;
+            Assert.AreEqual("page-faults", NativeHitchRecorder.ClassifyStall(hitch));
+        }
+
+        [Test]
+        public void OffCpuFrameDuringStorageReadsIsIo()
+        {
+            // A loader thread read while the main thread waited
+            var hitch = Hitch(300, 40);
+            hitch.majorFaults = 0;
+            hitch.processMajorFaults = 0;
+            hitch.readBytes = 4 * 1024 * 1024;
+            hitch.ioWaitMs = 0;
+            Assert.AreEqual("io", NativeHitchRecorder.ClassifyStall(hitch));
+
+            hitch.readBytes = 0;
+            hitch.ioWaitMs = 150;
+            Assert.AreEqual("io", NativeHitchRecorder.ClassifyStall(hitch));
+
+            hitch.ioWaitMs = 0;
+            hitch.processMajorFaults = 12;
+            Assert.AreEqual("io", NativeHitchRecorder.ClassifyStall(hitch));
+        }
+
+        [Test]
+        public void OffCpuFrameWithoutIoIsBlocked()
+        {
+            // Small reads are not blamed
+            var hitch = Hitch(300, 40);
+            hitch.processMajorFaults = 0;
+            hitch.readBytes = 16 * 1024;
+            hitch.ioWaitMs = 0;
+            Assert.AreEqual("blocked", NativeHitchRecorder.ClassifyStall(hitch));
+
+            // I/O not tracked
+            Assert.AreEqual("blocked", NativeHitchRecorder.ClassifyStall(Hitch(300, 40)));
+        }
+
+        [Test]
+        public void EmptyFrameIsNotClassified()
+        {
+            Assert.IsNull(NativeHitchRecorder.ClassifyStall(Hitch(0, 0)));
+        }
+
+        [Test]
+        public void DescribeIoListsWhatHappened()
+        {
+            var data = new Dictionary<string, object>
+            {
+                { "ioWaitMs", 310L },
+                { "majorFaults", 1820L },
+                { "readBytes", 38L * 1024 * 1024 }
+            };
+            Assert.AreEqual(" (IO wait 310 ms, 1820 major faults, 38.0 MB read)", NativeHitchRecorder.DescribeIo(data));
+
+            data["ioWaitMs"] = 0L;
+            data["majorFaults"] = 0L;
+            Assert.AreEqual(" (38.0 MB read)", NativeHitchRecorder.DescribeIo(data));
+        }
+
+        [Test]
+        public void DescribeIoIsEmptyWithoutIo()
+        {
+            Assert.AreEqual("", NativeHitchRecorder.DescribeIo(null));
+            Assert.AreEqual("", NativeHitchRecorder.DescribeIo(new Dictionary<string, object>
+            {
+                { "ioWaitMs", 0L },
+                { "majorFaults", 0L },
+                { "readBytes", 0L }
+            }));
+        }
+    }
+}
@@ -0,0 +1,130 @@
+using System.Collections.Generic;
+using System.Reflection;
+using NUnit.Framework;
+
+namespace MoonForge.ErrorTracking.Tests
+{
+    // The pools are process-wide, so counters are compared before and after
+    public class PayloadArenaTests
+    {
+        private static BatchErrorItem FilledItem(int index)
+        {
+            var item = PayloadArena.RentItem();
+            item.clientErrorId = "item-" + index;
+            item.errorType = "exception";
+            item.errorCategory = "managed";
+            item.errorLevel = "error";
+            item.message = "Object reference not set";
+            item.frames = new List<StackFrame> { new StackFrame { function = "Game.Update" } };
+            item.rawStackTrace = "at Game.Update()";
+            item.logTail = "log";
+            item.exceptionClass = "NullReferenceException";
+            item.faultClass = "null_dereference";
+            item.fingerprint = "f";
+            item.device = new DeviceContext();
+            item.network = new NetworkContext();
+            item.gameState = new GameState();
+            item.appVersion = "1.0";
+            item.buildNumber = "1";
+            item.unityVersion = "2022.3";
+            item.userId = "user";
+            item.sessionId = "session";
+            item.breadcrumbs = new List<Breadcrumb>();
+            item.timestamp = 1234567890123L;
+            item.networkRequest = new NetworkRequest();
+            item.tags = new Dictionary<string, string> { { "k", "v" } };
+            item.truncated = new List<PayloadTruncation>();
+            return item;
+        }
+
+        [Test]
+        public void ReleasedArenaIsReused()
+        {
+            var arena = PayloadArena.Rent();
+            arena.Buffer.Append("{\"type\":\"error_batch\"}");
+            arena.Release();
+
+            var created = PayloadArena.GetStats().arenasCreated;
+            var again = PayloadArena.Rent();
+            Assert.AreSame(arena, again);
+            Assert.AreEqual(created, PayloadArena.GetStats().arenasCreated);
+            Assert.AreEqual(0, again.Buffer.Length);
+            Assert.AreEqual(0, again.Items.Count);
+            again.Release();
+        }
+
+        [Test]
+        public void ReleasedItemsComeBackCleared()
+        {
+            var arena = PayloadArena.Rent();
+            var item = FilledItem(0);
+            arena.Items.Add(item);
+            arena.Release();
+
+            var reused = PayloadArena.GetStats().itemsReused;
+            Assert.AreSame(item, PayloadArena.RentItem());
+            Assert.AreEqual(reused + 1, PayloadArena.GetStats().itemsReused);
+
+            // Every field, so one added to BatchErrorItem later can't keep a payload alive
+            foreach (var field in typeof(BatchErrorItem).GetFields(BindingFlags.Public | BindingFlags.Instance))
+            {
+                Assert.IsNull(field.GetValue(item), field.Name);
+            }
+        }
+
+        [Test]
+        public void SecondReleaseIsIgnored()
+        {
+            var inUse = PayloadArena.GetStats().arenasInUse;
+            var arena = PayloadArena.Rent();
+            Assert.AreEqual(inUse + 1, PayloadArena.GetStats().arenasInUse);
+
+            arena.Release();
+            arena.Release();
+            Assert.AreEqual(inUse, PayloadArena.GetStats().arenasInUse);
+
+            // Pooled once, so two rents get two arenas
+            var first = PayloadArena.Rent();
+            var second = PayloadArena.Rent();
+            Assert.AreNotSame(first, second);
+            first.Release();
+            second.Release();
+        }
+
+        [Test]
+        public void OversizedBufferIsNotPooled()
+        {
+            var arena = PayloadArena.Rent();
+            arena.Buffer.Append('x', 2 * 1024 * 1024);
+            arena.Release();
+
+            var next = PayloadArena.Rent();
+            Assert.AreNotSame(arena, next);
+            next.Release();
+        }
+
+        [Test]
+        public void SteadyBatchingAllocatesNothingNew()
+        {
+            // Warm up: one batch's worth of items and an arena
+            var warm = PayloadArena.Rent();
+            for (var i = 0; i < 20; i++) warm.Items.Add(FilledItem(i));
+            warm.Release();
+
+            var before = PayloadArena.GetStats();
+            for (var batch = 0; batch < 100; batch++)
+            {
+                var arena = PayloadArena.Rent();
+                for (var i = 0; i < 20; i++) arena.Items.Add(FilledItem(i));
+                arena.Buffer.Append('x', 4096);
+                arena.Release();
+            }
+
+            var after = PayloadArena.GetStats();
+            Assert.AreEqual(before.arenasCreated, after.arenasCreated);
+            Assert.AreEqual(before.itemsCreated, after.itemsCreated);
+            Assert.AreEqual(before.itemsReused + 2000, after.itemsReused);
+            Assert.AreEqual(before.arenasRented + 100, after.arenasRented);
+        }
+    }
+}
@@ -0,0 +1,281 @@
+using System.Collections;
+using System.Collections.Generic;
+using System.Reflection;
+using System.Text;
+using MoonForge.ErrorTracking.Editor;
+using NUnit.Framework;
+using UnityEngine;
+
+namespace MoonForge.ErrorTracking.Tests
+{
+    public class PayloadBudgetTests
+    {
+        // Throws on a lone surrogate, so a cut inside a pair shows up
+        private static readonly UTF8Encoding StrictUtf8 = new UTF8Encoding(false, true);
+
+        private List<Breadcrumb> _breadcrumbs;
+        private GameState _gameState;
+
+        [SetUp]
+        public void SetUp()
+        {
+            _breadcrumbs = new List<Breadcrumb>();
+            for (var i = 0; i < 100; i++)
+            {
+                _breadcrumbs.Add(new Breadcrumb(BreadcrumbType.Navigation, "crumb " + i + Repeat(300, "x"), BreadcrumbLevel.Info, "nav"));
+            }
+
+            var customData = new Dictionary<string, object>();
+            for (var i = 0; i < 5000; i++) customData["key" + i] = "value " + i;
+            _gameState = new GameState { sceneName = "Main", customData = customData };
+        }
+
+        private static string Repeat(int length, string unit)
+        {
+            var sb = new StringBuilder();
+            while (sb.Length < length) sb.Append(unit);
+            return sb.ToString();
+        }
+
+        private static BatchErrorItem SmallItem(int index)
+        {
+            return new BatchErrorItem
+            {
+                clientErrorId = "item-" + index,
+                errorType = "exception",
+                errorCategory = "managed",
+                errorLevel = "error",
+                message = "m",
+                appVersion = "1",
+                buildNumber = "2"
+            };
+        }
+
+        // Every trimmable part oversized, with escapes and astral characters throughout
+        private BatchErrorItem LargeItem(int index)
+        {
+            var frames = new List<StackFrame>();
+            for (var i = 0; i < 500; i++)
+            {
+                frames.Add(new StackFrame { module = "Mod" + i % 7, function = "Fn" + i + "😀", filename = "f.cs", lineno = i + 1, inApp = i % 2 == 0 });
+            }
+
+            var item = SmallItem(index);
+            item.message = Repeat(100000, "msg 中文😀 \"q\"\n");
+            item.rawStackTrace = Repeat(400000, "  at Foo.Bar () [0x0001] in <x>:0 é😀\n");
+            item.logTail = Repeat(50000, "log\u0001line😀\n");
+            item.frames = frames;
+            item.gameState = _gameState;
+            item.breadcrumbs = _breadcrumbs;
+            item.tags = new Dictionary<string, string> { { "a", "b" } };
+            return item;
+        }
+
+        private static string Encode(BatchErrorItem item, BatchFrameTable frameTable, int maxBytes, out int size)
+        {
+            var sb = new StringBuilder("[");
+            size = PayloadBudget.AppendItem(sb, item, frameTable, maxBytes);
+            return sb.ToString(1, sb.Length - 1);
+        }
+
+        private static List<string> TruncatedFields(BatchErrorItem item)
+        {
+            var fields = new List<string>();
+            if (item.truncated != null)
+            {
+                foreach (var entry in item.truncated) fields.Add(entry.field);
+            }
+            return fields;
+        }
+
+        [Test]
+        public void ItemUnderBudgetIsUntouched()
+        {
+            var item = SmallItem(0);
+            var expected = new StringBuilder();
+            WirePayloadEncoder.Append(expected, item);
+
+            var json = Encode(item, null, 1024, out var size);
+            Assert.AreEqual(expected.ToString(), json);
+            Assert.AreEqual(StrictUtf8.GetByteCount(json), size);
+            Assert.IsNull(item.truncated);
+        }
+
+        [TestCase(64)]
+        [TestCase(16)]
+        [TestCase(8)]
+        public void LargeItemIsTrimmedToBudget(int budgetKB)
+        {
+            var item = LargeItem(0);
+            var json = Encode(item, null, budgetKB * 1024, out var size);
+
+            Assert.AreEqual(StrictUtf8.GetByteCount(json), size);
+            Assert.LessOrEqual(size, budgetKB * 1024);
+
+            // Still a valid error with its required fields
+            var body = "{\"type\":\"error_batch\",\"game\":\"g\",\"errors\":[" + json + "]}";
+            Assert.IsTrue(WirePayloadDecoder.TryDecode(body, out ErrorBatchPayload batch, out var error), error);
+            Assert.AreEqual("item-0", batch.errors[0].clientErrorId);
+            Assert.AreEqual(item.truncated.Count, batch.errors[0].truncated.Count);
+        }
+
+        [Test]
+        public void PartsAreCutInOrder()
+        {
+            // The message alone is over budget, so every step runs
+            var item = LargeItem(0);
+            Encode(item, null, 64 * 1024, out _);
+            CollectionAssert.AreEqual(new[] { "gameState.customData", "breadcrumbs", "rawStackTrace", "logTail", "frames", "tags", "message" }, TruncatedFields(item));
+            Assert.AreEqual(PayloadBudget.KeptFrames, item.frames.Count);
+            Assert.AreEqual("Fn0😀", item.frames[0].function);
+            Assert.AreEqual("Main", item.gameState.sceneName);
+            Assert.IsNull(item.breadcrumbs);
+
+            // Only custom data too large: nothing else is cut
+            var small = SmallItem(1);
+            small.gameState = _gameState;
+            small.breadcrumbs = _breadcrumbs.GetRange(0, 3);
+            Encode(small, null, 4 * 1024, out _);
+            CollectionAssert.AreEqual(new[] { "gameState.customData" }, TruncatedFields(small));
+            Assert.AreEqual(5000, small.truncated[0].original);
+            Assert.AreEqual(0, small.truncated[0].kept);
+            Assert.AreEqual(3, small.breadcrumbs.Count);
+        }
+
+        [Test]
+        public void NewestBreadcrumbsAreKept()
+        {
+            var item = SmallItem(0);
+            item.breadcrumbs = _breadcrumbs;
+            Encode(item, null, 8 * 1024, out var size);
+
+            Assert.LessOrEqual(size, 8 * 1024);
+            Assert.AreEqual(100, item.truncated[0].original);
+            Assert.AreEqual(item.breadcrumbs.Count, item.truncated[0].kept);
+            Assert.AreSame(_breadcrumbs[99], item.breadcrumbs[item.breadcrumbs.Count - 1]);
+        }
+
+        [Test]
+        public void SharedObjectsAreNotModified()
+        {
+            var first = LargeItem(0);
+            var second = LargeItem(1);
+            Encode(first, null, 2 * 1024, out _);
+            Encode(second, null, 2 * 1024, out _);
+
+            Assert.AreEqual(5000, _gameState.customData.Count);
+            Assert.AreEqual(100, _breadcrumbs.Count);
+            Assert.AreEqual(first.truncated.Count, second.truncated.Count);
+        }
+
+        [Test]
+        public void CutFramesLeaveNoTableEntries()
+        {
+            var table = new BatchFrameTable();
+            Encode(LargeItem(0), table, 64 * 1024, out var size);
+
+            Assert.AreEqual(PayloadBudget.KeptFrames, table.FrameCount);
+            Assert.LessOrEqual(size, 64 * 1024);
+        }
+
+        [Test]
+        public void CutNeverSplitsACharacter()
+        {
+            const string text = "ab😀c\"d中";
+            for (var maxBytes = 0; maxBytes <= WirePayloadEncoder.EncodedByteCount(text) + 1; maxBytes++)
+            {
+                var cut = WirePayloadEncoder.CutToEncodedBytes(text, maxBytes);
+                Assert.DoesNotThrow(() => StrictUtf8.GetByteCount(cut), "cut to " + maxBytes);
+                Assert.LessOrEqual(WirePayloadEncoder.EncodedByteCount(cut), maxBytes);
+                Assert.IsTrue(text.StartsWith(cut));
+            }
+            Assert.AreEqual("ab", WirePayloadEncoder.CutToEncodedBytes(text, 5));
+            Assert.AreEqual("ab😀", WirePayloadEncoder.CutToEncodedBytes(text, 6));
+        }
+
+        [Test]
+        public void Utf8LengthCountsFromStart()
+        {
+            var sb = new StringBuilder();
+            for (var i = 0; i < 2000; i++) sb.Append("aé中😀");
+            var text = sb.ToString();
+
+            Assert.AreEqual(Encoding.UTF8.GetByteCount(text), PayloadBudget.Utf8Length(sb, 0));
+            Assert.AreEqual(Encoding.UTF8.GetByteCount(text.Substring(5001)), PayloadBudget.Utf8Length(sb, 5001));
+            Assert.AreEqual(0, PayloadBudget.Utf8Length(sb, sb.Length));
+        }
+
+        #region Batch Bodies
+
+        private static IList SerializeBatch(ErrorTrackerConfig config, List<BatchErrorItem> items)
+        {
+            var transport = new HttpTransport(config, null);
+            var serialize = typeof(HttpTransport).GetMethod("SerializeBatchPayload", BindingFlags.NonPublic | BindingFlags.Instance);
+            return (IList)serialize.Invoke(transport, new object[] { new ErrorBatchPayload { game = "g", errors = items } });
+        }
+
+        private static T BodyField<T>(object body, string name)
+        {
+            return (T)body.GetType().GetField(name).GetValue(body);
+        }
+
+        [TestCase(false)]
+        [TestCase(true)]
+        public void BatchIsSplitAtBodyBudget(bool compactFrames)
+        {
+            var config = ScriptableObject.CreateInstance<ErrorTrackerConfig>();
+            config.compactBatchFrames = compactFrames;
+            config.maxErrorPayloadKB = 64;
+            config.maxBatchPayloadKB = 512;
+            try
+            {
+                var items = new List<BatchErrorItem>();
+                for (var i = 0; i < 20; i++) items.Add(LargeItem(i));
+
+                var bodies = SerializeBatch(config, items);
+                Assert.Greater(bodies.Count, 1);
+
+                var next = 0;
+                foreach (var body in bodies)
+                {
+                    var json = BodyField<string>(body, "json");
+                    Assert.LessOrEqual(StrictUtf8.GetByteCount(json), 512 * 1024);
+                    Assert.IsTrue(WirePayloadDecoder.TryDecode(json, out ErrorBatchPayload batch, out var error), error);
+
+                    // In order, each error in exactly one body
+                    Assert.AreEqual(BodyField<int>(body, "count"), batch.errors.Count);
+                    foreach (var decoded in batch.errors) Assert.AreEqual("item-" + next++, decoded.clientErrorId);
+                }
+                Assert.AreEqual(items.Count, next);
+            }
+            finally
+            {
+                Object.DestroyImmediate(config);
+            }
+        }
+
+        [Test]
+        public void OversizedFirstItemStillSent()
+        {
+            // An error that can't be trimmed under the body budget goes alone rather than being dropped
+            var config = ScriptableObject.CreateInstance<ErrorTrackerConfig>();
+            config.maxErrorPayloadKB = 0;
+            config.maxBatchPayloadKB = 1;
+            try
+            {
+                var items = new List<BatchErrorItem> { LargeItem(0), SmallItem(1) };
+                var bodies = SerializeBatch(config, items);
+
+                Assert.AreEqual(2, bodies.Count);
+                Assert.AreEqual(1, BodyField<int>(bodies[0], "count"));
+                Assert.AreEqual(1, BodyField<int>(bodies[1], "count"));
+            }
+            finally
+            {
+                Object.DestroyImmediate(config);
+            }
+        }
+
+        #endregion
+    }
+}
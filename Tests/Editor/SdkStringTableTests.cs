@@ -0,0 +1,166 @@
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.Reflection;
+using System.Threading;
+using NUnit.Framework;
+using UnityEngine;
+
+namespace MoonForge.ErrorTracking.Tests
+{
+    public class SdkStringTableTests
+    {
+        private const int ThreadCount = 8;
+        private const int StringsPerTest = 200;
+
+        // The table is process-wide; each test uses strings no other test interns
+        private static string Fresh(string name, int index)
+        {
+            return new string(("SdkStringTableTests." + name + "." + index).ToCharArray());
+        }
+
+        [Test]
+        public void EqualStringsShareOneInstanceAndId()
+        {
+            var first = Fresh("Share", 0);
+            var second = Fresh("Share", 0);
+            Assert.AreNotSame(first, second);
+
+            var interned = SdkStringTable.Intern(first);
+            Assert.AreSame(first, interned);
+            Assert.AreSame(interned, SdkStringTable.Intern(second));
+
+            var id = SdkStringTable.GetId(second);
+            Assert.AreEqual(id, SdkStringTable.GetId(first));
+            Assert.AreSame(interned, SdkStringTable.Resolve(id));
+        }
+
+        [Test]
+        public void UninternableStringsPassThrough()
+        {
+            var countBefore = SdkStringTable.Count;
+            var overLong = new string('x', 513);
+
+            Assert.IsNull(SdkStringTable.Intern(null));
+            Assert.AreEqual("", SdkStringTable.Intern(""));
+            Assert.AreSame(overLong, SdkStringTable.Intern(overLong));
+            Assert.AreEqual(-1, SdkStringTable.GetId(null));
+            Assert.AreEqual(-1, SdkStringTable.GetId(overLong));
+            Assert.AreEqual(countBefore, SdkStringTable.Count);
+
+            Assert.IsNull(SdkStringTable.Resolve(-1));
+            Assert.IsNull(SdkStringTable.Resolve(SdkStringTable.Count));
+        }
+
+        [Test]
+        public void ConcurrentAddsAgreeOnIds()
+        {
+            var countBefore = SdkStringTable.Count;
+            var ids = new ConcurrentBag<int[]>();
+            var ready = new Barrier(ThreadCount);
+
+            var threads = new List<Thread>();
+            for (var t = 0; t < ThreadCount; t++)
+            {
+                var thread = new Thread(() =>
+                {
+                    var seen = new int[StringsPerTest];
+                    ready.SignalAndWait();
+                    // All in the same order, so every add races the other threads' adds of that string
+                    for (var i = 0; i < StringsPerTest; i++)
+                    {
+                        seen[i] = SdkStringTable.GetId(Fresh("Concurrent", i));
+                    }
+                    ids.Add(seen);
+                });
+                thread.Start();
+                threads.Add(thread);
+            }
+            foreach (var thread in threads) thread.Join();
+
+            Assert.AreEqual(countBefore + StringsPerTest, SdkStringTable.Count);
+            var expected = ids.ToArray()[0];
+            foreach (var seen in ids)
+            {
+                CollectionAssert.AreEqual(expected, seen);
+            }
+            for (var i = 0; i < StringsPerTest; i++)
+            {
+                Assert.AreEqual(Fresh("Concurrent", i), SdkStringTable.Resolve(expected[i]));
+            }
+        }
+
+        [Test]
+        public void FullTableReturnsNewStringsUnchanged()
+        {
+            var countBefore = SdkStringTable.Count;
+            var known = Fresh("Full", -1);
+            var knownId = SdkStringTable.GetId(known);
+            try
+            {
+                for (var i = 0; SdkStringTable.Count < SdkStringTable.Capacity; i++)
+                {
+                    SdkStringTable.GetId(Fresh("Full", i));
+                }
+
+                var late = Fresh("Full", SdkStringTable.Capacity);
+                Assert.AreEqual(-1, SdkStringTable.GetId(late));
+                Assert.AreSame(late, SdkStringTable.Intern(late));
+                Assert.AreEqual(SdkStringTable.Capacity, SdkStringTable.Count);
+
+                // Strings added before still resolve to the shared instance
+                Assert.AreEqual(knownId, SdkStringTable.GetId(Fresh("Full", -1)));
+                Assert.AreSame(known, SdkStringTable.Intern(Fresh("Full", -1)));
+            }
+            finally
+            {
+                RemoveAddedSince(countBefore);
+            }
+        }
+
+        [Test]
+        public void ParsedFramesShareStrings()
+        {
+            var handler = new UnityExceptionHandler(ScriptableObject.CreateInstance<ErrorTrackerConfig>(), _ => { });
+            var parse = typeof(UnityExceptionHandler).GetMethod("ParseStackFrames", BindingFlags.NonPublic | BindingFlags.Instance);
+            var trace = "SdkStringTableTests.Player.Update () (at Assets/Scripts/SdkStringTableTests.cs:42)\n" +
+                        "SdkStringTableTests.Game.Tick ()";
+
+            var first = (List<StackFrame>)parse.Invoke(handler, new object[] { new string(trace.ToCharArray()) });
+            var second = (List<StackFrame>)parse.Invoke(handler, new object[] { new string(trace.ToCharArray()) });
+
+            Assert.AreEqual(2, first.Count);
+            for (var i = 0; i < first.Count; i++)
+            {
+                Assert.AreSame(first[i].function, second[i].function);
+                Assert.AreSame(first[i].module, second[i].module);
+            }
+            Assert.AreEqual("Assets/Scripts/SdkStringTableTests.cs", first[0].filename);
+            Assert.AreSame(first[0].filename, second[0].filename);
+        }
+
+        [Test]
+        public void BreadcrumbCategoriesShareStrings()
+        {
+            var first = new Breadcrumb(BreadcrumbType.Debug, "one", category: Fresh("Category", 0));
+            var second = new Breadcrumb(BreadcrumbType.Debug, "two", category: Fresh("Category", 0));
+
+            Assert.AreSame(first.category, second.category);
+            Assert.AreSame(SdkStringTable.Intern(Fresh("Category", 0)), first.category);
+        }
+
+        // Puts the table back as it was, so later tests can still intern
+        private static void RemoveAddedSince(int count)
+        {
+            var flags = BindingFlags.NonPublic | BindingFlags.Static;
+            var ids = (ConcurrentDictionary<string, int>)typeof(SdkStringTable).GetField("_ids", flags).GetValue(null);
+            var strings = (string[])typeof(SdkStringTable).GetField("_strings", flags).GetValue(null);
+
+            for (var id = count; id < SdkStringTable.Count; id++)
+            {
+                ids.TryRemove(strings[id], out _);
+                strings[id] = null;
+            }
+            typeof(SdkStringTable).GetField("_count", flags).SetValue(null, count);
+        }
+    }
+}
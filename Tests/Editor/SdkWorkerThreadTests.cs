@@ -0,0 +1,125 @@
+using System;
+using System.Threading;
+using NUnit.Framework;
+using UnityEngine;
+
+namespace MoonForge.ErrorTracking.Tests
+{
+    public class SdkWorkerThreadTests
+    {
+        private ErrorTrackerConfig _config;
+        private SdkWorkerThread _worker;
+
+        [SetUp]
+        public void SetUp()
+        {
+            _config = ScriptableObject.CreateInstance<ErrorTrackerConfig>();
+            _config.workerThreadPolicy = ThreadAffinityPolicy.None;
+            _worker = new SdkWorkerThread(_config);
+        }
+
+        [TearDown]
+        public void TearDown()
+        {
+            _worker.Shutdown(1000);
+            UnityEngine.Object.DestroyImmediate(_config);
+        }
+
+        [Test]
+        public void JobsRunInPostedOrder()
+        {
+            var order = new int[10];
+            var count = 0;
+            for (var i = 0; i < order.Length; i++)
+            {
+                var index = i;
+                _worker.Post(() => order[count++] = index);
+            }
+
+            Assert.IsTrue(_worker.Shutdown(1000));
+            Assert.AreEqual(new[] { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }, order);
+        }
+
+        [Test]
+        public void ShutdownHandsFinishedWorkToTheScheduler()
+        {
+            // How the tracker shuts down: serialization on the worker posts the
+            // request to the main thread, which must still see it
+            var scheduler = new FrameBudgetScheduler(_config);
+            var sent = false;
+            _worker.Post(() =>
+            {
+                Thread.Sleep(50);
+                scheduler.Post(() => sent = true);
+            });
+
+            Assert.IsTrue(_worker.Shutdown(1000));
+            scheduler.RunAll();
+            Assert.IsTrue(sent);
+
+            // Posted after shutdown: runs inline
+            var inline = false;
+            _worker.Post(() => inline = true);
+            Assert.IsTrue(inline);
+        }
+
+        [Test]
+        public void TimerRunsWhileJobsKeepArriving()
+        {
+            var fired = new ManualResetEventSlim();
+            var stop = false;
+
+            // Each job posts the next before it runs, so the queue is never empty
+            Action job = null;
+            job = () =>
+            {
+                if (Volatile.Read(ref stop)) return;
+                _worker.Post(job);
+                Thread.Sleep(1);
+            };
+            _worker.Post(job);
+
+            _worker.Schedule(TimeSpan.FromMilliseconds(50), fired.Set);
+
+            var ran = fired.Wait(2000);
+            Volatile.Write(ref stop, true);
+            Assert.IsTrue(ran, "timer starved by the job stream");
+        }
+
+        [Test]
+        public void RepeatingTimerKeepsCadenceUnderLoad()
+        {
+            var ticks = 0;
+            var stop = false;
+
+            Action job = null;
+            job = () =>
+            {
+                if (Volatile.Read(ref stop)) return;
+                _worker.Post(job);
+                Thread.Sleep(1);
+            };
+            _worker.Post(job);
+
+            var timer = _worker.ScheduleRepeating(TimeSpan.FromMilliseconds(20), TimeSpan.FromMilliseconds(20),
+                () => Interlocked.Increment(ref ticks));
+            Thread.Sleep(500);
+            timer.Cancel();
+            Volatile.Write(ref stop, true);
+
+            // 25 intervals; allow for a slow machine but not for starvation
+            Assert.GreaterOrEqual(Volatile.Read(ref ticks), 10);
+        }
+
+        [Test]
+        public void CancelledTimerDoesNotRun()
+        {
+            var ran = false;
+            var timer = _worker.Schedule(TimeSpan.FromMilliseconds(30), () => ran = true);
+            timer.Cancel();
+
+            Thread.Sleep(100);
+            Assert.IsFalse(ran);
+        }
+    }
+}
@@ -0,0 +1,85 @@
+using System;
+using System.Collections.Generic;
+using System.Reflection;
+using NUnit.Framework;
+
+namespace MoonForge.ErrorTracking.Tests
+{
+    // TimerWheel is internal to the runtime assembly, so it is driven through reflection
+    public class TimerWheelTests
+    {
+        private static readonly Type WheelType = typeof(SdkTimer).Assembly.GetType("MoonForge.ErrorTracking.TimerWheel");
+        private static readonly FieldInfo DueTickField = typeof(SdkTimer).GetField("DueTick", BindingFlags.NonPublic | BindingFlags.Instance);
+
+        private object _wheel;
+        private readonly List<SdkTimer> _expired = new List<SdkTimer>();
+
+        private void Add(SdkTimer timer)
+        {
+            WheelType.GetMethod("Add").Invoke(_wheel, new object[] { timer });
+        }
+
+        private void Advance(long nowTick)
+        {
+            WheelType.GetMethod("Advance").Invoke(_wheel, new object[] { nowTick, _expired });
+        }
+
+        private static SdkTimer Timer(long dueTick)
+        {
+            var timer = (SdkTimer)Activator.CreateInstance(typeof(SdkTimer), true);
+            DueTickField.SetValue(timer, dueTick);
+            return timer;
+        }
+
+        [Test]
+        public void TimersExpireOnTheirDueTickOnEveryLevel()
+        {
+            // Not on a slot boundary, so cascades happen partway through each level
+            const long start = 1000003;
+            _wheel = Activator.CreateInstance(WheelType, start);
+
+            // Level 0, its edge, levels 1 to 3, and past the wheel's range (clamped, then inserted again)
+            var offsets = new long[] { 1, 63, 64, 4095, 4096, 300007, 16777215, 20000011 };
+            var timers = new List<SdkTimer>();
+            foreach (var offset in offsets)
+            {
+                var timer = Timer(start + offset);
+                timers.Add(timer);
+                Add(timer);
+            }
+
+            foreach (var timer in timers)
+            {
+                var due = (long)DueTickField.GetValue(timer);
+                Advance(due - 1);
+                Assert.IsFalse(_expired.Contains(timer), $"expired before tick {due}");
+
+                Advance(due);
+                Assert.AreEqual(1, _expired.Count, $"tick {due}");
+                Assert.AreSame(timer, _expired[0]);
+                _expired.Clear();
+            }
+        }
+
+        [Test]
+        public void OneLongAdvanceExpiresEverythingDue()
+        {
+            const long start = 77;
+            _wheel = Activator.CreateInstance(WheelType, start);
+
+            var early = Timer(start + 10);
+            var cascaded = Timer(start + 70000);
+            var later = Timer(start + 70001);
+            Add(early);
+            Add(cascaded);
+            Add(later);
+
+            Advance(start + 70000);
+            CollectionAssert.AreEqual(new[] { early, cascaded }, _expired);
+
+            _expired.Clear();
+            Advance(start + 70001);
+            CollectionAssert.AreEqual(new[] { later }, _expired);
+        }
+    }
+}
@@ -0,0 +1,355 @@
+using System.Collections.Generic;
+using System.IO;
+using System.Text;
+using MoonForge.ErrorTracking.Editor;
+using NUnit.Framework;
+
+namespace MoonForge.ErrorTracking.Tests
+{
+    public class WirePayloadCodecTests
+    {
+        private const string Required = "\"errorType\":\"exception\",\"errorCategory\":\"managed\",\"errorLevel\":\"error\",\"message\":\"m\",\"appVersion\":\"1\",\"buildNumber\":\"1\"";
+
+        private System.Random _random;
+
+        [SetUp]
+        public void SetUp()
+        {
+            _random = new System.Random(7);
+        }
+
+        #region Random Payloads
+
+        // Quotes, backslashes, control characters and non-ASCII, or null/empty
+        private string Text(bool allowNull = true)
+        {
+            var kind = _random.Next(6);
+            if (allowNull && kind == 0) return null;
+            if (kind == 1) return "";
+
+            var sb = new StringBuilder();
+            var length = _random.Next(1, 12);
+            for (var i = 0; i < length; i++)
+            {
+                switch (_random.Next(10))
+                {
+                    case 0: sb.Append('"'); break;
+                    case 1: sb.Append('\\'); break;
+                    case 2: sb.Append((char)_random.Next(0, 32)); break;
+                    case 3: sb.Append('é'); break;
+                    case 4: sb.Append('\u4e2d'); break;
+                    default: sb.Append((char)('a' + _random.Next(26))); break;
+                }
+            }
+            return sb.ToString();
+        }
+
+        private string RequiredText()
+        {
+            return "r" + Text(false);
+        }
+
+        private float? OptionalFloat()
+        {
+            return _random.Next(3) == 0 ? (float?)null : (float)(_random.NextDouble() * 1000 - 100);
+        }
+
+        private Dictionary<string, object> CustomData(int depth = 0)
+        {
+            if (_random.Next(3) == 0) return null;
+
+            var data = new Dictionary<string, object>();
+            var count = _random.Next(0, 4);
+            for (var i = 0; i < count; i++)
+            {
+                object value;
+                switch (_random.Next(8))
+                {
+                    case 0: value = null; break;
+                    case 1: value = _random.Next(2) == 0; break;
+                    case 2: value = _random.Next(); break;
+                    case 3: value = (long)_random.Next() * 1000; break;
+                    case 4: value = (float)_random.NextDouble(); break;
+                    case 5: value = _random.NextDouble(); break;
+                    case 6: value = depth < 2 ? (object)CustomData(depth + 1) : "x"; break;
+                    default: value = Text(false); break;
+                }
+                data["k" + i + Text(false)] = value;
+            }
+            return data;
+        }
+
+        private Dictionary<string, string> Headers()
+        {
+            if (_random.Next(3) == 0) return null;
+
+            var headers = new Dictionary<string, string>();
+            var count = _random.Next(0, 3);
+            for (var i = 0; i < count; i++) headers["h" + i] = Text();
+            return headers;
+        }
+
+        private List<StackFrame> Frames()
+        {
+            if (_random.Next(4) == 0) return null;
+
+            var frames = new List<StackFrame>();
+            var count = _random.Next(0, 6);
+            for (var i = 0; i < count; i++)
+            {
+                frames.Add(new StackFrame
+                {
+                    module = Text(),
+                    function = Text(),
+                    filename = Text(),
+                    lineno = _random.Next(-2, 50),
+                    colno = _random.Next(-1, 3),
+                    instructionAddress = Text(),
+                    symbolAddress = Text(),
+                    inApp = _random.Next(2) == 0,
+                    package = Text()
+                });
+            }
+            return frames;
+        }
+
+        private DeviceContext Device()
+        {
+            if (_random.Next(4) == 0) return null;
+
+            return new DeviceContext
+            {
+                platform = RequiredText(),
+                osVersion = RequiredText(),
+                deviceModel = RequiredText(),
+                manufacturer = Text(),
+                cpuArchitecture = Text(),
+                memoryUsedMb = OptionalFloat(),
+                memoryAvailableMb = OptionalFloat(),
+                cpuUsagePercent = OptionalFloat(),
+                threadCpu = _random.Next(2) == 0 ? null : new List<ThreadCpuUsage>
+                {
+                    new ThreadCpuUsage { tid = _random.Next(), name = RequiredText(), cpuPercent = (float)_random.NextDouble() * 100, cpuTimeMs = _random.Next() }
+                },
+                fps = OptionalFloat(),
+                batteryLevel = OptionalFloat(),
+                batteryCharging = _random.Next(3) == 0 ? (bool?)null : _random.Next(2) == 0,
+                thermalState = Text(),
+                temperatureC = OptionalFloat(),
+                cpuFrequencyCapPercent = OptionalFloat(),
+                batteryTemperatureC = OptionalFloat(),
+                cpuClusters = _random.Next(2) == 0 ? null : new List<CpuClusterFrequency>
+                {
+                    new CpuClusterFrequency { cpu = 0, curKhz = _random.Next(), maxKhz = 0, capKhz = _random.Next() }
+                }
+            };
+        }
+
+        private List<Breadcrumb> Breadcrumbs()
+        {
+            if (_random.Next(3) == 0) return null;
+
+            var breadcrumbs = new List<Breadcrumb>();
+            var count = _random.Next(0, 4);
+            for (var i = 0; i < count; i++)
+            {
+                var breadcrumb = new Breadcrumb(BreadcrumbType.Navigation, Text(), BreadcrumbLevel.Warning, Text());
+                breadcrumb.data = CustomData();
+                breadcrumb.timestamp = _random.Next();
+                breadcrumbs.Add(breadcrumb);
+            }
+            return breadcrumbs;
+        }
+
+        private ErrorPayloadInner Inner()
+        {
+            return new ErrorPayloadInner
+            {
+                game = Text(),
+                errorType = RequiredText(),
+                errorCategory = RequiredText(),
+                errorLevel = RequiredText(),
+                message = RequiredText(),
+                frames = Frames(),
+                rawStackTrace = Text(),
+                logTail = Text(),
+                exceptionClass = Text(),
+                faultClass = Text(),
+                fingerprint = Text(),
+                device = Device(),
+                network = _random.Next(3) == 0 ? null : new NetworkContext { type = Text(), carrier = Text(), effectiveType = Text() },
+                gameState = _random.Next(3) == 0 ? null : new GameState { sceneName = Text(), gameMode = Text(), levelId = Text(), customData = CustomData() },
+                appVersion = RequiredText(),
+                buildNumber = RequiredText(),
+                unityVersion = Text(),
+                userId = Text(),
+                sessionId = Text(),
+                breadcrumbs = Breadcrumbs(),
+                timestamp = _random.Next(2) == 0 ? (long?)null : _random.Next(),
+                networkRequest = _random.Next(3) == 0 ? null : new NetworkRequest
+                {
+                    url = RequiredText(),
+                    method = RequiredText(),
+                    statusCode = _random.Next(2) == 0 ? (int?)null : _random.Next(600),
+                    durationMs = OptionalFloat(),
+                    requestHeaders = Headers(),
+                    responseHeaders = Headers()
+                },
+                tags = Headers()
+            };
+        }
+
+        #endregion
+
+        private static string Encode(ErrorPayload payload)
+        {
+            var sb = new StringBuilder();
+            WirePayloadEncoder.Append(sb, payload);
+            return sb.ToString();
+        }
+
+        private static string Decode(string json)
+        {
+            Assert.IsTrue(WirePayloadDecoder.TryDecode(json, out ErrorPayload payload, out var error), error);
+            return Encode(payload);
+        }
+
+        private static string DecodeError(string json)
+        {
+            Assert.IsFalse(WirePayloadDecoder.TryDecode(json, out ErrorPayload _, out var error), json);
+            return error;
+        }
+
+        [Test]
+        public void RandomPayloadsRoundTrip()
+        {
+            for (var i = 0; i < 400; i++)
+            {
+                var json = Encode(new ErrorPayload { payload = Inner() });
+                Assert.AreEqual(json, Decode(json));
+            }
+        }
+
+        [Test]
+        public void BatchItemsRoundTrip()
+        {
+            var items = new List<BatchErrorItem>();
+            for (var i = 0; i < 50; i++)
+            {
+                var inner = Inner();
+                items.Add(new BatchErrorItem
+                {
+                    clientErrorId = RequiredText(),
+                    errorType = inner.errorType,
+                    errorCategory = inner.errorCategory,
+                    errorLevel = inner.errorLevel,
+                    message = inner.message,
+                    frames = inner.frames,
+                    faultClass = inner.faultClass,
+                    device = inner.device,
+                    gameState = inner.gameState,
+                    appVersion = inner.appVersion,
+                    buildNumber = inner.buildNumber,
+                    breadcrumbs = inner.breadcrumbs,
+                    timestamp = inner.timestamp,
+                    tags = inner.tags
+                });
+            }
+
+            var sb = new StringBuilder("{\"type\":\"error_batch\",\"game\":\"g\",\"errors\":[");
+            var start = sb.Length;
+            for (var i = 0; i < items.Count; i++)
+            {
+                if (i > 0) sb.Append(',');
+                WirePayloadEncoder.Append(sb, items[i]);
+            }
+            var errors = sb.ToString(start, sb.Length - start);
+            sb.Append("]}");
+
+            Assert.IsTrue(WirePayloadDecoder.TryDecode(sb.ToString(), out ErrorBatchPayload batch, out var error), error);
+            Assert.AreEqual("g", batch.game);
+            Assert.AreEqual(items.Count, batch.errors.Count);
+
+            var again = new StringBuilder();
+            for (var i = 0; i < batch.errors.Count; i++)
+            {
+                if (i > 0) again.Append(',');
+                WirePayloadEncoder.Append(again, batch.errors[i]);
+            }
+            Assert.AreEqual(errors, again.ToString());
+        }
+
+        [Test]
+        public void AbsentOptionalFieldsAreOmitted()
+        {
+            var json = Encode(new ErrorPayload
+            {
+                payload = new ErrorPayloadInner
+                {
+                    errorType = "exception",
+                    errorCategory = "managed",
+                    errorLevel = "error",
+                    message = "m",
+                    appVersion = "1",
+                    buildNumber = "1",
+                    frames = new List<StackFrame>(),
+                    tags = new Dictionary<string, string>()
+                }
+            });
+            Assert.AreEqual("{\"type\":\"error\",\"payload\":{" + Required + "}}", json);
+        }
+
+        [Test]
+        public void MissingRequiredFieldIsRejectedWithPath()
+        {
+            StringAssert.Contains("payload.message",
+                DecodeError("{\"type\":\"error\",\"payload\":{\"errorType\":\"exception\",\"errorCategory\":\"managed\",\"errorLevel\":\"error\",\"appVersion\":\"1\",\"buildNumber\":\"1\"}}"));
+
+            StringAssert.Contains("payload.device.osVersion",
+                DecodeError("{\"type\":\"error\",\"payload\":{" + Required + ",\"device\":{\"platform\":\"p\",\"deviceModel\":\"d\"}}}"));
+
+            Assert.IsFalse(WirePayloadDecoder.TryDecode(
+                "{\"type\":\"error_batch\",\"game\":\"g\",\"errors\":[{" + Required + "}]}", out ErrorBatchPayload _, out var error));
+            StringAssert.Contains("clientErrorId", error);
+        }
+
+        [Test]
+        public void WrongValueTypeIsRejected()
+        {
+            StringAssert.Contains("expected string", DecodeError("{\"type\":\"error\",\"payload\":{\"errorType\":5}}"));
+            StringAssert.Contains("expected a number", DecodeError("{\"type\":\"error\",\"payload\":{" + Required + ",\"frames\":[{\"lineno\":\"7\"}]}}"));
+        }
+
+        [Test]
+        public void MalformedBodiesAreRejected()
+        {
+            DecodeError("{\"type\":\"error\",\"payload\":{" + Required + "}} trailing");
+            DecodeError("{\"type\":\"error\",\"payload\":{" + Required);
+            DecodeError("{\"type\":\"error\",\"payload\":{" + Required + ",\"message\":\"\\q\"}}");
+            DecodeError("");
+            Assert.AreEqual("body is null", DecodeError("null"));
+        }
+
+        [Test]
+        public void UnknownFieldsAreSkipped()
+        {
+            var json = "{\"type\":\"error\",\"payload\":{\"unknown\":{\"a\":[1,2.5e3,{\"b\":null}],\"c\":\"}\"}," + Required + "},\"extra\":true}";
+            Assert.AreEqual("{\"type\":\"error\",\"payload\":{" + Required + "}}", Decode(json));
+        }
+
+        [Test]
+        public void GeneratedCodecsAreCurrent()
+        {
+            var package = UnityEditor.PackageManager.PackageInfo.FindForAssembly(typeof(WireSchemaGenerator).Assembly);
+            if (package == null) Assert.Ignore("Not running from the package");
+
+            // The same check as WireSchemaGenerator.VerifyFromCommandLine, for runs without the CI step
+            Assert.AreEqual(WireSchemaGenerator.GenerateEncoder(),
+                File.ReadAllText(Path.Combine(package.resolvedPath, "Runtime/Transport/WirePayloadEncoder.g.cs")).Replace("\r\n", "\n"),
+                "Run MoonForge > Developer > Regenerate Wire Codecs");
+            Assert.AreEqual(WireSchemaGenerator.GenerateDecoder(),
+                File.ReadAllText(Path.Combine(package.resolvedPath, "Editor/WirePayloadDecoder.g.cs")).Replace("\r\n", "\n"),
+                "Run MoonForge > Developer > Regenerate Wire Codecs");
+        }
+    }
+}